@@ -0,0 +1,54 @@
+/**************************************************************************
+ * Copyright 2009-2015 Olivier Belanger                                   *
+ *                                                                        *
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *
+ *                                                                        *
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with pyo.  If not, see <http://www.gnu.org/licenses/>.   *
+ *************************************************************************/
+#ifndef _ARENA_H
+#define _ARENA_H
+
+#include <stddef.h>
+
+/* Memory arena for the sample buffers of the objects, tables and phase
+   vocoder streams. Every block is aligned on 64 bytes (a cache line and
+   the widest vector loads). Blocks up to ARENA_MAX_CLASS bytes come from
+   per size class slabs, so buffers of the same size are packed next to
+   each other, and freed blocks are reused by the next allocations of the
+   same size class. Bigger blocks are allocated individually. The arena
+   is shared by all the objects and is thread-safe. */
+
+#define ARENA_ALIGN 64
+#define ARENA_MAX_CLASS 65536
+
+typedef struct
+{
+    size_t used; /* bytes requested by the live blocks. */
+    size_t peak; /* highest value of `used`. */
+    size_t reserved; /* bytes obtained from the system (slabs and big blocks). */
+    size_t blocks; /* number of live blocks. */
+    size_t slabs; /* number of slabs. */
+    size_t large; /* number of live blocks bigger than ARENA_MAX_CLASS. */
+} ArenaStats;
+
+/* Returns a 64-byte aligned block of `size` bytes (uninitialized), or NULL. */
+void * arena_alloc(size_t size);
+/* Same as realloc(), `ptr` can be NULL. Returns NULL (and leaves `ptr` allocated) on failure. */
+void * arena_realloc(void *ptr, size_t size);
+/* Releases a block returned by arena_alloc() or arena_realloc(), `ptr` can be NULL. */
+void arena_free(void *ptr);
+void arena_get_stats(ArenaStats *stats);
+
+#endif // _ARENA_H
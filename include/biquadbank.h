@@ -0,0 +1,96 @@
+/**************************************************************************
+ * Copyright 2009-2015 Olivier Belanger                                   *
+ *                                                                        *
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *
+ *                                                                        *
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with pyo.  If not, see <http://www.gnu.org/licenses/>.   *
+ *************************************************************************/
+
+#ifndef _BIQUADBANK_H
+#define _BIQUADBANK_H
+
+#include "pyomodule.h"
+
+/* Bank of independent biquad filters.
+ *
+ * The coefficients and the sample memories of the filters are stored in
+ * arrays (one array per coefficient or memory, indexed by filter), so that
+ * consecutive filters can be computed side by side. The owner computes the
+ * coefficients of a filter only when its parameters change, with
+ * BiquadBank_setCoeffs() or BiquadBank_setEQCoeffs(). */
+
+/* Filter types of BiquadBank_setCoeffs(), as Biquad. */
+#define BIQUADBANK_LOWPASS 0
+#define BIQUADBANK_HIGHPASS 1
+#define BIQUADBANK_BANDPASS 2
+#define BIQUADBANK_BANDSTOP 3
+#define BIQUADBANK_ALLPASS 4
+
+/* Filter types of BiquadBank_setEQCoeffs(), as EQ. */
+#define BIQUADBANK_PEAK 0
+#define BIQUADBANK_LOWSHELF 1
+#define BIQUADBANK_HIGHSHELF 2
+
+typedef struct
+{
+    int size; /* Number of filters. */
+    MYFLT *memory; /* Single block holding all the arrays below. */
+    // coefficients
+    MYFLT *b0;
+    MYFLT *b1;
+    MYFLT *b2;
+    MYFLT *a0;
+    MYFLT *a1;
+    MYFLT *a2;
+    // sample memories
+    MYFLT *x1;
+    MYFLT *x2;
+    MYFLT *y1;
+    MYFLT *y2;
+    int *init; /* The memories of the filter are set from the next input sample. */
+} BiquadBank;
+
+/* (Re)allocates the bank for `size` filters. All the coefficients are reset
+   to 0 and all the filters are reinitialized. Returns -1 on failure. */
+extern int BiquadBank_alloc(BiquadBank *self, int size);
+extern void BiquadBank_free(BiquadBank *self);
+
+/* Coefficients of filter `f` from the cosinus of the normalized frequency
+   (`c`) and from `alpha` (sin(w0) / (2 * q)). */
+extern void BiquadBank_setCoeffs(BiquadBank *self, int f, int type, MYFLT c, MYFLT alpha);
+/* Same for the EQ types, `A` being the amplitude (10^(boost/40)). */
+extern void BiquadBank_setEQCoeffs(BiquadBank *self, int f, int type, MYFLT A, MYFLT c, MYFLT alpha);
+/* Copies the coefficients of filter `src` to filter `dst`. */
+extern void BiquadBank_copyCoeffs(BiquadBank *self, int dst, int src);
+
+/* Sets the memories of filter `f`, if it has to be initialized, to `x`. */
+extern void BiquadBank_prime(BiquadBank *self, int f, MYFLT x);
+
+/* Filters `bufsize` samples of `in[j]` into `out[j]` with filter first+j,
+   for j in 0 .. lanes-1 (lanes <= PYO_BIQUADBANK_LANES). `in[j]` and
+   `out[j]` can be the same buffer. */
+#define PYO_BIQUADBANK_LANES 8
+extern void BiquadBank_process(BiquadBank *self, int first, int lanes, MYFLT **in, MYFLT **out, int bufsize);
+
+/* One sample `x` through filter `f`, the output is written in `val`. */
+#define BIQUADBANK_TICK(bank, f, x, val) \
+    val = ( ((bank)->b0[f] * (x)) + ((bank)->b1[f] * (bank)->x1[f]) + ((bank)->b2[f] * (bank)->x2[f]) - \
+            ((bank)->a1[f] * (bank)->y1[f]) - ((bank)->a2[f] * (bank)->y2[f]) ) * (bank)->a0[f]; \
+    (bank)->y2[f] = (bank)->y1[f]; \
+    (bank)->y1[f] = val; \
+    (bank)->x2[f] = (bank)->x1[f]; \
+    (bank)->x1[f] = (x);
+
+#endif // _BIQUADBANK_H
@@ -0,0 +1,67 @@
+/**************************************************************************
+ * Copyright 2009-2015 Olivier Belanger                                   *
+ *                                                                        *
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *
+ *                                                                        *
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with pyo.  If not, see <http://www.gnu.org/licenses/>.   *
+ *************************************************************************/
+
+#ifndef _BUFFERPOOL_H
+#define _BUFFERPOOL_H
+
+#include "pyomodule.h"
+#include "streammodule.h"
+
+typedef struct
+{
+    void *key;
+    int node;
+} BufferPoolEntry;
+
+typedef struct
+{
+    int bufsize; /* size of the shared buffers. */
+    int built; /* a plan has been computed and applied. */
+    unsigned int serial; /* graph serial number when the plan was computed. */
+
+    /* Shared buffers, kept from one plan to the next. */
+    MYFLT **buffers;
+    int count;
+    int size;
+
+    /* Plan, one entry per stream. */
+    int capacity;
+    int *lastReader; /* index of the last stream reading this one, -1 if none. */
+    int *readEarly; /* read by a stream computed before it, its data must persist. */
+    int *buffer; /* index of the shared buffer, -1 for the stream's own buffer. */
+    int *releaseHead; /* shared buffers released after this stream is computed. */
+    int *releaseNext;
+    int *freeList;
+    BufferPoolEntry *table;
+    unsigned int tableSize;
+    PyObject **refs;
+    int nrefs;
+    int refsSize;
+    PyObject *server;
+    int shared; /* number of streams computed in a shared buffer. */
+} PyoBufferPool;
+
+PyoBufferPool * BufferPool_new();
+void BufferPool_free(PyoBufferPool *self);
+void BufferPool_build(PyoBufferPool *self, Stream **streams, int count, int bufsize, PyObject *server);
+void BufferPool_release(PyoBufferPool *self, Stream **streams, int count);
+void BufferPool_detach(Stream *stream);
+
+#endif // _BUFFERPOOL_H
@@ -0,0 +1,131 @@
+/**************************************************************************
+ * Copyright 2009-2015 Olivier Belanger                                   *
+ *                                                                        *
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *
+ *                                                                        *
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with pyo.  If not, see <http://www.gnu.org/licenses/>.   *
+ *************************************************************************/
+#ifndef _CONVOLVER_H
+#define _CONVOLVER_H
+
+#include <pthread.h>
+#include "pyomodule.h"
+#include "fft.h"
+
+/* Largest block size grown by the non-uniform partitioning. */
+#define PYO_CONV_MAX_BLOCK 8192
+/* Maximum number of partition levels. */
+#define PYO_CONV_MAX_LEVELS 16
+
+/* A set of uniform partitions of the same block size. The spectra are
+   stored contiguously, one block after the other: `impulse_real[p * bsize]`
+   is the first bin of the partition p and the frequency-domain delay line
+   holds the spectra of the last `num` input blocks the same way. */
+typedef struct
+{
+    int bsize; /* block size, the fft size is twice this value */
+    int num; /* number of partitions */
+    int fdlpos; /* slot of the most recent input spectrum */
+    MYFLT gain;
+    PyoFFTPlan *plan;
+    MYFLT *impulse_real;
+    MYFLT *impulse_imag;
+    MYFLT *fdl_real;
+    MYFLT *fdl_imag;
+    MYFLT *sum_real;
+    MYFLT *sum_imag;
+    MYFLT *frame; /* fft work buffer, 2 * bsize */
+    MYFLT *last; /* previous input block (overlap-save) */
+    /* Background levels only. */
+    MYFLT *fill; /* input block being filled by the audio thread */
+    MYFLT *input; /* input block given to the worker */
+    MYFLT *result; /* output block written by the worker */
+    MYFLT *playing; /* output block read by the audio thread */
+    int fillpos;
+    int playpos;
+    unsigned int posted;
+    unsigned int completed;
+} PyoConvLevel;
+
+/* Non-uniform partitioned convolver (Gardner). The head of the impulse is
+   split in small partitions computed in the audio thread, the tail in
+   partitions of growing block size computed by a background thread, each
+   level having a whole block period to finish its job. Every level starts
+   at an offset of 2 * bsize - size samples so the total latency stays one
+   block of `size` samples, as with uniform partitions. */
+typedef struct
+{
+    int size; /* head block size, samples given to Convolver_process */
+    int nlevels;
+    PyoConvLevel levels[PYO_CONV_MAX_LEVELS];
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    int threaded;
+    int quit;
+} PyoConvolver;
+
+/* The output is the convolution of the input with the impulse, scaled by
+   `gain`. The block size doesn't grow beyond `maxblock`, a `maxblock` equal
+   to `size` gives uniform partitions. Without a worker thread, the tail
+   levels are computed in Convolver_process when their input block is
+   complete. */
+PyoConvolver * Convolver_new(const MYFLT *impulse, int length, int size, int maxblock, MYFLT gain, int threaded);
+void Convolver_free(PyoConvolver *self);
+/* Replaces the impulse, which must keep the same length. */
+void Convolver_setImpulse(PyoConvolver *self, const MYFLT *impulse, int length);
+/* Takes the next `size` input samples and returns the `size` output samples
+   delayed by one block. */
+void Convolver_process(PyoConvolver *self, const MYFLT *in, MYFLT *out);
+/* Computes again the output of the last Convolver_process call after a
+   change of impulse. Exact with uniform partitions only, the output of the
+   other levels was computed from older input blocks. */
+void Convolver_refresh(PyoConvolver *self, MYFLT *out);
+
+/* Impulses up to this length are computed with a direct loop only. */
+#define PYO_FIR_DIRECT_MAX 256
+/* Length of the direct head, and block size of the fft tail, above it. */
+#define PYO_FIR_HEAD_SIZE 64
+
+/* FIR filter without block latency, used by Convolve and the IR* objects.
+   The first PYO_FIR_HEAD_SIZE taps are computed sample by sample, the rest
+   of a long impulse by a partitioned convolver whose one block of latency
+   is covered by the head. As in the former direct form, the output is
+   delayed by one sample: out[n] = sum(impulse[j] * in[n - 1 - j]).
+   A `dynamic` filter, whose impulse changes often, uses uniform partitions
+   so that a new impulse applies at once, as with the direct form. Otherwise
+   the tail is partitioned non-uniformly and computed by a worker thread. */
+typedef struct
+{
+    int length;
+    int head; /* taps computed by the direct loop */
+    MYFLT *impulse;
+    MYFLT *history; /* last `head` inputs, twice, most recent first */
+    int hpos;
+    MYFLT last; /* previous input sample */
+    MYFLT *inblock;
+    MYFLT *outblock;
+    int blockpos;
+    PyoConvolver *tail;
+    int dynamic;
+} PyoFirFilter;
+
+PyoFirFilter * FirFilter_new(int length, int dynamic);
+void FirFilter_free(PyoFirFilter *self);
+/* Copies `num` taps, the remaining taps are set to 0. */
+void FirFilter_setImpulse(PyoFirFilter *self, const MYFLT *impulse, int num);
+void FirFilter_process(PyoFirFilter *self, const MYFLT *in, MYFLT *out, int num);
+
+#endif // _CONVOLVER_H
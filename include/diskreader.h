@@ -0,0 +1,74 @@
+/**************************************************************************
+ * Copyright 2009-2015 Olivier Belanger                                   *
+ *                                                                        *
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *
+ *                                                                        *
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with pyo.  If not, see <http://www.gnu.org/licenses/>.   *
+ *************************************************************************/
+#ifndef _DISKREADER_H
+#define _DISKREADER_H
+
+#include <pthread.h>
+#include "sndfile.h"
+#include "pyomodule.h"
+
+/* Number of frames of a cache block and number of blocks per sound file. */
+#define PYO_DISK_BLOCK_FRAMES 16384
+#define PYO_DISK_SLOTS 4
+/* Number of threads reading the sound files. */
+#define PYO_DISK_READ_THREADS 2
+
+enum
+{
+    PyoDiskSlotEmpty = 0,
+    PyoDiskSlotRequested, /* waiting for an I/O thread */
+    PyoDiskSlotLoading, /* being read by an I/O thread */
+    PyoDiskSlotReady
+};
+
+typedef struct
+{
+    int state;
+    sf_count_t block; /* index of the block of frames held by the slot */
+    sf_count_t frames; /* frames read, less than a block at the end of the file */
+    unsigned long stamp; /* last use, for eviction */
+    MYFLT *data; /* interleaved frames */
+} PyoDiskSlot;
+
+/* A sound file read ahead by the I/O threads. The audio thread only copies
+   frames from the cached blocks and asks for the blocks it will need next.
+   Only the I/O threads (and the audio thread of a blocking reader, on a
+   miss) call libsndfile, under the reader's lock. */
+typedef struct _PyoDiskReader
+{
+    SNDFILE *sf;
+    SF_INFO info;
+    pthread_mutex_t lock; /* Protects sf. */
+    PyoDiskSlot slots[PYO_DISK_SLOTS];
+    unsigned long stamp;
+    int blocking; /* Reads the missing frames instead of dropping them (offline servers). */
+    int busy; /* I/O threads reading this file. */
+    unsigned long underruns; /* Blocks that missed frames not loaded in time */
+    struct _PyoDiskReader *next;
+} PyoDiskReader;
+
+PyoDiskReader * DiskReader_new(const char *path, SF_INFO *info, int blocking);
+void DiskReader_free(PyoDiskReader *self);
+sf_count_t DiskReader_read(PyoDiskReader *self, sf_count_t pos, MYFLT *buffer, sf_count_t frames);
+void DiskReader_prefetch(PyoDiskReader *self, sf_count_t pos);
+void DiskReader_wait(PyoDiskReader *self, sf_count_t pos);
+unsigned long DiskReader_getUnderruns(PyoDiskReader *self);
+
+#endif // _DISKREADER_H
@@ -0,0 +1,55 @@
+/**************************************************************************
+ * Copyright 2009-2015 Olivier Belanger                                   *
+ *                                                                        *
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *
+ *                                                                        *
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with pyo.  If not, see <http://www.gnu.org/licenses/>.   *
+ *************************************************************************/
+#ifndef _DISKWRITER_H
+#define _DISKWRITER_H
+
+#include <pthread.h>
+#include "sndfile.h"
+#include "pyomodule.h"
+
+/* Default size, in frames, of the ring buffer of a recording. */
+#define PYO_DISK_RING_FRAMES 65536
+
+/* A sound file written by the disk writer thread. The audio thread pushes
+   samples into a single-producer single-consumer ring buffer and never
+   waits for the disk, unless the stream is blocking (offline rendering). */
+typedef struct _PyoDiskStream
+{
+    SNDFILE *file;
+    char *ring;
+    int samplesize; /* sizeof(float) or sizeof(double) */
+    unsigned long size; /* ring size in samples, a multiple of the number of channels */
+    unsigned long head; /* samples written by the audio thread */
+    unsigned long tail; /* samples written to disk */
+    int blocking;
+    int closing;
+    int closed;
+    int released; /* freed by the disk writer thread once closed */
+    unsigned long overruns; /* blocks dropped because the ring was full */
+    struct _PyoDiskStream *next;
+} PyoDiskStream;
+
+PyoDiskStream * DiskStream_new(SNDFILE *file, int chnls, int samplesize, long frames, int blocking);
+int DiskStream_write(PyoDiskStream *self, const void *samples, long count);
+unsigned long DiskStream_close(PyoDiskStream *self);
+void DiskStream_release(PyoDiskStream *self);
+unsigned long DiskStream_getOverruns(PyoDiskStream *self);
+
+#endif // _DISKWRITER_H
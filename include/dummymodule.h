@@ -24,15 +24,36 @@
 #include <Python.h>
 #include "pyomodule.h"
 
+/* Arithmetic operators between audio objects build Dummy objects. A Dummy
+   used as the operand of another one, and not requested by anything else,
+   is not computed on its own: it is inlined and its parent evaluates the
+   whole expression, chunk by chunk, in a single pass. Other Dummy objects
+   are computed every block. */
+#define PYO_DUMMY_CHUNK 256 /* samples evaluated at once by an expression. */
+#define PYO_DUMMY_MAX_NODES 32 /* Dummy objects fused in one expression. */
+
+/* Operations of Dummy_fromOperation. */
+#define PYO_DUMMY_MUL 0
+#define PYO_DUMMY_ADD 1
+#define PYO_DUMMY_SUB 2
+#define PYO_DUMMY_DIV 3
+
 typedef struct
 {
     pyo_audio_HEAD
     PyObject *input;
     Stream *input_stream;
     int modebuffer[3]; // need at least 2 slots for mul & add
+    int inlined[3]; /* mul, add and input are computed by this object. */
+    int requested; /* the stream is read by another object or played. */
+    int fused; /* inlined in another Dummy, which computes it. */
+    int nodes; /* Dummy objects evaluated by this one, itself included. */
+    MYFLT *scratch; /* chunks of the inlined mul and add. */
 } Dummy;
 
 extern PyObject * Dummy_initialize(Dummy *self);
+extern PyObject * Dummy_fromOperation(PyObject *input, PyObject *arg, int op);
+extern void Dummy_visitInlined(PyObject *obj, visitproc visit, void *arg);
 
 #define MAKE_NEW_DUMMY(self, type, rt_error)    \
 (self) = (Dummy *)(type)->tp_alloc((type), 0);  \
@@ -23,6 +23,47 @@
 
 #include "pyomodule.h"
 
+/* Transform types of the plans. */
+#define PYO_FFT_REAL 0          /* real signal, split format of realfft_split */
+#define PYO_FFT_REAL_PACKED 1   /* real signal, packed format of realfft_packed */
+
+#define PYO_FFT_MAX_STAGES 32
+
+/* A plan holds the tables of a transform of a given size and type. Plans
+   are shared: fft_plan_acquire returns the cached plan of the same size and
+   type if any, fft_plan_release frees it with its last user. Executing a
+   plan doesn't modify it, so a plan can be used by several threads. */
+typedef struct PyoFFTPlan
+{
+    int size;
+    int type;
+    int refcount;
+    int nstages;
+    int radix[PYO_FFT_MAX_STAGES];
+    MYFLT *stage_real[PYO_FFT_MAX_STAGES];
+    MYFLT *stage_imag[PYO_FFT_MAX_STAGES];
+    MYFLT *stage_twiddle;
+    MYFLT *real_twiddle;
+    MYFLT **split_twiddle;
+    MYFLT *packed_twiddle;
+    void *external[2];
+    struct PyoFFTPlan *next;
+} PyoFFTPlan;
+
+/* Sizes accepted by the PYO_FFT_REAL plans: even sizes whose half is a
+   product of 2, 3 and 5 (e.g. 1536 or 3000). PYO_FFT_REAL_PACKED plans need
+   a power of two. */
+int fft_valid_size(int size, int type);
+/* Smallest valid size greater than or equal to `size`. */
+int fft_next_size(int size, int type);
+PyoFFTPlan * fft_plan_acquire(int size, int type);
+void fft_plan_release(PyoFFTPlan *plan);
+/* Same conventions as realfft_split/irealfft_split (or the packed versions):
+   the forward transform is normalized by the size, the inverse is not.
+   `data` is used as scratch memory, `outdata` must be another array. */
+void fft_plan_forward(PyoFFTPlan *plan, MYFLT *data, MYFLT *outdata);
+void fft_plan_inverse(PyoFFTPlan *plan, MYFLT *data, MYFLT *outdata);
+
 /* in-place split-radix real fft */
 void realfft_split(MYFLT *data, MYFLT *outdata, int n, MYFLT **twiddle);
 void irealfft_split(MYFLT *data, MYFLT *outdata, int n, MYFLT **twiddle);
@@ -17,69 +17,26 @@
  * You should have received a copy of the GNU Lesser General Public       *
  * License along with pyo.  If not, see <http://www.gnu.org/licenses/>.   *
  *************************************************************************/
+#ifndef _GRAINKERNEL_H
+#define _GRAINKERNEL_H
 
-#include "interpolation.h"
 #include "pyomodule.h"
-#include <math.h>
+#include "muladd.h"
 
-MYFLT nointerp(MYFLT *buf, T_SIZE_T index, MYFLT frac, T_SIZE_T size)
-{
-    return  buf[index];
-}
+/* Grain kernels of the granular synthesis objects. The implementation
+   (scalar or AVX2) is selected at runtime by grainkernel_init(). All
+   kernels give the same results, sample by sample, as the scalar one. */
 
-MYFLT linear(MYFLT *buf, T_SIZE_T index, MYFLT frac, T_SIZE_T size)
-{
-    MYFLT x1 = buf[index];
-    MYFLT x2 = buf[index + 1];
-    return (x1 + (x2 - x1) * frac);
-}
+/* Adds one grain to `out` over `size` samples:
 
-MYFLT cosine(MYFLT *buf, T_SIZE_T index, MYFLT frac, T_SIZE_T size)
-{
-    MYFLT frac2;
-    MYFLT x1 = buf[index];
-    MYFLT x2 = buf[index + 1];
+       out[i] += table(index[i]) * env(phase[i] * envsize)
 
-    frac2 = (1.0 - MYCOS(frac * M_PI)) * 0.5;
-    return (x1 + (x2 - x1) * frac2);
-}
+   both tables being read with linear interpolation, and table(x) being 0
+   when x is outside [0, tablesize). The tables must have a guard point. */
+extern void (*grainkernel_accumulate)(MYFLT *PYO_RESTRICT out, const MYFLT *PYO_RESTRICT phase, const MYFLT *PYO_RESTRICT index,
+                                      const MYFLT *env, T_SIZE_T envsize, const MYFLT *table, T_SIZE_T tablesize, int size);
 
-MYFLT cubic(MYFLT *buf, T_SIZE_T index, MYFLT frac, T_SIZE_T size)
-{
-    MYFLT x0, x3, a0, a1, a2, a3;
-    MYFLT x1 = buf[index];
-    MYFLT x2 = buf[index + 1];
+void grainkernel_init(void);
+const char * grainkernel_name(void);
 
-    if (index == 0)
-    {
-        x0 = x1 + (x1 - x2);
-        x3 = buf[index + 2];
-    }
-    else if (index >= (size - 2))
-    {
-        x0 = buf[index - 1];
-        x3 = x2 + (x2 - x1);
-    }
-    else
-    {
-        x0 = buf[index - 1];
-        x3 = buf[index + 2];
-    }
-
-    a3 = frac * frac;
-    a3 -= 1.0;
-    a3 *= (1.0 / 6.0);
-    a2 = (frac + 1.0) * 0.5;
-    a0 = a2 - 1.0;
-    a1 = a3 * 3.0;
-    a2 -= a1;
-    a0 -= a3;
-    a1 -= frac;
-    a0 *= frac;
-    a1 *= frac;
-    a2 *= frac;
-    a3 *= frac;
-    a1 += 1.0;
-
-    return (a0 * x0 + a1 * x1 + a2 * x2 + a3 * x3);
-}
\ No newline at end of file
+#endif // _GRAINKERNEL_H
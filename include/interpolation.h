@@ -20,11 +20,113 @@
 #ifndef _INTERPOLATION_H
 #define _INTERPOLATION_H
 
+#include <math.h>
 #include "pyomodule.h"
 
-MYFLT nointerp(MYFLT *buf, T_SIZE_T index, MYFLT frac, T_SIZE_T size);
-MYFLT linear(MYFLT *buf, T_SIZE_T index, MYFLT frac, T_SIZE_T size);
-MYFLT cosine(MYFLT *buf, T_SIZE_T index, MYFLT frac, T_SIZE_T size);
-MYFLT cubic(MYFLT *buf, T_SIZE_T index, MYFLT frac, T_SIZE_T size);
+/* Table interpolation functions. They are defined in the header so that
+   processing loops calling them directly get them inlined. `buf` must
+   hold a guard point after `size` samples. */
+
+static inline MYFLT
+nointerp(MYFLT *buf, T_SIZE_T index, MYFLT frac, T_SIZE_T size)
+{
+    return  buf[index];
+}
+
+static inline MYFLT
+linear(MYFLT *buf, T_SIZE_T index, MYFLT frac, T_SIZE_T size)
+{
+    MYFLT x1 = buf[index];
+    MYFLT x2 = buf[index + 1];
+    return (x1 + (x2 - x1) * frac);
+}
+
+static inline MYFLT
+cosine(MYFLT *buf, T_SIZE_T index, MYFLT frac, T_SIZE_T size)
+{
+    MYFLT frac2;
+    MYFLT x1 = buf[index];
+    MYFLT x2 = buf[index + 1];
+
+    frac2 = (1.0 - MYCOS(frac * M_PI)) * 0.5;
+    return (x1 + (x2 - x1) * frac2);
+}
+
+static inline MYFLT
+cubic(MYFLT *buf, T_SIZE_T index, MYFLT frac, T_SIZE_T size)
+{
+    MYFLT x0, x3, a0, a1, a2, a3;
+    MYFLT x1 = buf[index];
+    MYFLT x2 = buf[index + 1];
+
+    if (index == 0)
+    {
+        x0 = x1 + (x1 - x2);
+        x3 = buf[index + 2];
+    }
+    else if (index >= (size - 2))
+    {
+        x0 = buf[index - 1];
+        x3 = x2 + (x2 - x1);
+    }
+    else
+    {
+        x0 = buf[index - 1];
+        x3 = buf[index + 2];
+    }
+
+    a3 = frac * frac;
+    a3 -= 1.0;
+    a3 *= (1.0 / 6.0);
+    a2 = (frac + 1.0) * 0.5;
+    a0 = a2 - 1.0;
+    a1 = a3 * 3.0;
+    a2 -= a1;
+    a0 -= a3;
+    a1 -= frac;
+    a0 *= frac;
+    a1 *= frac;
+    a2 *= frac;
+    a3 *= frac;
+    a1 += 1.0;
+
+    return (a0 * x0 + a1 * x1 + a2 * x2 + a3 * x3);
+}
+
+/* Whole-block variants: read the table at the `n` positions of `pos`, in
+   samples, and write the results to `out`. Selected once per mode (see
+   SET_INTERP_BLOCK_POINTER), they replace a call through a function
+   pointer for each sample by a single call per block whose loop the
+   compiler can unroll and vectorize. */
+typedef void (*interp_block_func)(MYFLT *table, T_SIZE_T size, double *pos, MYFLT *out, int n);
+
+#define INTERP_BLOCK(interp) \
+static inline void \
+interp_block_##interp(MYFLT *table, T_SIZE_T size, double *pos, MYFLT *out, int n) \
+{ \
+    int i; \
+    T_SIZE_T ipart; \
+    for (i = 0; i < n; i++) { \
+        ipart = (T_SIZE_T)pos[i]; \
+        out[i] = interp(table, ipart, (MYFLT)(pos[i] - ipart), size); \
+    } \
+}
+
+INTERP_BLOCK(nointerp)
+INTERP_BLOCK(linear)
+INTERP_BLOCK(cosine)
+INTERP_BLOCK(cubic)
+
+/* SET_INTERP_POINTER for objects that also hold an interp_block_ptr. */
+#define SET_INTERP_BLOCK_POINTER \
+    SET_INTERP_POINTER \
+    if (self->interp == 1) \
+        self->interp_block_ptr = interp_block_nointerp; \
+    else if (self->interp == 2) \
+        self->interp_block_ptr = interp_block_linear; \
+    else if (self->interp == 3) \
+        self->interp_block_ptr = interp_block_cosine; \
+    else if (self->interp == 4) \
+        self->interp_block_ptr = interp_block_cubic;
 
 #endif // _INTERPOLATION_H
@@ -0,0 +1,40 @@
+/**************************************************************************
+ * Copyright 2009-2015 Olivier Belanger                                   *
+ *                                                                        *
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *
+ *                                                                        *
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with pyo.  If not, see <http://www.gnu.org/licenses/>.   *
+ *************************************************************************/
+#ifndef _MIXBUS_H
+#define _MIXBUS_H
+
+#include "pyomodule.h"
+
+/* Output mix bus kernels. The implementation (scalar, SSE, AVX or NEON)
+   is selected at runtime by mixbus_init(). All kernels give the same
+   results, sample by sample, as the scalar versions. */
+
+/* dst[i] += src[i] */
+extern void (*mixbus_accumulate)(MYFLT *dst, const MYFLT *src, int size);
+/* dst[i] = (float)src[i] * gain */
+extern void (*mixbus_scale)(float *dst, const MYFLT *src, MYFLT gain, int size);
+/* dst[i] = (float)src[i] * gain[i] */
+extern void (*mixbus_ramp)(float *dst, const MYFLT *src, const MYFLT *gain, int size);
+
+void mixbus_init(void);
+const char * mixbus_name(void);
+void mixbus_interleave(float *dst, const float *src, int nchnls, int size);
+
+#endif // _MIXBUS_H
@@ -0,0 +1,64 @@
+/**************************************************************************
+ * Copyright 2009-2015 Olivier Belanger                                   *
+ *                                                                        *
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *
+ *                                                                        *
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with pyo.  If not, see <http://www.gnu.org/licenses/>.   *
+ *************************************************************************/
+#ifndef _MULADD_H
+#define _MULADD_H
+
+#include "pyomodule.h"
+
+#if defined(_MSC_VER)
+#define PYO_RESTRICT __restrict
+#else
+#define PYO_RESTRICT __restrict__
+#endif
+
+/* Mul & add kernels used by the POST_PROCESSING macros, applied in place
+   on an object's output buffer (muladd_copy writes the result of another
+   buffer). The implementation (scalar, SSE, AVX or
+   NEON) is selected at runtime by muladd_init(). Buffers aligned on the
+   vector size take aligned loads and stores. All kernels give the same
+   results, sample by sample, as the scalar versions. The suffixes follow
+   the macro names: `i` for a float, `a` for an audio stream and `reva`
+   for a stream used in reverse (division or subtraction). */
+
+/* data[i] = data[i] * mul + add */
+extern void (*muladd_ii)(MYFLT *PYO_RESTRICT data, MYFLT mul, MYFLT add, int size);
+/* data[i] = src[i] * mul + add */
+extern void (*muladd_copy)(MYFLT *PYO_RESTRICT data, const MYFLT *PYO_RESTRICT src, MYFLT mul, MYFLT add, int size);
+/* data[i] = data[i] * mul[i] + add */
+extern void (*muladd_ai)(MYFLT *PYO_RESTRICT data, const MYFLT *PYO_RESTRICT mul, MYFLT add, int size);
+/* data[i] = data[i] * mul + add[i] */
+extern void (*muladd_ia)(MYFLT *PYO_RESTRICT data, MYFLT mul, const MYFLT *PYO_RESTRICT add, int size);
+/* data[i] = data[i] * mul[i] + add[i] */
+extern void (*muladd_aa)(MYFLT *PYO_RESTRICT data, const MYFLT *PYO_RESTRICT mul, const MYFLT *PYO_RESTRICT add, int size);
+/* data[i] = data[i] * mul - add[i] */
+extern void (*muladd_ireva)(MYFLT *PYO_RESTRICT data, MYFLT mul, const MYFLT *PYO_RESTRICT add, int size);
+/* data[i] = data[i] * mul[i] - add[i] */
+extern void (*muladd_areva)(MYFLT *PYO_RESTRICT data, const MYFLT *PYO_RESTRICT mul, const MYFLT *PYO_RESTRICT add, int size);
+/* data[i] = data[i] / mul[i] + add, mul[i] near 0 replaced by 0.00001 */
+extern void (*muladd_revai)(MYFLT *PYO_RESTRICT data, const MYFLT *PYO_RESTRICT mul, MYFLT add, int size);
+/* data[i] = data[i] / mul[i] + add[i] */
+extern void (*muladd_revaa)(MYFLT *PYO_RESTRICT data, const MYFLT *PYO_RESTRICT mul, const MYFLT *PYO_RESTRICT add, int size);
+/* data[i] = data[i] / mul[i] - add[i] */
+extern void (*muladd_revareva)(MYFLT *PYO_RESTRICT data, const MYFLT *PYO_RESTRICT mul, const MYFLT *PYO_RESTRICT add, int size);
+
+void muladd_init(void);
+const char * muladd_name(void);
+
+#endif // _MULADD_H
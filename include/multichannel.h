@@ -0,0 +1,106 @@
+/**************************************************************************
+ * Copyright 2009-2015 Olivier Belanger                                   *
+ *                                                                        *
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *
+ *                                                                        *
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with pyo.  If not, see <http://www.gnu.org/licenses/>.   *
+ *************************************************************************/
+
+#ifndef _MULTICHANNEL_H
+#define _MULTICHANNEL_H
+
+#include <Python.h>
+#include "pyomodule.h"
+#include "streammodule.h"
+
+/* Native multichannel objects.
+ *
+ * Instead of one object per channel, a multichannel object computes all the
+ * channels of a PyoObject in a single call. The channels are written one
+ * after the other in `buffer_streams` (chnls * bufsize samples, channel c
+ * starting at c * bufsize). Each channel is exposed by a MultiChannel object,
+ * which copies its part of the buffer while applying its own float mul and
+ * add, in a single pass. These are the `_base_objs` of the Python object, the
+ * multichannel object being its only `_base_players` item.
+ *
+ * The setters of a multichannel object take the values of all the channels,
+ * or the value of a single channel followed by its number. The setters of
+ * a MultiChannel object are forwarded with its channel number, so that
+ * `obj._base_objs[i].setFreq(x)` works as with the per-channel objects. The
+ * multichannel object also keeps the mul of each channel, to skip the
+ * channels muted by a silent mul stream as the per-channel objects do.
+ *
+ * The processing loops run over groups of PYO_MULTI_LANES channels, with
+ * the channel as the inner index, so that the recursions of the channels
+ * are computed side by side (and in the vector registers when possible). */
+#define PYO_MULTI_LANES 8
+
+/* Attribute given per channel, each value being a float or an audio object. */
+typedef struct
+{
+    PyObject *list; /* Value of each channel. */
+    MYFLT *values; /* Float value of each channel. */
+    Stream **streams; /* Stream of each channel (borrowed), NULL for a float. */
+    int audio; /* Number of channels given as an audio object. */
+} MultiParam;
+
+#define pyo_multi_HEAD \
+    pyo_audio_HEAD \
+    int chnls; \
+    MYFLT *buffer_streams; \
+    MultiParam muls; /* mul of the MultiChannel object of each channel. */
+
+typedef struct
+{
+    pyo_multi_HEAD
+} MultiObject;
+
+/* Sets the values of the chnls channels from a list (wrapped when shorter),
+   a float or an audio object, swapped under the lock of the streams of
+   `server`. Returns -1 with an exception set on failure. */
+extern int MultiParam_set(MultiParam *self, PyObject *arg, int chnls, PyObject *server);
+/* Same as MultiParam_set, from the arguments of a setter: the values, and
+   optionally the number of the only channel to set. */
+extern int MultiParam_setArgs(MultiParam *self, PyObject *args, int chnls, PyObject *server);
+/* Channels first to first+lanes-1 are all given as floats. */
+extern int MultiParam_isFloat(MultiParam *self, int first, int lanes);
+extern void MultiParam_free(MultiParam *self);
+
+/* Sets the chnls integers of `values` from a list (wrapped when shorter) or
+   an integer. Returns -1 with an exception set on failure. */
+extern int Multi_setInts(int *values, PyObject *arg, int chnls);
+/* Same as Multi_setInts, from the arguments of a setter (see
+   MultiParam_setArgs). */
+extern int Multi_setIntsArgs(int *values, PyObject *args, int chnls);
+
+/* Allocates the buffer of the channels and sets their mul to 1, returns -1
+   on failure. */
+extern int MultiObject_allocBuffer(MultiObject *self);
+extern void MultiObject_freeBuffer(MultiObject *self);
+/* Channels first to first+lanes-1 are all muted by their mul. */
+extern int MultiObject_isMuted(MultiObject *self, int first, int lanes);
+
+#define MULTIPARAM_VISIT(p) Py_VISIT((p).list);
+#define MULTIPARAM_CLEAR(p) Py_CLEAR((p).list);
+
+#define pyo_multi_VISIT \
+    pyo_VISIT \
+    MULTIPARAM_VISIT(self->muls)
+
+#define pyo_multi_CLEAR \
+    pyo_CLEAR \
+    MULTIPARAM_CLEAR(self->muls)
+
+#endif // _MULTICHANNEL_H
@@ -0,0 +1,68 @@
+/**************************************************************************
+ * Copyright 2009-2015 Olivier Belanger                                   *
+ *                                                                        *
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *
+ *                                                                        *
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with pyo.  If not, see <http://www.gnu.org/licenses/>.   *
+ *************************************************************************/
+
+#ifndef _OSCILLATORBANK_H
+#define _OSCILLATORBANK_H
+
+#include "pyomodule.h"
+
+/* Bank of table oscillators for additive synthesis.
+ *
+ * The state of the oscillators is stored in arrays (one array per field,
+ * indexed by oscillator), so that consecutive oscillators can be computed
+ * side by side. The increment and the amplitude of an oscillator follow
+ * linear ramps: the owner sets new targets at control rate, with
+ * OscillatorBank_rampTo(), and the bank moves toward them sample by sample.
+ *
+ * The kernel (scalar or AVX2) is selected at runtime by
+ * oscillatorbank_init(). Both kernels sum the oscillators in the same
+ * order and give the same results. */
+
+typedef struct
+{
+    int size; /* Number of oscillators. */
+    MYFLT *memory; /* Single block holding all the arrays below. */
+    MYFLT *phase; /* Reading position in the table. */
+    MYFLT *inc; /* Position increment, in table samples per sample. */
+    MYFLT *amp;
+    MYFLT *incStep; /* Added to `inc` after each sample. */
+    MYFLT *ampStep; /* Added to `amp` after each sample. */
+} OscillatorBank;
+
+/* (Re)allocates the bank for `size` oscillators. All the fields of all the
+   oscillators are reset to 0. Returns -1 on failure. */
+extern int OscillatorBank_alloc(OscillatorBank *self, int size);
+extern void OscillatorBank_free(OscillatorBank *self);
+
+/* Sets the increment and the amplitude of oscillator `k`, without ramp. */
+extern void OscillatorBank_set(OscillatorBank *self, int k, MYFLT inc, MYFLT amp);
+/* Sets the steps of oscillator `k` so that its increment and its amplitude
+   reach `inc` and `amp` after `n` samples. */
+extern void OscillatorBank_rampTo(OscillatorBank *self, int k, MYFLT inc, MYFLT amp, int n);
+
+/* Adds `n` samples of the first `count` oscillators to `out`. The table is
+   read with linear interpolation and must have a guard point. The phases
+   are wrapped in [0, tablesize) before being read. */
+extern void OscillatorBank_process(OscillatorBank *self, int count, const MYFLT *table, T_SIZE_T tablesize, MYFLT *out, int n);
+
+void oscillatorbank_init(void);
+const char * oscillatorbank_name(void);
+
+#endif // _OSCILLATORBANK_H
@@ -62,6 +62,7 @@ typedef Py_ssize_t T_SIZE_T;
 #define TYPE_O_IFS "O|ifs"
 #define TYPE_S_IFF "s|iff"
 #define TYPE_P_IFF "s#|iff"
+#define TYPE_P_IFFIZ "s#|iffiz"
 #define TYPE_S_FIFF "s|fiff"
 #define TYPE_P_FIFF "s#|fiff"
 #define TYPE_S_FFIFF "s|ffiff"
@@ -158,6 +159,7 @@ typedef Py_ssize_t T_SIZE_T;
 #define TYPE_O_IFS "O|ids"
 #define TYPE_S_IFF "s|idd"
 #define TYPE_P_IFF "s#|idd"
+#define TYPE_P_IFFIZ "s#|iddiz"
 #define TYPE_S_FIFF "s|didd"
 #define TYPE_P_FIFF "s#|didd"
 #define TYPE_S_FFIFF "s|ddidd"
@@ -232,6 +234,14 @@ typedef Py_ssize_t T_SIZE_T;
 #include "externalmodule.h"
 #endif
 
+#include "muladd.h"
+#include "arena.h"
+
+/* Locks the processing of the streams while a setter swaps the values read
+   by the audio thread (only contended in GIL-free mode, see servermodule.c). */
+extern void Server_lockProcessing(PyObject *server);
+extern void Server_unlockProcessing(PyObject *server);
+
 #ifdef USE_PORTMIDI
 extern PyTypeObject MidiListenerType;
 extern PyTypeObject MidiDispatcherType;
@@ -247,6 +257,7 @@ extern PyTypeObject OscListReceiveType;
 extern PyTypeObject OscListReceiverType;
 #endif
 extern PyTypeObject SineType;
+extern PyTypeObject SineMultiType;
 extern PyTypeObject FastSineType;
 extern PyTypeObject SineLoopType;
 extern PyTypeObject FmType;
@@ -316,10 +327,14 @@ extern PyTypeObject XnoiseMidiType;
 extern PyTypeObject XnoiseDurType;
 extern PyTypeObject UrnType;
 extern PyTypeObject BiquadType;
+extern PyTypeObject BiquadMultiType;
 extern PyTypeObject BiquadxType;
+extern PyTypeObject BiquadxMultiType;
 extern PyTypeObject BiquadaType;
 extern PyTypeObject EQType;
+extern PyTypeObject EQMultiType;
 extern PyTypeObject ToneType;
+extern PyTypeObject ToneMultiType;
 extern PyTypeObject AtoneType;
 extern PyTypeObject DCBlockType;
 extern PyTypeObject PortType;
@@ -430,6 +445,7 @@ extern PyTypeObject SPannerType;
 extern PyTypeObject SPanType;
 extern PyTypeObject PannerType;
 extern PyTypeObject PanType;
+extern PyTypeObject MultiChannelType;
 extern PyTypeObject SwitcherType;
 extern PyTypeObject SwitchType;
 extern PyTypeObject SelectorType;
@@ -676,8 +692,8 @@ extern PyTypeObject MMLZStreamType;
 
 #define pyo_DEALLOC \
     if (self->server != NULL && self->stream != NULL) \
-        Server_removeStream((Server *)self->server, Stream_getStreamId(self->stream)); \
-    PyMem_RawFree(self->data); \
+        Server_removeStream((Server *)self->server, self->stream); \
+    arena_free(self->data); \
 
 #define ASSERT_ARG_NOT_NULL \
     if (arg == NULL) { \
@@ -743,7 +759,7 @@ extern PyTypeObject MMLZStreamType;
     PyObject *ichobj = PyObject_CallMethod(self->server, "getIchnls", NULL); \
     self->ichnls = PyLong_AsLong(ichobj); \
     Py_DECREF(ichobj); \
-    self->data = (MYFLT *)PyMem_RawRealloc(self->data, (self->bufsize) * sizeof(MYFLT)); \
+    self->data = (MYFLT *)arena_alloc((self->bufsize) * sizeof(MYFLT)); \
     for (i=0; i<self->bufsize; i++) \
         self->data[i] = 0.0; \
     MAKE_NEW_STREAM(self->stream, &StreamType, NULL); \
@@ -751,6 +767,7 @@ extern PyTypeObject MMLZStreamType;
     Stream_setStreamId(self->stream, Stream_getNewStreamId()); \
     Stream_setBufferSize(self->stream, self->bufsize); \
     Stream_setData(self->stream, self->data); \
+    Stream_setState(self->stream, PYO_STREAM_SILENT); \
     Py_INCREF(self->stream);
 
 #define SET_INTERP_POINTER \
@@ -773,7 +790,7 @@ extern PyTypeObject MMLZStreamType;
         return PyLong_FromLong(-1); \
     } \
     self->size = (T_SIZE_T)PyList_Size(arg); \
-    self->data = (MYFLT *)PyMem_RawRealloc(self->data, (self->size+1) * sizeof(MYFLT)); \
+    self->data = (MYFLT *)arena_realloc(self->data, (self->size+1) * sizeof(MYFLT)); \
     TableStream_setSize(self->tablestream, self->size+1); \
  \
     for (i=0; i<(self->size); i++) { \
@@ -1468,7 +1485,7 @@ extern PyTypeObject MMLZStreamType;
  \
     T_SIZE_T size = PyLong_AsLong(value); \
  \
-    MYFLT *data = (MYFLT *)PyMem_RawRealloc(self->data, (size + 1) * sizeof(MYFLT)); \
+    MYFLT *data = (MYFLT *)arena_realloc(self->data, (size + 1) * sizeof(MYFLT)); \
     if (data != NULL) \
     { \
         self->data = data; \
@@ -1499,7 +1516,7 @@ extern PyTypeObject MMLZStreamType;
  \
     factor = (MYFLT)(self->size) / old_size; \
  \
-    self->data = (MYFLT *)PyMem_RawRealloc(self->data, (self->size + 1) * sizeof(MYFLT)); \
+    self->data = (MYFLT *)arena_realloc(self->data, (self->size + 1) * sizeof(MYFLT)); \
     TableStream_setSize(self->tablestream, self->size); \
  \
     T_SIZE_T listsize = PyList_Size(self->pointslist); \
@@ -1688,154 +1705,100 @@ extern PyTypeObject MMLZStreamType;
     Py_INCREF(self->pv_stream); \
     return (PyObject *)self->pv_stream;
 
-#define SET_MUL \
+/* The setters build the new value first, then swap it under the lock of
+   the streams (see Server_lockProcessing), so that the audio thread never
+   reads a released value in GIL-free mode. The old value is released last. */
+#define SET_MULADD_VALUE(member, memberstream, modebufpos, number, audiomode) \
     if (arg == NULL) { \
         Py_RETURN_NONE; \
     } \
  \
-    Py_DECREF(self->mul); \
+    PyObject *oldvalue = self->member, *newvalue; \
+    Stream *newstream = NULL; \
+    int newmode; \
  \
     if (PyNumber_Check(arg)) { \
-        self->mul = PyNumber_Float(arg); \
-        self->modebuffer[0] = 0; \
+        newvalue = number; \
+        newmode = 0; \
     } \
     else { \
-        self->mul = arg; \
-        Py_INCREF(self->mul); \
-        if (! PyObject_HasAttrString((PyObject *)self->mul, "_getStream")) { \
+        newvalue = arg; \
+        Py_INCREF(newvalue); \
+        if (! PyObject_HasAttrString(newvalue, "_getStream")) { \
             PyErr_SetString(PyExc_ArithmeticError, "Only number or audio internal object can be used in arithmetic with audio internal objects.\n"); \
             PyErr_Print(); \
         } \
-        PyObject *streamtmp = PyObject_CallMethod((PyObject *)self->mul, "_getStream", NULL); \
-        self->mul_stream = (Stream *)streamtmp; \
-        Py_INCREF(self->mul_stream); \
-        self->modebuffer[0] = 1; \
+        newstream = (Stream *)PyObject_CallMethod(newvalue, "_getStream", NULL); \
+        Py_XINCREF(newstream); \
+        newmode = audiomode; \
     } \
  \
+    Server_lockProcessing(self->server); \
+    self->member = newvalue; \
+    if (newstream != NULL) { \
+        self->memberstream = newstream; \
+        Stream_invalidateGraph(); \
+    } \
+    self->modebuffer[modebufpos] = newmode; \
     (*self->mode_func_ptr)(self); \
+    Server_unlockProcessing(self->server); \
+ \
+    Py_DECREF(oldvalue); \
  \
     Py_RETURN_NONE;
 
+#define SET_MUL \
+    SET_MULADD_VALUE(mul, mul_stream, 0, PyNumber_Float(arg), 1)
+
 #define SET_ADD \
-    if (arg == NULL) { \
-        Py_RETURN_NONE; \
-    } \
-\
-    Py_DECREF(self->add); \
- \
-    if (PyNumber_Check(arg)) { \
-        self->add = PyNumber_Float(arg); \
-        self->modebuffer[1] = 0; \
-    } \
-    else { \
-        self->add = arg; \
-        Py_INCREF(self->add); \
-        if (! PyObject_HasAttrString((PyObject *)self->add, "_getStream")) { \
-            PyErr_SetString(PyExc_ArithmeticError, "Only number or audio internal object can be used in arithmetic with audio internal objects.\n"); \
-            PyErr_Print(); \
-        } \
-        PyObject *streamtmp = PyObject_CallMethod((PyObject *)self->add, "_getStream", NULL); \
-        self->add_stream = (Stream *)streamtmp; \
-        Py_INCREF(self->add_stream); \
-        self->modebuffer[1] = 1; \
-    } \
-\
-    (*self->mode_func_ptr)(self); \
-\
-    Py_RETURN_NONE;
+    SET_MULADD_VALUE(add, add_stream, 1, PyNumber_Float(arg), 1)
 
 #define SET_SUB \
-    if (arg == NULL) { \
-        Py_RETURN_NONE; \
-    } \
- \
-    Py_DECREF(self->add); \
- \
-    if (PyNumber_Check(arg)) { \
-        double tmp = PyFloat_AsDouble(arg); \
-        self->add = PyFloat_FromDouble(tmp * -1.0); \
-        self->modebuffer[1] = 0; \
-    } \
-    else { \
-        self->add = arg; \
-        Py_INCREF(self->add); \
-        if (! PyObject_HasAttrString((PyObject *)self->add, "_getStream")) { \
-            PyErr_SetString(PyExc_ArithmeticError, "Only number or audio internal object can be used in arithmetic with audio internal objects.\n"); \
-            PyErr_Print(); \
-        } \
-        PyObject *streamtmp = PyObject_CallMethod((PyObject *)self->add, "_getStream", NULL); \
-        self->add_stream = (Stream *)streamtmp; \
-        Py_INCREF(self->add_stream); \
-        self->modebuffer[1] = 2; \
-    } \
- \
-    (*self->mode_func_ptr)(self); \
- \
-    Py_RETURN_NONE;
+    SET_MULADD_VALUE(add, add_stream, 1, PyFloat_FromDouble(PyFloat_AsDouble(arg) * -1.0), 2)
 
 #define SET_DIV \
-    if (arg == NULL) { \
+    if (arg != NULL && PyNumber_Check(arg) && PyFloat_AsDouble(arg) == 0.) { \
         Py_RETURN_NONE; \
     } \
  \
-    if (PyNumber_Check(arg)) { \
-        if (PyFloat_AsDouble(arg) != 0.) { \
-            Py_DECREF(self->mul); \
-            self->mul = PyFloat_FromDouble(1.0 / PyFloat_AsDouble(arg)); \
-            self->modebuffer[0] = 0; \
-        } \
-    } \
-    else { \
-        Py_DECREF(self->mul); \
-        self->mul = arg; \
-        Py_INCREF(self->mul); \
-        if (! PyObject_HasAttrString((PyObject *)self->mul, "_getStream")) { \
-            PyErr_SetString(PyExc_ArithmeticError, "Only number or audio internal object can be used in arithmetic with audio internal objects.\n"); \
-            PyErr_Print(); \
-        } \
-        PyObject *streamtmp = PyObject_CallMethod((PyObject *)self->mul, "_getStream", NULL); \
-        self->mul_stream = (Stream *)streamtmp; \
-        Py_INCREF(self->mul_stream); \
-        self->modebuffer[0] = 2; \
-    } \
- \
-    (*self->mode_func_ptr)(self); \
- \
-    Py_RETURN_NONE;
+    SET_MULADD_VALUE(mul, mul_stream, 0, PyFloat_FromDouble(1.0 / PyFloat_AsDouble(arg)), 2)
 
 #define SET_PARAM(param, paramstream, modebufpos) \
     if (arg == NULL) { \
         Py_RETURN_NONE; \
     } \
  \
-    Py_DECREF(param); \
+    PyObject *oldparam = param, *newparam; \
+    Stream *newparamstream = NULL; \
  \
     if (PyNumber_Check(arg)) { \
-        param = PyNumber_Float(arg); \
-        self->modebuffer[modebufpos] = 0; \
+        newparam = PyNumber_Float(arg); \
     } \
     else { \
-        param = arg; \
-        Py_INCREF(param); \
-        PyObject *streamtmp = PyObject_CallMethod((PyObject *)param, "_getStream", NULL); \
-        paramstream = (Stream *)streamtmp; \
-        Py_INCREF(paramstream); \
-        self->modebuffer[modebufpos] = 1; \
+        newparam = arg; \
+        Py_INCREF(newparam); \
+        newparamstream = (Stream *)PyObject_CallMethod(newparam, "_getStream", NULL); \
+        Py_XINCREF(newparamstream); \
     } \
  \
+    Server_lockProcessing(self->server); \
+    param = newparam; \
+    if (newparamstream != NULL) { \
+        paramstream = newparamstream; \
+        Stream_invalidateGraph(); \
+    } \
+    self->modebuffer[modebufpos] = newparamstream != NULL; \
     (*self->mode_func_ptr)(self); \
+    Server_unlockProcessing(self->server); \
+ \
+    Py_DECREF(oldparam); \
  \
     Py_RETURN_NONE;
 
-/* Multiply, Add, inplace_multiply & inplace_add */
+/* Multiply, Add, inplace_multiply & inplace_add. The operations build Dummy
+   objects, fused into a single expression when chained (see dummymodule.h). */
 #define MULTIPLY \
-    Dummy *dummy; \
-    MAKE_NEW_DUMMY(dummy, &DummyType, NULL); \
-    Dummy_initialize(dummy); \
-    PyObject_CallMethod((PyObject *)dummy, "setMul", "O", arg); \
-    PyObject_CallMethod((PyObject *)dummy, "setInput", "O", self); \
-    Py_INCREF(dummy); \
-    return (PyObject *)dummy;
+    return Dummy_fromOperation((PyObject *)self, arg, PYO_DUMMY_MUL);
 
 #define INPLACE_MULTIPLY \
     PyObject_CallMethod((PyObject *)self, "setMul", "O", arg); \
@@ -1843,13 +1806,7 @@ extern PyTypeObject MMLZStreamType;
     return (PyObject *)self;
 
 #define ADD \
-    Dummy *dummy; \
-    MAKE_NEW_DUMMY(dummy, &DummyType, NULL); \
-    Dummy_initialize(dummy); \
-    PyObject_CallMethod((PyObject *)dummy, "setAdd", "O", arg); \
-    PyObject_CallMethod((PyObject *)dummy, "setInput", "O", self); \
-    Py_INCREF(dummy); \
-    return (PyObject *)dummy;
+    return Dummy_fromOperation((PyObject *)self, arg, PYO_DUMMY_ADD);
 
 #define INPLACE_ADD \
     PyObject_CallMethod((PyObject *)self, "setAdd", "O", arg); \
@@ -1857,13 +1814,7 @@ extern PyTypeObject MMLZStreamType;
     return (PyObject *)self;
 
 #define SUB \
-    Dummy *dummy; \
-    MAKE_NEW_DUMMY(dummy, &DummyType, NULL); \
-    Dummy_initialize(dummy); \
-    PyObject_CallMethod((PyObject *)dummy, "setSub", "O", arg); \
-    PyObject_CallMethod((PyObject *)dummy, "setInput", "O", self); \
-    Py_INCREF(dummy); \
-    return (PyObject *)dummy;
+    return Dummy_fromOperation((PyObject *)self, arg, PYO_DUMMY_SUB);
 
 #define INPLACE_SUB \
     PyObject_CallMethod((PyObject *)self, "setSub", "O", arg); \
@@ -1871,13 +1822,7 @@ extern PyTypeObject MMLZStreamType;
     return (PyObject *)self;
 
 #define DIV \
-    Dummy *dummy; \
-    MAKE_NEW_DUMMY(dummy, &DummyType, NULL); \
-    Dummy_initialize(dummy); \
-    PyObject_CallMethod((PyObject *)dummy, "setDiv", "O", arg); \
-    PyObject_CallMethod((PyObject *)dummy, "setInput", "O", self); \
-    Py_INCREF(dummy); \
-    return (PyObject *)dummy;
+    return Dummy_fromOperation((PyObject *)self, arg, PYO_DUMMY_DIV);
 
 #define INPLACE_DIV \
     PyObject_CallMethod((PyObject *)self, "setDiv", "O", arg); \
@@ -1925,6 +1870,7 @@ extern PyTypeObject MMLZStreamType;
             Stream_setStreamActive(self->stream, 0); \
             for (i=0; i<self->bufsize; i++) \
                 self->data[i] = 0.0; \
+            Stream_setState(self->stream, PYO_STREAM_SILENT); \
             Stream_setBufferCountWait(self->stream, nearestBuf); \
         } \
     } \
@@ -1979,6 +1925,7 @@ extern PyTypeObject MMLZStreamType;
             Stream_setStreamActive(self->stream, 0); \
             for (i=0; i<self->bufsize; i++) \
                 self->data[i] = 0.0; \
+            Stream_setState(self->stream, PYO_STREAM_SILENT); \
             Stream_setBufferCountWait(self->stream, nearestBuf); \
         } \
     } \
@@ -2007,6 +1954,7 @@ extern PyTypeObject MMLZStreamType;
         for (i=0; i<self->bufsize; i++) { \
             self->data[i] = 0; \
         } \
+        Stream_setState(self->stream, PYO_STREAM_SILENT); \
     } \
     else { \
         Stream_resetBufferCount(self->stream); \
@@ -2015,117 +1963,65 @@ extern PyTypeObject MMLZStreamType;
     } \
     Py_RETURN_NONE;
 
-/* Post processing (mul & add) macros */
+/* Post processing (mul & add) macros, see Stream_mulAdd and muladd.h. */
 #define POST_PROCESSING_II \
-    MYFLT mul, add, old, val; \
-    int i; \
-    mul = PyFloat_AS_DOUBLE(self->mul); \
-    add = PyFloat_AS_DOUBLE(self->add); \
-    if (mul != 1 || add != 0) { \
-        for (i=0; i<self->bufsize; i++) { \
-            old = self->data[i]; \
-            val = mul * old + add; \
-            self->data[i] = val; \
-        } \
-    }
+    Stream_mulAdd(self->stream, self->data, self->bufsize, NULL, PyFloat_AS_DOUBLE(self->mul), \
+                  NULL, PyFloat_AS_DOUBLE(self->add), 0);
 
 #define POST_PROCESSING_AI \
-    MYFLT add, old, val; \
-    int i; \
-    MYFLT *mul = Stream_getData((Stream *)self->mul_stream); \
-    add = PyFloat_AS_DOUBLE(self->add); \
-    for (i=0; i<self->bufsize; i++) { \
-        old = self->data[i]; \
-        val = mul[i] * old + add; \
-        self->data[i] = val; \
-    }
+    Stream_mulAdd(self->stream, self->data, self->bufsize, self->mul_stream, 0, \
+                  NULL, PyFloat_AS_DOUBLE(self->add), 0);
 
 #define POST_PROCESSING_IA \
-    MYFLT mul, old, val; \
-    int i; \
-    mul = PyFloat_AS_DOUBLE(self->mul); \
-    MYFLT *add = Stream_getData((Stream *)self->add_stream); \
-    for (i=0; i<self->bufsize; i++) { \
-        old = self->data[i]; \
-        val = mul * old + add[i]; \
-        self->data[i] = val; \
-    }
+    Stream_mulAdd(self->stream, self->data, self->bufsize, NULL, PyFloat_AS_DOUBLE(self->mul), \
+                  self->add_stream, 0, 0);
 
 #define POST_PROCESSING_AA \
-    MYFLT old, val; \
-    int i; \
-    MYFLT *mul = Stream_getData((Stream *)self->mul_stream); \
-    MYFLT *add = Stream_getData((Stream *)self->add_stream); \
-    for (i=0; i<self->bufsize; i++) { \
-        old = self->data[i]; \
-        val = mul[i] * old + add[i]; \
-        self->data[i] = val; \
-    }
+    Stream_mulAdd(self->stream, self->data, self->bufsize, self->mul_stream, 0, \
+                  self->add_stream, 0, 0);
 
 #define POST_PROCESSING_REVAI \
-    MYFLT tmp, add, old, val; \
-    int i; \
-    MYFLT *mul = Stream_getData((Stream *)self->mul_stream); \
-    add = PyFloat_AS_DOUBLE(self->add); \
-    for (i=0; i<self->bufsize; i++) { \
-        old = self->data[i]; \
-        tmp = mul[i]; \
-        if (tmp < 0.00001 && tmp > -0.00001) \
-            tmp = 0.00001; \
-        val = old / tmp + add; \
-        self->data[i] = val; \
-    }
+    Stream_mulAdd(self->stream, self->data, self->bufsize, self->mul_stream, 0, \
+                  NULL, PyFloat_AS_DOUBLE(self->add), PYO_MULADD_REVMUL);
 
 #define POST_PROCESSING_REVAA \
-    MYFLT tmp, old, val; \
-    int i; \
-    MYFLT *mul = Stream_getData((Stream *)self->mul_stream); \
-    MYFLT *add = Stream_getData((Stream *)self->add_stream); \
-    for (i=0; i<self->bufsize; i++) { \
-        old = self->data[i]; \
-        tmp = mul[i]; \
-        if (tmp < 0.00001 && tmp > -0.00001) \
-            tmp = 0.00001; \
-        val = old / tmp + add[i]; \
-        self->data[i] = val; \
-    }
+    Stream_mulAdd(self->stream, self->data, self->bufsize, self->mul_stream, 0, \
+                  self->add_stream, 0, PYO_MULADD_REVMUL);
 
 #define POST_PROCESSING_IREVA \
-    MYFLT mul, old, val; \
-    int i; \
-    mul = PyFloat_AS_DOUBLE(self->mul); \
-    MYFLT *add = Stream_getData((Stream *)self->add_stream); \
-    for (i=0; i<self->bufsize; i++) { \
-        old = self->data[i]; \
-        val = mul * old - add[i]; \
-        self->data[i] = val; \
-    }
+    Stream_mulAdd(self->stream, self->data, self->bufsize, NULL, PyFloat_AS_DOUBLE(self->mul), \
+                  self->add_stream, 0, PYO_MULADD_REVADD);
 
 #define POST_PROCESSING_AREVA \
-    MYFLT old, val; \
-    int i; \
-    MYFLT *mul = Stream_getData((Stream *)self->mul_stream); \
-    MYFLT *add = Stream_getData((Stream *)self->add_stream); \
-    for (i=0; i<self->bufsize; i++) { \
-        old = self->data[i]; \
-        val = mul[i] * old - add[i]; \
-        self->data[i] = val; \
-    }
+    Stream_mulAdd(self->stream, self->data, self->bufsize, self->mul_stream, 0, \
+                  self->add_stream, 0, PYO_MULADD_REVADD);
 
 #define POST_PROCESSING_REVAREVA \
-    MYFLT tmp, old, val; \
-    int i; \
-    MYFLT *mul = Stream_getData((Stream *)self->mul_stream); \
-    MYFLT *add = Stream_getData((Stream *)self->add_stream); \
-    for (i=0; i<self->bufsize; i++) { \
-        old = self->data[i]; \
-        tmp = mul[i]; \
-        if (tmp < 0.00001 && tmp > -0.00001) \
-            tmp = 0.00001; \
-        val = old / tmp - add[i]; \
-        self->data[i] = val; \
+    Stream_mulAdd(self->stream, self->data, self->bufsize, self->mul_stream, 0, \
+                  self->add_stream, 0, PYO_MULADD_REVMUL | PYO_MULADD_REVADD);
+
+/* True when the audio mul is silent for the current block: the output is
+   then the add alone. Generators and filters can skip their processing
+   function, but must keep their state coherent (an oscillator still moves
+   its phase, a filter resets its memories). */
+#define MULADD_MUTED \
+    (self->modebuffer[0] == 1 && Stream_getState(self->mul_stream) == PYO_STREAM_SILENT)
+
+/* Fused mul & add. An object can apply a float mul and add while writing
+   its output, saving the post processing pass over self->data. Its
+   processing function starts with FUSED_MULADD_INIT and writes
+   FUSED_MULADD(val) instead of val; its setProcMode sets muladd_func_ptr
+   to an empty function when muladdmode is 0. With audio mul or add, the
+   values are left unchanged and the regular post processing applies. */
+#define FUSED_MULADD_INIT \
+    MYFLT fmul = 1, fadd = 0; \
+    if (self->modebuffer[0] == 0 && self->modebuffer[1] == 0) { \
+        fmul = PyFloat_AS_DOUBLE(self->mul); \
+        fadd = PyFloat_AS_DOUBLE(self->add); \
     }
 
+#define FUSED_MULADD(val) (fmul * (val) + fadd)
+
 /* Tables buffer protocol. */
 #define TABLESTREAM_GET_BUFFER \
     if (view == NULL) { \
@@ -0,0 +1,78 @@
+/**************************************************************************
+ * Copyright 2009-2015 Olivier Belanger                                   *
+ *                                                                        *
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *
+ *                                                                        *
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with pyo.  If not, see <http://www.gnu.org/licenses/>.   *
+ *************************************************************************/
+
+#ifndef _SCHEDULER_H
+#define _SCHEDULER_H
+
+#include <pthread.h>
+#include <stdint.h>
+#include "pyomodule.h"
+#include "streammodule.h"
+
+/* Maximum number of objects visited by a single stream. A stream
+   referencing more objects than that is computed serially. */
+#define PYO_SCHED_MAX_REFS 128
+
+typedef struct
+{
+    void *key;
+    unsigned int stamp;
+    int node; /* index in the segment for streams and their objects, -1 for shared resources. */
+    int readLevel; /* highest level of the streams reading this resource. */
+    int writeLevel; /* highest level of the streams writing this resource. */
+} SchedulerEntry;
+
+typedef struct
+{
+    int nworkers;
+    pthread_t *threads;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    unsigned int generation;
+    int quit;
+
+    /* Job currently dispatched to the workers (one dependency level). */
+    Stream **job;
+    int jobCount;
+    uint64_t ticket; /* generation of the job in the high bits, next stream to compute in the low bits. */
+    int done; /* streams of the job computed. */
+    int waiting; /* workers sleeping on cond. */
+
+    /* Graph of the current segment. */
+    int capacity;
+    Stream **nodes;
+    int *level;
+    int *readLevel;
+    int *levelCount;
+    Stream **order;
+    SchedulerEntry *table;
+    unsigned int tableSize;
+    unsigned int stamp;
+    PyObject *server;
+    PyObject *refs[PYO_SCHED_MAX_REFS];
+    int nrefs;
+} PyoScheduler;
+
+PyoScheduler * Scheduler_new(int nworkers);
+void Scheduler_free(PyoScheduler *self);
+void Scheduler_reserve(PyoScheduler *self, int capacity);
+int Scheduler_process(PyoScheduler *self, Stream **streams, int start, int count, PyObject *server);
+
+#endif // _SCHEDULER_H
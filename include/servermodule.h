@@ -28,8 +28,13 @@
 extern "C" {
 #endif
 
+#include <pthread.h>
 #include "sndfile.h"
 #include "pyomodule.h"
+#include "streammodule.h"
+#include "scheduler.h"
+#include "bufferpool.h"
+#include "diskwriter.h"
 
 #ifdef __APPLE__
 #include <CoreAudio/AudioHardware.h>
@@ -71,12 +76,50 @@ typedef struct
     PyoMidiTimestamp    timestamp;
 } PyoMidiEvent;
 
+/* Largest number of samples between two computations of the coefficients
+   of a filter modulated at audio rate (see Server.setCoeffRate). */
+#define PYO_COEFFRATE_MAX 1024
+
+/* Python-touching work posted by the audio thread in GIL-free mode. */
+
+#define PYO_DEFERRED_QUEUE_SIZE 4096 /* Must be a power-of-two. */
+
+typedef enum
+{
+    PyoDeferStop = 0,       /* call the stop method of the stream's object. */
+    PyoDeferCallback = 1,   /* call the stream's callback function. */
+    PyoDeferServerCallback, /* call the Server's CALLBACK. */
+    PyoDeferGui,            /* send rms values to the Server's GUI. */
+    PyoDeferTime            /* send the current time to the Server's GUI. */
+} PyoDeferredType;
+
+typedef struct
+{
+    Stream *stream;
+    int type;
+} PyoDeferredCall;
+
+/* Reorder asked while the audio thread iterates over the streams, done
+   at the end of the block. `cur` is moved just before `ref`. */
+typedef struct
+{
+    Stream *ref;
+    Stream *cur;
+} PyoStreamMove;
+
 /************************************************/
 
 typedef struct
 {
     PyObject_HEAD
-    PyObject *streams;
+    Stream **stream_array; /* Streams in processing order, removed ones leave a NULL slot. */
+    int stream_array_size;
+    int stream_holes; /* Number of NULL slots in stream_array. */
+    int stream_iterating; /* The audio thread is iterating over stream_array. */
+    PyoStreamMove *stream_moves; /* Reorders deferred while iterating. */
+    int stream_moves_count;
+    int stream_moves_size;
+    pthread_mutex_t stream_lock; /* Protects the streams against the audio thread in GIL-free mode. */
     PyoAudioBackendType audio_be_type;
     PyoMidiBackendType midi_be_type;
     void *audio_be_data;
@@ -124,6 +167,23 @@ typedef struct
     int record;
     int thisServerID;       /* To keep the reference index in the array of servers */
 
+    /* GIL-free processing */
+    int gilFree; /* if true, the audio thread computes the streams without holding the GIL. */
+    PyoDeferredCall deferred[PYO_DEFERRED_QUEUE_SIZE]; /* lock-free single-producer single-consumer queue. */
+    unsigned int deferredHead; /* written by the audio thread only. */
+    unsigned int deferredTail; /* written by the consumer, always with the GIL held. */
+    unsigned int deferredOverflows;
+    unsigned int deferredOverflowsReported;
+    unsigned int lockMisses; /* blocks replayed because another thread held the streams. */
+    unsigned int lockMissesReported;
+    int ctlThreadRunning;
+    pthread_t ctlThread;
+    int nworkers; /* Number of threads helping the audio thread to compute the streams. */
+    PyoScheduler *scheduler;
+    PyoBufferPool *bufferpool; /* NULL unless the streams share their buffers. */
+    int multichannel; /* if true, the objects that can compute all their channels in a single object do so. */
+    int coeffrate; /* default number of samples between two computations of the modulated filter coefficients. */
+
 #ifdef __APPLE__
     pthread_mutex_t buf_mutex;
     pthread_cond_t buf_cond;
@@ -142,6 +202,9 @@ typedef struct
 
     MYFLT *input_buffer;
     float *output_buffer; /* Has to be float since audio callbacks must use floats */
+    float *planar_output_buffer; /* Same samples as output_buffer, one channel after the other */
+    MYFLT *mix_buffer; /* Streams sum, one channel after the other */
+    MYFLT *amp_buffer; /* Global amplitude, per sample, while ramping */
 
     /* rendering offline of the first "startoffset" seconds */
     double startoffset;
@@ -154,6 +217,10 @@ typedef struct
     double recquality;
     SNDFILE *recfile;
     SF_INFO recinfo;
+    PyoDiskStream *recstream; /* Ring buffer emptied by the disk writer thread */
+    pthread_mutex_t rec_lock; /* Taken by the audio thread with trylock only */
+    long recbufsize; /* Ring buffer size, in frames */
+    unsigned long recoverruns; /* Blocks dropped by the previous recordings */
 
     /* GUI VUMETER */
     int withGUI;
@@ -185,7 +252,7 @@ typedef struct
 
 PyObject * PyServer_get_server();
 extern unsigned int pyorand();
-extern PyObject * Server_removeStream(Server *self, int sid);
+extern void Server_removeStream(Server *self, Stream *stream);
 extern MYFLT * Server_getInputBuffer(Server *self);
 extern PyoMidiEvent * Server_getMidiEventBuffer(Server *self);
 extern int Server_getMidiEventCount(Server *self);
@@ -207,7 +274,17 @@ PyObject * Server_start(Server *self);
 PyObject * Server_boot(Server *self, PyObject *arg);
 void Server_process_gui(Server *server);
 void Server_process_time(Server *server);
+void Server_send_rms(Server *self);
+void Server_send_time(Server *self);
 int Server_start_rec_internal(Server *self, char *filename);
+void Server_stop_rec_internal(Server *self);
+void Server_lock_streams(Server *self);
+void Server_unlock_streams(Server *self);
+int Server_getGILFree(Server *self);
+int Server_isNonRealTime(Server *self);
+void Server_deferCall(Server *self, Stream *stream, int type);
+void Server_callOrDefer(Server *self, Stream *stream);
+void Server_processDeferredCalls(Server *self);
 
 #ifdef __cplusplus
 }
@@ -24,12 +24,26 @@
 #include <Python.h>
 #include "pyomodule.h"
 
+/* Content of a stream's buffer for the current block. Streams are reset
+   to PYO_STREAM_VARYING before being computed, the object computing the
+   stream can then tag its buffer as constant or silent. New and stopped
+   streams are silent. */
+#define PYO_STREAM_VARYING 0
+#define PYO_STREAM_CONSTANT 1 /* every sample is equal to data[0]. */
+#define PYO_STREAM_SILENT 2 /* every sample is 0. */
+
+/* Flags of Stream_mulAdd, for the POST_PROCESSING_REV* macros. */
+#define PYO_MULADD_REVMUL 1 /* divides by mul instead of multiplying. */
+#define PYO_MULADD_REVADD 2 /* subtracts add instead of adding. */
+
 typedef struct
 {
     PyObject_HEAD
     PyObject *streamobject;
     void (*funcptr)();
+    void (*callbackptr)(); /* Python-touching part of the process, can be deferred to the control thread. */
     int sid;
+    int slot; /* index in the server's stream table, -1 if not registered. */
     int chnl;
     int bufsize;
     int active;
@@ -37,10 +51,21 @@ typedef struct
     int duration;
     int bufferCountWait;
     int bufferCount;
+    int needGIL; /* compute function calls the Python API, even in GIL-free mode. */
+    int serial; /* must be computed in list order (uses the global random generator). */
+    int tableWriter; /* compute function writes into the tables or matrices it holds. */
+    int state; /* PYO_STREAM_VARYING, PYO_STREAM_CONSTANT or PYO_STREAM_SILENT. */
+    int computing; /* set while Stream_callFunction computes the stream. */
+    int shareable; /* compute function overwrites the whole buffer every block, the buffer can be shared. */
+    int shared; /* data points to a buffer of the server's pool (see bufferpool.c). */
+    MYFLT last; /* last sample of the block, kept for getValue while the buffer is shared. */
     MYFLT *data;
 } Stream;
 
 extern int Stream_getNewStreamId();
+extern void Stream_invalidateGraph();
+extern unsigned int Stream_getGraphSerial();
+extern Stream ** Stream_getListStreams(PyObject *list);
 extern PyObject * Stream_getStreamObject(Stream *self);
 extern int Stream_getStreamId(Stream *self);
 extern int Stream_getStreamActive(Stream *self);
@@ -52,8 +77,14 @@ extern MYFLT * Stream_getData(Stream *self);
 extern void Stream_setData(Stream * self, MYFLT *data);
 extern void Stream_setFunctionPtr(Stream *self, void *ptr);
 extern void Stream_callFunction(Stream *self);
+extern void Stream_setCallbackPtr(Stream *self, void *ptr);
+extern void Stream_callCallback(Stream *self);
 extern void Stream_IncrementBufferCount(Stream *self);
 extern void Stream_IncrementDurationCount(Stream *self);
+extern int Stream_IncrementDurationCountDeferred(Stream *self);
+extern int Stream_mulAddBuffer(MYFLT *data, int size, int xstate, MYFLT *m, MYFLT mul, int mstate,
+                               MYFLT *a, MYFLT add, int astate, int flags);
+extern void Stream_mulAdd(Stream *self, MYFLT *data, int size, Stream *mul_stream, MYFLT mul, Stream *add_stream, MYFLT add, int flags);
 extern PyTypeObject StreamType;
 
 #define MAKE_NEW_STREAM(self, type, rt_error) \
@@ -61,7 +92,14 @@ extern PyTypeObject StreamType;
   if ((self) == rt_error) { return rt_error; } \
  \
   (self)->sid = (self)->chnl = (self)->todac = (self)->bufferCountWait = 0; \
-  (self)->bufferCount = (self)->bufsize = (self)->duration = (self)->active = 0;
+  (self)->bufferCount = (self)->bufsize = (self)->duration = (self)->active = 0; \
+  (self)->needGIL = (self)->serial = (self)->tableWriter = 0; \
+  (self)->state = PYO_STREAM_VARYING; \
+  (self)->computing = 0; \
+  (self)->shareable = (self)->shared = 0; \
+  (self)->last = 0.0; \
+  (self)->slot = -1; \
+  (self)->callbackptr = NULL;
 
 typedef struct
 {
@@ -86,5 +124,15 @@ extern PyTypeObject TriggerStreamType;
 #define Stream_setDuration(op, v) (((Stream *)(op))->duration = (v))
 #define Stream_setBufferSize(op, v) (((Stream *)(op))->bufsize = (v))
 #define Stream_resetBufferCount(op) (((Stream *)(op))->bufferCount = 0)
+#define Stream_setNeedGIL(op, v) (((Stream *)(op))->needGIL = (v))
+#define Stream_getNeedGIL(op) (((Stream *)(op))->needGIL)
+#define Stream_setSerial(op, v) (((Stream *)(op))->serial = (v))
+#define Stream_getSerial(op) (((Stream *)(op))->serial)
+#define Stream_setTableWriter(op, v) (((Stream *)(op))->tableWriter = (v))
+#define Stream_getTableWriter(op) (((Stream *)(op))->tableWriter)
+#define Stream_setState(op, v) (((Stream *)(op))->state = (v))
+#define Stream_getState(op) (((Stream *)(op))->state)
+#define Stream_setShareable(op, v) (((Stream *)(op))->shareable = (v))
+#define Stream_getShareable(op) (((Stream *)(op))->shareable)
 
 #endif // _STREAMMODULE_H
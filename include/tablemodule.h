@@ -23,6 +23,7 @@
 
 #include "Python.h"
 #include "pyomodule.h"
+#include "interpolation.h"
 
 typedef struct
 {
@@ -33,6 +34,11 @@ typedef struct
     Py_ssize_t shape[1]; /* 1-dimension array (must be set to table size) needed by the buffer protocol. */
     T_SIZE_T pointer; /* writing pointer. */
     MYFLT feedback; /* Recording feedback. */ 
+    int mipmaps; /* 1 if band-limited copies of the table are requested. */
+    int miplevels; /* Number of levels, 0 when the copies are not built. */
+    T_SIZE_T mipsize; /* Table size the levels were built for. */
+    MYFLT **levels; /* levels[0] is `data`, levels[k] keeps the harmonics up to size / 2^(k+1). */
+    PyObject *server; /* Server of the table, the levels are swapped under its lock. */
 } TableStream;
 
 
@@ -42,7 +48,13 @@ if ((self) == rt_error) { return rt_error; }    \
 \
 (self)->size = 0; \
 (self)->pointer = 0; \
-(self)->feedback = 0.0
+(self)->feedback = 0.0; \
+(self)->mipmaps = 0; \
+(self)->miplevels = 0; \
+(self)->mipsize = 0; \
+(self)->levels = NULL; \
+(self)->server = PyServer_get_server(); \
+Py_XINCREF((self)->server)
 
 
 extern T_SIZE_T TableStream_getSize(TableStream *self);
@@ -53,6 +65,62 @@ extern void TableStream_resetRecordingPointer(TableStream *self);
 extern void TableStream_setFeedback(TableStream *self, MYFLT feedback);
 extern MYFLT TableStream_getFeedback(TableStream *self);
 extern void TableStream_record(TableStream *self, int pos, MYFLT value);
+extern void TableStream_updateMipmaps(TableStream *self);
+/* Returns the band-limited levels of the table, or NULL if they are not
+   requested or not up to date with the table size. */
+extern MYFLT ** TableStream_getMipmaps(TableStream *self, int *nlevels);
+/* Interpolates the table at the `n` positions of `pos` into `out` with the
+   block function of the object's interpolation mode. Mipmapped tables are
+   read at the levels picked from the phase increment `inc`, or from the
+   largest increment of `incs` if it is not NULL. `tmp` holds n samples. */
+extern void TableStream_interpolate(TableStream *self, interp_block_func block, double *pos, double inc,
+                                    double *incs, MYFLT *out, MYFLT *tmp, int n);
 extern PyTypeObject TableStreamType;
 
+/* Picks the levels to read at `inc` table samples per output sample. The
+   harmonics of level k stay below the Nyquist frequency while inc <= 2^k.
+   Between 2^(k-1) and 2^k, `lo` is level k-1 and `hi` level k, mixed in by
+   the returned factor, so that the bandwidth follows the speed without a
+   jump and reaches level k at 2^k. The table itself is read as is up to
+   its original speed. The objects pick the levels once per block. */
+static inline MYFLT
+TableStream_pickMipmaps(MYFLT **levels, int nlevels, double inc, MYFLT **lo, MYFLT **hi)
+{
+    int k;
+    double lvl;
+
+    inc = fabs(inc);
+
+    if (inc <= 1.0)
+    {
+        *lo = *hi = levels[0];
+        return 0.0;
+    }
+
+    lvl = log2(inc);
+    k = (int)ceil(lvl);
+
+    if (k >= nlevels)
+    {
+        *lo = *hi = levels[nlevels - 1];
+        return 0.0;
+    }
+
+    *lo = levels[k - 1];
+    *hi = levels[k];
+    return (MYFLT)(lvl - k + 1.0);
+}
+
+/* Interpolates a table position in the levels given by TableStream_pickMipmaps. */
+static inline MYFLT
+TableStream_readMipmaps(MYFLT (*interp)(MYFLT *, T_SIZE_T, MYFLT, T_SIZE_T), MYFLT *lo, MYFLT *hi, MYFLT mix, T_SIZE_T ipart, MYFLT fpart, T_SIZE_T size)
+{
+    MYFLT val = (*interp)(lo, ipart, fpart, size);
+
+    if (hi != lo)
+        val += ((*interp)(hi, ipart, fpart, size) - val) * mix;
+
+    return val;
+}
+
 #endif // _TABLEMODULE_H
\ No newline at end of file
@@ -551,6 +551,15 @@ def wrap(arg, i):
         return x
 
 
+def multichannelStreams(lmax):
+    """
+    Return True if an object with `lmax` streams must compute them in a
+    single object (see Server.setMultichannelStreams).
+
+    """
+    return lmax > 1 and serverMultichannelStreams()
+
+
 def example(cls, dur=5, toprint=True, double=False):
     """
     Execute the documentation example of the object given as an argument.
@@ -1869,6 +1878,7 @@ class PyoTableObject(PyoObjectBase):
         self._size = size
         self.viewFrame = None
         self.graphFrame = None
+        self._mipmaps = False
 
     def save(self, path, format=0, sampletype=0, quality=0.4):
         """
@@ -2451,6 +2461,40 @@ class PyoTableObject(PyoObjectBase):
         [obj.rotate(pos) for obj in self._base_objs]
         self.refreshView()
 
+    def setMipmaps(self, x):
+        """
+        Keeps band-limited copies of the table for the oscillators.
+
+        When active, the table builds, with an FFT, octave-spaced copies
+        of its content holding fewer and fewer harmonics. Osc, OscLoop,
+        OscTrig and TableRead then read the copies matching their reading
+        speed, crossfading between them, which avoids aliasing at high
+        frequencies without oversampling. Up to its original speed, the
+        table is read as is.
+
+        Copies are rebuilt whenever the table is modified by one of its
+        methods. Content written by audio objects (TableRec, TableWrite,
+        etc.) is not tracked, call this method again to rebuild them.
+
+        Only tables whose size is even, with a half which is a product
+        of 2, 3 and 5 (as any power-of-two), can be mipmapped. Each copy
+        uses as much memory as the table itself.
+
+        :Args:
+
+            x: boolean
+                True to build and use the band-limited copies, False
+                to free them.
+
+        """
+        pyoArgsAssert(self, "B", x)
+        self._mipmaps = x
+        [obj.getTableStream().setMipmaps(x) for obj in self._base_objs]
+
+    def _refreshMipmaps(self):
+        if self._mipmaps:
+            [obj.getTableStream().refreshMipmaps() for obj in self._base_objs]
+
     def copy(self):
         """
         Returns a deep copy of the object.
@@ -2505,9 +2549,11 @@ class PyoTableObject(PyoObjectBase):
 
     def refreshView(self):
         """
-        Updates the graphical display of the table, if applicable.
+        Updates the graphical display and the band-limited copies
+        of the table, if applicable.
 
         """
+        self._refreshMipmaps()
         if self.viewFrame is not None:
             size = self.viewFrame.wavePanel.GetSize()
             samples = self._base_objs[0].getViewTable((size[0], size[1]))
@@ -3035,6 +3081,10 @@ class Dummy(PyoObject):
         >>> print(b)
         <pyo.lib._core.Dummy object at 0x11fd710>
 
+        Chained operations, like `a * b + c * .5`, are fused: the
+        intermediate results used nowhere else are not computed as
+        separate streams, the whole expression is evaluated in one pass.
+
     >>> s = Server().boot()
     >>> s.start()
     >>> m = Metro(time=0.25).play()
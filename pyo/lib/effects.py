@@ -923,8 +923,14 @@ class Convolve(PyoObject):
 
     .. note::
 
-        Convolution is very expensive to compute, so the impulse response must
-        be kept very short to run in real time.
+        The first samples of the impulse response are computed in the time
+        domain and the rest with a partitioned FFT convolution, running in a
+        background thread. This keeps the cost low for long impulse responses
+        without adding latency.
+
+        Changes in the table content are detected progressively, a few
+        thousand samples per buffer, and a change of the impulse tail is
+        heard with a short delay.
 
         Usually convolution generates a high amplitude level, take care of the
         `mul` parameter!
@@ -79,10 +79,22 @@ class Biquad(PyoObject):
         self._type = type
         self._in_fader = InputFader(input)
         in_fader, freq, q, type, mul, add, lmax = convertArgsToLists(self._in_fader, freq, q, type, mul, add)
-        self._base_objs = [
-            Biquad_base(wrap(in_fader, i), wrap(freq, i), wrap(q, i), wrap(type, i), wrap(mul, i), wrap(add, i))
-            for i in range(lmax)
-        ]
+        if multichannelStreams(lmax):
+            self._base_players = [
+                BiquadMulti_base(
+                    lmax,
+                    [wrap(in_fader, i) for i in range(lmax)],
+                    [wrap(freq, i) for i in range(lmax)],
+                    [wrap(q, i) for i in range(lmax)],
+                    [wrap(type, i) for i in range(lmax)],
+                )
+            ]
+            self._base_objs = [MultiChannel_base(self._base_players[0], i, wrap(mul, i), wrap(add, i)) for i in range(lmax)]
+        else:
+            self._base_objs = [
+                Biquad_base(wrap(in_fader, i), wrap(freq, i), wrap(q, i), wrap(type, i), wrap(mul, i), wrap(add, i))
+                for i in range(lmax)
+            ]
         self._init_play()
 
     def setInput(self, x, fadetime=0.05):
@@ -114,7 +126,10 @@ class Biquad(PyoObject):
         pyoArgsAssert(self, "O", x)
         self._freq = x
         x, lmax = convertArgsToLists(x)
-        [obj.setFreq(wrap(x, i)) for i, obj in enumerate(self._base_objs)]
+        if self._base_players is not None:
+            self._base_players[0].setFreq([wrap(x, i) for i in range(len(self._base_objs))])
+        else:
+            [obj.setFreq(wrap(x, i)) for i, obj in enumerate(self._base_objs)]
 
     def setQ(self, x):
         """
@@ -129,7 +144,10 @@ class Biquad(PyoObject):
         pyoArgsAssert(self, "O", x)
         self._q = x
         x, lmax = convertArgsToLists(x)
-        [obj.setQ(wrap(x, i)) for i, obj in enumerate(self._base_objs)]
+        if self._base_players is not None:
+            self._base_players[0].setQ([wrap(x, i) for i in range(len(self._base_objs))])
+        else:
+            [obj.setQ(wrap(x, i)) for i, obj in enumerate(self._base_objs)]
 
     def setType(self, x):
         """
@@ -149,7 +167,29 @@ class Biquad(PyoObject):
         pyoArgsAssert(self, "i", x)
         self._type = x
         x, lmax = convertArgsToLists(x)
-        [obj.setType(wrap(x, i)) for i, obj in enumerate(self._base_objs)]
+        if self._base_players is not None:
+            self._base_players[0].setType([wrap(x, i) for i in range(len(self._base_objs))])
+        else:
+            [obj.setType(wrap(x, i)) for i, obj in enumerate(self._base_objs)]
+
+    def setCoeffRate(self, x):
+        """
+        Sets the number of samples between two computations of the filter
+        coefficients, when they follow a parameter given as an audio signal.
+        See Server.setCoeffRate, which gives the default rate.
+
+        :Args:
+
+            x: int
+                Number of samples, between 1 and 1024.
+
+        """
+        pyoArgsAssert(self, "i", x)
+        x, lmax = convertArgsToLists(x)
+        if self._base_players is not None:
+            self._base_players[0].setCoeffRate([wrap(x, i) for i in range(len(self._base_objs))])
+        else:
+            [obj.setCoeffRate(wrap(x, i)) for i, obj in enumerate(self._base_objs)]
 
     def ctrl(self, map_list=None, title=None, wxnoserver=False):
         self._map_list = [
@@ -247,12 +287,25 @@ class Biquadx(PyoObject):
         in_fader, freq, q, type, stages, mul, add, lmax = convertArgsToLists(
             self._in_fader, freq, q, type, stages, mul, add
         )
-        self._base_objs = [
-            Biquadx_base(
-                wrap(in_fader, i), wrap(freq, i), wrap(q, i), wrap(type, i), wrap(stages, i), wrap(mul, i), wrap(add, i)
-            )
-            for i in range(lmax)
-        ]
+        if multichannelStreams(lmax):
+            self._base_players = [
+                BiquadxMulti_base(
+                    lmax,
+                    [wrap(in_fader, i) for i in range(lmax)],
+                    [wrap(freq, i) for i in range(lmax)],
+                    [wrap(q, i) for i in range(lmax)],
+                    [wrap(type, i) for i in range(lmax)],
+                    [wrap(stages, i) for i in range(lmax)],
+                )
+            ]
+            self._base_objs = [MultiChannel_base(self._base_players[0], i, wrap(mul, i), wrap(add, i)) for i in range(lmax)]
+        else:
+            self._base_objs = [
+                Biquadx_base(
+                    wrap(in_fader, i), wrap(freq, i), wrap(q, i), wrap(type, i), wrap(stages, i), wrap(mul, i), wrap(add, i)
+                )
+                for i in range(lmax)
+            ]
         self._init_play()
 
     def setInput(self, x, fadetime=0.05):
@@ -284,7 +337,10 @@ class Biquadx(PyoObject):
         pyoArgsAssert(self, "O", x)
         self._freq = x
         x, lmax = convertArgsToLists(x)
-        [obj.setFreq(wrap(x, i)) for i, obj in enumerate(self._base_objs)]
+        if self._base_players is not None:
+            self._base_players[0].setFreq([wrap(x, i) for i in range(len(self._base_objs))])
+        else:
+            [obj.setFreq(wrap(x, i)) for i, obj in enumerate(self._base_objs)]
 
     def setQ(self, x):
         """
@@ -299,7 +355,10 @@ class Biquadx(PyoObject):
         pyoArgsAssert(self, "O", x)
         self._q = x
         x, lmax = convertArgsToLists(x)
-        [obj.setQ(wrap(x, i)) for i, obj in enumerate(self._base_objs)]
+        if self._base_players is not None:
+            self._base_players[0].setQ([wrap(x, i) for i in range(len(self._base_objs))])
+        else:
+            [obj.setQ(wrap(x, i)) for i, obj in enumerate(self._base_objs)]
 
     def setType(self, x):
         """
@@ -319,7 +378,10 @@ class Biquadx(PyoObject):
         pyoArgsAssert(self, "i", x)
         self._type = x
         x, lmax = convertArgsToLists(x)
-        [obj.setType(wrap(x, i)) for i, obj in enumerate(self._base_objs)]
+        if self._base_players is not None:
+            self._base_players[0].setType([wrap(x, i) for i in range(len(self._base_objs))])
+        else:
+            [obj.setType(wrap(x, i)) for i, obj in enumerate(self._base_objs)]
 
     def setStages(self, x):
         """
@@ -334,7 +396,29 @@ class Biquadx(PyoObject):
         pyoArgsAssert(self, "i", x)
         self._stages = x
         x, lmax = convertArgsToLists(x)
-        [obj.setStages(wrap(x, i)) for i, obj in enumerate(self._base_objs)]
+        if self._base_players is not None:
+            self._base_players[0].setStages([wrap(x, i) for i in range(len(self._base_objs))])
+        else:
+            [obj.setStages(wrap(x, i)) for i, obj in enumerate(self._base_objs)]
+
+    def setCoeffRate(self, x):
+        """
+        Sets the number of samples between two computations of the filter
+        coefficients, when they follow a parameter given as an audio signal.
+        See Server.setCoeffRate, which gives the default rate.
+
+        :Args:
+
+            x: int
+                Number of samples, between 1 and 1024.
+
+        """
+        pyoArgsAssert(self, "i", x)
+        x, lmax = convertArgsToLists(x)
+        if self._base_players is not None:
+            self._base_players[0].setCoeffRate([wrap(x, i) for i in range(len(self._base_objs))])
+        else:
+            [obj.setCoeffRate(wrap(x, i)) for i, obj in enumerate(self._base_objs)]
 
     def ctrl(self, map_list=None, title=None, wxnoserver=False):
         self._map_list = [
@@ -707,12 +791,25 @@ class EQ(PyoObject):
         in_fader, freq, q, boost, type, mul, add, lmax = convertArgsToLists(
             self._in_fader, freq, q, boost, type, mul, add
         )
-        self._base_objs = [
-            EQ_base(
-                wrap(in_fader, i), wrap(freq, i), wrap(q, i), wrap(boost, i), wrap(type, i), wrap(mul, i), wrap(add, i)
-            )
-            for i in range(lmax)
-        ]
+        if multichannelStreams(lmax):
+            self._base_players = [
+                EQMulti_base(
+                    lmax,
+                    [wrap(in_fader, i) for i in range(lmax)],
+                    [wrap(freq, i) for i in range(lmax)],
+                    [wrap(q, i) for i in range(lmax)],
+                    [wrap(boost, i) for i in range(lmax)],
+                    [wrap(type, i) for i in range(lmax)],
+                )
+            ]
+            self._base_objs = [MultiChannel_base(self._base_players[0], i, wrap(mul, i), wrap(add, i)) for i in range(lmax)]
+        else:
+            self._base_objs = [
+                EQ_base(
+                    wrap(in_fader, i), wrap(freq, i), wrap(q, i), wrap(boost, i), wrap(type, i), wrap(mul, i), wrap(add, i)
+                )
+                for i in range(lmax)
+            ]
         self._init_play()
 
     def setInput(self, x, fadetime=0.05):
@@ -744,7 +841,10 @@ class EQ(PyoObject):
         pyoArgsAssert(self, "O", x)
         self._freq = x
         x, lmax = convertArgsToLists(x)
-        [obj.setFreq(wrap(x, i)) for i, obj in enumerate(self._base_objs)]
+        if self._base_players is not None:
+            self._base_players[0].setFreq([wrap(x, i) for i in range(len(self._base_objs))])
+        else:
+            [obj.setFreq(wrap(x, i)) for i, obj in enumerate(self._base_objs)]
 
     def setQ(self, x):
         """
@@ -759,7 +859,10 @@ class EQ(PyoObject):
         pyoArgsAssert(self, "O", x)
         self._q = x
         x, lmax = convertArgsToLists(x)
-        [obj.setQ(wrap(x, i)) for i, obj in enumerate(self._base_objs)]
+        if self._base_players is not None:
+            self._base_players[0].setQ([wrap(x, i) for i in range(len(self._base_objs))])
+        else:
+            [obj.setQ(wrap(x, i)) for i, obj in enumerate(self._base_objs)]
 
     def setBoost(self, x):
         """
@@ -774,7 +877,10 @@ class EQ(PyoObject):
         pyoArgsAssert(self, "O", x)
         self._boost = x
         x, lmax = convertArgsToLists(x)
-        [obj.setBoost(wrap(x, i)) for i, obj in enumerate(self._base_objs)]
+        if self._base_players is not None:
+            self._base_players[0].setBoost([wrap(x, i) for i in range(len(self._base_objs))])
+        else:
+            [obj.setBoost(wrap(x, i)) for i, obj in enumerate(self._base_objs)]
 
     def setType(self, x):
         """
@@ -792,7 +898,29 @@ class EQ(PyoObject):
         pyoArgsAssert(self, "i", x)
         self._type = x
         x, lmax = convertArgsToLists(x)
-        [obj.setType(wrap(x, i)) for i, obj in enumerate(self._base_objs)]
+        if self._base_players is not None:
+            self._base_players[0].setType([wrap(x, i) for i in range(len(self._base_objs))])
+        else:
+            [obj.setType(wrap(x, i)) for i, obj in enumerate(self._base_objs)]
+
+    def setCoeffRate(self, x):
+        """
+        Sets the number of samples between two computations of the filter
+        coefficients, when they follow a parameter given as an audio signal.
+        See Server.setCoeffRate, which gives the default rate.
+
+        :Args:
+
+            x: int
+                Number of samples, between 1 and 1024.
+
+        """
+        pyoArgsAssert(self, "i", x)
+        x, lmax = convertArgsToLists(x)
+        if self._base_players is not None:
+            self._base_players[0].setCoeffRate([wrap(x, i) for i in range(len(self._base_objs))])
+        else:
+            [obj.setCoeffRate(wrap(x, i)) for i, obj in enumerate(self._base_objs)]
 
     def ctrl(self, map_list=None, title=None, wxnoserver=False):
         self._map_list = [
@@ -878,7 +1006,11 @@ class Tone(PyoObject):
         self._freq = freq
         self._in_fader = InputFader(input)
         in_fader, freq, mul, add, lmax = convertArgsToLists(self._in_fader, freq, mul, add)
-        self._base_objs = [Tone_base(wrap(in_fader, i), wrap(freq, i), wrap(mul, i), wrap(add, i)) for i in range(lmax)]
+        if multichannelStreams(lmax):
+            self._base_players = [ToneMulti_base(lmax, [wrap(in_fader, i) for i in range(lmax)], [wrap(freq, i) for i in range(lmax)])]
+            self._base_objs = [MultiChannel_base(self._base_players[0], i, wrap(mul, i), wrap(add, i)) for i in range(lmax)]
+        else:
+            self._base_objs = [Tone_base(wrap(in_fader, i), wrap(freq, i), wrap(mul, i), wrap(add, i)) for i in range(lmax)]
         self._init_play()
 
     def setInput(self, x, fadetime=0.05):
@@ -910,7 +1042,10 @@ class Tone(PyoObject):
         pyoArgsAssert(self, "O", x)
         self._freq = x
         x, lmax = convertArgsToLists(x)
-        [obj.setFreq(wrap(x, i)) for i, obj in enumerate(self._base_objs)]
+        if self._base_players is not None:
+            self._base_players[0].setFreq([wrap(x, i) for i in range(len(self._base_objs))])
+        else:
+            [obj.setFreq(wrap(x, i)) for i, obj in enumerate(self._base_objs)]
 
     def ctrl(self, map_list=None, title=None, wxnoserver=False):
         self._map_list = [SLMapFreq(self._freq), SLMapMul(self._mul)]
@@ -3177,6 +3312,22 @@ class SVF(PyoObject):
         x, lmax = convertArgsToLists(x)
         [obj.setType(wrap(x, i)) for i, obj in enumerate(self._base_objs)]
 
+    def setCoeffRate(self, x):
+        """
+        Sets the number of samples between two computations of the filter
+        coefficients, when they follow a parameter given as an audio signal.
+        See Server.setCoeffRate, which gives the default rate.
+
+        :Args:
+
+            x: int
+                Number of samples, between 1 and 1024.
+
+        """
+        pyoArgsAssert(self, "i", x)
+        x, lmax = convertArgsToLists(x)
+        [obj.setCoeffRate(wrap(x, i)) for i, obj in enumerate(self._base_objs)]
+
     def ctrl(self, map_list=None, title=None, wxnoserver=False):
         self._map_list = [
             SLMap(20, 7350, "log", "freq", self._freq),
@@ -3665,6 +3816,22 @@ class Reson(PyoObject):
         x, lmax = convertArgsToLists(x)
         [obj.setQ(wrap(x, i)) for i, obj in enumerate(self._base_objs)]
 
+    def setCoeffRate(self, x):
+        """
+        Sets the number of samples between two computations of the filter
+        coefficients, when they follow a parameter given as an audio signal.
+        See Server.setCoeffRate, which gives the default rate.
+
+        :Args:
+
+            x: int
+                Number of samples, between 1 and 1024.
+
+        """
+        pyoArgsAssert(self, "i", x)
+        x, lmax = convertArgsToLists(x)
+        [obj.setCoeffRate(wrap(x, i)) for i, obj in enumerate(self._base_objs)]
+
     def ctrl(self, map_list=None, title=None, wxnoserver=False):
         self._map_list = [SLMapFreq(self._freq), SLMapQ(self._q), SLMapMul(self._mul)]
         PyoObject.ctrl(self, map_list, title, wxnoserver)
@@ -3808,6 +3975,22 @@ class Resonx(PyoObject):
         x, lmax = convertArgsToLists(x)
         [obj.setStages(wrap(x, i)) for i, obj in enumerate(self._base_objs)]
 
+    def setCoeffRate(self, x):
+        """
+        Sets the number of samples between two computations of the filter
+        coefficients, when they follow a parameter given as an audio signal.
+        See Server.setCoeffRate, which gives the default rate.
+
+        :Args:
+
+            x: int
+                Number of samples, between 1 and 1024.
+
+        """
+        pyoArgsAssert(self, "i", x)
+        x, lmax = convertArgsToLists(x)
+        [obj.setCoeffRate(wrap(x, i)) for i, obj in enumerate(self._base_objs)]
+
     def ctrl(self, map_list=None, title=None, wxnoserver=False):
         self._map_list = [SLMapFreq(self._freq), SLMapQ(self._q), SLMapMul(self._mul)]
         PyoObject.ctrl(self, map_list, title, wxnoserver)
@@ -3917,6 +4100,22 @@ class ButLP(PyoObject):
         x, lmax = convertArgsToLists(x)
         [obj.setFreq(wrap(x, i)) for i, obj in enumerate(self._base_objs)]
 
+    def setCoeffRate(self, x):
+        """
+        Sets the number of samples between two computations of the filter
+        coefficients, when they follow a parameter given as an audio signal.
+        See Server.setCoeffRate, which gives the default rate.
+
+        :Args:
+
+            x: int
+                Number of samples, between 1 and 1024.
+
+        """
+        pyoArgsAssert(self, "i", x)
+        x, lmax = convertArgsToLists(x)
+        [obj.setCoeffRate(wrap(x, i)) for i, obj in enumerate(self._base_objs)]
+
     def ctrl(self, map_list=None, title=None, wxnoserver=False):
         self._map_list = [SLMapFreq(self._freq), SLMapMul(self._mul)]
         PyoObject.ctrl(self, map_list, title, wxnoserver)
@@ -4008,6 +4207,22 @@ class ButHP(PyoObject):
         x, lmax = convertArgsToLists(x)
         [obj.setFreq(wrap(x, i)) for i, obj in enumerate(self._base_objs)]
 
+    def setCoeffRate(self, x):
+        """
+        Sets the number of samples between two computations of the filter
+        coefficients, when they follow a parameter given as an audio signal.
+        See Server.setCoeffRate, which gives the default rate.
+
+        :Args:
+
+            x: int
+                Number of samples, between 1 and 1024.
+
+        """
+        pyoArgsAssert(self, "i", x)
+        x, lmax = convertArgsToLists(x)
+        [obj.setCoeffRate(wrap(x, i)) for i, obj in enumerate(self._base_objs)]
+
     def ctrl(self, map_list=None, title=None, wxnoserver=False):
         self._map_list = [SLMapFreq(self._freq), SLMapMul(self._mul)]
         PyoObject.ctrl(self, map_list, title, wxnoserver)
@@ -4118,6 +4333,22 @@ class ButBP(PyoObject):
         x, lmax = convertArgsToLists(x)
         [obj.setQ(wrap(x, i)) for i, obj in enumerate(self._base_objs)]
 
+    def setCoeffRate(self, x):
+        """
+        Sets the number of samples between two computations of the filter
+        coefficients, when they follow a parameter given as an audio signal.
+        See Server.setCoeffRate, which gives the default rate.
+
+        :Args:
+
+            x: int
+                Number of samples, between 1 and 1024.
+
+        """
+        pyoArgsAssert(self, "i", x)
+        x, lmax = convertArgsToLists(x)
+        [obj.setCoeffRate(wrap(x, i)) for i, obj in enumerate(self._base_objs)]
+
     def ctrl(self, map_list=None, title=None, wxnoserver=False):
         self._map_list = [SLMapFreq(self._freq), SLMap(1, 100, "log", "q", self._q), SLMapMul(self._mul)]
         PyoObject.ctrl(self, map_list, title, wxnoserver)
@@ -4237,6 +4468,22 @@ class ButBR(PyoObject):
         x, lmax = convertArgsToLists(x)
         [obj.setQ(wrap(x, i)) for i, obj in enumerate(self._base_objs)]
 
+    def setCoeffRate(self, x):
+        """
+        Sets the number of samples between two computations of the filter
+        coefficients, when they follow a parameter given as an audio signal.
+        See Server.setCoeffRate, which gives the default rate.
+
+        :Args:
+
+            x: int
+                Number of samples, between 1 and 1024.
+
+        """
+        pyoArgsAssert(self, "i", x)
+        x, lmax = convertArgsToLists(x)
+        [obj.setCoeffRate(wrap(x, i)) for i, obj in enumerate(self._base_objs)]
+
     def ctrl(self, map_list=None, title=None, wxnoserver=False):
         self._map_list = [SLMapFreq(self._freq), SLMap(1, 100, "log", "q", self._q), SLMapMul(self._mul)]
         PyoObject.ctrl(self, map_list, title, wxnoserver)
@@ -4356,6 +4603,22 @@ class MoogLP(PyoObject):
         x, lmax = convertArgsToLists(x)
         [obj.setRes(wrap(x, i)) for i, obj in enumerate(self._base_objs)]
 
+    def setCoeffRate(self, x):
+        """
+        Sets the number of samples between two computations of the filter
+        coefficients, when they follow a parameter given as an audio signal.
+        See Server.setCoeffRate, which gives the default rate.
+
+        :Args:
+
+            x: int
+                Number of samples, between 1 and 1024.
+
+        """
+        pyoArgsAssert(self, "i", x)
+        x, lmax = convertArgsToLists(x)
+        [obj.setCoeffRate(wrap(x, i)) for i, obj in enumerate(self._base_objs)]
+
     def ctrl(self, map_list=None, title=None, wxnoserver=False):
         self._map_list = [SLMapFreq(self._freq), SLMap(0.0, 1.0, "lin", "res", self._res), SLMapMul(self._mul)]
         PyoObject.ctrl(self, map_list, title, wxnoserver)
@@ -4477,6 +4740,22 @@ class ComplexRes(PyoObject):
         x, lmax = convertArgsToLists(x)
         [obj.setDecay(wrap(x, i)) for i, obj in enumerate(self._base_objs)]
 
+    def setCoeffRate(self, x):
+        """
+        Sets the number of samples between two computations of the filter
+        coefficients, when they follow a parameter given as an audio signal.
+        See Server.setCoeffRate, which gives the default rate.
+
+        :Args:
+
+            x: int
+                Number of samples, between 1 and 1024.
+
+        """
+        pyoArgsAssert(self, "i", x)
+        x, lmax = convertArgsToLists(x)
+        [obj.setCoeffRate(wrap(x, i)) for i, obj in enumerate(self._base_objs)]
+
     def ctrl(self, map_list=None, title=None, wxnoserver=False):
         self._map_list = [SLMapFreq(self._freq), SLMap(0.0001, 10, "log", "decay", self._decay), SLMapMul(self._mul)]
         PyoObject.ctrl(self, map_list, title, wxnoserver)
@@ -52,10 +52,11 @@ class FFT(PyoObject):
 
         input: PyoObject
             Input signal to process.
-        size: int {pow-of-two > 4}, optional
-            FFT size. Must be a power of two greater than 4.
-            The FFT size is the number of samples used in each
-            analysis frame. Defaults to 1024.
+        size: int {even > 4}, optional
+            FFT size. Usually a power of two greater than 4, but any
+            even size whose half only has 2, 3 and 5 as factors, like
+            1536 or 3000, is accepted. The FFT size is the number
+            of samples used in each analysis frame. Defaults to 1024.
         overlaps: int, optional
             The number of overlaped analysis block. Must be a
             positive integer. More overlaps can greatly improved
@@ -287,11 +288,13 @@ class IFFT(PyoObject):
             Input `real` signal.
         inimag: PyoObject
             Input `imaginary` signal.
-        size: int {pow-of-two > 4}, optional
-            FFT size. Must be a power of two greater than 4.
-            The FFT size is the number of samples used in each
-            analysis frame. This value must match the `size`
-            attribute of the former FFT object. Defaults to 1024.
+        size: int {even > 4}, optional
+            FFT size. Usually a power of two greater than 4, but any
+            even size whose half only has 2, 3 and 5 as factors, like
+            1536 or 3000, is accepted. The FFT size is the number
+            of samples used in each analysis frame. This value must
+            match the `size` attribute of the former FFT object.
+            Defaults to 1024.
         overlaps: int, optional
             The number of overlaped analysis block. Must be a
             positive integer. More overlaps can greatly improved
@@ -1267,9 +1270,13 @@ class CvlVerb(PyoObject):
     """
     Convolution based reverb.
 
-    CvlVerb implements convolution based on a uniformly partitioned overlap-save
-    algorithm. This object can be used to convolve an input signal with an
-    impulse response soundfile to simulate real acoustic spaces.
+    CvlVerb implements convolution based on a non-uniformly partitioned
+    overlap-save algorithm. The head of the impulse is split in partitions of
+    `size` samples computed in the audio callback, the tail in partitions of
+    growing size computed by a background thread. The cost per buffer stays
+    almost constant, even with very long impulses. This object can be used
+    to convolve an input signal with an impulse response soundfile to
+    simulate real acoustic spaces.
 
     :Parent: :py:class:`PyoObject`
 
@@ -1283,8 +1290,9 @@ class CvlVerb(PyoObject):
             initialization time only. Defaults to 'IRMediumHallStereo.wav', located
             in pyo SNDS_PATH folder.
         size: int {pow-of-two}, optional
-            The size in samples of each partition of the impulse file. Small size means
-            smaller latency but more computation time. If not a power-of-2, the object
+            The size in samples of the first partitions of the impulse file, which is
+            also the latency of the reverb. Small size means smaller latency but more
+            computation time. If not a power-of-2, the object
             will find the next power-of-2 greater and use that as the actual partition size.
             This value must also be greater or equal than the server's buffer size.
             Available at initialization time only. Defaults to 1024.
@@ -1422,11 +1430,13 @@ class IFFTMatrix(PyoObject):
             FFT. Try different signals like white noise or an oscillator
             with a frequency slightly detuned in relation to the
             frequency of the FFT (sr / fftsize).
-        size: int {pow-of-two > 4}, optional
-            FFT size. Must be a power of two greater than 4.
-            The FFT size is the number of samples used in each
-            analysis frame. This value must match the `size`
-            attribute of the former FFT object. Defaults to 1024.
+        size: int {even > 4}, optional
+            FFT size. Usually a power of two greater than 4, but any
+            even size whose half only has 2, 3 and 5 as factors, like
+            1536 or 3000, is accepted. The FFT size is the number
+            of samples used in each analysis frame. This value must
+            match the `size` attribute of the former FFT object.
+            Defaults to 1024.
         overlaps: int, optional
             The number of overlaped analysis block. Must be a
             positive integer. More overlaps can greatly improved
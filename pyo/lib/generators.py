@@ -61,7 +61,11 @@ class Sine(PyoObject):
         self._freq = freq
         self._phase = phase
         freq, phase, mul, add, lmax = convertArgsToLists(freq, phase, mul, add)
-        self._base_objs = [Sine_base(wrap(freq, i), wrap(phase, i), wrap(mul, i), wrap(add, i)) for i in range(lmax)]
+        if multichannelStreams(lmax):
+            self._base_players = [SineMulti_base(lmax, [wrap(freq, i) for i in range(lmax)], [wrap(phase, i) for i in range(lmax)])]
+            self._base_objs = [MultiChannel_base(self._base_players[0], i, wrap(mul, i), wrap(add, i)) for i in range(lmax)]
+        else:
+            self._base_objs = [Sine_base(wrap(freq, i), wrap(phase, i), wrap(mul, i), wrap(add, i)) for i in range(lmax)]
         self._init_play()
 
     def setFreq(self, x):
@@ -77,7 +81,10 @@ class Sine(PyoObject):
         pyoArgsAssert(self, "O", x)
         self._freq = x
         x, lmax = convertArgsToLists(x)
-        [obj.setFreq(wrap(x, i)) for i, obj in enumerate(self._base_objs)]
+        if self._base_players is not None:
+            self._base_players[0].setFreq([wrap(x, i) for i in range(len(self._base_objs))])
+        else:
+            [obj.setFreq(wrap(x, i)) for i, obj in enumerate(self._base_objs)]
 
     def setPhase(self, x):
         """
@@ -92,14 +99,20 @@ class Sine(PyoObject):
         pyoArgsAssert(self, "O", x)
         self._phase = x
         x, lmax = convertArgsToLists(x)
-        [obj.setPhase(wrap(x, i)) for i, obj in enumerate(self._base_objs)]
+        if self._base_players is not None:
+            self._base_players[0].setPhase([wrap(x, i) for i in range(len(self._base_objs))])
+        else:
+            [obj.setPhase(wrap(x, i)) for i, obj in enumerate(self._base_objs)]
 
     def reset(self):
         """
         Resets current phase to 0.
 
         """
-        [obj.reset() for i, obj in enumerate(self._base_objs)]
+        if self._base_players is not None:
+            self._base_players[0].reset()
+        else:
+            [obj.reset() for i, obj in enumerate(self._base_objs)]
 
     def ctrl(self, map_list=None, title=None, wxnoserver=False):
         self._map_list = [SLMapFreq(self._freq), SLMapPhase(self._phase), SLMapMul(self._mul)]
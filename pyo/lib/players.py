@@ -72,6 +72,10 @@ class SfPlayer(PyoObject):
 
     .. note::
 
+        The sound file is streamed from the disk by background threads, the
+        audio callback only reads blocks of samples already loaded. See the
+        getUnderruns() method to know if the disk was too slow.
+
         SfPlayer will send a trigger signal at the end of the playback if
         loop is off or any time it wraps around if loop is on. User can
         retrieve the trigger streams by calling obj['trig']:
@@ -235,6 +239,17 @@ class SfPlayer(PyoObject):
         x, lmax = convertArgsToLists(x)
         [obj.setInterp(wrap(x, i)) for i, obj in enumerate(self._base_players)]
 
+    def getUnderruns(self):
+        """
+        Returns the number of buffers that were played before the disk could provide their samples.
+
+        The sound file is read ahead by background threads. When the disk
+        is too slow, the missing samples are replaced by silence and counted
+        here. Offline servers wait for the disk instead.
+
+        """
+        return sum(obj.getUnderruns() for obj in self._base_players)
+
     def ctrl(self, map_list=None, title=None, wxnoserver=False):
         self._map_list = [
             SLMap(-2.0, 2.0, "lin", "speed", self._speed),
@@ -402,6 +417,17 @@ class SfMarkerShuffler(PyoObject):
         x, lmax = convertArgsToLists(x)
         [obj.setInterp(wrap(x, i)) for i, obj in enumerate(self._base_players)]
 
+    def getUnderruns(self):
+        """
+        Returns the number of buffers that were played before the disk could provide their samples.
+
+        The sound file is read ahead by background threads. When the disk
+        is too slow, the missing samples are replaced by silence and counted
+        here. Offline servers wait for the disk instead.
+
+        """
+        return sum(obj.getUnderruns() for obj in self._base_players)
+
     def setRandomType(self, dist=0, x=0.5):
         """
         Set the random distribution type used to choose the markers.
@@ -615,6 +641,17 @@ class SfMarkerLooper(PyoObject):
         x, lmax = convertArgsToLists(x)
         [obj.setInterp(wrap(x, i)) for i, obj in enumerate(self._base_players)]
 
+    def getUnderruns(self):
+        """
+        Returns the number of buffers that were played before the disk could provide their samples.
+
+        The sound file is read ahead by background threads. When the disk
+        is too slow, the missing samples are replaced by silence and counted
+        here. Offline servers wait for the disk instead.
+
+        """
+        return sum(obj.getUnderruns() for obj in self._base_players)
+
     def getMarkers(self):
         """
         Returns a list of marker time values in samples.
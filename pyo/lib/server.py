@@ -560,6 +560,212 @@ class Server(object):
         self._verbosity = x
         self._server.setVerbosity(x)
 
+    def setGILFree(self, x):
+        """
+        Activate or deactivate GIL-free processing of the audio graph.
+
+        When activated, the audio callback does not acquire the Python
+        GIL to compute the streams, so the audio thread can't be blocked
+        by the interpreter. Every call to Python (the server's callback,
+        Pattern, TrigFunc, CallAfter, objects reaching their `dur` time,
+        meters and time display) is posted to a queue and executed
+        asynchronously by a control thread (or, with the offline and
+        manual servers, at the end of the processing block). Objects that
+        can't run without the interpreter (Scope, Linseg, Print, Iter,
+        MIDI/OSC objects, etc.) still acquire the GIL when they compute
+        their samples.
+
+        Parameter changes from Python wait for the end of the current
+        processing block, the audio thread never sees a half-updated
+        object.
+
+        :Args:
+
+            x: boolean
+                True to activate GIL-free processing, False to deactivate.
+
+        """
+        self._server.setGILFree(int(bool(x)))
+
+    def getGILFree(self):
+        """
+        Returns 1 if GIL-free processing is active, otherwise returns 0.
+
+        """
+        return self._server.getGILFree()
+
+    def getArenaStats(self):
+        """
+        Returns the statistics of the sample buffers allocator as a dictionary.
+
+        The sample buffers of the objects, the tables and the phase vocoder
+        streams are allocated, aligned on 64 bytes, from slabs of memory
+        shared by all the objects. The dictionary has these keys:
+
+        - used: bytes used by the live buffers.
+        - peak: highest number of bytes used since the beginning.
+        - reserved: bytes obtained from the system.
+        - blocks: number of live buffers.
+        - slabs: number of slabs.
+        - large: number of live buffers bigger than 64 KB, allocated individually.
+
+        """
+        return self._server.getArenaStats()
+
+    def setNumWorkers(self, x):
+        """
+        Set the number of threads computing the audio graph with the audio thread.
+
+        When greater than 0, the objects that do not depend on each other
+        (through their inputs, parameters or the tables they write into)
+        are computed concurrently. Objects calling Python functions or
+        drawing random numbers are still computed in order by the audio
+        thread. The output is identical to the single-threaded processing,
+        whatever the number of workers.
+
+        :Args:
+
+            x: int
+                Number of worker threads. 0 (the default) disables
+                parallel processing.
+
+        """
+        self._server.setNumWorkers(x)
+
+    def getNumWorkers(self):
+        """
+        Returns the number of threads computing the audio graph with the audio thread.
+
+        """
+        return self._server.getNumWorkers()
+
+    def setBufferReuse(self, x):
+        """
+        Activate or deactivate the sharing of the sample buffers between objects.
+
+        Most objects are read, within a block, by a few objects computed
+        after them (the intermediate objects created by the arithmetic
+        operators, an oscillator feeding a filter, ...). When active, the
+        server finds, from the processing order, the objects read only
+        after being computed and computes them in buffers taken from a small
+        pool, a buffer being reused as soon as the last object reading it
+        has been computed. This reduces the memory touched at every block
+        to the samples live within the block. The sharing is computed again
+        whenever an object is created, deleted or gets a new audio input.
+
+        Only the objects known to overwrite their whole buffer at every block
+        (Dummy, Sig, SigTo, Sine, Osc and Biquad) are shared. The sharing is
+        suspended while worker threads are used (see setNumWorkers). An object
+        created from a Python function called by the audio thread can read
+        wrong samples from the shared objects during its first block.
+
+        :Args:
+
+            x: boolean
+                True to share the buffers, False (the default) to give
+                every object its own buffer.
+
+        """
+        self._server.setBufferReuse(bool(x))
+
+    def getBufferReuse(self):
+        """
+        Returns True if the objects share their sample buffers.
+
+        """
+        return self._server.getBufferReuse()
+
+    def getBufferReuseStats(self):
+        """
+        Returns the state of the buffer sharing as a dictionary.
+
+        - streams: number of objects computed in a shared buffer.
+        - buffers: number of shared buffers.
+
+        """
+        return self._server.getBufferReuseStats()
+
+    def setMultichannelStreams(self, x):
+        """
+        Activate or deactivate the objects computing all their streams at once.
+
+        A multichannel object (an object given a list as argument) creates
+        one internal object per stream, each one with its own parameters
+        and computed separately. When active, the objects created afterward
+        that support it compute all their streams in a single internal
+        object, keeping the samples of the streams one after the other in
+        a single buffer and processing the streams side by side, several
+        at a time. Each stream remains an element of the object (`obj[i]`)
+        with its own `mul` and `add`. The output is identical to the one
+        computed stream by stream.
+
+        Only Sine, Tone, Biquad, Biquadx and EQ compute their streams this
+        way for now. The filters of Biquad, Biquadx and EQ are computed by a
+        single bank of biquads, their coefficients being computed again only
+        when their parameters change. This setting has no effect on the
+        objects already created.
+
+        It is off by default because the gain depends on the graph. Many
+        streams with float parameters (a bank of filters over 64 channels,
+        for example) are computed up to twice as fast. A few streams, or
+        streams with audio parameters, are computed one by one anyway and
+        pay for the copy of each stream. Biquadx, whose stages already run
+        one after the other, gains nothing.
+
+        :Args:
+
+            x: boolean
+                True to compute the streams of an object together, False
+                (the default) to compute each stream separately.
+
+        """
+        self._server.setMultichannelStreams(bool(x))
+
+    def getMultichannelStreams(self):
+        """
+        Returns True if the objects compute all their streams at once.
+
+        """
+        return self._server.getMultichannelStreams()
+
+    def setCoeffRate(self, x):
+        """
+        Set the default update rate of the coefficients of the modulated filters.
+
+        A filter given an audio signal as frequency (or q, ...) computes its
+        coefficients again at every sample where the signal changes, which
+        costs far more than the filtering itself. With a rate of N, the
+        coefficients are computed only once every N samples, from the
+        parameters of the last sample of each segment, and are linearly
+        interpolated in between. They are exact at the end of each segment
+        and never jump, so there is no zipper noise. In between, they are
+        off by at most N * N / 8 times the second derivative of the
+        coefficients per sample, which is negligible for modulations that
+        are slow compared to N samples. Rates of 16 to 64 are inaudible for
+        slow modulations.
+
+        The filters created afterward use this rate, it can be changed for
+        a single filter with its `setCoeffRate` method. Supported by Biquad,
+        Biquadx, EQ, SVF, Reson, Resonx, ButLP, ButHP, ButBP, ButBR, MoogLP
+        and ComplexRes.
+
+        :Args:
+
+            x: int
+                Number of samples between two computations of the
+                coefficients, between 1 (the default, the coefficients
+                are computed at every sample) and 1024.
+
+        """
+        self._server.setCoeffRate(x)
+
+    def getCoeffRate(self):
+        """
+        Returns the default update rate of the coefficients of the modulated filters.
+
+        """
+        return self._server.getCoeffRate()
+
     def setGlobalDur(self, x):
         """
         Set the global object duration (time to wait before stopping the object).
@@ -976,6 +1182,39 @@ class Server(object):
         """
         self._server.recstop()
 
+    def setRecordBufferSize(self, x):
+        """
+        Set the size of the ring buffer used by recordings.
+
+        The audio callback never writes to the disk. It pushes its output
+        into a ring buffer emptied by a background thread. If the disk
+        can not keep up, the blocks that do not fit in the ring buffer are
+        dropped and counted (see getRecordOverruns method). Offline servers
+        wait for the disk instead. Also used by Record objects created
+        after the call. Takes effect at the next recstart() call.
+
+        :Args:
+
+            x: int
+                Size of the ring buffer, in sample frames. Defaults to 65536.
+
+        """
+        self._server.setRecordBufferSize(x)
+
+    def getRecordBufferSize(self):
+        """
+        Returns the size, in sample frames, of the recording ring buffer.
+
+        """
+        return self._server.getRecordBufferSize()
+
+    def getRecordOverruns(self):
+        """
+        Returns the number of blocks dropped by the server recordings.
+
+        """
+        return self._server.getRecordOverruns()
+
     def noteout(self, pitch, velocity, channel=0, timestamp=0):
         """
         Send a MIDI note message to the selected midi output device.
@@ -577,7 +577,9 @@ class OscBank(PyoObject):
 
         Altough parameters can be audio signals, values are sampled only once
         per buffer size. To avoid artefacts, it is recommended to keep variations
-        at low rate (< 20 Hz).
+        at low rate (< 20 Hz). When random deviations are active, the frequency
+        and the amplitude of each partial move linearly, over the buffer, from
+        the values of the previous buffer to the new ones.
 
     >>> s = Server().boot()
     >>> s.start()
@@ -3454,6 +3456,41 @@ class Granule(PyoObject):
         x, lmax = convertArgsToLists(x)
         [obj.setSync(wrap(x, i)) for i, obj in enumerate(self._base_objs)]
 
+    def setMaxGrains(self, x):
+        """
+        Sets the maximum number of grains playing at once.
+
+        When this number of grains is playing, new grains are dropped
+        until older ones end. Grains beyond a lowered maximum are cut
+        off immediately.
+
+        :Args:
+
+            x: int
+                Maximum number of overlapping grains per stream.
+                Defaults to 4096.
+
+        """
+        pyoArgsAssert(self, "i", x)
+        x, lmax = convertArgsToLists(x)
+        [obj.setMaxGrains(wrap(x, i)) for i, obj in enumerate(self._base_objs)]
+
+    def getActiveGrains(self):
+        """
+        Returns the number of grains currently playing, summed over all streams.
+
+        """
+        return sum(obj.getActiveGrains() for obj in self._base_objs)
+
+    def getDroppedGrains(self):
+        """
+        Returns the number of grains dropped since the object was created
+        because the maximum number of grains was reached, summed over all
+        streams.
+
+        """
+        return sum(obj.getDroppedGrains() for obj in self._base_objs)
+
     def ctrl(self, map_list=None, title=None, wxnoserver=False):
         self._map_list = [
             SLMap(1, 250, "lin", "dens", self._dens),
@@ -3829,6 +3866,41 @@ class Particle(PyoObject):
         x, lmax = convertArgsToLists(x)
         [obj.setPan(wrap(x, i)) for i, obj in enumerate(self._base_players)]
 
+    def setMaxGrains(self, x):
+        """
+        Sets the maximum number of grains playing at once.
+
+        When this number of grains is playing, new grains are dropped
+        until older ones end. Grains beyond a lowered maximum are cut
+        off immediately.
+
+        :Args:
+
+            x: int
+                Maximum number of overlapping grains per stream.
+                Defaults to 4096.
+
+        """
+        pyoArgsAssert(self, "i", x)
+        x, lmax = convertArgsToLists(x)
+        [obj.setMaxGrains(wrap(x, i)) for i, obj in enumerate(self._base_players)]
+
+    def getActiveGrains(self):
+        """
+        Returns the number of grains currently playing, summed over all streams.
+
+        """
+        return sum(obj.getActiveGrains() for obj in self._base_players)
+
+    def getDroppedGrains(self):
+        """
+        Returns the number of grains dropped since the object was created
+        because the maximum number of grains was reached, summed over all
+        streams.
+
+        """
+        return sum(obj.getDroppedGrains() for obj in self._base_players)
+
     def ctrl(self, map_list=None, title=None, wxnoserver=False):
         tablesize = self._table.getSize(False)
         self._map_list = [
@@ -22,6 +22,7 @@ from ._maps import *
 from ._widgets import createGraphWindow, createDataGraphWindow, createSndViewTableWindow
 from math import pi
 import copy
+import os
 
 ######################################################################
 ### Tables
@@ -1623,6 +1624,25 @@ class SndTable(PyoTableObject):
             the file.
         initchnls: int, optional
             Number of channels for an empty table (path=None). Defaults to 1.
+        mmap: boolean, optional
+            If True, the table memory-maps the sound instead of loading the
+            samples in RAM. Pages are read from disk the first time they are
+            accessed (see the `prefetch` method), so loading a large sample
+            library only costs a few milliseconds per file. Mono WAV files
+            of 32-bit floats (64-bit floats with the double precision
+            library) are mapped as they are. Other files are loaded in
+            memory, unless `cachedir` is given. Edits made to the table are
+            never written back to the file. Append and insert operations
+            bring the sound back in memory. Available on unix systems only,
+            elsewhere the sound is loaded in memory. Defaults to False.
+        cachedir: string, optional
+            Directory of the cache files, used when `mmap` is True and the
+            sound can't be mapped as it is. The sound is then decoded once
+            into a cache file holding all its channels as floats (between
+            two and four times the size of a 16-bit file), and the table
+            maps the cache. Choose a directory on a disk, the temporary
+            directory of the system is often held in RAM. The default
+            (None) disables the cache.
 
     >>> s = Server().boot()
     >>> s.start()
@@ -1633,7 +1653,7 @@ class SndTable(PyoTableObject):
 
     """
 
-    def __init__(self, path=None, chnl=None, start=0, stop=None, initchnls=1):
+    def __init__(self, path=None, chnl=None, start=0, stop=None, initchnls=1, mmap=False, cachedir=None):
         PyoTableObject.__init__(self)
         self._path = path
         self._chnl = chnl
@@ -1642,24 +1662,33 @@ class SndTable(PyoTableObject):
         self._size = []
         self._dur = []
         self._base_objs = []
+        self._mapkw = {}
+        if mmap:
+            self._mapkw = {"mmap": 1}
+            if cachedir is not None:
+                os.makedirs(cachedir, exist_ok=True)
+                self._mapkw["cachedir"] = cachedir
         path, lmax = convertArgsToLists(path)
         if self._path is None:
             self._base_objs = [SndTable_base("", 0, 0) for i in range(initchnls)]
         else:
+            kw = self._mapkw
             for p in path:
                 _size, _dur, _snd_sr, _snd_chnls, _format, _type = sndinfo(p, raise_on_failure=True)
                 if chnl is None:
                     if stop is None:
-                        self._base_objs.extend([SndTable_base(stringencode(p), i, start) for i in range(_snd_chnls)])
+                        self._base_objs.extend(
+                            [SndTable_base(stringencode(p), i, start, **kw) for i in range(_snd_chnls)]
+                        )
                     else:
                         self._base_objs.extend(
-                            [SndTable_base(stringencode(p), i, start, stop) for i in range(_snd_chnls)]
+                            [SndTable_base(stringencode(p), i, start, stop, **kw) for i in range(_snd_chnls)]
                         )
                 else:
                     if stop is None:
-                        self._base_objs.append(SndTable_base(stringencode(p), chnl, start))
+                        self._base_objs.append(SndTable_base(stringencode(p), chnl, start, **kw))
                     else:
-                        self._base_objs.append(SndTable_base(stringencode(p), chnl, start, stop))
+                        self._base_objs.append(SndTable_base(stringencode(p), chnl, start, stop, **kw))
                 self._size.append(self._base_objs[-1].getSize())
                 self._dur.append(self._size[-1] / float(_snd_sr))
             if lmax == 1:
@@ -1697,18 +1726,22 @@ class SndTable(PyoTableObject):
                 self._size.append(_size)
                 self._dur.append(_dur)
                 if stop is None:
-                    obj.setSound(stringencode(p), 0, start)
+                    obj.setSound(stringencode(p), 0, start, **self._mapkw)
                 else:
-                    obj.setSound(stringencode(p), 0, start, stop)
+                    obj.setSound(stringencode(p), 0, start, stop, **self._mapkw)
         else:
             _size, _dur, _snd_sr, _snd_chnls, _format, _type = sndinfo(path, raise_on_failure=True)
             self._size = _size
             self._dur = _dur
+            kw = self._mapkw
             if stop is None:
-                [obj.setSound(stringencode(path), (i % _snd_chnls), start) for i, obj in enumerate(self._base_objs)]
+                [
+                    obj.setSound(stringencode(path), (i % _snd_chnls), start, **kw)
+                    for i, obj in enumerate(self._base_objs)
+                ]
             else:
                 [
-                    obj.setSound(stringencode(path), (i % _snd_chnls), start, stop)
+                    obj.setSound(stringencode(path), (i % _snd_chnls), start, stop, **kw)
                     for i, obj in enumerate(self._base_objs)
                 ]
         self.refreshView()
@@ -1824,6 +1857,27 @@ class SndTable(PyoTableObject):
                 ]
         self.refreshView()
 
+    def prefetch(self, start=0, stop=None):
+        """
+        Read a region of a memory-mapped sound from disk in advance.
+
+        The pages are loaded in the background, so that the first reading
+        of this region does not have to wait for the disk. Does nothing if
+        the table was not created with `mmap` set to True.
+
+        :Args:
+
+            start: float, optional
+                Beginning of the region, in seconds. Defaults to 0.
+            stop: float, optional
+                End of the region, in seconds. The default (None) means the
+                end of the table.
+
+        """
+        if stop is None:
+            stop = -1
+        [obj.prefetch(start, stop) for obj in self._base_objs]
+
     def getViewTable(self, size, begin=0, end=0):
         """
         Return a list of points (in X, Y pixel values) for each channel in the table.
@@ -1888,6 +1942,7 @@ class SndTable(PyoTableObject):
         createSndViewTableWindow(self, title, wxnoserver, self.__class__.__name__, mouse_callback)
 
     def refreshView(self):
+        self._refreshMipmaps()
         if self.viewFrame is not None:
             self.viewFrame.update()
 
@@ -2128,6 +2183,7 @@ class NewTable(PyoTableObject):
         createSndViewTableWindow(self, title, wxnoserver, self.__class__.__name__, mouse_callback)
 
     def refreshView(self):
+        self._refreshMipmaps()
         if self.viewFrame is not None:
             self.viewFrame.update()
 
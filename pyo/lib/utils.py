@@ -641,7 +641,8 @@ class Record(PyoObject):
                 5. U-Law encoded
                 6. A-Law encoded
         buffering: int, optional
-            Number of bufferSize to wait before writing samples to disk.
+            Number of bufferSize to wait before sending samples to the
+            disk writer thread.
 
             High buffering uses more memory but improves performance.
             Defaults to 4.
@@ -654,6 +655,11 @@ class Record(PyoObject):
 
         All parameters can only be set at intialization time.
 
+        The file is written by a background thread. The samples go through
+        a ring buffer whose size is set with the Server's setRecordBufferSize
+        method. If the disk is too slow, samples are dropped instead of
+        blocking the audio callback (see getOverruns method).
+
         The stop() method must be called on the object to close the file
         properly.
 
@@ -723,6 +729,13 @@ class Record(PyoObject):
         self._input = x
         self._in_fader.setInput(x, fadetime)
 
+    def getOverruns(self):
+        """
+        Returns the number of blocks dropped because the disk was too slow.
+
+        """
+        return self._base_objs[0].getOverruns()
+
     @property
     def input(self):
         """PyoObject. Input signal to filter."""
@@ -168,6 +168,12 @@ if "--use-coreaudio" in sys.argv:
     macros.append(("USE_COREAUDIO", None))
     ad_files.append("ad_coreaudio.c")
 
+# Optional external FFT library
+if "--use-fftw" in sys.argv:
+    sys.argv.remove("--use-fftw")
+    macros.append(("USE_FFTW", None))
+    libraries += ["fftw3f", "fftw3"]
+
 path = "src/engine"
 files = [
     "pyomodule.c",
@@ -176,11 +182,22 @@ files = [
     "pvstreammodule.c",
     "dummymodule.c",
     "mixmodule.c",
+    "multichannelmodule.c",
+    "biquadbank.c",
+    "oscillatorbank.c",
     "inputfadermodule.c",
-    "interpolation.c",
     "fft.c",
     "wind.c",
     "vbap.c",
+    "scheduler.c",
+    "bufferpool.c",
+    "mixbus.c",
+    "muladd.c",
+    "grainkernel.c",
+    "arena.c",
+    "diskwriter.c",
+    "diskreader.c",
+    "convolver.c",
 ] + ad_files
 source_files = [os.path.join(path, f) for f in files]
 
@@ -165,12 +165,9 @@ jack_callback(jack_nframes_t nframes, void *arg)
 
     Server_process_buffers(server);
 
-    for (i = 0; i < server->bufferSize; i++)
+    for (j = 0; j < server->nchnls; j++)
     {
-        for (j = 0; j < server->nchnls; j++)
-        {
-            out_buffers[j][i] = (jack_default_audio_sample_t) server->output_buffer[(i * server->nchnls) + j];
-        }
+        memcpy(out_buffers[j], server->planar_output_buffer + j * server->bufferSize, server->bufferSize * sizeof(float));
     }
 
     server->midi_count = 0;
@@ -147,12 +147,9 @@ pa_callback_nonInterleaved( const void *inputBuffer, void *outputBuffer,
 
     Server_process_buffers(server);
 
-    for (i = 0; i < server->bufferSize; i++)
+    for (j = 0; j < server->nchnls; j++)
     {
-        for (j = 0; j < server->nchnls; j++)
-        {
-            out[j + server->output_offset][i] = (float) server->output_buffer[(i * server->nchnls) + j];
-        }
+        memcpy(out[j + server->output_offset], server->planar_output_buffer + j * server->bufferSize, server->bufferSize * sizeof(float));
     }
 
     server->midi_count = 0;
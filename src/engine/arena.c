@@ -0,0 +1,266 @@
+/**************************************************************************
+ * Copyright 2009-2015 Olivier Belanger                                   *
+ *                                                                        *
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *
+ *                                                                        *
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with pyo.  If not, see <http://www.gnu.org/licenses/>.   *
+ *************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "arena.h"
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <malloc.h>
+#endif
+
+/* Every block is preceded by a header of ARENA_ALIGN bytes, so that the
+   payload stays aligned. Size classes are multiples of 64 bytes up to
+   1024 bytes, then powers of two up to ARENA_MAX_CLASS. */
+
+#define ARENA_SMALL_CLASSES 16
+#define ARENA_NUM_CLASSES (ARENA_SMALL_CLASSES + 6)
+#define ARENA_LARGE -1
+#define ARENA_SLAB_SIZE (256 * 1024)
+
+typedef struct
+{
+    int cls; /* size class, or ARENA_LARGE. */
+    size_t size; /* requested size. */
+} ArenaHeader;
+
+typedef struct ArenaFree
+{
+    struct ArenaFree *next;
+} ArenaFree;
+
+typedef struct
+{
+    ArenaFree *freelist;
+    char *cursor; /* next unused block of the current slab. */
+    char *end;
+} ArenaClass;
+
+static ArenaClass arena_classes[ARENA_NUM_CLASSES];
+static ArenaStats arena_stats;
+static pthread_mutex_t arena_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static void *
+arena_system_alloc(size_t size)
+{
+#if defined(_WIN32) || defined(_WIN64)
+    return _aligned_malloc(size, ARENA_ALIGN);
+#else
+    void *ptr = NULL;
+
+    if (posix_memalign(&ptr, ARENA_ALIGN, size) != 0)
+        return NULL;
+
+    return ptr;
+#endif
+}
+
+static void
+arena_system_free(void *ptr)
+{
+#if defined(_WIN32) || defined(_WIN64)
+    _aligned_free(ptr);
+#else
+    free(ptr);
+#endif
+}
+
+static size_t
+arena_class_size(int cls)
+{
+    if (cls < ARENA_SMALL_CLASSES)
+        return (size_t)(cls + 1) * 64;
+    else
+        return (size_t)2048 << (cls - ARENA_SMALL_CLASSES);
+}
+
+static int
+arena_size_class(size_t size)
+{
+    int cls;
+
+    if (size > ARENA_MAX_CLASS)
+        return ARENA_LARGE;
+
+    if (size <= 64 * ARENA_SMALL_CLASSES)
+        return size == 0 ? 0 : (int)((size - 1) / 64);
+
+    for (cls = ARENA_SMALL_CLASSES; arena_class_size(cls) < size; cls++);
+
+    return cls;
+}
+
+/* Takes a block from the class free list or from its current slab. Called with the lock held. */
+static char *
+arena_class_alloc(int cls)
+{
+    ArenaClass *c = &arena_classes[cls];
+    size_t unit = ARENA_ALIGN + arena_class_size(cls);
+    char *block;
+
+    if (c->freelist != NULL)
+    {
+        block = (char *)c->freelist;
+        c->freelist = c->freelist->next;
+        return block - ARENA_ALIGN;
+    }
+
+    if (c->cursor == NULL || (size_t)(c->end - c->cursor) < unit)
+    {
+        size_t slabsize = unit > ARENA_SLAB_SIZE / 4 ? unit * 4 : ARENA_SLAB_SIZE;
+        char *slab = (char *)arena_system_alloc(slabsize);
+
+        if (slab == NULL)
+            return NULL;
+
+        /* The end of the previous slab, if any, is left unused. */
+        c->cursor = slab;
+        c->end = slab + slabsize - slabsize % unit;
+        arena_stats.reserved += slabsize;
+        arena_stats.slabs++;
+    }
+
+    block = c->cursor;
+    c->cursor += unit;
+
+    return block;
+}
+
+void *
+arena_alloc(size_t size)
+{
+    int cls = arena_size_class(size);
+    char *block;
+    ArenaHeader *header;
+
+    if (cls == ARENA_LARGE)
+    {
+        block = (char *)arena_system_alloc(ARENA_ALIGN + size);
+
+        if (block == NULL)
+            return NULL;
+
+        pthread_mutex_lock(&arena_lock);
+        arena_stats.reserved += ARENA_ALIGN + size;
+        arena_stats.large++;
+    }
+    else
+    {
+        pthread_mutex_lock(&arena_lock);
+        block = arena_class_alloc(cls);
+
+        if (block == NULL)
+        {
+            pthread_mutex_unlock(&arena_lock);
+            return NULL;
+        }
+    }
+
+    arena_stats.used += size;
+    arena_stats.blocks++;
+
+    if (arena_stats.used > arena_stats.peak)
+        arena_stats.peak = arena_stats.used;
+
+    pthread_mutex_unlock(&arena_lock);
+
+    header = (ArenaHeader *)block;
+    header->cls = cls;
+    header->size = size;
+
+    return block + ARENA_ALIGN;
+}
+
+void
+arena_free(void *ptr)
+{
+    ArenaHeader *header;
+    ArenaFree *node;
+
+    if (ptr == NULL)
+        return;
+
+    header = (ArenaHeader *)((char *)ptr - ARENA_ALIGN);
+
+    pthread_mutex_lock(&arena_lock);
+    arena_stats.used -= header->size;
+    arena_stats.blocks--;
+
+    if (header->cls == ARENA_LARGE)
+    {
+        arena_stats.reserved -= ARENA_ALIGN + header->size;
+        arena_stats.large--;
+        pthread_mutex_unlock(&arena_lock);
+        arena_system_free(header);
+        return;
+    }
+
+    node = (ArenaFree *)ptr;
+    node->next = arena_classes[header->cls].freelist;
+    arena_classes[header->cls].freelist = node;
+    pthread_mutex_unlock(&arena_lock);
+}
+
+void *
+arena_realloc(void *ptr, size_t size)
+{
+    ArenaHeader *header;
+    void *newptr;
+
+    if (ptr == NULL)
+        return arena_alloc(size);
+
+    header = (ArenaHeader *)((char *)ptr - ARENA_ALIGN);
+
+    /* Still fits in the same size class. */
+    if (header->cls != ARENA_LARGE && header->cls == arena_size_class(size))
+    {
+        pthread_mutex_lock(&arena_lock);
+        arena_stats.used += size;
+        arena_stats.used -= header->size;
+
+        if (arena_stats.used > arena_stats.peak)
+            arena_stats.peak = arena_stats.used;
+
+        pthread_mutex_unlock(&arena_lock);
+        header->size = size;
+        return ptr;
+    }
+
+    newptr = arena_alloc(size);
+
+    if (newptr == NULL)
+        return NULL;
+
+    memcpy(newptr, ptr, header->size < size ? header->size : size);
+    arena_free(ptr);
+
+    return newptr;
+}
+
+void
+arena_get_stats(ArenaStats *stats)
+{
+    pthread_mutex_lock(&arena_lock);
+    *stats = arena_stats;
+    pthread_mutex_unlock(&arena_lock);
+}
@@ -0,0 +1,242 @@
+/**************************************************************************
+ * Copyright 2009-2015 Olivier Belanger                                   *
+ *                                                                        *
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *
+ *                                                                        *
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with pyo.  If not, see <http://www.gnu.org/licenses/>.   *
+ *************************************************************************/
+
+#include <Python.h>
+#include <string.h>
+#include "pyomodule.h"
+#include "biquadbank.h"
+
+/* Number of samples of each array rounded up to a multiple of 16, so that
+   every array starts on a 64-byte boundary. */
+static int
+BiquadBank_stride(int size)
+{
+    return (size + 15) & ~15;
+}
+
+int
+BiquadBank_alloc(BiquadBank *self, int size)
+{
+    int i, stride = BiquadBank_stride(size);
+    MYFLT *memory;
+    int *init;
+
+    memory = (MYFLT *)arena_realloc(self->memory, 10 * stride * sizeof(MYFLT));
+
+    if (memory == NULL)
+        return -1;
+
+    self->memory = memory;
+
+    init = (int *)PyMem_RawRealloc(self->init, size * sizeof(int));
+
+    if (init == NULL)
+        return -1;
+
+    self->init = init;
+
+    memset(memory, 0, 10 * stride * sizeof(MYFLT));
+
+    self->b0 = memory;
+    self->b1 = memory + stride;
+    self->b2 = memory + 2 * stride;
+    self->a0 = memory + 3 * stride;
+    self->a1 = memory + 4 * stride;
+    self->a2 = memory + 5 * stride;
+    self->x1 = memory + 6 * stride;
+    self->x2 = memory + 7 * stride;
+    self->y1 = memory + 8 * stride;
+    self->y2 = memory + 9 * stride;
+
+    for (i = 0; i < size; i++)
+        self->init[i] = 1;
+
+    self->size = size;
+
+    return 0;
+}
+
+void
+BiquadBank_free(BiquadBank *self)
+{
+    arena_free(self->memory);
+    PyMem_RawFree(self->init);
+    self->memory = NULL;
+    self->init = NULL;
+    self->size = 0;
+}
+
+void
+BiquadBank_setCoeffs(BiquadBank *self, int f, int type, MYFLT c, MYFLT alpha)
+{
+    switch (type)
+    {
+        case BIQUADBANK_HIGHPASS:
+            self->b0[f] = (1 + c) / 2;
+            self->b1[f] = -(1 + c);
+            self->b2[f] = self->b0[f];
+            self->a0[f] = 1.0 / (1 + alpha);
+            self->a1[f] = -2 * c;
+            self->a2[f] = 1 - alpha;
+            break;
+
+        case BIQUADBANK_BANDPASS:
+            self->b0[f] = alpha;
+            self->b1[f] = 0;
+            self->b2[f] = -alpha;
+            self->a0[f] = 1.0 / (1 + alpha);
+            self->a1[f] = -2 * c;
+            self->a2[f] = 1 - alpha;
+            break;
+
+        case BIQUADBANK_BANDSTOP:
+            self->b0[f] = 1;
+            self->b1[f] = self->a1[f] = -2 * c;
+            self->b2[f] = 1;
+            self->a0[f] = 1.0 / (1 + alpha);
+            self->a2[f] = 1 - alpha;
+            break;
+
+        case BIQUADBANK_ALLPASS:
+            self->b0[f] = self->a2[f] = 1 - alpha;
+            self->b1[f] = self->a1[f] = -2 * c;
+            self->b2[f] = 1 + alpha;
+            self->a0[f] = 1.0 / (1 + alpha);
+            break;
+
+        default:
+            self->b0[f] = self->b2[f] = (1 - c) / 2;
+            self->b1[f] = 1 - c;
+            self->a0[f] = 1.0 / (1 + alpha);
+            self->a1[f] = -2 * c;
+            self->a2[f] = 1 - alpha;
+            break;
+    }
+}
+
+void
+BiquadBank_setEQCoeffs(BiquadBank *self, int f, int type, MYFLT A, MYFLT c, MYFLT alpha)
+{
+    MYFLT alphaMul, alphaDiv, twoSqrtAAlpha, AminOneC, AAddOneC;
+
+    switch (type)
+    {
+        case BIQUADBANK_LOWSHELF:
+            twoSqrtAAlpha = MYSQRT(A * 2.0) * alpha;
+            AminOneC = (A - 1.0) * c;
+            AAddOneC = (A + 1.0) * c;
+            self->b0[f] = A * ((A + 1.0) - AminOneC + twoSqrtAAlpha);
+            self->b1[f] = 2.0 * A * ((A - 1.0) - AAddOneC);
+            self->b2[f] = A * ((A + 1.0) - AminOneC - twoSqrtAAlpha);
+            self->a0[f] = 1.0 / ((A + 1.0) + AminOneC + twoSqrtAAlpha);
+            self->a1[f] = -2.0 * ((A - 1.0) + AAddOneC);
+            self->a2[f] = (A + 1.0) + AminOneC - twoSqrtAAlpha;
+            break;
+
+        case BIQUADBANK_HIGHSHELF:
+            twoSqrtAAlpha = MYSQRT(A * 2.0) * alpha;
+            AminOneC = (A - 1.0) * c;
+            AAddOneC = (A + 1.0) * c;
+            self->b0[f] = A * ((A + 1.0) + AminOneC + twoSqrtAAlpha);
+            self->b1[f] = -2.0 * A * ((A - 1.0) + AAddOneC);
+            self->b2[f] = A * ((A + 1.0) + AminOneC - twoSqrtAAlpha);
+            self->a0[f] = 1.0 / ((A + 1.0) - AminOneC + twoSqrtAAlpha);
+            self->a1[f] = 2.0 * ((A - 1.0) - AAddOneC);
+            self->a2[f] = (A + 1.0) - AminOneC - twoSqrtAAlpha;
+            break;
+
+        default:
+            alphaMul = alpha * A;
+            alphaDiv = alpha / A;
+            self->b0[f] = 1.0 + alphaMul;
+            self->b1[f] = self->a1[f] = -2.0 * c;
+            self->b2[f] = 1.0 - alphaMul;
+            self->a0[f] = 1.0 / (1.0 + alphaDiv);
+            self->a2[f] = 1.0 - alphaDiv;
+            break;
+    }
+}
+
+void
+BiquadBank_copyCoeffs(BiquadBank *self, int dst, int src)
+{
+    self->b0[dst] = self->b0[src];
+    self->b1[dst] = self->b1[src];
+    self->b2[dst] = self->b2[src];
+    self->a0[dst] = self->a0[src];
+    self->a1[dst] = self->a1[src];
+    self->a2[dst] = self->a2[src];
+}
+
+void
+BiquadBank_prime(BiquadBank *self, int f, MYFLT x)
+{
+    if (self->init[f])
+    {
+        self->x1[f] = self->x2[f] = self->y1[f] = self->y2[f] = x;
+        self->init[f] = 0;
+    }
+}
+
+void
+BiquadBank_process(BiquadBank *self, int first, int lanes, MYFLT **in, MYFLT **out, int bufsize)
+{
+    MYFLT b0[PYO_BIQUADBANK_LANES], b1[PYO_BIQUADBANK_LANES], b2[PYO_BIQUADBANK_LANES];
+    MYFLT a0[PYO_BIQUADBANK_LANES], a1[PYO_BIQUADBANK_LANES], a2[PYO_BIQUADBANK_LANES];
+    MYFLT x1[PYO_BIQUADBANK_LANES], x2[PYO_BIQUADBANK_LANES], y1[PYO_BIQUADBANK_LANES], y2[PYO_BIQUADBANK_LANES];
+    MYFLT x, val;
+    int i, j;
+
+    for (j = 0; j < lanes; j++)
+    {
+        b0[j] = self->b0[first + j];
+        b1[j] = self->b1[first + j];
+        b2[j] = self->b2[first + j];
+        a0[j] = self->a0[first + j];
+        a1[j] = self->a1[first + j];
+        a2[j] = self->a2[first + j];
+        x1[j] = self->x1[first + j];
+        x2[j] = self->x2[first + j];
+        y1[j] = self->y1[first + j];
+        y2[j] = self->y2[first + j];
+    }
+
+    for (i = 0; i < bufsize; i++)
+    {
+        for (j = 0; j < lanes; j++)
+        {
+            x = in[j][i];
+            val = ( (b0[j] * x) + (b1[j] * x1[j]) + (b2[j] * x2[j]) - (a1[j] * y1[j]) - (a2[j] * y2[j]) ) * a0[j];
+            y2[j] = y1[j];
+            y1[j] = val;
+            x2[j] = x1[j];
+            x1[j] = x;
+            out[j][i] = val;
+        }
+    }
+
+    for (j = 0; j < lanes; j++)
+    {
+        self->x1[first + j] = x1[j];
+        self->x2[first + j] = x2[j];
+        self->y1[first + j] = y1[j];
+        self->y2[first + j] = y2[j];
+    }
+}
@@ -0,0 +1,411 @@
+/**************************************************************************
+ * Copyright 2009-2015 Olivier Belanger                                   *
+ *                                                                        *
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *
+ *                                                                        *
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with pyo.  If not, see <http://www.gnu.org/licenses/>.   *
+ *************************************************************************/
+
+/* Sharing of the stream buffers.
+ *
+ * Most streams are read, during the block, by a few streams computed after
+ * them (the Dummy objects created by the arithmetic operators, an oscillator
+ * feeding a filter, ...). Once its last reader has been computed, the buffer
+ * of such a stream is useless until the stream is computed again in the next
+ * block. The plan gives each of these streams a buffer from a small pool, in
+ * list order, a buffer being taken again by a later stream as soon as the
+ * last reader of its previous owner has been computed. The readers are found,
+ * as in the scheduler, from the objects visited by each stream's tp_traverse
+ * function.
+ *
+ * A stream is computed in a shared buffer only if its object overwrites the
+ * whole buffer every block (Stream_setShareable), and if it is read by at
+ * least one stream computed after it and by none computed before it (that one
+ * reads the previous block). Its own buffer goes back to the arena while it
+ * is shared. The plan is computed again when a stream is added, removed or
+ * moved, or when an object is given a new stream to read by one of its
+ * setters (Stream_invalidateGraph). */
+
+#include <Python.h>
+#include <stdint.h>
+#include <string.h>
+#include "bufferpool.h"
+#include "dummymodule.h"
+
+/* Every audio object starts with pyo_audio_HEAD. */
+typedef struct
+{
+    pyo_audio_HEAD
+} BufferPoolObject;
+
+static unsigned int
+BufferPool_hash(void *key)
+{
+    uintptr_t k = (uintptr_t)key >> 4;
+    return (unsigned int)(k ^ (k >> 16)) * 2654435761u;
+}
+
+static BufferPoolEntry *
+BufferPool_lookup(PyoBufferPool *self, void *key)
+{
+    unsigned int mask = self->tableSize - 1;
+    unsigned int h = BufferPool_hash(key) & mask;
+
+    while (self->table[h].key != NULL)
+    {
+        if (self->table[h].key == key)
+            return &self->table[h];
+
+        h = (h + 1) & mask;
+    }
+
+    return NULL;
+}
+
+static void
+BufferPool_insert(PyoBufferPool *self, void *key, int node)
+{
+    unsigned int mask = self->tableSize - 1;
+    unsigned int h = BufferPool_hash(key) & mask;
+
+    while (self->table[h].key != NULL)
+    {
+        if (self->table[h].key == key)
+            return;
+
+        h = (h + 1) & mask;
+    }
+
+    self->table[h].key = key;
+    self->table[h].node = node;
+}
+
+static void
+BufferPool_addRef(PyoBufferPool *self, PyObject *obj)
+{
+    if (obj == NULL || obj == self->server)
+        return;
+
+    if (self->nrefs >= self->refsSize)
+    {
+        self->refsSize = self->refsSize == 0 ? 64 : self->refsSize * 2;
+        self->refs = (PyObject **)PyMem_RawRealloc(self->refs, self->refsSize * sizeof(PyObject *));
+    }
+
+    self->refs[self->nrefs++] = obj;
+}
+
+static int
+BufferPool_visit(PyObject *obj, void *arg)
+{
+    Py_ssize_t i;
+    PyObject *value;
+    PyoBufferPool *self = (PyoBufferPool *)arg;
+
+    if (PyList_CheckExact(obj))
+    {
+        for (i = 0; i < PyList_GET_SIZE(obj); i++)
+            BufferPool_addRef(self, PyList_GET_ITEM(obj, i));
+    }
+    else if (PyTuple_CheckExact(obj))
+    {
+        for (i = 0; i < PyTuple_GET_SIZE(obj); i++)
+            BufferPool_addRef(self, PyTuple_GET_ITEM(obj, i));
+    }
+    else if (PyDict_CheckExact(obj))
+    {
+        i = 0;
+
+        while (PyDict_Next(obj, &i, NULL, &value))
+            BufferPool_addRef(self, value);
+    }
+    else
+    {
+        BufferPool_addRef(self, obj);
+    }
+
+    return 0;
+}
+
+static void
+BufferPool_reserve(PyoBufferPool *self, int capacity)
+{
+    unsigned int size = 1024;
+
+    if (capacity > self->capacity)
+    {
+        self->lastReader = (int *)PyMem_RawRealloc(self->lastReader, capacity * sizeof(int));
+        self->readEarly = (int *)PyMem_RawRealloc(self->readEarly, capacity * sizeof(int));
+        self->buffer = (int *)PyMem_RawRealloc(self->buffer, capacity * sizeof(int));
+        self->releaseHead = (int *)PyMem_RawRealloc(self->releaseHead, capacity * sizeof(int));
+        self->releaseNext = (int *)PyMem_RawRealloc(self->releaseNext, capacity * sizeof(int));
+        self->capacity = capacity;
+    }
+
+    /* Streams and their objects, the table stays at most half full. */
+    while (size < (unsigned int)capacity * 4)
+        size <<= 1;
+
+    if (size > self->tableSize)
+    {
+        PyMem_RawFree(self->table);
+        self->table = (BufferPoolEntry *)PyMem_RawMalloc(size * sizeof(BufferPoolEntry));
+        self->tableSize = size;
+    }
+
+    memset(self->table, 0, self->tableSize * sizeof(BufferPoolEntry));
+}
+
+/* Returns a new shared buffer. */
+static int
+BufferPool_grow(PyoBufferPool *self)
+{
+    int i;
+
+    if (self->count >= self->size)
+    {
+        self->size = self->size == 0 ? 16 : self->size * 2;
+        self->buffers = (MYFLT **)PyMem_RawRealloc(self->buffers, self->size * sizeof(MYFLT *));
+        self->freeList = (int *)PyMem_RawRealloc(self->freeList, self->size * sizeof(int));
+    }
+
+    self->buffers[self->count] = (MYFLT *)arena_alloc(self->bufsize * sizeof(MYFLT));
+
+    for (i = 0; i < self->bufsize; i++)
+        self->buffers[self->count][i] = 0.0;
+
+    return self->count++;
+}
+
+static void
+BufferPool_freeBuffers(PyoBufferPool *self, int from)
+{
+    int i;
+
+    for (i = from; i < self->count; i++)
+        arena_free(self->buffers[i]);
+
+    self->count = from;
+}
+
+static void
+BufferPool_attach(Stream *stream, MYFLT *data)
+{
+    BufferPoolObject *obj = (BufferPoolObject *)stream->streamobject;
+
+    if (! stream->shared)
+        arena_free(obj->data);
+
+    obj->data = data;
+    stream->data = data;
+    stream->shared = 1;
+}
+
+/* Gives back its own buffer to a stream computed in a shared buffer. */
+void
+BufferPool_detach(Stream *stream)
+{
+    int i;
+    BufferPoolObject *obj;
+
+    if (! stream->shared)
+        return;
+
+    obj = (BufferPoolObject *)stream->streamobject;
+    obj->data = (MYFLT *)arena_alloc(stream->bufsize * sizeof(MYFLT));
+
+    for (i = 0; i < stream->bufsize; i++)
+        obj->data[i] = 0.0;
+
+    stream->data = obj->data;
+    stream->shared = 0;
+}
+
+PyoBufferPool *
+BufferPool_new()
+{
+    PyoBufferPool *self = (PyoBufferPool *)PyMem_RawMalloc(sizeof(PyoBufferPool));
+
+    memset(self, 0, sizeof(PyoBufferPool));
+
+    return self;
+}
+
+void
+BufferPool_free(PyoBufferPool *self)
+{
+    BufferPool_freeBuffers(self, 0);
+    PyMem_RawFree(self->buffers);
+    PyMem_RawFree(self->freeList);
+    PyMem_RawFree(self->lastReader);
+    PyMem_RawFree(self->readEarly);
+    PyMem_RawFree(self->buffer);
+    PyMem_RawFree(self->releaseHead);
+    PyMem_RawFree(self->releaseNext);
+    PyMem_RawFree(self->table);
+    PyMem_RawFree(self->refs);
+    PyMem_RawFree(self);
+}
+
+/* Computes the plan for the streams of the list and moves them to their buffers.
+   Must not be called while a block is computed. */
+void
+BufferPool_build(PyoBufferPool *self, Stream **streams, int count, int bufsize, PyObject *server)
+{
+    int i, j, k, nfree, used;
+    Stream *stream;
+    PyObject *obj;
+    BufferPoolEntry *entry;
+
+    if (bufsize != self->bufsize)
+    {
+        BufferPool_release(self, streams, count);
+        self->bufsize = bufsize;
+    }
+
+    self->server = server;
+    self->serial = Stream_getGraphSerial();
+    self->built = 1;
+
+    if (count <= 0)
+        return;
+
+    BufferPool_reserve(self, count);
+
+    for (k = 0; k < count; k++)
+    {
+        self->lastReader[k] = -1;
+        self->readEarly[k] = 0;
+        self->buffer[k] = -1;
+        self->releaseHead[k] = -1;
+
+        if (streams[k] != NULL)
+        {
+            BufferPool_insert(self, streams[k], k);
+
+            if (streams[k]->streamobject != NULL)
+                BufferPool_insert(self, streams[k]->streamobject, k);
+        }
+    }
+
+    /* Readers of each stream. */
+    for (k = 0; k < count; k++)
+    {
+        if ((stream = streams[k]) == NULL)
+            continue;
+
+        obj = stream->streamobject;
+
+        /* Unknown readers, nothing can be shared. */
+        if (obj == NULL || Py_TYPE(obj)->tp_traverse == NULL)
+        {
+            for (i = 0; i < count; i++)
+                self->readEarly[i] = 1;
+
+            break;
+        }
+
+        self->nrefs = 0;
+        Py_TYPE(obj)->tp_traverse(obj, BufferPool_visit, self);
+
+        /* The objects read by the Dummy objects it computes inline. */
+        if (Py_TYPE(obj) == &DummyType)
+            Dummy_visitInlined(obj, BufferPool_visit, self);
+
+        for (j = 0; j < self->nrefs; j++)
+        {
+            entry = BufferPool_lookup(self, self->refs[j]);
+
+            if (entry == NULL || entry->node == k)
+                continue;
+
+            if (entry->node > k)
+                self->readEarly[entry->node] = 1;
+            else if (self->lastReader[entry->node] < k)
+                self->lastReader[entry->node] = k;
+        }
+    }
+
+    /* Gives the buffers in list order, the lowest free buffer first. */
+    nfree = 0;
+    used = 0;
+
+    for (i = self->count - 1; i >= 0; i--)
+        self->freeList[nfree++] = i;
+
+    for (k = 0; k < count; k++)
+    {
+        stream = streams[k];
+
+        if (stream != NULL && stream->shareable && stream->bufsize == bufsize &&
+            self->lastReader[k] > k && ! self->readEarly[k])
+        {
+            self->buffer[k] = nfree > 0 ? self->freeList[--nfree] : BufferPool_grow(self);
+
+            if (self->buffer[k] >= used)
+                used = self->buffer[k] + 1;
+
+            self->releaseNext[k] = self->releaseHead[self->lastReader[k]];
+            self->releaseHead[self->lastReader[k]] = k;
+        }
+
+        for (j = self->releaseHead[k]; j != -1; j = self->releaseNext[j])
+        {
+            /* Keeps the lowest buffers on top of the free list. */
+            for (i = nfree; i > 0 && self->freeList[i - 1] < self->buffer[j]; i--)
+                self->freeList[i] = self->freeList[i - 1];
+
+            self->freeList[i] = self->buffer[j];
+            nfree++;
+        }
+    }
+
+    self->shared = 0;
+
+    for (k = 0; k < count; k++)
+    {
+        if ((stream = streams[k]) == NULL)
+            continue;
+
+        if (self->buffer[k] >= 0)
+        {
+            BufferPool_attach(stream, self->buffers[self->buffer[k]]);
+            self->shared++;
+        }
+        else
+        {
+            BufferPool_detach(stream);
+        }
+    }
+
+    BufferPool_freeBuffers(self, used);
+}
+
+/* Gives back their own buffer to the streams and frees the shared buffers. */
+void
+BufferPool_release(PyoBufferPool *self, Stream **streams, int count)
+{
+    int k;
+
+    for (k = 0; k < count; k++)
+    {
+        if (streams[k] != NULL)
+            BufferPool_detach(streams[k]);
+    }
+
+    BufferPool_freeBuffers(self, 0);
+    self->shared = 0;
+    self->built = 0;
+}
@@ -0,0 +1,526 @@
+/**************************************************************************
+ * Copyright 2009-2015 Olivier Belanger                                   *
+ *                                                                        *
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *
+ *                                                                        *
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with pyo.  If not, see <http://www.gnu.org/licenses/>.   *
+ *************************************************************************/
+
+#include <Python.h>
+#include <sched.h>
+#include <string.h>
+#include "convolver.h"
+#include "fft.h"
+
+static void
+Convolver_allocLevel(PyoConvLevel *lv, int bsize, int num, int background)
+{
+    lv->bsize = bsize;
+    lv->num = num;
+    lv->fdlpos = 0;
+
+    lv->plan = fft_plan_acquire(bsize * 2, PYO_FFT_REAL);
+
+    lv->impulse_real = (MYFLT *)PyMem_RawCalloc(num * bsize, sizeof(MYFLT));
+    lv->impulse_imag = (MYFLT *)PyMem_RawCalloc(num * bsize, sizeof(MYFLT));
+    lv->fdl_real = (MYFLT *)PyMem_RawCalloc(num * bsize, sizeof(MYFLT));
+    lv->fdl_imag = (MYFLT *)PyMem_RawCalloc(num * bsize, sizeof(MYFLT));
+    lv->sum_real = (MYFLT *)PyMem_RawCalloc(bsize, sizeof(MYFLT));
+    lv->sum_imag = (MYFLT *)PyMem_RawCalloc(bsize, sizeof(MYFLT));
+    lv->frame = (MYFLT *)PyMem_RawCalloc(bsize * 4, sizeof(MYFLT));
+    lv->last = (MYFLT *)PyMem_RawCalloc(bsize, sizeof(MYFLT));
+
+    if (background)
+    {
+        lv->fill = (MYFLT *)PyMem_RawCalloc(bsize, sizeof(MYFLT));
+        lv->input = (MYFLT *)PyMem_RawCalloc(bsize, sizeof(MYFLT));
+        lv->result = (MYFLT *)PyMem_RawCalloc(bsize, sizeof(MYFLT));
+        lv->playing = (MYFLT *)PyMem_RawCalloc(bsize, sizeof(MYFLT));
+    }
+}
+
+static void
+Convolver_freeLevel(PyoConvLevel *lv)
+{
+    fft_plan_release(lv->plan);
+    PyMem_RawFree(lv->impulse_real);
+    PyMem_RawFree(lv->impulse_imag);
+    PyMem_RawFree(lv->fdl_real);
+    PyMem_RawFree(lv->fdl_imag);
+    PyMem_RawFree(lv->sum_real);
+    PyMem_RawFree(lv->sum_imag);
+    PyMem_RawFree(lv->frame);
+    PyMem_RawFree(lv->last);
+    PyMem_RawFree(lv->fill);
+    PyMem_RawFree(lv->input);
+    PyMem_RawFree(lv->result);
+    PyMem_RawFree(lv->playing);
+}
+
+/* Spectra of the impulse partitions of a level, `impulse` starting at the
+   level's offset in the impulse. */
+static void
+Convolver_analyseLevel(PyoConvLevel *lv, const MYFLT *impulse, int length, MYFLT gain)
+{
+    int i, p, n, bsize = lv->bsize, size2 = lv->bsize * 2;
+    MYFLT scl = gain * size2;
+    MYFLT *inframe = lv->frame, *outframe = lv->frame + size2;
+    MYFLT *hr, *hi;
+
+    for (p = 0; p < lv->num; p++)
+    {
+        n = length - p * bsize;
+
+        if (n > bsize)
+            n = bsize;
+
+        for (i = 0; i < n; i++)
+            inframe[i] = impulse[p * bsize + i];
+
+        for (i = n; i < size2; i++)
+            inframe[i] = 0.0;
+
+        fft_plan_forward(lv->plan, inframe, outframe);
+
+        hr = lv->impulse_real + p * bsize;
+        hi = lv->impulse_imag + p * bsize;
+        hr[0] = outframe[0] * scl;
+        hi[0] = outframe[bsize] * scl; /* Nyquist, real */
+
+        for (i = 1; i < bsize; i++)
+        {
+            hr[i] = outframe[i] * scl;
+            hi[i] = outframe[size2 - i] * scl;
+        }
+    }
+
+    memset(lv->frame, 0, bsize * 4 * sizeof(MYFLT));
+}
+
+/* Spectrum of the next input block, stored in the delay line. */
+static void
+Convolver_forward(PyoConvLevel *lv, const MYFLT *in)
+{
+    int i, bsize = lv->bsize, size2 = lv->bsize * 2;
+    MYFLT *inframe = lv->frame, *outframe = lv->frame + size2;
+    MYFLT *xr, *xi;
+
+    memcpy(inframe, lv->last, bsize * sizeof(MYFLT));
+    memcpy(inframe + bsize, in, bsize * sizeof(MYFLT));
+    memcpy(lv->last, in, bsize * sizeof(MYFLT));
+
+    fft_plan_forward(lv->plan, inframe, outframe);
+
+    lv->fdlpos++;
+
+    if (lv->fdlpos == lv->num)
+        lv->fdlpos = 0;
+
+    xr = lv->fdl_real + lv->fdlpos * bsize;
+    xi = lv->fdl_imag + lv->fdlpos * bsize;
+    xr[0] = outframe[0];
+    xi[0] = outframe[bsize];
+
+    for (i = 1; i < bsize; i++)
+    {
+        xr[i] = outframe[i];
+        xi[i] = outframe[size2 - i];
+    }
+}
+
+/* Output block of the delay line through all the partitions of a level. */
+static void
+Convolver_output(PyoConvLevel *lv, MYFLT *out)
+{
+    int i, p, slot, bsize = lv->bsize, size2 = lv->bsize * 2;
+    MYFLT *inframe = lv->frame, *outframe = lv->frame + size2;
+    MYFLT *xr, *xi, *hr, *hi;
+    MYFLT *sr = lv->sum_real, *si = lv->sum_imag;
+
+    memset(sr, 0, bsize * sizeof(MYFLT));
+    memset(si, 0, bsize * sizeof(MYFLT));
+
+    /* Oldest input block first. */
+    for (p = lv->num - 1; p >= 0; p--)
+    {
+        slot = lv->fdlpos - p;
+
+        if (slot < 0)
+            slot += lv->num;
+
+        xr = lv->fdl_real + slot * bsize;
+        xi = lv->fdl_imag + slot * bsize;
+        hr = lv->impulse_real + p * bsize;
+        hi = lv->impulse_imag + p * bsize;
+
+        sr[0] += xr[0] * hr[0];
+        si[0] += xi[0] * hi[0];
+
+        for (i = 1; i < bsize; i++)
+        {
+            sr[i] += xr[i] * hr[i] - xi[i] * hi[i];
+            si[i] += xr[i] * hi[i] + xi[i] * hr[i];
+        }
+    }
+
+    inframe[0] = sr[0];
+    inframe[bsize] = si[0];
+
+    for (i = 1; i < bsize; i++)
+    {
+        inframe[i] = sr[i];
+        inframe[size2 - i] = si[i];
+    }
+
+    fft_plan_inverse(lv->plan, inframe, outframe);
+
+    memcpy(out, outframe + bsize, bsize * sizeof(MYFLT));
+}
+
+/* Overlap-save of one input block through all the partitions of a level. */
+static void
+Convolver_runLevel(PyoConvLevel *lv, const MYFLT *in, MYFLT *out)
+{
+    Convolver_forward(lv, in);
+    Convolver_output(lv, out);
+}
+
+static int
+Convolver_hasJob(PyoConvolver *self)
+{
+    int k;
+
+    for (k = 1; k < self->nlevels; k++)
+    {
+        if (__atomic_load_n(&self->levels[k].posted, __ATOMIC_ACQUIRE) != self->levels[k].completed)
+            return 1;
+    }
+
+    return 0;
+}
+
+static void *
+Convolver_worker(void *arg)
+{
+    int k;
+    unsigned int posted;
+    PyoConvLevel *lv;
+    PyoConvolver *self = (PyoConvolver *)arg;
+
+    pthread_mutex_lock(&self->mutex);
+
+    for (;;)
+    {
+        while (! Convolver_hasJob(self) && ! self->quit)
+            pthread_cond_wait(&self->cond, &self->mutex);
+
+        if (self->quit)
+            break;
+
+        pthread_mutex_unlock(&self->mutex);
+
+        /* Smaller blocks have the earliest deadlines. */
+        for (k = 1; k < self->nlevels; k++)
+        {
+            lv = &self->levels[k];
+            posted = __atomic_load_n(&lv->posted, __ATOMIC_ACQUIRE);
+
+            if (posted != lv->completed)
+            {
+                Convolver_runLevel(lv, lv->input, lv->result);
+                __atomic_store_n(&lv->completed, posted, __ATOMIC_RELEASE);
+            }
+        }
+
+        pthread_mutex_lock(&self->mutex);
+    }
+
+    pthread_mutex_unlock(&self->mutex);
+
+    return NULL;
+}
+
+PyoConvolver *
+Convolver_new(const MYFLT *impulse, int length, int size, int maxblock, MYFLT gain, int threaded)
+{
+    int k, num, bsize = size, offset = 0, last;
+    PyoConvolver *self = (PyoConvolver *)PyMem_RawMalloc(sizeof(PyoConvolver));
+
+    memset(self, 0, sizeof(PyoConvolver));
+    self->size = size;
+
+    /* Head: 3 partitions of `size` samples. Then 2 partitions per level, the
+       block size doubling at each level, until `maxblock` where the last
+       level takes the rest of the impulse. */
+    for (k = 0; k < PYO_CONV_MAX_LEVELS; k++)
+    {
+        last = (bsize * 2) > maxblock || k == (PYO_CONV_MAX_LEVELS - 1);
+        num = (length - offset + bsize - 1) / bsize;
+
+        if (! last && num > (k == 0 ? 3 : 2))
+            num = k == 0 ? 3 : 2;
+
+        if (num < 1)
+            num = 1;
+
+        Convolver_allocLevel(&self->levels[k], bsize, num, k > 0);
+        self->levels[k].gain = gain;
+        Convolver_analyseLevel(&self->levels[k], impulse + offset, length - offset, gain);
+        self->nlevels++;
+
+        offset += num * bsize;
+        bsize *= 2;
+
+        if (offset >= length || last)
+            break;
+    }
+
+    if (threaded && self->nlevels > 1)
+    {
+        pthread_mutex_init(&self->mutex, NULL);
+        pthread_cond_init(&self->cond, NULL);
+
+        if (pthread_create(&self->thread, NULL, Convolver_worker, self) == 0)
+            self->threaded = 1;
+        else
+        {
+            pthread_mutex_destroy(&self->mutex);
+            pthread_cond_destroy(&self->cond);
+        }
+    }
+
+    return self;
+}
+
+void
+Convolver_free(PyoConvolver *self)
+{
+    int k;
+
+    if (self->threaded)
+    {
+        pthread_mutex_lock(&self->mutex);
+        self->quit = 1;
+        pthread_cond_signal(&self->cond);
+        pthread_mutex_unlock(&self->mutex);
+        pthread_join(self->thread, NULL);
+        pthread_mutex_destroy(&self->mutex);
+        pthread_cond_destroy(&self->cond);
+    }
+
+    for (k = 0; k < self->nlevels; k++)
+        Convolver_freeLevel(&self->levels[k]);
+
+    PyMem_RawFree(self);
+}
+
+void
+Convolver_setImpulse(PyoConvolver *self, const MYFLT *impulse, int length)
+{
+    int k, offset = 0;
+    PyoConvLevel *lv;
+
+    for (k = 0; k < self->nlevels; k++)
+    {
+        lv = &self->levels[k];
+
+        /* The worker must be done with the spectra of this level. */
+        while (__atomic_load_n(&lv->completed, __ATOMIC_ACQUIRE) != lv->posted)
+            sched_yield();
+
+        Convolver_analyseLevel(lv, impulse + offset, length - offset, lv->gain);
+        offset += lv->num * lv->bsize;
+    }
+}
+
+void
+Convolver_refresh(PyoConvolver *self, MYFLT *out)
+{
+    int i, k, size = self->size;
+    MYFLT *play;
+    PyoConvLevel *lv;
+
+    Convolver_output(&self->levels[0], out);
+
+    for (k = 1; k < self->nlevels; k++)
+    {
+        lv = &self->levels[k];
+        play = lv->playing + lv->playpos - size;
+
+        for (i = 0; i < size; i++)
+            out[i] += play[i];
+    }
+}
+
+void
+Convolver_process(PyoConvolver *self, const MYFLT *in, MYFLT *out)
+{
+    int i, k, size = self->size;
+    MYFLT *tmp, *play;
+    PyoConvLevel *lv;
+
+    Convolver_runLevel(&self->levels[0], in, out);
+
+    for (k = 1; k < self->nlevels; k++)
+    {
+        lv = &self->levels[k];
+        memcpy(lv->fill + lv->fillpos, in, size * sizeof(MYFLT));
+        lv->fillpos += size;
+
+        if (lv->fillpos == lv->bsize)
+        {
+            /* The previous job of this level is due now. */
+            while (__atomic_load_n(&lv->completed, __ATOMIC_ACQUIRE) != lv->posted)
+                sched_yield();
+
+            tmp = lv->playing;
+            lv->playing = lv->result;
+            lv->result = tmp;
+            lv->playpos = 0;
+
+            tmp = lv->input;
+            lv->input = lv->fill;
+            lv->fill = tmp;
+            lv->fillpos = 0;
+
+            if (self->threaded)
+            {
+                pthread_mutex_lock(&self->mutex);
+                __atomic_store_n(&lv->posted, lv->posted + 1, __ATOMIC_RELEASE);
+                pthread_cond_signal(&self->cond);
+                pthread_mutex_unlock(&self->mutex);
+            }
+            else
+            {
+                Convolver_runLevel(lv, lv->input, lv->result);
+            }
+        }
+
+        play = lv->playing + lv->playpos;
+
+        for (i = 0; i < size; i++)
+            out[i] += play[i];
+
+        lv->playpos += size;
+    }
+}
+
+/** FIR filter. **/
+/****************/
+
+PyoFirFilter *
+FirFilter_new(int length, int dynamic)
+{
+    PyoFirFilter *self = (PyoFirFilter *)PyMem_RawMalloc(sizeof(PyoFirFilter));
+
+    memset(self, 0, sizeof(PyoFirFilter));
+    self->length = length;
+    self->dynamic = dynamic;
+    self->head = length > PYO_FIR_DIRECT_MAX ? PYO_FIR_HEAD_SIZE : length;
+    self->impulse = (MYFLT *)PyMem_RawCalloc(length, sizeof(MYFLT));
+    self->history = (MYFLT *)PyMem_RawCalloc(self->head * 2 + 1, sizeof(MYFLT));
+
+    if (self->head < length)
+    {
+        self->inblock = (MYFLT *)PyMem_RawCalloc(self->head, sizeof(MYFLT));
+        self->outblock = (MYFLT *)PyMem_RawCalloc(self->head, sizeof(MYFLT));
+        if (dynamic)
+            self->tail = Convolver_new(self->impulse + self->head, length - self->head, self->head, self->head, 1.0, 0);
+        else
+            self->tail = Convolver_new(self->impulse + self->head, length - self->head, self->head, PYO_CONV_MAX_BLOCK, 1.0, 1);
+    }
+
+    return self;
+}
+
+void
+FirFilter_free(PyoFirFilter *self)
+{
+    if (self->tail != NULL)
+        Convolver_free(self->tail);
+
+    PyMem_RawFree(self->impulse);
+    PyMem_RawFree(self->history);
+    PyMem_RawFree(self->inblock);
+    PyMem_RawFree(self->outblock);
+    PyMem_RawFree(self);
+}
+
+void
+FirFilter_setImpulse(PyoFirFilter *self, const MYFLT *impulse, int num)
+{
+    int i;
+
+    if (num > self->length)
+        num = self->length;
+
+    for (i = 0; i < num; i++)
+        self->impulse[i] = impulse[i];
+
+    for (i = num; i < self->length; i++)
+        self->impulse[i] = 0.0;
+
+    if (self->tail != NULL)
+    {
+        Convolver_setImpulse(self->tail, self->impulse + self->head, self->length - self->head);
+
+        /* The new impulse also applies to the rest of the current block. */
+        if (self->dynamic)
+            Convolver_refresh(self->tail, self->outblock);
+    }
+}
+
+void
+FirFilter_process(PyoFirFilter *self, const MYFLT *in, MYFLT *out, int num)
+{
+    int i, j, head = self->head;
+    MYFLT val, *hist;
+    MYFLT *impulse = self->impulse;
+
+    for (i = 0; i < num; i++)
+    {
+        if (head > 0)
+        {
+            self->hpos--;
+
+            if (self->hpos < 0)
+                self->hpos += head;
+
+            self->history[self->hpos] = self->history[self->hpos + head] = self->last;
+        }
+
+        hist = self->history + self->hpos;
+        val = 0.0;
+
+        for (j = 0; j < head; j++)
+            val += hist[j] * impulse[j];
+
+        if (self->tail != NULL)
+        {
+            self->inblock[self->blockpos] = self->last;
+            val += self->outblock[self->blockpos];
+            self->blockpos++;
+
+            if (self->blockpos == head)
+            {
+                Convolver_process(self->tail, self->inblock, self->outblock);
+                self->blockpos = 0;
+            }
+        }
+
+        out[i] = val;
+        self->last = in[i];
+    }
+}
@@ -0,0 +1,429 @@
+/**************************************************************************
+ * Copyright 2009-2015 Olivier Belanger                                   *
+ *                                                                        *
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *
+ *                                                                        *
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with pyo.  If not, see <http://www.gnu.org/licenses/>.   *
+ *************************************************************************/
+
+/* Read-ahead sound file streaming.
+ *
+ * Each sound file player owns a small cache of blocks of frames. The audio
+ * thread copies the frames it needs from the blocks already loaded and asks
+ * for the blocks it will need next (the following block in the reading
+ * direction and the loop points). A pool of I/O threads, shared by all the
+ * players, loads the requested blocks. A slot belongs to the audio thread
+ * when it is empty or ready and to the I/O threads when it is requested or
+ * loading, so no lock is needed between them. The I/O threads sleep on a
+ * condition variable, signaled by the audio thread when it asks for a block.
+ * When a block is not ready in
+ * time, the missing frames are replaced by zeros and an underrun is counted,
+ * except for blocking readers (offline rendering), which read them directly. */
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "diskreader.h"
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <windows.h>
+#define PYO_DISK_SLEEP() Sleep(1)
+#else
+#define PYO_DISK_SLEEP() { struct timespec ts = {0, 1000000}; nanosleep(&ts, NULL); }
+#endif
+
+/* Longest sleep of an idle I/O thread, in nanoseconds. The audio thread
+   signals the threads without taking diskreader_lock, so a signal sent
+   just before a thread starts waiting is missed: the thread then finds
+   the request when this delay expires, well before the block is needed. */
+#define PYO_DISK_IDLE_WAIT 50000000
+
+static pthread_mutex_t diskreader_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t diskreader_cond = PTHREAD_COND_INITIALIZER;
+static PyoDiskReader *diskreader_files = NULL;
+static int diskreader_threads = 0;
+static unsigned int diskreader_requests = 0; /* incremented by each request. */
+
+/* Reads `frames` frames at `pos`. Must be called with the reader's lock held. */
+static sf_count_t
+DiskReader_readFile(PyoDiskReader *self, sf_count_t pos, MYFLT *buffer, sf_count_t frames)
+{
+    if (sf_seek(self->sf, pos, SEEK_SET) < 0)
+        return 0;
+
+    return SF_READ(self->sf, buffer, frames * self->info.channels) / self->info.channels;
+}
+
+static void
+DiskReader_loadSlot(PyoDiskReader *self, PyoDiskSlot *slot)
+{
+    sf_count_t frames;
+
+    pthread_mutex_lock(&self->lock);
+    frames = DiskReader_readFile(self, slot->block * PYO_DISK_BLOCK_FRAMES, slot->data, PYO_DISK_BLOCK_FRAMES);
+    pthread_mutex_unlock(&self->lock);
+
+    slot->frames = frames < 0 ? 0 : frames;
+    __atomic_store_n(&slot->state, PyoDiskSlotReady, __ATOMIC_RELEASE);
+}
+
+/* Sleeps until a block is requested after `requests`, the count of
+   requests seen before the last search. Called with diskreader_lock held. */
+static void
+DiskReader_idle(unsigned int requests)
+{
+    struct timespec ts;
+
+    if (__atomic_load_n(&diskreader_requests, __ATOMIC_ACQUIRE) != requests)
+        return;
+
+    clock_gettime(CLOCK_REALTIME, &ts);
+    ts.tv_nsec += PYO_DISK_IDLE_WAIT;
+
+    if (ts.tv_nsec >= 1000000000)
+    {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1000000000;
+    }
+
+    pthread_cond_timedwait(&diskreader_cond, &diskreader_lock, &ts);
+}
+
+static void *
+DiskReader_thread(void *arg)
+{
+    int i, expected;
+    unsigned int requests;
+    PyoDiskReader *file, *owner;
+    PyoDiskSlot *slot;
+
+    for (;;)
+    {
+        slot = NULL;
+        owner = NULL;
+        pthread_mutex_lock(&diskreader_lock);
+        requests = __atomic_load_n(&diskreader_requests, __ATOMIC_ACQUIRE);
+
+        if (diskreader_files == NULL)
+        {
+            diskreader_threads--;
+            pthread_mutex_unlock(&diskreader_lock);
+            break;
+        }
+
+        /* Claims the first requested block. */
+        for (file = diskreader_files; file != NULL && slot == NULL; file = file->next)
+        {
+            for (i = 0; i < PYO_DISK_SLOTS; i++)
+            {
+                expected = PyoDiskSlotRequested;
+
+                if (__atomic_compare_exchange_n(&file->slots[i].state, &expected, PyoDiskSlotLoading,
+                                                0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+                {
+                    slot = &file->slots[i];
+                    owner = file;
+                    owner->busy++;
+                    break;
+                }
+            }
+        }
+
+        if (slot == NULL)
+        {
+            DiskReader_idle(requests);
+            pthread_mutex_unlock(&diskreader_lock);
+            continue;
+        }
+
+        pthread_mutex_unlock(&diskreader_lock);
+
+        DiskReader_loadSlot(owner, slot);
+
+        pthread_mutex_lock(&diskreader_lock);
+        owner->busy--;
+        pthread_mutex_unlock(&diskreader_lock);
+    }
+
+    return NULL;
+}
+
+/* Opens a sound file and registers it to the I/O threads. Returns NULL if
+   the file can not be opened. `info` receives the file properties. */
+PyoDiskReader *
+DiskReader_new(const char *path, SF_INFO *info, int blocking)
+{
+    int i;
+    pthread_t thread;
+    PyoDiskReader *self;
+
+    self = (PyoDiskReader *)PyMem_RawCalloc(1, sizeof(PyoDiskReader));
+
+    if (self == NULL)
+        return NULL;
+
+    self->info.format = 0;
+    self->sf = sf_open(path, SFM_READ, &self->info);
+
+    if (self->sf == NULL)
+    {
+        PyMem_RawFree(self);
+        return NULL;
+    }
+
+    for (i = 0; i < PYO_DISK_SLOTS; i++)
+    {
+        self->slots[i].data = (MYFLT *)PyMem_RawMalloc(PYO_DISK_BLOCK_FRAMES * self->info.channels * sizeof(MYFLT));
+        self->slots[i].block = -1;
+    }
+
+    self->blocking = blocking;
+    pthread_mutex_init(&self->lock, NULL);
+    *info = self->info;
+
+    pthread_mutex_lock(&diskreader_lock);
+
+    self->next = diskreader_files;
+    diskreader_files = self;
+
+    while (diskreader_threads < PYO_DISK_READ_THREADS)
+    {
+        if (pthread_create(&thread, NULL, DiskReader_thread, NULL) != 0)
+            break;
+
+        pthread_detach(thread);
+        diskreader_threads++;
+    }
+
+    pthread_mutex_unlock(&diskreader_lock);
+
+    /* Without I/O threads, every miss is read by the audio thread. */
+    if (diskreader_threads == 0)
+        self->blocking = 1;
+
+    return self;
+}
+
+/* Unregisters the reader, waits for the I/O threads to be done with it
+   and closes the file. Must not be called while the audio thread uses it. */
+void
+DiskReader_free(PyoDiskReader *self)
+{
+    int i, busy;
+    PyoDiskReader **prev;
+
+    if (self == NULL)
+        return;
+
+    pthread_mutex_lock(&diskreader_lock);
+
+    for (prev = &diskreader_files; *prev != NULL; prev = &(*prev)->next)
+    {
+        if (*prev == self)
+        {
+            *prev = self->next;
+            break;
+        }
+    }
+
+    /* Without files, the I/O threads exit. */
+    if (diskreader_files == NULL)
+        pthread_cond_broadcast(&diskreader_cond);
+
+    pthread_mutex_unlock(&diskreader_lock);
+
+    do
+    {
+        pthread_mutex_lock(&diskreader_lock);
+        busy = self->busy;
+        pthread_mutex_unlock(&diskreader_lock);
+
+        if (busy)
+            PYO_DISK_SLEEP();
+    }
+    while (busy);
+
+    sf_close(self->sf);
+    pthread_mutex_destroy(&self->lock);
+
+    for (i = 0; i < PYO_DISK_SLOTS; i++)
+        PyMem_RawFree(self->slots[i].data);
+
+    PyMem_RawFree(self);
+}
+
+/* Returns the slot holding (or loading) a block, NULL if it is not cached. */
+static PyoDiskSlot *
+DiskReader_findSlot(PyoDiskReader *self, sf_count_t block)
+{
+    int i;
+
+    for (i = 0; i < PYO_DISK_SLOTS; i++)
+    {
+        if (self->slots[i].block == block && __atomic_load_n(&self->slots[i].state, __ATOMIC_ACQUIRE) != PyoDiskSlotEmpty)
+            return &self->slots[i];
+    }
+
+    return NULL;
+}
+
+/* Asks the I/O threads to load a block in the least recently used slot. */
+static void
+DiskReader_request(PyoDiskReader *self, sf_count_t block)
+{
+    int i, state;
+    PyoDiskSlot *slot, *victim = NULL;
+
+    if ((slot = DiskReader_findSlot(self, block)) != NULL)
+    {
+        slot->stamp = ++self->stamp;
+        return;
+    }
+
+    for (i = 0; i < PYO_DISK_SLOTS; i++)
+    {
+        slot = &self->slots[i];
+        state = __atomic_load_n(&slot->state, __ATOMIC_ACQUIRE);
+
+        if (state == PyoDiskSlotEmpty)
+        {
+            victim = slot;
+            break;
+        }
+        else if (state == PyoDiskSlotReady && (victim == NULL || slot->stamp < victim->stamp))
+            victim = slot;
+    }
+
+    /* All the slots are waiting for the disk. */
+    if (victim == NULL)
+        return;
+
+    victim->block = block;
+    victim->stamp = ++self->stamp;
+    __atomic_store_n(&victim->state, PyoDiskSlotRequested, __ATOMIC_RELEASE);
+
+    /* Wakes an I/O thread, without waiting for diskreader_lock. */
+    __atomic_add_fetch(&diskreader_requests, 1, __ATOMIC_RELEASE);
+    pthread_cond_signal(&diskreader_cond);
+}
+
+/* Prepares the block containing `pos` for a later read. */
+void
+DiskReader_prefetch(PyoDiskReader *self, sf_count_t pos)
+{
+    if (self == NULL || pos < 0 || pos >= self->info.frames)
+        return;
+
+    DiskReader_request(self, pos / PYO_DISK_BLOCK_FRAMES);
+}
+
+/* Waits (one second at most) for the block containing `pos` to be loaded.
+   Must not be called by the audio thread. */
+void
+DiskReader_wait(PyoDiskReader *self, sf_count_t pos)
+{
+    int i;
+    PyoDiskSlot *slot;
+
+    if (self == NULL || pos < 0 || pos >= self->info.frames)
+        return;
+
+    for (i = 0; i < 1000; i++)
+    {
+        slot = DiskReader_findSlot(self, pos / PYO_DISK_BLOCK_FRAMES);
+
+        if (slot == NULL || __atomic_load_n(&slot->state, __ATOMIC_ACQUIRE) == PyoDiskSlotReady)
+            break;
+
+        PYO_DISK_SLEEP();
+    }
+}
+
+/* Copies `frames` frames at `pos` in `buffer`, as sf_seek followed by
+   sf_read would do: the read stops at the end of the file, leaving the
+   rest of the buffer untouched. Returns the number of frames copied. */
+sf_count_t
+DiskReader_read(PyoDiskReader *self, sf_count_t pos, MYFLT *buffer, sf_count_t frames)
+{
+    int chnls, missed = 0;
+    sf_count_t block, offset, count, done = 0;
+    PyoDiskSlot *slot;
+
+    if (self == NULL || pos < 0 || pos >= self->info.frames || frames <= 0)
+        return 0;
+
+    if ((pos + frames) > self->info.frames)
+        frames = self->info.frames - pos;
+
+    chnls = self->info.channels;
+
+    while (done < frames)
+    {
+        block = (pos + done) / PYO_DISK_BLOCK_FRAMES;
+        offset = (pos + done) - block * PYO_DISK_BLOCK_FRAMES;
+        count = PYO_DISK_BLOCK_FRAMES - offset;
+
+        if (count > (frames - done))
+            count = frames - done;
+
+        slot = DiskReader_findSlot(self, block);
+
+        if (slot != NULL && __atomic_load_n(&slot->state, __ATOMIC_ACQUIRE) == PyoDiskSlotReady)
+        {
+            if (offset + count > slot->frames)
+                count = slot->frames > offset ? slot->frames - offset : 0;
+
+            memcpy(buffer + done * chnls, slot->data + offset * chnls, count * chnls * sizeof(MYFLT));
+            slot->stamp = ++self->stamp;
+
+            /* Short block, the file was truncated. */
+            if (count == 0)
+                break;
+        }
+        else
+        {
+            if (slot == NULL)
+                DiskReader_request(self, block);
+
+            if (self->blocking)
+            {
+                pthread_mutex_lock(&self->lock);
+                count = DiskReader_readFile(self, pos + done, buffer + done * chnls, count);
+                pthread_mutex_unlock(&self->lock);
+
+                if (count <= 0)
+                    break;
+            }
+            else
+            {
+                memset(buffer + done * chnls, 0, count * chnls * sizeof(MYFLT));
+                missed = 1;
+            }
+        }
+
+        done += count;
+    }
+
+    if (missed)
+        __atomic_add_fetch(&self->underruns, 1, __ATOMIC_RELAXED);
+
+    return done;
+}
+
+unsigned long
+DiskReader_getUnderruns(PyoDiskReader *self)
+{
+    return self == NULL ? 0 : __atomic_load_n(&self->underruns, __ATOMIC_RELAXED);
+}
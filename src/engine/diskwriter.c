@@ -0,0 +1,268 @@
+/**************************************************************************
+ * Copyright 2009-2015 Olivier Belanger                                   *
+ *                                                                        *
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *
+ *                                                                        *
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with pyo.  If not, see <http://www.gnu.org/licenses/>.   *
+ *************************************************************************/
+
+/* Asynchronous sound file writer.
+ *
+ * Every recording (Server.recstart and Record objects) owns a ring buffer
+ * filled by the audio thread and emptied by a single disk writer thread
+ * shared by all recordings. The thread is started with the first recording
+ * and exits when there is nothing left to write. When a ring buffer is full,
+ * the block is dropped and counted as an overrun, except for blocking streams
+ * (offline rendering) where the audio thread waits for the disk. */
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "diskwriter.h"
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <windows.h>
+#define PYO_DISK_SLEEP() Sleep(1)
+#else
+#define PYO_DISK_SLEEP() { struct timespec ts = {0, 1000000}; nanosleep(&ts, NULL); }
+#endif
+
+static pthread_mutex_t diskwriter_lock = PTHREAD_MUTEX_INITIALIZER;
+static PyoDiskStream *diskwriter_streams = NULL;
+static int diskwriter_running = 0;
+
+/* Writes the samples available in the ring buffer. Returns the number of samples written. */
+static unsigned long
+DiskStream_drain(PyoDiskStream *self)
+{
+    unsigned long head, tail, start, count, total = 0;
+    char *data;
+
+    head = __atomic_load_n(&self->head, __ATOMIC_ACQUIRE);
+    tail = self->tail;
+
+    while (tail != head)
+    {
+        start = tail % self->size;
+        count = head - tail;
+
+        /* Contiguous part of the ring. */
+        if (count > self->size - start)
+            count = self->size - start;
+
+        data = self->ring + start * self->samplesize;
+
+        if (self->samplesize == sizeof(float))
+            sf_write_float(self->file, (float *)data, count);
+        else
+            sf_write_double(self->file, (double *)data, count);
+
+        tail += count;
+        total += count;
+        __atomic_store_n(&self->tail, tail, __ATOMIC_RELEASE);
+    }
+
+    return total;
+}
+
+static void *
+DiskWriter_thread(void *arg)
+{
+    unsigned long written;
+    PyoDiskStream *stream, **prev;
+
+    for (;;)
+    {
+        written = 0;
+        pthread_mutex_lock(&diskwriter_lock);
+
+        if (diskwriter_streams == NULL)
+        {
+            diskwriter_running = 0;
+            pthread_mutex_unlock(&diskwriter_lock);
+            break;
+        }
+
+        prev = &diskwriter_streams;
+
+        while ((stream = *prev) != NULL)
+        {
+            /* Reads the closing flag before the last samples. */
+            if (__atomic_load_n(&stream->closing, __ATOMIC_ACQUIRE))
+            {
+                DiskStream_drain(stream);
+                sf_close(stream->file);
+                *prev = stream->next;
+
+                /* Nobody waits for a released stream. */
+                if (stream->released)
+                {
+                    PyMem_RawFree(stream->ring);
+                    PyMem_RawFree(stream);
+                }
+                else
+                    __atomic_store_n(&stream->closed, 1, __ATOMIC_RELEASE);
+
+                continue;
+            }
+
+            written += DiskStream_drain(stream);
+            prev = &stream->next;
+        }
+
+        pthread_mutex_unlock(&diskwriter_lock);
+
+        if (written == 0)
+            PYO_DISK_SLEEP();
+    }
+
+    return NULL;
+}
+
+/* Creates the ring buffer of an opened sound file and registers it to the
+   disk writer thread. `samplesize` is the size of the samples that will be
+   pushed (sizeof(float) or sizeof(double)). */
+PyoDiskStream *
+DiskStream_new(SNDFILE *file, int chnls, int samplesize, long frames, int blocking)
+{
+    pthread_t thread;
+    PyoDiskStream *self;
+
+    if (frames < 1)
+        frames = PYO_DISK_RING_FRAMES;
+
+    self = (PyoDiskStream *)PyMem_RawCalloc(1, sizeof(PyoDiskStream));
+
+    if (self == NULL)
+        return NULL;
+
+    self->file = file;
+    self->samplesize = samplesize;
+    self->size = (unsigned long)frames * chnls;
+    self->blocking = blocking;
+    self->ring = (char *)PyMem_RawMalloc(self->size * samplesize);
+
+    if (self->ring == NULL)
+    {
+        PyMem_RawFree(self);
+        return NULL;
+    }
+
+    pthread_mutex_lock(&diskwriter_lock);
+
+    self->next = diskwriter_streams;
+    diskwriter_streams = self;
+
+    if (! diskwriter_running)
+    {
+        if (pthread_create(&thread, NULL, DiskWriter_thread, NULL) == 0)
+        {
+            pthread_detach(thread);
+            diskwriter_running = 1;
+        }
+        else
+        {
+            diskwriter_streams = self->next;
+            pthread_mutex_unlock(&diskwriter_lock);
+            PyMem_RawFree(self->ring);
+            PyMem_RawFree(self);
+            return NULL;
+        }
+    }
+
+    pthread_mutex_unlock(&diskwriter_lock);
+
+    return self;
+}
+
+/* Pushes `count` samples (whole frames) into the ring buffer. Called by the
+   audio thread. Returns -1 if the block was dropped because the ring is full. */
+int
+DiskStream_write(PyoDiskStream *self, const void *samples, long count)
+{
+    unsigned long head, start, first;
+
+    if (count <= 0)
+        return 0;
+
+    head = self->head;
+
+    while (self->size - (head - __atomic_load_n(&self->tail, __ATOMIC_ACQUIRE)) < (unsigned long)count)
+    {
+        if (! self->blocking || (unsigned long)count > self->size)
+        {
+            __atomic_add_fetch(&self->overruns, 1, __ATOMIC_RELAXED);
+            return -1;
+        }
+
+        PYO_DISK_SLEEP();
+    }
+
+    start = head % self->size;
+    first = self->size - start;
+
+    if (first > (unsigned long)count)
+        first = count;
+
+    memcpy(self->ring + start * self->samplesize, samples, first * self->samplesize);
+
+    if (first < (unsigned long)count)
+        memcpy(self->ring, (const char *)samples + first * self->samplesize, (count - first) * self->samplesize);
+
+    __atomic_store_n(&self->head, head + count, __ATOMIC_RELEASE);
+
+    return 0;
+}
+
+/* Asks the disk writer thread to write the remaining samples and close the
+   file, then waits for it. Must not be called while the audio thread may
+   still write to the stream. The stream is freed. Returns the number of overruns. */
+unsigned long
+DiskStream_close(PyoDiskStream *self)
+{
+    unsigned long overruns;
+
+    if (self == NULL)
+        return 0;
+
+    __atomic_store_n(&self->closing, 1, __ATOMIC_RELEASE);
+
+    while (! __atomic_load_n(&self->closed, __ATOMIC_ACQUIRE))
+        PYO_DISK_SLEEP();
+
+    overruns = self->overruns;
+    PyMem_RawFree(self->ring);
+    PyMem_RawFree(self);
+
+    return overruns;
+}
+
+/* Same as DiskStream_close, but returns immediately, the disk writer thread
+   closes the file and frees the stream later. Used from the audio thread. */
+void
+DiskStream_release(PyoDiskStream *self)
+{
+    if (self == NULL)
+        return;
+
+    self->released = 1;
+    __atomic_store_n(&self->closing, 1, __ATOMIC_RELEASE);
+}
+
+unsigned long
+DiskStream_getOverruns(PyoDiskStream *self)
+{
+    return self == NULL ? 0 : __atomic_load_n(&self->overruns, __ATOMIC_RELAXED);
+}
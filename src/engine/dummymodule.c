@@ -26,87 +26,124 @@
 #include "servermodule.h"
 #include "dummymodule.h"
 
-static void Dummy_postprocessing_ii(Dummy *self) { POST_PROCESSING_II };
-static void Dummy_postprocessing_ai(Dummy *self) { POST_PROCESSING_AI };
-static void Dummy_postprocessing_ia(Dummy *self) { POST_PROCESSING_IA };
-static void Dummy_postprocessing_aa(Dummy *self) { POST_PROCESSING_AA };
-static void Dummy_postprocessing_ireva(Dummy *self) { POST_PROCESSING_IREVA };
-static void Dummy_postprocessing_areva(Dummy *self) { POST_PROCESSING_AREVA };
-static void Dummy_postprocessing_revai(Dummy *self) { POST_PROCESSING_REVAI };
-static void Dummy_postprocessing_revaa(Dummy *self) { POST_PROCESSING_REVAA };
-static void Dummy_postprocessing_revareva(Dummy *self) { POST_PROCESSING_REVAREVA };
-
-static void
-Dummy_setProcMode(Dummy *self)
+/* Evaluates `size` samples of the expression, starting at `offset` in the
+   block, into `out` and returns the state of the result. The input of a
+   Dummy being copied, its state is always varying, and mul and add come
+   either from the streams read or from the inlined Dummy objects. */
+static int
+Dummy_evaluate(Dummy *self, MYFLT *out, int offset, int size)
 {
-    int muladdmode;
-    muladdmode = self->modebuffer[0] + self->modebuffer[1] * 10;
+    int i, mstate, astate, flags = 0;
+    MYFLT mul = 0, add = 0, *m = NULL, *a = NULL;
 
-    switch (muladdmode)
+    if (Stream_getStreamActive(self->stream) == 0)
     {
-        case 0:
-            self->muladd_func_ptr = Dummy_postprocessing_ii;
-            break;
-
-        case 1:
-            self->muladd_func_ptr = Dummy_postprocessing_ai;
-            break;
-
-        case 2:
-            self->muladd_func_ptr = Dummy_postprocessing_revai;
-            break;
+        memset(out, 0, size * sizeof(MYFLT));
+        return PYO_STREAM_SILENT;
+    }
 
-        case 10:
-            self->muladd_func_ptr = Dummy_postprocessing_ia;
-            break;
+    if (self->modebuffer[2] == 0)
+    {
+        MYFLT inval = PyFloat_AS_DOUBLE(self->input);
 
-        case 11:
-            self->muladd_func_ptr = Dummy_postprocessing_aa;
-            break;
+        for (i = 0; i < size; i++)
+        {
+            out[i] = inval;
+        }
+    }
+    else if (self->inlined[2])
+        Dummy_evaluate((Dummy *)self->input, out, offset, size);
+    else
+        memcpy(out, Stream_getData(self->input_stream) + offset, size * sizeof(MYFLT));
 
-        case 12:
-            self->muladd_func_ptr = Dummy_postprocessing_revaa;
-            break;
+    if (self->modebuffer[0] == 0)
+    {
+        mul = PyFloat_AS_DOUBLE(self->mul);
+        mstate = mul == 0 ? PYO_STREAM_SILENT : PYO_STREAM_CONSTANT;
+    }
+    else
+    {
+        if (self->inlined[0])
+        {
+            m = self->scratch;
+            mstate = Dummy_evaluate((Dummy *)self->mul, m, offset, size);
+        }
+        else
+        {
+            mstate = Stream_getState(self->mul_stream);
+            m = Stream_getData(self->mul_stream) + offset;
+        }
 
-        case 20:
-            self->muladd_func_ptr = Dummy_postprocessing_ireva;
-            break;
+        if (self->modebuffer[0] == 2)
+            flags |= PYO_MULADD_REVMUL;
+    }
 
-        case 21:
-            self->muladd_func_ptr = Dummy_postprocessing_areva;
-            break;
+    if (self->modebuffer[1] == 0)
+    {
+        add = PyFloat_AS_DOUBLE(self->add);
+        astate = add == 0 ? PYO_STREAM_SILENT : PYO_STREAM_CONSTANT;
+    }
+    else
+    {
+        if (self->inlined[1])
+        {
+            a = self->scratch + PYO_DUMMY_CHUNK;
+            astate = Dummy_evaluate((Dummy *)self->add, a, offset, size);
+        }
+        else
+        {
+            astate = Stream_getState(self->add_stream);
+            a = Stream_getData(self->add_stream) + offset;
+        }
 
-        case 22:
-            self->muladd_func_ptr = Dummy_postprocessing_revareva;
-            break;
+        if (self->modebuffer[1] == 2)
+            flags |= PYO_MULADD_REVADD;
     }
+
+    return Stream_mulAddBuffer(out, size, PYO_STREAM_VARYING, m, mul, mstate, a, add, astate, flags);
 }
 
 static void
 Dummy_compute_next_data_frame(Dummy *self)
 {
-    int i;
+    int i, chunk, size, state = PYO_STREAM_VARYING;
 
-    if (self->modebuffer[2] == 0)
-    {
-        MYFLT inval = PyFloat_AS_DOUBLE(self->input);
+    /* Inlined in the Dummy reading it. */
+    if (self->fused && ! self->requested)
+        return;
 
-        for (i = 0; i < self->bufsize; i++)
-        {
-            self->data[i] = inval;
-        }
-    }
-    else
-    {
-        MYFLT *in = Stream_getData((Stream *)self->input_stream);
+    chunk = self->nodes > 1 ? PYO_DUMMY_CHUNK : self->bufsize;
 
-        for (i = 0; i < self->bufsize; i++)
-        {
-            self->data[i] = in[i];
-        }
+    for (i = 0; i < self->bufsize; i += chunk)
+    {
+        size = self->bufsize - i < chunk ? self->bufsize - i : chunk;
+        state = Dummy_evaluate(self, self->data + i, i, size);
     }
 
-    (*self->muladd_func_ptr)(self);
+    Stream_setState(self->stream, state);
+}
+
+/* Computes the Dummy between two blocks, when its input changes or when
+   its stream is asked for, so that its value can be read right away. */
+static void
+Dummy_computeNow(Dummy *self)
+{
+    Server_lockProcessing(self->server);
+    Dummy_compute_next_data_frame(self);
+    Server_unlockProcessing(self->server);
+}
+
+/* The stream is read by another object, played or read with get(): an
+   inlined Dummy is computed on its own from now on. */
+static void
+Dummy_request(Dummy *self)
+{
+    int fused = self->fused && ! self->requested;
+
+    self->requested = 1;
+
+    if (fused)
+        Dummy_computeNow(self);
 }
 
 static int
@@ -117,6 +154,25 @@ Dummy_traverse(Dummy *self, visitproc visit, void *arg)
     return 0;
 }
 
+/* Visits the objects read by the Dummy objects inlined in `obj`, which
+   are read, in fact, when `obj` is computed. */
+void
+Dummy_visitInlined(PyObject *obj, visitproc visit, void *arg)
+{
+    int i;
+    Dummy *self = (Dummy *)obj;
+    PyObject *operands[3] = {self->mul, self->add, self->input};
+
+    for (i = 0; i < 3; i++)
+    {
+        if (self->inlined[i])
+        {
+            Dummy_traverse((Dummy *)operands[i], visit, arg);
+            Dummy_visitInlined(operands[i], visit, arg);
+        }
+    }
+}
+
 static int
 Dummy_clear(Dummy *self)
 {
@@ -129,6 +185,7 @@ static void
 Dummy_dealloc(Dummy* self)
 {
     pyo_DEALLOC
+    PyMem_RawFree(self->scratch);
     Dummy_clear(self);
     Py_TYPE(self->stream)->tp_free((PyObject*)self->stream);
     Py_TYPE(self)->tp_free((PyObject*)self);
@@ -149,10 +206,14 @@ Dummy_initialize(Dummy *self)
     self->modebuffer[0] = 0;
     self->modebuffer[1] = 0;
     self->modebuffer[2] = 0;
+    self->inlined[0] = self->inlined[1] = self->inlined[2] = 0;
+    self->requested = self->fused = 0;
+    self->nodes = 1;
+    self->scratch = NULL;
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, Dummy_compute_next_data_frame);
-    self->mode_func_ptr = Dummy_setProcMode;
+    Stream_setShareable(self->stream, 1);
 
     PyObject_CallMethod(self->server, "addStream", "O", self->stream);
 
@@ -161,44 +222,184 @@ Dummy_initialize(Dummy *self)
     Py_RETURN_NONE;
 }
 
-static PyObject *
-Dummy_setInput(Dummy *self, PyObject *arg)
+/* Sets the mul (0), the add (1) or the input (2) to `arg`, a number or an
+   audio object. With `reverse`, the add is subtracted and the result is
+   divided by the mul, as with setSub and setDiv. With `fuse`, a Dummy not
+   read by any other object is inlined instead of being computed apart. */
+static void
+Dummy_setOperand(Dummy *self, int which, PyObject *arg, int reverse, int fuse)
 {
-    ASSERT_ARG_NOT_NULL
-
-    Py_DECREF(self->input);
+    int i, mode = 0, inlined = 0;
+    double value;
+    Dummy *dummy;
+    PyObject *old, *operand, **operands[3] = {&self->mul, &self->add, &self->input};
+    Stream *stream = NULL, **streams[3] = {&self->mul_stream, &self->add_stream, &self->input_stream};
 
     if (PyNumber_Check(arg))
     {
-        self->input = PyNumber_Float(arg);
-        self->modebuffer[2] = 0;
+        value = PyFloat_AsDouble(arg);
+
+        if (reverse && which == 0)
+        {
+            if (value == 0.)
+                return;
+
+            value = 1.0 / value;
+        }
+        else if (reverse)
+            value = -value;
+
+        operand = PyFloat_FromDouble(value);
     }
     else
     {
-        self->input = arg;
-        Py_INCREF(self->input);
-        PyObject *streamtmp = PyObject_CallMethod((PyObject *)self->input, "_getStream", NULL);
-        self->input_stream = (Stream *)streamtmp;
-        Py_INCREF(self->input_stream);
-        self->modebuffer[2] = 1;
+        if (! PyObject_HasAttrString(arg, "_getStream"))
+        {
+            PyErr_SetString(PyExc_ArithmeticError, "Only number or audio internal object can be used in arithmetic with audio internal objects.\n");
+            PyErr_Print();
+            return;
+        }
+
+        dummy = (Dummy *)arg;
+        mode = reverse ? 2 : 1;
+
+        if (fuse && Py_TYPE(arg) == &DummyType && ! dummy->requested &&
+            (self->nodes + dummy->nodes) <= PYO_DUMMY_MAX_NODES)
+        {
+            stream = dummy->stream;
+            inlined = 1;
+        }
+        else if ((stream = (Stream *)PyObject_CallMethod(arg, "_getStream", NULL)) == NULL)
+            return;
+
+        Py_INCREF(arg);
+        operand = arg;
     }
 
-    (*self->mode_func_ptr)(self);
+    /* Chunks of an inlined mul and add, evaluated before their use. */
+    if (inlined && which < 2 && self->scratch == NULL)
+        self->scratch = (MYFLT *)PyMem_RawMalloc(2 * PYO_DUMMY_CHUNK * sizeof(MYFLT));
 
-    Dummy_compute_next_data_frame(self);
+    Server_lockProcessing(self->server);
+
+    old = *operands[which];
+    *operands[which] = operand;
+
+    if (stream != NULL)
+        *streams[which] = stream;
+
+    self->modebuffer[which] = mode;
+    self->inlined[which] = inlined;
+
+    if (inlined)
+        dummy->fused = 1;
+
+    self->nodes = 1;
+
+    for (i = 0; i < 3; i++)
+    {
+        if (self->inlined[i])
+            self->nodes += ((Dummy *)*operands[i])->nodes;
+    }
+
+    if (stream != NULL && ! inlined)
+        Stream_invalidateGraph();
+
+    Server_unlockProcessing(self->server);
+
+    Py_DECREF(old);
+}
+
+/* Returns a new Dummy computing `input` (an audio object or, for reflected
+   operations, a number) multiplied by, added to, minus or divided by `arg`.
+   Used by the arithmetic operators of all audio objects. */
+PyObject *
+Dummy_fromOperation(PyObject *input, PyObject *arg, int op)
+{
+    Dummy *dummy;
+    PyObject *tmp;
+    MAKE_NEW_DUMMY(dummy, &DummyType, NULL);
+    tmp = Dummy_initialize(dummy);
+    Py_XDECREF(tmp);
+
+    switch (op)
+    {
+        case PYO_DUMMY_MUL:
+            Dummy_setOperand(dummy, 0, arg, 0, 1);
+            break;
+
+        case PYO_DUMMY_ADD:
+            Dummy_setOperand(dummy, 1, arg, 0, 1);
+            break;
+
+        case PYO_DUMMY_SUB:
+            Dummy_setOperand(dummy, 1, arg, 1, 1);
+            break;
+
+        case PYO_DUMMY_DIV:
+            Dummy_setOperand(dummy, 0, arg, 1, 1);
+            break;
+    }
+
+    Dummy_setOperand(dummy, 2, input, 0, 1);
+    Dummy_computeNow(dummy);
+
+    Py_INCREF(dummy);
+    return (PyObject *)dummy;
+}
+
+static PyObject *
+Dummy_setInput(Dummy *self, PyObject *arg)
+{
+    ASSERT_ARG_NOT_NULL
+
+    Dummy_setOperand(self, 2, arg, 0, 0);
+    Dummy_computeNow(self);
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+Dummy_setMul(Dummy *self, PyObject *arg)
+{
+    if (arg != NULL)
+        Dummy_setOperand(self, 0, arg, 0, 0);
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+Dummy_setAdd(Dummy *self, PyObject *arg)
+{
+    if (arg != NULL)
+        Dummy_setOperand(self, 1, arg, 0, 0);
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+Dummy_setSub(Dummy *self, PyObject *arg)
+{
+    if (arg != NULL)
+        Dummy_setOperand(self, 1, arg, 1, 0);
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+Dummy_setDiv(Dummy *self, PyObject *arg)
+{
+    if (arg != NULL)
+        Dummy_setOperand(self, 0, arg, 1, 0);
 
     Py_RETURN_NONE;
 }
 
 static PyObject * Dummy_getServer(Dummy* self) { GET_SERVER };
-static PyObject * Dummy_getStream(Dummy* self) { GET_STREAM };
-static PyObject * Dummy_setMul(Dummy *self, PyObject *arg) { SET_MUL };
-static PyObject * Dummy_setAdd(Dummy *self, PyObject *arg) { SET_ADD };
-static PyObject * Dummy_setSub(Dummy *self, PyObject *arg) { SET_SUB };
-static PyObject * Dummy_setDiv(Dummy *self, PyObject *arg) { SET_DIV };
-
-static PyObject * Dummy_play(Dummy *self, PyObject *args, PyObject *kwds) { PLAY };
-static PyObject * Dummy_out(Dummy *self, PyObject *args, PyObject *kwds) { OUT };
+static PyObject * Dummy_getStream(Dummy* self) { Dummy_request(self); GET_STREAM };
+
+static PyObject * Dummy_play(Dummy *self, PyObject *args, PyObject *kwds) { Dummy_request(self); PLAY };
+static PyObject * Dummy_out(Dummy *self, PyObject *args, PyObject *kwds) { Dummy_request(self); OUT };
 static PyObject * Dummy_stop(Dummy *self, PyObject *args, PyObject *kwds) { STOP };
 
 static PyObject * Dummy_multiply(Dummy *self, PyObject *arg) { MULTIPLY };
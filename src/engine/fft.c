@@ -684,3 +684,657 @@ void irealfft_packed(MYFLT *data, MYFLT *outdata, int size, MYFLT *twiddle)
     for (i = 0; i < size; i++)
         outdata[i] = data[i] * 2;
 }
+
+/******************************************************
+**                   FFT plans
+**
+**  Mixed-radix (4, 2, 3, 5) real FFT: a complex FFT of
+**  half the size, Stockham autosort stages on separate
+**  real and imaginary arrays, then the split of the
+**  even and odd samples spectra. The butterflies of a
+**  stage run along contiguous arrays and vectorize.
+****************************************************** */
+#include <pthread.h>
+
+#ifdef USE_FFTW
+#include <fftw3.h>
+#ifdef USE_DOUBLE
+#define FFTW(x) fftw_##x
+#else
+#define FFTW(x) fftwf_##x
+#endif
+#endif
+
+static PyoFFTPlan *fft_plans = NULL;
+static pthread_mutex_t fft_plans_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static int
+fft_factorize(int n, int *radix)
+{
+    int nstages = 0;
+
+    while (n > 1 && nstages < PYO_FFT_MAX_STAGES)
+    {
+        if ((n % 4) == 0)
+            radix[nstages] = 4;
+        else if ((n % 2) == 0)
+            radix[nstages] = 2;
+        else if ((n % 3) == 0)
+            radix[nstages] = 3;
+        else if ((n % 5) == 0)
+            radix[nstages] = 5;
+        else
+            return -1;
+
+        n /= radix[nstages++];
+    }
+
+    return n == 1 ? nstages : -1;
+}
+
+int
+fft_valid_size(int size, int type)
+{
+    int radix[PYO_FFT_MAX_STAGES];
+
+    if (size < 2 || (size & 1))
+        return 0;
+
+    if (type == PYO_FFT_REAL_PACKED)
+        return (size & (size - 1)) == 0;
+
+    return fft_factorize(size / 2, radix) >= 0;
+}
+
+int
+fft_next_size(int size, int type)
+{
+    if (size < 2)
+        size = 2;
+
+    while (!fft_valid_size(size, type))
+        size++;
+
+    return size;
+}
+
+/* Radix-4 stage: `m` butterflies of stride `s`. */
+static void
+fft_stage4(int s, int m, const MYFLT *xr, const MYFLT *xi, MYFLT *yr, MYFLT *yi, const MYFLT *twr, const MYFLT *twi)
+{
+    int p, q, sm = s * m;
+    const MYFLT *ar, *ai;
+    MYFLT *br, *bi;
+    MYFLT w1r, w1i, w2r, w2i, w3r, w3i;
+    MYFLT t0r, t0i, t1r, t1i, t2r, t2i, t3r, t3i, c1r, c1i, c2r, c2i, c3r, c3i;
+
+    for (p = 0; p < m; p++)
+    {
+        w1r = twr[p];
+        w1i = twi[p];
+        w2r = twr[m + p];
+        w2i = twi[m + p];
+        w3r = twr[2 * m + p];
+        w3i = twi[2 * m + p];
+        ar = xr + s * p;
+        ai = xi + s * p;
+        br = yr + 4 * s * p;
+        bi = yi + 4 * s * p;
+
+        for (q = 0; q < s; q++)
+        {
+            t0r = ar[q] + ar[q + 2 * sm];
+            t0i = ai[q] + ai[q + 2 * sm];
+            t1r = ar[q] - ar[q + 2 * sm];
+            t1i = ai[q] - ai[q + 2 * sm];
+            t2r = ar[q + sm] + ar[q + 3 * sm];
+            t2i = ai[q + sm] + ai[q + 3 * sm];
+            t3r = ar[q + sm] - ar[q + 3 * sm];
+            t3i = ai[q + sm] - ai[q + 3 * sm];
+            c1r = t1r + t3i;
+            c1i = t1i - t3r;
+            c2r = t0r - t2r;
+            c2i = t0i - t2i;
+            c3r = t1r - t3i;
+            c3i = t1i + t3r;
+            br[q] = t0r + t2r;
+            bi[q] = t0i + t2i;
+            br[q + s] = c1r * w1r - c1i * w1i;
+            bi[q + s] = c1r * w1i + c1i * w1r;
+            br[q + 2 * s] = c2r * w2r - c2i * w2i;
+            bi[q + 2 * s] = c2r * w2i + c2i * w2r;
+            br[q + 3 * s] = c3r * w3r - c3i * w3i;
+            bi[q + 3 * s] = c3r * w3i + c3i * w3r;
+        }
+    }
+}
+
+static void
+fft_stage2(int s, int m, const MYFLT *xr, const MYFLT *xi, MYFLT *yr, MYFLT *yi, const MYFLT *twr, const MYFLT *twi)
+{
+    int p, q, sm = s * m;
+    const MYFLT *ar, *ai;
+    MYFLT *br, *bi;
+    MYFLT wr, wi, dr, di;
+
+    for (p = 0; p < m; p++)
+    {
+        wr = twr[p];
+        wi = twi[p];
+        ar = xr + s * p;
+        ai = xi + s * p;
+        br = yr + 2 * s * p;
+        bi = yi + 2 * s * p;
+
+        for (q = 0; q < s; q++)
+        {
+            dr = ar[q] - ar[q + sm];
+            di = ai[q] - ai[q + sm];
+            br[q] = ar[q] + ar[q + sm];
+            bi[q] = ai[q] + ai[q + sm];
+            br[q + s] = dr * wr - di * wi;
+            bi[q + s] = dr * wi + di * wr;
+        }
+    }
+}
+
+static void
+fft_stage3(int s, int m, const MYFLT *xr, const MYFLT *xi, MYFLT *yr, MYFLT *yi, const MYFLT *twr, const MYFLT *twi)
+{
+    int p, q, sm = s * m;
+    const MYFLT *ar, *ai;
+    MYFLT *br, *bi;
+    MYFLT w1r, w1i, w2r, w2i;
+    MYFLT tr, ti, dr, di, mr, mi, c1r, c1i, c2r, c2i;
+    MYFLT h = 0.5;
+    MYFLT s3 = 0.86602540378443864676; /* sin(2pi/3) */
+
+    for (p = 0; p < m; p++)
+    {
+        w1r = twr[p];
+        w1i = twi[p];
+        w2r = twr[m + p];
+        w2i = twi[m + p];
+        ar = xr + s * p;
+        ai = xi + s * p;
+        br = yr + 3 * s * p;
+        bi = yi + 3 * s * p;
+
+        for (q = 0; q < s; q++)
+        {
+            tr = ar[q + sm] + ar[q + 2 * sm];
+            ti = ai[q + sm] + ai[q + 2 * sm];
+            dr = (ar[q + sm] - ar[q + 2 * sm]) * s3;
+            di = (ai[q + sm] - ai[q + 2 * sm]) * s3;
+            mr = ar[q] - h * tr;
+            mi = ai[q] - h * ti;
+            c1r = mr + di;
+            c1i = mi - dr;
+            c2r = mr - di;
+            c2i = mi + dr;
+            br[q] = ar[q] + tr;
+            bi[q] = ai[q] + ti;
+            br[q + s] = c1r * w1r - c1i * w1i;
+            bi[q + s] = c1r * w1i + c1i * w1r;
+            br[q + 2 * s] = c2r * w2r - c2i * w2i;
+            bi[q + 2 * s] = c2r * w2i + c2i * w2r;
+        }
+    }
+}
+
+static void
+fft_stage5(int s, int m, const MYFLT *xr, const MYFLT *xi, MYFLT *yr, MYFLT *yi, const MYFLT *twr, const MYFLT *twi)
+{
+    int k, p, q, sm = s * m;
+    const MYFLT *ar, *ai;
+    MYFLT *br, *bi;
+    MYFLT wr[4], wi[4], cr[5], ci[5];
+    MYFLT t1r, t1i, t2r, t2i, d1r, d1i, d2r, d2i, m1r, m1i, m2r, m2i, n1r, n1i, n2r, n2i;
+    MYFLT k1 = 0.30901699437494742410; /* cos(2pi/5) */
+    MYFLT k2 = -0.80901699437494742410; /* cos(4pi/5) */
+    MYFLT s1 = 0.95105651629515357212; /* sin(2pi/5) */
+    MYFLT s2 = 0.58778525229247312917; /* sin(4pi/5) */
+
+    for (p = 0; p < m; p++)
+    {
+        for (k = 0; k < 4; k++)
+        {
+            wr[k] = twr[k * m + p];
+            wi[k] = twi[k * m + p];
+        }
+
+        ar = xr + s * p;
+        ai = xi + s * p;
+        br = yr + 5 * s * p;
+        bi = yi + 5 * s * p;
+
+        for (q = 0; q < s; q++)
+        {
+            t1r = ar[q + sm] + ar[q + 4 * sm];
+            t1i = ai[q + sm] + ai[q + 4 * sm];
+            t2r = ar[q + 2 * sm] + ar[q + 3 * sm];
+            t2i = ai[q + 2 * sm] + ai[q + 3 * sm];
+            d1r = ar[q + sm] - ar[q + 4 * sm];
+            d1i = ai[q + sm] - ai[q + 4 * sm];
+            d2r = ar[q + 2 * sm] - ar[q + 3 * sm];
+            d2i = ai[q + 2 * sm] - ai[q + 3 * sm];
+            m1r = ar[q] + k1 * t1r + k2 * t2r;
+            m1i = ai[q] + k1 * t1i + k2 * t2i;
+            m2r = ar[q] + k2 * t1r + k1 * t2r;
+            m2i = ai[q] + k2 * t1i + k1 * t2i;
+            n1r = s1 * d1r + s2 * d2r;
+            n1i = s1 * d1i + s2 * d2i;
+            n2r = s2 * d1r - s1 * d2r;
+            n2i = s2 * d1i - s1 * d2i;
+            cr[1] = m1r + n1i;
+            ci[1] = m1i - n1r;
+            cr[4] = m1r - n1i;
+            ci[4] = m1i + n1r;
+            cr[2] = m2r + n2i;
+            ci[2] = m2i - n2r;
+            cr[3] = m2r - n2i;
+            ci[3] = m2i + n2r;
+            br[q] = ar[q] + t1r + t2r;
+            bi[q] = ai[q] + t1i + t2i;
+
+            for (k = 1; k < 5; k++)
+            {
+                br[q + k * s] = cr[k] * wr[k - 1] - ci[k] * wi[k - 1];
+                bi[q + k * s] = cr[k] * wi[k - 1] + ci[k] * wr[k - 1];
+            }
+        }
+    }
+}
+
+/* Forward complex FFT of n points, from (re, im) to (re, im) or to
+   (re2, im2), the other half of the arrays. Returns 1 in the latter case. */
+static int
+fft_complex(PyoFFTPlan *plan, MYFLT *re, MYFLT *im, MYFLT *re2, MYFLT *im2)
+{
+    int k, m, s = 1, n = plan->size / 2, swapped = 0;
+    MYFLT *tmp;
+
+    for (k = 0; k < plan->nstages; k++)
+    {
+        m = n / plan->radix[k];
+
+        switch (plan->radix[k])
+        {
+            case 4:
+                fft_stage4(s, m, re, im, re2, im2, plan->stage_real[k], plan->stage_imag[k]);
+                break;
+
+            case 2:
+                fft_stage2(s, m, re, im, re2, im2, plan->stage_real[k], plan->stage_imag[k]);
+                break;
+
+            case 3:
+                fft_stage3(s, m, re, im, re2, im2, plan->stage_real[k], plan->stage_imag[k]);
+                break;
+
+            case 5:
+                fft_stage5(s, m, re, im, re2, im2, plan->stage_real[k], plan->stage_imag[k]);
+                break;
+        }
+
+        tmp = re;
+        re = re2;
+        re2 = tmp;
+        tmp = im;
+        im = im2;
+        im2 = tmp;
+        swapped = !swapped;
+        s *= plan->radix[k];
+        n = m;
+    }
+
+    return swapped;
+}
+
+static void
+fft_mixed_forward(PyoFFTPlan *plan, MYFLT *data, MYFLT *outdata)
+{
+    int k, j, size = plan->size, n = size / 2;
+    MYFLT *src;
+    MYFLT ar, ai, br, bi, er, ei, or_, oi, tr, ti, c, s;
+    MYFLT scl = 0.5 / size;
+
+    /* Even samples as real part, odd samples as imaginary part. */
+    for (k = 0; k < n; k++)
+    {
+        outdata[k] = data[2 * k];
+        outdata[n + k] = data[2 * k + 1];
+    }
+
+    src = fft_complex(plan, outdata, outdata + n, data, data + n) ? data : outdata;
+
+    ar = src[0];
+    ai = src[n];
+    outdata[0] = (ar + ai) * (scl + scl);
+    outdata[n] = (ar - ai) * (scl + scl);
+
+    for (k = 1; k <= n / 2; k++)
+    {
+        j = n - k;
+        ar = src[k];
+        ai = src[n + k];
+        br = src[j];
+        bi = src[n + j];
+        er = ar + br;
+        ei = ai - bi;
+        or_ = ai + bi;
+        oi = br - ar;
+        c = plan->real_twiddle[k];
+        s = plan->real_twiddle[n / 2 + 1 + k];
+        tr = c * or_ + s * oi;
+        ti = c * oi - s * or_;
+        outdata[k] = (er + tr) * scl;
+        outdata[size - k] = (ei + ti) * scl;
+
+        if (k != j)
+        {
+            outdata[j] = (er - tr) * scl;
+            outdata[n + k] = (ti - ei) * scl;
+        }
+    }
+}
+
+static void
+fft_mixed_inverse(PyoFFTPlan *plan, MYFLT *data, MYFLT *outdata)
+{
+    int k, j, size = plan->size, n = size / 2;
+    MYFLT *dst, *src;
+    MYFLT ykr, yki, yjr, yji, ar, ai, dr, di, br, bi, c, s;
+
+    /* The stages alternate between the two arrays, start where they end
+       in `data`. */
+    dst = (plan->nstages & 1) ? outdata : data;
+
+    ykr = data[0];
+    yjr = data[n];
+    dst[0] = ykr + yjr;
+    dst[n] = yjr - ykr;
+
+    for (k = 1; k <= n / 2; k++)
+    {
+        j = n - k;
+        ykr = data[k];
+        yki = data[size - k];
+        yjr = data[j];
+        yji = data[n + k];
+        ar = ykr + yjr;
+        ai = yki - yji;
+        dr = ykr - yjr;
+        di = yki + yji;
+        c = plan->real_twiddle[k];
+        s = plan->real_twiddle[n / 2 + 1 + k];
+        br = dr * c - di * s;
+        bi = dr * s + di * c;
+        /* Conjugates, the inverse is computed with the forward stages. */
+        dst[k] = ar - bi;
+        dst[n + k] = -(ai + br);
+
+        if (k != j)
+        {
+            dst[j] = ar + bi;
+            dst[n + j] = ai - br;
+        }
+    }
+
+    if (dst == outdata)
+        fft_complex(plan, outdata, outdata + n, data, data + n);
+    else
+        fft_complex(plan, data, data + n, outdata, outdata + n);
+
+    src = data;
+
+    for (k = 0; k < n; k++)
+    {
+        outdata[2 * k] = src[k];
+        outdata[2 * k + 1] = -src[n + k];
+    }
+}
+
+static void
+fft_plan_free(PyoFFTPlan *plan)
+{
+    int i;
+
+#ifdef USE_FFTW
+
+    if (plan->external[0] != NULL)
+        FFTW(destroy_plan)((FFTW(plan))plan->external[0]);
+
+    if (plan->external[1] != NULL)
+        FFTW(destroy_plan)((FFTW(plan))plan->external[1]);
+
+#endif
+
+    if (plan->split_twiddle != NULL)
+    {
+        for (i = 0; i < 4; i++)
+            PyMem_RawFree(plan->split_twiddle[i]);
+
+        PyMem_RawFree(plan->split_twiddle);
+    }
+
+    PyMem_RawFree(plan->stage_twiddle);
+    PyMem_RawFree(plan->real_twiddle);
+    PyMem_RawFree(plan->packed_twiddle);
+    PyMem_RawFree(plan);
+}
+
+static PyoFFTPlan *
+fft_plan_new(int size, int type)
+{
+    int i, k, p, r, m, n, len, total;
+    double a;
+    PyoFFTPlan *plan = (PyoFFTPlan *)PyMem_RawCalloc(1, sizeof(PyoFFTPlan));
+
+    if (plan == NULL)
+        return NULL;
+
+    plan->size = size;
+    plan->type = type;
+    plan->refcount = 1;
+
+    if (type == PYO_FFT_REAL_PACKED)
+    {
+        plan->packed_twiddle = (MYFLT *)PyMem_RawMalloc(size * sizeof(MYFLT));
+
+        if (plan->packed_twiddle == NULL)
+        {
+            fft_plan_free(plan);
+            return NULL;
+        }
+
+        fft_compute_radix2_twiddle(plan->packed_twiddle, size);
+        return plan;
+    }
+
+#ifdef USE_FFTW
+    {
+        MYFLT *tmp1 = (MYFLT *)FFTW(malloc)(size * sizeof(MYFLT));
+        MYFLT *tmp2 = (MYFLT *)FFTW(malloc)(size * sizeof(MYFLT));
+
+        /* Half-complex format is the split format of pyo. */
+        if (tmp1 != NULL && tmp2 != NULL)
+        {
+            plan->external[0] = FFTW(plan_r2r_1d)(size, tmp1, tmp2, FFTW_R2HC, FFTW_ESTIMATE | FFTW_UNALIGNED);
+            plan->external[1] = FFTW(plan_r2r_1d)(size, tmp1, tmp2, FFTW_HC2R, FFTW_ESTIMATE | FFTW_UNALIGNED);
+        }
+
+        FFTW(free)(tmp1);
+        FFTW(free)(tmp2);
+
+        if (plan->external[0] != NULL && plan->external[1] != NULL)
+            return plan;
+    }
+#endif
+
+    n = size / 2;
+    plan->nstages = fft_factorize(n, plan->radix);
+
+    /* Twiddles of the stages: (radix - 1) x (length / radix) each. */
+    total = 0;
+
+    for (k = 0, len = n; k < plan->nstages; k++)
+    {
+        total += (plan->radix[k] - 1) * (len / plan->radix[k]);
+        len /= plan->radix[k];
+    }
+
+    plan->stage_twiddle = (MYFLT *)PyMem_RawMalloc((2 * total + 1) * sizeof(MYFLT));
+    plan->real_twiddle = (MYFLT *)PyMem_RawMalloc((n + 2) * sizeof(MYFLT));
+
+    if (plan->stage_twiddle == NULL || plan->real_twiddle == NULL)
+    {
+        fft_plan_free(plan);
+        return NULL;
+    }
+
+    i = 0;
+
+    for (k = 0, len = n; k < plan->nstages; k++)
+    {
+        r = plan->radix[k];
+        m = len / r;
+        plan->stage_real[k] = plan->stage_twiddle + i;
+        plan->stage_imag[k] = plan->stage_twiddle + total + i;
+
+        for (p = 0; p < m; p++)
+        {
+            for (r = 1; r < plan->radix[k]; r++)
+            {
+                a = -2.0 * PI * p * r / len;
+                plan->stage_real[k][(r - 1) * m + p] = (MYFLT)cos(a);
+                plan->stage_imag[k][(r - 1) * m + p] = (MYFLT)sin(a);
+            }
+        }
+
+        i += (plan->radix[k] - 1) * m;
+        len = m;
+    }
+
+    /* cos and sin of 2pi k / size, for k in [0, size / 4]. */
+    for (k = 0; k <= n / 2; k++)
+    {
+        a = 2.0 * PI * k / size;
+        plan->real_twiddle[k] = (MYFLT)cos(a);
+        plan->real_twiddle[n / 2 + 1 + k] = (MYFLT)sin(a);
+    }
+
+    return plan;
+}
+
+PyoFFTPlan *
+fft_plan_acquire(int size, int type)
+{
+    PyoFFTPlan *plan;
+
+    if (!fft_valid_size(size, type))
+        return NULL;
+
+    pthread_mutex_lock(&fft_plans_mutex);
+
+    for (plan = fft_plans; plan != NULL; plan = plan->next)
+    {
+        if (plan->size == size && plan->type == type)
+        {
+            plan->refcount++;
+            pthread_mutex_unlock(&fft_plans_mutex);
+            return plan;
+        }
+    }
+
+    plan = fft_plan_new(size, type);
+
+    if (plan != NULL)
+    {
+        plan->next = fft_plans;
+        fft_plans = plan;
+    }
+
+    pthread_mutex_unlock(&fft_plans_mutex);
+
+    return plan;
+}
+
+void
+fft_plan_release(PyoFFTPlan *plan)
+{
+    PyoFFTPlan **link;
+
+    if (plan == NULL)
+        return;
+
+    pthread_mutex_lock(&fft_plans_mutex);
+
+    if (--plan->refcount == 0)
+    {
+        for (link = &fft_plans; *link != NULL; link = &(*link)->next)
+        {
+            if (*link == plan)
+            {
+                *link = plan->next;
+                break;
+            }
+        }
+
+        fft_plan_free(plan);
+    }
+
+    pthread_mutex_unlock(&fft_plans_mutex);
+}
+
+void
+fft_plan_forward(PyoFFTPlan *plan, MYFLT *data, MYFLT *outdata)
+{
+    if (plan->type == PYO_FFT_REAL_PACKED)
+    {
+        realfft_packed(data, outdata, plan->size, plan->packed_twiddle);
+        return;
+    }
+
+#ifdef USE_FFTW
+
+    if (plan->external[0] != NULL)
+    {
+        int i;
+        MYFLT scl = 1.0 / plan->size;
+
+        FFTW(execute_r2r)((FFTW(plan))plan->external[0], data, outdata);
+
+
+        for (i = 0; i < plan->size; i++)
+            outdata[i] *= scl;
+
+        return;
+    }
+
+#endif
+
+    fft_mixed_forward(plan, data, outdata);
+}
+
+void
+fft_plan_inverse(PyoFFTPlan *plan, MYFLT *data, MYFLT *outdata)
+{
+    if (plan->type == PYO_FFT_REAL_PACKED)
+    {
+        irealfft_packed(data, outdata, plan->size, plan->packed_twiddle);
+        return;
+    }
+
+#ifdef USE_FFTW
+
+    if (plan->external[1] != NULL)
+    {
+        FFTW(execute_r2r)((FFTW(plan))plan->external[1], data, outdata);
+        return;
+    }
+
+#endif
+
+    fft_mixed_inverse(plan, data, outdata);
+}
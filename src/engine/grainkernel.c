@@ -0,0 +1,189 @@
+/**************************************************************************
+ * Copyright 2009-2015 Olivier Belanger                                   *
+ *                                                                        *
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *
+ *                                                                        *
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with pyo.  If not, see <http://www.gnu.org/licenses/>.   *
+ *************************************************************************/
+
+/* Grain kernels.
+ *
+ * A granulator adds each of its grains to the output block, one after the
+ * other: an envelope read at the grain phase times the sound table read at
+ * the grain position, both with linear interpolation. The AVX2 version
+ * reads the tables with gathers and performs the same operations in the
+ * same order as the scalar version, so the output does not depend on the
+ * instruction set. */
+
+#include <limits.h>
+#include "grainkernel.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define GRAINKERNEL_X86
+#include <immintrin.h>
+#endif
+
+/* Scalar kernel. */
+
+static void
+grainkernel_accumulate_c(MYFLT *PYO_RESTRICT out, const MYFLT *PYO_RESTRICT phase, const MYFLT *PYO_RESTRICT index,
+                         const MYFLT *env, T_SIZE_T envsize, const MYFLT *table, T_SIZE_T tablesize, int size)
+{
+    MYFLT x, x1, pos, fpart, amp, val;
+    T_SIZE_T ipart;
+    int i;
+
+    for (i = 0; i < size; i++)
+    {
+        pos = phase[i] * envsize;
+        ipart = (T_SIZE_T)pos;
+        fpart = pos - ipart;
+        x = env[ipart];
+        x1 = env[ipart + 1];
+        amp = x + (x1 - x) * fpart;
+
+        pos = index[i];
+
+        if (pos >= 0 && pos < tablesize)
+        {
+            ipart = (T_SIZE_T)pos;
+            fpart = pos - ipart;
+            x = table[ipart];
+            x1 = table[ipart + 1];
+            val = x + (x1 - x) * fpart;
+        }
+        else
+            val = 0.0;
+
+        out[i] += (val * amp);
+    }
+}
+
+#ifdef GRAINKERNEL_X86
+
+/* AVX2 kernel. The gathers take 32-bit indices, larger tables use the
+   scalar kernel. The lanes outside of the sound table are not loaded and
+   their value is set to 0, as in the scalar kernel. */
+
+#ifndef USE_DOUBLE
+
+#define GRAINKERNEL_VTYPE __m256
+#define GRAINKERNEL_ITYPE __m256i
+#define GRAINKERNEL_VWIDTH 8
+#define GRAINKERNEL_VLOAD _mm256_loadu_ps
+#define GRAINKERNEL_VSTORE _mm256_storeu_ps
+#define GRAINKERNEL_VSET1 _mm256_set1_ps
+#define GRAINKERNEL_VZERO _mm256_setzero_ps
+#define GRAINKERNEL_VMUL _mm256_mul_ps
+#define GRAINKERNEL_VADD _mm256_add_ps
+#define GRAINKERNEL_VSUB _mm256_sub_ps
+#define GRAINKERNEL_VAND _mm256_and_ps
+#define GRAINKERNEL_VCMP _mm256_cmp_ps
+#define GRAINKERNEL_VTRUNC _mm256_cvttps_epi32
+#define GRAINKERNEL_VFLOAT _mm256_cvtepi32_ps
+#define GRAINKERNEL_INEXT(v) _mm256_add_epi32(v, _mm256_set1_epi32(1))
+#define GRAINKERNEL_GATHER(base, v) _mm256_i32gather_ps(base, v, 4)
+#define GRAINKERNEL_MGATHER(base, v, mask) _mm256_mask_i32gather_ps(_mm256_setzero_ps(), base, v, mask, 4)
+
+#else
+
+#define GRAINKERNEL_VTYPE __m256d
+#define GRAINKERNEL_ITYPE __m128i
+#define GRAINKERNEL_VWIDTH 4
+#define GRAINKERNEL_VLOAD _mm256_loadu_pd
+#define GRAINKERNEL_VSTORE _mm256_storeu_pd
+#define GRAINKERNEL_VSET1 _mm256_set1_pd
+#define GRAINKERNEL_VZERO _mm256_setzero_pd
+#define GRAINKERNEL_VMUL _mm256_mul_pd
+#define GRAINKERNEL_VADD _mm256_add_pd
+#define GRAINKERNEL_VSUB _mm256_sub_pd
+#define GRAINKERNEL_VAND _mm256_and_pd
+#define GRAINKERNEL_VCMP _mm256_cmp_pd
+#define GRAINKERNEL_VTRUNC _mm256_cvttpd_epi32
+#define GRAINKERNEL_VFLOAT _mm256_cvtepi32_pd
+#define GRAINKERNEL_INEXT(v) _mm_add_epi32(v, _mm_set1_epi32(1))
+#define GRAINKERNEL_GATHER(base, v) _mm256_i32gather_pd(base, v, 8)
+#define GRAINKERNEL_MGATHER(base, v, mask) _mm256_mask_i32gather_pd(_mm256_setzero_pd(), base, v, mask, 8)
+
+#endif
+
+__attribute__((target("avx2"))) static void
+grainkernel_accumulate_avx2(MYFLT *PYO_RESTRICT out, const MYFLT *PYO_RESTRICT phase, const MYFLT *PYO_RESTRICT index,
+                            const MYFLT *env, T_SIZE_T envsize, const MYFLT *table, T_SIZE_T tablesize, int size)
+{
+    int i = 0;
+    GRAINKERNEL_VTYPE pos, fpart, x, x1, amp, val, inside;
+    GRAINKERNEL_ITYPE ipart;
+    GRAINKERNEL_VTYPE venvsize = GRAINKERNEL_VSET1(envsize), vtablesize = GRAINKERNEL_VSET1(tablesize);
+    GRAINKERNEL_VTYPE zero = GRAINKERNEL_VZERO();
+
+    /* The phase of a grain can go a little over 1 (or under 0 with a
+       negative pitch), keep a margin for the envelope indices. */
+    if (envsize > INT_MAX / 4 || tablesize > INT_MAX - 1)
+    {
+        grainkernel_accumulate_c(out, phase, index, env, envsize, table, tablesize, size);
+        return;
+    }
+
+    for (; i <= size - GRAINKERNEL_VWIDTH; i += GRAINKERNEL_VWIDTH)
+    {
+        pos = GRAINKERNEL_VMUL(GRAINKERNEL_VLOAD(phase + i), venvsize);
+        ipart = GRAINKERNEL_VTRUNC(pos);
+        fpart = GRAINKERNEL_VSUB(pos, GRAINKERNEL_VFLOAT(ipart));
+        x = GRAINKERNEL_GATHER(env, ipart);
+        x1 = GRAINKERNEL_GATHER(env, GRAINKERNEL_INEXT(ipart));
+        amp = GRAINKERNEL_VADD(x, GRAINKERNEL_VMUL(GRAINKERNEL_VSUB(x1, x), fpart));
+
+        pos = GRAINKERNEL_VLOAD(index + i);
+        inside = GRAINKERNEL_VAND(GRAINKERNEL_VCMP(pos, zero, _CMP_GE_OQ), GRAINKERNEL_VCMP(pos, vtablesize, _CMP_LT_OQ));
+        ipart = GRAINKERNEL_VTRUNC(pos);
+        fpart = GRAINKERNEL_VSUB(pos, GRAINKERNEL_VFLOAT(ipart));
+        x = GRAINKERNEL_MGATHER(table, ipart, inside);
+        x1 = GRAINKERNEL_MGATHER(table, GRAINKERNEL_INEXT(ipart), inside);
+        val = GRAINKERNEL_VAND(GRAINKERNEL_VADD(x, GRAINKERNEL_VMUL(GRAINKERNEL_VSUB(x1, x), fpart)), inside);
+
+        GRAINKERNEL_VSTORE(out + i, GRAINKERNEL_VADD(GRAINKERNEL_VLOAD(out + i), GRAINKERNEL_VMUL(val, amp)));
+    }
+
+    if (i < size)
+        grainkernel_accumulate_c(out + i, phase + i, index + i, env, envsize, table, tablesize, size - i);
+}
+
+#endif // GRAINKERNEL_X86
+
+void (*grainkernel_accumulate)(MYFLT *PYO_RESTRICT out, const MYFLT *PYO_RESTRICT phase, const MYFLT *PYO_RESTRICT index,
+                               const MYFLT *env, T_SIZE_T envsize, const MYFLT *table, T_SIZE_T tablesize, int size) = grainkernel_accumulate_c;
+
+static const char *grainkernel_kernels = "scalar";
+
+void
+grainkernel_init(void)
+{
+#if defined(GRAINKERNEL_X86)
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2"))
+    {
+        grainkernel_accumulate = grainkernel_accumulate_avx2;
+        grainkernel_kernels = "avx2";
+    }
+#endif
+}
+
+const char *
+grainkernel_name(void)
+{
+    return grainkernel_kernels;
+}
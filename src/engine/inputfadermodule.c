@@ -199,13 +199,23 @@ InputFader_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 static PyObject *
 InputFader_setInput(InputFader *self, PyObject *args, PyObject *kwds)
 {
-    PyObject *tmp, *streamtmp;
+    PyObject *tmp, *streamtmp, *old;
 
     static char *kwlist[] = {"input", "fadetime", NULL};
 
     if (! PyArg_ParseTupleAndKeywords(args, kwds, TYPE_O_F, kwlist, &tmp, &self->fadetime))
         Py_RETURN_NONE;
 
+    streamtmp = PyObject_CallMethod(tmp, "_getStream", NULL);
+
+    if (streamtmp == NULL)
+        return NULL;
+
+    /* The stream lives as long as its object. */
+    Py_DECREF(streamtmp);
+    Py_INCREF(tmp);
+    Server_lockProcessing(self->server);
+
     self->switcher = (self->switcher + 1) % 2;
     self->currentTime = 0.0;
 
@@ -214,25 +224,24 @@ InputFader_setInput(InputFader *self, PyObject *args, PyObject *kwds)
 
     if (self->switcher == 0)
     {
-        Py_DECREF(self->input1);
+        old = self->input1;
         self->input1 = tmp;
-        Py_INCREF(self->input1);
-        streamtmp = PyObject_CallMethod((PyObject *)self->input1, "_getStream", NULL);
         self->input1_stream = (Stream *)streamtmp;
-        Py_INCREF(self->input1_stream);
         self->proc_func_ptr = InputFader_process_one;
     }
     else
     {
-        Py_DECREF(self->input2);
+        old = self->input2;
         self->input2 = tmp;
-        Py_INCREF(self->input2);
-        streamtmp = PyObject_CallMethod((PyObject *)self->input2, "_getStream", NULL);
         self->input2_stream = (Stream *)streamtmp;
-        Py_INCREF(self->input2_stream);
         self->proc_func_ptr = InputFader_process_two;
     }
 
+    Stream_invalidateGraph();
+    Server_unlockProcessing(self->server);
+
+    Py_DECREF(old);
+
     Py_RETURN_NONE;
 }
 
@@ -0,0 +1,361 @@
+/**************************************************************************
+ * Copyright 2009-2015 Olivier Belanger                                   *
+ *                                                                        *
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *
+ *                                                                        *
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with pyo.  If not, see <http://www.gnu.org/licenses/>.   *
+ *************************************************************************/
+
+/* Output mix bus kernels.
+ *
+ * The streams are summed into one MYFLT buffer per channel, then the global
+ * amplitude is applied while converting to the float output buffer. These
+ * loops run over every output sample of every block, so they have SSE/AVX
+ * (x86) and NEON (aarch64) versions selected at runtime. Only element-wise
+ * additions and multiplications are vectorized, in the same order as the
+ * scalar versions, so the output does not depend on the instruction set. */
+
+#include <string.h>
+#include "mixbus.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MIXBUS_X86
+#include <immintrin.h>
+#elif defined(__GNUC__) && defined(__aarch64__) && defined(__ARM_NEON)
+#define MIXBUS_NEON
+#include <arm_neon.h>
+#endif
+
+/* Scalar kernels. */
+
+static void
+mixbus_accumulate_c(MYFLT *dst, const MYFLT *src, int size)
+{
+    int i;
+
+    for (i = 0; i < size; i++)
+        dst[i] += src[i];
+}
+
+static void
+mixbus_scale_c(float *dst, const MYFLT *src, MYFLT gain, int size)
+{
+    int i;
+
+    for (i = 0; i < size; i++)
+        dst[i] = (float)src[i] * gain;
+}
+
+static void
+mixbus_ramp_c(float *dst, const MYFLT *src, const MYFLT *gain, int size)
+{
+    int i;
+
+    for (i = 0; i < size; i++)
+        dst[i] = (float)src[i] * gain[i];
+}
+
+#ifdef MIXBUS_X86
+
+/* SSE kernels. In double precision, samples are rounded to float before the
+   multiplication, as in the scalar versions. */
+
+__attribute__((target("sse2"))) static void
+mixbus_accumulate_sse(MYFLT *dst, const MYFLT *src, int size)
+{
+    int i = 0;
+
+#ifndef USE_DOUBLE
+
+    for (; i <= size - 4; i += 4)
+        _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_loadu_ps(src + i)));
+
+#else
+
+    for (; i <= size - 2; i += 2)
+        _mm_storeu_pd(dst + i, _mm_add_pd(_mm_loadu_pd(dst + i), _mm_loadu_pd(src + i)));
+
+#endif
+
+    for (; i < size; i++)
+        dst[i] += src[i];
+}
+
+__attribute__((target("sse2"))) static void
+mixbus_scale_sse(float *dst, const MYFLT *src, MYFLT gain, int size)
+{
+    int i = 0;
+
+#ifndef USE_DOUBLE
+    __m128 g = _mm_set1_ps(gain);
+
+    for (; i <= size - 4; i += 4)
+        _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_loadu_ps(src + i), g));
+
+#else
+    __m128d x, g = _mm_set1_pd(gain);
+
+    for (; i <= size - 2; i += 2)
+    {
+        x = _mm_cvtps_pd(_mm_cvtpd_ps(_mm_loadu_pd(src + i)));
+        _mm_storel_pi((__m64 *)(dst + i), _mm_cvtpd_ps(_mm_mul_pd(x, g)));
+    }
+
+#endif
+
+    for (; i < size; i++)
+        dst[i] = (float)src[i] * gain;
+}
+
+__attribute__((target("sse2"))) static void
+mixbus_ramp_sse(float *dst, const MYFLT *src, const MYFLT *gain, int size)
+{
+    int i = 0;
+
+#ifndef USE_DOUBLE
+
+    for (; i <= size - 4; i += 4)
+        _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_loadu_ps(src + i), _mm_loadu_ps(gain + i)));
+
+#else
+    __m128d x;
+
+    for (; i <= size - 2; i += 2)
+    {
+        x = _mm_cvtps_pd(_mm_cvtpd_ps(_mm_loadu_pd(src + i)));
+        _mm_storel_pi((__m64 *)(dst + i), _mm_cvtpd_ps(_mm_mul_pd(x, _mm_loadu_pd(gain + i))));
+    }
+
+#endif
+
+    for (; i < size; i++)
+        dst[i] = (float)src[i] * gain[i];
+}
+
+/* AVX kernels. */
+
+__attribute__((target("avx"))) static void
+mixbus_accumulate_avx(MYFLT *dst, const MYFLT *src, int size)
+{
+    int i = 0;
+
+#ifndef USE_DOUBLE
+
+    for (; i <= size - 8; i += 8)
+        _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_loadu_ps(dst + i), _mm256_loadu_ps(src + i)));
+
+#else
+
+    for (; i <= size - 4; i += 4)
+        _mm256_storeu_pd(dst + i, _mm256_add_pd(_mm256_loadu_pd(dst + i), _mm256_loadu_pd(src + i)));
+
+#endif
+
+    for (; i < size; i++)
+        dst[i] += src[i];
+}
+
+__attribute__((target("avx"))) static void
+mixbus_scale_avx(float *dst, const MYFLT *src, MYFLT gain, int size)
+{
+    int i = 0;
+
+#ifndef USE_DOUBLE
+    __m256 g = _mm256_set1_ps(gain);
+
+    for (; i <= size - 8; i += 8)
+        _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_loadu_ps(src + i), g));
+
+#else
+    __m256d x, g = _mm256_set1_pd(gain);
+
+    for (; i <= size - 4; i += 4)
+    {
+        x = _mm256_cvtps_pd(_mm256_cvtpd_ps(_mm256_loadu_pd(src + i)));
+        _mm_storeu_ps(dst + i, _mm256_cvtpd_ps(_mm256_mul_pd(x, g)));
+    }
+
+#endif
+
+    for (; i < size; i++)
+        dst[i] = (float)src[i] * gain;
+}
+
+__attribute__((target("avx"))) static void
+mixbus_ramp_avx(float *dst, const MYFLT *src, const MYFLT *gain, int size)
+{
+    int i = 0;
+
+#ifndef USE_DOUBLE
+
+    for (; i <= size - 8; i += 8)
+        _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_loadu_ps(src + i), _mm256_loadu_ps(gain + i)));
+
+#else
+    __m256d x;
+
+    for (; i <= size - 4; i += 4)
+    {
+        x = _mm256_cvtps_pd(_mm256_cvtpd_ps(_mm256_loadu_pd(src + i)));
+        _mm_storeu_ps(dst + i, _mm256_cvtpd_ps(_mm256_mul_pd(x, _mm256_loadu_pd(gain + i))));
+    }
+
+#endif
+
+    for (; i < size; i++)
+        dst[i] = (float)src[i] * gain[i];
+}
+
+#endif // MIXBUS_X86
+
+#ifdef MIXBUS_NEON
+
+/* NEON kernels. */
+
+static void
+mixbus_accumulate_neon(MYFLT *dst, const MYFLT *src, int size)
+{
+    int i = 0;
+
+#ifndef USE_DOUBLE
+
+    for (; i <= size - 4; i += 4)
+        vst1q_f32(dst + i, vaddq_f32(vld1q_f32(dst + i), vld1q_f32(src + i)));
+
+#else
+
+    for (; i <= size - 2; i += 2)
+        vst1q_f64(dst + i, vaddq_f64(vld1q_f64(dst + i), vld1q_f64(src + i)));
+
+#endif
+
+    for (; i < size; i++)
+        dst[i] += src[i];
+}
+
+static void
+mixbus_scale_neon(float *dst, const MYFLT *src, MYFLT gain, int size)
+{
+    int i = 0;
+
+#ifndef USE_DOUBLE
+
+    for (; i <= size - 4; i += 4)
+        vst1q_f32(dst + i, vmulq_n_f32(vld1q_f32(src + i), gain));
+
+#else
+    float64x2_t x, g = vdupq_n_f64(gain);
+
+    for (; i <= size - 2; i += 2)
+    {
+        x = vcvt_f64_f32(vcvt_f32_f64(vld1q_f64(src + i)));
+        vst1_f32(dst + i, vcvt_f32_f64(vmulq_f64(x, g)));
+    }
+
+#endif
+
+    for (; i < size; i++)
+        dst[i] = (float)src[i] * gain;
+}
+
+static void
+mixbus_ramp_neon(float *dst, const MYFLT *src, const MYFLT *gain, int size)
+{
+    int i = 0;
+
+#ifndef USE_DOUBLE
+
+    for (; i <= size - 4; i += 4)
+        vst1q_f32(dst + i, vmulq_f32(vld1q_f32(src + i), vld1q_f32(gain + i)));
+
+#else
+    float64x2_t x;
+
+    for (; i <= size - 2; i += 2)
+    {
+        x = vcvt_f64_f32(vcvt_f32_f64(vld1q_f64(src + i)));
+        vst1_f32(dst + i, vcvt_f32_f64(vmulq_f64(x, vld1q_f64(gain + i))));
+    }
+
+#endif
+
+    for (; i < size; i++)
+        dst[i] = (float)src[i] * gain[i];
+}
+
+#endif // MIXBUS_NEON
+
+void (*mixbus_accumulate)(MYFLT *dst, const MYFLT *src, int size) = mixbus_accumulate_c;
+void (*mixbus_scale)(float *dst, const MYFLT *src, MYFLT gain, int size) = mixbus_scale_c;
+void (*mixbus_ramp)(float *dst, const MYFLT *src, const MYFLT *gain, int size) = mixbus_ramp_c;
+
+static const char *mixbus_kernels = "scalar";
+
+void
+mixbus_init(void)
+{
+#if defined(MIXBUS_X86)
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx"))
+    {
+        mixbus_accumulate = mixbus_accumulate_avx;
+        mixbus_scale = mixbus_scale_avx;
+        mixbus_ramp = mixbus_ramp_avx;
+        mixbus_kernels = "avx";
+    }
+    else if (__builtin_cpu_supports("sse2"))
+    {
+        mixbus_accumulate = mixbus_accumulate_sse;
+        mixbus_scale = mixbus_scale_sse;
+        mixbus_ramp = mixbus_ramp_sse;
+        mixbus_kernels = "sse2";
+    }
+
+#elif defined(MIXBUS_NEON)
+    mixbus_accumulate = mixbus_accumulate_neon;
+    mixbus_scale = mixbus_scale_neon;
+    mixbus_ramp = mixbus_ramp_neon;
+    mixbus_kernels = "neon";
+#endif
+}
+
+const char *
+mixbus_name(void)
+{
+    return mixbus_kernels;
+}
+
+/* Planar (one buffer per channel) to interleaved frames. */
+void
+mixbus_interleave(float *dst, const float *src, int nchnls, int size)
+{
+    int i, j;
+    const float *in;
+
+    if (nchnls == 1)
+    {
+        memcpy(dst, src, size * sizeof(float));
+        return;
+    }
+
+    for (j = 0; j < nchnls; j++)
+    {
+        in = src + j * size;
+
+        for (i = 0; i < size; i++)
+            dst[i * nchnls + j] = in[i];
+    }
+}
@@ -25,11 +25,14 @@
 #include "streammodule.h"
 #include "servermodule.h"
 #include "dummymodule.h"
+#include "mixbus.h"
 
 typedef struct
 {
     pyo_audio_HEAD
     PyObject *input;
+    Stream **input_streams; /* streams of the objects in `input`, fetched once (borrowed). */
+    int inputsize;
     int modebuffer[2];
 } Mix;
 
@@ -92,32 +95,67 @@ Mix_setProcMode(Mix *self)
 static void
 Mix_compute_next_data_frame(Mix *self)
 {
-    int i, j;
-    MYFLT old;
-    PyObject *stream;
-    Py_ssize_t lsize = PyList_Size(self->input);
-
-    MYFLT buffer[self->bufsize];
-    memset(&buffer, 0, sizeof(buffer));
+    int i, instate, state = PYO_STREAM_SILENT;
+    MYFLT *in;
 
-    for (i = 0; i < lsize; i++)
+    for (i = 0; i < self->inputsize; i++)
     {
-        stream = PyObject_CallMethod((PyObject *)PyList_GET_ITEM(self->input, i), "_getStream", NULL);
-        MYFLT *in = Stream_getData((Stream *)stream);
+        instate = Stream_getState(self->input_streams[i]);
+
+        if (instate == PYO_STREAM_SILENT)
+            continue;
 
-        for (j = 0; j < self->bufsize; j++)
+        in = Stream_getData(self->input_streams[i]);
+
+        if (state == PYO_STREAM_SILENT)
         {
-            old = buffer[j];
-            buffer[j] = in[j] + old;
+            memcpy(self->data, in, self->bufsize * sizeof(MYFLT));
+            state = instate;
+        }
+        else
+        {
+            mixbus_accumulate(self->data, in, self->bufsize);
+
+            if (instate != PYO_STREAM_CONSTANT)
+                state = PYO_STREAM_VARYING;
         }
     }
 
-    for (i = 0; i < self->bufsize; i++)
+    if (state == PYO_STREAM_SILENT)
+        memset(self->data, 0, self->bufsize * sizeof(MYFLT));
+
+    Stream_setState(self->stream, state);
+
+    (*self->muladd_func_ptr)(self);
+}
+
+/* Fetches the stream of every object in the input list. The pointers are
+   borrowed, the streams live as long as the objects held by `input`. */
+static int
+Mix_setInputStreams(Mix *self)
+{
+    int i;
+    PyObject *streamtmp;
+    Py_ssize_t lsize = PyList_Size(self->input);
+
+    if (lsize < 0)
+        return -1;
+
+    self->input_streams = (Stream **)PyMem_RawMalloc((lsize + 1) * sizeof(Stream *));
+
+    for (i = 0; i < lsize; i++)
     {
-        self->data[i] = buffer[i];
+        streamtmp = PyObject_CallMethod((PyObject *)PyList_GET_ITEM(self->input, i), "_getStream", NULL);
+
+        if (streamtmp == NULL)
+            return -1;
+
+        self->input_streams[i] = (Stream *)streamtmp;
+        self->inputsize = i + 1;
+        Py_DECREF(streamtmp);
     }
 
-    (*self->muladd_func_ptr)(self);
+    return 0;
 }
 
 static int
@@ -141,6 +179,7 @@ Mix_dealloc(Mix* self)
 {
     pyo_DEALLOC
     Mix_clear(self);
+    PyMem_RawFree(self->input_streams);
     Py_TYPE(self->stream)->tp_free((PyObject*)self->stream);
     Py_TYPE(self)->tp_free((PyObject*)self);
 }
@@ -168,6 +207,9 @@ Mix_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->input = inputtmp;
     Py_INCREF(self->input);
 
+    if (Mix_setInputStreams(self) < 0)
+        return NULL;
+
     if (multmp)
     {
         PyObject_CallMethod((PyObject *)self, "setMul", "O", multmp);
@@ -0,0 +1,514 @@
+/**************************************************************************
+ * Copyright 2009-2015 Olivier Belanger                                   *
+ *                                                                        *
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *
+ *                                                                        *
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with pyo.  If not, see <http://www.gnu.org/licenses/>.   *
+ *************************************************************************/
+
+/* Mul & add kernels.
+ *
+ * Every audio object applies its `mul` and `add` attributes to its output
+ * buffer once per block, so these loops run over every sample of the graph.
+ * They have SSE/AVX (x86) and NEON (aarch64) versions selected at runtime.
+ * The vector versions are written once, with the MULADD_V* macros defined
+ * for each instruction set, and perform the same operations in the same
+ * order as the scalar versions. */
+
+#include <stdint.h>
+#include "muladd.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MULADD_X86
+#include <immintrin.h>
+#elif defined(__GNUC__) && defined(__aarch64__) && defined(__ARM_NEON)
+#define MULADD_NEON
+#include <arm_neon.h>
+#endif
+
+/* Divisors closer to 0 than this are replaced by it. */
+#define MULADD_EPSILON 0.00001
+
+static inline MYFLT
+muladd_clip(MYFLT x)
+{
+    if (x < MULADD_EPSILON && x > -MULADD_EPSILON)
+        x = MULADD_EPSILON;
+
+    return x;
+}
+
+/* Scalar kernels. */
+
+static void
+muladd_ii_c(MYFLT *PYO_RESTRICT data, MYFLT mul, MYFLT add, int size)
+{
+    int i;
+
+    for (i = 0; i < size; i++)
+        data[i] = mul * data[i] + add;
+}
+
+static void
+muladd_copy_c(MYFLT *PYO_RESTRICT data, const MYFLT *PYO_RESTRICT src, MYFLT mul, MYFLT add, int size)
+{
+    int i;
+
+    for (i = 0; i < size; i++)
+        data[i] = mul * src[i] + add;
+}
+
+static void
+muladd_ai_c(MYFLT *PYO_RESTRICT data, const MYFLT *PYO_RESTRICT mul, MYFLT add, int size)
+{
+    int i;
+
+    for (i = 0; i < size; i++)
+        data[i] = mul[i] * data[i] + add;
+}
+
+static void
+muladd_ia_c(MYFLT *PYO_RESTRICT data, MYFLT mul, const MYFLT *PYO_RESTRICT add, int size)
+{
+    int i;
+
+    for (i = 0; i < size; i++)
+        data[i] = mul * data[i] + add[i];
+}
+
+static void
+muladd_aa_c(MYFLT *PYO_RESTRICT data, const MYFLT *PYO_RESTRICT mul, const MYFLT *PYO_RESTRICT add, int size)
+{
+    int i;
+
+    for (i = 0; i < size; i++)
+        data[i] = mul[i] * data[i] + add[i];
+}
+
+static void
+muladd_ireva_c(MYFLT *PYO_RESTRICT data, MYFLT mul, const MYFLT *PYO_RESTRICT add, int size)
+{
+    int i;
+
+    for (i = 0; i < size; i++)
+        data[i] = mul * data[i] - add[i];
+}
+
+static void
+muladd_areva_c(MYFLT *PYO_RESTRICT data, const MYFLT *PYO_RESTRICT mul, const MYFLT *PYO_RESTRICT add, int size)
+{
+    int i;
+
+    for (i = 0; i < size; i++)
+        data[i] = mul[i] * data[i] - add[i];
+}
+
+static void
+muladd_revai_c(MYFLT *PYO_RESTRICT data, const MYFLT *PYO_RESTRICT mul, MYFLT add, int size)
+{
+    int i;
+
+    for (i = 0; i < size; i++)
+        data[i] = data[i] / muladd_clip(mul[i]) + add;
+}
+
+static void
+muladd_revaa_c(MYFLT *PYO_RESTRICT data, const MYFLT *PYO_RESTRICT mul, const MYFLT *PYO_RESTRICT add, int size)
+{
+    int i;
+
+    for (i = 0; i < size; i++)
+        data[i] = data[i] / muladd_clip(mul[i]) + add[i];
+}
+
+static void
+muladd_revareva_c(MYFLT *PYO_RESTRICT data, const MYFLT *PYO_RESTRICT mul, const MYFLT *PYO_RESTRICT add, int size)
+{
+    int i;
+
+    for (i = 0; i < size; i++)
+        data[i] = data[i] / muladd_clip(mul[i]) - add[i];
+}
+
+/* Vector kernels, instantiated by MULADD_VKERNELS(isa) once the following
+   macros are defined for the instruction set:
+   MULADD_VATTR: function attributes, MULADD_VTYPE: vector type,
+   MULADD_VWIDTH: number of MYFLT per vector, MULADD_VALIGN: alignment
+   mask, MULADD_VLOAD/MULADD_VLOADA: unaligned/aligned loads,
+   MULADD_VSTORE/MULADD_VSTOREA: unaligned/aligned stores, MULADD_VSET1,
+   MULADD_VMUL, MULADD_VADD, MULADD_VSUB, MULADD_VDIV and MULADD_VCLIP,
+   the vector version of muladd_clip(). */
+
+#define MULADD_ALIGNED(p) ((((uintptr_t)(p)) & MULADD_VALIGN) == 0)
+
+#define MULADD_VLOOP(aligned, EXPR) \
+    if (aligned) \
+    { \
+        for (; i <= size - MULADD_VWIDTH; i += MULADD_VWIDTH) \
+            MULADD_VSTOREA(data + i, EXPR(MULADD_VLOADA)); \
+    } \
+    else \
+    { \
+        for (; i <= size - MULADD_VWIDTH; i += MULADD_VWIDTH) \
+            MULADD_VSTORE(data + i, EXPR(MULADD_VLOAD)); \
+    }
+
+#define MULADD_E_II(L) MULADD_VADD(MULADD_VMUL(vmul, L(data + i)), vadd)
+#define MULADD_E_COPY(L) MULADD_VADD(MULADD_VMUL(vmul, L(src + i)), vadd)
+#define MULADD_E_AI(L) MULADD_VADD(MULADD_VMUL(L(mul + i), L(data + i)), vadd)
+#define MULADD_E_IA(L) MULADD_VADD(MULADD_VMUL(vmul, L(data + i)), L(add + i))
+#define MULADD_E_AA(L) MULADD_VADD(MULADD_VMUL(L(mul + i), L(data + i)), L(add + i))
+#define MULADD_E_IREVA(L) MULADD_VSUB(MULADD_VMUL(vmul, L(data + i)), L(add + i))
+#define MULADD_E_AREVA(L) MULADD_VSUB(MULADD_VMUL(L(mul + i), L(data + i)), L(add + i))
+#define MULADD_E_REVAI(L) MULADD_VADD(MULADD_VDIV(L(data + i), MULADD_VCLIP(L(mul + i))), vadd)
+#define MULADD_E_REVAA(L) MULADD_VADD(MULADD_VDIV(L(data + i), MULADD_VCLIP(L(mul + i))), L(add + i))
+#define MULADD_E_REVAREVA(L) MULADD_VSUB(MULADD_VDIV(L(data + i), MULADD_VCLIP(L(mul + i))), L(add + i))
+
+#define MULADD_VKERNELS(isa) \
+MULADD_VATTR static void \
+muladd_ii_##isa(MYFLT *PYO_RESTRICT data, MYFLT mul, MYFLT add, int size) \
+{ \
+    int i = 0; \
+    MULADD_VTYPE vmul = MULADD_VSET1(mul), vadd = MULADD_VSET1(add); \
+    MULADD_VLOOP(MULADD_ALIGNED(data), MULADD_E_II) \
+    for (; i < size; i++) \
+        data[i] = mul * data[i] + add; \
+} \
+ \
+MULADD_VATTR static void \
+muladd_copy_##isa(MYFLT *PYO_RESTRICT data, const MYFLT *PYO_RESTRICT src, MYFLT mul, MYFLT add, int size) \
+{ \
+    int i = 0; \
+    MULADD_VTYPE vmul = MULADD_VSET1(mul), vadd = MULADD_VSET1(add); \
+    MULADD_VLOOP(MULADD_ALIGNED(data) && MULADD_ALIGNED(src), MULADD_E_COPY) \
+    for (; i < size; i++) \
+        data[i] = mul * src[i] + add; \
+} \
+ \
+MULADD_VATTR static void \
+muladd_ai_##isa(MYFLT *PYO_RESTRICT data, const MYFLT *PYO_RESTRICT mul, MYFLT add, int size) \
+{ \
+    int i = 0; \
+    MULADD_VTYPE vadd = MULADD_VSET1(add); \
+    MULADD_VLOOP(MULADD_ALIGNED(data) && MULADD_ALIGNED(mul), MULADD_E_AI) \
+    for (; i < size; i++) \
+        data[i] = mul[i] * data[i] + add; \
+} \
+ \
+MULADD_VATTR static void \
+muladd_ia_##isa(MYFLT *PYO_RESTRICT data, MYFLT mul, const MYFLT *PYO_RESTRICT add, int size) \
+{ \
+    int i = 0; \
+    MULADD_VTYPE vmul = MULADD_VSET1(mul); \
+    MULADD_VLOOP(MULADD_ALIGNED(data) && MULADD_ALIGNED(add), MULADD_E_IA) \
+    for (; i < size; i++) \
+        data[i] = mul * data[i] + add[i]; \
+} \
+ \
+MULADD_VATTR static void \
+muladd_aa_##isa(MYFLT *PYO_RESTRICT data, const MYFLT *PYO_RESTRICT mul, const MYFLT *PYO_RESTRICT add, int size) \
+{ \
+    int i = 0; \
+    MULADD_VLOOP(MULADD_ALIGNED(data) && MULADD_ALIGNED(mul) && MULADD_ALIGNED(add), MULADD_E_AA) \
+    for (; i < size; i++) \
+        data[i] = mul[i] * data[i] + add[i]; \
+} \
+ \
+MULADD_VATTR static void \
+muladd_ireva_##isa(MYFLT *PYO_RESTRICT data, MYFLT mul, const MYFLT *PYO_RESTRICT add, int size) \
+{ \
+    int i = 0; \
+    MULADD_VTYPE vmul = MULADD_VSET1(mul); \
+    MULADD_VLOOP(MULADD_ALIGNED(data) && MULADD_ALIGNED(add), MULADD_E_IREVA) \
+    for (; i < size; i++) \
+        data[i] = mul * data[i] - add[i]; \
+} \
+ \
+MULADD_VATTR static void \
+muladd_areva_##isa(MYFLT *PYO_RESTRICT data, const MYFLT *PYO_RESTRICT mul, const MYFLT *PYO_RESTRICT add, int size) \
+{ \
+    int i = 0; \
+    MULADD_VLOOP(MULADD_ALIGNED(data) && MULADD_ALIGNED(mul) && MULADD_ALIGNED(add), MULADD_E_AREVA) \
+    for (; i < size; i++) \
+        data[i] = mul[i] * data[i] - add[i]; \
+} \
+ \
+MULADD_VATTR static void \
+muladd_revai_##isa(MYFLT *PYO_RESTRICT data, const MYFLT *PYO_RESTRICT mul, MYFLT add, int size) \
+{ \
+    int i = 0; \
+    MULADD_VTYPE vadd = MULADD_VSET1(add); \
+    MULADD_VLOOP(MULADD_ALIGNED(data) && MULADD_ALIGNED(mul), MULADD_E_REVAI) \
+    for (; i < size; i++) \
+        data[i] = data[i] / muladd_clip(mul[i]) + add; \
+} \
+ \
+MULADD_VATTR static void \
+muladd_revaa_##isa(MYFLT *PYO_RESTRICT data, const MYFLT *PYO_RESTRICT mul, const MYFLT *PYO_RESTRICT add, int size) \
+{ \
+    int i = 0; \
+    MULADD_VLOOP(MULADD_ALIGNED(data) && MULADD_ALIGNED(mul) && MULADD_ALIGNED(add), MULADD_E_REVAA) \
+    for (; i < size; i++) \
+        data[i] = data[i] / muladd_clip(mul[i]) + add[i]; \
+} \
+ \
+MULADD_VATTR static void \
+muladd_revareva_##isa(MYFLT *PYO_RESTRICT data, const MYFLT *PYO_RESTRICT mul, const MYFLT *PYO_RESTRICT add, int size) \
+{ \
+    int i = 0; \
+    MULADD_VLOOP(MULADD_ALIGNED(data) && MULADD_ALIGNED(mul) && MULADD_ALIGNED(add), MULADD_E_REVAREVA) \
+    for (; i < size; i++) \
+        data[i] = data[i] / muladd_clip(mul[i]) - add[i]; \
+}
+
+#ifdef MULADD_X86
+
+/* SSE kernels. The float comparisons of the clip use <= and >= with the
+   float epsilon to select the same values as the double comparisons of
+   muladd_clip(). */
+
+#ifndef USE_DOUBLE
+
+__attribute__((target("sse2"))) static inline __m128
+muladd_clip_sse(__m128 x)
+{
+    __m128 eps = _mm_set1_ps(MULADD_EPSILON), neps = _mm_set1_ps(-MULADD_EPSILON);
+    __m128 m = _mm_and_ps(_mm_cmple_ps(x, eps), _mm_cmpge_ps(x, neps));
+    return _mm_or_ps(_mm_and_ps(m, eps), _mm_andnot_ps(m, x));
+}
+
+#define MULADD_VTYPE __m128
+#define MULADD_VWIDTH 4
+#define MULADD_VLOAD _mm_loadu_ps
+#define MULADD_VLOADA _mm_load_ps
+#define MULADD_VSTORE _mm_storeu_ps
+#define MULADD_VSTOREA _mm_store_ps
+#define MULADD_VSET1 _mm_set1_ps
+#define MULADD_VMUL _mm_mul_ps
+#define MULADD_VADD _mm_add_ps
+#define MULADD_VSUB _mm_sub_ps
+#define MULADD_VDIV _mm_div_ps
+
+#else
+
+__attribute__((target("sse2"))) static inline __m128d
+muladd_clip_sse(__m128d x)
+{
+    __m128d eps = _mm_set1_pd(MULADD_EPSILON), neps = _mm_set1_pd(-MULADD_EPSILON);
+    __m128d m = _mm_and_pd(_mm_cmplt_pd(x, eps), _mm_cmpgt_pd(x, neps));
+    return _mm_or_pd(_mm_and_pd(m, eps), _mm_andnot_pd(m, x));
+}
+
+#define MULADD_VTYPE __m128d
+#define MULADD_VWIDTH 2
+#define MULADD_VLOAD _mm_loadu_pd
+#define MULADD_VLOADA _mm_load_pd
+#define MULADD_VSTORE _mm_storeu_pd
+#define MULADD_VSTOREA _mm_store_pd
+#define MULADD_VSET1 _mm_set1_pd
+#define MULADD_VMUL _mm_mul_pd
+#define MULADD_VADD _mm_add_pd
+#define MULADD_VSUB _mm_sub_pd
+#define MULADD_VDIV _mm_div_pd
+
+#endif
+
+#define MULADD_VATTR __attribute__((target("sse2")))
+#define MULADD_VALIGN 15
+#define MULADD_VCLIP muladd_clip_sse
+
+MULADD_VKERNELS(sse)
+
+#undef MULADD_VATTR
+#undef MULADD_VTYPE
+#undef MULADD_VWIDTH
+#undef MULADD_VALIGN
+#undef MULADD_VLOAD
+#undef MULADD_VLOADA
+#undef MULADD_VSTORE
+#undef MULADD_VSTOREA
+#undef MULADD_VSET1
+#undef MULADD_VMUL
+#undef MULADD_VADD
+#undef MULADD_VSUB
+#undef MULADD_VDIV
+#undef MULADD_VCLIP
+
+/* AVX kernels. */
+
+#ifndef USE_DOUBLE
+
+__attribute__((target("avx"))) static inline __m256
+muladd_clip_avx(__m256 x)
+{
+    __m256 eps = _mm256_set1_ps(MULADD_EPSILON), neps = _mm256_set1_ps(-MULADD_EPSILON);
+    __m256 m = _mm256_and_ps(_mm256_cmp_ps(x, eps, _CMP_LE_OQ), _mm256_cmp_ps(x, neps, _CMP_GE_OQ));
+    return _mm256_blendv_ps(x, eps, m);
+}
+
+#define MULADD_VTYPE __m256
+#define MULADD_VWIDTH 8
+#define MULADD_VLOAD _mm256_loadu_ps
+#define MULADD_VLOADA _mm256_load_ps
+#define MULADD_VSTORE _mm256_storeu_ps
+#define MULADD_VSTOREA _mm256_store_ps
+#define MULADD_VSET1 _mm256_set1_ps
+#define MULADD_VMUL _mm256_mul_ps
+#define MULADD_VADD _mm256_add_ps
+#define MULADD_VSUB _mm256_sub_ps
+#define MULADD_VDIV _mm256_div_ps
+
+#else
+
+__attribute__((target("avx"))) static inline __m256d
+muladd_clip_avx(__m256d x)
+{
+    __m256d eps = _mm256_set1_pd(MULADD_EPSILON), neps = _mm256_set1_pd(-MULADD_EPSILON);
+    __m256d m = _mm256_and_pd(_mm256_cmp_pd(x, eps, _CMP_LT_OQ), _mm256_cmp_pd(x, neps, _CMP_GT_OQ));
+    return _mm256_blendv_pd(x, eps, m);
+}
+
+#define MULADD_VTYPE __m256d
+#define MULADD_VWIDTH 4
+#define MULADD_VLOAD _mm256_loadu_pd
+#define MULADD_VLOADA _mm256_load_pd
+#define MULADD_VSTORE _mm256_storeu_pd
+#define MULADD_VSTOREA _mm256_store_pd
+#define MULADD_VSET1 _mm256_set1_pd
+#define MULADD_VMUL _mm256_mul_pd
+#define MULADD_VADD _mm256_add_pd
+#define MULADD_VSUB _mm256_sub_pd
+#define MULADD_VDIV _mm256_div_pd
+
+#endif
+
+#define MULADD_VATTR __attribute__((target("avx")))
+#define MULADD_VALIGN 31
+#define MULADD_VCLIP muladd_clip_avx
+
+MULADD_VKERNELS(avx)
+
+#endif // MULADD_X86
+
+#ifdef MULADD_NEON
+
+/* NEON kernels. Loads and stores don't depend on the alignment. The
+   multiply and the add stay separate instructions, as in the SSE and AVX
+   kernels, so a compiler contracting the scalar loops into fused
+   multiply-adds makes them differ by one rounding. */
+
+#ifndef USE_DOUBLE
+
+static inline float32x4_t
+muladd_clip_neon(float32x4_t x)
+{
+    float32x4_t eps = vdupq_n_f32(MULADD_EPSILON);
+    uint32x4_t m = vandq_u32(vcleq_f32(x, eps), vcgeq_f32(x, vnegq_f32(eps)));
+    return vbslq_f32(m, eps, x);
+}
+
+#define MULADD_VTYPE float32x4_t
+#define MULADD_VWIDTH 4
+#define MULADD_VLOAD vld1q_f32
+#define MULADD_VSTORE vst1q_f32
+#define MULADD_VSET1 vdupq_n_f32
+#define MULADD_VMUL vmulq_f32
+#define MULADD_VADD vaddq_f32
+#define MULADD_VSUB vsubq_f32
+#define MULADD_VDIV vdivq_f32
+
+#else
+
+static inline float64x2_t
+muladd_clip_neon(float64x2_t x)
+{
+    float64x2_t eps = vdupq_n_f64(MULADD_EPSILON);
+    uint64x2_t m = vandq_u64(vcltq_f64(x, eps), vcgtq_f64(x, vnegq_f64(eps)));
+    return vbslq_f64(m, eps, x);
+}
+
+#define MULADD_VTYPE float64x2_t
+#define MULADD_VWIDTH 2
+#define MULADD_VLOAD vld1q_f64
+#define MULADD_VSTORE vst1q_f64
+#define MULADD_VSET1 vdupq_n_f64
+#define MULADD_VMUL vmulq_f64
+#define MULADD_VADD vaddq_f64
+#define MULADD_VSUB vsubq_f64
+#define MULADD_VDIV vdivq_f64
+
+#endif
+
+#define MULADD_VATTR
+#define MULADD_VALIGN 0
+#define MULADD_VLOADA MULADD_VLOAD
+#define MULADD_VSTOREA MULADD_VSTORE
+#define MULADD_VCLIP muladd_clip_neon
+
+MULADD_VKERNELS(neon)
+
+#endif // MULADD_NEON
+
+void (*muladd_ii)(MYFLT *PYO_RESTRICT data, MYFLT mul, MYFLT add, int size) = muladd_ii_c;
+void (*muladd_copy)(MYFLT *PYO_RESTRICT data, const MYFLT *PYO_RESTRICT src, MYFLT mul, MYFLT add, int size) = muladd_copy_c;
+void (*muladd_ai)(MYFLT *PYO_RESTRICT data, const MYFLT *PYO_RESTRICT mul, MYFLT add, int size) = muladd_ai_c;
+void (*muladd_ia)(MYFLT *PYO_RESTRICT data, MYFLT mul, const MYFLT *PYO_RESTRICT add, int size) = muladd_ia_c;
+void (*muladd_aa)(MYFLT *PYO_RESTRICT data, const MYFLT *PYO_RESTRICT mul, const MYFLT *PYO_RESTRICT add, int size) = muladd_aa_c;
+void (*muladd_ireva)(MYFLT *PYO_RESTRICT data, MYFLT mul, const MYFLT *PYO_RESTRICT add, int size) = muladd_ireva_c;
+void (*muladd_areva)(MYFLT *PYO_RESTRICT data, const MYFLT *PYO_RESTRICT mul, const MYFLT *PYO_RESTRICT add, int size) = muladd_areva_c;
+void (*muladd_revai)(MYFLT *PYO_RESTRICT data, const MYFLT *PYO_RESTRICT mul, MYFLT add, int size) = muladd_revai_c;
+void (*muladd_revaa)(MYFLT *PYO_RESTRICT data, const MYFLT *PYO_RESTRICT mul, const MYFLT *PYO_RESTRICT add, int size) = muladd_revaa_c;
+void (*muladd_revareva)(MYFLT *PYO_RESTRICT data, const MYFLT *PYO_RESTRICT mul, const MYFLT *PYO_RESTRICT add, int size) = muladd_revareva_c;
+
+static const char *muladd_kernels = "scalar";
+
+#define MULADD_SET_KERNELS(isa) \
+    muladd_ii = muladd_ii_##isa; \
+    muladd_copy = muladd_copy_##isa; \
+    muladd_ai = muladd_ai_##isa; \
+    muladd_ia = muladd_ia_##isa; \
+    muladd_aa = muladd_aa_##isa; \
+    muladd_ireva = muladd_ireva_##isa; \
+    muladd_areva = muladd_areva_##isa; \
+    muladd_revai = muladd_revai_##isa; \
+    muladd_revaa = muladd_revaa_##isa; \
+    muladd_revareva = muladd_revareva_##isa; \
+    muladd_kernels = #isa;
+
+void
+muladd_init(void)
+{
+#if defined(MULADD_X86)
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx"))
+    {
+        MULADD_SET_KERNELS(avx)
+    }
+    else if (__builtin_cpu_supports("sse2"))
+    {
+        MULADD_SET_KERNELS(sse)
+    }
+
+#elif defined(MULADD_NEON)
+    MULADD_SET_KERNELS(neon)
+#endif
+}
+
+const char *
+muladd_name(void)
+{
+    return muladd_kernels;
+}
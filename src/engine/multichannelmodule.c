@@ -0,0 +1,662 @@
+/**************************************************************************
+ * Copyright 2009-2015 Olivier Belanger                                   *
+ *                                                                        *
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *
+ *                                                                        *
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with pyo.  If not, see <http://www.gnu.org/licenses/>.   *
+ *************************************************************************/
+
+#include <Python.h>
+#include "structmember.h"
+#include <string.h>
+#include "pyomodule.h"
+#include "streammodule.h"
+#include "servermodule.h"
+#include "dummymodule.h"
+#include "multichannel.h"
+#include "muladd.h"
+
+/* Attributes given per channel. */
+
+int
+MultiParam_set(MultiParam *self, PyObject *arg, int chnls, PyObject *server)
+{
+    int i, audio = 0;
+    Py_ssize_t lsize;
+    MYFLT *values;
+    Stream **streams;
+    PyObject *list, *oldlist, *item, *streamtmp;
+
+    if (PyList_Check(arg))
+    {
+        lsize = PyList_Size(arg);
+
+        if (lsize < 1)
+        {
+            PyErr_SetString(PyExc_ValueError, "multichannel attribute: the list of values is empty.");
+            return -1;
+        }
+    }
+    else
+        lsize = 0;
+
+    list = PyList_New(chnls);
+
+    if (list == NULL)
+        return -1;
+
+    for (i = 0; i < chnls; i++)
+    {
+        item = lsize ? PyList_GET_ITEM(arg, i % lsize) : arg;
+
+        if (! PyNumber_Check(item) && ! PyObject_HasAttrString(item, "_getStream"))
+        {
+            PyErr_SetString(PyExc_TypeError, "multichannel attribute: values must be floats or audio objects.");
+            Py_DECREF(list);
+            return -1;
+        }
+
+        Py_INCREF(item);
+        PyList_SET_ITEM(list, i, item);
+    }
+
+    /* The new values are gathered first, then copied under the lock of the
+       streams, the audio thread can be reading the arrays. */
+    values = (MYFLT *)PyMem_RawCalloc(chnls, sizeof(MYFLT));
+    streams = (Stream **)PyMem_RawCalloc(chnls, sizeof(Stream *));
+
+    for (i = 0; i < chnls; i++)
+    {
+        item = PyList_GET_ITEM(list, i);
+
+        if (PyNumber_Check(item))
+        {
+            values[i] = PyFloat_AsDouble(item);
+        }
+        else
+        {
+            /* Borrowed, the stream lives as long as its object held by `list`. */
+            streamtmp = PyObject_CallMethod(item, "_getStream", NULL);
+
+            if (streamtmp == NULL)
+            {
+                PyMem_RawFree(values);
+                PyMem_RawFree(streams);
+                Py_DECREF(list);
+                return -1;
+            }
+
+            streams[i] = (Stream *)streamtmp;
+            Py_DECREF(streamtmp);
+            audio++;
+        }
+    }
+
+    Server_lockProcessing(server);
+
+    /* The arrays are sized once, then only updated. */
+    if (self->values == NULL)
+    {
+        self->values = values;
+        self->streams = streams;
+        values = NULL;
+        streams = NULL;
+    }
+    else
+    {
+        memcpy(self->values, values, chnls * sizeof(MYFLT));
+        memcpy(self->streams, streams, chnls * sizeof(Stream *));
+    }
+
+    self->audio = audio;
+    oldlist = self->list;
+    self->list = list;
+
+    Stream_invalidateGraph();
+
+    Server_unlockProcessing(server);
+
+    PyMem_RawFree(values);
+    PyMem_RawFree(streams);
+    Py_XDECREF(oldlist);
+
+    return 0;
+}
+
+int
+MultiParam_setArgs(MultiParam *self, PyObject *args, int chnls, PyObject *server)
+{
+    int chnl = -1, err;
+    PyObject *arg, *list;
+
+    if (! PyArg_ParseTuple(args, "O|i", &arg, &chnl))
+        return -1;
+
+    if (chnl < 0)
+        return MultiParam_set(self, arg, chnls, server);
+
+    if (chnl >= chnls)
+    {
+        PyErr_SetString(PyExc_ValueError, "multichannel attribute: channel out of range.");
+        return -1;
+    }
+
+    /* The other channels keep their values. */
+    list = PyList_GetSlice(self->list, 0, chnls);
+
+    if (list == NULL)
+        return -1;
+
+    Py_INCREF(arg);
+    PyList_SetItem(list, chnl, arg);
+    err = MultiParam_set(self, list, chnls, server);
+    Py_DECREF(list);
+
+    return err;
+}
+
+int
+MultiParam_isFloat(MultiParam *self, int first, int lanes)
+{
+    int i;
+
+    if (self->audio == 0)
+        return 1;
+
+    for (i = first; i < first + lanes; i++)
+    {
+        if (self->streams[i] != NULL)
+            return 0;
+    }
+
+    return 1;
+}
+
+void
+MultiParam_free(MultiParam *self)
+{
+    PyMem_RawFree(self->values);
+    PyMem_RawFree(self->streams);
+    self->values = NULL;
+    self->streams = NULL;
+}
+
+int
+Multi_setInts(int *values, PyObject *arg, int chnls)
+{
+    int i;
+    Py_ssize_t lsize = PyList_Check(arg) ? PyList_Size(arg) : 0;
+    PyObject *item;
+
+    if (PyList_Check(arg) && lsize < 1)
+    {
+        PyErr_SetString(PyExc_ValueError, "multichannel attribute: the list of values is empty.");
+        return -1;
+    }
+
+    for (i = 0; i < (lsize ? lsize : 1); i++)
+    {
+        item = lsize ? PyList_GET_ITEM(arg, i) : arg;
+
+        if (! PyLong_Check(item))
+        {
+            PyErr_SetString(PyExc_TypeError, "multichannel attribute: values must be integers.");
+            return -1;
+        }
+    }
+
+    for (i = 0; i < chnls; i++)
+    {
+        item = lsize ? PyList_GET_ITEM(arg, i % lsize) : arg;
+        values[i] = (int)PyLong_AsLong(item);
+    }
+
+    return 0;
+}
+
+int
+Multi_setIntsArgs(int *values, PyObject *args, int chnls)
+{
+    int chnl = -1;
+    PyObject *arg;
+
+    if (! PyArg_ParseTuple(args, "O|i", &arg, &chnl))
+        return -1;
+
+    if (chnl < 0)
+        return Multi_setInts(values, arg, chnls);
+
+    if (chnl >= chnls)
+    {
+        PyErr_SetString(PyExc_ValueError, "multichannel attribute: channel out of range.");
+        return -1;
+    }
+
+    if (! PyLong_Check(arg))
+    {
+        PyErr_SetString(PyExc_TypeError, "multichannel attribute: values must be integers.");
+        return -1;
+    }
+
+    values[chnl] = (int)PyLong_AsLong(arg);
+
+    return 0;
+}
+
+int
+MultiObject_allocBuffer(MultiObject *self)
+{
+    int err;
+    PyObject *one;
+
+    self->buffer_streams = (MYFLT *)arena_alloc(self->chnls * self->bufsize * sizeof(MYFLT));
+
+    if (self->buffer_streams == NULL)
+        return -1;
+
+    memset(self->buffer_streams, 0, self->chnls * self->bufsize * sizeof(MYFLT));
+
+    one = PyFloat_FromDouble(1.0);
+    err = MultiParam_set(&self->muls, one, self->chnls, self->server);
+    Py_DECREF(one);
+
+    return err;
+}
+
+void
+MultiObject_freeBuffer(MultiObject *self)
+{
+    arena_free(self->buffer_streams);
+    self->buffer_streams = NULL;
+    MultiParam_free(&self->muls);
+}
+
+int
+MultiObject_isMuted(MultiObject *self, int first, int lanes)
+{
+    int i;
+
+    for (i = first; i < first + lanes; i++)
+    {
+        if (self->muls.streams[i] != NULL)
+        {
+            if (Stream_getState(self->muls.streams[i]) != PYO_STREAM_SILENT)
+                return 0;
+        }
+        else if (self->muls.values[i] != 0)
+            return 0;
+    }
+
+    return 1;
+}
+
+/************************************************************************************************/
+/* MultiChannel streamer object, one channel of a multichannel object */
+/************************************************************************************************/
+typedef struct
+{
+    pyo_audio_HEAD
+    MultiObject *mainObject;
+    int modebuffer[2];
+    int chnl;
+} MultiChannel;
+
+static void MultiChannel_postprocessing_ii(MultiChannel *self) { POST_PROCESSING_II };
+static void MultiChannel_postprocessing_ai(MultiChannel *self) { POST_PROCESSING_AI };
+static void MultiChannel_postprocessing_ia(MultiChannel *self) { POST_PROCESSING_IA };
+static void MultiChannel_postprocessing_aa(MultiChannel *self) { POST_PROCESSING_AA };
+static void MultiChannel_postprocessing_ireva(MultiChannel *self) { POST_PROCESSING_IREVA };
+static void MultiChannel_postprocessing_areva(MultiChannel *self) { POST_PROCESSING_AREVA };
+static void MultiChannel_postprocessing_revai(MultiChannel *self) { POST_PROCESSING_REVAI };
+static void MultiChannel_postprocessing_revaa(MultiChannel *self) { POST_PROCESSING_REVAA };
+static void MultiChannel_postprocessing_revareva(MultiChannel *self) { POST_PROCESSING_REVAREVA };
+
+static void
+MultiChannel_setProcMode(MultiChannel *self)
+{
+    int muladdmode;
+    muladdmode = self->modebuffer[0] + self->modebuffer[1] * 10;
+
+    switch (muladdmode)
+    {
+        case 0:
+            self->muladd_func_ptr = MultiChannel_postprocessing_ii;
+            break;
+
+        case 1:
+            self->muladd_func_ptr = MultiChannel_postprocessing_ai;
+            break;
+
+        case 2:
+            self->muladd_func_ptr = MultiChannel_postprocessing_revai;
+            break;
+
+        case 10:
+            self->muladd_func_ptr = MultiChannel_postprocessing_ia;
+            break;
+
+        case 11:
+            self->muladd_func_ptr = MultiChannel_postprocessing_aa;
+            break;
+
+        case 12:
+            self->muladd_func_ptr = MultiChannel_postprocessing_revaa;
+            break;
+
+        case 20:
+            self->muladd_func_ptr = MultiChannel_postprocessing_ireva;
+            break;
+
+        case 21:
+            self->muladd_func_ptr = MultiChannel_postprocessing_areva;
+            break;
+
+        case 22:
+            self->muladd_func_ptr = MultiChannel_postprocessing_revareva;
+            break;
+    }
+}
+
+static void
+MultiChannel_compute_next_data_frame(MultiChannel *self)
+{
+    MYFLT mul, add;
+    MYFLT *in = self->mainObject->buffer_streams + self->chnl * self->bufsize;
+
+    /* Float mul & add, applied while copying the channel. */
+    if (self->modebuffer[0] == 0 && self->modebuffer[1] == 0)
+    {
+        mul = PyFloat_AS_DOUBLE(self->mul);
+        add = PyFloat_AS_DOUBLE(self->add);
+
+        if (mul == 1 && add == 0)
+        {
+            memcpy(self->data, in, self->bufsize * sizeof(MYFLT));
+            return;
+        }
+        else if (mul != 0)
+        {
+            muladd_copy(self->data, in, mul, add, self->bufsize);
+            return;
+        }
+    }
+    /* The channel, not computed while muted, is not read. */
+    else if (! MULADD_MUTED)
+        memcpy(self->data, in, self->bufsize * sizeof(MYFLT));
+
+    (*self->muladd_func_ptr)(self);
+}
+
+static int
+MultiChannel_traverse(MultiChannel *self, visitproc visit, void *arg)
+{
+    pyo_VISIT
+    Py_VISIT(self->mainObject);
+    return 0;
+}
+
+static int
+MultiChannel_clear(MultiChannel *self)
+{
+    pyo_CLEAR
+    Py_CLEAR(self->mainObject);
+    return 0;
+}
+
+static void
+MultiChannel_dealloc(MultiChannel* self)
+{
+    pyo_DEALLOC
+    MultiChannel_clear(self);
+    Py_TYPE(self->stream)->tp_free((PyObject*)self->stream);
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static PyObject *
+MultiChannel_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    int i;
+    PyObject *maintmp = NULL, *multmp = NULL, *addtmp = NULL;
+    MultiChannel *self;
+    self = (MultiChannel *)type->tp_alloc(type, 0);
+
+    self->modebuffer[0] = 0;
+    self->modebuffer[1] = 0;
+
+    INIT_OBJECT_COMMON
+    Stream_setFunctionPtr(self->stream, MultiChannel_compute_next_data_frame);
+    Stream_setShareable(self->stream, 1);
+    self->mode_func_ptr = MultiChannel_setProcMode;
+
+    static char *kwlist[] = {"mainObject", "chnl", "mul", "add", NULL};
+
+    if (! PyArg_ParseTupleAndKeywords(args, kwds, "Oi|OO", kwlist, &maintmp, &self->chnl, &multmp, &addtmp))
+        Py_RETURN_NONE;
+
+    if (self->chnl < 0 || self->chnl >= ((MultiObject *)maintmp)->chnls)
+    {
+        PyErr_SetString(PyExc_ValueError, "MultiChannel: channel out of range.");
+        return NULL;
+    }
+
+    self->mainObject = (MultiObject *)maintmp;
+    Py_INCREF(self->mainObject);
+
+    if (multmp)
+    {
+        PyObject_CallMethod((PyObject *)self, "setMul", "O", multmp);
+    }
+
+    if (addtmp)
+    {
+        PyObject_CallMethod((PyObject *)self, "setAdd", "O", addtmp);
+    }
+
+    PyObject_CallMethod(self->server, "addStream", "O", self->stream);
+
+    (*self->mode_func_ptr)(self);
+
+    return (PyObject *)self;
+}
+
+static PyObject * MultiChannel_getServer(MultiChannel* self) { GET_SERVER };
+static PyObject * MultiChannel_getStream(MultiChannel* self) { GET_STREAM };
+static PyObject * MultiChannel_setMulValue(MultiChannel *self, PyObject *arg) { SET_MUL };
+static PyObject * MultiChannel_setAdd(MultiChannel *self, PyObject *arg) { SET_ADD };
+static PyObject * MultiChannel_setSub(MultiChannel *self, PyObject *arg) { SET_SUB };
+static PyObject * MultiChannel_setDivValue(MultiChannel *self, PyObject *arg) { SET_DIV };
+
+/* Gives the mul of the channel to the multichannel object, 1 for a division
+   (never muted). `ret` is the result of the setter. */
+static PyObject *
+MultiChannel_updateMul(MultiChannel *self, PyObject *ret)
+{
+    int err;
+    PyObject *args;
+
+    if (ret == NULL)
+        return NULL;
+
+    if (self->modebuffer[0] == 2)
+        args = Py_BuildValue("(di)", 1.0, self->chnl);
+    else
+        args = Py_BuildValue("(Oi)", self->mul, self->chnl);
+
+    err = MultiParam_setArgs(&self->mainObject->muls, args, self->mainObject->chnls, self->server);
+    Py_DECREF(args);
+
+    if (err < 0)
+    {
+        Py_DECREF(ret);
+        return NULL;
+    }
+
+    return ret;
+}
+
+static PyObject *
+MultiChannel_setMul(MultiChannel *self, PyObject *arg)
+{
+    return MultiChannel_updateMul(self, MultiChannel_setMulValue(self, arg));
+}
+
+static PyObject *
+MultiChannel_setDiv(MultiChannel *self, PyObject *arg)
+{
+    return MultiChannel_updateMul(self, MultiChannel_setDivValue(self, arg));
+}
+
+/* Setters of the channel, forwarded to the multichannel object. */
+static PyObject *
+MultiChannel_forward(MultiChannel *self, const char *name, PyObject *arg)
+{
+    if (arg == NULL)
+        return PyObject_CallMethod((PyObject *)self->mainObject, name, "i", self->chnl);
+
+    return PyObject_CallMethod((PyObject *)self->mainObject, name, "Oi", arg, self->chnl);
+}
+
+static PyObject * MultiChannel_setFreq(MultiChannel *self, PyObject *arg) { return MultiChannel_forward(self, "setFreq", arg); };
+static PyObject * MultiChannel_setPhase(MultiChannel *self, PyObject *arg) { return MultiChannel_forward(self, "setPhase", arg); };
+static PyObject * MultiChannel_setQ(MultiChannel *self, PyObject *arg) { return MultiChannel_forward(self, "setQ", arg); };
+static PyObject * MultiChannel_setBoost(MultiChannel *self, PyObject *arg) { return MultiChannel_forward(self, "setBoost", arg); };
+static PyObject * MultiChannel_setType(MultiChannel *self, PyObject *arg) { return MultiChannel_forward(self, "setType", arg); };
+static PyObject * MultiChannel_setStages(MultiChannel *self, PyObject *arg) { return MultiChannel_forward(self, "setStages", arg); };
+static PyObject * MultiChannel_setCoeffRate(MultiChannel *self, PyObject *arg) { return MultiChannel_forward(self, "setCoeffRate", arg); };
+static PyObject * MultiChannel_reset(MultiChannel *self) { return MultiChannel_forward(self, "reset", NULL); };
+
+static PyObject * MultiChannel_play(MultiChannel *self, PyObject *args, PyObject *kwds) { PLAY };
+static PyObject * MultiChannel_out(MultiChannel *self, PyObject *args, PyObject *kwds) { OUT };
+static PyObject * MultiChannel_stop(MultiChannel *self, PyObject *args, PyObject *kwds) { STOP };
+
+static PyObject * MultiChannel_multiply(MultiChannel *self, PyObject *arg) { MULTIPLY };
+static PyObject * MultiChannel_inplace_multiply(MultiChannel *self, PyObject *arg) { INPLACE_MULTIPLY };
+static PyObject * MultiChannel_add(MultiChannel *self, PyObject *arg) { ADD };
+static PyObject * MultiChannel_inplace_add(MultiChannel *self, PyObject *arg) { INPLACE_ADD };
+static PyObject * MultiChannel_sub(MultiChannel *self, PyObject *arg) { SUB };
+static PyObject * MultiChannel_inplace_sub(MultiChannel *self, PyObject *arg) { INPLACE_SUB };
+static PyObject * MultiChannel_div(MultiChannel *self, PyObject *arg) { DIV };
+static PyObject * MultiChannel_inplace_div(MultiChannel *self, PyObject *arg) { INPLACE_DIV };
+
+static PyMemberDef MultiChannel_members[] =
+{
+    {"server", T_OBJECT_EX, offsetof(MultiChannel, server), 0, "Pyo server."},
+    {"stream", T_OBJECT_EX, offsetof(MultiChannel, stream), 0, "Stream object."},
+    {"mul", T_OBJECT_EX, offsetof(MultiChannel, mul), 0, "Mul factor."},
+    {"add", T_OBJECT_EX, offsetof(MultiChannel, add), 0, "Add factor."},
+    {NULL}  /* Sentinel */
+};
+
+static PyMethodDef MultiChannel_methods[] =
+{
+    {"getServer", (PyCFunction)MultiChannel_getServer, METH_NOARGS, "Returns server object."},
+    {"_getStream", (PyCFunction)MultiChannel_getStream, METH_NOARGS, "Returns stream object."},
+    {"play", (PyCFunction)MultiChannel_play, METH_VARARGS | METH_KEYWORDS, "Starts computing without sending sound to soundcard."},
+    {"out", (PyCFunction)MultiChannel_out, METH_VARARGS | METH_KEYWORDS, "Starts computing and sends sound to soundcard channel speficied by argument."},
+    {"stop", (PyCFunction)MultiChannel_stop, METH_VARARGS | METH_KEYWORDS, "Stops computing."},
+    {"setMul", (PyCFunction)MultiChannel_setMul, METH_O, "Sets MultiChannel mul factor."},
+    {"setAdd", (PyCFunction)MultiChannel_setAdd, METH_O, "Sets MultiChannel add factor."},
+    {"setSub", (PyCFunction)MultiChannel_setSub, METH_O, "Sets inverse add factor."},
+    {"setDiv", (PyCFunction)MultiChannel_setDiv, METH_O, "Sets inverse mul factor."},
+    {"setFreq", (PyCFunction)MultiChannel_setFreq, METH_O, "Sets the frequency of the channel."},
+    {"setPhase", (PyCFunction)MultiChannel_setPhase, METH_O, "Sets the phase of the channel."},
+    {"setQ", (PyCFunction)MultiChannel_setQ, METH_O, "Sets the Q factor of the channel."},
+    {"setBoost", (PyCFunction)MultiChannel_setBoost, METH_O, "Sets the boost factor of the channel."},
+    {"setType", (PyCFunction)MultiChannel_setType, METH_O, "Sets the filter type of the channel."},
+    {"setStages", (PyCFunction)MultiChannel_setStages, METH_O, "Sets the number of filtering stages of the channel."},
+    {"setCoeffRate", (PyCFunction)MultiChannel_setCoeffRate, METH_O, "Sets the number of samples between two computations of the coefficients of the channel."},
+    {"reset", (PyCFunction)MultiChannel_reset, METH_NOARGS, "Resets the channel."},
+    {NULL}  /* Sentinel */
+};
+
+static PyNumberMethods MultiChannel_as_number =
+{
+    (binaryfunc)MultiChannel_add,                      /*nb_add*/
+    (binaryfunc)MultiChannel_sub,                 /*nb_subtract*/
+    (binaryfunc)MultiChannel_multiply,                 /*nb_multiply*/
+    0,                /*nb_remainder*/
+    0,                   /*nb_divmod*/
+    0,                   /*nb_power*/
+    0,                  /*nb_neg*/
+    0,                /*nb_pos*/
+    0,                  /*(unaryfunc)array_abs,*/
+    0,                    /*nb_nonzero*/
+    0,                    /*nb_invert*/
+    0,               /*nb_lshift*/
+    0,              /*nb_rshift*/
+    0,              /*nb_and*/
+    0,              /*nb_xor*/
+    0,               /*nb_or*/
+    0,                       /*nb_int*/
+    0,                      /*nb_long*/
+    0,                     /*nb_float*/
+    (binaryfunc)MultiChannel_inplace_add,              /*inplace_add*/
+    (binaryfunc)MultiChannel_inplace_sub,         /*inplace_subtract*/
+    (binaryfunc)MultiChannel_inplace_multiply,         /*inplace_multiply*/
+    0,        /*inplace_remainder*/
+    0,           /*inplace_power*/
+    0,       /*inplace_lshift*/
+    0,      /*inplace_rshift*/
+    0,      /*inplace_and*/
+    0,      /*inplace_xor*/
+    0,       /*inplace_or*/
+    0,             /*nb_floor_divide*/
+    (binaryfunc)MultiChannel_div,                       /*nb_true_divide*/
+    0,     /*nb_inplace_floor_divide*/
+    (binaryfunc)MultiChannel_inplace_div,                       /*nb_inplace_true_divide*/
+    0,                     /* nb_index */
+};
+
+PyTypeObject MultiChannelType =
+{
+    PyVarObject_HEAD_INIT(NULL, 0)
+    "_pyo.MultiChannel_base",         /*tp_name*/
+    sizeof(MultiChannel),         /*tp_basicsize*/
+    0,                         /*tp_itemsize*/
+    (destructor)MultiChannel_dealloc, /*tp_dealloc*/
+    0,                         /*tp_print*/
+    0,                         /*tp_getattr*/
+    0,                         /*tp_setattr*/
+    0,                         /*tp_as_async (tp_compare in Python 2)*/
+    0,                         /*tp_repr*/
+    &MultiChannel_as_number,             /*tp_as_number*/
+    0,                         /*tp_as_sequence*/
+    0,                         /*tp_as_mapping*/
+    0,                         /*tp_hash */
+    0,                         /*tp_call*/
+    0,                         /*tp_str*/
+    0,                         /*tp_getattro*/
+    0,                         /*tp_setattro*/
+    0,                         /*tp_as_buffer*/
+    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE | Py_TPFLAGS_HAVE_GC, /*tp_flags*/
+    "MultiChannel objects. Reads one channel from a multichannel object.",           /* tp_doc */
+    (traverseproc)MultiChannel_traverse,   /* tp_traverse */
+    (inquiry)MultiChannel_clear,           /* tp_clear */
+    0,                     /* tp_richcompare */
+    0,                     /* tp_weaklistoffset */
+    0,                     /* tp_iter */
+    0,                     /* tp_iternext */
+    MultiChannel_methods,             /* tp_methods */
+    MultiChannel_members,             /* tp_members */
+    0,                      /* tp_getset */
+    0,                         /* tp_base */
+    0,                         /* tp_dict */
+    0,                         /* tp_descr_get */
+    0,                         /* tp_descr_set */
+    0,                         /* tp_dictoffset */
+    0,      /* tp_init */
+    0,                         /* tp_alloc */
+    MultiChannel_new,                 /* tp_new */
+};
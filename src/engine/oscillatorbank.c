@@ -0,0 +1,348 @@
+/**************************************************************************
+ * Copyright 2009-2015 Olivier Belanger                                   *
+ *                                                                        *
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *
+ *                                                                        *
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with pyo.  If not, see <http://www.gnu.org/licenses/>.   *
+ *************************************************************************/
+
+/* Oscillator bank.
+ *
+ * The oscillators are computed by groups of OSCILLATORBANK_LANES, one
+ * oscillator per lane, over chunks of up to OSCILLATORBANK_CHUNK samples.
+ * Each lane accumulates its oscillators in its own column of a chunk
+ * buffer, then the lanes of each sample are summed, always in the same
+ * order, into the output. The AVX2 kernel reads the table with gathers
+ * and performs the same operations as the scalar kernel. */
+
+#include <Python.h>
+#include <string.h>
+#include <limits.h>
+#include "pyomodule.h"
+#include "oscillatorbank.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define OSCILLATORBANK_X86
+#include <immintrin.h>
+#endif
+
+#ifndef USE_DOUBLE
+#define OSCILLATORBANK_LANES 8
+#else
+#define OSCILLATORBANK_LANES 4
+#endif
+
+#define OSCILLATORBANK_CHUNK 64
+
+typedef void (*oscillatorbank_group_func)(OscillatorBank *self, int first, int lanes, const MYFLT *table,
+                                          T_SIZE_T tablesize, MYFLT *acc, int n);
+
+/* Number of oscillators of each array rounded up to a multiple of 16, so
+   that every array starts on a 64-byte boundary and a group never reads
+   past the end of an array. */
+static int
+OscillatorBank_stride(int size)
+{
+    return (size + 15) & ~15;
+}
+
+int
+OscillatorBank_alloc(OscillatorBank *self, int size)
+{
+    int stride = OscillatorBank_stride(size);
+    MYFLT *memory;
+
+    memory = (MYFLT *)arena_realloc(self->memory, 5 * stride * sizeof(MYFLT));
+
+    if (memory == NULL)
+        return -1;
+
+    self->memory = memory;
+
+    memset(memory, 0, 5 * stride * sizeof(MYFLT));
+
+    self->phase = memory;
+    self->inc = memory + stride;
+    self->amp = memory + 2 * stride;
+    self->incStep = memory + 3 * stride;
+    self->ampStep = memory + 4 * stride;
+
+    self->size = size;
+
+    return 0;
+}
+
+void
+OscillatorBank_free(OscillatorBank *self)
+{
+    arena_free(self->memory);
+    self->memory = NULL;
+    self->size = 0;
+}
+
+void
+OscillatorBank_set(OscillatorBank *self, int k, MYFLT inc, MYFLT amp)
+{
+    self->inc[k] = inc;
+    self->amp[k] = amp;
+    self->incStep[k] = self->ampStep[k] = 0.0;
+}
+
+void
+OscillatorBank_rampTo(OscillatorBank *self, int k, MYFLT inc, MYFLT amp, int n)
+{
+    self->incStep[k] = (inc - self->inc[k]) / n;
+    self->ampStep[k] = (amp - self->amp[k]) / n;
+}
+
+/* Same wrapping as OscBank, done only when the position leaves the table. */
+static inline MYFLT
+OscillatorBank_clip(MYFLT x, T_SIZE_T size)
+{
+    if (x >= size)
+    {
+        x -= (T_SIZE_T)(x / size) * size;
+    }
+    else if (x < 0)
+    {
+        x += ((T_SIZE_T)(-x / size) + 1) * size;
+    }
+
+    return x;
+}
+
+/* Scalar kernel. */
+
+static void
+OscillatorBank_group_c(OscillatorBank *self, int first, int lanes, const MYFLT *table, T_SIZE_T tablesize, MYFLT *acc, int n)
+{
+    int i, j;
+    T_SIZE_T ipart;
+    MYFLT pos, fpart, x, x1;
+    MYFLT phase[OSCILLATORBANK_LANES], inc[OSCILLATORBANK_LANES], amp[OSCILLATORBANK_LANES];
+    MYFLT incStep[OSCILLATORBANK_LANES], ampStep[OSCILLATORBANK_LANES];
+
+    for (j = 0; j < OSCILLATORBANK_LANES; j++)
+    {
+        phase[j] = self->phase[first + j];
+        inc[j] = self->inc[first + j];
+        incStep[j] = self->incStep[first + j];
+
+        if (j < lanes)
+        {
+            amp[j] = self->amp[first + j];
+            ampStep[j] = self->ampStep[first + j];
+        }
+        else
+            amp[j] = ampStep[j] = 0.0;
+    }
+
+    for (i = 0; i < n; i++)
+    {
+        for (j = 0; j < OSCILLATORBANK_LANES; j++)
+        {
+            pos = OscillatorBank_clip(phase[j], tablesize);
+            ipart = (T_SIZE_T)pos;
+            fpart = pos - ipart;
+            x = table[ipart];
+            x1 = table[ipart + 1];
+            acc[j] += (x + (x1 - x) * fpart) * amp[j];
+            phase[j] = pos + inc[j];
+            inc[j] += incStep[j];
+            amp[j] += ampStep[j];
+        }
+
+        acc += OSCILLATORBANK_LANES;
+    }
+
+    for (j = 0; j < lanes; j++)
+    {
+        self->phase[first + j] = phase[j];
+        self->inc[first + j] = inc[j];
+        self->amp[first + j] = amp[j];
+    }
+}
+
+#ifdef OSCILLATORBANK_X86
+
+/* AVX2 kernel. The gathers take 32-bit indices, larger tables use the
+   scalar kernel. The lanes past the last oscillator have a null amplitude
+   and their state is not written back. */
+
+#ifndef USE_DOUBLE
+
+#define OSCILLATORBANK_VTYPE __m256
+#define OSCILLATORBANK_ITYPE __m256i
+#define OSCILLATORBANK_VLOAD _mm256_loadu_ps
+#define OSCILLATORBANK_VSTORE _mm256_storeu_ps
+#define OSCILLATORBANK_VMSTORE(p, mask, v) _mm256_maskstore_ps(p, mask, v)
+#define OSCILLATORBANK_VSET1 _mm256_set1_ps
+#define OSCILLATORBANK_VZERO _mm256_setzero_ps
+#define OSCILLATORBANK_VMUL _mm256_mul_ps
+#define OSCILLATORBANK_VDIV _mm256_div_ps
+#define OSCILLATORBANK_VADD _mm256_add_ps
+#define OSCILLATORBANK_VSUB _mm256_sub_ps
+#define OSCILLATORBANK_VOR _mm256_or_ps
+#define OSCILLATORBANK_VCMP _mm256_cmp_ps
+#define OSCILLATORBANK_VBLEND _mm256_blendv_ps
+#define OSCILLATORBANK_VMOVEMASK _mm256_movemask_ps
+#define OSCILLATORBANK_VTRUNC _mm256_cvttps_epi32
+#define OSCILLATORBANK_VFLOAT _mm256_cvtepi32_ps
+#define OSCILLATORBANK_IADD _mm256_add_epi32
+#define OSCILLATORBANK_IMUL _mm256_mullo_epi32
+#define OSCILLATORBANK_ISET1 _mm256_set1_epi32
+#define OSCILLATORBANK_LANEMASK(lanes) _mm256_cmpgt_epi32(_mm256_set1_epi32(lanes), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7))
+#define OSCILLATORBANK_VMASK(mask) _mm256_castsi256_ps(mask)
+#define OSCILLATORBANK_VAND _mm256_and_ps
+#define OSCILLATORBANK_GATHER(base, v) _mm256_i32gather_ps(base, v, 4)
+
+#else
+
+#define OSCILLATORBANK_VTYPE __m256d
+#define OSCILLATORBANK_ITYPE __m128i
+#define OSCILLATORBANK_VLOAD _mm256_loadu_pd
+#define OSCILLATORBANK_VSTORE _mm256_storeu_pd
+#define OSCILLATORBANK_VMSTORE(p, mask, v) _mm256_maskstore_pd(p, mask, v)
+#define OSCILLATORBANK_VSET1 _mm256_set1_pd
+#define OSCILLATORBANK_VZERO _mm256_setzero_pd
+#define OSCILLATORBANK_VMUL _mm256_mul_pd
+#define OSCILLATORBANK_VDIV _mm256_div_pd
+#define OSCILLATORBANK_VADD _mm256_add_pd
+#define OSCILLATORBANK_VSUB _mm256_sub_pd
+#define OSCILLATORBANK_VOR _mm256_or_pd
+#define OSCILLATORBANK_VCMP _mm256_cmp_pd
+#define OSCILLATORBANK_VBLEND _mm256_blendv_pd
+#define OSCILLATORBANK_VMOVEMASK _mm256_movemask_pd
+#define OSCILLATORBANK_VTRUNC _mm256_cvttpd_epi32
+#define OSCILLATORBANK_VFLOAT _mm256_cvtepi32_pd
+#define OSCILLATORBANK_IADD _mm_add_epi32
+#define OSCILLATORBANK_IMUL _mm_mullo_epi32
+#define OSCILLATORBANK_ISET1 _mm_set1_epi32
+#define OSCILLATORBANK_LANEMASK(lanes) _mm256_cmpgt_epi64(_mm256_set1_epi64x(lanes), _mm256_setr_epi64x(0, 1, 2, 3))
+#define OSCILLATORBANK_VMASK(mask) _mm256_castsi256_pd(mask)
+#define OSCILLATORBANK_VAND _mm256_and_pd
+#define OSCILLATORBANK_GATHER(base, v) _mm256_i32gather_pd(base, v, 8)
+
+#endif
+
+__attribute__((target("avx2"))) static void
+OscillatorBank_group_avx2(OscillatorBank *self, int first, int lanes, const MYFLT *table, T_SIZE_T tablesize, MYFLT *acc, int n)
+{
+    int i;
+    __m256i mask = OSCILLATORBANK_LANEMASK(lanes);
+    OSCILLATORBANK_VTYPE pos, fpart, x, x1, above, below, wrapped;
+    OSCILLATORBANK_ITYPE ipart;
+    OSCILLATORBANK_VTYPE vsize = OSCILLATORBANK_VSET1(tablesize), zero = OSCILLATORBANK_VZERO();
+    OSCILLATORBANK_ITYPE isize = OSCILLATORBANK_ISET1((int)tablesize), ione = OSCILLATORBANK_ISET1(1);
+    OSCILLATORBANK_VTYPE phase = OSCILLATORBANK_VLOAD(self->phase + first);
+    OSCILLATORBANK_VTYPE inc = OSCILLATORBANK_VLOAD(self->inc + first);
+    OSCILLATORBANK_VTYPE incStep = OSCILLATORBANK_VLOAD(self->incStep + first);
+    OSCILLATORBANK_VTYPE amp = OSCILLATORBANK_VAND(OSCILLATORBANK_VLOAD(self->amp + first), OSCILLATORBANK_VMASK(mask));
+    OSCILLATORBANK_VTYPE ampStep = OSCILLATORBANK_VAND(OSCILLATORBANK_VLOAD(self->ampStep + first), OSCILLATORBANK_VMASK(mask));
+
+    for (i = 0; i < n; i++)
+    {
+        pos = phase;
+        above = OSCILLATORBANK_VCMP(pos, vsize, _CMP_GE_OQ);
+        below = OSCILLATORBANK_VCMP(pos, zero, _CMP_LT_OQ);
+
+        if (OSCILLATORBANK_VMOVEMASK(OSCILLATORBANK_VOR(above, below)))
+        {
+            ipart = OSCILLATORBANK_IMUL(OSCILLATORBANK_VTRUNC(OSCILLATORBANK_VDIV(pos, vsize)), isize);
+            wrapped = OSCILLATORBANK_VSUB(pos, OSCILLATORBANK_VFLOAT(ipart));
+            pos = OSCILLATORBANK_VBLEND(pos, wrapped, above);
+            ipart = OSCILLATORBANK_VTRUNC(OSCILLATORBANK_VDIV(OSCILLATORBANK_VSUB(zero, phase), vsize));
+            ipart = OSCILLATORBANK_IMUL(OSCILLATORBANK_IADD(ipart, ione), isize);
+            wrapped = OSCILLATORBANK_VADD(phase, OSCILLATORBANK_VFLOAT(ipart));
+            pos = OSCILLATORBANK_VBLEND(pos, wrapped, below);
+        }
+
+        ipart = OSCILLATORBANK_VTRUNC(pos);
+        fpart = OSCILLATORBANK_VSUB(pos, OSCILLATORBANK_VFLOAT(ipart));
+        x = OSCILLATORBANK_GATHER(table, ipart);
+        x1 = OSCILLATORBANK_GATHER(table, OSCILLATORBANK_IADD(ipart, ione));
+        x = OSCILLATORBANK_VMUL(OSCILLATORBANK_VADD(x, OSCILLATORBANK_VMUL(OSCILLATORBANK_VSUB(x1, x), fpart)), amp);
+        OSCILLATORBANK_VSTORE(acc, OSCILLATORBANK_VADD(OSCILLATORBANK_VLOAD(acc), x));
+        phase = OSCILLATORBANK_VADD(pos, inc);
+        inc = OSCILLATORBANK_VADD(inc, incStep);
+        amp = OSCILLATORBANK_VADD(amp, ampStep);
+        acc += OSCILLATORBANK_LANES;
+    }
+
+    OSCILLATORBANK_VMSTORE(self->phase + first, mask, phase);
+    OSCILLATORBANK_VMSTORE(self->inc + first, mask, inc);
+    OSCILLATORBANK_VMSTORE(self->amp + first, mask, amp);
+}
+
+#endif // OSCILLATORBANK_X86
+
+static oscillatorbank_group_func OscillatorBank_group = OscillatorBank_group_c;
+
+static const char *oscillatorbank_kernels = "scalar";
+
+void
+OscillatorBank_process(OscillatorBank *self, int count, const MYFLT *table, T_SIZE_T tablesize, MYFLT *out, int n)
+{
+    int i, j, start, len, lanes;
+    MYFLT *a;
+    MYFLT acc[OSCILLATORBANK_CHUNK * OSCILLATORBANK_LANES];
+    oscillatorbank_group_func group = OscillatorBank_group;
+
+    if (tablesize > INT_MAX - 1)
+        group = OscillatorBank_group_c;
+
+    for (start = 0; start < n; start += OSCILLATORBANK_CHUNK)
+    {
+        len = n - start < OSCILLATORBANK_CHUNK ? n - start : OSCILLATORBANK_CHUNK;
+
+        memset(acc, 0, len * OSCILLATORBANK_LANES * sizeof(MYFLT));
+
+        for (j = 0; j < count; j += OSCILLATORBANK_LANES)
+        {
+            lanes = count - j < OSCILLATORBANK_LANES ? count - j : OSCILLATORBANK_LANES;
+            (*group)(self, j, lanes, table, tablesize, acc, len);
+        }
+
+        for (i = 0; i < len; i++)
+        {
+            a = acc + i * OSCILLATORBANK_LANES;
+#ifndef USE_DOUBLE
+            out[start + i] += ((a[0] + a[1]) + (a[2] + a[3])) + ((a[4] + a[5]) + (a[6] + a[7]));
+#else
+            out[start + i] += (a[0] + a[1]) + (a[2] + a[3]);
+#endif
+        }
+    }
+}
+
+void
+oscillatorbank_init(void)
+{
+#if defined(OSCILLATORBANK_X86)
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2"))
+    {
+        OscillatorBank_group = OscillatorBank_group_avx2;
+        oscillatorbank_kernels = "avx2";
+    }
+#endif
+}
+
+const char *
+oscillatorbank_name(void)
+{
+    return oscillatorbank_kernels;
+}
@@ -2019,6 +2019,26 @@ serverBooted(PyObject *self)
     }
 }
 
+#define serverMultichannelStreams_info \
+"\nReturns True if the objects created now compute all their channels in a single object.\n\n\
+>>> s = Server().boot()\n\
+>>> print(serverMultichannelStreams())\n\
+False\n\
+>>> s.setMultichannelStreams(True)\n\
+>>> print(serverMultichannelStreams())\n\
+True\n\n"
+
+static PyObject *
+serverMultichannelStreams(PyObject *self)
+{
+    Server *server = (Server *)PyServer_get_server();
+
+    if (server != NULL && server->multichannel)
+        Py_RETURN_TRUE;
+    else
+        Py_RETURN_FALSE;
+}
+
 static PyMethodDef pyo_functions[] =
 {
     {"pa_get_version", (PyCFunction)portaudio_get_version, METH_NOARGS, portaudio_get_version_info},
@@ -2058,6 +2078,7 @@ static PyMethodDef pyo_functions[] =
     {"secToSamps", (PyCFunction)secToSamps, METH_O, secToSamps_info},
     {"serverCreated", (PyCFunction)serverCreated, METH_NOARGS, serverCreated_info},
     {"serverBooted", (PyCFunction)serverBooted, METH_NOARGS, serverBooted_info},
+    {"serverMultichannelStreams", (PyCFunction)serverMultichannelStreams, METH_NOARGS, serverMultichannelStreams_info},
     {"withPortaudio", (PyCFunction)with_portaudio, METH_NOARGS, "Returns True if pyo is built with portaudio support."},
     {"withPortmidi", (PyCFunction)with_portmidi, METH_NOARGS, "Returns True if pyo is built with portmidi support."},
     {"withJack", (PyCFunction)with_jack, METH_NOARGS, "Returns True if pyo is built with jack support."},
@@ -2204,6 +2225,7 @@ PyInit__pyo64(void)
     module_add_object(m, "TableRead_base", &TableReadType);
     module_add_object(m, "Pulsar_base", &PulsarType);
     module_add_object(m, "Sine_base", &SineType);
+    module_add_object(m, "SineMulti_base", &SineMultiType);
     module_add_object(m, "FastSine_base", &FastSineType);
     module_add_object(m, "SineLoop_base", &SineLoopType);
     module_add_object(m, "Fm_base", &FmType);
@@ -2225,10 +2247,14 @@ PyInit__pyo64(void)
     module_add_object(m, "PinkNoise_base", &PinkNoiseType);
     module_add_object(m, "BrownNoise_base", &BrownNoiseType);
     module_add_object(m, "Biquad_base", &BiquadType);
+    module_add_object(m, "BiquadMulti_base", &BiquadMultiType);
     module_add_object(m, "Biquadx_base", &BiquadxType);
+    module_add_object(m, "BiquadxMulti_base", &BiquadxMultiType);
     module_add_object(m, "Biquada_base", &BiquadaType);
     module_add_object(m, "EQ_base", &EQType);
+    module_add_object(m, "EQMulti_base", &EQMultiType);
     module_add_object(m, "Tone_base", &ToneType);
+    module_add_object(m, "ToneMulti_base", &ToneMultiType);
     module_add_object(m, "Atone_base", &AtoneType);
     module_add_object(m, "DCBlock_base", &DCBlockType);
     module_add_object(m, "Allpass_base", &AllpassType);
@@ -2286,6 +2312,7 @@ PyInit__pyo64(void)
     module_add_object(m, "SPanner_base", &SPannerType);
     module_add_object(m, "Panner_base", &PannerType);
     module_add_object(m, "Pan_base", &PanType);
+    module_add_object(m, "MultiChannel_base", &MultiChannelType);
     module_add_object(m, "SPan_base", &SPanType);
     module_add_object(m, "Switcher_base", &SwitcherType);
     module_add_object(m, "Switch_base", &SwitchType);
@@ -0,0 +1,514 @@
+/**************************************************************************
+ * Copyright 2009-2015 Olivier Belanger                                   *
+ *                                                                        *
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *
+ *                                                                        *
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with pyo.  If not, see <http://www.gnu.org/licenses/>.   *
+ *************************************************************************/
+
+/* Parallel stream scheduler.
+ *
+ * The streams are split in segments, each segment ending at the first stream
+ * that must be computed by the audio thread itself (a stream calling Python or
+ * the global random generator, or reaching the end of its duration). Within a
+ * segment, the dependency graph is built from the objects visited by each
+ * stream's tp_traverse function (inputs, parameters, tables). Every stream
+ * gets a level higher than the level of the streams, earlier in the list, with
+ * which it conflicts (it reads them, they read it, or they share a table that
+ * one of them writes). Streams of the same level are independent and are
+ * computed concurrently by the workers and the audio thread, each thread
+ * taking the next stream available. Since conflicting streams are always
+ * computed in list order, the result does not depend on the number of
+ * workers and is identical to the serial processing. */
+
+#include <Python.h>
+#include <sched.h>
+#include <stdint.h>
+#include <string.h>
+#include "scheduler.h"
+#include "dummymodule.h"
+
+/** Worker pool. **/
+/******************/
+
+/* Computes the streams of the job of `generation` until none is left. A
+   stream is claimed by moving the ticket forward, which fails once the
+   job is finished or replaced, so a late worker never takes a stream of
+   the next job. Returns when every stream has been claimed. */
+static void
+Scheduler_runJob(PyoScheduler *self, unsigned int generation)
+{
+    uint64_t ticket = __atomic_load_n(&self->ticket, __ATOMIC_ACQUIRE);
+
+    for (;;)
+    {
+        if ((unsigned int)(ticket >> 32) != generation || (int)(uint32_t)ticket >= __atomic_load_n(&self->jobCount, __ATOMIC_RELAXED))
+            return;
+
+        if (__atomic_compare_exchange_n(&self->ticket, &ticket, ticket + 1, 0, __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE))
+        {
+            Stream_callFunction(self->job[(uint32_t)ticket]);
+            __atomic_add_fetch(&self->done, 1, __ATOMIC_RELEASE);
+            ticket++;
+        }
+    }
+}
+
+static void *
+Scheduler_worker(void *arg)
+{
+    PyoScheduler *self = (PyoScheduler *)arg;
+    unsigned int generation = 0;
+
+    pthread_mutex_lock(&self->mutex);
+
+    for (;;)
+    {
+        while (self->generation == generation && ! self->quit)
+        {
+            self->waiting++;
+            pthread_cond_wait(&self->cond, &self->mutex);
+            self->waiting--;
+        }
+
+        if (self->quit)
+            break;
+
+        generation = self->generation;
+        pthread_mutex_unlock(&self->mutex);
+
+        Scheduler_runJob(self, generation);
+
+        pthread_mutex_lock(&self->mutex);
+    }
+
+    pthread_mutex_unlock(&self->mutex);
+
+    return NULL;
+}
+
+/* Computes a list of independent streams. A level of a single stream is
+   computed by the audio thread alone. Otherwise, the workers that are
+   asleep are woken up and the audio thread takes its share of the job,
+   then waits only for the streams claimed by the workers. */
+static void
+Scheduler_run(PyoScheduler *self, Stream **items, int count)
+{
+    int i;
+    unsigned int generation;
+
+    if (self->nworkers == 0 || count < 2)
+    {
+        for (i = 0; i < count; i++)
+        {
+            Stream_callFunction(items[i]);
+        }
+
+        return;
+    }
+
+    generation = self->generation + 1;
+    self->job = items;
+    __atomic_store_n(&self->jobCount, count, __ATOMIC_RELAXED);
+    self->done = 0;
+    __atomic_store_n(&self->ticket, (uint64_t)generation << 32, __ATOMIC_RELEASE);
+
+    pthread_mutex_lock(&self->mutex);
+    self->generation = generation;
+
+    if (self->waiting > 0)
+        pthread_cond_broadcast(&self->cond);
+
+    pthread_mutex_unlock(&self->mutex);
+
+    Scheduler_runJob(self, generation);
+
+    while (__atomic_load_n(&self->done, __ATOMIC_ACQUIRE) < count)
+        sched_yield();
+}
+
+/** Graph construction. **/
+/************************/
+
+static unsigned int
+Scheduler_hash(void *key)
+{
+    uintptr_t k = (uintptr_t)key >> 4;
+    return (unsigned int)(k ^ (k >> 16)) * 2654435761u;
+}
+
+static SchedulerEntry *
+Scheduler_lookup(PyoScheduler *self, void *key)
+{
+    unsigned int i, mask = self->tableSize - 1;
+    unsigned int h = Scheduler_hash(key) & mask;
+    SchedulerEntry *entry;
+
+    for (i = 0; i < self->tableSize; i++)
+    {
+        entry = &self->table[(h + i) & mask];
+
+        if (entry->stamp != self->stamp)
+            return NULL;
+
+        if (entry->key == key)
+            return entry;
+    }
+
+    return NULL;
+}
+
+static SchedulerEntry *
+Scheduler_insert(PyoScheduler *self, void *key, int node)
+{
+    unsigned int i, mask = self->tableSize - 1;
+    unsigned int h = Scheduler_hash(key) & mask;
+    SchedulerEntry *entry;
+
+    /* Keep the table at most half full. */
+    for (i = 0; i < (self->tableSize >> 1); i++)
+    {
+        entry = &self->table[(h + i) & mask];
+
+        if (entry->stamp != self->stamp)
+        {
+            entry->key = key;
+            entry->stamp = self->stamp;
+            entry->node = node;
+            entry->readLevel = entry->writeLevel = -1;
+            return entry;
+        }
+
+        if (entry->key == key)
+            return entry;
+    }
+
+    return NULL;
+}
+
+/* Only pyo objects (streams, tables, matrices, ...) can carry dependencies. */
+static int
+Scheduler_isPyoObject(PyObject *obj)
+{
+    const char *name = Py_TYPE(obj)->tp_name;
+
+    return strncmp(name, "_pyo", 4) == 0 || strncmp(name, "pyo.", 4) == 0;
+}
+
+static void
+Scheduler_addRef(PyoScheduler *self, PyObject *obj)
+{
+    if (obj == NULL || obj == self->server || ! Scheduler_isPyoObject(obj))
+        return;
+
+    if (self->nrefs < PYO_SCHED_MAX_REFS)
+        self->refs[self->nrefs] = obj;
+
+    self->nrefs++;
+}
+
+static int
+Scheduler_visit(PyObject *obj, void *arg)
+{
+    Py_ssize_t i;
+    PyoScheduler *self = (PyoScheduler *)arg;
+
+    if (PyList_CheckExact(obj))
+    {
+        for (i = 0; i < PyList_GET_SIZE(obj); i++)
+            Scheduler_addRef(self, PyList_GET_ITEM(obj, i));
+    }
+    else if (PyTuple_CheckExact(obj))
+    {
+        for (i = 0; i < PyTuple_GET_SIZE(obj); i++)
+            Scheduler_addRef(self, PyTuple_GET_ITEM(obj, i));
+    }
+    else
+    {
+        Scheduler_addRef(self, obj);
+    }
+
+    return 0;
+}
+
+/* Streams that must be computed by the audio thread, in list order. */
+static int
+Scheduler_isSerial(Stream *stream)
+{
+    PyObject *obj = stream->streamobject;
+
+    if (stream->serial || stream->needGIL || stream->callbackptr != NULL)
+        return 1;
+
+    /* Stopping the object (and clearing its buffer) must happen at its position. */
+    if (stream->duration != 0 && (stream->bufferCount + 1) >= stream->duration)
+        return 1;
+
+    if (obj == NULL || Py_TYPE(obj)->tp_traverse == NULL)
+        return 1;
+
+    return 0;
+}
+
+/* Computes the level of the node k. Returns -1 if the stream must be computed serially. */
+static int
+Scheduler_computeLevel(PyoScheduler *self, int k, int n)
+{
+    int j, lvl, writer, node;
+    Stream *stream = self->nodes[k];
+    PyObject *obj = stream->streamobject;
+    SchedulerEntry *entry;
+
+    self->nrefs = 0;
+    Py_TYPE(obj)->tp_traverse(obj, Scheduler_visit, self);
+
+    /* The objects read by the Dummy objects it computes inline. */
+    if (Py_TYPE(obj) == &DummyType)
+        Dummy_visitInlined(obj, Scheduler_visit, self);
+
+    if (self->nrefs > PYO_SCHED_MAX_REFS)
+        return -1;
+
+    writer = Stream_getTableWriter(stream);
+    lvl = self->readLevel[k];
+
+    for (j = 0; j < self->nrefs; j++)
+    {
+        entry = Scheduler_lookup(self, self->refs[j]);
+
+        if (entry != NULL && entry->node >= 0)
+        {
+            node = entry->node;
+
+            if (node < k)
+                lvl = lvl > self->level[node] ? lvl : self->level[node];
+        }
+        else
+        {
+            if (entry == NULL && (entry = Scheduler_insert(self, self->refs[j], -1)) == NULL)
+                return -1;
+
+            lvl = lvl > entry->writeLevel ? lvl : entry->writeLevel;
+
+            if (writer)
+                lvl = lvl > entry->readLevel ? lvl : entry->readLevel;
+        }
+    }
+
+    lvl++;
+
+    /* Later streams read by this one must wait for it. */
+    for (j = 0; j < self->nrefs; j++)
+    {
+        entry = Scheduler_lookup(self, self->refs[j]);
+
+        if (entry->node >= 0)
+        {
+            node = entry->node;
+
+            if (node > k && node < n && self->readLevel[node] < lvl)
+                self->readLevel[node] = lvl;
+        }
+        else if (writer)
+        {
+            if (entry->writeLevel < lvl)
+                entry->writeLevel = lvl;
+        }
+        else if (entry->readLevel < lvl)
+        {
+            entry->readLevel = lvl;
+        }
+    }
+
+    return lvl;
+}
+
+/** Public functions. **/
+/**********************/
+
+PyoScheduler *
+Scheduler_new(int nworkers)
+{
+    int i;
+    PyoScheduler *self = (PyoScheduler *)PyMem_RawMalloc(sizeof(PyoScheduler));
+
+    memset(self, 0, sizeof(PyoScheduler));
+    pthread_mutex_init(&self->mutex, NULL);
+    pthread_cond_init(&self->cond, NULL);
+
+    self->threads = (pthread_t *)PyMem_RawMalloc((nworkers > 0 ? nworkers : 1) * sizeof(pthread_t));
+
+    for (i = 0; i < nworkers; i++)
+    {
+        if (pthread_create(&self->threads[i], NULL, Scheduler_worker, self) != 0)
+            break;
+
+        self->nworkers++;
+    }
+
+    Scheduler_reserve(self, 256);
+
+    return self;
+}
+
+void
+Scheduler_free(PyoScheduler *self)
+{
+    int i;
+
+    pthread_mutex_lock(&self->mutex);
+    self->quit = 1;
+    pthread_cond_broadcast(&self->cond);
+    pthread_mutex_unlock(&self->mutex);
+
+    for (i = 0; i < self->nworkers; i++)
+    {
+        pthread_join(self->threads[i], NULL);
+    }
+
+    pthread_mutex_destroy(&self->mutex);
+    pthread_cond_destroy(&self->cond);
+
+    PyMem_RawFree(self->threads);
+    PyMem_RawFree(self->nodes);
+    PyMem_RawFree(self->level);
+    PyMem_RawFree(self->readLevel);
+    PyMem_RawFree(self->levelCount);
+    PyMem_RawFree(self->order);
+    PyMem_RawFree(self->table);
+    PyMem_RawFree(self);
+}
+
+/* Grows the graph buffers. Must not be called while a block is computed. */
+void
+Scheduler_reserve(PyoScheduler *self, int capacity)
+{
+    unsigned int size = 1024;
+
+    if (capacity <= self->capacity)
+        return;
+
+    if (capacity < self->capacity * 2)
+        capacity = self->capacity * 2;
+
+    self->nodes = (Stream **)PyMem_RawRealloc(self->nodes, capacity * sizeof(Stream *));
+    self->order = (Stream **)PyMem_RawRealloc(self->order, capacity * sizeof(Stream *));
+    self->level = (int *)PyMem_RawRealloc(self->level, capacity * sizeof(int));
+    self->readLevel = (int *)PyMem_RawRealloc(self->readLevel, capacity * sizeof(int));
+    self->levelCount = (int *)PyMem_RawRealloc(self->levelCount, (capacity + 1) * sizeof(int));
+
+    while (size < (unsigned int)capacity * 8)
+        size <<= 1;
+
+    if (size > self->tableSize)
+    {
+        PyMem_RawFree(self->table);
+        self->table = (SchedulerEntry *)PyMem_RawMalloc(size * sizeof(SchedulerEntry));
+        memset(self->table, 0, size * sizeof(SchedulerEntry));
+        self->tableSize = size;
+        self->stamp = 0;
+    }
+
+    self->capacity = capacity;
+}
+
+/* Computes the streams from `start` up to the first one that must be computed
+   serially by the caller. Returns the index of this stream (`count` if the
+   whole list has been computed). */
+int
+Scheduler_process(PyoScheduler *self, Stream **streams, int start, int count, PyObject *server)
+{
+    int i, k, n = 0, end, lvl, maxLevel = -1, offset, tmp;
+    Stream *stream;
+
+    self->server = server;
+
+    if (++self->stamp == 0)
+    {
+        memset(self->table, 0, self->tableSize * sizeof(SchedulerEntry));
+        self->stamp = 1;
+    }
+
+    /* Collect the streams of the segment. */
+    for (end = start; end < count && n < self->capacity; end++)
+    {
+        stream = streams[end];
+
+        if (stream == NULL || Stream_getStreamActive(stream) != 1)
+            continue;
+
+        if (Scheduler_isSerial(stream))
+            break;
+
+        if (Scheduler_insert(self, stream, n) == NULL ||
+            Scheduler_insert(self, stream->streamobject, n) == NULL)
+            break;
+
+        self->nodes[n] = stream;
+        self->readLevel[n] = -1;
+        n++;
+    }
+
+    /* Assign the dependency levels. */
+    for (k = 0; k < n; k++)
+    {
+        lvl = Scheduler_computeLevel(self, k, n);
+
+        if (lvl < 0)
+        {
+            /* Too many references, this stream is left to the caller. */
+            stream = self->nodes[k];
+
+            for (end = start; streams[end] != stream; end++);
+
+            n = k;
+            break;
+        }
+
+        self->level[k] = lvl;
+
+        if (lvl > maxLevel)
+            maxLevel = lvl;
+    }
+
+    /* Stable counting sort of the nodes by level. */
+    for (i = 0; i <= maxLevel; i++)
+        self->levelCount[i] = 0;
+
+    for (k = 0; k < n; k++)
+        self->levelCount[self->level[k]]++;
+
+    offset = 0;
+
+    for (i = 0; i <= maxLevel; i++)
+    {
+        tmp = self->levelCount[i];
+        self->levelCount[i] = offset;
+        offset += tmp;
+    }
+
+    for (k = 0; k < n; k++)
+        self->order[self->levelCount[self->level[k]]++] = self->nodes[k];
+
+    offset = 0;
+
+    for (i = 0; i <= maxLevel; i++)
+    {
+        Scheduler_run(self, &self->order[offset], self->levelCount[i] - offset);
+        offset = self->levelCount[i];
+    }
+
+    return end;
+}
@@ -33,6 +33,16 @@
 #include "streammodule.h"
 #include "pyomodule.h"
 #include "servermodule.h"
+#include "mixbus.h"
+#include "grainkernel.h"
+#include "oscillatorbank.h"
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <windows.h>
+#define PYO_CONTROL_SLEEP() Sleep(1)
+#else
+#define PYO_CONTROL_SLEEP() { struct timespec ts = {0, 1000000}; nanosleep(&ts, NULL); }
+#endif
 
 #ifdef USE_PORTAUDIO
 #include "ad_portaudio.h"
@@ -252,8 +262,7 @@ void
         }
 
         self->server_started = 0;
-        self->record = 0;
-        sf_close(self->recfile);
+        Server_stop_rec_internal(self);
         Server_message(self, "Offline Server rendering finished.\n");
     }
 
@@ -293,8 +302,7 @@ Server_offline_start(Server *self)
 
     self->server_started = 0;
     self->server_stopped = 1;
-    self->record = 0;
-    sf_close(self->recfile);
+    Server_stop_rec_internal(self);
     Server_message(self, "Offline Server rendering finished.\n");
     return 0;
 }
@@ -332,23 +340,9 @@ Server_embedded_i_startIdx(int idx)
 int
 Server_embedded_ni_start(Server *self)
 {
-    int i, j;
-    float out[self->bufferSize * self->nchnls];
-
     Server_process_buffers(self);
 
-    for (i = 0; i < (self->bufferSize * self->nchnls); i++)
-    {
-        out[i] = self->output_buffer[i];
-    }
-
-    for (i = 0; i < self->bufferSize; i++)
-    {
-        for (j = 0; j < self->nchnls; j++)
-        {
-            self->output_buffer[(j * self->bufferSize) + i] = out[(i * self->nchnls) + j];
-        }
-    }
+    memcpy(self->output_buffer, self->planar_output_buffer, self->bufferSize * self->nchnls * sizeof(float));
 
     self->midi_count = 0;
     return 0;
@@ -373,62 +367,421 @@ Server_embedded_stop(Server *self)
     return 0;
 }
 
+/** GIL-free processing. **/
+/**************************/
+
+/* In GIL-free mode, the audio thread never calls the Python API directly
+   (except for streams flagged with Stream_setNeedGIL). Every python-touching
+   work is posted to a single-producer single-consumer queue and executed
+   later, with the GIL held, either by the control thread or, if the thread
+   calling Server_process_buffers already holds the GIL (offline, manual and
+   embedded servers), at the end of the block. Consumers always hold the GIL,
+   so the queue has effectively one consumer at a time. */
+
+/* Offline and manual servers are not driven by an audio device, they can
+   wait for the disk instead of dropping samples. */
+int
+Server_isNonRealTime(Server *self)
+{
+    return self->audio_be_type == PyoOffline || self->audio_be_type == PyoOfflineNB ||
+           self->audio_be_type == PyoManual;
+}
+
+int
+Server_getGILFree(Server *self)
+{
+    return self->gilFree;
+}
+
+void
+Server_deferCall(Server *self, Stream *stream, int type)
+{
+    unsigned int head = __atomic_load_n(&self->deferredHead, __ATOMIC_RELAXED);
+    unsigned int tail = __atomic_load_n(&self->deferredTail, __ATOMIC_ACQUIRE);
+
+    if ((head - tail) >= PYO_DEFERRED_QUEUE_SIZE)
+    {
+        self->deferredOverflows++;
+        return;
+    }
+
+    self->deferred[head & (PYO_DEFERRED_QUEUE_SIZE - 1)].stream = stream;
+    self->deferred[head & (PYO_DEFERRED_QUEUE_SIZE - 1)].type = type;
+    __atomic_store_n(&self->deferredHead, head + 1, __ATOMIC_RELEASE);
+}
+
+/* Called by objects whose process needs to call a Python function.
+   The stream's callback is either called immediately or deferred. */
+void
+Server_callOrDefer(Server *self, Stream *stream)
+{
+    if (self->gilFree)
+        Server_deferCall(self, stream, PyoDeferCallback);
+    else
+        Stream_callCallback(stream);
+}
+
+/* Removes pending calls for a stream about to be destroyed. GIL must be held. */
+static void
+Server_purgeDeferredCalls(Server *self, Stream *stream)
+{
+    unsigned int i;
+    unsigned int head = __atomic_load_n(&self->deferredHead, __ATOMIC_ACQUIRE);
+
+    for (i = self->deferredTail; i != head; i++)
+    {
+        if (self->deferred[i & (PYO_DEFERRED_QUEUE_SIZE - 1)].stream == stream)
+            self->deferred[i & (PYO_DEFERRED_QUEUE_SIZE - 1)].stream = NULL;
+    }
+}
+
+/* Executes pending calls. GIL must be held. */
+void
+Server_processDeferredCalls(Server *self)
+{
+    unsigned int tail = self->deferredTail;
+    unsigned int head = __atomic_load_n(&self->deferredHead, __ATOMIC_ACQUIRE);
+    PyoDeferredCall *call;
+    PyObject *result;
+
+    while (tail != head)
+    {
+        call = &self->deferred[tail & (PYO_DEFERRED_QUEUE_SIZE - 1)];
+
+        switch (call->type)
+        {
+            case PyoDeferStop:
+                if (call->stream != NULL)
+                {
+                    result = PyObject_CallMethod(call->stream->streamobject, "stop", NULL);
+                    Py_XDECREF(result);
+                }
+
+                break;
+
+            case PyoDeferCallback:
+                if (call->stream != NULL)
+                    Stream_callCallback(call->stream);
+
+                break;
+
+            case PyoDeferServerCallback:
+                if (self->CALLBACK != NULL)
+                {
+                    result = PyObject_CallObject((PyObject *)self->CALLBACK, NULL);
+
+                    if (result == NULL)
+                        PyErr_Print();
+
+                    Py_XDECREF(result);
+                }
+
+                break;
+
+            case PyoDeferGui:
+                Server_send_rms(self);
+                break;
+
+            case PyoDeferTime:
+                Server_send_time(self);
+                break;
+        }
+
+        tail++;
+        __atomic_store_n(&self->deferredTail, tail, __ATOMIC_RELEASE);
+        /* A call may have posted new events (ex.: Pattern starting objects). */
+        head = __atomic_load_n(&self->deferredHead, __ATOMIC_ACQUIRE);
+    }
+
+    if (self->deferredOverflows != self->deferredOverflowsReported)
+    {
+        Server_warning(self, "GIL-free processing: %u deferred calls dropped (queue full).\n",
+                       self->deferredOverflows - self->deferredOverflowsReported);
+        self->deferredOverflowsReported = self->deferredOverflows;
+    }
+
+    if (self->lockMisses != self->lockMissesReported)
+    {
+        Server_warning(self, "GIL-free processing: %u blocks played again, the streams were locked by another thread.\n",
+                       self->lockMisses - self->lockMissesReported);
+        self->lockMissesReported = self->lockMisses;
+    }
+}
+
+static void *
+Server_control_thread(void *arg)
+{
+    Server *self = (Server *)arg;
+    PyGILState_STATE s;
+
+    while (__atomic_load_n(&self->ctlThreadRunning, __ATOMIC_ACQUIRE))
+    {
+        if (__atomic_load_n(&self->deferredHead, __ATOMIC_ACQUIRE) != self->deferredTail)
+        {
+            s = PyGILState_Ensure();
+            Server_processDeferredCalls(self);
+            PyGILState_Release(s);
+        }
+        else
+        {
+            PYO_CONTROL_SLEEP();
+        }
+    }
+
+    return NULL;
+}
+
+static void
+Server_start_control_thread(Server *self)
+{
+    if (self->ctlThreadRunning)
+        return;
+
+    self->ctlThreadRunning = 1;
+
+    if (pthread_create(&self->ctlThread, NULL, Server_control_thread, self) != 0)
+    {
+        self->ctlThreadRunning = 0;
+        Server_error(self, "Unable to start the GIL-free control thread.\n");
+    }
+}
+
+static void
+Server_stop_control_thread(Server *self)
+{
+    if (! self->ctlThreadRunning)
+        return;
+
+    __atomic_store_n(&self->ctlThreadRunning, 0, __ATOMIC_RELEASE);
+
+    /* The control thread may be waiting for the GIL. */
+    if (PyGILState_Check())
+    {
+        Py_BEGIN_ALLOW_THREADS
+        pthread_join(self->ctlThread, NULL);
+        Py_END_ALLOW_THREADS
+    }
+    else
+    {
+        pthread_join(self->ctlThread, NULL);
+    }
+
+    /* Flush what's left in the queue. */
+    if (PyGILState_Check())
+        Server_processDeferredCalls(self);
+}
+
+/* Locks the streams against the audio thread. In GIL-free mode, the audio
+   thread may be waiting for the GIL while holding the lock, so the GIL is
+   released while waiting for the lock. The lock is recursive because objects
+   can be created (or destroyed) by a Python function called from the audio thread. */
+void
+Server_lock_streams(Server *self)
+{
+    if (pthread_mutex_trylock(&self->stream_lock) != 0)
+    {
+        if (PyGILState_Check())
+        {
+            Py_BEGIN_ALLOW_THREADS
+            pthread_mutex_lock(&self->stream_lock);
+            Py_END_ALLOW_THREADS
+        }
+        else
+        {
+            pthread_mutex_lock(&self->stream_lock);
+        }
+    }
+}
+
+void
+Server_unlock_streams(Server *self)
+{
+    pthread_mutex_unlock(&self->stream_lock);
+}
+
+void
+Server_lockProcessing(PyObject *server)
+{
+    Server_lock_streams((Server *)server);
+}
+
+void
+Server_unlockProcessing(PyObject *server)
+{
+    Server_unlock_streams((Server *)server);
+}
+
 /** Main Processing functions. **/
 /********************************/
 
+static void Server_compactStreams(Server *self);
+static void Server_applyStreamMoves(Server *self);
+static void Server_purgeStreamMoves(Server *self, Stream *stream);
+
+/* Computes a stream (if `compute` is true), adds it to the output
+   buffers and handles its duration. */
+static void
+Server_process_stream(Server *server, Stream *stream_tmp, MYFLT *buffer, int gilfree, int compute)
+{
+    int chnl;
+    MYFLT *data, *out;
+    PyGILState_STATE gs;
+
+    if (Stream_getStreamActive(stream_tmp) == 1)
+    {
+        if (compute)
+        {
+            if (gilfree && Stream_getNeedGIL(stream_tmp))
+            {
+                gs = PyGILState_Ensure();
+                Stream_callFunction(stream_tmp);
+                PyGILState_Release(gs);
+            }
+            else
+            {
+                Stream_callFunction(stream_tmp);
+            }
+
+            if (stream_tmp->shared)
+                stream_tmp->last = stream_tmp->data[stream_tmp->bufsize - 1];
+        }
+
+        if (Stream_getStreamToDac(stream_tmp) != 0 && Stream_getState(stream_tmp) != PYO_STREAM_SILENT)
+        {
+            data = Stream_getData(stream_tmp);
+            chnl = Stream_getStreamChnl(stream_tmp);
+            out = buffer + chnl * server->bufferSize;
+
+            mixbus_accumulate(out, data, server->bufferSize);
+        }
+
+        if (Stream_getDuration(stream_tmp) != 0)
+        {
+            if (! gilfree)
+                Stream_IncrementDurationCount(stream_tmp);
+            else if (Stream_IncrementDurationCountDeferred(stream_tmp))
+                Server_deferCall(server, stream_tmp, PyoDeferStop);
+        }
+    }
+    else
+    {
+        /* A shared buffer holds the samples of another stream, a stopped stream must read as silence. */
+        if (stream_tmp->shared)
+        {
+            memset(stream_tmp->data, 0, stream_tmp->bufsize * sizeof(MYFLT));
+            Stream_setState(stream_tmp, PYO_STREAM_SILENT);
+            stream_tmp->last = 0.0;
+        }
+
+        if (Stream_getBufferCountWait(stream_tmp) != 0)
+            Stream_IncrementBufferCount(stream_tmp);
+    }
+}
+
 void
 Server_process_buffers(Server *server)
 {
     //clock_t begin = clock();
 
     float *out = server->output_buffer;
-    MYFLT buffer[server->nchnls][server->bufferSize];
-    int i, j, chnl, nchnls = server->nchnls;
+    MYFLT *buffer = server->mix_buffer;
+    int i, j, end, nchnls = server->nchnls, size = server->bufferSize;
+    int gilfree = server->gilFree;
     MYFLT amp = server->amp;
-    Stream *stream_tmp;
-    MYFLT *data;
-
-    memset(&buffer, 0, sizeof(buffer));
+    PyGILState_STATE s = 0;
 
     /* This is the biggest bottle-neck of the callback. Don't know
        how (or if possible) to improve GIL acquire/release.
+       In GIL-free mode, the streams are protected by a mutex instead.
+       A real-time audio thread does not wait for a Python thread holding
+       it (a setter swapping a parameter, ...): the streams keep their
+       values and the previous block is played again. Offline and manual
+       servers wait for the lock.
     */
-    PyGILState_STATE s = PyGILState_Ensure();
+    if (gilfree)
+    {
+        if (server->audio_be_type != PyoOffline && server->audio_be_type != PyoOfflineNB && server->audio_be_type != PyoManual)
+        {
+            if (pthread_mutex_trylock(&server->stream_lock) != 0)
+            {
+                server->lockMisses++;
+                return;
+            }
+        }
+        else
+            pthread_mutex_lock(&server->stream_lock);
+    }
+    else
+        s = PyGILState_Ensure();
+
+    memset(buffer, 0, nchnls * size * sizeof(MYFLT));
 
     if (server->elapsedSamples == 0)
         server->midi_time_offset = pm_get_current_time();
 
     if (server->CALLBACK != NULL)
-        PyObject_Call((PyObject *)server->CALLBACK, PyTuple_New(0), NULL);
+    {
+        if (gilfree)
+            Server_deferCall(server, NULL, PyoDeferServerCallback);
+        else
+            Py_XDECREF(PyObject_CallObject((PyObject *)server->CALLBACK, NULL));
+    }
+
+    if (server->stream_holes > 0)
+        Server_compactStreams(server);
+
+    /* The shared buffers follow the list order, they are not used with the workers. */
+    if (server->bufferpool != NULL)
+    {
+        if (server->scheduler != NULL)
+        {
+            if (server->bufferpool->built)
+                BufferPool_release(server->bufferpool, server->stream_array, server->stream_count);
+        }
+        else if (! server->bufferpool->built || server->bufferpool->serial != Stream_getGraphSerial())
+            BufferPool_build(server->bufferpool, server->stream_array, server->stream_count, server->bufferSize, (PyObject *)server);
+    }
+
+    /* stream_array may be reallocated by a Python function creating new
+       objects, and removed streams leave a NULL slot until the next block. */
+    server->stream_iterating = 1;
 
-    for (i = 0; i < server->stream_count; i++)
+    if (server->scheduler != NULL)
     {
-        stream_tmp = (Stream *)PyList_GET_ITEM(server->streams, i);
+        i = 0;
 
-        if (Stream_getStreamActive(stream_tmp) == 1)
+        while (i < server->stream_count)
         {
-            Stream_callFunction(stream_tmp);
+            /* Computes the streams up to the next one that must be computed by this thread. */
+            end = Scheduler_process(server->scheduler, server->stream_array, i, server->stream_count, (PyObject *)server);
 
-            if (Stream_getStreamToDac(stream_tmp) != 0)
+            for (; i < end; i++)
             {
-                data = Stream_getData(stream_tmp);
-                chnl = Stream_getStreamChnl(stream_tmp);
-
-                for (j = 0; j < server->bufferSize; j++)
-                {
-                    buffer[chnl][j] += *data++;
-                }
+                if (server->stream_array[i] != NULL)
+                    Server_process_stream(server, server->stream_array[i], buffer, gilfree, 0);
             }
 
-            if (Stream_getDuration(stream_tmp) != 0)
+            if (i < server->stream_count)
             {
-                Stream_IncrementDurationCount(stream_tmp);
+                Server_process_stream(server, server->stream_array[i], buffer, gilfree, 1);
+                i++;
             }
         }
-        else if (Stream_getBufferCountWait(stream_tmp) != 0)
-            Stream_IncrementBufferCount(stream_tmp);
+    }
+    else
+    {
+        for (i = 0; i < server->stream_count; i++)
+        {
+            if (server->stream_array[i] != NULL)
+                Server_process_stream(server, server->stream_array[i], buffer, gilfree, 1);
+        }
     }
 
+    server->stream_iterating = 0;
+
+    if (server->stream_moves_count > 0)
+        Server_applyStreamMoves(server);
+
     if (server->withGUI == 1 && nchnls <= 16)
     {
         Server_process_gui(server);
@@ -441,7 +794,10 @@ Server_process_buffers(Server *server)
 
     server->elapsedSamples += server->bufferSize;
 
-    PyGILState_Release(s);
+    if (gilfree)
+        pthread_mutex_unlock(&server->stream_lock);
+    else
+        PyGILState_Release(s);
 
     if (amp != server->lastAmp)
     {
@@ -450,23 +806,43 @@ Server_process_buffers(Server *server)
         server->lastAmp = amp;
     }
 
-    for (i = 0; i < server->bufferSize; i++)
+    if (server->timeCount < server->timeStep)
     {
-        if (server->timeCount < server->timeStep)
+        for (i = 0; i < size; i++)
         {
-            server->currentAmp += server->stepVal;
-            server->timeCount++;
-        }
+            if (server->timeCount < server->timeStep)
+            {
+                server->currentAmp += server->stepVal;
+                server->timeCount++;
+            }
 
-        for (j = 0; j < server->nchnls; j++)
-        {
-            out[(i * server->nchnls) + j] = (float)buffer[j][i] * server->currentAmp;
+            server->amp_buffer[i] = server->currentAmp;
         }
+
+        for (j = 0; j < nchnls; j++)
+            mixbus_ramp(server->planar_output_buffer + j * size, buffer + j * size, server->amp_buffer, size);
+    }
+    else
+    {
+        for (j = 0; j < nchnls; j++)
+            mixbus_scale(server->planar_output_buffer + j * size, buffer + j * size, server->currentAmp, size);
     }
 
-    /* Writing to disk is not real time safe. */
-    if (server->record == 1)
-        sf_write_float(server->recfile, out, server->bufferSize * server->nchnls);
+    mixbus_interleave(out, server->planar_output_buffer, nchnls, size);
+
+    /* The disk writer thread writes the samples to the file. The lock is
+       only held by recstart and recstop, the block is skipped meanwhile. */
+    if (server->record == 1 && pthread_mutex_trylock(&server->rec_lock) == 0)
+    {
+        if (server->recstream != NULL)
+            DiskStream_write(server->recstream, out, size * nchnls);
+
+        pthread_mutex_unlock(&server->rec_lock);
+    }
+
+    /* Offline, manual and embedded servers run the deferred calls themselves. */
+    if (gilfree && PyGILState_Check())
+        Server_processDeferredCalls(server);
 
     //clock_t end = clock();
     //double time_spent = (double)(end - begin) / CLOCKS_PER_SEC;
@@ -511,102 +887,121 @@ Server_process_gui(Server *server)
             server->lastRms[j] = (rms[j] + server->lastRms[j]) * 0.5;
         }
 
-        switch (server->nchnls)
-        {
-            case 1:
-                PyObject_CallMethod((PyObject *)server->GUI, "setRms", "f", server->lastRms[0]);
-                break;
+        if (server->gilFree)
+            Server_deferCall(server, NULL, PyoDeferGui);
+        else
+            Server_send_rms(server);
 
-            case 2:
-                PyObject_CallMethod((PyObject *)server->GUI, "setRms", "ff", server->lastRms[0], server->lastRms[1]);
-                break;
+        server->gcount = 0;
+    }
+}
 
-            case 3:
-                PyObject_CallMethod((PyObject *)server->GUI, "setRms", "fff", server->lastRms[0], server->lastRms[1], server->lastRms[2]);
-                break;
+void
+Server_send_rms(Server *self)
+{
+    switch (self->nchnls)
+    {
+        case 1:
+            PyObject_CallMethod((PyObject *)self->GUI, "setRms", "f", self->lastRms[0]);
+            break;
 
-            case 4:
-                PyObject_CallMethod((PyObject *)server->GUI, "setRms", "ffff", server->lastRms[0], server->lastRms[1], server->lastRms[2], server->lastRms[3]);
-                break;
+        case 2:
+            PyObject_CallMethod((PyObject *)self->GUI, "setRms", "ff", self->lastRms[0], self->lastRms[1]);
+            break;
 
-            case 5:
-                PyObject_CallMethod((PyObject *)server->GUI, "setRms", "fffff", server->lastRms[0], server->lastRms[1], server->lastRms[2], server->lastRms[3], server->lastRms[4]);
-                break;
+        case 3:
+            PyObject_CallMethod((PyObject *)self->GUI, "setRms", "fff", self->lastRms[0], self->lastRms[1], self->lastRms[2]);
+            break;
 
-            case 6:
-                PyObject_CallMethod((PyObject *)server->GUI, "setRms", "ffffff", server->lastRms[0], server->lastRms[1], server->lastRms[2], server->lastRms[3], server->lastRms[4], server->lastRms[5]);
-                break;
+        case 4:
+            PyObject_CallMethod((PyObject *)self->GUI, "setRms", "ffff", self->lastRms[0], self->lastRms[1], self->lastRms[2], self->lastRms[3]);
+            break;
 
-            case 7:
-                PyObject_CallMethod((PyObject *)server->GUI, "setRms", "fffffff", server->lastRms[0], server->lastRms[1], server->lastRms[2], server->lastRms[3], server->lastRms[4], server->lastRms[5], server->lastRms[6]);
-                break;
+        case 5:
+            PyObject_CallMethod((PyObject *)self->GUI, "setRms", "fffff", self->lastRms[0], self->lastRms[1], self->lastRms[2], self->lastRms[3], self->lastRms[4]);
+            break;
 
-            case 8:
-                PyObject_CallMethod((PyObject *)server->GUI, "setRms", "ffffffff", server->lastRms[0], server->lastRms[1], server->lastRms[2], server->lastRms[3], server->lastRms[4], server->lastRms[5], server->lastRms[6], server->lastRms[7]);
-                break;
+        case 6:
+            PyObject_CallMethod((PyObject *)self->GUI, "setRms", "ffffff", self->lastRms[0], self->lastRms[1], self->lastRms[2], self->lastRms[3], self->lastRms[4], self->lastRms[5]);
+            break;
 
-            case 9:
-                PyObject_CallMethod((PyObject *)server->GUI, "setRms", "fffffffff", server->lastRms[0], server->lastRms[1], server->lastRms[2], server->lastRms[3], server->lastRms[4], server->lastRms[5], server->lastRms[6], server->lastRms[7], server->lastRms[8]);
-                break;
+        case 7:
+            PyObject_CallMethod((PyObject *)self->GUI, "setRms", "fffffff", self->lastRms[0], self->lastRms[1], self->lastRms[2], self->lastRms[3], self->lastRms[4], self->lastRms[5], self->lastRms[6]);
+            break;
 
-            case 10:
-                PyObject_CallMethod((PyObject *)server->GUI, "setRms", "ffffffffff", server->lastRms[0], server->lastRms[1], server->lastRms[2], server->lastRms[3], server->lastRms[4], server->lastRms[5], server->lastRms[6], server->lastRms[7], server->lastRms[8], server->lastRms[9]);
-                break;
+        case 8:
+            PyObject_CallMethod((PyObject *)self->GUI, "setRms", "ffffffff", self->lastRms[0], self->lastRms[1], self->lastRms[2], self->lastRms[3], self->lastRms[4], self->lastRms[5], self->lastRms[6], self->lastRms[7]);
+            break;
 
-            case 11:
-                PyObject_CallMethod((PyObject *)server->GUI, "setRms", "fffffffffff", server->lastRms[0], server->lastRms[1], server->lastRms[2], server->lastRms[3], server->lastRms[4], server->lastRms[5], server->lastRms[6], server->lastRms[7], server->lastRms[8], server->lastRms[9], server->lastRms[10]);
-                break;
+        case 9:
+            PyObject_CallMethod((PyObject *)self->GUI, "setRms", "fffffffff", self->lastRms[0], self->lastRms[1], self->lastRms[2], self->lastRms[3], self->lastRms[4], self->lastRms[5], self->lastRms[6], self->lastRms[7], self->lastRms[8]);
+            break;
 
-            case 12:
-                PyObject_CallMethod((PyObject *)server->GUI, "setRms", "ffffffffffff", server->lastRms[0], server->lastRms[1], server->lastRms[2], server->lastRms[3], server->lastRms[4], server->lastRms[5], server->lastRms[6], server->lastRms[7], server->lastRms[8], server->lastRms[9], server->lastRms[10], server->lastRms[11]);
-                break;
+        case 10:
+            PyObject_CallMethod((PyObject *)self->GUI, "setRms", "ffffffffff", self->lastRms[0], self->lastRms[1], self->lastRms[2], self->lastRms[3], self->lastRms[4], self->lastRms[5], self->lastRms[6], self->lastRms[7], self->lastRms[8], self->lastRms[9]);
+            break;
 
-            case 13:
-                PyObject_CallMethod((PyObject *)server->GUI, "setRms", "fffffffffffff", server->lastRms[0], server->lastRms[1], server->lastRms[2], server->lastRms[3], server->lastRms[4], server->lastRms[5], server->lastRms[6], server->lastRms[7], server->lastRms[8], server->lastRms[9], server->lastRms[10], server->lastRms[11], server->lastRms[12]);
-                break;
+        case 11:
+            PyObject_CallMethod((PyObject *)self->GUI, "setRms", "fffffffffff", self->lastRms[0], self->lastRms[1], self->lastRms[2], self->lastRms[3], self->lastRms[4], self->lastRms[5], self->lastRms[6], self->lastRms[7], self->lastRms[8], self->lastRms[9], self->lastRms[10]);
+            break;
 
-            case 14:
-                PyObject_CallMethod((PyObject *)server->GUI, "setRms", "ffffffffffffff", server->lastRms[0], server->lastRms[1], server->lastRms[2], server->lastRms[3], server->lastRms[4], server->lastRms[5], server->lastRms[6], server->lastRms[7], server->lastRms[8], server->lastRms[9], server->lastRms[10], server->lastRms[11], server->lastRms[12], server->lastRms[13]);
-                break;
+        case 12:
+            PyObject_CallMethod((PyObject *)self->GUI, "setRms", "ffffffffffff", self->lastRms[0], self->lastRms[1], self->lastRms[2], self->lastRms[3], self->lastRms[4], self->lastRms[5], self->lastRms[6], self->lastRms[7], self->lastRms[8], self->lastRms[9], self->lastRms[10], self->lastRms[11]);
+            break;
 
-            case 15:
-                PyObject_CallMethod((PyObject *)server->GUI, "setRms", "fffffffffffffff", server->lastRms[0], server->lastRms[1], server->lastRms[2], server->lastRms[3], server->lastRms[4], server->lastRms[5], server->lastRms[6], server->lastRms[7], server->lastRms[8], server->lastRms[9], server->lastRms[10], server->lastRms[11], server->lastRms[12], server->lastRms[13], server->lastRms[14]);
-                break;
+        case 13:
+            PyObject_CallMethod((PyObject *)self->GUI, "setRms", "fffffffffffff", self->lastRms[0], self->lastRms[1], self->lastRms[2], self->lastRms[3], self->lastRms[4], self->lastRms[5], self->lastRms[6], self->lastRms[7], self->lastRms[8], self->lastRms[9], self->lastRms[10], self->lastRms[11], self->lastRms[12]);
+            break;
 
-            case 16:
-                PyObject_CallMethod((PyObject *)server->GUI, "setRms", "ffffffffffffffff", server->lastRms[0], server->lastRms[1], server->lastRms[2], server->lastRms[3], server->lastRms[4], server->lastRms[5], server->lastRms[6], server->lastRms[7], server->lastRms[8], server->lastRms[9], server->lastRms[10], server->lastRms[11], server->lastRms[12], server->lastRms[13], server->lastRms[14], server->lastRms[15]);
-                break;
-        }
+        case 14:
+            PyObject_CallMethod((PyObject *)self->GUI, "setRms", "ffffffffffffff", self->lastRms[0], self->lastRms[1], self->lastRms[2], self->lastRms[3], self->lastRms[4], self->lastRms[5], self->lastRms[6], self->lastRms[7], self->lastRms[8], self->lastRms[9], self->lastRms[10], self->lastRms[11], self->lastRms[12], self->lastRms[13]);
+            break;
 
-        server->gcount = 0;
+        case 15:
+            PyObject_CallMethod((PyObject *)self->GUI, "setRms", "fffffffffffffff", self->lastRms[0], self->lastRms[1], self->lastRms[2], self->lastRms[3], self->lastRms[4], self->lastRms[5], self->lastRms[6], self->lastRms[7], self->lastRms[8], self->lastRms[9], self->lastRms[10], self->lastRms[11], self->lastRms[12], self->lastRms[13], self->lastRms[14]);
+            break;
+
+        case 16:
+            PyObject_CallMethod((PyObject *)self->GUI, "setRms", "ffffffffffffffff", self->lastRms[0], self->lastRms[1], self->lastRms[2], self->lastRms[3], self->lastRms[4], self->lastRms[5], self->lastRms[6], self->lastRms[7], self->lastRms[8], self->lastRms[9], self->lastRms[10], self->lastRms[11], self->lastRms[12], self->lastRms[13], self->lastRms[14], self->lastRms[15]);
+            break;
     }
 }
 
 void
 Server_process_time(Server *server)
 {
-    int hours, minutes, seconds, milliseconds;
-    float sr = server->samplingRate;
-    double sampsToSecs;
-
     if (server->tcount <= server->timePass)
     {
         server->tcount++;
     }
     else
     {
-        sampsToSecs = (double)(server->elapsedSamples / sr);
-        seconds = (int)sampsToSecs;
-        milliseconds = (int)((sampsToSecs - seconds) * 1000);
-        minutes = seconds / 60;
-        hours = minutes / 60;
-        minutes = minutes % 60;
-        seconds = seconds % 60;
-        PyObject_CallMethod((PyObject *)server->TIME, "setTime", "iiii", hours, minutes, seconds, milliseconds);
+        if (server->gilFree)
+            Server_deferCall(server, NULL, PyoDeferTime);
+        else
+            Server_send_time(server);
+
         server->tcount = 0;
     }
 }
 
+void
+Server_send_time(Server *self)
+{
+    int hours, minutes, seconds, milliseconds;
+    float sr = self->samplingRate;
+    double sampsToSecs;
+
+    sampsToSecs = (double)(self->elapsedSamples / sr);
+    seconds = (int)sampsToSecs;
+    milliseconds = (int)((sampsToSecs - seconds) * 1000);
+    minutes = seconds / 60;
+    hours = minutes / 60;
+    minutes = minutes % 60;
+    seconds = seconds % 60;
+    PyObject_CallMethod((PyObject *)self->TIME, "setTime", "iiii", hours, minutes, seconds, milliseconds);
+}
+
 static int
 Server_traverse(Server *self, visitproc visit, void *arg)
 {
@@ -616,7 +1011,6 @@ Server_traverse(Server *self, visitproc visit, void *arg)
     if (self->CALLBACK != NULL)
         Py_VISIT(self->CALLBACK);
 
-    Py_VISIT(self->streams);
     Py_VISIT(self->jackInputPortNames);
     Py_VISIT(self->jackOutputPortNames);
     Py_VISIT(self->jackMidiInputPortName);
@@ -637,7 +1031,6 @@ Server_clear(Server *self)
     if (self->CALLBACK != NULL)
         Py_CLEAR(self->CALLBACK);
 
-    Py_CLEAR(self->streams);
     Py_CLEAR(self->jackInputPortNames);
     Py_CLEAR(self->jackOutputPortNames);
     Py_CLEAR(self->jackMidiInputPortName);
@@ -656,9 +1049,24 @@ Server_dealloc(Server* self)
         Server_shutdown(self);
 
     Server_clear(self);
+    Server_stop_control_thread(self);
+    Server_stop_rec_internal(self);
     PyMem_RawFree(self->input_buffer);
     PyMem_RawFree(self->output_buffer);
+    PyMem_RawFree(self->planar_output_buffer);
+    PyMem_RawFree(self->mix_buffer);
+    PyMem_RawFree(self->amp_buffer);
     PyMem_RawFree(self->serverName);
+    PyMem_RawFree(self->stream_array);
+    PyMem_RawFree(self->stream_moves);
+    pthread_mutex_destroy(&self->stream_lock);
+    pthread_mutex_destroy(&self->rec_lock);
+
+    if (self->scheduler != NULL)
+        Scheduler_free(self->scheduler);
+
+    if (self->bufferpool != NULL)
+        BufferPool_free(self->bufferpool);
 
     if (self->withGUI == 1)
         PyMem_RawFree(self->lastRms);
@@ -713,7 +1121,34 @@ Server_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->serverName = (char *) PyMem_RawCalloc(32, sizeof(char));
     self->jackautoin = 1;
     self->jackautoout = 1;
-    self->streams = PyList_New(0);
+    self->stream_array = NULL;
+    self->stream_array_size = 0;
+    self->stream_holes = 0;
+    self->stream_iterating = 0;
+    self->stream_moves = NULL;
+    self->stream_moves_count = self->stream_moves_size = 0;
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&self->stream_lock, &attr);
+    pthread_mutexattr_destroy(&attr);
+    self->gilFree = 0;
+    self->deferredHead = self->deferredTail = 0;
+    self->deferredOverflows = self->deferredOverflowsReported = 0;
+    self->lockMisses = self->lockMissesReported = 0;
+    self->ctlThreadRunning = 0;
+    self->nworkers = 0;
+    self->scheduler = NULL;
+    self->bufferpool = NULL;
+    self->multichannel = 0;
+    self->coeffrate = 1;
+    self->planar_output_buffer = NULL;
+    self->mix_buffer = NULL;
+    self->amp_buffer = NULL;
+    mixbus_init();
+    muladd_init();
+    grainkernel_init();
+    oscillatorbank_init();
     self->jackInputPortNames = PyBytes_FromString("");
     self->jackOutputPortNames = PyBytes_FromString("");
     self->jackMidiInputPortName = PyBytes_FromString("");
@@ -729,6 +1164,10 @@ Server_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->nchnls = 2;
     self->ichnls = 2;
     self->record = 0;
+    self->recstream = NULL;
+    self->recbufsize = PYO_DISK_RING_FRAMES;
+    self->recoverruns = 0;
+    pthread_mutex_init(&self->rec_lock, NULL);
     self->bufferSize = 256;
     self->currentResampling = 1;
     self->lastResampling = 1;
@@ -1254,134 +1693,326 @@ Server_setIsJackTransportSlave(Server *self, PyObject *arg)
             self->isJackTransportSlave = PyLong_AsLong(arg);
     }
 
-    Py_RETURN_NONE;
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+Server_setGlobalSeed(Server *self, PyObject *arg)
+{
+    self->globalSeed = 0;
+
+    if (arg != NULL && PyLong_Check(arg))
+    {
+        self->globalSeed = (int)PyLong_AsLong(arg);
+        self->globalSeed = self->globalSeed > 0 ? self->globalSeed : 0;
+    }
+
+    Py_RETURN_NONE;
+}
+
+int
+Server_generateSeed(Server *self, int oid)
+{
+    unsigned int curseed, count, mult, ltime;
+
+    count = ++rnd_objs_count[oid];
+    mult = rnd_objs_mult[oid];
+
+    if (self->globalSeed > 0)
+    {
+        curseed = (self->globalSeed + count * mult) % PYO_RAND_MAX;
+    }
+    else
+    {
+        ltime = (unsigned int)time(NULL);
+        curseed = (ltime * ltime + count * mult) % PYO_RAND_MAX;
+    }
+
+    PYO_RAND_SEED = curseed;
+
+    return 0;
+}
+
+static PyObject *
+Server_setAmp(Server *self, PyObject *arg)
+{
+    if (arg != NULL)
+    {
+        int check = PyNumber_Check(arg);
+
+        if (check)
+        {
+            self->amp = PyFloat_AsDouble(arg);
+
+            if (self->amp != 0.0)
+                self->resetAmp = self->amp;
+        }
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+Server_setAmpCallable(Server *self, PyObject *arg)
+{
+    int i;
+
+    ASSERT_ARG_NOT_NULL
+
+    Py_XDECREF(self->GUI);
+    self->GUI = arg;
+    Py_INCREF(self->GUI);
+
+    self->lastRms = (float *)PyMem_RawRealloc(self->lastRms, self->nchnls * sizeof(float));
+
+    for (i = 0; i < self->nchnls; i++)
+    {
+        self->lastRms[i] = 0.0;
+    }
+
+    for (i = 1; i < 100; i++)
+    {
+        if ((self->bufferSize * i / self->samplingRate) > 0.045)
+        {
+            self->numPass = i;
+            break;
+        }
+    }
+
+    self->gcount = 0;
+    self->withGUI = 1;
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+Server_setTimeCallable(Server *self, PyObject *arg)
+{
+    int i;
+
+    ASSERT_ARG_NOT_NULL
+
+    Py_XDECREF(self->TIME);
+    self->TIME = arg;
+    Py_INCREF(self->TIME);
+
+    for (i = 1; i < 100; i++)
+    {
+        if ((self->bufferSize * i / self->samplingRate) > 0.06)
+        {
+            self->timePass = i;
+            break;
+        }
+    }
+
+    self->tcount = 0;
+    self->withTIME = 1;
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+Server_setCallback(Server *self, PyObject *arg)
+{
+    ASSERT_ARG_NOT_NULL
+
+    Py_XDECREF(self->CALLBACK);
+    self->CALLBACK = arg;
+    Py_INCREF(self->CALLBACK);
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+Server_setGILFree(Server *self, PyObject *arg)
+{
+    if (arg != NULL && PyLong_Check(arg))
+    {
+        int gilfree = PyLong_AsLong(arg) != 0;
+
+        if (gilfree == self->gilFree)
+            Py_RETURN_NONE;
+
+        if (gilfree)
+        {
+            self->gilFree = 1;
+
+            if (self->server_started)
+                Server_start_control_thread(self);
+        }
+        else
+        {
+            /* Wait for the audio thread to leave the GIL-free section. */
+            Server_lock_streams(self);
+            self->gilFree = 0;
+            Server_unlock_streams(self);
+            Server_stop_control_thread(self);
+        }
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+Server_getGILFreeMode(Server *self)
+{
+    return PyLong_FromLong(self->gilFree);
+}
+
+static PyObject *
+Server_getArenaStats(Server *self)
+{
+    ArenaStats stats;
+
+    arena_get_stats(&stats);
+
+    return Py_BuildValue("{s:n,s:n,s:n,s:n,s:n,s:n}", "used", (Py_ssize_t)stats.used, "peak", (Py_ssize_t)stats.peak,
+                         "reserved", (Py_ssize_t)stats.reserved, "blocks", (Py_ssize_t)stats.blocks,
+                         "slabs", (Py_ssize_t)stats.slabs, "large", (Py_ssize_t)stats.large);
 }
 
 static PyObject *
-Server_setGlobalSeed(Server *self, PyObject *arg)
+Server_setNumWorkers(Server *self, PyObject *arg)
 {
-    self->globalSeed = 0;
+    int nworkers;
 
     if (arg != NULL && PyLong_Check(arg))
     {
-        self->globalSeed = (int)PyLong_AsLong(arg);
-        self->globalSeed = self->globalSeed > 0 ? self->globalSeed : 0;
+        nworkers = PyLong_AsLong(arg);
+
+        if (nworkers < 0)
+            nworkers = 0;
+
+        /* The audio thread must not be computing the streams. */
+        Server_lock_streams(self);
+
+        if (self->scheduler != NULL)
+        {
+            Scheduler_free(self->scheduler);
+            self->scheduler = NULL;
+        }
+
+        self->nworkers = nworkers;
+
+        if (nworkers > 0)
+        {
+            self->scheduler = Scheduler_new(nworkers);
+            Scheduler_reserve(self->scheduler, self->stream_array_size);
+
+            if (self->scheduler->nworkers != nworkers)
+                Server_warning(self, "Only %d worker threads could be started.\n", self->scheduler->nworkers);
+        }
+
+        Server_unlock_streams(self);
     }
 
     Py_RETURN_NONE;
 }
 
-int
-Server_generateSeed(Server *self, int oid)
+static PyObject *
+Server_getNumWorkers(Server *self)
 {
-    unsigned int curseed, count, mult, ltime;
+    return PyLong_FromLong(self->nworkers);
+}
 
-    count = ++rnd_objs_count[oid];
-    mult = rnd_objs_mult[oid];
+static PyObject *
+Server_setBufferReuse(Server *self, PyObject *arg)
+{
+    int active = PyObject_IsTrue(arg);
 
-    if (self->globalSeed > 0)
+    if (active < 0)
+        return NULL;
+
+    /* The audio thread must not be computing the streams. */
+    Server_lock_streams(self);
+
+    if (active && self->bufferpool == NULL)
     {
-        curseed = (self->globalSeed + count * mult) % PYO_RAND_MAX;
+        self->bufferpool = BufferPool_new();
     }
-    else
+    else if (! active && self->bufferpool != NULL)
     {
-        ltime = (unsigned int)time(NULL);
-        curseed = (ltime * ltime + count * mult) % PYO_RAND_MAX;
+        BufferPool_release(self->bufferpool, self->stream_array, self->stream_count);
+        BufferPool_free(self->bufferpool);
+        self->bufferpool = NULL;
     }
 
-    PYO_RAND_SEED = curseed;
+    Server_unlock_streams(self);
 
-    return 0;
+    Py_RETURN_NONE;
 }
 
 static PyObject *
-Server_setAmp(Server *self, PyObject *arg)
+Server_getBufferReuse(Server *self)
 {
-    if (arg != NULL)
-    {
-        int check = PyNumber_Check(arg);
+    return PyBool_FromLong(self->bufferpool != NULL);
+}
 
-        if (check)
-        {
-            self->amp = PyFloat_AsDouble(arg);
+static PyObject *
+Server_setMultichannelStreams(Server *self, PyObject *arg)
+{
+    int active = PyObject_IsTrue(arg);
 
-            if (self->amp != 0.0)
-                self->resetAmp = self->amp;
-        }
-    }
+    if (active < 0)
+        return NULL;
+
+    self->multichannel = active;
 
     Py_RETURN_NONE;
 }
 
 static PyObject *
-Server_setAmpCallable(Server *self, PyObject *arg)
+Server_getMultichannelStreams(Server *self)
 {
-    int i;
-
-    ASSERT_ARG_NOT_NULL
-
-    Py_XDECREF(self->GUI);
-    self->GUI = arg;
-    Py_INCREF(self->GUI);
+    return PyBool_FromLong(self->multichannel);
+}
 
-    self->lastRms = (float *)PyMem_RawRealloc(self->lastRms, self->nchnls * sizeof(float));
+static PyObject *
+Server_setCoeffRate(Server *self, PyObject *arg)
+{
+    long rate;
 
-    for (i = 0; i < self->nchnls; i++)
+    if (! PyLong_Check(arg))
     {
-        self->lastRms[i] = 0.0;
+        PyErr_SetString(PyExc_TypeError, "Server.setCoeffRate: the rate must be an integer.");
+        return NULL;
     }
 
-    for (i = 1; i < 100; i++)
+    rate = PyLong_AsLong(arg);
+
+    if (rate < 1 || rate > PYO_COEFFRATE_MAX)
     {
-        if ((self->bufferSize * i / self->samplingRate) > 0.045)
-        {
-            self->numPass = i;
-            break;
-        }
+        PyErr_Format(PyExc_ValueError, "Server.setCoeffRate: the rate must be between 1 and %d.", PYO_COEFFRATE_MAX);
+        return NULL;
     }
 
-    self->gcount = 0;
-    self->withGUI = 1;
+    self->coeffrate = (int)rate;
 
     Py_RETURN_NONE;
 }
 
 static PyObject *
-Server_setTimeCallable(Server *self, PyObject *arg)
+Server_getCoeffRate(Server *self)
 {
-    int i;
+    return PyLong_FromLong(self->coeffrate);
+}
 
-    ASSERT_ARG_NOT_NULL
+static PyObject *
+Server_getBufferReuseStats(Server *self)
+{
+    int streams = 0, buffers = 0;
 
-    Py_XDECREF(self->TIME);
-    self->TIME = arg;
-    Py_INCREF(self->TIME);
+    Server_lock_streams(self);
 
-    for (i = 1; i < 100; i++)
+    if (self->bufferpool != NULL && self->bufferpool->built)
     {
-        if ((self->bufferSize * i / self->samplingRate) > 0.06)
-        {
-            self->timePass = i;
-            break;
-        }
+        streams = self->bufferpool->shared;
+        buffers = self->bufferpool->count;
     }
 
-    self->tcount = 0;
-    self->withTIME = 1;
-
-    Py_RETURN_NONE;
-}
-
-static PyObject *
-Server_setCallback(Server *self, PyObject *arg)
-{
-    ASSERT_ARG_NOT_NULL
-
-    Py_XDECREF(self->CALLBACK);
-    self->CALLBACK = arg;
-    Py_INCREF(self->CALLBACK);
+    Server_unlock_streams(self);
 
-    Py_RETURN_NONE;
+    return Py_BuildValue("{s:i,s:i}", "streams", streams, "buffers", buffers);
 }
 
 static PyObject *
@@ -1426,7 +2057,7 @@ Server_allowMicrosoftMidiDevices(Server *self)
 PyObject *
 Server_shutdown(Server *self)
 {
-    int i, ret = -1;
+    int i, count, ret = -1;
     PyGILState_STATE s = 0;
 
     if (self->server_booted == 0)
@@ -1502,15 +2133,25 @@ Server_shutdown(Server *self)
         s = PyGILState_Ensure();
     }
 
-    if (PyList_Size(self->streams) > 0)
+    Server_lock_streams(self);
+
+    if (self->bufferpool != NULL)
+        BufferPool_release(self->bufferpool, self->stream_array, self->stream_count);
+
+    /* Empty the table first, releasing the streams may deallocate objects. */
+    count = self->stream_count;
+    self->stream_count = self->stream_holes = 0;
+
+    for (i = count; i > 0; i--)
     {
-        for (i = PyList_Size(self->streams); i > 0; i--)
+        if (self->stream_array[i - 1] != NULL)
         {
-            PySequence_DelItem(self->streams, i - 1);
+            self->stream_array[i - 1]->slot = -1;
+            Py_DECREF(self->stream_array[i - 1]);
         }
     }
 
-    self->stream_count = 0;
+    Server_unlock_streams(self);
 
     if (self->audio_be_type != PyoEmbedded)
     {
@@ -1532,7 +2173,7 @@ Server_boot(Server *self, PyObject *arg)
     }
 
     self->server_started = 0;
-    self->stream_count = 0;
+    self->stream_count = self->stream_holes = 0;
     self->elapsedSamples = 0;
 
     int needNewBuffer = 0;
@@ -1547,7 +2188,11 @@ Server_boot(Server *self, PyObject *arg)
     }
 
     Server_debug(self, "Streams list size at Server boot (must always be 0) = %d\n",
-                 PyList_Size(self->streams));
+                 self->stream_count);
+    Server_debug(self, "Output mix bus kernels = %s\n", mixbus_name());
+    Server_debug(self, "Mul & add kernels = %s\n", muladd_name());
+    Server_debug(self, "Grain kernels = %s\n", grainkernel_name());
+    Server_debug(self, "Oscillator bank kernels = %s\n", oscillatorbank_name());
 
     switch (self->audio_be_type)
     {
@@ -1647,6 +2292,13 @@ Server_boot(Server *self, PyObject *arg)
         }
 
         self->output_buffer = (float *)PyMem_RawMalloc(self->bufferSize * self->nchnls * sizeof(float));
+
+        PyMem_RawFree(self->planar_output_buffer);
+        PyMem_RawFree(self->mix_buffer);
+        PyMem_RawFree(self->amp_buffer);
+        self->planar_output_buffer = (float *)PyMem_RawCalloc(self->bufferSize * self->nchnls, sizeof(float));
+        self->mix_buffer = (MYFLT *)PyMem_RawCalloc(self->bufferSize * self->nchnls, sizeof(MYFLT));
+        self->amp_buffer = (MYFLT *)PyMem_RawCalloc(self->bufferSize, sizeof(MYFLT));
     }
 
     for (i = 0; i < self->bufferSize * self->ichnls; i++)
@@ -1742,6 +2394,9 @@ Server_start(Server *self)
 
     self->amp = self->resetAmp;
 
+    if (self->gilFree)
+        Server_start_control_thread(self);
+
     switch (self->audio_be_type)
     {
         case PyoPortaudio:
@@ -1836,6 +2491,8 @@ Server_stop(Server *self)
         self->server_started = 0;
     }
 
+    Server_stop_control_thread(self);
+
     if (self->withGUI && PyObject_HasAttrString((PyObject *)self->GUI, "setStartButtonState"))
         PyObject_CallMethod((PyObject *)self->GUI, "setStartButtonState", "i", 0);
 
@@ -1877,6 +2534,11 @@ Server_start_rec(Server *self, PyObject *args, PyObject *kwds)
 int
 Server_start_rec_internal(Server *self, char *filename)
 {
+    PyoDiskStream *stream;
+
+    if (self->recstream != NULL)
+        Server_stop_rec_internal(self);
+
     /* Prepare sfinfo */
     self->recinfo.samplerate = (int)self->samplingRate;
     self->recinfo.channels = self->nchnls;
@@ -1985,23 +2647,127 @@ Server_start_rec_internal(Server *self, char *filename)
         sf_command(self->recfile, SFC_SET_VBR_ENCODING_QUALITY, &self->recquality, sizeof(double));
     }
 
+    /* Non real time servers wait for the disk instead of dropping blocks. */
+    stream = DiskStream_new(self->recfile, self->nchnls, sizeof(float), self->recbufsize, Server_isNonRealTime(self));
+
+    if (stream == NULL)
+    {
+        Server_error(self, "Not able to start the disk writer thread.\n");
+        sf_close(self->recfile);
+        return -1;
+    }
+
+    pthread_mutex_lock(&self->rec_lock);
+    self->recstream = stream;
     self->record = 1;
+    pthread_mutex_unlock(&self->rec_lock);
+
     return 0;
 }
 
+/* Stops the recording and waits for the disk writer thread to close the file. */
+void
+Server_stop_rec_internal(Server *self)
+{
+    unsigned long overruns;
+    PyoDiskStream *stream;
+
+    pthread_mutex_lock(&self->rec_lock);
+    self->record = 0;
+    stream = self->recstream;
+    self->recstream = NULL;
+    pthread_mutex_unlock(&self->rec_lock);
+
+    if (stream == NULL)
+        return;
+
+    overruns = DiskStream_close(stream);
+
+    if (overruns > 0)
+    {
+        Server_warning(self, "Recording: %lu blocks dropped, the disk was too slow (see Server.setRecordBufferSize).\n", overruns);
+        self->recoverruns += overruns;
+    }
+}
+
 static PyObject *
 Server_stop_rec(Server *self, PyObject *args)
 {
-    self->record = 0;
-    sf_close(self->recfile);
+    Server_stop_rec_internal(self);
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+Server_setRecordBufferSize(Server *self, PyObject *arg)
+{
+    if (arg != NULL && PyLong_Check(arg))
+    {
+        self->recbufsize = PyLong_AsLong(arg);
+
+        if (self->recbufsize < self->bufferSize)
+            self->recbufsize = self->bufferSize;
+    }
 
     Py_RETURN_NONE;
 }
 
+static PyObject *
+Server_getRecordBufferSize(Server *self)
+{
+    return PyLong_FromLong(self->recbufsize);
+}
+
+static PyObject *
+Server_getRecordOverruns(Server *self)
+{
+    unsigned long overruns;
+
+    pthread_mutex_lock(&self->rec_lock);
+    overruns = self->recoverruns + DiskStream_getOverruns(self->recstream);
+    pthread_mutex_unlock(&self->rec_lock);
+
+    return PyLong_FromUnsignedLong(overruns);
+}
+
+/* Removes the holes left by the removed streams. Must not be called
+   while the audio thread iterates over the streams. */
+static void
+Server_compactStreams(Server *self)
+{
+    int i, j = 0;
+
+    for (i = 0; i < self->stream_count; i++)
+    {
+        if (self->stream_array[i] != NULL)
+        {
+            self->stream_array[j] = self->stream_array[i];
+            self->stream_array[j]->slot = j;
+            j++;
+        }
+    }
+
+    self->stream_count = j;
+    self->stream_holes = 0;
+}
+
+static void
+Server_growStreams(Server *self)
+{
+    if (self->stream_count >= self->stream_array_size)
+    {
+        self->stream_array_size = self->stream_array_size == 0 ? 256 : self->stream_array_size * 2;
+        self->stream_array = (Stream **)PyMem_RawRealloc(self->stream_array, self->stream_array_size * sizeof(Stream *));
+
+        if (self->scheduler != NULL)
+            Scheduler_reserve(self->scheduler, self->stream_array_size);
+    }
+}
+
 static PyObject *
 Server_addStream(Server *self, PyObject *args)
 {
-    PyObject *streamtmp;
+    Stream *streamtmp;
 
     if (! PyArg_ParseTuple(args, "O", &streamtmp))
         return PyLong_FromLong(-1);
@@ -2012,21 +2778,31 @@ Server_addStream(Server *self, PyObject *args)
         return PyLong_FromLong(-1);
     }
 
-    int sid = Stream_getStreamId((Stream *)streamtmp);
-    Server_debug(self, "Added stream id %d\n", sid);
+    Server_debug(self, "Added stream id %d\n", Stream_getStreamId(streamtmp));
 
-    PyList_Append(self->streams, streamtmp);
+    Server_lock_streams(self);
 
-    self->stream_count++;
+    if (self->stream_holes > (self->stream_count >> 1) && ! self->stream_iterating)
+        Server_compactStreams(self);
+
+    Server_growStreams(self);
+
+    Py_INCREF(streamtmp);
+    streamtmp->slot = self->stream_count;
+    self->stream_array[self->stream_count++] = streamtmp;
+    Stream_invalidateGraph();
+
+    Server_unlock_streams(self);
 
     Py_RETURN_NONE;
 }
 
-PyObject *
-Server_removeStream(Server *self, int id)
+/* Called by the objects when they are deallocated. The slot is
+   emptied, the array is compacted at the beginning of the next block. */
+void
+Server_removeStream(Server *self, Stream *stream)
 {
-    int i, sid;
-    Stream *stream_tmp;
+    int slot;
     PyGILState_STATE s = 0;
 
     if (self->audio_be_type != PyoEmbedded)
@@ -2034,74 +2810,172 @@ Server_removeStream(Server *self, int id)
         s = PyGILState_Ensure();
     }
 
-    if (my_server[self->thisServerID] != NULL && PySequence_Size(self->streams) != -1)
+    if (my_server[self->thisServerID] != NULL)
     {
-        for (i = 0; i < self->stream_count; i++)
-        {
-            stream_tmp = (Stream *)PyList_GetItem(self->streams, i);
+        Server_lock_streams(self);
 
-            if (stream_tmp != NULL)
-            {
-                sid = Stream_getStreamId(stream_tmp);
+        slot = stream->slot;
 
-                if (sid == id)
-                {
-                    Server_debug(self, "Removed stream id %d\n", id);
-                    PySequence_DelItem(self->streams, i);
-                    self->stream_count--;
-                    break;
-                }
-            }
+        if (slot >= 0 && slot < self->stream_count && self->stream_array[slot] == stream)
+        {
+            Server_debug(self, "Removed stream id %d\n", Stream_getStreamId(stream));
+            Server_purgeDeferredCalls(self, stream);
+            Server_purgeStreamMoves(self, stream);
+            BufferPool_detach(stream);
+            Stream_invalidateGraph();
+            self->stream_array[slot] = NULL;
+            self->stream_holes++;
+            stream->slot = -1;
+            Py_DECREF(stream);
         }
+
+        Server_unlock_streams(self);
     }
 
     if (self->audio_be_type != PyoEmbedded)
     {
         PyGILState_Release(s);
     }
+}
+
+static PyObject *
+Server_removeStreamObject(Server *self, PyObject *args)
+{
+    PyObject *streamtmp;
+
+    if (! PyArg_ParseTuple(args, "O!", &StreamType, &streamtmp))
+        return NULL;
+
+    Server_removeStream(self, (Stream *)streamtmp);
 
     Py_RETURN_NONE;
 }
 
-PyObject *
-Server_changeStreamPosition(Server *self, PyObject *args)
+/* Moves `cur` just before `ref` in the processing order, or at the end if
+   `ref` is NULL or not registered. The table holds a reference to `cur`,
+   taken by the caller if it was not registered yet. */
+static void
+Server_moveStream(Server *self, Stream *ref, Stream *cur)
 {
-    int i, rsid, csid, sid;
-    Stream *ref_stream_tmp, *cur_stream_tmp, *stream_tmp;
+    int i, cslot, rslot;
 
-    if (! PyArg_ParseTuple(args, "OO", &ref_stream_tmp, &cur_stream_tmp))
-        return PyLong_FromLong(-1);
+    if (self->stream_holes > 0)
+        Server_compactStreams(self);
 
-    rsid = Stream_getStreamId(ref_stream_tmp);
-    csid = Stream_getStreamId(cur_stream_tmp);
+    cslot = cur->slot;
 
-    for (i = 0; i < self->stream_count; i++)
+    if (cslot >= 0 && cslot < self->stream_count && self->stream_array[cslot] == cur)
     {
-        stream_tmp = (Stream *)PyList_GET_ITEM(self->streams, i);
-        sid = Stream_getStreamId(stream_tmp);
+        self->stream_count--;
+        memmove(&self->stream_array[cslot], &self->stream_array[cslot + 1], (self->stream_count - cslot) * sizeof(Stream *));
+    }
+    else
+        cslot = self->stream_count;
 
-        if (sid == csid)
-        {
-            PySequence_DelItem(self->streams, i);
-            self->stream_count--;
-            break;
-        }
+    rslot = ref != NULL ? ref->slot : -1;
+
+    if (rslot > cslot)
+        rslot--;
+
+    if (rslot < 0 || rslot >= self->stream_count || self->stream_array[rslot] != ref)
+        rslot = self->stream_count;
+
+    Server_growStreams(self);
+
+    memmove(&self->stream_array[rslot + 1], &self->stream_array[rslot], (self->stream_count - rslot) * sizeof(Stream *));
+    self->stream_array[rslot] = cur;
+    self->stream_count++;
+
+    for (i = (cslot < rslot ? cslot : rslot); i < self->stream_count; i++)
+        self->stream_array[i]->slot = i;
+
+    Stream_invalidateGraph();
+}
+
+/* Returns true if `stream` is in the table or waits to be moved into it. */
+static int
+Server_isStreamHeld(Server *self, Stream *stream)
+{
+    int i;
+
+    if (stream->slot >= 0 && stream->slot < self->stream_count && self->stream_array[stream->slot] == stream)
+        return 1;
+
+    for (i = 0; i < self->stream_moves_count; i++)
+    {
+        if (self->stream_moves[i].cur == stream)
+            return 1;
     }
 
-    for (i = 0; i < self->stream_count; i++)
+    return 0;
+}
+
+/* Does the reorders asked while the audio thread was iterating over the
+   streams. Called with the streams locked, once the iteration is over. */
+static void
+Server_applyStreamMoves(Server *self)
+{
+    int i;
+
+    for (i = 0; i < self->stream_moves_count; i++)
     {
-        stream_tmp = (Stream *)PyList_GET_ITEM(self->streams, i);
-        sid = Stream_getStreamId(stream_tmp);
+        if (self->stream_moves[i].cur != NULL)
+            Server_moveStream(self, self->stream_moves[i].ref, self->stream_moves[i].cur);
+    }
+
+    self->stream_moves_count = 0;
+}
+
+/* Forgets a removed stream in the deferred reorders. */
+static void
+Server_purgeStreamMoves(Server *self, Stream *stream)
+{
+    int i;
+
+    for (i = 0; i < self->stream_moves_count; i++)
+    {
+        if (self->stream_moves[i].ref == stream)
+            self->stream_moves[i].ref = NULL;
+
+        if (self->stream_moves[i].cur == stream)
+            self->stream_moves[i].cur = NULL;
+    }
+}
+
+/* Puts `cur` just before `ref` in the processing order. While the audio
+   thread iterates over the streams (a callback called during the block),
+   the slots must not move and the reorder is done at the end of the block,
+   like the compaction of the removed streams. */
+PyObject *
+Server_changeStreamPosition(Server *self, PyObject *args)
+{
+    Stream *ref_stream_tmp, *cur_stream_tmp;
 
-        if (sid == rsid)
+    if (! PyArg_ParseTuple(args, "OO", &ref_stream_tmp, &cur_stream_tmp))
+        return PyLong_FromLong(-1);
+
+    Server_lock_streams(self);
+
+    /* Not registered yet, the table takes a reference. */
+    if (! Server_isStreamHeld(self, cur_stream_tmp))
+        Py_INCREF(cur_stream_tmp);
+
+    if (self->stream_iterating)
+    {
+        if (self->stream_moves_count >= self->stream_moves_size)
         {
-            break;
+            self->stream_moves_size = self->stream_moves_size == 0 ? 16 : self->stream_moves_size * 2;
+            self->stream_moves = (PyoStreamMove *)PyMem_RawRealloc(self->stream_moves, self->stream_moves_size * sizeof(PyoStreamMove));
         }
+
+        self->stream_moves[self->stream_moves_count].ref = ref_stream_tmp;
+        self->stream_moves[self->stream_moves_count].cur = cur_stream_tmp;
+        self->stream_moves_count++;
     }
+    else
+        Server_moveStream(self, ref_stream_tmp, cur_stream_tmp);
 
-    Py_INCREF(cur_stream_tmp);
-    PyList_Insert(self->streams, i, (PyObject *)cur_stream_tmp);
-    self->stream_count++;
+    Server_unlock_streams(self);
 
     Py_RETURN_NONE;
 }
@@ -2506,8 +3380,16 @@ Server_getMidiActive(Server *self)
 static PyObject *
 Server_getStreams(Server *self)
 {
-    Py_INCREF(self->streams);
-    return self->streams;
+    int i;
+    PyObject *streams = PyList_New(0);
+
+    for (i = 0; i < self->stream_count; i++)
+    {
+        if (self->stream_array[i] != NULL)
+            PyList_Append(streams, (PyObject *)self->stream_array[i]);
+    }
+
+    return streams;
 }
 
 static PyObject *
@@ -2691,6 +3573,18 @@ static PyMethodDef Server_methods[] =
     {"setTimeCallable", (PyCFunction)Server_setTimeCallable, METH_O, "Sets the Server's TIME callable object."},
     {"setCallback", (PyCFunction)Server_setCallback, METH_O, "Sets the Server's CALLBACK callable object."},
     {"setVerbosity", (PyCFunction)Server_setVerbosity, METH_O, "Sets the verbosity."},
+    {"setGILFree", (PyCFunction)Server_setGILFree, METH_O, "Activates or deactivates GIL-free processing of the audio graph."},
+    {"getGILFree", (PyCFunction)Server_getGILFreeMode, METH_NOARGS, "Returns 1 if GIL-free processing is active, otherwise returns 0."},
+    {"getArenaStats", (PyCFunction)Server_getArenaStats, METH_NOARGS, "Returns the statistics of the sample buffers allocator."},
+    {"setNumWorkers", (PyCFunction)Server_setNumWorkers, METH_O, "Sets the number of threads computing the streams with the audio thread."},
+    {"getNumWorkers", (PyCFunction)Server_getNumWorkers, METH_NOARGS, "Returns the number of threads computing the streams with the audio thread."},
+    {"setBufferReuse", (PyCFunction)Server_setBufferReuse, METH_O, "Activates the sharing of the stream buffers."},
+    {"getBufferReuse", (PyCFunction)Server_getBufferReuse, METH_NOARGS, "Returns True if the streams share their buffers."},
+    {"getBufferReuseStats", (PyCFunction)Server_getBufferReuseStats, METH_NOARGS, "Returns the number of streams computed in shared buffers and the number of shared buffers."},
+    {"setMultichannelStreams", (PyCFunction)Server_setMultichannelStreams, METH_O, "Activates the objects computing all their channels at once."},
+    {"getMultichannelStreams", (PyCFunction)Server_getMultichannelStreams, METH_NOARGS, "Returns True if the objects compute all their channels at once."},
+    {"setCoeffRate", (PyCFunction)Server_setCoeffRate, METH_O, "Sets the default update rate of the modulated filter coefficients."},
+    {"getCoeffRate", (PyCFunction)Server_getCoeffRate, METH_NOARGS, "Returns the default update rate of the modulated filter coefficients."},
     {"allowMicrosoftMidiDevices", (PyCFunction)Server_allowMicrosoftMidiDevices, METH_NOARGS, "Allow Microsoft Midi Mapper or GS Wavetable Synth devices."},
     {"setStartOffset", (PyCFunction)Server_setStartOffset, METH_O, "Sets starting time offset."},
     {"boot", (PyCFunction)Server_boot, METH_O, "Setup and boot the server."},
@@ -2700,8 +3594,11 @@ static PyMethodDef Server_methods[] =
     {"recordOptions", (PyCFunction)Server_recordOptions, METH_VARARGS | METH_KEYWORDS, "Sets format settings for offline rendering and global recording."},
     {"recstart", (PyCFunction)Server_start_rec, METH_VARARGS | METH_KEYWORDS, "Start automatic output recording."},
     {"recstop", (PyCFunction)Server_stop_rec, METH_NOARGS, "Stop automatic output recording."},
+    {"setRecordBufferSize", (PyCFunction)Server_setRecordBufferSize, METH_O, "Sets the size, in frames, of the recording ring buffer."},
+    {"getRecordBufferSize", (PyCFunction)Server_getRecordBufferSize, METH_NOARGS, "Returns the size, in frames, of the recording ring buffer."},
+    {"getRecordOverruns", (PyCFunction)Server_getRecordOverruns, METH_NOARGS, "Returns the number of blocks dropped while recording."},
     {"addStream", (PyCFunction)Server_addStream, METH_VARARGS, "Adds an audio stream to the server."},
-    {"removeStream", (PyCFunction)Server_removeStream, METH_VARARGS, "Removes an audio stream from the server."},
+    {"removeStream", (PyCFunction)Server_removeStreamObject, METH_VARARGS, "Removes an audio stream from the server."},
     {"changeStreamPosition", (PyCFunction)Server_changeStreamPosition, METH_VARARGS, "Puts an audio stream before another one in the stack."},
     {"noteout", (PyCFunction)Server_noteout, METH_VARARGS, "Send a Midi note event to Portmidi output stream."},
     {"afterout", (PyCFunction)Server_afterout, METH_VARARGS, "Send an aftertouch event to Portmidi output stream."},
@@ -2741,7 +3638,6 @@ static PyMethodDef Server_methods[] =
 
 static PyMemberDef Server_members[] =
 {
-    {"streams", T_OBJECT_EX, offsetof(Server, streams), 0, "Server's streams list."},
     {NULL}  /* Sentinel */
 };
 
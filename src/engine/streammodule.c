@@ -25,12 +25,62 @@
 
 int stream_id = 1;
 
+/* Incremented whenever a stream is added or removed, or an object is given
+   a new stream to read, the servers compute their buffer sharing plan
+   again (see bufferpool.c). */
+unsigned int stream_graph_serial = 0;
+
 int
 Stream_getNewStreamId()
 {
     return stream_id++;
 }
 
+void
+Stream_invalidateGraph()
+{
+    stream_graph_serial++;
+}
+
+unsigned int
+Stream_getGraphSerial()
+{
+    return stream_graph_serial;
+}
+
+/* Returns a new array (PyMem_RawMalloc) with the streams of the audio
+   objects of `list`, or NULL if one of them has no stream. The pointers
+   are borrowed: an object frees its stream when it is deallocated, the
+   streams live as long as the objects of the list. */
+Stream **
+Stream_getListStreams(PyObject *list)
+{
+    Py_ssize_t i, lsize = PyList_Size(list);
+    PyObject *streamtmp;
+    Stream **streams;
+
+    if (lsize < 0)
+        return NULL;
+
+    streams = (Stream **)PyMem_RawMalloc((lsize + 1) * sizeof(Stream *));
+
+    for (i = 0; i < lsize; i++)
+    {
+        streamtmp = PyObject_CallMethod(PyList_GET_ITEM(list, i), "_getStream", NULL);
+
+        if (streamtmp == NULL)
+        {
+            PyMem_RawFree(streams);
+            return NULL;
+        }
+
+        streams[i] = (Stream *)streamtmp;
+        Py_DECREF(streamtmp);
+    }
+
+    return streams;
+}
+
 static int
 Stream_traverse(Stream *self, visitproc visit, void *arg)
 {
@@ -109,7 +159,21 @@ void Stream_setFunctionPtr(Stream *self, void *ptr)
 
 void Stream_callFunction(Stream *self)
 {
+    self->state = PYO_STREAM_VARYING;
+    self->computing = 1;
     (*self->funcptr)(self->streamobject);
+    self->computing = 0;
+}
+
+void Stream_setCallbackPtr(Stream *self, void *ptr)
+{
+    self->callbackptr = ptr;
+}
+
+void Stream_callCallback(Stream *self)
+{
+    if (self->callbackptr != NULL)
+        (*self->callbackptr)(self->streamobject);
 }
 
 void Stream_IncrementBufferCount(Stream *self)
@@ -134,9 +198,143 @@ void Stream_IncrementDurationCount(Stream *self)
     }
 }
 
+/* Same as Stream_IncrementDurationCount but without calling into Python.
+   Returns 1 when the stream should be stopped by the caller. */
+int Stream_IncrementDurationCountDeferred(Stream *self)
+{
+    self->bufferCount++;
+
+    if (self->bufferCount >= self->duration)
+    {
+        self->duration = self->bufferCount = 0;
+        return 1;
+    }
+
+    return 0;
+}
+
+static void
+Stream_fill(MYFLT *data, MYFLT value, int size)
+{
+    int i;
+
+    for (i = 0; i < size; i++)
+        data[i] = value;
+}
+
+/* Applies mul and add to `data`, a buffer of `size` samples whose state
+   is `xstate`, and returns the state of the result. mul and add are given
+   either as buffers with their state or, when the buffer is NULL, as
+   floats. Constant buffers take the kernels for floats, and when the
+   buffer or mul is silent, the result is simply the add values. */
+int
+Stream_mulAddBuffer(MYFLT *data, int size, int xstate, MYFLT *m, MYFLT mul, int mstate,
+                    MYFLT *a, MYFLT add, int astate, int flags)
+{
+    int i, state;
+
+    if (m != NULL)
+        mul = m[0];
+
+    if (a != NULL)
+        add = a[0];
+
+    if (flags & PYO_MULADD_REVADD)
+        add = -add;
+
+    /* x * 0 + add or 0 / mul + add. */
+    if (xstate == PYO_STREAM_SILENT || (mstate == PYO_STREAM_SILENT && !(flags & PYO_MULADD_REVMUL)))
+    {
+        if (astate != PYO_STREAM_VARYING)
+            Stream_fill(data, add, size);
+        else if (flags & PYO_MULADD_REVADD)
+        {
+            for (i = 0; i < size; i++)
+                data[i] = -a[i];
+        }
+        else
+            memcpy(data, a, size * sizeof(MYFLT));
+
+        return astate;
+    }
+
+    if (mstate != PYO_STREAM_VARYING && xstate == PYO_STREAM_CONSTANT && astate != PYO_STREAM_VARYING)
+        state = PYO_STREAM_CONSTANT;
+    else
+        state = PYO_STREAM_VARYING;
+
+    if (flags & PYO_MULADD_REVMUL)
+    {
+        if (astate != PYO_STREAM_VARYING)
+            muladd_revai(data, m, add, size);
+        else if (flags & PYO_MULADD_REVADD)
+            muladd_revareva(data, m, a, size);
+        else
+            muladd_revaa(data, m, a, size);
+    }
+    else if (mstate != PYO_STREAM_VARYING)
+    {
+        if (astate != PYO_STREAM_VARYING)
+        {
+            if (mul != 1 || add != 0)
+                muladd_ii(data, mul, add, size);
+        }
+        else if (flags & PYO_MULADD_REVADD)
+            muladd_ireva(data, mul, a, size);
+        else
+            muladd_ia(data, mul, a, size);
+    }
+    else
+    {
+        if (astate != PYO_STREAM_VARYING)
+            muladd_ai(data, m, add, size);
+        else if (flags & PYO_MULADD_REVADD)
+            muladd_areva(data, m, a, size);
+        else
+            muladd_aa(data, m, a, size);
+    }
+
+    return state;
+}
+
+/* Applies mul and add to `data`, the buffer of the stream `self`, and
+   tags the stream with the state of the result. mul and add are given
+   either as streams or, when the stream is NULL, as floats. The tag of
+   the buffer is only read when the stream is computed by the server, an
+   object computed directly (from its constructor, ...) may still carry
+   the silent tag of a new or stopped stream and is taken as varying. */
+void
+Stream_mulAdd(Stream *self, MYFLT *data, int size, Stream *mul_stream, MYFLT mul, Stream *add_stream, MYFLT add, int flags)
+{
+    int mstate, astate;
+    MYFLT *m = NULL, *a = NULL;
+
+    if (mul_stream == NULL)
+        mstate = mul == 0 ? PYO_STREAM_SILENT : PYO_STREAM_CONSTANT;
+    else
+    {
+        mstate = mul_stream->state;
+        m = mul_stream->data;
+    }
+
+    if (add_stream == NULL)
+        astate = add == 0 ? PYO_STREAM_SILENT : PYO_STREAM_CONSTANT;
+    else
+    {
+        astate = add_stream->state;
+        a = add_stream->data;
+    }
+
+    self->state = Stream_mulAddBuffer(data, size, self->computing ? self->state : PYO_STREAM_VARYING,
+                                      m, mul, mstate, a, add, astate, flags);
+}
+
 static PyObject *
 Stream_getValue(Stream *self)
 {
+    if (self->shared)
+        return Py_BuildValue(TYPE_F, self->state == PYO_STREAM_SILENT ? 0.0 : self->last);
+
     return Py_BuildValue(TYPE_F, self->data[self->bufsize - 1]);
 }
 
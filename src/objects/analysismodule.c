@@ -1667,7 +1667,7 @@ typedef struct
     MYFLT centroid;
     MYFLT *inframe;
     MYFLT *outframe;
-    MYFLT **twiddle;
+    PyoFFTPlan *plan;
     MYFLT *input_buffer;
     MYFLT *window;
     int modebuffer[2];
@@ -1676,9 +1676,8 @@ typedef struct
 static void
 Centroid_alloc_memories(Centroid *self)
 {
-    int i, n8;
+    int i;
     self->hsize = self->size / 2;
-    n8 = self->size >> 3;
     self->inframe = (MYFLT *)PyMem_RawRealloc(self->inframe, self->size * sizeof(MYFLT));
     self->outframe = (MYFLT *)PyMem_RawRealloc(self->outframe, self->size * sizeof(MYFLT));
     self->input_buffer = (MYFLT *)PyMem_RawRealloc(self->input_buffer, self->size * sizeof(MYFLT));
@@ -1686,12 +1685,8 @@ Centroid_alloc_memories(Centroid *self)
     for (i = 0; i < self->size; i++)
         self->inframe[i] = self->outframe[i] = self->input_buffer[i] = 0.0;
 
-    self->twiddle = (MYFLT **)PyMem_RawRealloc(self->twiddle, 4 * sizeof(MYFLT *));
-
-    for (i = 0; i < 4; i++)
-        self->twiddle[i] = (MYFLT *)PyMem_RawMalloc(n8 * sizeof(MYFLT));
-
-    fft_compute_split_twiddle(self->twiddle, self->size);
+    fft_plan_release(self->plan);
+    self->plan = fft_plan_acquire(self->size, PYO_FFT_REAL);
     self->window = (MYFLT *)PyMem_RawRealloc(self->window, self->size * sizeof(MYFLT));
     gen_window(self->window, self->size, 2);
 }
@@ -1719,7 +1714,7 @@ Centroid_process_i(Centroid *self)
                 self->inframe[i] = self->input_buffer[i] * self->window[i];
             }
 
-            realfft_split(self->inframe, self->outframe, self->size, self->twiddle);
+            fft_plan_forward(self->plan, self->inframe, self->outframe);
             sum1 = sum2 = 0.0;
 
             for (i = 1; i < self->hsize; i++)
@@ -1831,18 +1826,12 @@ Centroid_clear(Centroid *self)
 static void
 Centroid_dealloc(Centroid* self)
 {
-    int i;
     pyo_DEALLOC
     PyMem_RawFree(self->inframe);
     PyMem_RawFree(self->outframe);
     PyMem_RawFree(self->input_buffer);
 
-    for (i = 0; i < 4; i++)
-    {
-        PyMem_RawFree(self->twiddle[i]);
-    }
-
-    PyMem_RawFree(self->twiddle);
+    fft_plan_release(self->plan);
     PyMem_RawFree(self->window);
     Centroid_clear(self);
     Py_TYPE(self->stream)->tp_free((PyObject*)self->stream);
@@ -2644,6 +2633,7 @@ Scope_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, Scope_compute_next_data_frame);
+    Stream_setNeedGIL(self->stream, 1);
 
     static char *kwlist[] = {"input", "length", NULL};
 
@@ -119,6 +119,16 @@ typedef struct t_expr
     MYFLT result2;
 } expr;
 
+/* Block instruction: computes the values of the node `node` for a whole
+   block, from the blocks `in` (unused ones point to zeros) into `out`. */
+typedef struct
+{
+    int op;
+    int node;
+    MYFLT *out;
+    MYFLT *in[3];
+} expr_instr;
+
 typedef struct
 {
     pyo_audio_HEAD
@@ -127,9 +137,21 @@ typedef struct
     int count;
     int chnls;
     MYFLT oneOverSr;
-    MYFLT *input_buffer;
+    MYFLT *input_buffer; // previous and current blocks of each input
     MYFLT *output_buffer;
+    Stream **input_streams;
+    int inputsize;
     expr lexp[1024];
+    /* Compiled program, see Exprer_compile. */
+    expr_instr lcode[1024];
+    int ncode;
+    MYFLT *lreg[1024]; // block of values of each node computed by block
+    int lscalar[1024]; // nodes interpreted sample by sample, in order
+    int nscalar;
+    int lpublish[1024]; // block nodes read by the nodes interpreted
+    int npublish;
+    int yread; // the program reads its own outputs ($y)
+    MYFLT *registers;
 } Exprer;
 
 void
@@ -280,17 +302,678 @@ print_expr(expr ex, int node)
     PySys_WriteStdout("\n\n");
 }
 
+/* Arguments of a node, in the order Exprer_process reads them. */
+#define EXPR_ARG_NODE 0
+#define EXPR_ARG_VAR 1
+#define EXPR_ARG_INPUT 2
+#define EXPR_ARG_OUTPUT 3
+#define EXPR_ARG_VALUE 4
+
+static int
+expr_argkind(expr *ex, int k)
+{
+    if (ex->nodes[k] != -1)
+        return EXPR_ARG_NODE;
+    else if (ex->vars[k] != -1)
+        return EXPR_ARG_VAR;
+    else if (ex->input[k] < 1)
+        return EXPR_ARG_INPUT;
+    else if (ex->output[k] < 0)
+        return EXPR_ARG_OUTPUT;
+
+    return EXPR_ARG_VALUE;
+}
+
+/* Node read by the argument k, or -1. */
+static int
+expr_argref(expr *ex, int k)
+{
+    if (ex->nodes[k] != -1)
+        return ex->nodes[k];
+
+    return ex->vars[k];
+}
+
+static MYFLT
+expr_wrap(MYFLT x)
+{
+    while (x < 0.0) {x += 1.0; }
+
+    while (x >= 1.0) {x -= 1.0; }
+
+    return x;
+}
+
+/* Operators without state, a function of their arguments a, b and c. */
+#define EXPR_PURE_OPS \
+    EXPR_OP(OP_ADD, a + b) \
+    EXPR_OP(OP_SUB, a - b) \
+    EXPR_OP(OP_MUL, a * b) \
+    EXPR_OP(OP_DIV, a / b) \
+    EXPR_OP(OP_EXP, MYPOW(a, b)) \
+    EXPR_OP(OP_MOD, MYFMOD(a, b)) \
+    EXPR_OP(OP_NEG, -a) \
+    EXPR_OP(OP_SIN, MYSIN(a)) \
+    EXPR_OP(OP_COS, MYCOS(a)) \
+    EXPR_OP(OP_TAN, MYTAN(a)) \
+    EXPR_OP(OP_TANH, MYTANH(a)) \
+    EXPR_OP(OP_ATAN, MYATAN(a)) \
+    EXPR_OP(OP_ATAN2, MYATAN2(a, b)) \
+    EXPR_OP(OP_LT, a < b ? 1.0 : 0.0) \
+    EXPR_OP(OP_LE, a <= b ? 1.0 : 0.0) \
+    EXPR_OP(OP_GT, a > b ? 1.0 : 0.0) \
+    EXPR_OP(OP_GE, a >= b ? 1.0 : 0.0) \
+    EXPR_OP(OP_EQ, a == b ? 1.0 : 0.0) \
+    EXPR_OP(OP_NE, a != b ? 1.0 : 0.0) \
+    EXPR_OP(OP_IF, a != 0 ? b : c) \
+    EXPR_OP(OP_AND, a != 0 && b != 0 ? 1.0 : 0.0) \
+    EXPR_OP(OP_OR, a != 0 || b != 0 ? 1.0 : 0.0) \
+    EXPR_OP(OP_SQRT, MYSQRT(a)) \
+    EXPR_OP(OP_LOG, MYLOG(a)) \
+    EXPR_OP(OP_LOG2, MYLOG2(a)) \
+    EXPR_OP(OP_LOG10, MYLOG10(a)) \
+    EXPR_OP(OP_POW, MYPOW(a, b)) \
+    EXPR_OP(OP_FABS, MYFABS(a)) \
+    EXPR_OP(OP_FLOOR, MYFLOOR(a)) \
+    EXPR_OP(OP_CEIL, MYCEIL(a)) \
+    EXPR_OP(OP_EEXP, MYEXP(a)) \
+    EXPR_OP(OP_ROUND, MYROUND(a)) \
+    EXPR_OP(OP_MIN, a < b ? a : b) \
+    EXPR_OP(OP_MAX, a > b ? a : b) \
+    EXPR_OP(OP_WRAP, expr_wrap(a)) \
+    EXPR_OP(OP_PI, PI) \
+    EXPR_OP(OP_TWOPI, TWOPI) \
+    EXPR_OP(OP_E, E) \
+    EXPR_OP(OP_SR, self->sr)
+
+static int
+expr_ispure(int op)
+{
+    switch (op)
+    {
+#define EXPR_OP(op, f) case op:
+        EXPR_PURE_OPS
+#undef EXPR_OP
+            return 1;
+    }
+
+    return 0;
+}
+
+/* Value of a pure operator whose arguments are all constants. */
+static MYFLT
+Exprer_fold(Exprer *self, int op, MYFLT a, MYFLT b, MYFLT c)
+{
+    MYFLT result = 0.0;
+
+    switch (op)
+    {
+#define EXPR_OP(op, f) case op: result = (f); break;
+        EXPR_PURE_OPS
+#undef EXPR_OP
+    }
+
+    return result;
+}
+
+/* Block of the input `chnl` delayed by `delay` samples, the previous block
+   being kept just before the current one. NULL if there is no such input. */
+static MYFLT *
+Exprer_inputBlock(Exprer *self, int chnl, int delay)
+{
+    if (chnl < 0 || chnl >= self->inputsize)
+        return NULL;
+
+    return self->input_buffer + (2 * chnl + 1) * self->bufsize - (delay % self->bufsize);
+}
+
+/* Runs a block instruction. The stateful operators keep their state in the
+   node, as when interpreted sample by sample. */
+static void
+Exprer_runBlock(Exprer *self, expr_instr *instr)
+{
+    int i, chnl, n = self->bufsize;
+    MYFLT a, b, c, tmp;
+    MYFLT *out = instr->out, *x0 = instr->in[0], *x1 = instr->in[1], *x2 = instr->in[2];
+    expr *ex = &self->lexp[instr->node];
+
+    switch (instr->op)
+    {
+#define EXPR_OP(op, f) \
+        case op: \
+            for (i = 0; i < n; i++) \
+            { \
+                a = x0[i]; b = x1[i]; c = x2[i]; \
+                out[i] = (f); \
+            } \
+            break;
+        EXPR_PURE_OPS
+#undef EXPR_OP
+
+        case OP_CONST: // var, set between blocks
+            a = ex->values[0];
+
+            for (i = 0; i < n; i++)
+                out[i] = a;
+
+            break;
+
+        case OP_INC:
+            for (i = 0; i < n; i++)
+            {
+                a = x0[i]; b = x1[i];
+                out[i] = ex->previous[0];
+                ex->previous[0] = MYFMOD(ex->previous[0] + a, b);
+            }
+
+            ex->result = out[n - 1];
+            break;
+
+        case OP_DEC:
+            tmp = ex->result;
+
+            for (i = 0; i < n; i++)
+            {
+                tmp -= x0[i];
+
+                if (tmp < 0) { tmp += x1[i]; }
+
+                out[i] = tmp;
+            }
+
+            ex->result = tmp;
+            break;
+
+        case OP_PHS:
+            for (i = 0; i < n; i++)
+            {
+                a = x0[i]; b = x1[i];
+                tmp = ex->previous[0] + b;
+
+                if (tmp >= 1) { tmp -= 1.0; }
+
+                out[i] = tmp;
+                ex->previous[0] += (a * self->oneOverSr);
+
+                if (ex->previous[0] >= 1) { ex->previous[0] -= 1.0; }
+            }
+
+            ex->result = out[n - 1];
+            break;
+
+        case OP_RANDF:
+            for (i = 0; i < n; i++)
+                out[i] = RANDOM_UNIFORM * (x1[i] - x0[i]) + x0[i];
+
+            ex->result = out[n - 1];
+            break;
+
+        case OP_RANDI:
+            for (i = 0; i < n; i++)
+                out[i] = MYFLOOR(RANDOM_UNIFORM * (x1[i] - x0[i]) + x0[i]);
+
+            ex->result = out[n - 1];
+            break;
+
+        case OP_SAH:
+            tmp = ex->result;
+
+            for (i = 0; i < n; i++)
+            {
+                a = x0[i]; b = x1[i];
+                tmp = b < ex->previous[1] ? a : tmp;
+                ex->previous[1] = b;
+                out[i] = tmp;
+            }
+
+            ex->result = tmp;
+            break;
+
+        case OP_RPOLE:
+            tmp = ex->result;
+
+            for (i = 0; i < n; i++)
+            {
+                tmp = x0[i] + tmp * x1[i];
+                out[i] = tmp;
+            }
+
+            ex->result = tmp;
+            break;
+
+        case OP_RZERO:
+            for (i = 0; i < n; i++)
+            {
+                a = x0[i]; b = x1[i];
+                out[i] = a - ex->previous[0] * b;
+                ex->previous[0] = a;
+            }
+
+            ex->result = out[n - 1];
+            break;
+
+        case OP_DELAY:
+            for (i = 0; i < n; i++)
+            {
+                a = x0[i];
+                out[i] = ex->previous[0];
+                ex->previous[0] = a;
+            }
+
+            ex->result = out[n - 1];
+            break;
+
+        case OP_OUT:
+            for (i = 0; i < n; i++)
+            {
+                chnl = (int)x0[i];
+
+                if (chnl >= self->chnls || chnl < 0)
+                    self->output_buffer[i] = x1[i];
+                else
+                    self->output_buffer[chnl * n + i] = x1[i];
+            }
+
+            break;
+    }
+}
+
+/* Workspace of Exprer_compile. Nodes and constants are first given virtual
+   registers, mapped afterwards on the fewest blocks possible. */
+#define EXPR_MAX_VREGS 4100
+
+typedef struct
+{
+    int scalar[1024];
+    int live[1024];
+    int cplx[1024];
+    int isvar[1024];
+    int folded[1024];
+    int published[1024];
+    int stack[1024];
+    int vreg[1024]; // virtual register of the node, -1 for an input block
+    MYFLT *ptr[1024]; // input block of the node
+    MYFLT value[1024]; // value of the folded nodes
+    int in[1024][3];
+    MYFLT *inptr[1024][3];
+    int out[1024];
+    int isconst[EXPR_MAX_VREGS];
+    MYFLT constval[EXPR_MAX_VREGS];
+    int lastuse[EXPR_MAX_VREGS];
+    int phys[EXPR_MAX_VREGS];
+    int freelist[EXPR_MAX_VREGS];
+} expr_compiler;
+
+static int
+expr_constant(expr_compiler *w, int *nv, MYFLT value)
+{
+    int r;
+
+    for (r = 0; r < *nv; r++)
+    {
+        if (w->isconst[r] && w->constval[r] == value)
+            return r;
+    }
+
+    w->isconst[*nv] = 1;
+    w->constval[*nv] = value;
+    w->lastuse[*nv] = -1;
+    return (*nv)++;
+}
+
+/* Compiles the nodes parsed by setExpr. The nodes without sample-level
+   feedback (a variable read before being computed, the outputs read with
+   $y, complex numbers) nor depending on such a node are computed a block
+   at a time, in the node order, by the instructions in `lcode`: the
+   other nodes are interpreted sample by sample afterwards. Nodes whose
+   arguments are constants are folded and nodes contributing to nothing
+   are dropped. */
+static void
+Exprer_compile(Exprer *self)
+{
+    int i, j, k, c, r, op, changed, anyout, top, nrand = 0, nv = 0, nphys = 0, nfree = 0, nconst = 0;
+    int n = self->count, last = self->count - 1;
+    MYFLT args[3];
+    PyObject *key, *value;
+    Py_ssize_t dictpos = 0;
+    expr *ex;
+    expr_compiler *w = (expr_compiler *)PyMem_RawCalloc(1, sizeof(expr_compiler));
+
+    self->ncode = self->nscalar = self->npublish = self->yread = 0;
+
+    for (j = 0; j < 1024; j++)
+        self->lreg[j] = NULL;
+
+    if (w == NULL || n == 0)
+    {
+        PyMem_RawFree(w);
+        return;
+    }
+
+    while (PyDict_Next(self->variables, &dictpos, &key, &value))
+    {
+        j = PyLong_AsLong(value);
+
+        if (j >= 0 && j < n)
+            w->isvar[j] = 1;
+    }
+
+    /* Nodes holding a complex number. */
+    do
+    {
+        changed = 0;
+
+        for (j = 0; j < n; j++)
+        {
+            ex = &self->lexp[j];
+            op = ex->type_op;
+            r = ex->num > 0 ? expr_argref(ex, 0) : -1;
+
+            if (! w->cplx[j] && (op == OP_COMPLEX || op == OP_CPOLE || op == OP_CZERO ||
+                                 (op == OP_CONST && r >= 0 && r < n && w->cplx[r])))
+            {
+                w->cplx[j] = changed = 1;
+            }
+        }
+    }
+    while (changed);
+
+    /* Nodes interpreted sample by sample. */
+    for (j = 0; j < n; j++)
+    {
+        ex = &self->lexp[j];
+        op = ex->type_op;
+
+        if (op < 0 || w->cplx[j] || op == OP_REAL || op == OP_IMAG)
+            w->scalar[j] = 1;
+
+        if (op == OP_RANDF || op == OP_RANDI)
+            nrand++;
+
+        for (k = 0; k < ex->num; k++)
+        {
+            switch (expr_argkind(ex, k))
+            {
+                case EXPR_ARG_VAR:
+                    // Read before being computed: the value of the previous sample.
+                    if (ex->vars[k] >= j)
+                    {
+                        w->scalar[j] = 1;
+
+                        if (ex->vars[k] < n)
+                            w->scalar[ex->vars[k]] = 1;
+                    }
+
+                    break;
+
+                case EXPR_ARG_OUTPUT:
+                    w->scalar[j] = 1;
+                    self->yread = 1;
+                    break;
+            }
+        }
+    }
+
+    /* The random generator must be called in the same order. */
+    for (j = 0; j < n && nrand > 1; j++)
+    {
+        if (self->lexp[j].type_op == OP_RANDF || self->lexp[j].type_op == OP_RANDI)
+            w->scalar[j] = 1;
+    }
+
+    do
+    {
+        changed = 0;
+
+        for (j = 0; j < n; j++)
+        {
+            ex = &self->lexp[j];
+
+            for (k = 0; k < ex->num && ! w->scalar[j]; k++)
+            {
+                r = expr_argref(ex, k);
+
+                if (r >= 0 && r < n && w->scalar[r])
+                    w->scalar[j] = changed = 1;
+            }
+        }
+
+        /* The outputs must be written in the node order. */
+        for (j = 0, anyout = 0; j < n; j++)
+        {
+            if (self->lexp[j].type_op == OP_OUT && (self->yread || w->scalar[j]))
+                anyout = 1;
+        }
+
+        for (j = 0; j < n && anyout; j++)
+        {
+            if (self->lexp[j].type_op == OP_OUT && ! w->scalar[j])
+                w->scalar[j] = changed = 1;
+        }
+    }
+    while (changed);
+
+    /* Live nodes: the result, the outputs and the random generators. */
+    top = 0;
+
+    for (j = 0; j < n; j++)
+    {
+        op = self->lexp[j].type_op;
+
+        if (j == last || op == OP_OUT || op == OP_RANDF || op == OP_RANDI)
+        {
+            w->live[j] = 1;
+            w->stack[top++] = j;
+        }
+    }
+
+    while (top > 0)
+    {
+        ex = &self->lexp[w->stack[--top]];
+
+        for (k = 0; k < ex->num; k++)
+        {
+            r = expr_argref(ex, k);
+
+            if (r >= 0 && r < n && ! w->live[r])
+            {
+                w->live[r] = 1;
+                w->stack[top++] = r;
+            }
+        }
+    }
+
+    /* Block nodes: folded, aliased or computed by an instruction. */
+    for (j = 0; j < n; j++)
+    {
+        ex = &self->lexp[j];
+        op = ex->type_op;
+
+        if (! w->live[j])
+            continue;
+
+        if (w->scalar[j])
+        {
+            self->lscalar[self->nscalar++] = j;
+
+            for (k = 0; k < ex->num; k++)
+            {
+                r = expr_argref(ex, k);
+
+                if (r >= 0 && r < n && ! w->scalar[r] && ! w->published[r])
+                {
+                    w->published[r] = 1;
+                    self->lpublish[self->npublish++] = r;
+                }
+            }
+
+            continue;
+        }
+
+        c = self->ncode;
+        w->in[c][0] = w->in[c][1] = w->in[c][2] = expr_constant(w, &nv, 0.0);
+        w->inptr[c][0] = w->inptr[c][1] = w->inptr[c][2] = NULL;
+        args[0] = args[1] = args[2] = 0.0;
+        w->folded[j] = 1;
+
+        for (k = 0; k < ex->num && k < 3; k++)
+        {
+            switch (expr_argkind(ex, k))
+            {
+                case EXPR_ARG_NODE:
+                case EXPR_ARG_VAR:
+                    r = expr_argref(ex, k);
+                    w->in[c][k] = w->vreg[r];
+                    w->inptr[c][k] = w->ptr[r];
+                    args[k] = w->value[r];
+                    w->folded[j] &= w->folded[r];
+                    break;
+
+                case EXPR_ARG_INPUT:
+                    w->inptr[c][k] = Exprer_inputBlock(self, ex->inchnls[k], -ex->input[k]);
+                    w->in[c][k] = w->inptr[c][k] == NULL ? expr_constant(w, &nv, 0.0) : -1;
+                    w->folded[j] &= w->inptr[c][k] == NULL;
+                    break;
+
+                default:
+                    args[k] = ex->values[k];
+                    w->in[c][k] = expr_constant(w, &nv, args[k]);
+                    break;
+            }
+        }
+
+        if (op == OP_CONST && ! w->isvar[j])
+        {
+            w->vreg[j] = w->in[c][0];
+            w->ptr[j] = w->inptr[c][0];
+            w->value[j] = args[0];
+            continue;
+        }
+        else if (op == OP_OUT)
+        {
+            w->folded[j] = 1;
+            w->value[j] = 0.0;
+            w->out[c] = -1;
+        }
+        else if (expr_ispure(op) && w->folded[j])
+        {
+            w->value[j] = Exprer_fold(self, op, args[0], args[1], args[2]);
+            w->vreg[j] = expr_constant(w, &nv, w->value[j]);
+            w->ptr[j] = NULL;
+            continue;
+        }
+        else
+        {
+            w->folded[j] = 0;
+            w->out[c] = nv;
+            w->isconst[nv] = 0;
+            w->lastuse[nv] = c;
+            nv++;
+        }
+
+        w->vreg[j] = w->out[c] >= 0 ? w->out[c] : expr_constant(w, &nv, 0.0);
+        w->ptr[j] = NULL;
+        self->lcode[c].op = op;
+        self->lcode[c].node = j;
+        self->ncode++;
+    }
+
+    /* Lifetime of the registers, the ones read while interpreting stay valid. */
+    for (c = 0; c < self->ncode; c++)
+    {
+        for (k = 0; k < 3; k++)
+        {
+            r = w->in[c][k];
+
+            if (r >= 0 && ! w->isconst[r])
+                w->lastuse[r] = c;
+        }
+    }
+
+    for (i = 0; i < self->npublish; i++)
+    {
+        r = w->vreg[self->lpublish[i]];
+
+        if (r >= 0)
+            w->lastuse[r] = self->ncode;
+    }
+
+    if (w->vreg[last] >= 0)
+        w->lastuse[w->vreg[last]] = self->ncode;
+
+    for (r = 0; r < nv; r++)
+        w->phys[r] = -1;
+
+    for (c = 0; c < self->ncode; c++)
+    {
+        r = w->out[c];
+
+        if (r >= 0)
+            w->phys[r] = nfree > 0 ? w->freelist[--nfree] : nphys++;
+
+        for (k = -1; k < 3; k++)
+        {
+            r = k < 0 ? w->out[c] : w->in[c][k];
+
+            if (r >= 0 && ! w->isconst[r] && w->lastuse[r] == c && w->phys[r] >= 0)
+            {
+                w->freelist[nfree++] = w->phys[r];
+                w->lastuse[r] = -1;
+            }
+        }
+    }
+
+    for (r = 0; r < nv; r++)
+    {
+        if (w->isconst[r])
+            w->phys[r] = nphys + nconst++;
+    }
+
+    self->registers = (MYFLT *)PyMem_RawRealloc(self->registers, (nphys + nconst) * self->bufsize * sizeof(MYFLT));
+
+    for (r = 0; r < nv; r++)
+    {
+        if (w->isconst[r])
+        {
+            for (i = 0; i < self->bufsize; i++)
+                self->registers[w->phys[r] * self->bufsize + i] = w->constval[r];
+        }
+    }
+
+#define EXPR_BLOCK(vr, p) ((vr) >= 0 ? self->registers + w->phys[vr] * self->bufsize : (p))
+
+    for (c = 0; c < self->ncode; c++)
+    {
+        self->lcode[c].out = w->out[c] >= 0 ? EXPR_BLOCK(w->out[c], NULL) : NULL;
+
+        for (k = 0; k < 3; k++)
+            self->lcode[c].in[k] = EXPR_BLOCK(w->in[c][k], w->inptr[c][k]);
+    }
+
+    for (j = 0; j < n; j++)
+    {
+        if (w->live[j] && ! w->scalar[j])
+        {
+            self->lreg[j] = EXPR_BLOCK(w->vreg[j], w->ptr[j]);
+
+            if (w->folded[j])
+                self->lexp[j].result = w->value[j];
+        }
+    }
+
+#undef EXPR_BLOCK
+
+    PyMem_RawFree(w);
+}
+
 static void
 Exprer_process(Exprer *self)
 {
-    int i, j, k, l, pos = 0, chnl = 0, outpos = 0;
-    MYFLT tmp = 0.0, result = 0.0;
+    int i, j, k, l, s, pos = 0, chnl = 0, outpos = 0, lastout = 0, last = self->count - 1;
+    MYFLT tmp = 0.0;
     MYFLT nextre = 0.0, lastre = 0.0, nextim = 0.0, lastim = 0.0, coefre = 0.0, coefim = 0.0;
-    PyObject *stream;
     MYFLT *in;
 
-    int inputsize = PyList_Size(self->input);
-
     if (self->count == 0)
     {
         for (i = 0; i < self->bufsize; i++)
@@ -300,17 +983,34 @@ Exprer_process(Exprer *self)
     }
     else
     {
-        for (i = 0; i < self->bufsize; i++)
+        for (l = 0; l < self->inputsize; l++)
+        {
+            in = self->input_buffer + 2 * l * self->bufsize;
+            memcpy(in, in + self->bufsize, self->bufsize * sizeof(MYFLT));
+            memcpy(in + self->bufsize, Stream_getData(self->input_streams[l]), self->bufsize * sizeof(MYFLT));
+        }
+
+        for (i = 0; i < self->ncode; i++)
         {
-            for (l = 0; l < inputsize; l++)
+            Exprer_runBlock(self, &self->lcode[i]);
+        }
+
+        // With $y, the result is written sample by sample, as read.
+        if (self->chnls == 1)
+            lastout = self->lreg[last] == NULL || self->yread;
+
+        for (i = 0; i < self->bufsize && (self->nscalar > 0 || lastout); i++)
+        {
+            for (s = 0; s < self->npublish; s++)
             {
-                stream = PyObject_CallMethod((PyObject *)PyList_GET_ITEM(self->input, l), "_getStream", NULL);
-                in = Stream_getData((Stream *)stream);
-                self->input_buffer[l * self->bufsize + i] = in[i];
+                j = self->lpublish[s];
+                self->lexp[j].result = self->lreg[j][i];
             }
 
-            for (j = 0; j < self->count; j++)
+            for (s = 0; s < self->nscalar; s++)
             {
+                j = self->lscalar[s];
+
                 for (k = 0; k < self->lexp[j].num; k++)
                 {
                     if (self->lexp[j].nodes[k] != -1)
@@ -350,13 +1050,8 @@ Exprer_process(Exprer *self)
                     }
                     else if (self->lexp[j].input[k] < 1)
                     {
-                        chnl = self->lexp[j].inchnls[k];
-                        pos = i + self->lexp[j].input[k];
-
-                        if (pos < 0)
-                            pos += self->bufsize;
-
-                        self->lexp[j].values[k] = self->input_buffer[chnl * self->bufsize + pos];
+                        in = Exprer_inputBlock(self, self->lexp[j].inchnls[k], -self->lexp[j].input[k]);
+                        self->lexp[j].values[k] = in == NULL ? 0.0 : in[i];
                     }
                     else if (self->lexp[j].output[k] < 0)
                     {
@@ -702,15 +1397,18 @@ Exprer_process(Exprer *self)
                         self->output_buffer[outpos] = self->lexp[j].values[1];
                         break;
                 }
-
-                result = self->lexp[j].result;
             }
 
-            if (self->chnls == 1)
+            if (lastout)
             {
-                self->output_buffer[i] = result;
+                self->output_buffer[i] = self->lreg[last] == NULL ? self->lexp[last].result : self->lreg[last][i];
             }
         }
+
+        if (self->chnls == 1 && ! lastout)
+        {
+            memcpy(self->output_buffer, self->lreg[last], self->bufsize * sizeof(MYFLT));
+        }
     }
 }
 
@@ -763,6 +1461,8 @@ Exprer_dealloc(Exprer* self)
 
     PyMem_RawFree(self->input_buffer);
     PyMem_RawFree(self->output_buffer);
+    PyMem_RawFree(self->input_streams);
+    PyMem_RawFree(self->registers);
     Exprer_clear(self);
     Py_TYPE(self->stream)->tp_free((PyObject*)self->stream);
     Py_TYPE(self)->tp_free((PyObject*)self);
@@ -779,6 +1479,7 @@ Exprer_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, Exprer_compute_next_data_frame);
+    Stream_setSerial(self->stream, 1);
     self->mode_func_ptr = Exprer_setProcMode;
 
     self->oneOverSr = 1.0 / self->sr;
@@ -793,9 +1494,14 @@ Exprer_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->input = inputtmp;
     Py_INCREF(self->input);
 
-    if (exprtmp)
+    self->inputsize = PyList_Size(self->input);
+    self->input_streams = (Stream **)PyMem_RawRealloc(self->input_streams, self->inputsize * sizeof(Stream *));
+
+    /* Borrowed, the streams live as long as the objects of the input list. */
+    for (i = 0; i < self->inputsize; i++)
     {
-        PyObject_CallMethod((PyObject *)self, "setExpr", "O", exprtmp);
+        self->input_streams[i] = (Stream *)PyObject_CallMethod(PyList_GET_ITEM(self->input, i), "_getStream", NULL);
+        Py_XDECREF(self->input_streams[i]);
     }
 
     PyObject_CallMethod(self->server, "addStream", "O", self->stream);
@@ -803,10 +1509,10 @@ Exprer_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     if (self->chnls < 1)
         self->chnls = 1;
 
-    self->input_buffer = (MYFLT *)PyMem_RawRealloc(self->input_buffer, PyList_Size(self->input) * self->bufsize * sizeof(MYFLT));
+    self->input_buffer = (MYFLT *)PyMem_RawRealloc(self->input_buffer, 2 * self->inputsize * self->bufsize * sizeof(MYFLT));
     self->output_buffer = (MYFLT *)PyMem_RawRealloc(self->output_buffer, self->chnls * self->bufsize * sizeof(MYFLT));
 
-    for (i = 0; i < (PyList_Size(self->input) * self->bufsize); i++)
+    for (i = 0; i < (2 * self->inputsize * self->bufsize); i++)
     {
         self->input_buffer[i] = 0.0;
     }
@@ -816,6 +1522,11 @@ Exprer_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
         self->output_buffer[i] = initout;
     }
 
+    if (exprtmp)
+    {
+        PyObject_CallMethod((PyObject *)self, "setExpr", "O", exprtmp);
+    }
+
     (*self->mode_func_ptr)(self);
 
     return (PyObject *)self;
@@ -828,7 +1539,7 @@ static PyObject * Exprer_play(Exprer *self, PyObject *args, PyObject *kwds) { PL
 static PyObject * Exprer_stop(Exprer *self, PyObject *args, PyObject *kwds) { STOP };
 
 static PyObject *
-Exprer_setExpr(Exprer *self, PyObject *arg)
+Exprer_parseExpr(Exprer *self, PyObject *arg)
 {
     int i, j = 0, count = 0;
     PyObject *sentence = NULL, *explist = NULL, *tmpchnl = NULL, *waitingList = NULL;
@@ -1147,6 +1858,8 @@ Exprer_setExpr(Exprer *self, PyObject *arg)
         Py_DECREF(waitingDict);
 
         self->count++;
+
+        Exprer_compile(self);
     }
 
     Py_XDECREF(sentence);
@@ -1157,6 +1870,19 @@ Exprer_setExpr(Exprer *self, PyObject *arg)
     Py_RETURN_NONE;
 }
 
+/* The expressions are rebuilt in place, the audio thread must not run them meanwhile. */
+static PyObject *
+Exprer_setExpr(Exprer *self, PyObject *arg)
+{
+    PyObject *result;
+
+    Server_lockProcessing(self->server);
+    result = Exprer_parseExpr(self, arg);
+    Server_unlockProcessing(self->server);
+
+    return result;
+}
+
 static PyObject *
 Exprer_setVar(Exprer *self, PyObject *args, PyObject *kwds)
 {
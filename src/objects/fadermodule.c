@@ -56,6 +56,8 @@ static void Fader_internal_stop(Fader *self)
         self->data[i] = 0;
         self->trigsBuffer[i] = 0.0;
     }
+
+    Stream_setState(self->stream, PYO_STREAM_SILENT);
 }
 
 static void
@@ -530,6 +532,8 @@ static void Adsr_internal_stop(Adsr *self)
         self->data[i] = 0;
         self->trigsBuffer[i] = 0.0;
     }
+
+    Stream_setState(self->stream, PYO_STREAM_SILENT);
 }
 
 static void
@@ -1256,6 +1260,7 @@ Linseg_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, Linseg_compute_next_data_frame);
+    Stream_setNeedGIL(self->stream, 1);
     self->mode_func_ptr = Linseg_setProcMode;
 
     self->sampleToSec = 1. / self->sr;
@@ -1346,10 +1351,12 @@ Linseg_setList(Linseg *self, PyObject *value)
     }
 
     Py_INCREF(value);
+    Server_lockProcessing(self->server);
     Py_DECREF(self->pointslist);
     self->pointslist = value;
 
     self->newlist = 1;
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -1722,6 +1729,7 @@ Expseg_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, Expseg_compute_next_data_frame);
+    Stream_setNeedGIL(self->stream, 1);
     self->mode_func_ptr = Expseg_setProcMode;
 
     self->sampleToSec = 1. / self->sr;
@@ -1812,10 +1820,12 @@ Expseg_setList(Expseg *self, PyObject *value)
     }
 
     Py_INCREF(value);
+    Server_lockProcessing(self->server);
     Py_DECREF(self->pointslist);
     self->pointslist = value;
 
     self->newlist = 1;
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -28,6 +28,7 @@
 #include "servermodule.h"
 #include "dummymodule.h"
 #include "fft.h"
+#include "convolver.h"
 #include "wind.h"
 #include "sndfile.h"
 #include "matrixmodule.h"
@@ -51,18 +52,16 @@ typedef struct
     MYFLT *inframe;
     MYFLT *outframe;
     MYFLT *window;
-    MYFLT **twiddle;
+    PyoFFTPlan *plan;
     //MYFLT *twiddle2;
     MYFLT *buffer_streams;
-    int allocated;
 } FFTMain;
 
 static void
 FFTMain_realloc_memories(FFTMain *self)
 {
-    int i, n8;
+    int i;
     self->hsize = self->size / 2;
-    n8 = self->size >> 3;
     self->inframe = (MYFLT *)PyMem_RawRealloc(self->inframe, self->size * sizeof(MYFLT));
     self->outframe = (MYFLT *)PyMem_RawRealloc(self->outframe, self->size * sizeof(MYFLT));
 
@@ -74,25 +73,13 @@ FFTMain_realloc_memories(FFTMain *self)
     for (i = 0; i < (self->bufsize * 3); i++)
         self->buffer_streams[i] = 0.0;
 
-    self->twiddle = (MYFLT **)PyMem_RawRealloc(self->twiddle, 4 * sizeof(MYFLT *));
-
-    for (i = 0; i < 4; i++)
-    {
-        if (self->allocated)
-        {
-            PyMem_RawFree(self->twiddle[i]);
-        }
-        self->twiddle[i] = (MYFLT *)PyMem_RawMalloc(n8 * sizeof(MYFLT));
-    }
-
-    fft_compute_split_twiddle(self->twiddle, self->size);
+    fft_plan_release(self->plan);
+    self->plan = fft_plan_acquire(self->size, PYO_FFT_REAL);
     //self->twiddle2 = (MYFLT *)PyMem_RawRealloc(self->twiddle2, self->size * sizeof(MYFLT));
     //fft_compute_radix2_twiddle(self->twiddle2, self->size);
     self->window = (MYFLT *)PyMem_RawRealloc(self->window, self->size * sizeof(MYFLT));
     gen_window(self->window, self->size, self->wintype);
     self->incount = -self->hopsize;
-
-    self->allocated = 1;
 }
 
 static void
@@ -131,7 +118,7 @@ FFTMain_filters(FFTMain *self)
         if (incount >= self->size)
         {
             incount -= self->size;
-            realfft_split(self->inframe, self->outframe, self->size, self->twiddle);
+            fft_plan_forward(self->plan, self->inframe, self->outframe);
         }
     }
 
@@ -194,19 +181,13 @@ FFTMain_clear(FFTMain *self)
 static void
 FFTMain_dealloc(FFTMain* self)
 {
-    int i;
     pyo_DEALLOC
     PyMem_RawFree(self->inframe);
     PyMem_RawFree(self->outframe);
     PyMem_RawFree(self->window);
     PyMem_RawFree(self->buffer_streams);
 
-    for (i = 0; i < 4; i++)
-    {
-        PyMem_RawFree(self->twiddle[i]);
-    }
-
-    PyMem_RawFree(self->twiddle);
+    fft_plan_release(self->plan);
     //free(self->twiddle2);
     FFTMain_clear(self);
     Py_TYPE(self->stream)->tp_free((PyObject*)self->stream);
@@ -223,7 +204,6 @@ FFTMain_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     self->size = 1024;
     self->wintype = 2;
-    self->allocated = 0;
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, FFTMain_compute_next_data_frame);
     self->mode_func_ptr = FFTMain_setProcMode;
@@ -237,6 +217,12 @@ FFTMain_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     PyObject_CallMethod(self->server, "addStream", "O", self->stream);
 
+    if (!fft_valid_size(self->size, PYO_FFT_REAL))
+    {
+        self->size = fft_next_size(self->size, PYO_FFT_REAL);
+        PySys_WriteStdout("FFT size must be an even number whose half only has 2, 3 and 5 as factors, using the next valid size : %d\n", self->size);
+    }
+
     FFTMain_realloc_memories(self);
 
     (*self->mode_func_ptr)(self);
@@ -262,14 +248,14 @@ FFTMain_setSize(FFTMain *self, PyObject *args, PyObject *kwds)
         Py_RETURN_NONE;
     }
 
-    if (isPowerOfTwo(size))
+    if (fft_valid_size(size, PYO_FFT_REAL))
     {
         self->size = size;
         self->hopsize = hopsize;
         FFTMain_realloc_memories(self);
     }
     else
-        PySys_WriteStdout("FFT size must be a power of two!\n");
+        PySys_WriteStdout("FFT size must be an even number whose half only has 2, 3 and 5 as factors!\n");
 
     Py_RETURN_NONE;
 }
@@ -631,43 +617,29 @@ typedef struct
     MYFLT *inframe;
     MYFLT *outframe;
     MYFLT *window;
-    MYFLT **twiddle;
+    PyoFFTPlan *plan;
     //MYFLT *twiddle2;
     int modebuffer[2];
-    int allocated;
 } IFFT;
 
 static void
 IFFT_realloc_memories(IFFT *self)
 {
-    int i, n8;
+    int i;
     self->hsize = self->size / 2;
-    n8 = self->size >> 3;
     self->inframe = (MYFLT *)PyMem_RawRealloc(self->inframe, self->size * sizeof(MYFLT));
     self->outframe = (MYFLT *)PyMem_RawRealloc(self->outframe, self->size * sizeof(MYFLT));
 
     for (i = 0; i < self->size; i++)
         self->inframe[i] = self->outframe[i] = 0.0;
 
-    self->twiddle = (MYFLT **)PyMem_RawRealloc(self->twiddle, 4 * sizeof(MYFLT *));
-
-    for (i = 0; i < 4; i++)
-    {
-        if (self->allocated)
-        {
-            PyMem_RawFree(self->twiddle[i]);
-        }
-        self->twiddle[i] = (MYFLT *)PyMem_RawMalloc(n8 * sizeof(MYFLT));
-    }
-
-    fft_compute_split_twiddle(self->twiddle, self->size);
+    fft_plan_release(self->plan);
+    self->plan = fft_plan_acquire(self->size, PYO_FFT_REAL);
     //self->twiddle2 = (MYFLT *)PyMem_RawRealloc(self->twiddle2, self->size * sizeof(MYFLT));
     //fft_compute_radix2_twiddle(self->twiddle2, self->size);
     self->window = (MYFLT *)PyMem_RawRealloc(self->window, self->size * sizeof(MYFLT));
     gen_window(self->window, self->size, self->wintype);
     self->incount = -self->hopsize;
-
-    self->allocated = 1;
 }
 
 static void
@@ -703,7 +675,7 @@ IFFT_filters(IFFT *self)
         if (incount >= self->size)
         {
             incount -= self->size;
-            irealfft_split(self->inframe, self->outframe, self->size, self->twiddle);
+            fft_plan_inverse(self->plan, self->inframe, self->outframe);
         }
     }
 
@@ -812,18 +784,12 @@ IFFT_clear(IFFT *self)
 static void
 IFFT_dealloc(IFFT* self)
 {
-    int i;
     pyo_DEALLOC
     PyMem_RawFree(self->inframe);
     PyMem_RawFree(self->outframe);
     PyMem_RawFree(self->window);
 
-    for (i = 0; i < 4; i++)
-    {
-        PyMem_RawFree(self->twiddle[i]);
-    }
-
-    PyMem_RawFree(self->twiddle);
+    fft_plan_release(self->plan);
     //free(self->twiddle2);
     IFFT_clear(self);
     Py_TYPE(self->stream)->tp_free((PyObject*)self->stream);
@@ -842,7 +808,6 @@ IFFT_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->wintype = 2;
     self->modebuffer[0] = 0;
     self->modebuffer[1] = 0;
-    self->allocated = 0;
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, IFFT_compute_next_data_frame);
@@ -877,6 +842,12 @@ IFFT_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     PyObject_CallMethod(self->server, "addStream", "O", self->stream);
 
+    if (!fft_valid_size(self->size, PYO_FFT_REAL))
+    {
+        self->size = fft_next_size(self->size, PYO_FFT_REAL);
+        PySys_WriteStdout("IFFT size must be an even number whose half only has 2, 3 and 5 as factors, using the next valid size : %d\n", self->size);
+    }
+
     IFFT_realloc_memories(self);
 
     (*self->mode_func_ptr)(self);
@@ -916,14 +887,14 @@ IFFT_setSize(IFFT *self, PyObject *args, PyObject *kwds)
         Py_RETURN_NONE;
     }
 
-    if (isPowerOfTwo(size))
+    if (fft_valid_size(size, PYO_FFT_REAL))
     {
         self->size = size;
         self->hopsize = hopsize;
         IFFT_realloc_memories(self);
     }
     else
-        PySys_WriteStdout("IFFT size must be a power of two!\n");
+        PySys_WriteStdout("IFFT size must be an even number whose half only has 2, 3 and 5 as factors!\n");
 
     Py_RETURN_NONE;
 }
@@ -1639,6 +1610,7 @@ typedef struct
 {
     pyo_audio_HEAD
     PyObject *input;
+    Stream **input_streams; /* borrowed, see Stream_getListStreams. */
     int inputSize;
     int modebuffer[2];
     int frameSize;
@@ -1659,7 +1631,7 @@ FrameDeltaMain_generate(FrameDeltaMain *self)
 
     for (j = 0; j < self->overlaps; j++)
     {
-        MYFLT *in = Stream_getData((Stream *)PyObject_CallMethod((PyObject *)PyList_GET_ITEM(self->input, j), "_getStream", NULL));
+        MYFLT *in = Stream_getData(self->input_streams[j]);
 
         for (i = 0; i < self->bufsize; i++)
         {
@@ -1753,6 +1725,7 @@ FrameDeltaMain_dealloc(FrameDeltaMain* self)
 
     PyMem_RawFree(self->frameBuffer);
     PyMem_RawFree(self->buffer_streams);
+    PyMem_RawFree(self->input_streams);
     FrameDeltaMain_clear(self);
     Py_TYPE(self->stream)->tp_free((PyObject*)self->stream);
     Py_TYPE(self)->tp_free((PyObject*)self);
@@ -1819,17 +1792,30 @@ static PyObject * FrameDeltaMain_stop(FrameDeltaMain *self, PyObject *args, PyOb
 static PyObject *
 FrameDeltaMain_setInput(FrameDeltaMain *self, PyObject *arg)
 {
+    PyObject *old;
+    Stream **streams, **oldstreams;
+
     if (! PyList_Check(arg))
     {
         PyErr_SetString(PyExc_TypeError, "The inputs attribute must be a list.");
         Py_RETURN_NONE;
     }
 
-    Py_DECREF(self->input);
+    if ((streams = Stream_getListStreams(arg)) == NULL)
+        return NULL;
 
+    Py_INCREF(arg);
+    Server_lockProcessing(self->server);
+    old = self->input;
+    oldstreams = self->input_streams;
     self->inputSize = PyList_Size(arg);
     self->input = arg;
-    Py_INCREF(self->input);
+    self->input_streams = streams;
+    Stream_invalidateGraph();
+    Server_unlockProcessing(self->server);
+
+    Py_DECREF(old);
+    PyMem_RawFree(oldstreams);
 
     Py_RETURN_NONE;
 }
@@ -1845,6 +1831,7 @@ FrameDeltaMain_setFrameSize(FrameDeltaMain *self, PyObject *arg)
 
         if (isPowerOfTwo(tmp))
         {
+            Server_lockProcessing(self->server);
             self->frameSize = tmp;
             self->hopsize = self->frameSize / self->overlaps;
 
@@ -1862,6 +1849,7 @@ FrameDeltaMain_setFrameSize(FrameDeltaMain *self, PyObject *arg)
             }
 
             self->count = 0;
+            Server_unlockProcessing(self->server);
         }
     }
     else
@@ -2206,6 +2194,7 @@ typedef struct
 {
     pyo_audio_HEAD
     PyObject *input;
+    Stream **input_streams; /* borrowed, see Stream_getListStreams. */
     int inputSize;
     int modebuffer[2];
     int frameSize;
@@ -2226,7 +2215,7 @@ FrameAccumMain_generate(FrameAccumMain *self)
 
     for (j = 0; j < self->overlaps; j++)
     {
-        MYFLT *in = Stream_getData((Stream *)PyObject_CallMethod((PyObject *)PyList_GET_ITEM(self->input, j), "_getStream", NULL));
+        MYFLT *in = Stream_getData(self->input_streams[j]);
 
         for (i = 0; i < self->bufsize; i++)
         {
@@ -2309,6 +2298,7 @@ FrameAccumMain_dealloc(FrameAccumMain* self)
 
     PyMem_RawFree(self->frameBuffer);
     PyMem_RawFree(self->buffer_streams);
+    PyMem_RawFree(self->input_streams);
     FrameAccumMain_clear(self);
     Py_TYPE(self->stream)->tp_free((PyObject*)self->stream);
     Py_TYPE(self)->tp_free((PyObject*)self);
@@ -2375,17 +2365,30 @@ static PyObject * FrameAccumMain_stop(FrameAccumMain *self, PyObject *args, PyOb
 static PyObject *
 FrameAccumMain_setInput(FrameAccumMain *self, PyObject *arg)
 {
+    PyObject *old;
+    Stream **streams, **oldstreams;
+
     if (! PyList_Check(arg))
     {
         PyErr_SetString(PyExc_TypeError, "The inputs attribute must be a list.");
         Py_RETURN_NONE;
     }
 
-    Py_DECREF(self->input);
+    if ((streams = Stream_getListStreams(arg)) == NULL)
+        return NULL;
 
+    Py_INCREF(arg);
+    Server_lockProcessing(self->server);
+    old = self->input;
+    oldstreams = self->input_streams;
     self->inputSize = PyList_Size(arg);
     self->input = arg;
-    Py_INCREF(self->input);
+    self->input_streams = streams;
+    Stream_invalidateGraph();
+    Server_unlockProcessing(self->server);
+
+    Py_DECREF(old);
+    PyMem_RawFree(oldstreams);
 
     Py_RETURN_NONE;
 }
@@ -2401,6 +2404,7 @@ FrameAccumMain_setFrameSize(FrameAccumMain *self, PyObject *arg)
 
         if (isPowerOfTwo(tmp))
         {
+            Server_lockProcessing(self->server);
             self->frameSize = tmp;
             self->hopsize = self->frameSize / self->overlaps;
 
@@ -2418,6 +2422,7 @@ FrameAccumMain_setFrameSize(FrameAccumMain *self, PyObject *arg)
             }
 
             self->count = 0;
+            Server_unlockProcessing(self->server);
         }
     }
     else
@@ -2762,6 +2767,7 @@ typedef struct
 {
     pyo_audio_HEAD
     PyObject *input;
+    Stream **input_streams; /* borrowed, see Stream_getListStreams. */
     PyObject *up;
     Stream *up_stream;
     PyObject *down;
@@ -2826,7 +2832,7 @@ VectralMain_generate(VectralMain *self)
 
     for (j = 0; j < self->overlaps; j++)
     {
-        MYFLT *in = Stream_getData((Stream *)PyObject_CallMethod((PyObject *)PyList_GET_ITEM(self->input, j), "_getStream", NULL));
+        MYFLT *in = Stream_getData(self->input_streams[j]);
 
         for (i = 0; i < self->bufsize; i++)
         {
@@ -2927,6 +2933,7 @@ VectralMain_dealloc(VectralMain* self)
 
     PyMem_RawFree(self->frameBuffer);
     PyMem_RawFree(self->buffer_streams);
+    PyMem_RawFree(self->input_streams);
     VectralMain_clear(self);
     Py_TYPE(self->stream)->tp_free((PyObject*)self->stream);
     Py_TYPE(self)->tp_free((PyObject*)self);
@@ -3016,17 +3023,30 @@ static PyObject * VectralMain_stop(VectralMain *self, PyObject *args, PyObject *
 static PyObject *
 VectralMain_setInput(VectralMain *self, PyObject *arg)
 {
+    PyObject *old;
+    Stream **streams, **oldstreams;
+
     if (! PyList_Check(arg))
     {
         PyErr_SetString(PyExc_TypeError, "The inputs attribute must be a list.");
         Py_RETURN_NONE;
     }
 
-    Py_DECREF(self->input);
+    if ((streams = Stream_getListStreams(arg)) == NULL)
+        return NULL;
 
+    Py_INCREF(arg);
+    Server_lockProcessing(self->server);
+    old = self->input;
+    oldstreams = self->input_streams;
     self->inputSize = PyList_Size(arg);
     self->input = arg;
-    Py_INCREF(self->input);
+    self->input_streams = streams;
+    Stream_invalidateGraph();
+    Server_unlockProcessing(self->server);
+
+    Py_DECREF(old);
+    PyMem_RawFree(oldstreams);
 
     Py_RETURN_NONE;
 }
@@ -3042,6 +3062,7 @@ VectralMain_setFrameSize(VectralMain *self, PyObject *arg)
 
         if (isPowerOfTwo(tmp))
         {
+            Server_lockProcessing(self->server);
             self->frameSize = tmp;
             self->hopsize = self->frameSize / self->overlaps;
 
@@ -3059,6 +3080,7 @@ VectralMain_setFrameSize(VectralMain *self, PyObject *arg)
             }
 
             self->count = 0;
+            Server_unlockProcessing(self->server);
         }
     }
     else
@@ -3416,54 +3438,22 @@ typedef struct
     char *impulse_path;
     int chnl;
     int size;
-    int size2;
-    int hsize;
     int incount;
-    int num_iter;
-    int current_iter;
-    int impulse_len;
-    MYFLT *inframe;
-    MYFLT *outframe;
-    MYFLT *last_half_frame;
-    MYFLT **twiddle;
     MYFLT *input_buffer;
     MYFLT *output_buffer;
-    MYFLT **impulse_real;
-    MYFLT **impulse_imag;
-    MYFLT **accum_real;
-    MYFLT **accum_imag;
-    MYFLT *real;
-    MYFLT *imag;
+    PyoConvolver *convolver;
     int modebuffer[3];
 } CvlVerb;
 
 static void
 CvlVerb_alloc_memories(CvlVerb *self)
 {
-    int i, n8;
-    self->hsize = self->size / 2;
-    self->size2 = self->size * 2;
-    n8 = self->size2 >> 3;
-    self->real = (MYFLT *)PyMem_RawRealloc(self->real, self->size * sizeof(MYFLT));
-    self->imag = (MYFLT *)PyMem_RawRealloc(self->imag, self->size * sizeof(MYFLT));
-    self->inframe = (MYFLT *)PyMem_RawRealloc(self->inframe, self->size2 * sizeof(MYFLT));
-    self->outframe = (MYFLT *)PyMem_RawRealloc(self->outframe, self->size2 * sizeof(MYFLT));
-    self->last_half_frame = (MYFLT *)PyMem_RawRealloc(self->last_half_frame, self->size * sizeof(MYFLT));
+    int i;
     self->input_buffer = (MYFLT *)PyMem_RawRealloc(self->input_buffer, self->size * sizeof(MYFLT));
-    self->output_buffer = (MYFLT *)PyMem_RawRealloc(self->output_buffer, self->size2 * sizeof(MYFLT));
-
-    for (i = 0; i < self->size2; i++)
-        self->inframe[i] = self->outframe[i] = self->output_buffer[i] = 0.0;
+    self->output_buffer = (MYFLT *)PyMem_RawRealloc(self->output_buffer, self->size * sizeof(MYFLT));
 
     for (i = 0; i < self->size; i++)
-        self->last_half_frame[i] = self->input_buffer[i] = 0.0;
-
-    self->twiddle = (MYFLT **)PyMem_RawRealloc(self->twiddle, 4 * sizeof(MYFLT *));
-
-    for (i = 0; i < 4; i++)
-        self->twiddle[i] = (MYFLT *)PyMem_RawMalloc(n8 * sizeof(MYFLT));
-
-    fft_compute_split_twiddle(self->twiddle, self->size2);
+        self->input_buffer[i] = self->output_buffer[i] = 0.0;
 }
 
 static void
@@ -3471,8 +3461,8 @@ CvlVerb_analyse_impulse(CvlVerb *self)
 {
     SNDFILE *sf;
     SF_INFO info;
-    int i, j, snd_size, snd_sr, snd_chnls, num_items, num;
-    MYFLT *tmp, *tmp2, *inframe, *outframe;
+    int i, snd_size, snd_sr, snd_chnls, num_items;
+    MYFLT *tmp, *tmp2;
 
     info.format = 0;
     sf = sf_open(self->impulse_path, SFM_READ, &info);
@@ -3480,6 +3470,7 @@ CvlVerb_analyse_impulse(CvlVerb *self)
     if (sf == NULL)
     {
         PySys_WriteStdout("CvlVerb failed to open the impulse file %s.\n", self->impulse_path);
+        self->convolver = Convolver_new(NULL, 0, self->size, self->size, 1.0 / (self->size * 2), 0);
         return;
     }
 
@@ -3493,14 +3484,11 @@ CvlVerb_analyse_impulse(CvlVerb *self)
         PySys_WriteStdout("CvlVerb warning: Impulse sampling rate does't match the sampling rate of the server.\n");
     }
 
-    self->num_iter = (int)MYCEIL((MYFLT)snd_size / self->size);
-    self->impulse_len = self->num_iter * self->size;
-
     tmp = (MYFLT *)PyMem_RawMalloc(num_items * sizeof(MYFLT));
-    tmp2 = (MYFLT *)PyMem_RawMalloc(self->impulse_len * sizeof(MYFLT));
+    tmp2 = (MYFLT *)PyMem_RawMalloc(snd_size * sizeof(MYFLT));
 
     sf_seek(sf, 0, SEEK_SET);
-    num = SF_READ(sf, tmp, num_items);
+    SF_READ(sf, tmp, num_items);
     sf_close(sf);
 
     for (i = 0; i < snd_size; i++)
@@ -3508,68 +3496,18 @@ CvlVerb_analyse_impulse(CvlVerb *self)
         tmp2[i] = tmp[i * snd_chnls + self->chnl];
     }
 
-    for (i = snd_size; i < self->impulse_len; i++)
-    {
-        tmp2[i] = 0.0;
-    }
-
-    self->impulse_real = (MYFLT **)PyMem_RawRealloc(self->impulse_real, self->num_iter * sizeof(MYFLT *));
-    self->impulse_imag = (MYFLT **)PyMem_RawRealloc(self->impulse_imag, self->num_iter * sizeof(MYFLT *));
-    self->accum_real = (MYFLT **)PyMem_RawRealloc(self->accum_real, self->num_iter * sizeof(MYFLT *));
-    self->accum_imag = (MYFLT **)PyMem_RawRealloc(self->accum_imag, self->num_iter * sizeof(MYFLT *));
-
-    for (i = 0; i < self->num_iter; i++)
-    {
-        self->impulse_real[i] = (MYFLT *)PyMem_RawMalloc(self->size * sizeof(MYFLT));
-        self->impulse_imag[i] = (MYFLT *)PyMem_RawMalloc(self->size * sizeof(MYFLT));
-        self->accum_real[i] = (MYFLT *)PyMem_RawMalloc(self->size * sizeof(MYFLT));
-        self->accum_imag[i] = (MYFLT *)PyMem_RawMalloc(self->size * sizeof(MYFLT));
-
-        for (j = 0; j < self->size; j++)
-        {
-            self->accum_real[i][j] = 0.0;
-            self->accum_imag[i][j] = 0.0;
-        }
-    }
-
-    inframe = (MYFLT *)PyMem_RawMalloc(self->size2 * sizeof(MYFLT));
-    outframe = (MYFLT *)PyMem_RawMalloc(self->size2 * sizeof(MYFLT));
-
-    for (j = 0; j < self->num_iter; j++)
-    {
-        num = j * self->size;
-
-        for (i = 0; i < self->size; i++)
-        {
-            inframe[i] = tmp2[num + i];
-        }
-
-        for (i = self->size; i < self->size2; i++)
-        {
-            inframe[i] = 0.0;
-        }
-
-        realfft_split(inframe, outframe, self->size2, self->twiddle);
-        self->impulse_real[j][0] = outframe[0];
-        self->impulse_imag[j][0] = 0.0;
-
-        for (i = 1; i < self->size; i++)
-        {
-            self->impulse_real[j][i] = outframe[i];
-            self->impulse_imag[j][i] = outframe[self->size2 - i];
-        }
-    }
+    /* Output level of an overlap-save with normalized fft of twice the
+       block size, as with the former uniform partitions. */
+    self->convolver = Convolver_new(tmp2, snd_size, self->size, PYO_CONV_MAX_BLOCK, 1.0 / (self->size * 2), 1);
 
     PyMem_RawFree(tmp);
     PyMem_RawFree(tmp2);
-    PyMem_RawFree(inframe);
-    PyMem_RawFree(outframe);
 }
 
 static void
 CvlVerb_process_i(CvlVerb *self)
 {
-    int i, j, k;
+    int i;
     MYFLT gdry;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
     MYFLT bal = PyFloat_AS_DOUBLE(self->bal);
@@ -3591,63 +3529,7 @@ CvlVerb_process_i(CvlVerb *self)
         if (self->incount == self->size)
         {
             self->incount = 0;
-
-            k = self->current_iter - 1;
-
-            if (k < 0)
-                k += self->num_iter;
-
-            for (i = 0; i < self->size; i++)
-            {
-                self->accum_real[k][i] = self->accum_imag[k][i] = 0.0;
-                self->inframe[i] = self->last_half_frame[i];
-                self->inframe[i + self->size] = self->last_half_frame[i] = self->input_buffer[i];
-            }
-
-            realfft_split(self->inframe, self->outframe, self->size2, self->twiddle);
-            self->real[0] = self->outframe[0];
-            self->imag[0] = 0.0;
-
-            for (i = 1; i < self->size; i++)
-            {
-                self->real[i] = self->outframe[i];
-                self->imag[i] = self->outframe[self->size2 - i];
-            }
-
-            for (j = 0; j < self->num_iter; j++)
-            {
-                k = self->current_iter + j;
-
-                if (k >= self->num_iter)
-                    k -= self->num_iter;
-
-                for (i = 0; i < self->size; i++)
-                {
-                    self->accum_real[k][i] += self->real[i] * self->impulse_real[j][i] - self->imag[i] * self->impulse_imag[j][i];
-                    self->accum_imag[k][i] += self->real[i] * self->impulse_imag[j][i] + self->imag[i] * self->impulse_real[j][i];
-                }
-            }
-
-            self->inframe[0] = self->accum_real[self->current_iter][0];
-            self->inframe[self->size] = 0.0;
-
-            for (i = 1; i < self->size; i++)
-            {
-                self->inframe[i] = self->accum_real[self->current_iter][i];
-                self->inframe[self->size2 - i] = self->accum_imag[self->current_iter][i];
-            }
-
-            irealfft_split(self->inframe, self->outframe, self->size2, self->twiddle);
-
-            for (i = 0; i < self->size; i++)
-            {
-                self->output_buffer[i] = self->outframe[i + self->size];
-            }
-
-            self->current_iter++;
-
-            if (self->current_iter == self->num_iter)
-                self->current_iter = 0;
+            Convolver_process(self->convolver, self->input_buffer, self->output_buffer);
         }
     }
 }
@@ -3655,7 +3537,7 @@ CvlVerb_process_i(CvlVerb *self)
 static void
 CvlVerb_process_a(CvlVerb *self)
 {
-    int i, j, k;
+    int i;
     MYFLT gwet, gdry;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
     MYFLT *bal = Stream_getData((Stream *)self->bal_stream);
@@ -3678,63 +3560,7 @@ CvlVerb_process_a(CvlVerb *self)
         if (self->incount == self->size)
         {
             self->incount = 0;
-
-            k = self->current_iter - 1;
-
-            if (k < 0)
-                k += self->num_iter;
-
-            for (i = 0; i < self->size; i++)
-            {
-                self->accum_real[k][i] = self->accum_imag[k][i] = 0.0;
-                self->inframe[i] = self->last_half_frame[i];
-                self->inframe[i + self->size] = self->last_half_frame[i] = self->input_buffer[i];
-            }
-
-            realfft_split(self->inframe, self->outframe, self->size2, self->twiddle);
-            self->real[0] = self->outframe[0];
-            self->imag[0] = 0.0;
-
-            for (i = 1; i < self->size; i++)
-            {
-                self->real[i] = self->outframe[i];
-                self->imag[i] = self->outframe[self->size2 - i];
-            }
-
-            for (j = 0; j < self->num_iter; j++)
-            {
-                k = self->current_iter + j;
-
-                if (k >= self->num_iter)
-                    k -= self->num_iter;
-
-                for (i = 0; i < self->size; i++)
-                {
-                    self->accum_real[k][i] += self->real[i] * self->impulse_real[j][i] - self->imag[i] * self->impulse_imag[j][i];
-                    self->accum_imag[k][i] += self->real[i] * self->impulse_imag[j][i] + self->imag[i] * self->impulse_real[j][i];
-                }
-            }
-
-            self->inframe[0] = self->accum_real[self->current_iter][0];
-            self->inframe[self->size] = 0.0;
-
-            for (i = 1; i < self->size; i++)
-            {
-                self->inframe[i] = self->accum_real[self->current_iter][i];
-                self->inframe[self->size2 - i] = self->accum_imag[self->current_iter][i];
-            }
-
-            irealfft_split(self->inframe, self->outframe, self->size2, self->twiddle);
-
-            for (i = 0; i < self->size; i++)
-            {
-                self->output_buffer[i] = self->outframe[i + self->size];
-            }
-
-            self->current_iter++;
-
-            if (self->current_iter == self->num_iter)
-                self->current_iter = 0;
+            Convolver_process(self->convolver, self->input_buffer, self->output_buffer);
         }
     }
 }
@@ -3835,35 +3661,13 @@ CvlVerb_clear(CvlVerb *self)
 static void
 CvlVerb_dealloc(CvlVerb* self)
 {
-    int i;
     pyo_DEALLOC
-    PyMem_RawFree(self->inframe);
-    PyMem_RawFree(self->outframe);
     PyMem_RawFree(self->input_buffer);
     PyMem_RawFree(self->output_buffer);
-    PyMem_RawFree(self->last_half_frame);
 
-    for (i = 0; i < 4; i++)
-    {
-        PyMem_RawFree(self->twiddle[i]);
-    }
-
-    PyMem_RawFree(self->twiddle);
+    if (self->convolver != NULL)
+        Convolver_free(self->convolver);
 
-    for (i = 0; i < self->num_iter; i++)
-    {
-        PyMem_RawFree(self->impulse_real[i]);
-        PyMem_RawFree(self->impulse_imag[i]);
-        PyMem_RawFree(self->accum_real[i]);
-        PyMem_RawFree(self->accum_imag[i]);
-    }
-
-    PyMem_RawFree(self->impulse_real);
-    PyMem_RawFree(self->impulse_imag);
-    PyMem_RawFree(self->accum_real);
-    PyMem_RawFree(self->accum_imag);
-    PyMem_RawFree(self->real);
-    PyMem_RawFree(self->imag);
     CvlVerb_clear(self);
     Py_TYPE(self->stream)->tp_free((PyObject*)self->stream);
     Py_TYPE(self)->tp_free((PyObject*)self);
@@ -3882,7 +3686,6 @@ CvlVerb_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->size = 1024;
     self->chnl = 0;
     self->incount = 0;
-    self->current_iter = 0;
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, CvlVerb_compute_next_data_frame);
     self->mode_func_ptr = CvlVerb_setProcMode;
@@ -4086,16 +3889,14 @@ typedef struct
     MYFLT *last_magnitude;
     MYFLT *tmpmag;
     MYFLT *window;
-    MYFLT **twiddle;
-    int allocated;
+    PyoFFTPlan *plan;
 } Spectrum;
 
 static void
 Spectrum_realloc_memories(Spectrum *self)
 {
-    int i, n8;
+    int i;
     self->hsize = self->size / 2;
-    n8 = self->size >> 3;
     self->input_buffer = (MYFLT *)PyMem_RawRealloc(self->input_buffer, self->size * sizeof(MYFLT));
     self->inframe = (MYFLT *)PyMem_RawRealloc(self->inframe, self->size * sizeof(MYFLT));
     self->outframe = (MYFLT *)PyMem_RawRealloc(self->outframe, self->size * sizeof(MYFLT));
@@ -4110,24 +3911,12 @@ Spectrum_realloc_memories(Spectrum *self)
     for (i = 0; i < self->hsize; i++)
         self->magnitude[i] = self->last_magnitude[i] = self->tmpmag[i + 3] = 0.0;
 
-    self->twiddle = (MYFLT **)PyMem_RawRealloc(self->twiddle, 4 * sizeof(MYFLT *));
-
-    for (i = 0; i < 4; i++)
-    {
-        if (self->allocated)
-        {
-            PyMem_RawFree(self->twiddle[i]);
-        }
-        self->twiddle[i] = (MYFLT *)PyMem_RawMalloc(n8 * sizeof(MYFLT));
-    }
-
-    fft_compute_split_twiddle(self->twiddle, self->size);
+    fft_plan_release(self->plan);
+    self->plan = fft_plan_acquire(self->size, PYO_FFT_REAL);
     self->window = (MYFLT *)PyMem_RawRealloc(self->window, self->size * sizeof(MYFLT));
     gen_window(self->window, self->size, self->wintype);
     self->incount = self->hsize;
     self->freqPerBin = self->sr / self->size;
-
-    self->allocated = 1;
 }
 
 static PyObject *
@@ -4252,7 +4041,7 @@ Spectrum_filters(Spectrum *self)
             }
 
             self->incount = self->hsize;
-            realfft_split(self->inframe, self->outframe, self->size, self->twiddle);
+            fft_plan_forward(self->plan, self->inframe, self->outframe);
             self->tmpmag[0] = self->tmpmag[1] = self->tmpmag[2] = 0.0;
             self->tmpmag[self->hsize] = self->tmpmag[self->hsize + 1] = self->tmpmag[self->hsize + 2] = 0.0;
             self->tmpmag[3] = MYSQRT(self->outframe[0] * self->outframe[0]);
@@ -4308,7 +4097,6 @@ Spectrum_clear(Spectrum *self)
 static void
 Spectrum_dealloc(Spectrum* self)
 {
-    int i;
     pyo_DEALLOC
     PyMem_RawFree(self->input_buffer);
     PyMem_RawFree(self->inframe);
@@ -4318,12 +4106,7 @@ Spectrum_dealloc(Spectrum* self)
     PyMem_RawFree(self->last_magnitude);
     PyMem_RawFree(self->tmpmag);
 
-    for (i = 0; i < 4; i++)
-    {
-        PyMem_RawFree(self->twiddle[i]);
-    }
-
-    PyMem_RawFree(self->twiddle);
+    fft_plan_release(self->plan);
     Spectrum_clear(self);
     Py_TYPE(self->stream)->tp_free((PyObject*)self->stream);
     Py_TYPE(self)->tp_free((PyObject*)self);
@@ -4350,7 +4133,6 @@ Spectrum_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->height = 400;
     self->fscaling = 0;
     self->mscaling = 1;
-    self->allocated = 0;
 
     Stream_setFunctionPtr(self->stream, Spectrum_compute_next_data_frame);
     self->mode_func_ptr = Spectrum_setProcMode;
@@ -4604,28 +4386,23 @@ typedef struct
     MYFLT *inframe;
     MYFLT *outframe;
     MYFLT *window;
-    MYFLT **twiddle;
+    PyoFFTPlan *plan;
     int modebuffer[2];
 } IFFTMatrix;
 
 static void
 IFFTMatrix_realloc_memories(IFFTMatrix *self)
 {
-    int i, n8;
+    int i;
     self->hsize = self->size / 2;
-    n8 = self->size >> 3;
     self->inframe = (MYFLT *)PyMem_RawRealloc(self->inframe, self->size * sizeof(MYFLT));
     self->outframe = (MYFLT *)PyMem_RawRealloc(self->outframe, self->size * sizeof(MYFLT));
 
     for (i = 0; i < self->size; i++)
         self->inframe[i] = self->outframe[i] = 0.0;
 
-    self->twiddle = (MYFLT **)PyMem_RawRealloc(self->twiddle, 4 * sizeof(MYFLT *));
-
-    for (i = 0; i < 4; i++)
-        self->twiddle[i] = (MYFLT *)PyMem_RawMalloc(n8 * sizeof(MYFLT));
-
-    fft_compute_split_twiddle(self->twiddle, self->size);
+    fft_plan_release(self->plan);
+    self->plan = fft_plan_acquire(self->size, PYO_FFT_REAL);
     self->window = (MYFLT *)PyMem_RawRealloc(self->window, self->size * sizeof(MYFLT));
     gen_window(self->window, self->size, self->wintype);
     self->incount = -self->hopsize;
@@ -4673,7 +4450,7 @@ IFFTMatrix_filters(IFFTMatrix *self)
         if (self->incount >= self->size)
         {
             self->incount -= self->size;
-            irealfft_split(self->inframe, self->outframe, self->size, self->twiddle);
+            fft_plan_inverse(self->plan, self->inframe, self->outframe);
         }
     }
 }
@@ -4766,18 +4543,12 @@ IFFTMatrix_clear(IFFTMatrix *self)
 static void
 IFFTMatrix_dealloc(IFFTMatrix* self)
 {
-    int i;
     pyo_DEALLOC
     PyMem_RawFree(self->inframe);
     PyMem_RawFree(self->outframe);
     PyMem_RawFree(self->window);
 
-    for (i = 0; i < 4; i++)
-    {
-        PyMem_RawFree(self->twiddle[i]);
-    }
-
-    PyMem_RawFree(self->twiddle);
+    fft_plan_release(self->plan);
     IFFTMatrix_clear(self);
     Py_TYPE(self->stream)->tp_free((PyObject*)self->stream);
     Py_TYPE(self)->tp_free((PyObject*)self);
@@ -4838,6 +4609,12 @@ IFFTMatrix_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     PyObject_CallMethod(self->server, "addStream", "O", self->stream);
 
+    if (!fft_valid_size(self->size, PYO_FFT_REAL))
+    {
+        self->size = fft_next_size(self->size, PYO_FFT_REAL);
+        PySys_WriteStdout("IFFTMatrix size must be an even number whose half only has 2, 3 and 5 as factors, using the next valid size : %d\n", self->size);
+    }
+
     IFFTMatrix_realloc_memories(self);
 
     (*self->mode_func_ptr)(self);
@@ -4897,6 +4674,7 @@ IFFTMatrix_setPhase(IFFTMatrix *self, PyObject *arg)
         Py_RETURN_NONE;
     }
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->phase);
 
     self->phase = arg;
@@ -4904,6 +4682,8 @@ IFFTMatrix_setPhase(IFFTMatrix *self, PyObject *arg)
     PyObject *streamtmp = PyObject_CallMethod((PyObject *)self->phase, "_getStream", NULL);
     self->phase_stream = (Stream *)streamtmp;
     Py_INCREF(self->phase_stream);
+    Stream_invalidateGraph();
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -4920,14 +4700,14 @@ IFFTMatrix_setSize(IFFTMatrix *self, PyObject *args, PyObject *kwds)
         Py_RETURN_NONE;
     }
 
-    if (isPowerOfTwo(size))
+    if (fft_valid_size(size, PYO_FFT_REAL))
     {
         self->size = size;
         self->hopsize = hopsize;
         IFFTMatrix_realloc_memories(self);
     }
     else
-        PySys_WriteStdout("IFFTMatrix size must be a power of two!\n");
+        PySys_WriteStdout("IFFTMatrix size must be an even number whose half only has 2, 3 and 5 as factors!\n");
 
     Py_RETURN_NONE;
 }
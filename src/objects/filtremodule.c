@@ -25,6 +25,225 @@
 #include "streammodule.h"
 #include "servermodule.h"
 #include "dummymodule.h"
+#include "multichannel.h"
+#include "biquadbank.h"
+
+/* Update rate of the coefficients of a filter modulated at audio rate.
+ *
+ * With a rate of 1 (the default), the coefficients follow the parameters at
+ * every sample. With a rate of N, they are computed only once every N
+ * samples, from the parameters of the last sample of the segment, and are
+ * linearly interpolated from their previous values over the segment. The
+ * segments end with the block. The coefficients are thus exact at the end of
+ * each segment and, in between, they are off by at most N * N / 8 times
+ * the largest second derivative (per sample) of the coefficients over time.
+ * This is negligible for a modulation slow compared to N samples, and the
+ * coefficients never jump, so there is no zipper noise.
+ *
+ * The coefficients are the fields of the filter, `CoeffRamp_init` is given
+ * their addresses. In the processing loop:
+ *
+ *     if (CoeffRamp_next(&self->ramp, i, self->bufsize, &k))
+ *     {
+ *         compute the coefficients with the parameters of sample k
+ *         CoeffRamp_start(&self->ramp);
+ *     }
+ */
+#define PYO_COEFFRAMP_MAX 6
+
+typedef struct
+{
+    int rate; /* Samples between two computations of the coefficients. */
+    int left; /* Samples left in the current segment. */
+    int primed; /* The coefficients hold values to interpolate from. */
+    int count;
+    MYFLT *coeffs[PYO_COEFFRAMP_MAX];
+    MYFLT start[PYO_COEFFRAMP_MAX];
+    MYFLT inc[PYO_COEFFRAMP_MAX];
+    MYFLT target[PYO_COEFFRAMP_MAX];
+} CoeffRamp;
+
+/* Ramps the coefficients at the given addresses, from their current values. */
+static void
+CoeffRamp_bind(CoeffRamp *self, int count, MYFLT **coeffs)
+{
+    int k;
+
+    self->left = 0;
+    self->primed = 0;
+    self->count = count;
+
+    for (k = 0; k < count; k++)
+        self->coeffs[k] = coeffs[k];
+}
+
+static void
+CoeffRamp_init(CoeffRamp *self, PyObject *server, int count, MYFLT **coeffs)
+{
+    self->rate = ((Server *)server)->coeffrate;
+    CoeffRamp_bind(self, count, coeffs);
+}
+
+/* Same with the coefficients of filter `f` of a BiquadBank, to be bound
+   again when the bank is reallocated. */
+static void
+CoeffRamp_bindBank(CoeffRamp *self, BiquadBank *bank, int f)
+{
+    MYFLT *coeffs[6] = {&bank->b0[f], &bank->b1[f], &bank->b2[f], &bank->a0[f], &bank->a1[f], &bank->a2[f]};
+    CoeffRamp_bind(self, 6, coeffs);
+}
+
+static void
+CoeffRamp_initBank(CoeffRamp *self, PyObject *server, BiquadBank *bank, int f)
+{
+    self->rate = ((Server *)server)->coeffrate;
+    CoeffRamp_bindBank(self, bank, f);
+}
+
+/* Returns 1 if the coefficients must be computed at sample `i`, from the
+   parameters of sample `*j`. Otherwise, moves them one step further. */
+static inline int
+CoeffRamp_next(CoeffRamp *self, int i, int bufsize, int *j)
+{
+    int k;
+
+    if (self->rate <= 1)
+    {
+        *j = i;
+        return 1;
+    }
+
+    if (self->left > 0)
+    {
+        self->left--;
+
+        if (self->left == 0)
+        {
+            for (k = 0; k < self->count; k++)
+                *self->coeffs[k] = self->target[k];
+        }
+        else
+        {
+            for (k = 0; k < self->count; k++)
+                *self->coeffs[k] += self->inc[k];
+        }
+
+        return 0;
+    }
+
+    self->left = bufsize - i < self->rate ? bufsize - i : self->rate;
+    *j = i + self->left - 1;
+
+    for (k = 0; k < self->count; k++)
+        self->start[k] = *self->coeffs[k];
+
+    return 1;
+}
+
+/* The coefficients of the end of the segment have just been computed,
+   steps back to the first sample of the segment. */
+static inline void
+CoeffRamp_start(CoeffRamp *self)
+{
+    int k;
+
+    if (self->rate <= 1)
+        return;
+
+    for (k = 0; k < self->count; k++)
+        self->target[k] = *self->coeffs[k];
+
+    if (self->primed && self->left > 1)
+    {
+        for (k = 0; k < self->count; k++)
+        {
+            self->inc[k] = (self->target[k] - self->start[k]) / self->left;
+            *self->coeffs[k] = self->start[k] + self->inc[k];
+        }
+    }
+
+    self->primed = 1;
+    self->left--;
+}
+
+static PyObject *
+CoeffRamp_setRate(CoeffRamp *self, PyObject *arg)
+{
+    long rate;
+
+    ASSERT_ARG_NOT_NULL
+
+    if (! PyLong_Check(arg))
+    {
+        PyErr_SetString(PyExc_TypeError, "setCoeffRate: the rate must be an integer.");
+        return NULL;
+    }
+
+    rate = PyLong_AsLong(arg);
+
+    if (rate < 1 || rate > PYO_COEFFRATE_MAX)
+    {
+        PyErr_Format(PyExc_ValueError, "setCoeffRate: the rate must be between 1 and %d.", PYO_COEFFRATE_MAX);
+        return NULL;
+    }
+
+    self->rate = (int)rate;
+    self->left = 0;
+
+    Py_RETURN_NONE;
+}
+
+/* Rates of the ramps of `chnls` channels, from the arguments of a setter: a
+   list (wrapped when shorter) or an integer, and optionally the number of
+   the only channel to set. */
+static PyObject *
+CoeffRamp_setRates(CoeffRamp *ramps, int chnls, PyObject *args)
+{
+    int i, *rates, chnl = -1;
+    PyObject *arg;
+
+    if (! PyArg_ParseTuple(args, "O|i", &arg, &chnl))
+        return NULL;
+
+    if (chnl >= chnls)
+    {
+        PyErr_SetString(PyExc_ValueError, "setCoeffRate: channel out of range.");
+        return NULL;
+    }
+    else if (chnl >= 0)
+        return CoeffRamp_setRate(&ramps[chnl], arg);
+
+    rates = (int *)PyMem_RawMalloc(chnls * sizeof(int));
+
+    if (rates == NULL)
+        return PyErr_NoMemory();
+
+    if (Multi_setInts(rates, arg, chnls) < 0)
+    {
+        PyMem_RawFree(rates);
+        return NULL;
+    }
+
+    for (i = 0; i < chnls; i++)
+    {
+        if (rates[i] < 1 || rates[i] > PYO_COEFFRATE_MAX)
+        {
+            PyMem_RawFree(rates);
+            PyErr_Format(PyExc_ValueError, "setCoeffRate: the rate must be between 1 and %d.", PYO_COEFFRATE_MAX);
+            return NULL;
+        }
+    }
+
+    for (i = 0; i < chnls; i++)
+    {
+        ramps[i].rate = rates[i];
+        ramps[i].left = 0;
+    }
+
+    PyMem_RawFree(rates);
+
+    Py_RETURN_NONE;
+}
 
 static MYFLT HALF_COS_ARRAY[513] = {1.0, 0.99998110153278696, 0.99992440684545181, 0.99982991808087995, 0.99969763881045715, 0.99952757403393411, 0.99931973017923825, 0.99907411510222999, 0.99879073808640628, 0.99846960984254973, 0.99811074250832332, 0.99771414964781235, 0.99727984625101107, 0.99680784873325645, 0.99629817493460782, 0.99575084411917214, 0.99516587697437664, 0.99454329561018584, 0.99388312355826691, 0.9931853857710996, 0.99245010862103322, 0.99167731989928998, 0.99086704881491472, 0.99001932599367026, 0.98913418347688054, 0.98821165472021921, 0.9872517745924454, 0.98625457937408512, 0.98522010675606064, 0.98414839583826585, 0.98303948712808786, 0.98189342253887657, 0.98071024538836005, 0.97949000039700762, 0.97823273368633901, 0.9769384927771817, 0.97560732658787452, 0.97423928543241856, 0.97283442101857576, 0.97139278644591409, 0.96991443620380113, 0.96839942616934394, 0.96684781360527761, 0.96525965715780015, 0.96363501685435693, 0.96197395410137099, 0.96027653168192206, 0.95854281375337425, 0.95677286584495025, 0.95496675485525528, 0.95312454904974775, 0.95124631805815985, 0.94933213287186513, 0.94738206584119555, 0.94539619067270686, 0.9433745824263926, 0.94131731751284708, 0.9392244736903772, 0.93709613006206383, 0.9349323670727715, 0.93273326650610799, 0.93049891148133324, 0.92822938645021758, 0.92592477719384991, 0.92358517081939495, 0.92121065575680161, 0.91880132175545981, 0.91635725988080907, 0.91387856251089561, 0.91136532333288145, 0.90881763733950294, 0.9062356008254806, 0.90361931138387919, 0.90096886790241915, 0.89828437055973898, 0.89556592082160869, 0.89281362143709486, 0.89002757643467667, 0.88720789111831455, 0.8843546720634694, 0.88146802711307481, 0.87854806537346075, 0.87559489721022943, 0.8726086342440843, 0.86958938934661101, 0.86653727663601088, 0.86345241147278784, 0.86033491045538835, 0.85718489141579368, 0.85400247341506719, 0.8507877767388532, 0.84754092289283123, 0.8442620345981231, 0.84095123578665476, 0.8376086515964718, 0.83423440836700968, 0.83082863363431847, 0.82739145612624232, 0.82392300575755428, 0.82042341362504534, 0.81689281200256991, 0.81333133433604599, 0.80973911523841147, 0.80611629048453592, 0.80246299700608914, 0.79877937288636502, 0.7950655573550629, 0.79132169078302494, 0.78754791467693042, 0.78374437167394739, 0.77991120553634141, 0.77604856114604148, 0.77215658449916424, 0.76823542270049605, 0.76428522395793219, 0.7603061375768756, 0.75629831395459302, 0.75226190457453135, 0.74819706200059122, 0.7441039398713607, 0.73998269289430851, 0.73583347683993672, 0.73165644853589207, 0.72745176586103977, 0.72321958773949491, 0.71896007413461649, 0.71467338604296105, 0.71035968548819706, 0.70601913551498185, 0.70165190018279788, 0.69725814455975277, 0.69283803471633953, 0.68839173771916018, 0.68391942162461061, 0.6794212554725293, 0.67489740927980701, 0.67034805403396192, 0.66577336168667567, 0.66117350514729512, 0.65654865827629605, 0.65189899587871258, 0.64722469369752944, 0.6425259284070397, 0.63780287760616672, 0.63305571981175202, 0.62828463445180749, 0.62348980185873359, 0.61867140326250347, 0.61382962078381298, 0.60896463742719675, 0.60407663707411186, 0.59916580447598711, 0.59423232524724023, 0.58927638585826192, 0.58429817362836856, 0.57929787671872113, 0.57427568412521424, 0.56923178567133192, 0.56416637200097319, 0.55907963457124654, 0.55397176564523298, 0.5488429582847193, 0.5436934063429012, 0.53852330445705543, 0.53333284804118442, 0.52812223327862839, 0.52289165711465235, 0.51764131724900009, 0.51237141212842374, 0.50708214093918114, 0.50177370359950879, 0.49644630075206486, 0.49110013375634509, 0.48573540468107329, 0.48035231629656205, 0.47495107206705045, 0.46953187614301212, 0.46409493335344021, 0.45864044919810504, 0.45316862983978612, 0.44767968209648135, 0.44217381343358825, 0.43665123195606403, 0.43111214640055828, 0.42555676612752463, 0.41998530111330729, 0.41439796194220363, 0.40879495979850627, 0.40317650645851943, 0.39754281428255606, 0.3918940962069094, 0.38623056573580644, 0.38055243693333718, 0.3748599244153632, 0.36915324334140731, 0.36343260940651945, 0.35769823883312568, 0.35195034836285416, 0.34618915524834432, 0.34041487724503472, 0.33462773260293199, 0.32882794005836308, 0.32301571882570607, 0.31719128858910622, 0.31135486949417079, 0.30550668213964982, 0.29964694756909749, 0.29377588726251663, 0.28789372312798917, 0.28200067749328667, 0.27609697309746906, 0.27018283308246382, 0.26425848098463345, 0.25832414072632598, 0.25238003660741054, 0.24642639329680122, 0.24046343582396335, 0.23449138957040974, 0.22851048026118126, 0.22252093395631445, 0.21652297704229864, 0.21051683622351761, 0.20450273851368242, 0.19848091122724945, 0.19245158197082995, 0.18641497863458675, 0.1803713293836198, 0.17432086264934399, 0.16826380712085329, 0.16220039173627876, 0.15613084567413366, 0.1500553983446527, 0.14397427938112045, 0.13788771863119115, 0.13179594614820278, 0.12569919218247999, 0.11959768717263308, 0.11349166173684638, 0.10738134666416307, 0.10126697290576155, 0.095148771566225324, 0.089026973894809708, 0.082901811276699419, 0.076773515224264705, 0.070642317368309157, 0.064508449449316344, 0.058372143308689985, 0.052233630879990445, 0.046093144180169916, 0.039950915300801082, 0.033807176399306589, 0.027662159690182372, 0.021516097436222258, 0.01536922193973846, 0.0092217655337806046, 0.0030739605733557966, -0.0030739605733554522, -0.0092217655337804832, -0.015369221939738116, -0.021516097436222133, -0.027662159690182025, -0.033807176399306464, -0.039950915300800735, -0.046093144180169791, -0.052233630879990098, -0.05837214330868986, -0.064508449449316232, -0.07064231736830906, -0.076773515224264371, -0.082901811276699308, -0.089026973894809375, -0.095148771566225213, -0.10126697290576121, -0.10738134666416296, -0.11349166173684605, -0.11959768717263299, -0.12569919218247966, -0.13179594614820267, -0.13788771863119104, -0.14397427938112034, -0.15005539834465259, -0.15613084567413354, -0.16220039173627843, -0.16826380712085318, -0.17432086264934366, -0.18037132938361969, -0.18641497863458642, -0.19245158197082984, -0.19848091122724912, -0.20450273851368231, -0.21051683622351727, -0.21652297704229853, -0.22252093395631434, -0.22851048026118118, -0.23449138957040966, -0.24046343582396323, -0.24642639329680088, -0.25238003660741043, -0.25832414072632565, -0.26425848098463334, -0.27018283308246349, -0.27609697309746895, -0.28200067749328633, -0.28789372312798905, -0.2937758872625163, -0.29964694756909738, -0.30550668213964971, -0.31135486949417068, -0.31719128858910589, -0.32301571882570601, -0.32882794005836274, -0.33462773260293188, -0.34041487724503444, -0.3461891552483442, -0.35195034836285388, -0.35769823883312557, -0.36343260940651911, -0.3691532433414072, -0.37485992441536287, -0.38055243693333707, -0.38623056573580633, -0.39189409620690935, -0.39754281428255578, -0.40317650645851938, -0.408794959798506, -0.41439796194220352, -0.41998530111330723, -0.42555676612752458, -0.43111214640055795, -0.43665123195606392, -0.44217381343358819, -0.44767968209648107, -0.45316862983978584, -0.45864044919810493, -0.46409493335344015, -0.46953187614301223, -0.47495107206704995, -0.48035231629656183, -0.4857354046810729, -0.49110013375634509, -0.4964463007520647, -0.50177370359950857, -0.5070821409391808, -0.51237141212842352, -0.51764131724899998, -0.52289165711465191, -0.52812223327862795, -0.53333284804118419, -0.53852330445705532, -0.5436934063429012, -0.54884295828471885, -0.55397176564523276, -0.55907963457124621, -0.56416637200097308, -0.5692317856713317, -0.57427568412521401, -0.57929787671872079, -0.58429817362836844, -0.5892763858582617, -0.5942323252472399, -0.59916580447598666, -0.60407663707411174, -0.60896463742719653, -0.61382962078381298, -0.61867140326250303, -0.62348980185873337, -0.62828463445180716, -0.6330557198117519, -0.6378028776061665, -0.64252592840703937, -0.64722469369752911, -0.65189899587871247, -0.65654865827629583, -0.66117350514729478, -0.66577336168667522, -0.67034805403396169, -0.67489740927980679, -0.6794212554725293, -0.68391942162461028, -0.68839173771915996, -0.6928380347163392, -0.69725814455975266, -0.70165190018279777, -0.70601913551498163, -0.71035968548819683, -0.71467338604296105, -0.71896007413461638, -0.72321958773949468, -0.72745176586103955, -0.73165644853589207, -0.73583347683993661, -0.73998269289430874, -0.74410393987136036, -0.74819706200059111, -0.75226190457453113, -0.75629831395459302, -0.76030613757687548, -0.76428522395793208, -0.76823542270049594, -0.77215658449916424, -0.77604856114604126, -0.77991120553634119, -0.78374437167394717, -0.78754791467693031, -0.79132169078302472, -0.7950655573550629, -0.79877937288636469, -0.80246299700608903, -0.80611629048453581, -0.80973911523841147, -0.81333133433604599, -0.8168928120025698, -0.82042341362504512, -0.82392300575755417, -0.82739145612624221, -0.83082863363431825, -0.83423440836700946, -0.8376086515964718, -0.84095123578665465, -0.8442620345981231, -0.84754092289283089, -0.85078777673885309, -0.85400247341506696, -0.85718489141579368, -0.86033491045538824, -0.86345241147278773, -0.86653727663601066, -0.86958938934661101, -0.87260863424408419, -0.87559489721022921, -0.87854806537346053, -0.88146802711307481, -0.88435467206346929, -0.88720789111831455, -0.89002757643467667, -0.89281362143709475, -0.89556592082160857, -0.89828437055973898, -0.90096886790241903, -0.90361931138387908, -0.90623560082548038, -0.90881763733950294, -0.91136532333288134, -0.9138785625108955, -0.91635725988080885, -0.91880132175545981, -0.92121065575680139, -0.92358517081939495, -0.9259247771938498, -0.92822938645021758, -0.93049891148133312, -0.93273326650610799, -0.9349323670727715, -0.93709613006206383, -0.93922447369037709, -0.94131731751284708, -0.9433745824263926, -0.94539619067270697, -0.94738206584119544, -0.94933213287186502, -0.95124631805815973, -0.95312454904974775, -0.95496675485525517, -0.95677286584495025, -0.95854281375337413, -0.96027653168192206, -0.96197395410137099, -0.96363501685435693, -0.96525965715780004, -0.9668478136052775, -0.96839942616934394, -0.96991443620380113, -0.97139278644591398, -0.97283442101857565, -0.97423928543241844, -0.97560732658787452, -0.9769384927771817, -0.9782327336863389, -0.97949000039700751, -0.98071024538836005, -0.98189342253887657, -0.98303948712808775, -0.98414839583826574, -0.98522010675606064, -0.98625457937408501, -0.9872517745924454, -0.98821165472021921, -0.98913418347688054, -0.99001932599367015, -0.99086704881491472, -0.99167731989928998, -0.99245010862103311, -0.99318538577109949, -0.99388312355826691, -0.99454329561018584, -0.99516587697437653, -0.99575084411917214, -0.99629817493460782, -0.99680784873325645, -0.99727984625101107, -0.99771414964781235, -0.99811074250832332, -0.99846960984254973, -0.99879073808640628, -0.99907411510222999, -0.99931973017923825, -0.99952757403393411, -0.99969763881045715, -0.99982991808087995, -0.99992440684545181, -0.99998110153278685, -1.0, -1.0};
 
@@ -59,6 +278,7 @@ typedef struct
     MYFLT a0;
     MYFLT a1;
     MYFLT a2;
+    CoeffRamp ramp;
 } Biquad;
 
 static void
@@ -135,6 +355,7 @@ Biquad_filters_ii(Biquad *self)
     MYFLT val;
     int i;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
+    FUSED_MULADD_INIT
 
     if (self->init == 1)
     {
@@ -146,7 +367,8 @@ Biquad_filters_ii(Biquad *self)
     {
         val = ( (self->b0 * in[i]) + (self->b1 * self->x1) + (self->b2 * self->x2) - (self->a1 * self->y1) - (self->a2 * self->y2) ) * self->a0;
         self->y2 = self->y1;
-        self->data[i] = self->y1 = val;
+        self->y1 = val;
+        self->data[i] = FUSED_MULADD(val);
         self->x2 = self->x1;
         self->x1 = in[i];
     }
@@ -156,8 +378,9 @@ static void
 Biquad_filters_ai(Biquad *self)
 {
     MYFLT val, q;
-    int i;
+    int i, k, fconst;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
+    FUSED_MULADD_INIT
 
     if (self->init == 1)
     {
@@ -167,13 +390,23 @@ Biquad_filters_ai(Biquad *self)
 
     MYFLT *fr = Stream_getData((Stream *)self->freq_stream);
     q = PyFloat_AS_DOUBLE(self->q);
+    fconst = Stream_getState(self->freq_stream) != PYO_STREAM_VARYING;
+
+    if (fconst)
+        Biquad_compute_variables(self, fr[0], q);
 
     for (i = 0; i < self->bufsize; i++)
     {
-        Biquad_compute_variables(self, fr[i], q);
+        if (! fconst && CoeffRamp_next(&self->ramp, i, self->bufsize, &k))
+        {
+            Biquad_compute_variables(self, fr[k], q);
+            CoeffRamp_start(&self->ramp);
+        }
+
         val = ( (self->b0 * in[i]) + (self->b1 * self->x1) + (self->b2 * self->x2) - (self->a1 * self->y1) - (self->a2 * self->y2) ) * self->a0;
         self->y2 = self->y1;
-        self->data[i] = self->y1 = val;
+        self->y1 = val;
+        self->data[i] = FUSED_MULADD(val);
         self->x2 = self->x1;
         self->x1 = in[i];
     }
@@ -183,8 +416,9 @@ static void
 Biquad_filters_ia(Biquad *self)
 {
     MYFLT val, fr;
-    int i;
+    int i, k, qconst;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
+    FUSED_MULADD_INIT
 
     if (self->init == 1)
     {
@@ -194,13 +428,23 @@ Biquad_filters_ia(Biquad *self)
 
     fr = PyFloat_AS_DOUBLE(self->freq);
     MYFLT *q = Stream_getData((Stream *)self->q_stream);
+    qconst = Stream_getState(self->q_stream) != PYO_STREAM_VARYING;
+
+    if (qconst)
+        Biquad_compute_variables(self, fr, q[0]);
 
     for (i = 0; i < self->bufsize; i++)
     {
-        Biquad_compute_variables(self, fr, q[i]);
+        if (! qconst && CoeffRamp_next(&self->ramp, i, self->bufsize, &k))
+        {
+            Biquad_compute_variables(self, fr, q[k]);
+            CoeffRamp_start(&self->ramp);
+        }
+
         val = ( (self->b0 * in[i]) + (self->b1 * self->x1) + (self->b2 * self->x2) - (self->a1 * self->y1) - (self->a2 * self->y2) ) * self->a0;
         self->y2 = self->y1;
-        self->data[i] = self->y1 = val;
+        self->y1 = val;
+        self->data[i] = FUSED_MULADD(val);
         self->x2 = self->x1;
         self->x1 = in[i];
     }
@@ -210,8 +454,9 @@ static void
 Biquad_filters_aa(Biquad *self)
 {
     MYFLT val;
-    int i;
+    int i, k, fconst;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
+    FUSED_MULADD_INIT
 
     if (self->init == 1)
     {
@@ -221,19 +466,29 @@ Biquad_filters_aa(Biquad *self)
 
     MYFLT *fr = Stream_getData((Stream *)self->freq_stream);
     MYFLT *q = Stream_getData((Stream *)self->q_stream);
+    fconst = Stream_getState(self->freq_stream) != PYO_STREAM_VARYING && Stream_getState(self->q_stream) != PYO_STREAM_VARYING;
+
+    if (fconst)
+        Biquad_compute_variables(self, fr[0], q[0]);
 
     for (i = 0; i < self->bufsize; i++)
     {
-        Biquad_compute_variables(self, fr[i], q[i]);
+        if (! fconst && CoeffRamp_next(&self->ramp, i, self->bufsize, &k))
+        {
+            Biquad_compute_variables(self, fr[k], q[k]);
+            CoeffRamp_start(&self->ramp);
+        }
+
         val = ( (self->b0 * in[i]) + (self->b1 * self->x1) + (self->b2 * self->x2) - (self->a1 * self->y1) - (self->a2 * self->y2) ) * self->a0;
         self->y2 = self->y1;
-        self->data[i] = self->y1 = val;
+        self->y1 = val;
+        self->data[i] = FUSED_MULADD(val);
         self->x2 = self->x1;
         self->x1 = in[i];
     }
 }
 
-static void Biquad_postprocessing_ii(Biquad *self) { POST_PROCESSING_II };
+static void Biquad_postprocessing_fused(Biquad *self) {}; /* mul & add applied by the processing function */
 static void Biquad_postprocessing_ai(Biquad *self) { POST_PROCESSING_AI };
 static void Biquad_postprocessing_ia(Biquad *self) { POST_PROCESSING_IA };
 static void Biquad_postprocessing_aa(Biquad *self) { POST_PROCESSING_AA };
@@ -296,7 +551,7 @@ Biquad_setProcMode(Biquad *self)
     switch (muladdmode)
     {
         case 0:
-            self->muladd_func_ptr = Biquad_postprocessing_ii;
+            self->muladd_func_ptr = Biquad_postprocessing_fused;
             break;
 
         case 1:
@@ -336,7 +591,13 @@ Biquad_setProcMode(Biquad *self)
 static void
 Biquad_compute_next_data_frame(Biquad *self)
 {
-    (*self->proc_func_ptr)(self);
+    /* While muted, the filter memories restart from the input when the
+       output comes back, as for a new object. */
+    if (MULADD_MUTED)
+        self->init = 1;
+    else
+        (*self->proc_func_ptr)(self);
+
     (*self->muladd_func_ptr)(self);
 }
 
@@ -391,7 +652,11 @@ Biquad_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->nyquist = (MYFLT)self->sr * 0.49;
     self->twoPiOverSr = TWOPI / (MYFLT)self->sr;
 
+    MYFLT *coeffs[6] = {&self->b0, &self->b1, &self->b2, &self->a0, &self->a1, &self->a2};
+    CoeffRamp_init(&self->ramp, self->server, 6, coeffs);
+
     Stream_setFunctionPtr(self->stream, Biquad_compute_next_data_frame);
+    Stream_setShareable(self->stream, 1);
     self->mode_func_ptr = Biquad_setProcMode;
 
     static char *kwlist[] = {"input", "freq", "q", "type", "mul", "add", NULL};
@@ -466,6 +731,8 @@ Biquad_setType(Biquad *self, PyObject *arg)
     Py_RETURN_NONE;
 }
 
+static PyObject * Biquad_setCoeffRate(Biquad *self, PyObject *arg) { return CoeffRamp_setRate(&self->ramp, arg); }
+
 static PyMemberDef Biquad_members[] =
 {
     {"server", T_OBJECT_EX, offsetof(Biquad, server), 0, "Pyo server."},
@@ -488,6 +755,7 @@ static PyMethodDef Biquad_methods[] =
     {"setFreq", (PyCFunction)Biquad_setFreq, METH_O, "Sets filter cutoff frequency in cycle per second."},
     {"setQ", (PyCFunction)Biquad_setQ, METH_O, "Sets filter Q factor."},
     {"setType", (PyCFunction)Biquad_setType, METH_O, "Sets filter type factor."},
+    {"setCoeffRate", (PyCFunction)Biquad_setCoeffRate, METH_O, "Sets the number of samples between two computations of the coefficients."},
     {"setMul", (PyCFunction)Biquad_setMul, METH_O, "Sets oscillator mul factor."},
     {"setAdd", (PyCFunction)Biquad_setAdd, METH_O, "Sets oscillator add factor."},
     {"setSub", (PyCFunction)Biquad_setSub, METH_O, "Sets inverse add factor."},
@@ -575,103 +843,35 @@ PyTypeObject BiquadType =
     Biquad_new,                                     /* tp_new */
 };
 
+/************/
+/* BiquadMulti */
+/************/
+/* Filters all the channels of a Biquad with a BiquadBank (see multichannel.h). */
 typedef struct
 {
-    pyo_audio_HEAD
-    PyObject *input;
-    Stream *input_stream;
-    PyObject *freq;
-    Stream *freq_stream;
-    PyObject *q;
-    Stream *q_stream;
-    void (*coeffs_func_ptr)();
-    int init;
-    int modebuffer[4]; // need at least 2 slots for mul & add
-    int filtertype;
-    int stages;
+    pyo_multi_HEAD
+    MultiParam input;
+    MultiParam freq;
+    MultiParam q;
+    BiquadBank bank;
+    int *filtertype;
+    int dirty; /* The coefficients must be computed again from the parameters. */
     MYFLT nyquist;
-    // sample memories
-    MYFLT *x1;
-    MYFLT *x2;
-    MYFLT *y1;
-    MYFLT *y2;
-    // variables
-    MYFLT c;
-    MYFLT w0;
-    MYFLT alpha;
-    // coefficients
-    MYFLT b0;
-    MYFLT b1;
-    MYFLT b2;
-    MYFLT a0;
-    MYFLT a1;
-    MYFLT a2;
-} Biquadx;
-
-static void
-Biquadx_allocate_memories(Biquadx *self)
-{
-    self->x1 = (MYFLT *)PyMem_RawRealloc(self->x1, self->stages * sizeof(MYFLT));
-    self->x2 = (MYFLT *)PyMem_RawRealloc(self->x2, self->stages * sizeof(MYFLT));
-    self->y1 = (MYFLT *)PyMem_RawRealloc(self->y1, self->stages * sizeof(MYFLT));
-    self->y2 = (MYFLT *)PyMem_RawRealloc(self->y2, self->stages * sizeof(MYFLT));
-    self->init = 1;
-}
-
-static void
-Biquadx_compute_coeffs_lp(Biquadx *self)
-{
-    self->b0 = self->b2 = (1 - self->c) / 2;
-    self->b1 = 1 - self->c;
-    self->a0 = 1.0 / (1 + self->alpha);
-    self->a1 = -2 * self->c;
-    self->a2 = 1 - self->alpha;
-}
-
-static void
-Biquadx_compute_coeffs_hp(Biquadx *self)
-{
-    self->b0 = (1 + self->c) / 2;
-    self->b1 = -(1 + self->c);
-    self->b2 = self->b0;
-    self->a0 = 1.0 / (1 + self->alpha);
-    self->a1 = -2 * self->c;
-    self->a2 = 1 - self->alpha;
-}
-
-static void
-Biquadx_compute_coeffs_bp(Biquadx *self)
-{
-    self->b0 = self->alpha;
-    self->b1 = 0;
-    self->b2 = -self->alpha;
-    self->a0 = 1.0 / (1 + self->alpha);
-    self->a1 = -2 * self->c;
-    self->a2 = 1 - self->alpha;
-}
+    MYFLT twoPiOverSr;
+    // parameters of the current coefficients
+    MYFLT *lastFreq;
+    MYFLT *lastQ;
+    CoeffRamp *ramps; /* Coefficients ramp of each channel. */
+} BiquadMulti;
 
 static void
-Biquadx_compute_coeffs_bs(Biquadx *self)
+BiquadMulti_compute_variables(BiquadMulti *self, int chnl, MYFLT freq, MYFLT q)
 {
-    self->b0 = 1;
-    self->b1 = self->a1 = -2 * self->c;
-    self->b2 = 1;
-    self->a0 = 1.0 / (1 + self->alpha);
-    self->a2 = 1 - self->alpha;
-}
+    MYFLT w0, c, alpha;
 
-static void
-Biquadx_compute_coeffs_ap(Biquadx *self)
-{
-    self->b0 = self->a2 = 1 - self->alpha;
-    self->b1 = self->a1 = -2 * self->c;
-    self->b2 = 1 + self->alpha;
-    self->a0 = 1.0 / (1 + self->alpha);
-}
+    self->lastFreq[chnl] = freq;
+    self->lastQ[chnl] = q;
 
-static void
-Biquadx_compute_variables(Biquadx *self, MYFLT freq, MYFLT q)
-{
     if (freq <= 1)
         freq = 1;
     else if (freq >= self->nyquist)
@@ -680,58 +880,482 @@ Biquadx_compute_variables(Biquadx *self, MYFLT freq, MYFLT q)
     if (q < 0.1)
         q = 0.1;
 
-    self->w0 = TWOPI * freq / self->sr;
-    self->c = MYCOS(self->w0);
-    self->alpha = MYSIN(self->w0) / (2 * q);
-    (*self->coeffs_func_ptr)(self);
+    w0 = freq * self->twoPiOverSr;
+    c = MYCOS(w0);
+    alpha = MYSIN(w0) / (2 * q);
+    BiquadBank_setCoeffs(&self->bank, chnl, self->filtertype[chnl], c, alpha);
 }
 
 static void
-Biquadx_filters_ii(Biquadx *self)
+BiquadMulti_update_coeffs(BiquadMulti *self)
 {
-    MYFLT vin, vout;
-    int i, j;
-    MYFLT *in = Stream_getData((Stream *)self->input_stream);
+    int i;
+    MYFLT fr, q;
 
-    if (self->init == 1)
+    for (i = 0; i < self->chnls; i++)
     {
-        for (i = 0; i < self->stages; i++)
-        {
-            self->x1[i] = self->x2[i] = self->y1[i] = self->y2[i] = in[0];
-        }
-
-        self->init = 0;
+        fr = self->freq.streams[i] != NULL ? Stream_getData(self->freq.streams[i])[0] : self->freq.values[i];
+        q = self->q.streams[i] != NULL ? Stream_getData(self->q.streams[i])[0] : self->q.values[i];
+        BiquadMulti_compute_variables(self, i, fr, q);
     }
 
-    vout = 0.0;
+    self->dirty = 0;
+}
+
+/* One channel with an audio parameter, the coefficients are computed again
+   only when the parameters change. */
+static void
+BiquadMulti_filters_chnl(BiquadMulti *self, int chnl)
+{
+    MYFLT val, fr, q;
+    int i, k;
+    MYFLT *in = Stream_getData(self->input.streams[chnl]);
+    MYFLT *out = self->buffer_streams + chnl * self->bufsize;
+    MYFLT *frs = self->freq.streams[chnl] != NULL ? Stream_getData(self->freq.streams[chnl]) : NULL;
+    MYFLT *qs = self->q.streams[chnl] != NULL ? Stream_getData(self->q.streams[chnl]) : NULL;
+
+    BiquadBank_prime(&self->bank, chnl, in[0]);
+
+    fr = self->freq.values[chnl];
+    q = self->q.values[chnl];
 
     for (i = 0; i < self->bufsize; i++)
     {
-        vin = in[i];
-
-        for (j = 0; j < self->stages; j++)
+        if (CoeffRamp_next(&self->ramps[chnl], i, self->bufsize, &k))
         {
-            vout = ( (self->b0 * vin) + (self->b1 * self->x1[j]) + (self->b2 * self->x2[j]) - (self->a1 * self->y1[j]) - (self->a2 * self->y2[j]) ) * self->a0;
-            self->x2[j] = self->x1[j];
-            self->x1[j] = vin;
-            self->y2[j] = self->y1[j];
-            self->y1[j] = vin = vout;
+            if (frs != NULL)
+                fr = frs[k];
+
+            if (qs != NULL)
+                q = qs[k];
+
+            if (fr != self->lastFreq[chnl] || q != self->lastQ[chnl])
+                BiquadMulti_compute_variables(self, chnl, fr, q);
+
+            CoeffRamp_start(&self->ramps[chnl]);
         }
 
-        self->data[i] = vout;
+        BIQUADBANK_TICK(&self->bank, chnl, in[i], val)
+        out[i] = val;
     }
 }
 
 static void
-Biquadx_filters_ai(Biquadx *self)
+BiquadMulti_compute_next_data_frame(BiquadMulti *self)
 {
-    MYFLT vin, vout, q;
-    int i, j;
-    MYFLT *in = Stream_getData((Stream *)self->input_stream);
+    int i, j, lanes;
+    MYFLT *in[PYO_BIQUADBANK_LANES], *out[PYO_BIQUADBANK_LANES];
 
-    if (self->init == 1)
+    if (self->dirty)
+        BiquadMulti_update_coeffs(self);
+
+    for (i = 0; i < self->chnls; i += PYO_BIQUADBANK_LANES)
     {
-        for (i = 0; i < self->stages; i++)
+        lanes = self->chnls - i < PYO_BIQUADBANK_LANES ? self->chnls - i : PYO_BIQUADBANK_LANES;
+
+        if (MultiParam_isFloat(&self->freq, i, lanes) && MultiParam_isFloat(&self->q, i, lanes)
+            && ! MultiObject_isMuted((MultiObject *)self, i, lanes))
+        {
+            for (j = 0; j < lanes; j++)
+            {
+                in[j] = Stream_getData(self->input.streams[i + j]);
+                out[j] = self->buffer_streams + (i + j) * self->bufsize;
+                BiquadBank_prime(&self->bank, i + j, in[j][0]);
+            }
+
+            BiquadBank_process(&self->bank, i, lanes, in, out, self->bufsize);
+        }
+        else
+        {
+            for (j = i; j < i + lanes; j++)
+            {
+                if (! MultiObject_isMuted((MultiObject *)self, j, 1))
+                    BiquadMulti_filters_chnl(self, j);
+            }
+        }
+
+        /* As with Biquad, the memories of a muted channel restart from the
+           input when its output comes back. */
+        for (j = i; j < i + lanes; j++)
+        {
+            if (MultiObject_isMuted((MultiObject *)self, j, 1))
+                self->bank.init[j] = 1;
+        }
+    }
+}
+
+static int
+BiquadMulti_traverse(BiquadMulti *self, visitproc visit, void *arg)
+{
+    pyo_multi_VISIT
+    MULTIPARAM_VISIT(self->input)
+    MULTIPARAM_VISIT(self->freq)
+    MULTIPARAM_VISIT(self->q)
+    return 0;
+}
+
+static int
+BiquadMulti_clear(BiquadMulti *self)
+{
+    pyo_multi_CLEAR
+    MULTIPARAM_CLEAR(self->input)
+    MULTIPARAM_CLEAR(self->freq)
+    MULTIPARAM_CLEAR(self->q)
+    return 0;
+}
+
+static void
+BiquadMulti_dealloc(BiquadMulti* self)
+{
+    pyo_DEALLOC
+    MultiObject_freeBuffer((MultiObject *)self);
+    MultiParam_free(&self->input);
+    MultiParam_free(&self->freq);
+    MultiParam_free(&self->q);
+    BiquadBank_free(&self->bank);
+    PyMem_RawFree(self->filtertype);
+    PyMem_RawFree(self->lastFreq);
+    PyMem_RawFree(self->lastQ);
+    PyMem_RawFree(self->ramps);
+    BiquadMulti_clear(self);
+    Py_TYPE(self->stream)->tp_free((PyObject*)self->stream);
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static PyObject *
+BiquadMulti_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    int i;
+    PyObject *inputtmp, *freqtmp = NULL, *qtmp = NULL, *typetmp = NULL;
+    BiquadMulti *self;
+    self = (BiquadMulti *)type->tp_alloc(type, 0);
+
+    self->dirty = 1;
+
+    INIT_OBJECT_COMMON
+
+    self->nyquist = (MYFLT)self->sr * 0.49;
+    self->twoPiOverSr = TWOPI / (MYFLT)self->sr;
+
+    Stream_setFunctionPtr(self->stream, BiquadMulti_compute_next_data_frame);
+
+    static char *kwlist[] = {"chnls", "input", "freq", "q", "type", NULL};
+
+    if (! PyArg_ParseTupleAndKeywords(args, kwds, "iO|OOO", kwlist, &self->chnls, &inputtmp, &freqtmp, &qtmp, &typetmp))
+        Py_RETURN_NONE;
+
+    if (self->chnls < 1)
+        self->chnls = 1;
+
+    if (MultiObject_allocBuffer((MultiObject *)self) < 0 || BiquadBank_alloc(&self->bank, self->chnls) < 0)
+        return PyErr_NoMemory();
+
+    self->filtertype = (int *)PyMem_RawCalloc(self->chnls, sizeof(int));
+    self->lastFreq = (MYFLT *)PyMem_RawCalloc(self->chnls, sizeof(MYFLT));
+    self->lastQ = (MYFLT *)PyMem_RawCalloc(self->chnls, sizeof(MYFLT));
+    self->ramps = (CoeffRamp *)PyMem_RawCalloc(self->chnls, sizeof(CoeffRamp));
+
+    for (i = 0; i < self->chnls; i++)
+        CoeffRamp_initBank(&self->ramps[i], self->server, &self->bank, i);
+
+    PyObject *deffreq = PyFloat_FromDouble(1000);
+    PyObject *defq = PyFloat_FromDouble(1);
+    i = MultiParam_set(&self->input, inputtmp, self->chnls, self->server);
+
+    if (i == 0 && self->input.audio != self->chnls)
+    {
+        PyErr_SetString(PyExc_TypeError, "\"input\" argument must be a list of PyoObjects.\n");
+        i = -1;
+    }
+
+    if (i == 0)
+        i = MultiParam_set(&self->freq, freqtmp ? freqtmp : deffreq, self->chnls, self->server);
+
+    if (i == 0)
+        i = MultiParam_set(&self->q, qtmp ? qtmp : defq, self->chnls, self->server);
+
+    if (i == 0 && typetmp)
+        i = Multi_setInts(self->filtertype, typetmp, self->chnls);
+
+    Py_DECREF(deffreq);
+    Py_DECREF(defq);
+
+    if (i < 0)
+    {
+        Py_DECREF(self);
+        return NULL;
+    }
+
+    PyObject_CallMethod(self->server, "addStream", "O", self->stream);
+
+    return (PyObject *)self;
+}
+
+static PyObject * BiquadMulti_getServer(BiquadMulti* self) { GET_SERVER };
+static PyObject * BiquadMulti_getStream(BiquadMulti* self) { GET_STREAM };
+
+static PyObject * BiquadMulti_play(BiquadMulti *self, PyObject *args, PyObject *kwds) { PLAY };
+static PyObject * BiquadMulti_stop(BiquadMulti *self, PyObject *args, PyObject *kwds) { STOP };
+
+static PyObject *
+BiquadMulti_setFreq(BiquadMulti *self, PyObject *args)
+{
+    if (MultiParam_setArgs(&self->freq, args, self->chnls, self->server) < 0)
+        return NULL;
+
+    self->dirty = 1;
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+BiquadMulti_setQ(BiquadMulti *self, PyObject *args)
+{
+    if (MultiParam_setArgs(&self->q, args, self->chnls, self->server) < 0)
+        return NULL;
+
+    self->dirty = 1;
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+BiquadMulti_setType(BiquadMulti *self, PyObject *args)
+{
+    if (Multi_setIntsArgs(self->filtertype, args, self->chnls) < 0)
+        return NULL;
+
+    self->dirty = 1;
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+BiquadMulti_setCoeffRate(BiquadMulti *self, PyObject *args)
+{
+    return CoeffRamp_setRates(self->ramps, self->chnls, args);
+}
+
+static PyMemberDef BiquadMulti_members[] =
+{
+    {"server", T_OBJECT_EX, offsetof(BiquadMulti, server), 0, "Pyo server."},
+    {"stream", T_OBJECT_EX, offsetof(BiquadMulti, stream), 0, "Stream object."},
+    {NULL}  /* Sentinel */
+};
+
+static PyMethodDef BiquadMulti_methods[] =
+{
+    {"getServer", (PyCFunction)BiquadMulti_getServer, METH_NOARGS, "Returns server object."},
+    {"_getStream", (PyCFunction)BiquadMulti_getStream, METH_NOARGS, "Returns stream object."},
+    {"play", (PyCFunction)BiquadMulti_play, METH_VARARGS | METH_KEYWORDS, "Starts computing without sending sound to soundcard."},
+    {"stop", (PyCFunction)BiquadMulti_stop, METH_VARARGS | METH_KEYWORDS, "Stops computing."},
+    {"setFreq", (PyCFunction)BiquadMulti_setFreq, METH_VARARGS, "Sets the cutoff frequency of each channel, or of the given channel."},
+    {"setQ", (PyCFunction)BiquadMulti_setQ, METH_VARARGS, "Sets the Q factor of each channel, or of the given channel."},
+    {"setType", (PyCFunction)BiquadMulti_setType, METH_VARARGS, "Sets the filter type of each channel, or of the given channel."},
+    {"setCoeffRate", (PyCFunction)BiquadMulti_setCoeffRate, METH_VARARGS, "Sets the number of samples between two computations of the coefficients of each channel, or of the given channel."},
+    {NULL}  /* Sentinel */
+};
+
+PyTypeObject BiquadMultiType =
+{
+    PyVarObject_HEAD_INIT(NULL, 0)
+    "_pyo.BiquadMulti_base",                                   /*tp_name*/
+    sizeof(BiquadMulti),                                 /*tp_basicsize*/
+    0,                                              /*tp_itemsize*/
+    (destructor)BiquadMulti_dealloc,                     /*tp_dealloc*/
+    0,                                              /*tp_print*/
+    0,                                              /*tp_getattr*/
+    0,                                              /*tp_setattr*/
+    0,                                              /*tp_as_async (tp_compare in Python 2)*/
+    0,                                              /*tp_repr*/
+    0,                                              /*tp_as_number*/
+    0,                                              /*tp_as_sequence*/
+    0,                                              /*tp_as_mapping*/
+    0,                                              /*tp_hash */
+    0,                                              /*tp_call*/
+    0,                                              /*tp_str*/
+    0,                                              /*tp_getattro*/
+    0,                                              /*tp_setattro*/
+    0,                                              /*tp_as_buffer*/
+    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE | Py_TPFLAGS_HAVE_GC, /*tp_flags*/
+    "BiquadMulti objects. Biquad filters of all the channels of a Biquad.",           /* tp_doc */
+    (traverseproc)BiquadMulti_traverse,                  /* tp_traverse */
+    (inquiry)BiquadMulti_clear,                          /* tp_clear */
+    0,                                              /* tp_richcompare */
+    0,                                              /* tp_weaklistoffset */
+    0,                                              /* tp_iter */
+    0,                                              /* tp_iternext */
+    BiquadMulti_methods,                                 /* tp_methods */
+    BiquadMulti_members,                                 /* tp_members */
+    0,                                              /* tp_getset */
+    0,                                              /* tp_base */
+    0,                                              /* tp_dict */
+    0,                                              /* tp_descr_get */
+    0,                                              /* tp_descr_set */
+    0,                                              /* tp_dictoffset */
+    0,                          /* tp_init */
+    0,                                              /* tp_alloc */
+    BiquadMulti_new,                                     /* tp_new */
+};
+
+typedef struct
+{
+    pyo_audio_HEAD
+    PyObject *input;
+    Stream *input_stream;
+    PyObject *freq;
+    Stream *freq_stream;
+    PyObject *q;
+    Stream *q_stream;
+    void (*coeffs_func_ptr)();
+    int init;
+    int modebuffer[4]; // need at least 2 slots for mul & add
+    int filtertype;
+    int stages;
+    MYFLT nyquist;
+    // sample memories
+    MYFLT *x1;
+    MYFLT *x2;
+    MYFLT *y1;
+    MYFLT *y2;
+    // variables
+    MYFLT c;
+    MYFLT w0;
+    MYFLT alpha;
+    // coefficients
+    MYFLT b0;
+    MYFLT b1;
+    MYFLT b2;
+    MYFLT a0;
+    MYFLT a1;
+    MYFLT a2;
+    CoeffRamp ramp;
+} Biquadx;
+
+static void
+Biquadx_allocate_memories(Biquadx *self)
+{
+    self->x1 = (MYFLT *)PyMem_RawRealloc(self->x1, self->stages * sizeof(MYFLT));
+    self->x2 = (MYFLT *)PyMem_RawRealloc(self->x2, self->stages * sizeof(MYFLT));
+    self->y1 = (MYFLT *)PyMem_RawRealloc(self->y1, self->stages * sizeof(MYFLT));
+    self->y2 = (MYFLT *)PyMem_RawRealloc(self->y2, self->stages * sizeof(MYFLT));
+    self->init = 1;
+}
+
+static void
+Biquadx_compute_coeffs_lp(Biquadx *self)
+{
+    self->b0 = self->b2 = (1 - self->c) / 2;
+    self->b1 = 1 - self->c;
+    self->a0 = 1.0 / (1 + self->alpha);
+    self->a1 = -2 * self->c;
+    self->a2 = 1 - self->alpha;
+}
+
+static void
+Biquadx_compute_coeffs_hp(Biquadx *self)
+{
+    self->b0 = (1 + self->c) / 2;
+    self->b1 = -(1 + self->c);
+    self->b2 = self->b0;
+    self->a0 = 1.0 / (1 + self->alpha);
+    self->a1 = -2 * self->c;
+    self->a2 = 1 - self->alpha;
+}
+
+static void
+Biquadx_compute_coeffs_bp(Biquadx *self)
+{
+    self->b0 = self->alpha;
+    self->b1 = 0;
+    self->b2 = -self->alpha;
+    self->a0 = 1.0 / (1 + self->alpha);
+    self->a1 = -2 * self->c;
+    self->a2 = 1 - self->alpha;
+}
+
+static void
+Biquadx_compute_coeffs_bs(Biquadx *self)
+{
+    self->b0 = 1;
+    self->b1 = self->a1 = -2 * self->c;
+    self->b2 = 1;
+    self->a0 = 1.0 / (1 + self->alpha);
+    self->a2 = 1 - self->alpha;
+}
+
+static void
+Biquadx_compute_coeffs_ap(Biquadx *self)
+{
+    self->b0 = self->a2 = 1 - self->alpha;
+    self->b1 = self->a1 = -2 * self->c;
+    self->b2 = 1 + self->alpha;
+    self->a0 = 1.0 / (1 + self->alpha);
+}
+
+static void
+Biquadx_compute_variables(Biquadx *self, MYFLT freq, MYFLT q)
+{
+    if (freq <= 1)
+        freq = 1;
+    else if (freq >= self->nyquist)
+        freq = self->nyquist;
+
+    if (q < 0.1)
+        q = 0.1;
+
+    self->w0 = TWOPI * freq / self->sr;
+    self->c = MYCOS(self->w0);
+    self->alpha = MYSIN(self->w0) / (2 * q);
+    (*self->coeffs_func_ptr)(self);
+}
+
+static void
+Biquadx_filters_ii(Biquadx *self)
+{
+    MYFLT vin, vout;
+    int i, j;
+    MYFLT *in = Stream_getData((Stream *)self->input_stream);
+
+    if (self->init == 1)
+    {
+        for (i = 0; i < self->stages; i++)
+        {
+            self->x1[i] = self->x2[i] = self->y1[i] = self->y2[i] = in[0];
+        }
+
+        self->init = 0;
+    }
+
+    vout = 0.0;
+
+    for (i = 0; i < self->bufsize; i++)
+    {
+        vin = in[i];
+
+        for (j = 0; j < self->stages; j++)
+        {
+            vout = ( (self->b0 * vin) + (self->b1 * self->x1[j]) + (self->b2 * self->x2[j]) - (self->a1 * self->y1[j]) - (self->a2 * self->y2[j]) ) * self->a0;
+            self->x2[j] = self->x1[j];
+            self->x1[j] = vin;
+            self->y2[j] = self->y1[j];
+            self->y1[j] = vin = vout;
+        }
+
+        self->data[i] = vout;
+    }
+}
+
+static void
+Biquadx_filters_ai(Biquadx *self)
+{
+    MYFLT vin, vout, q;
+    int i, j, k;
+    MYFLT *in = Stream_getData((Stream *)self->input_stream);
+
+    if (self->init == 1)
+    {
+        for (i = 0; i < self->stages; i++)
         {
             self->x1[i] = self->x2[i] = self->y1[i] = self->y2[i] = in[0];
         }
@@ -746,7 +1370,12 @@ Biquadx_filters_ai(Biquadx *self)
 
     for (i = 0; i < self->bufsize; i++)
     {
-        Biquadx_compute_variables(self, fr[i], q);
+        if (CoeffRamp_next(&self->ramp, i, self->bufsize, &k))
+        {
+            Biquadx_compute_variables(self, fr[k], q);
+            CoeffRamp_start(&self->ramp);
+        }
+
         vin = in[i];
 
         for (j = 0; j < self->stages; j++)
@@ -766,7 +1395,7 @@ static void
 Biquadx_filters_ia(Biquadx *self)
 {
     MYFLT vin, vout, fr;
-    int i, j;
+    int i, j, k;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
 
     if (self->init == 1)
@@ -786,7 +1415,12 @@ Biquadx_filters_ia(Biquadx *self)
 
     for (i = 0; i < self->bufsize; i++)
     {
-        Biquadx_compute_variables(self, fr, q[i]);
+        if (CoeffRamp_next(&self->ramp, i, self->bufsize, &k))
+        {
+            Biquadx_compute_variables(self, fr, q[k]);
+            CoeffRamp_start(&self->ramp);
+        }
+
         vin = in[i];
 
         for (j = 0; j < self->stages; j++)
@@ -806,7 +1440,7 @@ static void
 Biquadx_filters_aa(Biquadx *self)
 {
     MYFLT vin, vout;
-    int i, j;
+    int i, j, k;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
 
     if (self->init == 1)
@@ -826,7 +1460,12 @@ Biquadx_filters_aa(Biquadx *self)
 
     for (i = 0; i < self->bufsize; i++)
     {
-        Biquadx_compute_variables(self, fr[i], q[i]);
+        if (CoeffRamp_next(&self->ramp, i, self->bufsize, &k))
+        {
+            Biquadx_compute_variables(self, fr[k], q[k]);
+            CoeffRamp_start(&self->ramp);
+        }
+
         vin = in[i];
 
         for (j = 0; j < self->stages; j++)
@@ -1004,6 +1643,9 @@ Biquadx_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     self->nyquist = (MYFLT)self->sr * 0.49;
 
+    MYFLT *coeffs[6] = {&self->b0, &self->b1, &self->b2, &self->a0, &self->a1, &self->a2};
+    CoeffRamp_init(&self->ramp, self->server, 6, coeffs);
+
     Stream_setFunctionPtr(self->stream, Biquadx_compute_next_data_frame);
     self->mode_func_ptr = Biquadx_setProcMode;
 
@@ -1095,6 +1737,8 @@ Biquadx_setStages(Biquadx *self, PyObject *arg)
     Py_RETURN_NONE;
 }
 
+static PyObject * Biquadx_setCoeffRate(Biquadx *self, PyObject *arg) { return CoeffRamp_setRate(&self->ramp, arg); }
+
 static PyMemberDef Biquadx_members[] =
 {
     {"server", T_OBJECT_EX, offsetof(Biquadx, server), 0, "Pyo server."},
@@ -1118,6 +1762,7 @@ static PyMethodDef Biquadx_methods[] =
     {"setQ", (PyCFunction)Biquadx_setQ, METH_O, "Sets filter Q factor."},
     {"setType", (PyCFunction)Biquadx_setType, METH_O, "Sets filter type factor."},
     {"setStages", (PyCFunction)Biquadx_setStages, METH_O, "Sets the number of filtering stages."},
+    {"setCoeffRate", (PyCFunction)Biquadx_setCoeffRate, METH_O, "Sets the number of samples between two computations of the coefficients."},
     {"setMul", (PyCFunction)Biquadx_setMul, METH_O, "Sets oscillator mul factor."},
     {"setAdd", (PyCFunction)Biquadx_setAdd, METH_O, "Sets oscillator add factor."},
     {"setSub", (PyCFunction)Biquadx_setSub, METH_O, "Sets inverse add factor."},
@@ -1205,6 +1850,439 @@ PyTypeObject BiquadxType =
     Biquadx_new,                                     /* tp_new */
 };
 
+/************/
+/* BiquadxMulti */
+/************/
+/* Filters all the channels of a Biquadx with a BiquadBank (see multichannel.h).
+   The filter of stage s of channel c is the filter s * chnls + c of the bank. */
+typedef struct
+{
+    pyo_multi_HEAD
+    MultiParam input;
+    MultiParam freq;
+    MultiParam q;
+    BiquadBank bank;
+    int *filtertype;
+    int *stages;
+    int maxstages;
+    int dirty; /* The coefficients must be computed again from the parameters. */
+    MYFLT nyquist;
+    // parameters of the current coefficients
+    MYFLT *lastFreq;
+    MYFLT *lastQ;
+    CoeffRamp *ramps; /* Coefficients ramp of each channel, on its first stage. */
+} BiquadxMulti;
+
+static int
+BiquadxMulti_allocate_memories(BiquadxMulti *self)
+{
+    int i;
+
+    self->maxstages = 1;
+
+    for (i = 0; i < self->chnls; i++)
+    {
+        if (self->stages[i] > self->maxstages)
+            self->maxstages = self->stages[i];
+    }
+
+    self->dirty = 1;
+
+    if (BiquadBank_alloc(&self->bank, self->chnls * self->maxstages) < 0)
+        return -1;
+
+    for (i = 0; i < self->chnls; i++)
+        CoeffRamp_bindBank(&self->ramps[i], &self->bank, i);
+
+    return 0;
+}
+
+static void
+BiquadxMulti_compute_variables(BiquadxMulti *self, int chnl, MYFLT freq, MYFLT q)
+{
+    MYFLT w0, c, alpha;
+    int i;
+
+    self->lastFreq[chnl] = freq;
+    self->lastQ[chnl] = q;
+
+    if (freq <= 1)
+        freq = 1;
+    else if (freq >= self->nyquist)
+        freq = self->nyquist;
+
+    if (q < 0.1)
+        q = 0.1;
+
+    w0 = TWOPI * freq / self->sr;
+    c = MYCOS(w0);
+    alpha = MYSIN(w0) / (2 * q);
+    BiquadBank_setCoeffs(&self->bank, chnl, self->filtertype[chnl], c, alpha);
+
+    for (i = 1; i < self->stages[chnl]; i++)
+        BiquadBank_copyCoeffs(&self->bank, i * self->chnls + chnl, chnl);
+}
+
+static void
+BiquadxMulti_update_coeffs(BiquadxMulti *self)
+{
+    int i;
+    MYFLT fr, q;
+
+    for (i = 0; i < self->chnls; i++)
+    {
+        fr = self->freq.streams[i] != NULL ? Stream_getData(self->freq.streams[i])[0] : self->freq.values[i];
+        q = self->q.streams[i] != NULL ? Stream_getData(self->q.streams[i])[0] : self->q.values[i];
+        BiquadxMulti_compute_variables(self, i, fr, q);
+    }
+
+    self->dirty = 0;
+}
+
+/* Channels first to first+lanes-1, with the same number of stages. The
+   stages are computed one after the other over the whole block. */
+static void
+BiquadxMulti_filters_lanes(BiquadxMulti *self, int first, int lanes)
+{
+    int i, j;
+    MYFLT *in[PYO_BIQUADBANK_LANES], *out[PYO_BIQUADBANK_LANES];
+
+    for (j = 0; j < lanes; j++)
+    {
+        in[j] = Stream_getData(self->input.streams[first + j]);
+        out[j] = self->buffer_streams + (first + j) * self->bufsize;
+
+        for (i = 0; i < self->stages[first]; i++)
+            BiquadBank_prime(&self->bank, i * self->chnls + first + j, in[j][0]);
+    }
+
+    BiquadBank_process(&self->bank, first, lanes, in, out, self->bufsize);
+
+    for (i = 1; i < self->stages[first]; i++)
+        BiquadBank_process(&self->bank, i * self->chnls + first, lanes, out, out, self->bufsize);
+}
+
+/* One channel with an audio parameter, the coefficients are computed again
+   only when the parameters change. */
+static void
+BiquadxMulti_filters_chnl(BiquadxMulti *self, int chnl)
+{
+    MYFLT vin, vout, fr, q;
+    int i, j, k, f;
+    MYFLT *in = Stream_getData(self->input.streams[chnl]);
+    MYFLT *out = self->buffer_streams + chnl * self->bufsize;
+    MYFLT *frs = self->freq.streams[chnl] != NULL ? Stream_getData(self->freq.streams[chnl]) : NULL;
+    MYFLT *qs = self->q.streams[chnl] != NULL ? Stream_getData(self->q.streams[chnl]) : NULL;
+
+    for (j = 0; j < self->stages[chnl]; j++)
+        BiquadBank_prime(&self->bank, j * self->chnls + chnl, in[0]);
+
+    fr = self->freq.values[chnl];
+    q = self->q.values[chnl];
+    vout = 0.0;
+
+    for (i = 0; i < self->bufsize; i++)
+    {
+        if (CoeffRamp_next(&self->ramps[chnl], i, self->bufsize, &k))
+        {
+            if (frs != NULL)
+                fr = frs[k];
+
+            if (qs != NULL)
+                q = qs[k];
+
+            if (fr != self->lastFreq[chnl] || q != self->lastQ[chnl])
+                BiquadxMulti_compute_variables(self, chnl, fr, q);
+
+            CoeffRamp_start(&self->ramps[chnl]);
+        }
+
+        /* The ramp only moves the coefficients of the first stage. */
+        if (self->ramps[chnl].rate > 1)
+        {
+            for (j = 1; j < self->stages[chnl]; j++)
+                BiquadBank_copyCoeffs(&self->bank, j * self->chnls + chnl, chnl);
+        }
+
+        vin = in[i];
+
+        for (j = 0; j < self->stages[chnl]; j++)
+        {
+            f = j * self->chnls + chnl;
+            BIQUADBANK_TICK(&self->bank, f, vin, vout)
+            vin = vout;
+        }
+
+        out[i] = vout;
+    }
+}
+
+static void
+BiquadxMulti_compute_next_data_frame(BiquadxMulti *self)
+{
+    int i, j, lanes, same;
+
+    if (self->dirty)
+        BiquadxMulti_update_coeffs(self);
+
+    for (i = 0; i < self->chnls; i += PYO_BIQUADBANK_LANES)
+    {
+        lanes = self->chnls - i < PYO_BIQUADBANK_LANES ? self->chnls - i : PYO_BIQUADBANK_LANES;
+        same = self->stages[i] > 0;
+
+        for (j = i + 1; j < i + lanes; j++)
+        {
+            if (self->stages[j] != self->stages[i])
+                same = 0;
+        }
+
+        if (same && MultiParam_isFloat(&self->freq, i, lanes) && MultiParam_isFloat(&self->q, i, lanes))
+            BiquadxMulti_filters_lanes(self, i, lanes);
+        else
+        {
+            for (j = i; j < i + lanes; j++)
+                BiquadxMulti_filters_chnl(self, j);
+        }
+    }
+}
+
+static int
+BiquadxMulti_traverse(BiquadxMulti *self, visitproc visit, void *arg)
+{
+    pyo_multi_VISIT
+    MULTIPARAM_VISIT(self->input)
+    MULTIPARAM_VISIT(self->freq)
+    MULTIPARAM_VISIT(self->q)
+    return 0;
+}
+
+static int
+BiquadxMulti_clear(BiquadxMulti *self)
+{
+    pyo_multi_CLEAR
+    MULTIPARAM_CLEAR(self->input)
+    MULTIPARAM_CLEAR(self->freq)
+    MULTIPARAM_CLEAR(self->q)
+    return 0;
+}
+
+static void
+BiquadxMulti_dealloc(BiquadxMulti* self)
+{
+    pyo_DEALLOC
+    MultiObject_freeBuffer((MultiObject *)self);
+    MultiParam_free(&self->input);
+    MultiParam_free(&self->freq);
+    MultiParam_free(&self->q);
+    BiquadBank_free(&self->bank);
+    PyMem_RawFree(self->filtertype);
+    PyMem_RawFree(self->stages);
+    PyMem_RawFree(self->lastFreq);
+    PyMem_RawFree(self->lastQ);
+    PyMem_RawFree(self->ramps);
+    BiquadxMulti_clear(self);
+    Py_TYPE(self->stream)->tp_free((PyObject*)self->stream);
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static PyObject *
+BiquadxMulti_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    int i;
+    PyObject *inputtmp, *freqtmp = NULL, *qtmp = NULL, *typetmp = NULL, *stagestmp = NULL;
+    BiquadxMulti *self;
+    self = (BiquadxMulti *)type->tp_alloc(type, 0);
+
+    self->dirty = 1;
+
+    INIT_OBJECT_COMMON
+
+    self->nyquist = (MYFLT)self->sr * 0.49;
+
+    Stream_setFunctionPtr(self->stream, BiquadxMulti_compute_next_data_frame);
+
+    static char *kwlist[] = {"chnls", "input", "freq", "q", "type", "stages", NULL};
+
+    if (! PyArg_ParseTupleAndKeywords(args, kwds, "iO|OOOO", kwlist, &self->chnls, &inputtmp, &freqtmp, &qtmp, &typetmp, &stagestmp))
+        Py_RETURN_NONE;
+
+    if (self->chnls < 1)
+        self->chnls = 1;
+
+    self->filtertype = (int *)PyMem_RawCalloc(self->chnls, sizeof(int));
+    self->stages = (int *)PyMem_RawMalloc(self->chnls * sizeof(int));
+    self->lastFreq = (MYFLT *)PyMem_RawCalloc(self->chnls, sizeof(MYFLT));
+    self->lastQ = (MYFLT *)PyMem_RawCalloc(self->chnls, sizeof(MYFLT));
+    self->ramps = (CoeffRamp *)PyMem_RawCalloc(self->chnls, sizeof(CoeffRamp));
+
+    for (i = 0; i < self->chnls; i++)
+        self->stages[i] = 4;
+
+    if (stagestmp && Multi_setInts(self->stages, stagestmp, self->chnls) < 0)
+    {
+        Py_DECREF(self);
+        return NULL;
+    }
+
+    if (MultiObject_allocBuffer((MultiObject *)self) < 0 || BiquadxMulti_allocate_memories(self) < 0)
+        return PyErr_NoMemory();
+
+    for (i = 0; i < self->chnls; i++)
+        CoeffRamp_initBank(&self->ramps[i], self->server, &self->bank, i);
+
+    PyObject *deffreq = PyFloat_FromDouble(1000);
+    PyObject *defq = PyFloat_FromDouble(1);
+    i = MultiParam_set(&self->input, inputtmp, self->chnls, self->server);
+
+    if (i == 0 && self->input.audio != self->chnls)
+    {
+        PyErr_SetString(PyExc_TypeError, "\"input\" argument must be a list of PyoObjects.\n");
+        i = -1;
+    }
+
+    if (i == 0)
+        i = MultiParam_set(&self->freq, freqtmp ? freqtmp : deffreq, self->chnls, self->server);
+
+    if (i == 0)
+        i = MultiParam_set(&self->q, qtmp ? qtmp : defq, self->chnls, self->server);
+
+    if (i == 0 && typetmp)
+        i = Multi_setInts(self->filtertype, typetmp, self->chnls);
+
+    Py_DECREF(deffreq);
+    Py_DECREF(defq);
+
+    if (i < 0)
+    {
+        Py_DECREF(self);
+        return NULL;
+    }
+
+    PyObject_CallMethod(self->server, "addStream", "O", self->stream);
+
+    return (PyObject *)self;
+}
+
+static PyObject * BiquadxMulti_getServer(BiquadxMulti* self) { GET_SERVER };
+static PyObject * BiquadxMulti_getStream(BiquadxMulti* self) { GET_STREAM };
+
+static PyObject * BiquadxMulti_play(BiquadxMulti *self, PyObject *args, PyObject *kwds) { PLAY };
+static PyObject * BiquadxMulti_stop(BiquadxMulti *self, PyObject *args, PyObject *kwds) { STOP };
+
+static PyObject *
+BiquadxMulti_setFreq(BiquadxMulti *self, PyObject *args)
+{
+    if (MultiParam_setArgs(&self->freq, args, self->chnls, self->server) < 0)
+        return NULL;
+
+    self->dirty = 1;
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+BiquadxMulti_setQ(BiquadxMulti *self, PyObject *args)
+{
+    if (MultiParam_setArgs(&self->q, args, self->chnls, self->server) < 0)
+        return NULL;
+
+    self->dirty = 1;
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+BiquadxMulti_setType(BiquadxMulti *self, PyObject *args)
+{
+    if (Multi_setIntsArgs(self->filtertype, args, self->chnls) < 0)
+        return NULL;
+
+    self->dirty = 1;
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+BiquadxMulti_setStages(BiquadxMulti *self, PyObject *args)
+{
+    if (Multi_setIntsArgs(self->stages, args, self->chnls) < 0)
+        return NULL;
+
+    if (BiquadxMulti_allocate_memories(self) < 0)
+        return PyErr_NoMemory();
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+BiquadxMulti_setCoeffRate(BiquadxMulti *self, PyObject *args)
+{
+    return CoeffRamp_setRates(self->ramps, self->chnls, args);
+}
+
+static PyMemberDef BiquadxMulti_members[] =
+{
+    {"server", T_OBJECT_EX, offsetof(BiquadxMulti, server), 0, "Pyo server."},
+    {"stream", T_OBJECT_EX, offsetof(BiquadxMulti, stream), 0, "Stream object."},
+    {NULL}  /* Sentinel */
+};
+
+static PyMethodDef BiquadxMulti_methods[] =
+{
+    {"getServer", (PyCFunction)BiquadxMulti_getServer, METH_NOARGS, "Returns server object."},
+    {"_getStream", (PyCFunction)BiquadxMulti_getStream, METH_NOARGS, "Returns stream object."},
+    {"play", (PyCFunction)BiquadxMulti_play, METH_VARARGS | METH_KEYWORDS, "Starts computing without sending sound to soundcard."},
+    {"stop", (PyCFunction)BiquadxMulti_stop, METH_VARARGS | METH_KEYWORDS, "Stops computing."},
+    {"setFreq", (PyCFunction)BiquadxMulti_setFreq, METH_VARARGS, "Sets the cutoff frequency of each channel, or of the given channel."},
+    {"setQ", (PyCFunction)BiquadxMulti_setQ, METH_VARARGS, "Sets the Q factor of each channel, or of the given channel."},
+    {"setType", (PyCFunction)BiquadxMulti_setType, METH_VARARGS, "Sets the filter type of each channel, or of the given channel."},
+    {"setStages", (PyCFunction)BiquadxMulti_setStages, METH_VARARGS, "Sets the number of filtering stages of each channel, or of the given channel."},
+    {"setCoeffRate", (PyCFunction)BiquadxMulti_setCoeffRate, METH_VARARGS, "Sets the number of samples between two computations of the coefficients of each channel, or of the given channel."},
+    {NULL}  /* Sentinel */
+};
+
+PyTypeObject BiquadxMultiType =
+{
+    PyVarObject_HEAD_INIT(NULL, 0)
+    "_pyo.BiquadxMulti_base",                                   /*tp_name*/
+    sizeof(BiquadxMulti),                                 /*tp_basicsize*/
+    0,                                              /*tp_itemsize*/
+    (destructor)BiquadxMulti_dealloc,                     /*tp_dealloc*/
+    0,                                              /*tp_print*/
+    0,                                              /*tp_getattr*/
+    0,                                              /*tp_setattr*/
+    0,                                              /*tp_as_async (tp_compare in Python 2)*/
+    0,                                              /*tp_repr*/
+    0,                                              /*tp_as_number*/
+    0,                                              /*tp_as_sequence*/
+    0,                                              /*tp_as_mapping*/
+    0,                                              /*tp_hash */
+    0,                                              /*tp_call*/
+    0,                                              /*tp_str*/
+    0,                                              /*tp_getattro*/
+    0,                                              /*tp_setattro*/
+    0,                                              /*tp_as_buffer*/
+    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE | Py_TPFLAGS_HAVE_GC, /*tp_flags*/
+    "BiquadxMulti objects. Cascaded biquad filters of all the channels of a Biquadx.",           /* tp_doc */
+    (traverseproc)BiquadxMulti_traverse,                  /* tp_traverse */
+    (inquiry)BiquadxMulti_clear,                          /* tp_clear */
+    0,                                              /* tp_richcompare */
+    0,                                              /* tp_weaklistoffset */
+    0,                                              /* tp_iter */
+    0,                                              /* tp_iternext */
+    BiquadxMulti_methods,                                 /* tp_methods */
+    BiquadxMulti_members,                                 /* tp_members */
+    0,                                              /* tp_getset */
+    0,                                              /* tp_base */
+    0,                                              /* tp_dict */
+    0,                                              /* tp_descr_get */
+    0,                                              /* tp_descr_set */
+    0,                                              /* tp_dictoffset */
+    0,                          /* tp_init */
+    0,                                              /* tp_alloc */
+    BiquadxMulti_new,                                     /* tp_new */
+};
+
 /*** Biquad filter with direct coefficient control ***/
 typedef struct
 {
@@ -1326,6 +2404,12 @@ Biquada_traverse(Biquada *self, visitproc visit, void *arg)
 {
     pyo_VISIT
     Py_VISIT(self->input);
+    Py_VISIT(self->b0_stream);
+    Py_VISIT(self->b1_stream);
+    Py_VISIT(self->b2_stream);
+    Py_VISIT(self->a0_stream);
+    Py_VISIT(self->a1_stream);
+    Py_VISIT(self->a2_stream);
     return 0;
 }
 
@@ -1433,6 +2517,7 @@ Biquada_setB0(Biquada *self, PyObject *arg)
     PyObject *streamtmp = PyObject_CallMethod((PyObject *)arg, "_getStream", NULL);
     self->b0_stream = (Stream *)streamtmp;
     Py_INCREF(self->b0_stream);
+    Stream_invalidateGraph();
 
     Py_RETURN_NONE;
 }
@@ -1445,6 +2530,7 @@ Biquada_setB1(Biquada *self, PyObject *arg)
     PyObject *streamtmp = PyObject_CallMethod((PyObject *)arg, "_getStream", NULL);
     self->b1_stream = (Stream *)streamtmp;
     Py_INCREF(self->b1_stream);
+    Stream_invalidateGraph();
 
     Py_RETURN_NONE;
 }
@@ -1457,6 +2543,7 @@ Biquada_setB2(Biquada *self, PyObject *arg)
     PyObject *streamtmp = PyObject_CallMethod((PyObject *)arg, "_getStream", NULL);
     self->b2_stream = (Stream *)streamtmp;
     Py_INCREF(self->b2_stream);
+    Stream_invalidateGraph();
 
     Py_RETURN_NONE;
 }
@@ -1469,6 +2556,7 @@ Biquada_setA0(Biquada *self, PyObject *arg)
     PyObject *streamtmp = PyObject_CallMethod((PyObject *)arg, "_getStream", NULL);
     self->a0_stream = (Stream *)streamtmp;
     Py_INCREF(self->a0_stream);
+    Stream_invalidateGraph();
 
     Py_RETURN_NONE;
 }
@@ -1481,6 +2569,7 @@ Biquada_setA1(Biquada *self, PyObject *arg)
     PyObject *streamtmp = PyObject_CallMethod((PyObject *)arg, "_getStream", NULL);
     self->a1_stream = (Stream *)streamtmp;
     Py_INCREF(self->a1_stream);
+    Stream_invalidateGraph();
 
     Py_RETURN_NONE;
 }
@@ -1493,6 +2582,7 @@ Biquada_setA2(Biquada *self, PyObject *arg)
     PyObject *streamtmp = PyObject_CallMethod((PyObject *)arg, "_getStream", NULL);
     self->a2_stream = (Stream *)streamtmp;
     Py_INCREF(self->a2_stream);
+    Stream_invalidateGraph();
 
     Py_RETURN_NONE;
 }
@@ -1642,6 +2732,7 @@ typedef struct
     MYFLT a0;
     MYFLT a1;
     MYFLT a2;
+    CoeffRamp ramp;
 } EQ;
 
 static void
@@ -1729,7 +2820,7 @@ static void
 EQ_filters_aii(EQ *self)
 {
     MYFLT val, q, boost;
-    int i;
+    int i, k;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
 
     if (self->init == 1)
@@ -1744,7 +2835,12 @@ EQ_filters_aii(EQ *self)
 
     for (i = 0; i < self->bufsize; i++)
     {
-        EQ_compute_variables(self, fr[i], q, boost);
+        if (CoeffRamp_next(&self->ramp, i, self->bufsize, &k))
+        {
+            EQ_compute_variables(self, fr[k], q, boost);
+            CoeffRamp_start(&self->ramp);
+        }
+
         val = ( (self->b0 * in[i]) + (self->b1 * self->x1) + (self->b2 * self->x2) - (self->a1 * self->y1) - (self->a2 * self->y2) ) * self->a0;
         self->y2 = self->y1;
         self->data[i] = self->y1 = val;
@@ -1757,7 +2853,7 @@ static void
 EQ_filters_iai(EQ *self)
 {
     MYFLT val, fr, boost;
-    int i;
+    int i, k;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
 
     if (self->init == 1)
@@ -1772,7 +2868,12 @@ EQ_filters_iai(EQ *self)
 
     for (i = 0; i < self->bufsize; i++)
     {
-        EQ_compute_variables(self, fr, q[i], boost);
+        if (CoeffRamp_next(&self->ramp, i, self->bufsize, &k))
+        {
+            EQ_compute_variables(self, fr, q[k], boost);
+            CoeffRamp_start(&self->ramp);
+        }
+
         val = ( (self->b0 * in[i]) + (self->b1 * self->x1) + (self->b2 * self->x2) - (self->a1 * self->y1) - (self->a2 * self->y2) ) * self->a0;
         self->y2 = self->y1;
         self->data[i] = self->y1 = val;
@@ -1785,7 +2886,7 @@ static void
 EQ_filters_aai(EQ *self)
 {
     MYFLT val, boost;
-    int i;
+    int i, k;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
 
     if (self->init == 1)
@@ -1800,7 +2901,12 @@ EQ_filters_aai(EQ *self)
 
     for (i = 0; i < self->bufsize; i++)
     {
-        EQ_compute_variables(self, fr[i], q[i], boost);
+        if (CoeffRamp_next(&self->ramp, i, self->bufsize, &k))
+        {
+            EQ_compute_variables(self, fr[k], q[k], boost);
+            CoeffRamp_start(&self->ramp);
+        }
+
         val = ( (self->b0 * in[i]) + (self->b1 * self->x1) + (self->b2 * self->x2) - (self->a1 * self->y1) - (self->a2 * self->y2) ) * self->a0;
         self->y2 = self->y1;
         self->data[i] = self->y1 = val;
@@ -1813,7 +2919,7 @@ static void
 EQ_filters_iia(EQ *self)
 {
     MYFLT val, fr, q;
-    int i;
+    int i, k;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
 
     if (self->init == 1)
@@ -1828,7 +2934,12 @@ EQ_filters_iia(EQ *self)
 
     for (i = 0; i < self->bufsize; i++)
     {
-        EQ_compute_variables(self, fr, q, boost[i]);
+        if (CoeffRamp_next(&self->ramp, i, self->bufsize, &k))
+        {
+            EQ_compute_variables(self, fr, q, boost[k]);
+            CoeffRamp_start(&self->ramp);
+        }
+
         val = ( (self->b0 * in[i]) + (self->b1 * self->x1) + (self->b2 * self->x2) - (self->a1 * self->y1) - (self->a2 * self->y2) ) * self->a0;
         self->y2 = self->y1;
         self->data[i] = self->y1 = val;
@@ -1841,7 +2952,7 @@ static void
 EQ_filters_aia(EQ *self)
 {
     MYFLT val, q;
-    int i;
+    int i, k;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
 
     if (self->init == 1)
@@ -1856,7 +2967,12 @@ EQ_filters_aia(EQ *self)
 
     for (i = 0; i < self->bufsize; i++)
     {
-        EQ_compute_variables(self, fr[i], q, boost[i]);
+        if (CoeffRamp_next(&self->ramp, i, self->bufsize, &k))
+        {
+            EQ_compute_variables(self, fr[k], q, boost[k]);
+            CoeffRamp_start(&self->ramp);
+        }
+
         val = ( (self->b0 * in[i]) + (self->b1 * self->x1) + (self->b2 * self->x2) - (self->a1 * self->y1) - (self->a2 * self->y2) ) * self->a0;
         self->y2 = self->y1;
         self->data[i] = self->y1 = val;
@@ -1869,7 +2985,7 @@ static void
 EQ_filters_iaa(EQ *self)
 {
     MYFLT val, fr;
-    int i;
+    int i, k;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
 
     if (self->init == 1)
@@ -1884,7 +3000,12 @@ EQ_filters_iaa(EQ *self)
 
     for (i = 0; i < self->bufsize; i++)
     {
-        EQ_compute_variables(self, fr, q[i], boost[i]);
+        if (CoeffRamp_next(&self->ramp, i, self->bufsize, &k))
+        {
+            EQ_compute_variables(self, fr, q[k], boost[k]);
+            CoeffRamp_start(&self->ramp);
+        }
+
         val = ( (self->b0 * in[i]) + (self->b1 * self->x1) + (self->b2 * self->x2) - (self->a1 * self->y1) - (self->a2 * self->y2) ) * self->a0;
         self->y2 = self->y1;
         self->data[i] = self->y1 = val;
@@ -1897,7 +3018,7 @@ static void
 EQ_filters_aaa(EQ *self)
 {
     MYFLT val;
-    int i;
+    int i, k;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
 
     if (self->init == 1)
@@ -1912,7 +3033,12 @@ EQ_filters_aaa(EQ *self)
 
     for (i = 0; i < self->bufsize; i++)
     {
-        EQ_compute_variables(self, fr[i], q[i], boost[i]);
+        if (CoeffRamp_next(&self->ramp, i, self->bufsize, &k))
+        {
+            EQ_compute_variables(self, fr[k], q[k], boost[k]);
+            CoeffRamp_start(&self->ramp);
+        }
+
         val = ( (self->b0 * in[i]) + (self->b1 * self->x1) + (self->b2 * self->x2) - (self->a1 * self->y1) - (self->a2 * self->y2) ) * self->a0;
         self->y2 = self->y1;
         self->data[i] = self->y1 = val;
@@ -2091,6 +3217,9 @@ EQ_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->nyquist = (MYFLT)self->sr * 0.49;
     self->twoPiOverSr = TWOPI / (MYFLT)self->sr;
 
+    MYFLT *coeffs[6] = {&self->b0, &self->b1, &self->b2, &self->a0, &self->a1, &self->a2};
+    CoeffRamp_init(&self->ramp, self->server, 6, coeffs);
+
     Stream_setFunctionPtr(self->stream, EQ_compute_next_data_frame);
     self->mode_func_ptr = EQ_setProcMode;
 
@@ -2172,6 +3301,8 @@ EQ_setType(EQ *self, PyObject *arg)
     Py_RETURN_NONE;
 }
 
+static PyObject * EQ_setCoeffRate(EQ *self, PyObject *arg) { return CoeffRamp_setRate(&self->ramp, arg); }
+
 static PyMemberDef EQ_members[] =
 {
     {"server", T_OBJECT_EX, offsetof(EQ, server), 0, "Pyo server."},
@@ -2196,6 +3327,7 @@ static PyMethodDef EQ_methods[] =
     {"setQ", (PyCFunction)EQ_setQ, METH_O, "Sets filter Q factor."},
     {"setBoost", (PyCFunction)EQ_setBoost, METH_O, "Sets filter boost factor."},
     {"setType", (PyCFunction)EQ_setType, METH_O, "Sets filter type factor."},
+    {"setCoeffRate", (PyCFunction)EQ_setCoeffRate, METH_O, "Sets the number of samples between two computations of the coefficients."},
     {"setMul", (PyCFunction)EQ_setMul, METH_O, "Sets oscillator mul factor."},
     {"setAdd", (PyCFunction)EQ_setAdd, METH_O, "Sets oscillator add factor."},
     {"setSub", (PyCFunction)EQ_setSub, METH_O, "Sets inverse add factor."},
@@ -2203,57 +3335,429 @@ static PyMethodDef EQ_methods[] =
     {NULL}  /* Sentinel */
 };
 
-static PyNumberMethods EQ_as_number =
-{
-    (binaryfunc)EQ_add,                         /*nb_add*/
-    (binaryfunc)EQ_sub,                         /*nb_subtract*/
-    (binaryfunc)EQ_multiply,                    /*nb_multiply*/
-    0,                                              /*nb_remainder*/
-    0,                                              /*nb_divmod*/
-    0,                                              /*nb_power*/
-    0,                                              /*nb_neg*/
-    0,                                              /*nb_pos*/
-    0,                                              /*(unaryfunc)array_abs,*/
-    0,                                              /*nb_nonzero*/
-    0,                                              /*nb_invert*/
-    0,                                              /*nb_lshift*/
-    0,                                              /*nb_rshift*/
-    0,                                              /*nb_and*/
-    0,                                              /*nb_xor*/
-    0,                                              /*nb_or*/
-    0,                                              /*nb_int*/
-    0,                                              /*nb_long*/
-    0,                                              /*nb_float*/
-    (binaryfunc)EQ_inplace_add,                 /*inplace_add*/
-    (binaryfunc)EQ_inplace_sub,                 /*inplace_subtract*/
-    (binaryfunc)EQ_inplace_multiply,            /*inplace_multiply*/
-    0,                                              /*inplace_remainder*/
-    0,                                              /*inplace_power*/
-    0,                                              /*inplace_lshift*/
-    0,                                              /*inplace_rshift*/
-    0,                                              /*inplace_and*/
-    0,                                              /*inplace_xor*/
-    0,                                              /*inplace_or*/
-    0,                                              /*nb_floor_divide*/
-    (binaryfunc)EQ_div,                       /*nb_true_divide*/
-    0,                                              /*nb_inplace_floor_divide*/
-    (binaryfunc)EQ_inplace_div,                       /*nb_inplace_true_divide*/
-    0,                                              /* nb_index */
+static PyNumberMethods EQ_as_number =
+{
+    (binaryfunc)EQ_add,                         /*nb_add*/
+    (binaryfunc)EQ_sub,                         /*nb_subtract*/
+    (binaryfunc)EQ_multiply,                    /*nb_multiply*/
+    0,                                              /*nb_remainder*/
+    0,                                              /*nb_divmod*/
+    0,                                              /*nb_power*/
+    0,                                              /*nb_neg*/
+    0,                                              /*nb_pos*/
+    0,                                              /*(unaryfunc)array_abs,*/
+    0,                                              /*nb_nonzero*/
+    0,                                              /*nb_invert*/
+    0,                                              /*nb_lshift*/
+    0,                                              /*nb_rshift*/
+    0,                                              /*nb_and*/
+    0,                                              /*nb_xor*/
+    0,                                              /*nb_or*/
+    0,                                              /*nb_int*/
+    0,                                              /*nb_long*/
+    0,                                              /*nb_float*/
+    (binaryfunc)EQ_inplace_add,                 /*inplace_add*/
+    (binaryfunc)EQ_inplace_sub,                 /*inplace_subtract*/
+    (binaryfunc)EQ_inplace_multiply,            /*inplace_multiply*/
+    0,                                              /*inplace_remainder*/
+    0,                                              /*inplace_power*/
+    0,                                              /*inplace_lshift*/
+    0,                                              /*inplace_rshift*/
+    0,                                              /*inplace_and*/
+    0,                                              /*inplace_xor*/
+    0,                                              /*inplace_or*/
+    0,                                              /*nb_floor_divide*/
+    (binaryfunc)EQ_div,                       /*nb_true_divide*/
+    0,                                              /*nb_inplace_floor_divide*/
+    (binaryfunc)EQ_inplace_div,                       /*nb_inplace_true_divide*/
+    0,                                              /* nb_index */
+};
+
+PyTypeObject EQType =
+{
+    PyVarObject_HEAD_INIT(NULL, 0)
+    "_pyo.EQ_base",                                   /*tp_name*/
+    sizeof(EQ),                                 /*tp_basicsize*/
+    0,                                              /*tp_itemsize*/
+    (destructor)EQ_dealloc,                     /*tp_dealloc*/
+    0,                                              /*tp_print*/
+    0,                                              /*tp_getattr*/
+    0,                                              /*tp_setattr*/
+    0,                                              /*tp_as_async (tp_compare in Python 2)*/
+    0,                                              /*tp_repr*/
+    &EQ_as_number,                              /*tp_as_number*/
+    0,                                              /*tp_as_sequence*/
+    0,                                              /*tp_as_mapping*/
+    0,                                              /*tp_hash */
+    0,                                              /*tp_call*/
+    0,                                              /*tp_str*/
+    0,                                              /*tp_getattro*/
+    0,                                              /*tp_setattro*/
+    0,                                              /*tp_as_buffer*/
+    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE | Py_TPFLAGS_HAVE_GC, /*tp_flags*/
+    "EQ objects. Generates a biquadratic filter.",           /* tp_doc */
+    (traverseproc)EQ_traverse,                  /* tp_traverse */
+    (inquiry)EQ_clear,                          /* tp_clear */
+    0,                                              /* tp_richcompare */
+    0,                                              /* tp_weaklistoffset */
+    0,                                              /* tp_iter */
+    0,                                              /* tp_iternext */
+    EQ_methods,                                 /* tp_methods */
+    EQ_members,                                 /* tp_members */
+    0,                                              /* tp_getset */
+    0,                                              /* tp_base */
+    0,                                              /* tp_dict */
+    0,                                              /* tp_descr_get */
+    0,                                              /* tp_descr_set */
+    0,                                              /* tp_dictoffset */
+    0,                          /* tp_init */
+    0,                                              /* tp_alloc */
+    EQ_new,                                     /* tp_new */
+};
+
+/************/
+/* EQMulti */
+/************/
+/* Filters all the channels of an EQ with a BiquadBank (see multichannel.h). */
+typedef struct
+{
+    pyo_multi_HEAD
+    MultiParam input;
+    MultiParam freq;
+    MultiParam q;
+    MultiParam boost;
+    BiquadBank bank;
+    int *filtertype;
+    int dirty; /* The coefficients must be computed again from the parameters. */
+    MYFLT nyquist;
+    MYFLT twoPiOverSr;
+    // parameters of the current coefficients
+    MYFLT *lastFreq;
+    MYFLT *lastQ;
+    MYFLT *lastBoost;
+    CoeffRamp *ramps; /* Coefficients ramp of each channel. */
+} EQMulti;
+
+static void
+EQMulti_compute_variables(EQMulti *self, int chnl, MYFLT freq, MYFLT q, MYFLT boost)
+{
+    MYFLT A, w0, c, alpha;
+
+    self->lastFreq[chnl] = freq;
+    self->lastQ[chnl] = q;
+    self->lastBoost[chnl] = boost;
+
+    if (freq <= 1)
+        freq = 1;
+    else if (freq >= self->nyquist)
+        freq = self->nyquist;
+
+    A = MYPOW(10.0, boost / 40.0);
+    w0 = freq * self->twoPiOverSr;
+    c = MYCOS(w0);
+    alpha = MYSIN(w0) / (2 * q);
+    BiquadBank_setEQCoeffs(&self->bank, chnl, self->filtertype[chnl], A, c, alpha);
+}
+
+static void
+EQMulti_update_coeffs(EQMulti *self)
+{
+    int i;
+    MYFLT fr, q, boost;
+
+    for (i = 0; i < self->chnls; i++)
+    {
+        fr = self->freq.streams[i] != NULL ? Stream_getData(self->freq.streams[i])[0] : self->freq.values[i];
+        q = self->q.streams[i] != NULL ? Stream_getData(self->q.streams[i])[0] : self->q.values[i];
+        boost = self->boost.streams[i] != NULL ? Stream_getData(self->boost.streams[i])[0] : self->boost.values[i];
+        EQMulti_compute_variables(self, i, fr, q, boost);
+    }
+
+    self->dirty = 0;
+}
+
+/* One channel with an audio parameter, the coefficients are computed again
+   only when the parameters change. */
+static void
+EQMulti_filters_chnl(EQMulti *self, int chnl)
+{
+    MYFLT val, fr, q, boost;
+    int i, k;
+    MYFLT *in = Stream_getData(self->input.streams[chnl]);
+    MYFLT *out = self->buffer_streams + chnl * self->bufsize;
+    MYFLT *frs = self->freq.streams[chnl] != NULL ? Stream_getData(self->freq.streams[chnl]) : NULL;
+    MYFLT *qs = self->q.streams[chnl] != NULL ? Stream_getData(self->q.streams[chnl]) : NULL;
+    MYFLT *boosts = self->boost.streams[chnl] != NULL ? Stream_getData(self->boost.streams[chnl]) : NULL;
+
+    BiquadBank_prime(&self->bank, chnl, in[0]);
+
+    fr = self->freq.values[chnl];
+    q = self->q.values[chnl];
+    boost = self->boost.values[chnl];
+
+    for (i = 0; i < self->bufsize; i++)
+    {
+        if (CoeffRamp_next(&self->ramps[chnl], i, self->bufsize, &k))
+        {
+            if (frs != NULL)
+                fr = frs[k];
+
+            if (qs != NULL)
+                q = qs[k];
+
+            if (boosts != NULL)
+                boost = boosts[k];
+
+            if (fr != self->lastFreq[chnl] || q != self->lastQ[chnl] || boost != self->lastBoost[chnl])
+                EQMulti_compute_variables(self, chnl, fr, q, boost);
+
+            CoeffRamp_start(&self->ramps[chnl]);
+        }
+
+        BIQUADBANK_TICK(&self->bank, chnl, in[i], val)
+        out[i] = val;
+    }
+}
+
+static void
+EQMulti_compute_next_data_frame(EQMulti *self)
+{
+    int i, j, lanes;
+    MYFLT *in[PYO_BIQUADBANK_LANES], *out[PYO_BIQUADBANK_LANES];
+
+    if (self->dirty)
+        EQMulti_update_coeffs(self);
+
+    for (i = 0; i < self->chnls; i += PYO_BIQUADBANK_LANES)
+    {
+        lanes = self->chnls - i < PYO_BIQUADBANK_LANES ? self->chnls - i : PYO_BIQUADBANK_LANES;
+
+        if (MultiParam_isFloat(&self->freq, i, lanes) && MultiParam_isFloat(&self->q, i, lanes) && MultiParam_isFloat(&self->boost, i, lanes))
+        {
+            for (j = 0; j < lanes; j++)
+            {
+                in[j] = Stream_getData(self->input.streams[i + j]);
+                out[j] = self->buffer_streams + (i + j) * self->bufsize;
+                BiquadBank_prime(&self->bank, i + j, in[j][0]);
+            }
+
+            BiquadBank_process(&self->bank, i, lanes, in, out, self->bufsize);
+        }
+        else
+        {
+            for (j = i; j < i + lanes; j++)
+                EQMulti_filters_chnl(self, j);
+        }
+    }
+}
+
+static int
+EQMulti_traverse(EQMulti *self, visitproc visit, void *arg)
+{
+    pyo_multi_VISIT
+    MULTIPARAM_VISIT(self->input)
+    MULTIPARAM_VISIT(self->freq)
+    MULTIPARAM_VISIT(self->q)
+    MULTIPARAM_VISIT(self->boost)
+    return 0;
+}
+
+static int
+EQMulti_clear(EQMulti *self)
+{
+    pyo_multi_CLEAR
+    MULTIPARAM_CLEAR(self->input)
+    MULTIPARAM_CLEAR(self->freq)
+    MULTIPARAM_CLEAR(self->q)
+    MULTIPARAM_CLEAR(self->boost)
+    return 0;
+}
+
+static void
+EQMulti_dealloc(EQMulti* self)
+{
+    pyo_DEALLOC
+    MultiObject_freeBuffer((MultiObject *)self);
+    MultiParam_free(&self->input);
+    MultiParam_free(&self->freq);
+    MultiParam_free(&self->q);
+    MultiParam_free(&self->boost);
+    BiquadBank_free(&self->bank);
+    PyMem_RawFree(self->filtertype);
+    PyMem_RawFree(self->lastFreq);
+    PyMem_RawFree(self->lastQ);
+    PyMem_RawFree(self->lastBoost);
+    PyMem_RawFree(self->ramps);
+    EQMulti_clear(self);
+    Py_TYPE(self->stream)->tp_free((PyObject*)self->stream);
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static PyObject *
+EQMulti_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    int i;
+    PyObject *inputtmp, *freqtmp = NULL, *qtmp = NULL, *boosttmp = NULL, *typetmp = NULL;
+    EQMulti *self;
+    self = (EQMulti *)type->tp_alloc(type, 0);
+
+    self->dirty = 1;
+
+    INIT_OBJECT_COMMON
+
+    self->nyquist = (MYFLT)self->sr * 0.49;
+    self->twoPiOverSr = TWOPI / (MYFLT)self->sr;
+
+    Stream_setFunctionPtr(self->stream, EQMulti_compute_next_data_frame);
+
+    static char *kwlist[] = {"chnls", "input", "freq", "q", "boost", "type", NULL};
+
+    if (! PyArg_ParseTupleAndKeywords(args, kwds, "iO|OOOO", kwlist, &self->chnls, &inputtmp, &freqtmp, &qtmp, &boosttmp, &typetmp))
+        Py_RETURN_NONE;
+
+    if (self->chnls < 1)
+        self->chnls = 1;
+
+    if (MultiObject_allocBuffer((MultiObject *)self) < 0 || BiquadBank_alloc(&self->bank, self->chnls) < 0)
+        return PyErr_NoMemory();
+
+    self->filtertype = (int *)PyMem_RawCalloc(self->chnls, sizeof(int));
+    self->lastFreq = (MYFLT *)PyMem_RawCalloc(self->chnls, sizeof(MYFLT));
+    self->lastQ = (MYFLT *)PyMem_RawCalloc(self->chnls, sizeof(MYFLT));
+    self->lastBoost = (MYFLT *)PyMem_RawCalloc(self->chnls, sizeof(MYFLT));
+    self->ramps = (CoeffRamp *)PyMem_RawCalloc(self->chnls, sizeof(CoeffRamp));
+
+    for (i = 0; i < self->chnls; i++)
+        CoeffRamp_initBank(&self->ramps[i], self->server, &self->bank, i);
+
+    PyObject *deffreq = PyFloat_FromDouble(1000);
+    PyObject *defq = PyFloat_FromDouble(1);
+    PyObject *defboost = PyFloat_FromDouble(-3.0);
+    i = MultiParam_set(&self->input, inputtmp, self->chnls, self->server);
+
+    if (i == 0 && self->input.audio != self->chnls)
+    {
+        PyErr_SetString(PyExc_TypeError, "\"input\" argument must be a list of PyoObjects.\n");
+        i = -1;
+    }
+
+    if (i == 0)
+        i = MultiParam_set(&self->freq, freqtmp ? freqtmp : deffreq, self->chnls, self->server);
+
+    if (i == 0)
+        i = MultiParam_set(&self->q, qtmp ? qtmp : defq, self->chnls, self->server);
+
+    if (i == 0)
+        i = MultiParam_set(&self->boost, boosttmp ? boosttmp : defboost, self->chnls, self->server);
+
+    if (i == 0 && typetmp)
+        i = Multi_setInts(self->filtertype, typetmp, self->chnls);
+
+    Py_DECREF(deffreq);
+    Py_DECREF(defq);
+    Py_DECREF(defboost);
+
+    if (i < 0)
+    {
+        Py_DECREF(self);
+        return NULL;
+    }
+
+    PyObject_CallMethod(self->server, "addStream", "O", self->stream);
+
+    return (PyObject *)self;
+}
+
+static PyObject * EQMulti_getServer(EQMulti* self) { GET_SERVER };
+static PyObject * EQMulti_getStream(EQMulti* self) { GET_STREAM };
+
+static PyObject * EQMulti_play(EQMulti *self, PyObject *args, PyObject *kwds) { PLAY };
+static PyObject * EQMulti_stop(EQMulti *self, PyObject *args, PyObject *kwds) { STOP };
+
+static PyObject *
+EQMulti_setFreq(EQMulti *self, PyObject *args)
+{
+    if (MultiParam_setArgs(&self->freq, args, self->chnls, self->server) < 0)
+        return NULL;
+
+    self->dirty = 1;
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+EQMulti_setQ(EQMulti *self, PyObject *args)
+{
+    if (MultiParam_setArgs(&self->q, args, self->chnls, self->server) < 0)
+        return NULL;
+
+    self->dirty = 1;
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+EQMulti_setBoost(EQMulti *self, PyObject *args)
+{
+    if (MultiParam_setArgs(&self->boost, args, self->chnls, self->server) < 0)
+        return NULL;
+
+    self->dirty = 1;
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+EQMulti_setType(EQMulti *self, PyObject *args)
+{
+    if (Multi_setIntsArgs(self->filtertype, args, self->chnls) < 0)
+        return NULL;
+
+    self->dirty = 1;
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+EQMulti_setCoeffRate(EQMulti *self, PyObject *args)
+{
+    return CoeffRamp_setRates(self->ramps, self->chnls, args);
+}
+
+static PyMemberDef EQMulti_members[] =
+{
+    {"server", T_OBJECT_EX, offsetof(EQMulti, server), 0, "Pyo server."},
+    {"stream", T_OBJECT_EX, offsetof(EQMulti, stream), 0, "Stream object."},
+    {NULL}  /* Sentinel */
+};
+
+static PyMethodDef EQMulti_methods[] =
+{
+    {"getServer", (PyCFunction)EQMulti_getServer, METH_NOARGS, "Returns server object."},
+    {"_getStream", (PyCFunction)EQMulti_getStream, METH_NOARGS, "Returns stream object."},
+    {"play", (PyCFunction)EQMulti_play, METH_VARARGS | METH_KEYWORDS, "Starts computing without sending sound to soundcard."},
+    {"stop", (PyCFunction)EQMulti_stop, METH_VARARGS | METH_KEYWORDS, "Stops computing."},
+    {"setFreq", (PyCFunction)EQMulti_setFreq, METH_VARARGS, "Sets the cutoff frequency of each channel, or of the given channel."},
+    {"setQ", (PyCFunction)EQMulti_setQ, METH_VARARGS, "Sets the Q factor of each channel, or of the given channel."},
+    {"setBoost", (PyCFunction)EQMulti_setBoost, METH_VARARGS, "Sets the boost factor of each channel, or of the given channel."},
+    {"setType", (PyCFunction)EQMulti_setType, METH_VARARGS, "Sets the filter type of each channel, or of the given channel."},
+    {"setCoeffRate", (PyCFunction)EQMulti_setCoeffRate, METH_VARARGS, "Sets the number of samples between two computations of the coefficients of each channel, or of the given channel."},
+    {NULL}  /* Sentinel */
 };
 
-PyTypeObject EQType =
+PyTypeObject EQMultiType =
 {
     PyVarObject_HEAD_INIT(NULL, 0)
-    "_pyo.EQ_base",                                   /*tp_name*/
-    sizeof(EQ),                                 /*tp_basicsize*/
+    "_pyo.EQMulti_base",                                   /*tp_name*/
+    sizeof(EQMulti),                                 /*tp_basicsize*/
     0,                                              /*tp_itemsize*/
-    (destructor)EQ_dealloc,                     /*tp_dealloc*/
+    (destructor)EQMulti_dealloc,                     /*tp_dealloc*/
     0,                                              /*tp_print*/
     0,                                              /*tp_getattr*/
     0,                                              /*tp_setattr*/
     0,                                              /*tp_as_async (tp_compare in Python 2)*/
     0,                                              /*tp_repr*/
-    &EQ_as_number,                              /*tp_as_number*/
+    0,                                              /*tp_as_number*/
     0,                                              /*tp_as_sequence*/
     0,                                              /*tp_as_mapping*/
     0,                                              /*tp_hash */
@@ -2263,15 +3767,15 @@ PyTypeObject EQType =
     0,                                              /*tp_setattro*/
     0,                                              /*tp_as_buffer*/
     Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE | Py_TPFLAGS_HAVE_GC, /*tp_flags*/
-    "EQ objects. Generates a biquadratic filter.",           /* tp_doc */
-    (traverseproc)EQ_traverse,                  /* tp_traverse */
-    (inquiry)EQ_clear,                          /* tp_clear */
+    "EQMulti objects. Equalizer filters of all the channels of an EQ.",           /* tp_doc */
+    (traverseproc)EQMulti_traverse,                  /* tp_traverse */
+    (inquiry)EQMulti_clear,                          /* tp_clear */
     0,                                              /* tp_richcompare */
     0,                                              /* tp_weaklistoffset */
     0,                                              /* tp_iter */
     0,                                              /* tp_iternext */
-    EQ_methods,                                 /* tp_methods */
-    EQ_members,                                 /* tp_members */
+    EQMulti_methods,                                 /* tp_methods */
+    EQMulti_members,                                 /* tp_members */
     0,                                              /* tp_getset */
     0,                                              /* tp_base */
     0,                                              /* tp_dict */
@@ -2280,7 +3784,7 @@ PyTypeObject EQType =
     0,                                              /* tp_dictoffset */
     0,                          /* tp_init */
     0,                                              /* tp_alloc */
-    EQ_new,                                     /* tp_new */
+    EQMulti_new,                                     /* tp_new */
 };
 
 /* Performs portamento on audio signal */
@@ -3010,55 +4514,337 @@ static PyMethodDef Tone_methods[] =
 
 static PyNumberMethods Tone_as_number =
 {
-    (binaryfunc)Tone_add,                         /*nb_add*/
-    (binaryfunc)Tone_sub,                         /*nb_subtract*/
-    (binaryfunc)Tone_multiply,                    /*nb_multiply*/
-    0,                                              /*nb_remainder*/
-    0,                                              /*nb_divmod*/
-    0,                                              /*nb_power*/
-    0,                                              /*nb_neg*/
-    0,                                              /*nb_pos*/
-    0,                                              /*(unaryfunc)array_abs,*/
-    0,                                              /*nb_nonzero*/
-    0,                                              /*nb_invert*/
-    0,                                              /*nb_lshift*/
-    0,                                              /*nb_rshift*/
-    0,                                              /*nb_and*/
-    0,                                              /*nb_xor*/
-    0,                                              /*nb_or*/
-    0,                                              /*nb_int*/
-    0,                                              /*nb_long*/
-    0,                                              /*nb_float*/
-    (binaryfunc)Tone_inplace_add,                 /*inplace_add*/
-    (binaryfunc)Tone_inplace_sub,                 /*inplace_subtract*/
-    (binaryfunc)Tone_inplace_multiply,            /*inplace_multiply*/
-    0,                                              /*inplace_remainder*/
-    0,                                              /*inplace_power*/
-    0,                                              /*inplace_lshift*/
-    0,                                              /*inplace_rshift*/
-    0,                                              /*inplace_and*/
-    0,                                              /*inplace_xor*/
-    0,                                              /*inplace_or*/
-    0,                                              /*nb_floor_divide*/
-    (binaryfunc)Tone_div,                       /*nb_true_divide*/
-    0,                                              /*nb_inplace_floor_divide*/
-    (binaryfunc)Tone_inplace_div,                       /*nb_inplace_true_divide*/
-    0,                                              /* nb_index */
+    (binaryfunc)Tone_add,                         /*nb_add*/
+    (binaryfunc)Tone_sub,                         /*nb_subtract*/
+    (binaryfunc)Tone_multiply,                    /*nb_multiply*/
+    0,                                              /*nb_remainder*/
+    0,                                              /*nb_divmod*/
+    0,                                              /*nb_power*/
+    0,                                              /*nb_neg*/
+    0,                                              /*nb_pos*/
+    0,                                              /*(unaryfunc)array_abs,*/
+    0,                                              /*nb_nonzero*/
+    0,                                              /*nb_invert*/
+    0,                                              /*nb_lshift*/
+    0,                                              /*nb_rshift*/
+    0,                                              /*nb_and*/
+    0,                                              /*nb_xor*/
+    0,                                              /*nb_or*/
+    0,                                              /*nb_int*/
+    0,                                              /*nb_long*/
+    0,                                              /*nb_float*/
+    (binaryfunc)Tone_inplace_add,                 /*inplace_add*/
+    (binaryfunc)Tone_inplace_sub,                 /*inplace_subtract*/
+    (binaryfunc)Tone_inplace_multiply,            /*inplace_multiply*/
+    0,                                              /*inplace_remainder*/
+    0,                                              /*inplace_power*/
+    0,                                              /*inplace_lshift*/
+    0,                                              /*inplace_rshift*/
+    0,                                              /*inplace_and*/
+    0,                                              /*inplace_xor*/
+    0,                                              /*inplace_or*/
+    0,                                              /*nb_floor_divide*/
+    (binaryfunc)Tone_div,                       /*nb_true_divide*/
+    0,                                              /*nb_inplace_floor_divide*/
+    (binaryfunc)Tone_inplace_div,                       /*nb_inplace_true_divide*/
+    0,                                              /* nb_index */
+};
+
+PyTypeObject ToneType =
+{
+    PyVarObject_HEAD_INIT(NULL, 0)
+    "_pyo.Tone_base",                                   /*tp_name*/
+    sizeof(Tone),                                 /*tp_basicsize*/
+    0,                                              /*tp_itemsize*/
+    (destructor)Tone_dealloc,                     /*tp_dealloc*/
+    0,                                              /*tp_print*/
+    0,                                              /*tp_getattr*/
+    0,                                              /*tp_setattr*/
+    0,                                              /*tp_as_async (tp_compare in Python 2)*/
+    0,                                              /*tp_repr*/
+    &Tone_as_number,                              /*tp_as_number*/
+    0,                                              /*tp_as_sequence*/
+    0,                                              /*tp_as_mapping*/
+    0,                                              /*tp_hash */
+    0,                                              /*tp_call*/
+    0,                                              /*tp_str*/
+    0,                                              /*tp_getattro*/
+    0,                                              /*tp_setattro*/
+    0,                                              /*tp_as_buffer*/
+    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE | Py_TPFLAGS_HAVE_GC, /*tp_flags*/
+    "Tone objects. One-pole recursive lowpass filter.",           /* tp_doc */
+    (traverseproc)Tone_traverse,                  /* tp_traverse */
+    (inquiry)Tone_clear,                          /* tp_clear */
+    0,                                              /* tp_richcompare */
+    0,                                              /* tp_weaklistoffset */
+    0,                                              /* tp_iter */
+    0,                                              /* tp_iternext */
+    Tone_methods,                                 /* tp_methods */
+    Tone_members,                                 /* tp_members */
+    0,                                              /* tp_getset */
+    0,                                              /* tp_base */
+    0,                                              /* tp_dict */
+    0,                                              /* tp_descr_get */
+    0,                                              /* tp_descr_set */
+    0,                                              /* tp_dictoffset */
+    0,                          /* tp_init */
+    0,                                              /* tp_alloc */
+    Tone_new,                                     /* tp_new */
+};
+
+/************/
+/* ToneMulti */
+/************/
+/* Filters all the channels of a Tone (see multichannel.h). */
+typedef struct
+{
+    pyo_multi_HEAD
+    MultiParam input;
+    MultiParam freq;
+    MYFLT nyquist;
+    MYFLT mTwoPiOverSr;
+    MYFLT *lastFreq;
+    // sample memories
+    MYFLT *y1;
+    // variables
+    MYFLT *c;
+} ToneMulti;
+
+static void
+ToneMulti_computeCoeff(ToneMulti *self, int chnl, MYFLT fr)
+{
+    if (fr != self->lastFreq[chnl])
+    {
+        if (fr <= 0.1)
+            fr = 0.1;
+        else if (fr >= self->nyquist)
+            fr = self->nyquist;
+
+        self->lastFreq[chnl] = fr;
+        self->c[chnl] = MYEXP(self->mTwoPiOverSr * fr);
+    }
+}
+
+/* Channels first to first+lanes-1, freq given as floats. */
+static void
+ToneMulti_filters_lanes(ToneMulti *self, int first, int lanes)
+{
+    MYFLT y1[PYO_MULTI_LANES], c[PYO_MULTI_LANES], x;
+    MYFLT *in[PYO_MULTI_LANES];
+    int i, j;
+    MYFLT *out = self->buffer_streams + first * self->bufsize;
+
+    for (j = 0; j < lanes; j++)
+    {
+        ToneMulti_computeCoeff(self, first + j, self->freq.values[first + j]);
+        in[j] = Stream_getData(self->input.streams[first + j]);
+        y1[j] = self->y1[first + j];
+        c[j] = self->c[first + j];
+    }
+
+    for (i = 0; i < self->bufsize; i++)
+    {
+        for (j = 0; j < lanes; j++)
+        {
+            x = in[j][i];
+            out[j * self->bufsize + i] = y1[j] = x + (y1[j] - x) * c[j];
+        }
+    }
+
+    for (j = 0; j < lanes; j++)
+        self->y1[first + j] = y1[j];
+}
+
+/* One channel, same computation as Tone. */
+static void
+ToneMulti_filters_chnl(ToneMulti *self, int chnl)
+{
+    int i;
+    MYFLT *out = self->buffer_streams + chnl * self->bufsize;
+    MYFLT *in = Stream_getData(self->input.streams[chnl]);
+    MYFLT y1 = self->y1[chnl];
+
+    if (self->freq.streams[chnl] == NULL)
+    {
+        ToneMulti_computeCoeff(self, chnl, self->freq.values[chnl]);
+
+        for (i = 0; i < self->bufsize; i++)
+        {
+            out[i] = y1 = in[i] + (y1 - in[i]) * self->c[chnl];
+        }
+    }
+    else
+    {
+        MYFLT *fr = Stream_getData(self->freq.streams[chnl]);
+
+        for (i = 0; i < self->bufsize; i++)
+        {
+            ToneMulti_computeCoeff(self, chnl, fr[i]);
+            out[i] = y1 = in[i] + (y1 - in[i]) * self->c[chnl];
+        }
+    }
+
+    self->y1[chnl] = y1;
+}
+
+static void
+ToneMulti_compute_next_data_frame(ToneMulti *self)
+{
+    int i, j, lanes;
+
+    for (i = 0; i < self->chnls; i += PYO_MULTI_LANES)
+    {
+        lanes = self->chnls - i < PYO_MULTI_LANES ? self->chnls - i : PYO_MULTI_LANES;
+
+        if (MultiParam_isFloat(&self->freq, i, lanes))
+            ToneMulti_filters_lanes(self, i, lanes);
+        else
+        {
+            for (j = i; j < i + lanes; j++)
+                ToneMulti_filters_chnl(self, j);
+        }
+    }
+}
+
+static int
+ToneMulti_traverse(ToneMulti *self, visitproc visit, void *arg)
+{
+    pyo_multi_VISIT
+    MULTIPARAM_VISIT(self->input)
+    MULTIPARAM_VISIT(self->freq)
+    return 0;
+}
+
+static int
+ToneMulti_clear(ToneMulti *self)
+{
+    pyo_multi_CLEAR
+    MULTIPARAM_CLEAR(self->input)
+    MULTIPARAM_CLEAR(self->freq)
+    return 0;
+}
+
+static void
+ToneMulti_dealloc(ToneMulti* self)
+{
+    pyo_DEALLOC
+    MultiObject_freeBuffer((MultiObject *)self);
+    MultiParam_free(&self->input);
+    MultiParam_free(&self->freq);
+    PyMem_RawFree(self->lastFreq);
+    PyMem_RawFree(self->y1);
+    PyMem_RawFree(self->c);
+    ToneMulti_clear(self);
+    Py_TYPE(self->stream)->tp_free((PyObject*)self->stream);
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static PyObject *
+ToneMulti_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    int i;
+    PyObject *inputtmp, *freqtmp = NULL;
+    ToneMulti *self;
+    self = (ToneMulti *)type->tp_alloc(type, 0);
+
+    INIT_OBJECT_COMMON
+
+    self->nyquist = (MYFLT)self->sr * 0.49;
+    self->mTwoPiOverSr = -TWOPI / (MYFLT)self->sr;
+
+    Stream_setFunctionPtr(self->stream, ToneMulti_compute_next_data_frame);
+
+    static char *kwlist[] = {"chnls", "input", "freq", NULL};
+
+    if (! PyArg_ParseTupleAndKeywords(args, kwds, "iO|O", kwlist, &self->chnls, &inputtmp, &freqtmp))
+        Py_RETURN_NONE;
+
+    if (self->chnls < 1)
+        self->chnls = 1;
+
+    if (MultiObject_allocBuffer((MultiObject *)self) < 0)
+        return PyErr_NoMemory();
+
+    self->lastFreq = (MYFLT *)PyMem_RawMalloc(self->chnls * sizeof(MYFLT));
+    self->y1 = (MYFLT *)PyMem_RawCalloc(self->chnls, sizeof(MYFLT));
+    self->c = (MYFLT *)PyMem_RawCalloc(self->chnls, sizeof(MYFLT));
+
+    for (i = 0; i < self->chnls; i++)
+        self->lastFreq[i] = -1.0;
+
+    if (MultiParam_set(&self->input, inputtmp, self->chnls, self->server) < 0)
+    {
+        Py_DECREF(self);
+        return NULL;
+    }
+
+    if (self->input.audio != self->chnls)
+    {
+        PyErr_SetString(PyExc_TypeError, "\"input\" argument must be a list of PyoObjects.\n");
+        Py_DECREF(self);
+        return NULL;
+    }
+
+    PyObject *deffreq = PyFloat_FromDouble(1000);
+    i = MultiParam_set(&self->freq, freqtmp ? freqtmp : deffreq, self->chnls, self->server);
+    Py_DECREF(deffreq);
+
+    if (i < 0)
+    {
+        Py_DECREF(self);
+        return NULL;
+    }
+
+    PyObject_CallMethod(self->server, "addStream", "O", self->stream);
+
+    return (PyObject *)self;
+}
+
+static PyObject * ToneMulti_getServer(ToneMulti* self) { GET_SERVER };
+static PyObject * ToneMulti_getStream(ToneMulti* self) { GET_STREAM };
+
+static PyObject * ToneMulti_play(ToneMulti *self, PyObject *args, PyObject *kwds) { PLAY };
+static PyObject * ToneMulti_stop(ToneMulti *self, PyObject *args, PyObject *kwds) { STOP };
+
+static PyObject *
+ToneMulti_setFreq(ToneMulti *self, PyObject *args)
+{
+    if (MultiParam_setArgs(&self->freq, args, self->chnls, self->server) < 0)
+        return NULL;
+
+    Py_RETURN_NONE;
+}
+
+static PyMemberDef ToneMulti_members[] =
+{
+    {"server", T_OBJECT_EX, offsetof(ToneMulti, server), 0, "Pyo server."},
+    {"stream", T_OBJECT_EX, offsetof(ToneMulti, stream), 0, "Stream object."},
+    {NULL}  /* Sentinel */
+};
+
+static PyMethodDef ToneMulti_methods[] =
+{
+    {"getServer", (PyCFunction)ToneMulti_getServer, METH_NOARGS, "Returns server object."},
+    {"_getStream", (PyCFunction)ToneMulti_getStream, METH_NOARGS, "Returns stream object."},
+    {"play", (PyCFunction)ToneMulti_play, METH_VARARGS | METH_KEYWORDS, "Starts computing without sending sound to soundcard."},
+    {"stop", (PyCFunction)ToneMulti_stop, METH_VARARGS | METH_KEYWORDS, "Stops computing."},
+    {"setFreq", (PyCFunction)ToneMulti_setFreq, METH_VARARGS, "Sets the cutoff frequency of each channel, or of the given channel."},
+    {NULL}  /* Sentinel */
 };
 
-PyTypeObject ToneType =
+PyTypeObject ToneMultiType =
 {
     PyVarObject_HEAD_INIT(NULL, 0)
-    "_pyo.Tone_base",                                   /*tp_name*/
-    sizeof(Tone),                                 /*tp_basicsize*/
+    "_pyo.ToneMulti_base",                                   /*tp_name*/
+    sizeof(ToneMulti),                                 /*tp_basicsize*/
     0,                                              /*tp_itemsize*/
-    (destructor)Tone_dealloc,                     /*tp_dealloc*/
+    (destructor)ToneMulti_dealloc,                     /*tp_dealloc*/
     0,                                              /*tp_print*/
     0,                                              /*tp_getattr*/
     0,                                              /*tp_setattr*/
     0,                                              /*tp_as_async (tp_compare in Python 2)*/
     0,                                              /*tp_repr*/
-    &Tone_as_number,                              /*tp_as_number*/
+    0,                                              /*tp_as_number*/
     0,                                              /*tp_as_sequence*/
     0,                                              /*tp_as_mapping*/
     0,                                              /*tp_hash */
@@ -3068,15 +4854,15 @@ PyTypeObject ToneType =
     0,                                              /*tp_setattro*/
     0,                                              /*tp_as_buffer*/
     Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE | Py_TPFLAGS_HAVE_GC, /*tp_flags*/
-    "Tone objects. One-pole recursive lowpass filter.",           /* tp_doc */
-    (traverseproc)Tone_traverse,                  /* tp_traverse */
-    (inquiry)Tone_clear,                          /* tp_clear */
+    "ToneMulti objects. One-pole recursive lowpass filters of all the channels of a Tone.",           /* tp_doc */
+    (traverseproc)ToneMulti_traverse,                  /* tp_traverse */
+    (inquiry)ToneMulti_clear,                          /* tp_clear */
     0,                                              /* tp_richcompare */
     0,                                              /* tp_weaklistoffset */
     0,                                              /* tp_iter */
     0,                                              /* tp_iternext */
-    Tone_methods,                                 /* tp_methods */
-    Tone_members,                                 /* tp_members */
+    ToneMulti_methods,                                 /* tp_methods */
+    ToneMulti_members,                                 /* tp_members */
     0,                                              /* tp_getset */
     0,                                              /* tp_base */
     0,                                              /* tp_dict */
@@ -3085,7 +4871,7 @@ PyTypeObject ToneType =
     0,                                              /* tp_dictoffset */
     0,                          /* tp_init */
     0,                                              /* tp_alloc */
-    Tone_new,                                     /* tp_new */
+    ToneMulti_new,                                     /* tp_new */
 };
 
 /************/
@@ -6830,6 +8616,7 @@ typedef struct
     MYFLT y4;
     // variables
     MYFLT w;
+    CoeffRamp ramp;
 } SVF;
 
 static void
@@ -6887,7 +8674,7 @@ SVF_filters_iii(SVF *self)
 static void
 SVF_filters_aii(SVF *self)
 {
-    int i;
+    int i, k;
     MYFLT val, freq, q, type, q1, low, high, band, lowgain, highgain, bandgain;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
     MYFLT *fr = Stream_getData((Stream *)self->freq_stream);
@@ -6910,17 +8697,22 @@ SVF_filters_aii(SVF *self)
 
     for (i = 0; i < self->bufsize; i++)
     {
-        freq = fr[i];
+        if (CoeffRamp_next(&self->ramp, i, self->bufsize, &k))
+        {
+            freq = fr[k];
 
-        if (freq < 0.1)
-            freq = 0.1;
-        else if (freq > self->srOverSix)
-            freq = self->srOverSix;
+            if (freq < 0.1)
+                freq = 0.1;
+            else if (freq > self->srOverSix)
+                freq = self->srOverSix;
 
-        if (freq != self->last_freq)
-        {
-            self->last_freq = freq;
-            self->w = 2.0 * MYSIN(freq * self->piOverSr);
+            if (freq != self->last_freq)
+            {
+                self->last_freq = freq;
+                self->w = 2.0 * MYSIN(freq * self->piOverSr);
+            }
+
+            CoeffRamp_start(&self->ramp);
         }
 
         low = self->y2 + self->w * self->y1;
@@ -6994,7 +8786,7 @@ SVF_filters_iai(SVF *self)
 static void
 SVF_filters_aai(SVF *self)
 {
-    int i;
+    int i, k;
     MYFLT val, freq, q, type, q1, low, high, band, lowgain, highgain, bandgain;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
     MYFLT *fr = Stream_getData((Stream *)self->freq_stream);
@@ -7012,18 +8804,24 @@ SVF_filters_aai(SVF *self)
 
     for (i = 0; i < self->bufsize; i++)
     {
-        freq = fr[i];
         q = qst[i];
 
-        if (freq < 0.1)
-            freq = 0.1;
-        else if (freq > self->srOverSix)
-            freq = self->srOverSix;
-
-        if (freq != self->last_freq)
+        if (CoeffRamp_next(&self->ramp, i, self->bufsize, &k))
         {
-            self->last_freq = freq;
-            self->w = 2.0 * MYSIN(freq * self->piOverSr);
+            freq = fr[k];
+
+            if (freq < 0.1)
+                freq = 0.1;
+            else if (freq > self->srOverSix)
+                freq = self->srOverSix;
+
+            if (freq != self->last_freq)
+            {
+                self->last_freq = freq;
+                self->w = 2.0 * MYSIN(freq * self->piOverSr);
+            }
+
+            CoeffRamp_start(&self->ramp);
         }
 
         if (q < 0.5)
@@ -7101,7 +8899,7 @@ SVF_filters_iia(SVF *self)
 static void
 SVF_filters_aia(SVF *self)
 {
-    int i;
+    int i, k;
     MYFLT val, freq, q, type, q1, low, high, band, lowgain, highgain, bandgain;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
     MYFLT *fr = Stream_getData((Stream *)self->freq_stream);
@@ -7115,18 +8913,24 @@ SVF_filters_aia(SVF *self)
 
     for (i = 0; i < self->bufsize; i++)
     {
-        freq = fr[i];
         type = tp[i];
 
-        if (freq < 0.1)
-            freq = 0.1;
-        else if (freq > self->srOverSix)
-            freq = self->srOverSix;
-
-        if (freq != self->last_freq)
+        if (CoeffRamp_next(&self->ramp, i, self->bufsize, &k))
         {
-            self->last_freq = freq;
-            self->w = 2.0 * MYSIN(freq * self->piOverSr);
+            freq = fr[k];
+
+            if (freq < 0.1)
+                freq = 0.1;
+            else if (freq > self->srOverSix)
+                freq = self->srOverSix;
+
+            if (freq != self->last_freq)
+            {
+                self->last_freq = freq;
+                self->w = 2.0 * MYSIN(freq * self->piOverSr);
+            }
+
+            CoeffRamp_start(&self->ramp);
         }
 
         if (type < 0.0)
@@ -7209,7 +9013,7 @@ SVF_filters_iaa(SVF *self)
 static void
 SVF_filters_aaa(SVF *self)
 {
-    int i;
+    int i, k;
     MYFLT val, freq, q, type, q1, low, high, band, lowgain, highgain, bandgain;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
     MYFLT *fr = Stream_getData((Stream *)self->freq_stream);
@@ -7218,19 +9022,25 @@ SVF_filters_aaa(SVF *self)
 
     for (i = 0; i < self->bufsize; i++)
     {
-        freq = fr[i];
         q = qst[i];
         type = tp[i];
 
-        if (freq < 0.1)
-            freq = 0.1;
-        else if (freq > self->srOverSix)
-            freq = self->srOverSix;
-
-        if (freq != self->last_freq)
+        if (CoeffRamp_next(&self->ramp, i, self->bufsize, &k))
         {
-            self->last_freq = freq;
-            self->w = 2.0 * MYSIN(freq * self->piOverSr);
+            freq = fr[k];
+
+            if (freq < 0.1)
+                freq = 0.1;
+            else if (freq > self->srOverSix)
+                freq = self->srOverSix;
+
+            if (freq != self->last_freq)
+            {
+                self->last_freq = freq;
+                self->w = 2.0 * MYSIN(freq * self->piOverSr);
+            }
+
+            CoeffRamp_start(&self->ramp);
         }
 
         if (q < 0.5)
@@ -7415,6 +9225,9 @@ SVF_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->srOverSix = (MYFLT)self->sr / 6.0;
     self->piOverSr = PI / self->sr;
 
+    MYFLT *coeffs[1] = {&self->w};
+    CoeffRamp_init(&self->ramp, self->server, 1, coeffs);
+
     Stream_setFunctionPtr(self->stream, SVF_compute_next_data_frame);
     self->mode_func_ptr = SVF_setProcMode;
 
@@ -7481,6 +9294,8 @@ static PyObject * SVF_setFreq(SVF *self, PyObject *arg) { SET_PARAM(self->freq,
 static PyObject * SVF_setQ(SVF *self, PyObject *arg) { SET_PARAM(self->q, self->q_stream, 3); }
 static PyObject * SVF_setType(SVF *self, PyObject *arg) { SET_PARAM(self->type, self->type_stream, 4); }
 
+static PyObject * SVF_setCoeffRate(SVF *self, PyObject *arg) { return CoeffRamp_setRate(&self->ramp, arg); }
+
 static PyMemberDef SVF_members[] =
 {
     {"server", T_OBJECT_EX, offsetof(SVF, server), 0, "Pyo server."},
@@ -7504,6 +9319,7 @@ static PyMethodDef SVF_methods[] =
     {"setFreq", (PyCFunction)SVF_setFreq, METH_O, "Sets filter cutoff frequency in cycle per second."},
     {"setQ", (PyCFunction)SVF_setQ, METH_O, "Sets filter Q factor."},
     {"setType", (PyCFunction)SVF_setType, METH_O, "Sets filter type factor."},
+    {"setCoeffRate", (PyCFunction)SVF_setCoeffRate, METH_O, "Sets the number of samples between two computations of the coefficients."},
     {"setMul", (PyCFunction)SVF_setMul, METH_O, "Sets mul factor."},
     {"setAdd", (PyCFunction)SVF_setAdd, METH_O, "Sets add factor."},
     {"setSub", (PyCFunction)SVF_setSub, METH_O, "Sets inverse add factor."},
@@ -8810,6 +10626,7 @@ typedef struct
     MYFLT b1;
     MYFLT b2;
     MYFLT a;
+    CoeffRamp ramp;
 } Reson;
 
 static void
@@ -8862,20 +10679,25 @@ static void
 Reson_filters_ai(Reson *self)
 {
     MYFLT val, fr, q;
-    int i;
+    int i, k;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
     MYFLT *freq = Stream_getData((Stream *)self->freq_stream);
     q = PyFloat_AS_DOUBLE(self->q);
 
     for (i = 0; i < self->bufsize; i++)
     {
-        fr = freq[i];
-
-        if (fr != self->last_freq || q != self->last_q)
+        if (CoeffRamp_next(&self->ramp, i, self->bufsize, &k))
         {
-            self->last_freq = fr;
-            self->last_q = q;
-            Reson_compute_coeffs(self, fr, q);
+            fr = freq[k];
+
+            if (fr != self->last_freq || q != self->last_q)
+            {
+                self->last_freq = fr;
+                self->last_q = q;
+                Reson_compute_coeffs(self, fr, q);
+            }
+
+            CoeffRamp_start(&self->ramp);
         }
 
         val = self->a * (in[i] - self->x2) - (self->b1 * self->y1) - (self->b2 * self->y2);
@@ -8890,20 +10712,25 @@ static void
 Reson_filters_ia(Reson *self)
 {
     MYFLT val, fr, q;
-    int i;
+    int i, k;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
     fr = PyFloat_AS_DOUBLE(self->freq);
     MYFLT *qst = Stream_getData((Stream *)self->q_stream);
 
     for (i = 0; i < self->bufsize; i++)
     {
-        q = qst[i];
-
-        if (fr != self->last_freq || q != self->last_q)
+        if (CoeffRamp_next(&self->ramp, i, self->bufsize, &k))
         {
-            self->last_freq = fr;
-            self->last_q = q;
-            Reson_compute_coeffs(self, fr, q);
+            q = qst[k];
+
+            if (fr != self->last_freq || q != self->last_q)
+            {
+                self->last_freq = fr;
+                self->last_q = q;
+                Reson_compute_coeffs(self, fr, q);
+            }
+
+            CoeffRamp_start(&self->ramp);
         }
 
         val = self->a * (in[i] - self->x2) - (self->b1 * self->y1) - (self->b2 * self->y2);
@@ -8918,21 +10745,26 @@ static void
 Reson_filters_aa(Reson *self)
 {
     MYFLT val, fr, q;
-    int i;
+    int i, k;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
     MYFLT *freq = Stream_getData((Stream *)self->freq_stream);
     MYFLT *qst = Stream_getData((Stream *)self->q_stream);
 
     for (i = 0; i < self->bufsize; i++)
     {
-        fr = freq[i];
-        q = qst[i];
-
-        if (fr != self->last_freq || q != self->last_q)
+        if (CoeffRamp_next(&self->ramp, i, self->bufsize, &k))
         {
-            self->last_freq = fr;
-            self->last_q = q;
-            Reson_compute_coeffs(self, fr, q);
+            fr = freq[k];
+            q = qst[k];
+
+            if (fr != self->last_freq || q != self->last_q)
+            {
+                self->last_freq = fr;
+                self->last_q = q;
+                Reson_compute_coeffs(self, fr, q);
+            }
+
+            CoeffRamp_start(&self->ramp);
         }
 
         val = self->a * (in[i] - self->x2) - (self->b1 * self->y1) - (self->b2 * self->y2);
@@ -9078,6 +10910,9 @@ Reson_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->nyquist = (MYFLT)self->sr * 0.49;
     self->twopiOverSr = TWOPI / (MYFLT)self->sr;
 
+    MYFLT *coeffs[3] = {&self->b1, &self->b2, &self->a};
+    CoeffRamp_init(&self->ramp, self->server, 3, coeffs);
+
     Stream_setFunctionPtr(self->stream, Reson_compute_next_data_frame);
     self->mode_func_ptr = Reson_setProcMode;
 
@@ -9138,6 +10973,8 @@ static PyObject * Reson_inplace_div(Reson *self, PyObject *arg) { INPLACE_DIV };
 static PyObject * Reson_setFreq(Reson *self, PyObject *arg) { SET_PARAM(self->freq, self->freq_stream, 2); }
 static PyObject * Reson_setQ(Reson *self, PyObject *arg) { SET_PARAM(self->q, self->q_stream, 3); }
 
+static PyObject * Reson_setCoeffRate(Reson *self, PyObject *arg) { return CoeffRamp_setRate(&self->ramp, arg); }
+
 static PyMemberDef Reson_members[] =
 {
     {"server", T_OBJECT_EX, offsetof(Reson, server), 0, "Pyo server."},
@@ -9159,6 +10996,7 @@ static PyMethodDef Reson_methods[] =
     {"stop", (PyCFunction)Reson_stop, METH_VARARGS | METH_KEYWORDS, "Stops computing."},
     {"setFreq", (PyCFunction)Reson_setFreq, METH_O, "Sets filter cutoff frequency in cycle per second."},
     {"setQ", (PyCFunction)Reson_setQ, METH_O, "Sets filter Q factor."},
+    {"setCoeffRate", (PyCFunction)Reson_setCoeffRate, METH_O, "Sets the number of samples between two computations of the coefficients."},
     {"setMul", (PyCFunction)Reson_setMul, METH_O, "Sets oscillator mul factor."},
     {"setAdd", (PyCFunction)Reson_setAdd, METH_O, "Sets oscillator add factor."},
     {"setSub", (PyCFunction)Reson_setSub, METH_O, "Sets inverse add factor."},
@@ -9270,6 +11108,7 @@ typedef struct
     MYFLT b1;
     MYFLT b2;
     MYFLT a;
+    CoeffRamp ramp;
 } Resonx;
 
 static void
@@ -9346,7 +11185,7 @@ static void
 Resonx_filters_ai(Resonx *self)
 {
     MYFLT vin, vout, fr, q;
-    int i, j;
+    int i, j, k;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
     MYFLT *freq = Stream_getData((Stream *)self->freq_stream);
     q = PyFloat_AS_DOUBLE(self->q);
@@ -9356,13 +11195,19 @@ Resonx_filters_ai(Resonx *self)
     for (i = 0; i < self->bufsize; i++)
     {
         vin = in[i];
-        fr = freq[i];
 
-        if (fr != self->last_freq || q != self->last_q)
+        if (CoeffRamp_next(&self->ramp, i, self->bufsize, &k))
         {
-            self->last_freq = fr;
-            self->last_q = q;
-            Resonx_compute_coeffs(self, fr, q);
+            fr = freq[k];
+
+            if (fr != self->last_freq || q != self->last_q)
+            {
+                self->last_freq = fr;
+                self->last_q = q;
+                Resonx_compute_coeffs(self, fr, q);
+            }
+
+            CoeffRamp_start(&self->ramp);
         }
 
         for (j = 0; j < self->stages; j++)
@@ -9382,7 +11227,7 @@ static void
 Resonx_filters_ia(Resonx *self)
 {
     MYFLT vin, vout, fr, q;
-    int i, j;
+    int i, j, k;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
     fr = PyFloat_AS_DOUBLE(self->freq);
     MYFLT *qst = Stream_getData((Stream *)self->q_stream);
@@ -9392,13 +11237,19 @@ Resonx_filters_ia(Resonx *self)
     for (i = 0; i < self->bufsize; i++)
     {
         vin = in[i];
-        q = qst[i];
 
-        if (fr != self->last_freq || q != self->last_q)
+        if (CoeffRamp_next(&self->ramp, i, self->bufsize, &k))
         {
-            self->last_freq = fr;
-            self->last_q = q;
-            Resonx_compute_coeffs(self, fr, q);
+            q = qst[k];
+
+            if (fr != self->last_freq || q != self->last_q)
+            {
+                self->last_freq = fr;
+                self->last_q = q;
+                Resonx_compute_coeffs(self, fr, q);
+            }
+
+            CoeffRamp_start(&self->ramp);
         }
 
         for (j = 0; j < self->stages; j++)
@@ -9418,7 +11269,7 @@ static void
 Resonx_filters_aa(Resonx *self)
 {
     MYFLT vin, vout, fr, q;
-    int i, j;
+    int i, j, k;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
     MYFLT *freq = Stream_getData((Stream *)self->freq_stream);
     MYFLT *qst = Stream_getData((Stream *)self->q_stream);
@@ -9428,14 +11279,20 @@ Resonx_filters_aa(Resonx *self)
     for (i = 0; i < self->bufsize; i++)
     {
         vin = in[i];
-        fr = freq[i];
-        q = qst[i];
 
-        if (fr != self->last_freq || q != self->last_q)
+        if (CoeffRamp_next(&self->ramp, i, self->bufsize, &k))
         {
-            self->last_freq = fr;
-            self->last_q = q;
-            Resonx_compute_coeffs(self, fr, q);
+            fr = freq[k];
+            q = qst[k];
+
+            if (fr != self->last_freq || q != self->last_q)
+            {
+                self->last_freq = fr;
+                self->last_q = q;
+                Resonx_compute_coeffs(self, fr, q);
+            }
+
+            CoeffRamp_start(&self->ramp);
         }
 
         for (j = 0; j < self->stages; j++)
@@ -9590,6 +11447,9 @@ Resonx_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->nyquist = (MYFLT)self->sr * 0.49;
     self->twopiOverSr = TWOPI / (MYFLT)self->sr;
 
+    MYFLT *coeffs[3] = {&self->b1, &self->b2, &self->a};
+    CoeffRamp_init(&self->ramp, self->server, 3, coeffs);
+
     Stream_setFunctionPtr(self->stream, Resonx_compute_next_data_frame);
     self->mode_func_ptr = Resonx_setProcMode;
 
@@ -9666,6 +11526,8 @@ Resonx_setStages(Resonx *self, PyObject *arg)
     Py_RETURN_NONE;
 }
 
+static PyObject * Resonx_setCoeffRate(Resonx *self, PyObject *arg) { return CoeffRamp_setRate(&self->ramp, arg); }
+
 static PyMemberDef Resonx_members[] =
 {
     {"server", T_OBJECT_EX, offsetof(Resonx, server), 0, "Pyo server."},
@@ -9688,6 +11550,7 @@ static PyMethodDef Resonx_methods[] =
     {"setFreq", (PyCFunction)Resonx_setFreq, METH_O, "Sets filter cutoff frequency in cycle per second."},
     {"setQ", (PyCFunction)Resonx_setQ, METH_O, "Sets filter Q factor."},
     {"setStages", (PyCFunction)Resonx_setStages, METH_O, "Sets the number of stages of the filter."},
+    {"setCoeffRate", (PyCFunction)Resonx_setCoeffRate, METH_O, "Sets the number of samples between two computations of the coefficients."},
     {"setMul", (PyCFunction)Resonx_setMul, METH_O, "Sets oscillator mul factor."},
     {"setAdd", (PyCFunction)Resonx_setAdd, METH_O, "Sets oscillator add factor."},
     {"setSub", (PyCFunction)Resonx_setSub, METH_O, "Sets inverse add factor."},
@@ -9801,6 +11664,7 @@ typedef struct
     MYFLT a2;
     MYFLT b1;
     MYFLT b2;
+    CoeffRamp ramp;
 } ButLP;
 
 static void
@@ -9841,28 +11705,33 @@ static void
 ButLP_filters_a(ButLP *self)
 {
     MYFLT val, fr, c, c2;
-    int i;
+    int i, k;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
     MYFLT *freq = Stream_getData((Stream *)self->freq_stream);
 
     for (i = 0; i < self->bufsize; i++)
     {
-        fr = freq[i];
-
-        if (fr != self->lastFreq)
+        if (CoeffRamp_next(&self->ramp, i, self->bufsize, &k))
         {
-            if (fr < 0.1)
-                fr = 0.1;
-            else if (fr >= self->nyquist)
-                fr = self->nyquist;
-
-            self->lastFreq = fr;
-            c = 1.0 / MYTAN(self->piOnSr * fr);
-            c2 = c * c;
-            self->a0 = self->a2 = 1.0 / (1.0 + self->sqrt2 * c + c2);
-            self->a1 = 2.0 * self->a0;
-            self->b1 = self->a1 * (1.0 - c2);
-            self->b2 = self->a0 * (1.0 - self->sqrt2 * c + c2);
+            fr = freq[k];
+
+            if (fr != self->lastFreq)
+            {
+                if (fr < 0.1)
+                    fr = 0.1;
+                else if (fr >= self->nyquist)
+                    fr = self->nyquist;
+
+                self->lastFreq = fr;
+                c = 1.0 / MYTAN(self->piOnSr * fr);
+                c2 = c * c;
+                self->a0 = self->a2 = 1.0 / (1.0 + self->sqrt2 * c + c2);
+                self->a1 = 2.0 * self->a0;
+                self->b1 = self->a1 * (1.0 - c2);
+                self->b2 = self->a0 * (1.0 - self->sqrt2 * c + c2);
+            }
+
+            CoeffRamp_start(&self->ramp);
         }
 
         val = self->a0 * in[i] + self->a1 * self->x1 + self->a2 * self->x2 - self->b1 * self->y1 - self->b2 * self->y2;
@@ -9996,6 +11865,9 @@ ButLP_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->piOnSr = PI / (MYFLT)self->sr;
     self->sqrt2 = MYSQRT(2.0);
 
+    MYFLT *coeffs[5] = {&self->a0, &self->a1, &self->a2, &self->b1, &self->b2};
+    CoeffRamp_init(&self->ramp, self->server, 5, coeffs);
+
     Stream_setFunctionPtr(self->stream, ButLP_compute_next_data_frame);
     self->mode_func_ptr = ButLP_setProcMode;
 
@@ -10050,6 +11922,8 @@ static PyObject * ButLP_inplace_div(ButLP *self, PyObject *arg) { INPLACE_DIV };
 
 static PyObject * ButLP_setFreq(ButLP *self, PyObject *arg) { SET_PARAM(self->freq, self->freq_stream, 2); }
 
+static PyObject * ButLP_setCoeffRate(ButLP *self, PyObject *arg) { return CoeffRamp_setRate(&self->ramp, arg); }
+
 static PyMemberDef ButLP_members[] =
 {
     {"server", T_OBJECT_EX, offsetof(ButLP, server), 0, "Pyo server."},
@@ -10069,6 +11943,7 @@ static PyMethodDef ButLP_methods[] =
     {"out", (PyCFunction)ButLP_out, METH_VARARGS | METH_KEYWORDS, "Starts computing and sends sound to soundcard channel speficied by argument."},
     {"stop", (PyCFunction)ButLP_stop, METH_VARARGS | METH_KEYWORDS, "Stops computing."},
     {"setFreq", (PyCFunction)ButLP_setFreq, METH_O, "Sets filter cutoff frequency in cycle per second."},
+    {"setCoeffRate", (PyCFunction)ButLP_setCoeffRate, METH_O, "Sets the number of samples between two computations of the coefficients."},
     {"setMul", (PyCFunction)ButLP_setMul, METH_O, "Sets oscillator mul factor."},
     {"setAdd", (PyCFunction)ButLP_setAdd, METH_O, "Sets oscillator add factor."},
     {"setSub", (PyCFunction)ButLP_setSub, METH_O, "Sets inverse add factor."},
@@ -10182,6 +12057,7 @@ typedef struct
     MYFLT a2;
     MYFLT b1;
     MYFLT b2;
+    CoeffRamp ramp;
 } ButHP;
 
 static void
@@ -10222,28 +12098,33 @@ static void
 ButHP_filters_a(ButHP *self)
 {
     MYFLT val, fr, c, c2;
-    int i;
+    int i, k;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
     MYFLT *freq = Stream_getData((Stream *)self->freq_stream);
 
     for (i = 0; i < self->bufsize; i++)
     {
-        fr = freq[i];
-
-        if (fr != self->lastFreq)
+        if (CoeffRamp_next(&self->ramp, i, self->bufsize, &k))
         {
-            if (fr < 0.1)
-                fr = 0.1;
-            else if (fr >= self->nyquist)
-                fr = self->nyquist;
-
-            self->lastFreq = fr;
-            c = MYTAN(self->piOnSr * fr);
-            c2 = c * c;
-            self->a0 = self->a2 = 1.0 / (1.0 + self->sqrt2 * c + c2);
-            self->a1 = -2.0 * self->a0;
-            self->b1 = 2.0 * self->a0 * (c2 - 1.0);
-            self->b2 = self->a0 * (1.0 - self->sqrt2 * c + c2);
+            fr = freq[k];
+
+            if (fr != self->lastFreq)
+            {
+                if (fr < 0.1)
+                    fr = 0.1;
+                else if (fr >= self->nyquist)
+                    fr = self->nyquist;
+
+                self->lastFreq = fr;
+                c = MYTAN(self->piOnSr * fr);
+                c2 = c * c;
+                self->a0 = self->a2 = 1.0 / (1.0 + self->sqrt2 * c + c2);
+                self->a1 = -2.0 * self->a0;
+                self->b1 = 2.0 * self->a0 * (c2 - 1.0);
+                self->b2 = self->a0 * (1.0 - self->sqrt2 * c + c2);
+            }
+
+            CoeffRamp_start(&self->ramp);
         }
 
         val = self->a0 * in[i] + self->a1 * self->x1 + self->a2 * self->x2 - self->b1 * self->y1 - self->b2 * self->y2;
@@ -10377,6 +12258,9 @@ ButHP_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->piOnSr = PI / (MYFLT)self->sr;
     self->sqrt2 = MYSQRT(2.0);
 
+    MYFLT *coeffs[5] = {&self->a0, &self->a1, &self->a2, &self->b1, &self->b2};
+    CoeffRamp_init(&self->ramp, self->server, 5, coeffs);
+
     Stream_setFunctionPtr(self->stream, ButHP_compute_next_data_frame);
     self->mode_func_ptr = ButHP_setProcMode;
 
@@ -10431,6 +12315,8 @@ static PyObject * ButHP_inplace_div(ButHP *self, PyObject *arg) { INPLACE_DIV };
 
 static PyObject * ButHP_setFreq(ButHP *self, PyObject *arg) { SET_PARAM(self->freq, self->freq_stream, 2); }
 
+static PyObject * ButHP_setCoeffRate(ButHP *self, PyObject *arg) { return CoeffRamp_setRate(&self->ramp, arg); }
+
 static PyMemberDef ButHP_members[] =
 {
     {"server", T_OBJECT_EX, offsetof(ButHP, server), 0, "Pyo server."},
@@ -10450,6 +12336,7 @@ static PyMethodDef ButHP_methods[] =
     {"out", (PyCFunction)ButHP_out, METH_VARARGS | METH_KEYWORDS, "Starts computing and sends sound to soundcard channel speficied by argument."},
     {"stop", (PyCFunction)ButHP_stop, METH_VARARGS | METH_KEYWORDS, "Stops computing."},
     {"setFreq", (PyCFunction)ButHP_setFreq, METH_O, "Sets filter cutoff frequency in cycle per second."},
+    {"setCoeffRate", (PyCFunction)ButHP_setCoeffRate, METH_O, "Sets the number of samples between two computations of the coefficients."},
     {"setMul", (PyCFunction)ButHP_setMul, METH_O, "Sets oscillator mul factor."},
     {"setAdd", (PyCFunction)ButHP_setAdd, METH_O, "Sets oscillator add factor."},
     {"setSub", (PyCFunction)ButHP_setSub, METH_O, "Sets inverse add factor."},
@@ -10564,6 +12451,7 @@ typedef struct
     MYFLT a2;
     MYFLT b1;
     MYFLT b2;
+    CoeffRamp ramp;
 } ButBP;
 
 static void
@@ -10619,20 +12507,25 @@ static void
 ButBP_filters_ai(ButBP *self)
 {
     MYFLT val, fr, q;
-    int i;
+    int i, k;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
     MYFLT *freq = Stream_getData((Stream *)self->freq_stream);
     q = PyFloat_AS_DOUBLE(self->q);
 
     for (i = 0; i < self->bufsize; i++)
     {
-        fr = freq[i];
-
-        if (fr != self->last_freq || q != self->last_q)
+        if (CoeffRamp_next(&self->ramp, i, self->bufsize, &k))
         {
-            self->last_freq = fr;
-            self->last_q = q;
-            ButBP_compute_coeffs(self, fr, q);
+            fr = freq[k];
+
+            if (fr != self->last_freq || q != self->last_q)
+            {
+                self->last_freq = fr;
+                self->last_q = q;
+                ButBP_compute_coeffs(self, fr, q);
+            }
+
+            CoeffRamp_start(&self->ramp);
         }
 
         val = self->a0 * in[i] + self->a2 * self->x2 - self->b1 * self->y1 - self->b2 * self->y2;
@@ -10647,20 +12540,25 @@ static void
 ButBP_filters_ia(ButBP *self)
 {
     MYFLT val, fr, q;
-    int i;
+    int i, k;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
     fr = PyFloat_AS_DOUBLE(self->freq);
     MYFLT *qst = Stream_getData((Stream *)self->q_stream);
 
     for (i = 0; i < self->bufsize; i++)
     {
-        q = qst[i];
-
-        if (fr != self->last_freq || q != self->last_q)
+        if (CoeffRamp_next(&self->ramp, i, self->bufsize, &k))
         {
-            self->last_freq = fr;
-            self->last_q = q;
-            ButBP_compute_coeffs(self, fr, q);
+            q = qst[k];
+
+            if (fr != self->last_freq || q != self->last_q)
+            {
+                self->last_freq = fr;
+                self->last_q = q;
+                ButBP_compute_coeffs(self, fr, q);
+            }
+
+            CoeffRamp_start(&self->ramp);
         }
 
         val = self->a0 * in[i] + self->a2 * self->x2 - self->b1 * self->y1 - self->b2 * self->y2;
@@ -10675,21 +12573,26 @@ static void
 ButBP_filters_aa(ButBP *self)
 {
     MYFLT val, fr, q;
-    int i;
+    int i, k;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
     MYFLT *freq = Stream_getData((Stream *)self->freq_stream);
     MYFLT *qst = Stream_getData((Stream *)self->q_stream);
 
     for (i = 0; i < self->bufsize; i++)
     {
-        fr = freq[i];
-        q = qst[i];
-
-        if (fr != self->last_freq || q != self->last_q)
+        if (CoeffRamp_next(&self->ramp, i, self->bufsize, &k))
         {
-            self->last_freq = fr;
-            self->last_q = q;
-            ButBP_compute_coeffs(self, fr, q);
+            fr = freq[k];
+            q = qst[k];
+
+            if (fr != self->last_freq || q != self->last_q)
+            {
+                self->last_freq = fr;
+                self->last_q = q;
+                ButBP_compute_coeffs(self, fr, q);
+            }
+
+            CoeffRamp_start(&self->ramp);
         }
 
         val = self->a0 * in[i] + self->a2 * self->x2 - self->b1 * self->y1 - self->b2 * self->y2;
@@ -10835,6 +12738,9 @@ ButBP_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->nyquist = (MYFLT)self->sr * 0.49;
     self->piOnSr = PI / (MYFLT)self->sr;
 
+    MYFLT *coeffs[4] = {&self->a0, &self->a2, &self->b1, &self->b2};
+    CoeffRamp_init(&self->ramp, self->server, 4, coeffs);
+
     Stream_setFunctionPtr(self->stream, ButBP_compute_next_data_frame);
     self->mode_func_ptr = ButBP_setProcMode;
 
@@ -10895,6 +12801,8 @@ static PyObject * ButBP_inplace_div(ButBP *self, PyObject *arg) { INPLACE_DIV };
 static PyObject * ButBP_setFreq(ButBP *self, PyObject *arg) { SET_PARAM(self->freq, self->freq_stream, 2); }
 static PyObject * ButBP_setQ(ButBP *self, PyObject *arg) { SET_PARAM(self->q, self->q_stream, 3); }
 
+static PyObject * ButBP_setCoeffRate(ButBP *self, PyObject *arg) { return CoeffRamp_setRate(&self->ramp, arg); }
+
 static PyMemberDef ButBP_members[] =
 {
     {"server", T_OBJECT_EX, offsetof(ButBP, server), 0, "Pyo server."},
@@ -10916,6 +12824,7 @@ static PyMethodDef ButBP_methods[] =
     {"stop", (PyCFunction)ButBP_stop, METH_VARARGS | METH_KEYWORDS, "Stops computing."},
     {"setFreq", (PyCFunction)ButBP_setFreq, METH_O, "Sets filter cutoff frequency in cycle per second."},
     {"setQ", (PyCFunction)ButBP_setQ, METH_O, "Sets filter Q factor."},
+    {"setCoeffRate", (PyCFunction)ButBP_setCoeffRate, METH_O, "Sets the number of samples between two computations of the coefficients."},
     {"setMul", (PyCFunction)ButBP_setMul, METH_O, "Sets oscillator mul factor."},
     {"setAdd", (PyCFunction)ButBP_setAdd, METH_O, "Sets oscillator add factor."},
     {"setSub", (PyCFunction)ButBP_setSub, METH_O, "Sets inverse add factor."},
@@ -11031,6 +12940,7 @@ typedef struct
     MYFLT a2;
     MYFLT b1;
     MYFLT b2;
+    CoeffRamp ramp;
 } ButBR;
 
 static void
@@ -11085,20 +12995,25 @@ static void
 ButBR_filters_ai(ButBR *self)
 {
     MYFLT val, fr, q;
-    int i;
+    int i, k;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
     MYFLT *freq = Stream_getData((Stream *)self->freq_stream);
     q = PyFloat_AS_DOUBLE(self->q);
 
     for (i = 0; i < self->bufsize; i++)
     {
-        fr = freq[i];
-
-        if (fr != self->last_freq || q != self->last_q)
+        if (CoeffRamp_next(&self->ramp, i, self->bufsize, &k))
         {
-            self->last_freq = fr;
-            self->last_q = q;
-            ButBR_compute_coeffs(self, fr, q);
+            fr = freq[k];
+
+            if (fr != self->last_freq || q != self->last_q)
+            {
+                self->last_freq = fr;
+                self->last_q = q;
+                ButBR_compute_coeffs(self, fr, q);
+            }
+
+            CoeffRamp_start(&self->ramp);
         }
 
         val = self->a0 * in[i] + self->a1 * self->x1 + self->a2 * self->x2 - self->b1 * self->y1 - self->b2 * self->y2;
@@ -11113,20 +13028,25 @@ static void
 ButBR_filters_ia(ButBR *self)
 {
     MYFLT val, fr, q;
-    int i;
+    int i, k;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
     fr = PyFloat_AS_DOUBLE(self->freq);
     MYFLT *qst = Stream_getData((Stream *)self->q_stream);
 
     for (i = 0; i < self->bufsize; i++)
     {
-        q = qst[i];
-
-        if (fr != self->last_freq || q != self->last_q)
+        if (CoeffRamp_next(&self->ramp, i, self->bufsize, &k))
         {
-            self->last_freq = fr;
-            self->last_q = q;
-            ButBR_compute_coeffs(self, fr, q);
+            q = qst[k];
+
+            if (fr != self->last_freq || q != self->last_q)
+            {
+                self->last_freq = fr;
+                self->last_q = q;
+                ButBR_compute_coeffs(self, fr, q);
+            }
+
+            CoeffRamp_start(&self->ramp);
         }
 
         val = self->a0 * in[i] + self->a1 * self->x1 + self->a2 * self->x2 - self->b1 * self->y1 - self->b2 * self->y2;
@@ -11141,21 +13061,26 @@ static void
 ButBR_filters_aa(ButBR *self)
 {
     MYFLT val, fr, q;
-    int i;
+    int i, k;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
     MYFLT *freq = Stream_getData((Stream *)self->freq_stream);
     MYFLT *qst = Stream_getData((Stream *)self->q_stream);
 
     for (i = 0; i < self->bufsize; i++)
     {
-        fr = freq[i];
-        q = qst[i];
-
-        if (fr != self->last_freq || q != self->last_q)
+        if (CoeffRamp_next(&self->ramp, i, self->bufsize, &k))
         {
-            self->last_freq = fr;
-            self->last_q = q;
-            ButBR_compute_coeffs(self, fr, q);
+            fr = freq[k];
+            q = qst[k];
+
+            if (fr != self->last_freq || q != self->last_q)
+            {
+                self->last_freq = fr;
+                self->last_q = q;
+                ButBR_compute_coeffs(self, fr, q);
+            }
+
+            CoeffRamp_start(&self->ramp);
         }
 
         val = self->a0 * in[i] + self->a1 * self->x1 + self->a2 * self->x2 - self->b1 * self->y1 - self->b2 * self->y2;
@@ -11301,6 +13226,9 @@ ButBR_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->nyquist = (MYFLT)self->sr * 0.49;
     self->piOnSr = PI / (MYFLT)self->sr;
 
+    MYFLT *coeffs[5] = {&self->a0, &self->a1, &self->a2, &self->b1, &self->b2};
+    CoeffRamp_init(&self->ramp, self->server, 5, coeffs);
+
     Stream_setFunctionPtr(self->stream, ButBR_compute_next_data_frame);
     self->mode_func_ptr = ButBR_setProcMode;
 
@@ -11361,6 +13289,8 @@ static PyObject * ButBR_inplace_div(ButBR *self, PyObject *arg) { INPLACE_DIV };
 static PyObject * ButBR_setFreq(ButBR *self, PyObject *arg) { SET_PARAM(self->freq, self->freq_stream, 2); }
 static PyObject * ButBR_setQ(ButBR *self, PyObject *arg) { SET_PARAM(self->q, self->q_stream, 3); }
 
+static PyObject * ButBR_setCoeffRate(ButBR *self, PyObject *arg) { return CoeffRamp_setRate(&self->ramp, arg); }
+
 static PyMemberDef ButBR_members[] =
 {
     {"server", T_OBJECT_EX, offsetof(ButBR, server), 0, "Pyo server."},
@@ -11382,6 +13312,7 @@ static PyMethodDef ButBR_methods[] =
     {"stop", (PyCFunction)ButBR_stop, METH_VARARGS | METH_KEYWORDS, "Stops computing."},
     {"setFreq", (PyCFunction)ButBR_setFreq, METH_O, "Sets filter cutoff frequency in cycle per second."},
     {"setQ", (PyCFunction)ButBR_setQ, METH_O, "Sets filter Q factor."},
+    {"setCoeffRate", (PyCFunction)ButBR_setCoeffRate, METH_O, "Sets the number of samples between two computations of the coefficients."},
     {"setMul", (PyCFunction)ButBR_setMul, METH_O, "Sets oscillator mul factor."},
     {"setAdd", (PyCFunction)ButBR_setAdd, METH_O, "Sets oscillator add factor."},
     {"setSub", (PyCFunction)ButBR_setSub, METH_O, "Sets inverse add factor."},
@@ -11493,6 +13424,7 @@ typedef struct
     // sample memories
     MYFLT x;
     MYFLT y;
+    CoeffRamp ramp;
 } ComplexRes;
 
 static void
@@ -11531,7 +13463,7 @@ ComplexRes_filters_ii(ComplexRes *self)
 static void
 ComplexRes_filters_ai(ComplexRes *self)
 {
-    int i, check = 0;
+    int i, k, check = 0;
     MYFLT freq, ang, x, y;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
     MYFLT *fr = Stream_getData((Stream *)self->freq_stream);
@@ -11550,15 +13482,20 @@ ComplexRes_filters_ai(ComplexRes *self)
 
     for (i = 0; i < self->bufsize; i++)
     {
-        freq = fr[i];
-
-        if (freq != self->last_freq || check)
+        if (CoeffRamp_next(&self->ramp, i, self->bufsize, &k))
         {
-            ang = (freq * self->oneOnSr) * TWOPI;
-            self->coeffx = self->res * MYCOS(ang);
-            self->coeffy = self->res * MYSIN(ang);
-            self->last_freq = freq;
-            check = 0;
+            freq = fr[k];
+
+            if (freq != self->last_freq || check)
+            {
+                ang = (freq * self->oneOnSr) * TWOPI;
+                self->coeffx = self->res * MYCOS(ang);
+                self->coeffy = self->res * MYSIN(ang);
+                self->last_freq = freq;
+                check = 0;
+            }
+
+            CoeffRamp_start(&self->ramp);
         }
 
         x = self->coeffx * self->x - self->coeffy * self->y + in[i];
@@ -11572,7 +13509,7 @@ ComplexRes_filters_ai(ComplexRes *self)
 static void
 ComplexRes_filters_ia(ComplexRes *self)
 {
-    int i;
+    int i, k;
     MYFLT decay, ang, x, y;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
     MYFLT freq = PyFloat_AS_DOUBLE(self->freq);
@@ -11580,20 +13517,25 @@ ComplexRes_filters_ia(ComplexRes *self)
 
     for (i = 0; i < self->bufsize; i++)
     {
-        decay = dec[i];
+        if (CoeffRamp_next(&self->ramp, i, self->bufsize, &k))
+        {
+            decay = dec[k];
 
-        if (decay <= 0.0001)
-            decay = 0.0001;
+            if (decay <= 0.0001)
+                decay = 0.0001;
 
-        if (freq != self->last_freq || decay != self->last_decay)
-        {
-            self->res = MYEXP(-1.0 / (decay * self->sr));
-            //self->norm = (1.0-self->res*self->res)/self->res;
-            self->last_decay = decay;
-            ang = (freq * self->oneOnSr) * TWOPI;
-            self->coeffx = self->res * MYCOS(ang);
-            self->coeffy = self->res * MYSIN(ang);
-            self->last_freq = freq;
+            if (freq != self->last_freq || decay != self->last_decay)
+            {
+                self->res = MYEXP(-1.0 / (decay * self->sr));
+                //self->norm = (1.0-self->res*self->res)/self->res;
+                self->last_decay = decay;
+                ang = (freq * self->oneOnSr) * TWOPI;
+                self->coeffx = self->res * MYCOS(ang);
+                self->coeffy = self->res * MYSIN(ang);
+                self->last_freq = freq;
+            }
+
+            CoeffRamp_start(&self->ramp);
         }
 
         x = self->coeffx * self->x - self->coeffy * self->y + in[i];
@@ -11607,7 +13549,7 @@ ComplexRes_filters_ia(ComplexRes *self)
 static void
 ComplexRes_filters_aa(ComplexRes *self)
 {
-    int i;
+    int i, k;
     MYFLT freq, decay, ang, x, y;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
     MYFLT *fr = Stream_getData((Stream *)self->freq_stream);
@@ -11615,21 +13557,26 @@ ComplexRes_filters_aa(ComplexRes *self)
 
     for (i = 0; i < self->bufsize; i++)
     {
-        freq = fr[i];
-        decay = dec[i];
+        if (CoeffRamp_next(&self->ramp, i, self->bufsize, &k))
+        {
+            freq = fr[k];
+            decay = dec[k];
 
-        if (decay <= 0.0001)
-            decay = 0.0001;
+            if (decay <= 0.0001)
+                decay = 0.0001;
 
-        if (freq != self->last_freq || decay != self->last_decay)
-        {
-            self->res = MYEXP(-1.0 / (decay * self->sr));
-            //self->norm = (1.0-self->res*self->res)/self->res;
-            self->last_decay = decay;
-            ang = (freq * self->oneOnSr) * TWOPI;
-            self->coeffx = self->res * MYCOS(ang);
-            self->coeffy = self->res * MYSIN(ang);
-            self->last_freq = freq;
+            if (freq != self->last_freq || decay != self->last_decay)
+            {
+                self->res = MYEXP(-1.0 / (decay * self->sr));
+                //self->norm = (1.0-self->res*self->res)/self->res;
+                self->last_decay = decay;
+                ang = (freq * self->oneOnSr) * TWOPI;
+                self->coeffx = self->res * MYCOS(ang);
+                self->coeffy = self->res * MYSIN(ang);
+                self->last_freq = freq;
+            }
+
+            CoeffRamp_start(&self->ramp);
         }
 
         x = self->coeffx * self->x - self->coeffy * self->y + in[i];
@@ -11776,6 +13723,9 @@ ComplexRes_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     self->oneOnSr = 1.0 / self->sr;
 
+    MYFLT *coeffs[2] = {&self->coeffx, &self->coeffy};
+    CoeffRamp_init(&self->ramp, self->server, 2, coeffs);
+
     Stream_setFunctionPtr(self->stream, ComplexRes_compute_next_data_frame);
     self->mode_func_ptr = ComplexRes_setProcMode;
 
@@ -11836,6 +13786,8 @@ static PyObject * ComplexRes_inplace_div(ComplexRes *self, PyObject *arg) { INPL
 static PyObject * ComplexRes_setFreq(ComplexRes *self, PyObject *arg) { SET_PARAM(self->freq, self->freq_stream, 2); }
 static PyObject * ComplexRes_setDecay(ComplexRes *self, PyObject *arg) { SET_PARAM(self->decay, self->decay_stream, 3); }
 
+static PyObject * ComplexRes_setCoeffRate(ComplexRes *self, PyObject *arg) { return CoeffRamp_setRate(&self->ramp, arg); }
+
 static PyMemberDef ComplexRes_members[] =
 {
     {"server", T_OBJECT_EX, offsetof(ComplexRes, server), 0, "Pyo server."},
@@ -11857,6 +13809,7 @@ static PyMethodDef ComplexRes_methods[] =
     {"stop", (PyCFunction)ComplexRes_stop, METH_VARARGS | METH_KEYWORDS, "Stops computing."},
     {"setFreq", (PyCFunction)ComplexRes_setFreq, METH_O, "Sets filter center frequency in cycle per second."},
     {"setDecay", (PyCFunction)ComplexRes_setDecay, METH_O, "Sets filter decaying envelope time."},
+    {"setCoeffRate", (PyCFunction)ComplexRes_setCoeffRate, METH_O, "Sets the number of samples between two computations of the coefficients."},
     {"setMul", (PyCFunction)ComplexRes_setMul, METH_O, "Sets oscillator mul factor."},
     {"setAdd", (PyCFunction)ComplexRes_setAdd, METH_O, "Sets oscillator add factor."},
     {"setSub", (PyCFunction)ComplexRes_setSub, METH_O, "Sets inverse add factor."},
@@ -11971,6 +13924,7 @@ typedef struct
     MYFLT r;
     MYFLT p;
     MYFLT k;
+    CoeffRamp ramp;
 } MoogLP;
 
 static void
@@ -12035,20 +13989,25 @@ static void
 MoogLP_filters_ai(MoogLP *self)
 {
     MYFLT x, fr, res;
-    int i;
+    int i, k;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
     MYFLT *freq = Stream_getData((Stream *)self->freq_stream);
     res = PyFloat_AS_DOUBLE(self->res);
 
     for (i = 0; i < self->bufsize; i++)
     {
-        fr = freq[i];
-
-        if (fr != self->last_freq || res != self->last_res)
+        if (CoeffRamp_next(&self->ramp, i, self->bufsize, &k))
         {
-            self->last_freq = fr;
-            self->last_res = res;
-            MoogLP_compute_coeffs(self, fr, res);
+            fr = freq[k];
+
+            if (fr != self->last_freq || res != self->last_res)
+            {
+                self->last_freq = fr;
+                self->last_res = res;
+                MoogLP_compute_coeffs(self, fr, res);
+            }
+
+            CoeffRamp_start(&self->ramp);
         }
 
         x = in[i] - self->r * self->y4;
@@ -12069,20 +14028,25 @@ static void
 MoogLP_filters_ia(MoogLP *self)
 {
     MYFLT x, fr, res;
-    int i;
+    int i, k;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
     fr = PyFloat_AS_DOUBLE(self->freq);
     MYFLT *rz = Stream_getData((Stream *)self->res_stream);
 
     for (i = 0; i < self->bufsize; i++)
     {
-        res = rz[i];
-
-        if (fr != self->last_freq || res != self->last_res)
+        if (CoeffRamp_next(&self->ramp, i, self->bufsize, &k))
         {
-            self->last_freq = fr;
-            self->last_res = res;
-            MoogLP_compute_coeffs(self, fr, res);
+            res = rz[k];
+
+            if (fr != self->last_freq || res != self->last_res)
+            {
+                self->last_freq = fr;
+                self->last_res = res;
+                MoogLP_compute_coeffs(self, fr, res);
+            }
+
+            CoeffRamp_start(&self->ramp);
         }
 
         x = in[i] - self->r * self->y4;
@@ -12103,21 +14067,26 @@ static void
 MoogLP_filters_aa(MoogLP *self)
 {
     MYFLT x, fr, res;
-    int i;
+    int i, k;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
     MYFLT *freq = Stream_getData((Stream *)self->freq_stream);
     MYFLT *rz = Stream_getData((Stream *)self->res_stream);
 
     for (i = 0; i < self->bufsize; i++)
     {
-        fr = freq[i];
-        res = rz[i];
-
-        if (fr != self->last_freq || res != self->last_res)
+        if (CoeffRamp_next(&self->ramp, i, self->bufsize, &k))
         {
-            self->last_freq = fr;
-            self->last_res = res;
-            MoogLP_compute_coeffs(self, fr, res);
+            fr = freq[k];
+            res = rz[k];
+
+            if (fr != self->last_freq || res != self->last_res)
+            {
+                self->last_freq = fr;
+                self->last_res = res;
+                MoogLP_compute_coeffs(self, fr, res);
+            }
+
+            CoeffRamp_start(&self->ramp);
         }
 
         x = in[i] - self->r * self->y4;
@@ -12268,6 +14237,9 @@ MoogLP_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->nyquist = (MYFLT)self->sr * 0.49;
     self->oneOverSr = 1.0 / (MYFLT)self->sr;
 
+    MYFLT *coeffs[3] = {&self->r, &self->p, &self->k};
+    CoeffRamp_init(&self->ramp, self->server, 3, coeffs);
+
     Stream_setFunctionPtr(self->stream, MoogLP_compute_next_data_frame);
     self->mode_func_ptr = MoogLP_setProcMode;
 
@@ -12328,6 +14300,8 @@ static PyObject * MoogLP_inplace_div(MoogLP *self, PyObject *arg) { INPLACE_DIV
 static PyObject * MoogLP_setFreq(MoogLP *self, PyObject *arg) { SET_PARAM(self->freq, self->freq_stream, 2); }
 static PyObject * MoogLP_setRes(MoogLP *self, PyObject *arg) { SET_PARAM(self->res, self->res_stream, 3); }
 
+static PyObject * MoogLP_setCoeffRate(MoogLP *self, PyObject *arg) { return CoeffRamp_setRate(&self->ramp, arg); }
+
 static PyMemberDef MoogLP_members[] =
 {
     {"server", T_OBJECT_EX, offsetof(MoogLP, server), 0, "Pyo server."},
@@ -12349,6 +14323,7 @@ static PyMethodDef MoogLP_methods[] =
     {"stop", (PyCFunction)MoogLP_stop, METH_VARARGS | METH_KEYWORDS, "Stops computing."},
     {"setFreq", (PyCFunction)MoogLP_setFreq, METH_O, "Sets filter cutoff frequency in cycle per second."},
     {"setRes", (PyCFunction)MoogLP_setRes, METH_O, "Sets filter's resonance."},
+    {"setCoeffRate", (PyCFunction)MoogLP_setCoeffRate, METH_O, "Sets the number of samples between two computations of the coefficients."},
     {"setMul", (PyCFunction)MoogLP_setMul, METH_O, "Sets oscillator mul factor."},
     {"setAdd", (PyCFunction)MoogLP_setAdd, METH_O, "Sets oscillator add factor."},
     {"setSub", (PyCFunction)MoogLP_setSub, METH_O, "Sets inverse add factor."},
@@ -27,6 +27,7 @@
 #include "dummymodule.h"
 #include "tablemodule.h"
 #include "interpolation.h"
+#include "grainkernel.h"
 
 static MYFLT LOOPER_LINEAR_FADE[513] = {0.0, 0.001953125, 0.00390625, 0.005859375, 0.0078125, 0.009765625, 0.01171875, 0.013671875, 0.015625, 0.017578125, 0.01953125, 0.021484375, 0.0234375, 0.025390625, 0.02734375, 0.029296875, 0.03125, 0.033203125, 0.03515625, 0.037109375, 0.0390625, 0.041015625, 0.04296875, 0.044921875, 0.046875, 0.048828125, 0.05078125, 0.052734375, 0.0546875, 0.056640625, 0.05859375, 0.060546875, 0.0625, 0.064453125, 0.06640625, 0.068359375, 0.0703125, 0.072265625, 0.07421875, 0.076171875, 0.078125, 0.080078125, 0.08203125, 0.083984375, 0.0859375, 0.087890625, 0.08984375, 0.091796875, 0.09375, 0.095703125, 0.09765625, 0.099609375, 0.1015625, 0.103515625, 0.10546875, 0.107421875, 0.109375, 0.111328125, 0.11328125, 0.115234375, 0.1171875, 0.119140625, 0.12109375, 0.123046875, 0.125, 0.126953125, 0.12890625, 0.130859375, 0.1328125, 0.134765625, 0.13671875, 0.138671875, 0.140625, 0.142578125, 0.14453125, 0.146484375, 0.1484375, 0.150390625, 0.15234375, 0.154296875, 0.15625, 0.158203125, 0.16015625, 0.162109375, 0.1640625, 0.166015625, 0.16796875, 0.169921875, 0.171875, 0.173828125, 0.17578125, 0.177734375, 0.1796875, 0.181640625, 0.18359375, 0.185546875, 0.1875, 0.189453125, 0.19140625, 0.193359375, 0.1953125, 0.197265625, 0.19921875, 0.201171875, 0.203125, 0.205078125, 0.20703125, 0.208984375, 0.2109375, 0.212890625, 0.21484375, 0.216796875, 0.21875, 0.220703125, 0.22265625, 0.224609375, 0.2265625, 0.228515625, 0.23046875, 0.232421875, 0.234375, 0.236328125, 0.23828125, 0.240234375, 0.2421875, 0.244140625, 0.24609375, 0.248046875, 0.25, 0.251953125, 0.25390625, 0.255859375, 0.2578125, 0.259765625, 0.26171875, 0.263671875, 0.265625, 0.267578125, 0.26953125, 0.271484375, 0.2734375, 0.275390625, 0.27734375, 0.279296875, 0.28125, 0.283203125, 0.28515625, 0.287109375, 0.2890625, 0.291015625, 0.29296875, 0.294921875, 0.296875, 0.298828125, 0.30078125, 0.302734375, 0.3046875, 0.306640625, 0.30859375, 0.310546875, 0.3125, 0.314453125, 0.31640625, 0.318359375, 0.3203125, 0.322265625, 0.32421875, 0.326171875, 0.328125, 0.330078125, 0.33203125, 0.333984375, 0.3359375, 0.337890625, 0.33984375, 0.341796875, 0.34375, 0.345703125, 0.34765625, 0.349609375, 0.3515625, 0.353515625, 0.35546875, 0.357421875, 0.359375, 0.361328125, 0.36328125, 0.365234375, 0.3671875, 0.369140625, 0.37109375, 0.373046875, 0.375, 0.376953125, 0.37890625, 0.380859375, 0.3828125, 0.384765625, 0.38671875, 0.388671875, 0.390625, 0.392578125, 0.39453125, 0.396484375, 0.3984375, 0.400390625, 0.40234375, 0.404296875, 0.40625, 0.408203125, 0.41015625, 0.412109375, 0.4140625, 0.416015625, 0.41796875, 0.419921875, 0.421875, 0.423828125, 0.42578125, 0.427734375, 0.4296875, 0.431640625, 0.43359375, 0.435546875, 0.4375, 0.439453125, 0.44140625, 0.443359375, 0.4453125, 0.447265625, 0.44921875, 0.451171875, 0.453125, 0.455078125, 0.45703125, 0.458984375, 0.4609375, 0.462890625, 0.46484375, 0.466796875, 0.46875, 0.470703125, 0.47265625, 0.474609375, 0.4765625, 0.478515625, 0.48046875, 0.482421875, 0.484375, 0.486328125, 0.48828125, 0.490234375, 0.4921875, 0.494140625, 0.49609375, 0.498046875, 0.5, 0.501953125, 0.50390625, 0.505859375, 0.5078125, 0.509765625, 0.51171875, 0.513671875, 0.515625, 0.517578125, 0.51953125, 0.521484375, 0.5234375, 0.525390625, 0.52734375, 0.529296875, 0.53125, 0.533203125, 0.53515625, 0.537109375, 0.5390625, 0.541015625, 0.54296875, 0.544921875, 0.546875, 0.548828125, 0.55078125, 0.552734375, 0.5546875, 0.556640625, 0.55859375, 0.560546875, 0.5625, 0.564453125, 0.56640625, 0.568359375, 0.5703125, 0.572265625, 0.57421875, 0.576171875, 0.578125, 0.580078125, 0.58203125, 0.583984375, 0.5859375, 0.587890625, 0.58984375, 0.591796875, 0.59375, 0.595703125, 0.59765625, 0.599609375, 0.6015625, 0.603515625, 0.60546875, 0.607421875, 0.609375, 0.611328125, 0.61328125, 0.615234375, 0.6171875, 0.619140625, 0.62109375, 0.623046875, 0.625, 0.626953125, 0.62890625, 0.630859375, 0.6328125, 0.634765625, 0.63671875, 0.638671875, 0.640625, 0.642578125, 0.64453125, 0.646484375, 0.6484375, 0.650390625, 0.65234375, 0.654296875, 0.65625, 0.658203125, 0.66015625, 0.662109375, 0.6640625, 0.666015625, 0.66796875, 0.669921875, 0.671875, 0.673828125, 0.67578125, 0.677734375, 0.6796875, 0.681640625, 0.68359375, 0.685546875, 0.6875, 0.689453125, 0.69140625, 0.693359375, 0.6953125, 0.697265625, 0.69921875, 0.701171875, 0.703125, 0.705078125, 0.70703125, 0.708984375, 0.7109375, 0.712890625, 0.71484375, 0.716796875, 0.71875, 0.720703125, 0.72265625, 0.724609375, 0.7265625, 0.728515625, 0.73046875, 0.732421875, 0.734375, 0.736328125, 0.73828125, 0.740234375, 0.7421875, 0.744140625, 0.74609375, 0.748046875, 0.75, 0.751953125, 0.75390625, 0.755859375, 0.7578125, 0.759765625, 0.76171875, 0.763671875, 0.765625, 0.767578125, 0.76953125, 0.771484375, 0.7734375, 0.775390625, 0.77734375, 0.779296875, 0.78125, 0.783203125, 0.78515625, 0.787109375, 0.7890625, 0.791015625, 0.79296875, 0.794921875, 0.796875, 0.798828125, 0.80078125, 0.802734375, 0.8046875, 0.806640625, 0.80859375, 0.810546875, 0.8125, 0.814453125, 0.81640625, 0.818359375, 0.8203125, 0.822265625, 0.82421875, 0.826171875, 0.828125, 0.830078125, 0.83203125, 0.833984375, 0.8359375, 0.837890625, 0.83984375, 0.841796875, 0.84375, 0.845703125, 0.84765625, 0.849609375, 0.8515625, 0.853515625, 0.85546875, 0.857421875, 0.859375, 0.861328125, 0.86328125, 0.865234375, 0.8671875, 0.869140625, 0.87109375, 0.873046875, 0.875, 0.876953125, 0.87890625, 0.880859375, 0.8828125, 0.884765625, 0.88671875, 0.888671875, 0.890625, 0.892578125, 0.89453125, 0.896484375, 0.8984375, 0.900390625, 0.90234375, 0.904296875, 0.90625, 0.908203125, 0.91015625, 0.912109375, 0.9140625, 0.916015625, 0.91796875, 0.919921875, 0.921875, 0.923828125, 0.92578125, 0.927734375, 0.9296875, 0.931640625, 0.93359375, 0.935546875, 0.9375, 0.939453125, 0.94140625, 0.943359375, 0.9453125, 0.947265625, 0.94921875, 0.951171875, 0.953125, 0.955078125, 0.95703125, 0.958984375, 0.9609375, 0.962890625, 0.96484375, 0.966796875, 0.96875, 0.970703125, 0.97265625, 0.974609375, 0.9765625, 0.978515625, 0.98046875, 0.982421875, 0.984375, 0.986328125, 0.98828125, 0.990234375, 0.9921875, 0.994140625, 0.99609375, 0.998046875, 1.0};
 static MYFLT LOOPER_POWER_FADE[513] = {0.0, 0.0030679567629659761, 0.0061358846491544753, 0.0092037547820598194, 0.012271538285719925, 0.0153392062849881, 0.01840672990580482, 0.021474080275469508, 0.024541228522912288, 0.02760814577896574, 0.030674803176636626, 0.03374117185137758, 0.036807222941358832, 0.039872927587739811, 0.04293825693494082, 0.046003182130914623, 0.049067674327418015, 0.052131704680283324, 0.055195244349689941, 0.058258264500435752, 0.061320736302208578, 0.064382630929857465, 0.067443919563664051, 0.070504573389613856, 0.073564563599667426, 0.076623861392031492, 0.079682437971430126, 0.082740264549375692, 0.085797312344439894, 0.0888535525825246, 0.091908956497132724, 0.094963495329638992, 0.098017140329560604, 0.10106986275482782, 0.10412163387205459, 0.10717242495680884, 0.11022220729388306, 0.11327095217756435, 0.11631863091190475, 0.11936521481099135, 0.1224106751992162, 0.12545498341154623, 0.12849811079379317, 0.13154002870288312, 0.13458070850712617, 0.13762012158648604, 0.14065823933284921, 0.14369503315029447, 0.14673047445536175, 0.14976453467732151, 0.15279718525844344, 0.15582839765426523, 0.15885814333386145, 0.16188639378011183, 0.16491312048996992, 0.16793829497473117, 0.17096188876030122, 0.17398387338746382, 0.17700422041214875, 0.18002290140569951, 0.18303988795514095, 0.18605515166344663, 0.18906866414980619, 0.19208039704989244, 0.19509032201612825, 0.19809841071795356, 0.2011046348420919, 0.20410896609281687, 0.20711137619221856, 0.21011183688046961, 0.21311031991609136, 0.21610679707621952, 0.2191012401568698, 0.22209362097320351, 0.22508391135979283, 0.22807208317088573, 0.23105810828067111, 0.23404195858354343, 0.2370236059943672, 0.2400030224487415, 0.24298017990326387, 0.24595505033579459, 0.24892760574572015, 0.25189781815421697, 0.25486565960451457, 0.25783110216215899, 0.26079411791527551, 0.26375467897483135, 0.26671275747489837, 0.26966832557291509, 0.27262135544994898, 0.27557181931095814, 0.27851968938505306, 0.28146493792575794, 0.28440753721127188, 0.28734745954472951, 0.29028467725446233, 0.29321916269425863, 0.29615088824362379, 0.29907982630804048, 0.30200594931922808, 0.30492922973540237, 0.30784964004153487, 0.31076715274961147, 0.31368174039889152, 0.31659337555616585, 0.31950203081601569, 0.32240767880106985, 0.32531029216226293, 0.3282098435790925, 0.33110630575987643, 0.33399965144200938, 0.33688985339222005, 0.33977688440682685, 0.34266071731199438, 0.34554132496398909, 0.34841868024943456, 0.35129275608556709, 0.35416352542049034, 0.35703096123342998, 0.35989503653498811, 0.36275572436739723, 0.36561299780477385, 0.36846682995337232, 0.37131719395183754, 0.37416406297145793, 0.37700741021641826, 0.37984720892405116, 0.38268343236508978, 0.38551605384391885, 0.38834504669882625, 0.39117038430225387, 0.3939920400610481, 0.39680998741671031, 0.39962419984564679, 0.40243465085941843, 0.40524131400498986, 0.40804416286497869, 0.41084317105790391, 0.41363831223843456, 0.41642956009763715, 0.41921688836322391, 0.42200027079979968, 0.42477968120910881, 0.42755509343028208, 0.43032648134008261, 0.43309381885315196, 0.43585707992225547, 0.43861623853852766, 0.44137126873171667, 0.4441221445704292, 0.44686884016237416, 0.44961132965460654, 0.45234958723377089, 0.45508358712634384, 0.45781330359887723, 0.46053871095824001, 0.46325978355186015, 0.46597649576796618, 0.46868882203582796, 0.47139673682599764, 0.47410021465054997, 0.47679923006332209, 0.47949375766015301, 0.48218377207912272, 0.48486924800079106, 0.487550160148436, 0.49022648328829116, 0.49289819222978404, 0.49556526182577254, 0.49822766697278187, 0.50088538261124071, 0.50353838372571758, 0.50618664534515523, 0.50883014254310699, 0.5114688504379703, 0.51410274419322166, 0.51673179901764987, 0.51935599016558964, 0.52197529293715439, 0.52458968267846895, 0.52719913478190139, 0.52980362468629461, 0.5324031278771979, 0.53499761988709715, 0.53758707629564539, 0.54017147272989285, 0.54275078486451589, 0.54532498842204646, 0.54789405917310019, 0.55045797293660481, 0.55301670558002747, 0.55557023301960218, 0.5581185312205561, 0.56066157619733603, 0.56319934401383409, 0.56573181078361312, 0.56825895267013149, 0.57078074588696726, 0.5732971666980422, 0.57580819141784534, 0.57831379641165559, 0.58081395809576453, 0.58330865293769829, 0.58579785745643886, 0.58828154822264522, 0.59075970185887416, 0.5932322950397998, 0.59569930449243336, 0.59816070699634238, 0.60061647938386897, 0.60306659854034816, 0.60551104140432555, 0.60794978496777363, 0.61038280627630948, 0.61281008242940971, 0.61523159058062682, 0.61764730793780387, 0.6200572117632891, 0.62246127937414997, 0.62485948814238634, 0.62725181549514408, 0.62963823891492698, 0.63201873593980906, 0.63439328416364549, 0.6367618612362842, 0.63912444486377573, 0.64148101280858316, 0.64383154288979139, 0.64617601298331628, 0.64851440102211244, 0.65084668499638099, 0.65317284295377676, 0.65549285299961535, 0.65780669329707864, 0.66011434206742048, 0.66241577759017178, 0.66471097820334479, 0.66699992230363747, 0.66928258834663601, 0.67155895484701833, 0.67382900037875604, 0.67609270357531592, 0.67835004312986147, 0.68060099779545302, 0.68284554638524808, 0.68508366777270036, 0.68731534089175905, 0.68954054473706683, 0.69175925836415775, 0.69397146088965389, 0.69617713149146299, 0.69837624940897292, 0.70056879394324834, 0.7027547444572253, 0.70493408037590488, 0.70710678118654746, 0.70927282643886558, 0.71143219574521632, 0.71358486878079352, 0.71573082528381859, 0.7178700450557316, 0.72000250796138165, 0.72212819392921523, 0.72424708295146689, 0.7263591550843459, 0.7284643904482252, 0.73056276922782759, 0.7326542716724127, 0.73473887809596339, 0.73681656887736979, 0.73888732446061511, 0.74095112535495899, 0.74300795213512161, 0.74505778544146595, 0.74710060598018013, 0.74913639452345926, 0.75116513190968637, 0.75318679904361241, 0.75520137689653644, 0.75720884650648446, 0.75920918897838796, 0.76120238548426178, 0.76318841726338127, 0.76516726562245885, 0.76713891193582029, 0.76910333764557959, 0.77106052426181371, 0.77301045336273688, 0.77495310659487382, 0.77688846567323244, 0.77881651238147587, 0.78073722857209438, 0.78265059616657562, 0.78455659715557524, 0.78645521359908577, 0.78834642762660623, 0.79023022143731003, 0.79210657730021228, 0.79397547755433706, 0.79583690460888346, 0.79769084094339104, 0.79953726910790501, 0.80137617172314013, 0.80320753148064483, 0.80503133114296355, 0.80684755354379922, 0.80865618158817498, 0.81045719825259477, 0.81225058658520388, 0.8140363297059483, 0.81581441080673378, 0.81758481315158371, 0.8193475200767969, 0.82110251499110465, 0.82284978137582632, 0.82458930278502529, 0.82632106284566342, 0.82804504525775569, 0.82976123379452305, 0.83146961230254512, 0.83317016470191319, 0.83486287498638001, 0.83654772722351189, 0.83822470555483797, 0.83989379419599941, 0.84155497743689833, 0.84320823964184544, 0.84485356524970701, 0.84649093877405202, 0.84812034480329712, 0.84974176800085244, 0.8513551931052652, 0.85296060493036363, 0.85455798836540053, 0.85614732837519436, 0.85772861000027212, 0.85930181835700825, 0.8608669386377672, 0.8624239561110405, 0.8639728561215867, 0.86551362409056898, 0.86704624551569265, 0.8685707059713409, 0.87008699110871135, 0.87159508665595098, 0.87309497841828998, 0.87458665227817611, 0.87607009419540649, 0.87754529020726124, 0.87901222642863341, 0.88047088905216075, 0.88192126434835494, 0.88336333866573158, 0.88479709843093779, 0.88622253014888064, 0.88763962040285393, 0.88904835585466446, 0.89044872324475788, 0.89184070939234272, 0.89322430119551532, 0.89459948563138258, 0.89596624975618511, 0.89732458070541832, 0.89867446569395382, 0.90001589201616028, 0.90134884704602203, 0.90267331823725883, 0.90398929312344334, 0.90529675931811882, 0.90659570451491533, 0.90788611648766615, 0.90916798309052238, 0.91044129225806714, 0.91170603200542988, 0.9129621904283981, 0.91420975570353069, 0.91544871608826783, 0.9166790599210427, 0.91790077562139039, 0.91911385169005777, 0.92031827670911048, 0.9215140393420419, 0.92270112833387852, 0.92387953251128674, 0.92504924078267758, 0.92621024213831138, 0.92736252565040111, 0.92850608047321548, 0.92964089584318121, 0.93076696107898371, 0.93188426558166815, 0.93299279883473885, 0.93409255040425887, 0.9351835099389475, 0.93626566717027826, 0.93733901191257496, 0.93840353406310806, 0.93945922360218992, 0.9405060705932683, 0.94154406518302081, 0.94257319760144687, 0.94359345816196039, 0.94460483726148026, 0.94560732538052128, 0.94660091308328353, 0.94758559101774109, 0.94856134991573027, 0.94952818059303667, 0.9504860739494817, 0.95143502096900834, 0.95237501271976588, 0.95330604035419375, 0.95422809510910567, 0.95514116830577067, 0.95604525134999641, 0.95694033573220894, 0.95782641302753291, 0.9587034748958716, 0.95957151308198452, 0.96043051941556579, 0.96128048581132064, 0.96212140426904158, 0.96295326687368388, 0.96377606579543984, 0.96458979328981265, 0.9653944416976894, 0.96619000344541262, 0.96697647104485207, 0.96775383709347551, 0.96852209427441727, 0.96928123535654853, 0.97003125319454397, 0.97077214072895035, 0.97150389098625178, 0.97222649707893627, 0.97293995220556007, 0.97364424965081187, 0.97433938278557586, 0.97502534506699412, 0.97570213003852857, 0.97636973133002114, 0.97702814265775439, 0.97767735782450993, 0.97831737071962765, 0.9789481753190622, 0.97956976568544052, 0.98018213596811732, 0.98078528040323043, 0.98137919331375456, 0.98196386910955524, 0.98253930228744124, 0.98310548743121629, 0.98366241921173025, 0.98421009238692903, 0.98474850180190421, 0.98527764238894122, 0.98579750916756737, 0.98630809724459867, 0.98680940181418542, 0.98730141815785843, 0.98778414164457218, 0.98825756773074946, 0.98872169196032378, 0.98917650996478101, 0.98962201746320078, 0.99005821026229712, 0.99048508425645698, 0.99090263542778001, 0.99131085984611544, 0.99170975366909953, 0.9920993131421918, 0.99247953459870997, 0.9928504144598651, 0.9932119492347945, 0.9935641355205953, 0.99390697000235606, 0.9942404494531879, 0.99456457073425542, 0.99487933079480562, 0.99518472667219682, 0.99548075549192694, 0.99576741446765982, 0.99604470090125197, 0.996312612182778, 0.99657114579055484, 0.99682029929116567, 0.99706007033948296, 0.99729045667869021, 0.99751145614030345, 0.99772306664419164, 0.997925286198596, 0.99811811290014918, 0.99830154493389289, 0.99847558057329477, 0.99864021818026527, 0.99879545620517241, 0.99894129318685687, 0.99907772775264536, 0.99920475861836389, 0.99932238458834954, 0.99943060455546173, 0.99952941750109314, 0.99961882249517864, 0.99969881869620425, 0.99976940535121528, 0.9998305817958234, 0.99988234745421256, 0.9999247018391445, 0.9999576445519639, 0.99998117528260111, 0.99999529380957619, 1.0};
@@ -46,79 +47,39 @@ typedef struct
     int ngrains;
     MYFLT basedur;
     MYFLT pointerPos;
+    MYFLT *grains; /* Single block holding the four arrays below. */
     MYFLT *startPos;
     MYFLT *gsize;
     MYFLT *gphase;
     MYFLT *lastppos;
+    MYFLT *pointer; /* Pointer position at each sample of the block, before its wrap. */
+    MYFLT *phases; /* Phase of the current grain at each sample of the block. */
+    MYFLT *indexes; /* Table index of the current grain at each sample of the block. */
     MYFLT srScale;
     int modebuffer[5];
 } Granulator;
 
 static void
-Granulator_transform_iii(Granulator *self)
+Granulator_alloc_grains(Granulator *self)
 {
-    MYFLT val, x, x1, inc, index, fpart, amp, ppos;
-    int i, j;
-    T_SIZE_T ipart;
-
-    MYFLT *tablelist = TableStream_getData((TableStream *)self->table);
-    T_SIZE_T size = TableStream_getSize((TableStream *)self->table);
-
-    MYFLT *envlist = TableStream_getData((TableStream *)self->env);
-    T_SIZE_T envsize = TableStream_getSize((TableStream *)self->env);
-
-    MYFLT pit = PyFloat_AS_DOUBLE(self->pitch);
-    MYFLT pos = PyFloat_AS_DOUBLE(self->pos);
-    MYFLT dur = PyFloat_AS_DOUBLE(self->dur);
+    self->grains = (MYFLT *)PyMem_RawRealloc(self->grains, 4 * self->ngrains * sizeof(MYFLT));
+    self->startPos = self->grains;
+    self->gsize = self->grains + self->ngrains;
+    self->gphase = self->grains + 2 * self->ngrains;
+    self->lastppos = self->grains + 3 * self->ngrains;
+}
 
-    inc = pit * (1.0 / self->basedur) / self->sr;
+/* Moves the pointer over the block with a constant increment. */
+static void
+Granulator_pointer_i(Granulator *self, MYFLT inc)
+{
+    int i;
 
     for (i = 0; i < self->bufsize; i++)
     {
         self->data[i] = 0.0;
         self->pointerPos += inc;
-
-        for (j = 0; j < self->ngrains; j++)
-        {
-            ppos = self->pointerPos + self->gphase[j];
-
-            if (ppos >= 1.0)
-            {
-                ppos -= 1.0;
-            }
-
-            // compute envelope
-            index = ppos * envsize;
-            ipart = (T_SIZE_T)index;
-            fpart = index - ipart;
-            x = envlist[ipart];
-            x1 = envlist[ipart + 1];
-            amp = x + (x1 - x) * fpart;
-
-            if (ppos < self->lastppos[j])
-            {
-                self->startPos[j] = pos;
-                self->gsize[j] = dur * self->sr * self->srScale;
-            }
-
-            self->lastppos[j] = ppos;
-
-            // compute sampling
-            index = ppos * self->gsize[j] + self->startPos[j];
-
-            if (index >= 0 && index < size)
-            {
-                ipart = (T_SIZE_T)index;
-                fpart = index - ipart;
-                x = tablelist[ipart];
-                x1 = tablelist[ipart + 1];
-                val = x + (x1 - x) * fpart;
-            }
-            else
-                val = 0.0;
-
-            self->data[i] += (val * amp);
-        }
+        self->pointer[i] = self->pointerPos;
 
         if (self->pointerPos < 0)
             self->pointerPos += 1.0;
@@ -127,22 +88,12 @@ Granulator_transform_iii(Granulator *self)
     }
 }
 
+/* Same with the pitch given as an audio stream. */
 static void
-Granulator_transform_aii(Granulator *self)
+Granulator_pointer_a(Granulator *self, MYFLT *pit)
 {
-    MYFLT val, x, x1, inc, index, fpart, amp, ppos, frtosamps;
-    int i, j;
-    T_SIZE_T ipart;
-
-    MYFLT *tablelist = TableStream_getData((TableStream *)self->table);
-    T_SIZE_T size = TableStream_getSize((TableStream *)self->table);
-
-    MYFLT *envlist = TableStream_getData((TableStream *)self->env);
-    T_SIZE_T envsize = TableStream_getSize((TableStream *)self->env);
-
-    MYFLT *pit = Stream_getData((Stream *)self->pitch_stream);
-    MYFLT pos = PyFloat_AS_DOUBLE(self->pos);
-    MYFLT dur = PyFloat_AS_DOUBLE(self->dur);
+    MYFLT inc, frtosamps;
+    int i;
 
     frtosamps = (1.0 / self->basedur) / self->sr;
 
@@ -151,48 +102,7 @@ Granulator_transform_aii(Granulator *self)
         self->data[i] = 0.0;
         inc = pit[i] * frtosamps;
         self->pointerPos += inc;
-
-        for (j = 0; j < self->ngrains; j++)
-        {
-            ppos = self->pointerPos + self->gphase[j];
-
-            if (ppos >= 1.0)
-            {
-                ppos -= 1.0;
-            }
-
-            // compute envelope
-            index = ppos * envsize;
-            ipart = (T_SIZE_T)index;
-            fpart = index - ipart;
-            x = envlist[ipart];
-            x1 = envlist[ipart + 1];
-            amp = x + (x1 - x) * fpart;
-
-            if (ppos < self->lastppos[j])
-            {
-                self->startPos[j] = pos;
-                self->gsize[j] = dur * self->sr * self->srScale;
-            }
-
-            self->lastppos[j] = ppos;
-
-            // compute sampling
-            index = ppos * self->gsize[j] + self->startPos[j];
-
-            if (index >= 0 && index < size)
-            {
-                ipart = (T_SIZE_T)index;
-                fpart = index - ipart;
-                x = tablelist[ipart];
-                x1 = tablelist[ipart + 1];
-                val = x + (x1 - x) * fpart;
-            }
-            else
-                val = 0.0;
-
-            self->data[i] += (val * amp);
-        }
+        self->pointer[i] = self->pointerPos;
 
         if (self->pointerPos < 0)
             self->pointerPos += 1.0;
@@ -201,12 +111,22 @@ Granulator_transform_aii(Granulator *self)
     }
 }
 
+/* Adds the grains to the output, one after the other over the whole block.
+ * For each grain, a first loop follows its phase, restarts the grain (new
+ * start position and size) where the phase wraps around and computes the
+ * table index of each sample. The envelope and the table are then read by
+ * the grain kernel (see grainkernel.h). The grains are still summed in the
+ * same order at each sample, so the output is the same as when all the
+ * grains were computed at each sample.
+ *
+ * `pos[i * posstep]` and `dur[i * durstep]` are the start position and the
+ * duration of a grain restarting at sample i (a step of 0 for a float).
+ * When `dur` is NULL, the grain sizes are left as they are. */
 static void
-Granulator_transform_iai(Granulator *self)
+Granulator_grains(Granulator *self, MYFLT *pos, int posstep, MYFLT *dur, int durstep)
 {
-    MYFLT val, x, x1, inc, index, fpart, amp, ppos;
+    MYFLT ppos, gphase, last, start, gsize;
     int i, j;
-    T_SIZE_T ipart;
 
     MYFLT *tablelist = TableStream_getData((TableStream *)self->table);
     T_SIZE_T size = TableStream_getSize((TableStream *)self->table);
@@ -214,438 +134,137 @@ Granulator_transform_iai(Granulator *self)
     MYFLT *envlist = TableStream_getData((TableStream *)self->env);
     T_SIZE_T envsize = TableStream_getSize((TableStream *)self->env);
 
-    MYFLT pit = PyFloat_AS_DOUBLE(self->pitch);
-    MYFLT *pos = Stream_getData((Stream *)self->pos_stream);
-    MYFLT dur = PyFloat_AS_DOUBLE(self->dur);
-
-    inc = pit * (1.0 / self->basedur) / self->sr;
-
-    MYFLT gsize = dur * self->sr * self->srScale;
-
     for (j = 0; j < self->ngrains; j++)
     {
-        self->gsize[j] = gsize;
-    }
-
-    for (i = 0; i < self->bufsize; i++)
-    {
-        self->data[i] = 0.0;
-        self->pointerPos += inc;
+        gphase = self->gphase[j];
+        last = self->lastppos[j];
+        start = self->startPos[j];
+        gsize = self->gsize[j];
 
-        for (j = 0; j < self->ngrains; j++)
+        for (i = 0; i < self->bufsize; i++)
         {
-            ppos = self->pointerPos + self->gphase[j];
+            ppos = self->pointer[i] + gphase;
 
             if (ppos >= 1.0)
             {
                 ppos -= 1.0;
             }
 
-            // compute envelope
-            index = ppos * envsize;
-            ipart = (T_SIZE_T)index;
-            fpart = index - ipart;
-            x = envlist[ipart];
-            x1 = envlist[ipart + 1];
-            amp = x + (x1 - x) * fpart;
-
-            if (ppos < self->lastppos[j])
+            if (ppos < last)
             {
-                self->startPos[j] = pos[i];
-            }
-
-            self->lastppos[j] = ppos;
-
-            // compute sampling
-            index = ppos * self->gsize[j] + self->startPos[j];
+                start = pos[i * posstep];
 
-            if (index >= 0 && index < size)
-            {
-                ipart = (T_SIZE_T)index;
-                fpart = index - ipart;
-                x = tablelist[ipart];
-                x1 = tablelist[ipart + 1];
-                val = x + (x1 - x) * fpart;
+                if (dur != NULL)
+                    gsize = dur[i * durstep] * self->sr * self->srScale;
             }
-            else
-                val = 0.0;
 
-            self->data[i] += (val * amp);
+            last = ppos;
+            self->phases[i] = ppos;
+            self->indexes[i] = ppos * gsize + start;
         }
 
-        if (self->pointerPos < 0)
-            self->pointerPos += 1.0;
-        else if (self->pointerPos >= 1)
-            self->pointerPos -= 1.0;
+        self->lastppos[j] = last;
+        self->startPos[j] = start;
+        self->gsize[j] = gsize;
+
+        grainkernel_accumulate(self->data, self->phases, self->indexes, envlist, envsize, tablelist, size, self->bufsize);
     }
 }
 
 static void
-Granulator_transform_aai(Granulator *self)
+Granulator_transform_iii(Granulator *self)
 {
-    MYFLT val, x, x1, inc, index, fpart, amp, ppos, frtosamps;
-    int i, j;
-    T_SIZE_T ipart;
-
-    MYFLT *tablelist = TableStream_getData((TableStream *)self->table);
-    T_SIZE_T size = TableStream_getSize((TableStream *)self->table);
+    MYFLT pit = PyFloat_AS_DOUBLE(self->pitch);
+    MYFLT pos = PyFloat_AS_DOUBLE(self->pos);
+    MYFLT dur = PyFloat_AS_DOUBLE(self->dur);
 
-    MYFLT *envlist = TableStream_getData((TableStream *)self->env);
-    T_SIZE_T envsize = TableStream_getSize((TableStream *)self->env);
+    Granulator_pointer_i(self, pit * (1.0 / self->basedur) / self->sr);
+    Granulator_grains(self, &pos, 0, &dur, 0);
+}
 
+static void
+Granulator_transform_aii(Granulator *self)
+{
     MYFLT *pit = Stream_getData((Stream *)self->pitch_stream);
-    MYFLT *pos = Stream_getData((Stream *)self->pos_stream);
+    MYFLT pos = PyFloat_AS_DOUBLE(self->pos);
     MYFLT dur = PyFloat_AS_DOUBLE(self->dur);
 
-    frtosamps = (1.0 / self->basedur) / self->sr;
-
-    for (i = 0; i < self->bufsize; i++)
-    {
-        self->data[i] = 0.0;
-        inc = pit[i] * frtosamps;
-        self->pointerPos += inc;
-
-        for (j = 0; j < self->ngrains; j++)
-        {
-            ppos = self->pointerPos + self->gphase[j];
-
-            if (ppos >= 1.0)
-            {
-                ppos -= 1.0;
-            }
-
-            // compute envelope
-            index = ppos * envsize;
-            ipart = (T_SIZE_T)index;
-            fpart = index - ipart;
-            x = envlist[ipart];
-            x1 = envlist[ipart + 1];
-            amp = x + (x1 - x) * fpart;
+    Granulator_pointer_a(self, pit);
+    Granulator_grains(self, &pos, 0, &dur, 0);
+}
 
-            if (ppos < self->lastppos[j])
-            {
-                self->startPos[j] = pos[i];
-                self->gsize[j] = dur * self->sr * self->srScale;
-            }
+static void
+Granulator_transform_iai(Granulator *self)
+{
+    int j;
+    MYFLT pit = PyFloat_AS_DOUBLE(self->pitch);
+    MYFLT *pos = Stream_getData((Stream *)self->pos_stream);
+    MYFLT dur = PyFloat_AS_DOUBLE(self->dur);
 
-            self->lastppos[j] = ppos;
+    MYFLT gsize = dur * self->sr * self->srScale;
 
-            // compute sampling
-            index = ppos * self->gsize[j] + self->startPos[j];
+    for (j = 0; j < self->ngrains; j++)
+    {
+        self->gsize[j] = gsize;
+    }
 
-            if (index >= 0 && index < size)
-            {
-                ipart = (T_SIZE_T)index;
-                fpart = index - ipart;
-                x = tablelist[ipart];
-                x1 = tablelist[ipart + 1];
-                val = x + (x1 - x) * fpart;
-            }
-            else
-                val = 0.0;
+    Granulator_pointer_i(self, pit * (1.0 / self->basedur) / self->sr);
+    Granulator_grains(self, pos, 1, NULL, 0);
+}
 
-            self->data[i] += (val * amp);
-        }
+static void
+Granulator_transform_aai(Granulator *self)
+{
+    MYFLT *pit = Stream_getData((Stream *)self->pitch_stream);
+    MYFLT *pos = Stream_getData((Stream *)self->pos_stream);
+    MYFLT dur = PyFloat_AS_DOUBLE(self->dur);
 
-        if (self->pointerPos < 0)
-            self->pointerPos += 1.0;
-        else if (self->pointerPos >= 1)
-            self->pointerPos -= 1.0;
-    }
+    Granulator_pointer_a(self, pit);
+    Granulator_grains(self, pos, 1, &dur, 0);
 }
 
 static void
 Granulator_transform_iia(Granulator *self)
 {
-    MYFLT val, x, x1, inc, index, fpart, amp, ppos;
-    int i, j;
-    T_SIZE_T ipart;
-
-    MYFLT *tablelist = TableStream_getData((TableStream *)self->table);
-    T_SIZE_T size = TableStream_getSize((TableStream *)self->table);
-
-    MYFLT *envlist = TableStream_getData((TableStream *)self->env);
-    T_SIZE_T envsize = TableStream_getSize((TableStream *)self->env);
-
     MYFLT pit = PyFloat_AS_DOUBLE(self->pitch);
     MYFLT pos = PyFloat_AS_DOUBLE(self->pos);
     MYFLT *dur = Stream_getData((Stream *)self->dur_stream);
 
-    inc = pit * (1.0 / self->basedur) / self->sr;
-
-    for (i = 0; i < self->bufsize; i++)
-    {
-        self->data[i] = 0.0;
-        self->pointerPos += inc;
-
-        for (j = 0; j < self->ngrains; j++)
-        {
-            ppos = self->pointerPos + self->gphase[j];
-
-            if (ppos >= 1.0)
-            {
-                ppos -= 1.0;
-            }
-
-            // compute envelope
-            index = ppos * envsize;
-            ipart = (T_SIZE_T)index;
-            fpart = index - ipart;
-            x = envlist[ipart];
-            x1 = envlist[ipart + 1];
-            amp = x + (x1 - x) * fpart;
-
-            if (ppos < self->lastppos[j])
-            {
-                self->startPos[j] = pos;
-                self->gsize[j] = dur[i] * self->sr * self->srScale;
-            }
-
-            self->lastppos[j] = ppos;
-
-            // compute sampling
-            index = ppos * self->gsize[j] + self->startPos[j];
-
-            if (index >= 0 && index < size)
-            {
-                ipart = (T_SIZE_T)index;
-                fpart = index - ipart;
-                x = tablelist[ipart];
-                x1 = tablelist[ipart + 1];
-                val = x + (x1 - x) * fpart;
-            }
-            else
-                val = 0.0;
-
-            self->data[i] += (val * amp);
-        }
-
-        if (self->pointerPos < 0)
-            self->pointerPos += 1.0;
-        else if (self->pointerPos >= 1)
-            self->pointerPos -= 1.0;
-    }
+    Granulator_pointer_i(self, pit * (1.0 / self->basedur) / self->sr);
+    Granulator_grains(self, &pos, 0, dur, 1);
 }
 
 static void
 Granulator_transform_aia(Granulator *self)
 {
-    MYFLT val, x, x1, inc, index, fpart, amp, ppos, frtosamps;
-    int i, j;
-    T_SIZE_T ipart;
-
-    MYFLT *tablelist = TableStream_getData((TableStream *)self->table);
-    T_SIZE_T size = TableStream_getSize((TableStream *)self->table);
-
-    MYFLT *envlist = TableStream_getData((TableStream *)self->env);
-    T_SIZE_T envsize = TableStream_getSize((TableStream *)self->env);
-
     MYFLT *pit = Stream_getData((Stream *)self->pitch_stream);
     MYFLT pos = PyFloat_AS_DOUBLE(self->pos);
     MYFLT *dur = Stream_getData((Stream *)self->dur_stream);
 
-    frtosamps = (1.0 / self->basedur) / self->sr;
+    Granulator_pointer_a(self, pit);
+    Granulator_grains(self, &pos, 0, dur, 1);
+}
 
-    for (i = 0; i < self->bufsize; i++)
-    {
-        self->data[i] = 0.0;
-        inc = pit[i] * frtosamps;
-        self->pointerPos += inc;
+static void
+Granulator_transform_iaa(Granulator *self)
+{
+    MYFLT pit = PyFloat_AS_DOUBLE(self->pitch);
+    MYFLT *pos = Stream_getData((Stream *)self->pos_stream);
+    MYFLT *dur = Stream_getData((Stream *)self->dur_stream);
 
-        for (j = 0; j < self->ngrains; j++)
-        {
-            ppos = self->pointerPos + self->gphase[j];
+    Granulator_pointer_i(self, pit * (1.0 / self->basedur) / self->sr);
+    Granulator_grains(self, pos, 1, dur, 1);
+}
 
-            if (ppos >= 1.0)
-            {
-                ppos -= 1.0;
-            }
+static void
+Granulator_transform_aaa(Granulator *self)
+{
+    MYFLT *pit = Stream_getData((Stream *)self->pitch_stream);
+    MYFLT *pos = Stream_getData((Stream *)self->pos_stream);
+    MYFLT *dur = Stream_getData((Stream *)self->dur_stream);
 
-            // compute envelope
-            index = ppos * envsize;
-            ipart = (T_SIZE_T)index;
-            fpart = index - ipart;
-            x = envlist[ipart];
-            x1 = envlist[ipart + 1];
-            amp = x + (x1 - x) * fpart;
-
-            if (ppos < self->lastppos[j])
-            {
-                self->startPos[j] = pos;
-                self->gsize[j] = dur[i] * self->sr * self->srScale;
-            }
-
-            self->lastppos[j] = ppos;
-
-            // compute sampling
-            index = ppos * self->gsize[j] + self->startPos[j];
-
-            if (index >= 0 && index < size)
-            {
-                ipart = (T_SIZE_T)index;
-                fpart = index - ipart;
-                x = tablelist[ipart];
-                x1 = tablelist[ipart + 1];
-                val = x + (x1 - x) * fpart;
-            }
-            else
-                val = 0.0;
-
-            self->data[i] += (val * amp);
-        }
-
-        if (self->pointerPos < 0)
-            self->pointerPos += 1.0;
-        else if (self->pointerPos >= 1)
-            self->pointerPos -= 1.0;
-    }
-}
-
-static void
-Granulator_transform_iaa(Granulator *self)
-{
-    MYFLT val, x, x1, inc, index, fpart, amp, ppos;
-    int i, j;
-    T_SIZE_T ipart;
-
-    MYFLT *tablelist = TableStream_getData((TableStream *)self->table);
-    T_SIZE_T size = TableStream_getSize((TableStream *)self->table);
-
-    MYFLT *envlist = TableStream_getData((TableStream *)self->env);
-    T_SIZE_T envsize = TableStream_getSize((TableStream *)self->env);
-
-    MYFLT pit = PyFloat_AS_DOUBLE(self->pitch);
-    MYFLT *pos = Stream_getData((Stream *)self->pos_stream);
-    MYFLT *dur = Stream_getData((Stream *)self->dur_stream);
-
-    inc = pit * (1.0 / self->basedur) / self->sr;
-
-    for (i = 0; i < self->bufsize; i++)
-    {
-        self->data[i] = 0.0;
-        self->pointerPos += inc;
-
-        for (j = 0; j < self->ngrains; j++)
-        {
-            ppos = self->pointerPos + self->gphase[j];
-
-            if (ppos >= 1.0)
-            {
-                ppos -= 1.0;
-            }
-
-            // compute envelope
-            index = ppos * envsize;
-            ipart = (T_SIZE_T)index;
-            fpart = index - ipart;
-            x = envlist[ipart];
-            x1 = envlist[ipart + 1];
-            amp = x + (x1 - x) * fpart;
-
-            if (ppos < self->lastppos[j])
-            {
-                self->startPos[j] = pos[i];
-                self->gsize[j] = dur[i] * self->sr * self->srScale;
-            }
-
-            self->lastppos[j] = ppos;
-
-            // compute sampling
-            index = ppos * self->gsize[j] + self->startPos[j];
-
-            if (index >= 0 && index < size)
-            {
-                ipart = (T_SIZE_T)index;
-                fpart = index - ipart;
-                x = tablelist[ipart];
-                x1 = tablelist[ipart + 1];
-                val = x + (x1 - x) * fpart;
-            }
-            else
-                val = 0.0;
-
-            self->data[i] += (val * amp);
-        }
-
-        if (self->pointerPos < 0)
-            self->pointerPos += 1.0;
-        else if (self->pointerPos >= 1)
-            self->pointerPos -= 1.0;
-    }
-}
-
-static void
-Granulator_transform_aaa(Granulator *self)
-{
-    MYFLT val, x, x1, inc, index, fpart, amp, ppos, frtosamps;
-    int i, j;
-    T_SIZE_T ipart;
-
-    MYFLT *tablelist = TableStream_getData((TableStream *)self->table);
-    T_SIZE_T size = TableStream_getSize((TableStream *)self->table);
-
-    MYFLT *envlist = TableStream_getData((TableStream *)self->env);
-    T_SIZE_T envsize = TableStream_getSize((TableStream *)self->env);
-
-    MYFLT *pit = Stream_getData((Stream *)self->pitch_stream);
-    MYFLT *pos = Stream_getData((Stream *)self->pos_stream);
-    MYFLT *dur = Stream_getData((Stream *)self->dur_stream);
-
-    frtosamps = (1.0 / self->basedur) / self->sr;
-
-    for (i = 0; i < self->bufsize; i++)
-    {
-        self->data[i] = 0.0;
-        inc = pit[i] * frtosamps;
-        self->pointerPos += inc;
-
-        for (j = 0; j < self->ngrains; j++)
-        {
-            ppos = self->pointerPos + self->gphase[j];
-
-            if (ppos >= 1.0)
-            {
-                ppos -= 1.0;
-            }
-
-            // compute envelope
-            index = ppos * envsize;
-            ipart = (T_SIZE_T)index;
-            fpart = index - ipart;
-            x = envlist[ipart];
-            x1 = envlist[ipart + 1];
-            amp = x + (x1 - x) * fpart;
-
-            if (ppos < self->lastppos[j])
-            {
-                self->startPos[j] = pos[i];
-                self->gsize[j] = dur[i] * self->sr * self->srScale;
-            }
-
-            self->lastppos[j] = ppos;
-
-            // compute sampling
-            index = ppos * self->gsize[j] + self->startPos[j];
-
-            if (index >= 0 && index < size)
-            {
-                ipart = (T_SIZE_T)index;
-                fpart = index - ipart;
-                x = tablelist[ipart];
-                x1 = tablelist[ipart + 1];
-                val = x + (x1 - x) * fpart;
-            }
-            else
-                val = 0.0;
-
-            self->data[i] += (val * amp);
-        }
-
-        if (self->pointerPos < 0)
-            self->pointerPos += 1.0;
-        else if (self->pointerPos >= 1)
-            self->pointerPos -= 1.0;
-    }
+    Granulator_pointer_a(self, pit);
+    Granulator_grains(self, pos, 1, dur, 1);
 }
 
 static void Granulator_postprocessing_ii(Granulator *self) { POST_PROCESSING_II };
@@ -771,10 +390,8 @@ static void
 Granulator_dealloc(Granulator* self)
 {
     pyo_DEALLOC
-    PyMem_RawFree(self->startPos);
-    PyMem_RawFree(self->gphase);
-    PyMem_RawFree(self->gsize);
-    PyMem_RawFree(self->lastppos);
+    PyMem_RawFree(self->grains);
+    PyMem_RawFree(self->pointer);
     Granulator_clear(self);
     Py_TYPE(self->stream)->tp_free((PyObject*)self->stream);
     Py_TYPE(self)->tp_free((PyObject*)self);
@@ -806,6 +423,10 @@ Granulator_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     Stream_setFunctionPtr(self->stream, Granulator_compute_next_data_frame);
     self->mode_func_ptr = Granulator_setProcMode;
 
+    self->pointer = (MYFLT *)PyMem_RawMalloc(3 * self->bufsize * sizeof(MYFLT));
+    self->phases = self->pointer + self->bufsize;
+    self->indexes = self->pointer + 2 * self->bufsize;
+
     static char *kwlist[] = {"table", "env", "pitch", "pos", "dur", "grains", "basedur", "mul", "add", NULL};
 
     if (! PyArg_ParseTupleAndKeywords(args, kwds, TYPE_OO_OOOIFOO, kwlist, &tabletmp, &envtmp, &pitchtmp, &postmp, &durtmp, &self->ngrains, &self->basedur, &multmp, &addtmp))
@@ -855,10 +476,7 @@ Granulator_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     PyObject_CallMethod(self->server, "addStream", "O", self->stream);
 
-    self->startPos = (MYFLT *)PyMem_RawRealloc(self->startPos, self->ngrains * sizeof(MYFLT));
-    self->gsize = (MYFLT *)PyMem_RawRealloc(self->gsize, self->ngrains * sizeof(MYFLT));
-    self->gphase = (MYFLT *)PyMem_RawRealloc(self->gphase, self->ngrains * sizeof(MYFLT));
-    self->lastppos = (MYFLT *)PyMem_RawRealloc(self->lastppos, self->ngrains * sizeof(MYFLT));
+    Granulator_alloc_grains(self);
 
     Server_generateSeed((Server *)self->server, GRANULATOR_ID);
 
@@ -917,8 +535,10 @@ Granulator_setTable(Granulator *self, PyObject *arg)
 {
     ASSERT_ARG_NOT_NULL
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->table);
     self->table = PyObject_CallMethod((PyObject *)arg, "getTableStream", "");
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -935,8 +555,10 @@ Granulator_setEnv(Granulator *self, PyObject *arg)
 {
     ASSERT_ARG_NOT_NULL
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->env);
     self->env = PyObject_CallMethod((PyObject *)arg, "getTableStream", "");
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -959,10 +581,7 @@ Granulator_setGrains(Granulator *self, PyObject *arg)
     if (PyLong_Check(arg))
     {
         self->ngrains = PyLong_AsLong(arg);
-        self->startPos = (MYFLT *)PyMem_RawRealloc(self->startPos, self->ngrains * sizeof(MYFLT));
-        self->gsize = (MYFLT *)PyMem_RawRealloc(self->gsize, self->ngrains * sizeof(MYFLT));
-        self->gphase = (MYFLT *)PyMem_RawRealloc(self->gphase, self->ngrains * sizeof(MYFLT));
-        self->lastppos = (MYFLT *)PyMem_RawRealloc(self->lastppos, self->ngrains * sizeof(MYFLT));
+        Granulator_alloc_grains(self);
 
         for (i = 0; i < self->ngrains; i++)
         {
@@ -2094,6 +1713,7 @@ Looper_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, Looper_compute_next_data_frame);
+    Stream_setNeedGIL(self->stream, 1);
     self->mode_func_ptr = Looper_setProcMode;
 
     static char *kwlist[] = {"table", "pitch", "start", "dur", "xfade", "mode", "xfadeshape", "startfromloop", "interp", "autosmooth", "mul", "add", NULL};
@@ -2202,8 +1822,10 @@ Looper_setTable(Looper *self, PyObject *arg)
 {
     ASSERT_ARG_NOT_NULL
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->table);
     self->table = PyObject_CallMethod((PyObject *)arg, "getTableStream", "");
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -2702,7 +2324,8 @@ PyTypeObject LooperTimeStreamType =
     LooperTimeStream_new,                 /* tp_new */
 };
 
-static const MYFLT Granule_MAX_GRAINS = 4096;
+/* Default maximum number of grains playing at once. */
+static const int Granule_MAX_GRAINS = 4096;
 typedef struct
 {
     pyo_audio_HEAD
@@ -2720,8 +2343,9 @@ typedef struct
     MYFLT *glen;
     MYFLT *inc;
     MYFLT *phase;
-    int *flags;
-    int num;
+    int active; /* Playing grains are packed in [0, active) of the grain arrays. */
+    int maxgrains;
+    unsigned long dropped; /* Grains not started because maxgrains were already playing. */
     int sync;
     double timer;
     MYFLT oneOnSr;
@@ -2729,13 +2353,74 @@ typedef struct
     int modebuffer[6];
 } Granule;
 
+static void
+Granule_startGrain(Granule *self, int i, T_SIZE_T size)
+{
+    int j;
+    MYFLT pit, pos, dur;
+
+    if (self->active >= self->maxgrains)
+    {
+        self->dropped++;
+        return;
+    }
+
+    j = self->active;
+
+    if (self->modebuffer[3] == 0)
+        pit = PyFloat_AS_DOUBLE(self->pitch);
+    else
+        pit = Stream_getData((Stream *)self->pitch_stream)[i];
+
+    if (self->modebuffer[4] == 0)
+        pos = PyFloat_AS_DOUBLE(self->pos);
+    else
+        pos = Stream_getData((Stream *)self->pos_stream)[i];
+
+    if (self->modebuffer[5] == 0)
+        dur = PyFloat_AS_DOUBLE(self->dur);
+    else
+        dur = Stream_getData((Stream *)self->dur_stream)[i];
+
+    if (pit < 0.0)
+        pit = -pit;
+
+    if (pos < 0.0)
+        pos = 0.0;
+    else if (pos >= size)
+        pos = (MYFLT)size;
+
+    if (dur < 0.0001)
+        dur = 0.0001;
+
+    self->gpos[j] = pos;
+    self->glen[j] = dur * self->sr * pit;
+    self->phase[j] = 0.0;
+    self->inc[j] = 1.0 / (dur * self->sr);
+
+    /* A grain reading outside the table is never started. */
+    if (!((pos + self->glen[j]) >= size || (pos + self->glen[j]) < 0))
+        self->active++;
+}
+
+/* Removes grain j by moving the last playing grain into its slot. */
+static void
+Granule_retire(Granule *self, int j)
+{
+    int last = --self->active;
+
+    self->gpos[j] = self->gpos[last];
+    self->glen[j] = self->glen[last];
+    self->inc[j] = self->inc[last];
+    self->phase[j] = self->phase[last];
+}
+
 static void
 Granule_transform_i(Granule *self)
 {
     MYFLT dens, inc, index, amp, phase;
     int i, j, flag = 0;
     T_SIZE_T ipart;
-    MYFLT pit = 0, pos = 0, dur = 0;
 
     MYFLT *tablelist = TableStream_getData((TableStream *)self->table);
     T_SIZE_T size = TableStream_getSize((TableStream *)self->table);
@@ -2774,76 +2459,27 @@ Granule_transform_i(Granule *self)
 
         /* need to start a new grain */
         if (flag)
-        {
-            for (j = 0; j < Granule_MAX_GRAINS; j++)
-            {
-                if (self->flags[j] == 0)
-                {
-                    self->flags[j] = 1;
-
-                    if (j >= self->num)
-                        self->num = j + 1;
-
-                    if (self->modebuffer[3] == 0)
-                        pit = PyFloat_AS_DOUBLE(self->pitch);
-                    else
-                        pit = Stream_getData((Stream *)self->pitch_stream)[i];
-
-                    if (self->modebuffer[4] == 0)
-                        pos = PyFloat_AS_DOUBLE(self->pos);
-                    else
-                        pos = Stream_getData((Stream *)self->pos_stream)[i];
-
-                    if (self->modebuffer[5] == 0)
-                        dur = PyFloat_AS_DOUBLE(self->dur);
-                    else
-                        dur = Stream_getData((Stream *)self->dur_stream)[i];
-
-                    if (pit < 0.0)
-                        pit = -pit;
-
-                    if (pos < 0.0)
-                        pos = 0.0;
-                    else if (pos >= size)
-                        pos = (MYFLT)size;
-
-                    if (dur < 0.0001)
-                        dur = 0.0001;
-
-                    self->gpos[j] = pos;
-                    self->glen[j] = dur * self->sr * pit;
-
-                    if ((pos + self->glen[j]) >= size || (pos + self->glen[j]) < 0)
-                        self->flags[j] = 0;
-
-                    self->phase[j] = 0.0;
-                    self->inc[j] = 1.0 / (dur * self->sr);
-                    break;
-                }
-            }
-        }
+            Granule_startGrain(self, i, size);
 
         /* compute active grains */
-        for (j = 0; j < self->num; j++)
+        for (j = 0; j < self->active; j++)
         {
-            if (self->flags[j])
-            {
-                phase = self->phase[j];
-                /* compute envelope */
-                index = phase * envsize;
-                ipart = (T_SIZE_T)index;
-                amp = envlist[ipart] + (envlist[ipart + 1] - envlist[ipart]) * (index - ipart);
-                /* compute sampling */
-                index = phase * self->glen[j] + self->gpos[j];
-                ipart = (T_SIZE_T)index;
-                self->data[i] += (tablelist[ipart] + (tablelist[ipart + 1] - tablelist[ipart]) * (index - ipart)) * amp;
-                phase += self->inc[j];
+            phase = self->phase[j];
+            /* compute envelope */
+            index = phase * envsize;
+            ipart = (T_SIZE_T)index;
+            amp = envlist[ipart] + (envlist[ipart + 1] - envlist[ipart]) * (index - ipart);
+            /* compute sampling */
+            index = phase * self->glen[j] + self->gpos[j];
+            ipart = (T_SIZE_T)index;
+            self->data[i] += (tablelist[ipart] + (tablelist[ipart + 1] - tablelist[ipart]) * (index - ipart)) * amp;
+            phase += self->inc[j];
 
-                if (phase >= 1.0)
-                    self->flags[j] = 0;
-                else
-                    self->phase[j] = phase;
-            }
+
+            if (phase >= 1.0)
+                Granule_retire(self, j--);
+            else
+                self->phase[j] = phase;
         }
 
         flag = 0;
@@ -2856,7 +2492,6 @@ Granule_transform_a(Granule *self)
     MYFLT index, amp, phase;
     int i, j, flag = 0;
     T_SIZE_T ipart;
-    MYFLT pit = 0, pos = 0, dur = 0;
 
     MYFLT *tablelist = TableStream_getData((TableStream *)self->table);
     T_SIZE_T size = TableStream_getSize((TableStream *)self->table);
@@ -2890,81 +2525,32 @@ Granule_transform_a(Granule *self)
 
         /* need to start a new grain */
         if (flag)
-        {
-            for (j = 0; j < Granule_MAX_GRAINS; j++)
-            {
-                if (self->flags[j] == 0)
-                {
-                    self->flags[j] = 1;
+            Granule_startGrain(self, i, size);
 
-                    if (j >= self->num)
-                        self->num = j + 1;
-
-                    if (self->modebuffer[3] == 0)
-                        pit = PyFloat_AS_DOUBLE(self->pitch);
-                    else
-                        pit = Stream_getData((Stream *)self->pitch_stream)[i];
+        /* compute active grains */
+        for (j = 0; j < self->active; j++)
+        {
+            phase = self->phase[j];
+            // compute envelope
+            index = phase * envsize;
+            ipart = (T_SIZE_T)index;
+            amp = envlist[ipart] + (envlist[ipart + 1] - envlist[ipart]) * (index - ipart);
+            // compute sampling
+            index = phase * self->glen[j] + self->gpos[j];
+            ipart = (T_SIZE_T)index;
+            self->data[i] += (tablelist[ipart] + (tablelist[ipart + 1] - tablelist[ipart]) * (index - ipart)) * amp;
+            phase += self->inc[j];
 
-                    if (self->modebuffer[4] == 0)
-                        pos = PyFloat_AS_DOUBLE(self->pos);
-                    else
-                        pos = Stream_getData((Stream *)self->pos_stream)[i];
 
-                    if (self->modebuffer[5] == 0)
-                        dur = PyFloat_AS_DOUBLE(self->dur);
-                    else
-                        dur = Stream_getData((Stream *)self->dur_stream)[i];
+            if (phase >= 1.0)
+                Granule_retire(self, j--);
+            else
+                self->phase[j] = phase;
+        }
 
-                    if (pit < 0.0)
-                        pit = -pit;
-
-                    if (pos < 0.0)
-                        pos = 0.0;
-                    else if (pos >= size)
-                        pos = (MYFLT)size;
-
-                    if (dur < 0.0001)
-                        dur = 0.0001;
-
-                    self->gpos[j] = pos;
-                    self->glen[j] = dur * self->sr * pit;
-
-                    if ((pos + self->glen[j]) >= size || (pos + self->glen[j]) < 0)
-                        self->flags[j] = 0;
-
-                    self->phase[j] = 0.0;
-                    self->inc[j] = 1.0 / (dur * self->sr);
-                    break;
-                }
-            }
-        }
-
-        /* compute active grains */
-        for (j = 0; j < self->num; j++)
-        {
-            if (self->flags[j])
-            {
-                phase = self->phase[j];
-                // compute envelope
-                index = phase * envsize;
-                ipart = (T_SIZE_T)index;
-                amp = envlist[ipart] + (envlist[ipart + 1] - envlist[ipart]) * (index - ipart);
-                // compute sampling
-                index = phase * self->glen[j] + self->gpos[j];
-                ipart = (T_SIZE_T)index;
-                self->data[i] += (tablelist[ipart] + (tablelist[ipart + 1] - tablelist[ipart]) * (index - ipart)) * amp;
-                phase += self->inc[j];
-
-                if (phase >= 1.0)
-                    self->flags[j] = 0;
-                else
-                    self->phase[j] = phase;
-            }
-        }
-
-        flag = 0;
-    }
-}
+        flag = 0;
+    }
+}
 
 static void Granule_postprocessing_ii(Granule *self) { POST_PROCESSING_II };
 static void Granule_postprocessing_ai(Granule *self) { POST_PROCESSING_AI };
@@ -3070,13 +2656,21 @@ Granule_dealloc(Granule* self)
     PyMem_RawFree(self->gpos);
     PyMem_RawFree(self->glen);
     PyMem_RawFree(self->inc);
-    PyMem_RawFree(self->flags);
     PyMem_RawFree(self->phase);
     Granule_clear(self);
     Py_TYPE(self->stream)->tp_free((PyObject*)self->stream);
     Py_TYPE(self)->tp_free((PyObject*)self);
 }
 
+static void
+Granule_alloc_grains(Granule *self)
+{
+    self->gpos = (MYFLT *)PyMem_RawRealloc(self->gpos, self->maxgrains * sizeof(MYFLT));
+    self->glen = (MYFLT *)PyMem_RawRealloc(self->glen, self->maxgrains * sizeof(MYFLT));
+    self->inc = (MYFLT *)PyMem_RawRealloc(self->inc, self->maxgrains * sizeof(MYFLT));
+    self->phase = (MYFLT *)PyMem_RawRealloc(self->phase, self->maxgrains * sizeof(MYFLT));
+}
+
 static PyObject *
 Granule_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 {
@@ -3090,7 +2684,9 @@ Granule_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->pos = PyFloat_FromDouble(0.0);
     self->dur = PyFloat_FromDouble(0.1);
     self->timer = 1.0;
-    self->num = 0;
+    self->active = 0;
+    self->maxgrains = Granule_MAX_GRAINS;
+    self->dropped = 0;
     self->sync = 1;
     self->modebuffer[0] = 0;
     self->modebuffer[1] = 0;
@@ -3105,6 +2701,7 @@ Granule_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->srOnRandMax = self->sr / (MYFLT)PYO_RAND_MAX;
 
     Stream_setFunctionPtr(self->stream, Granule_compute_next_data_frame);
+    Stream_setSerial(self->stream, 1);
     self->mode_func_ptr = Granule_setProcMode;
 
     static char *kwlist[] = {"table", "env", "dens", "pitch", "pos", "dur", "mul", "add", NULL};
@@ -3160,17 +2757,7 @@ Granule_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     PyObject_CallMethod(self->server, "addStream", "O", self->stream);
 
-    self->gpos = (MYFLT *)PyMem_RawRealloc(self->gpos, Granule_MAX_GRAINS * sizeof(MYFLT));
-    self->glen = (MYFLT *)PyMem_RawRealloc(self->glen, Granule_MAX_GRAINS * sizeof(MYFLT));
-    self->inc = (MYFLT *)PyMem_RawRealloc(self->inc, Granule_MAX_GRAINS * sizeof(MYFLT));
-    self->phase = (MYFLT *)PyMem_RawRealloc(self->phase, Granule_MAX_GRAINS * sizeof(MYFLT));
-    self->flags = (int *)PyMem_RawRealloc(self->flags, Granule_MAX_GRAINS * sizeof(int));
-
-    for (i = 0; i < Granule_MAX_GRAINS; i++)
-    {
-        self->gpos[i] = self->glen[i] = self->inc[i] = self->phase[i] = 0.0;
-        self->flags[i] = 0;
-    }
+    Granule_alloc_grains(self);
 
     Server_generateSeed((Server *)self->server, GRANULE_ID);
 
@@ -3216,8 +2803,10 @@ Granule_setTable(Granule *self, PyObject *arg)
 {
     ASSERT_ARG_NOT_NULL
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->table);
     self->table = PyObject_CallMethod((PyObject *)arg, "getTableStream", "");
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -3234,8 +2823,10 @@ Granule_setEnv(Granule *self, PyObject *arg)
 {
     ASSERT_ARG_NOT_NULL
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->env);
     self->env = PyObject_CallMethod((PyObject *)arg, "getTableStream", "");
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -3256,6 +2847,35 @@ Granule_setSync(Granule *self, PyObject *arg)
     Py_RETURN_NONE;
 }
 
+static PyObject *
+Granule_setMaxGrains(Granule *self, PyObject *arg)
+{
+    int max;
+
+    if (PyLong_Check(arg))
+    {
+        max = PyLong_AsLong(arg);
+
+        if (max < 1)
+            max = 1;
+
+        /* Grains beyond the new maximum are cut off. */
+        if (self->active > max)
+        {
+            self->dropped += self->active - max;
+            self->active = max;
+        }
+
+        self->maxgrains = max;
+        Granule_alloc_grains(self);
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject * Granule_getActiveGrains(Granule *self) { return PyLong_FromLong(self->active); }
+static PyObject * Granule_getDroppedGrains(Granule *self) { return PyLong_FromUnsignedLong(self->dropped); }
+
 static PyMemberDef Granule_members[] =
 {
     {"server", T_OBJECT_EX, offsetof(Granule, server), 0, "Pyo server."},
@@ -3287,6 +2907,9 @@ static PyMethodDef Granule_methods[] =
     {"setPos", (PyCFunction)Granule_setPos, METH_O, "Sets position in the sound table."},
     {"setDur", (PyCFunction)Granule_setDur, METH_O, "Sets the grain duration."},
     {"setSync", (PyCFunction)Granule_setSync, METH_O, "Sets the granulator mode: synchronous or asynchronous."},
+    {"setMaxGrains", (PyCFunction)Granule_setMaxGrains, METH_O, "Sets the maximum number of grains playing at once."},
+    {"getActiveGrains", (PyCFunction)Granule_getActiveGrains, METH_NOARGS, "Returns the number of grains currently playing."},
+    {"getDroppedGrains", (PyCFunction)Granule_getDroppedGrains, METH_NOARGS, "Returns the number of grains not started because the maximum was reached."},
     {"setMul", (PyCFunction)Granule_setMul, METH_O, "Sets Granule mul factor."},
     {"setAdd", (PyCFunction)Granule_setAdd, METH_O, "Sets Granule add factor."},
     {"setSub", (PyCFunction)Granule_setSub, METH_O, "Sets inverse add factor."},
@@ -3374,7 +2997,8 @@ PyTypeObject GranuleType =
     Granule_new,                 /* tp_new */
 };
 
-static const MYFLT MAINPARTICLE_MAX_GRAINS = 4096;
+/* Default maximum number of grains playing at once. */
+static const int MAINPARTICLE_MAX_GRAINS = 4096;
 typedef struct
 {
     pyo_audio_HEAD
@@ -3398,10 +3022,11 @@ typedef struct
     MYFLT *phase;
     MYFLT *amp1;
     MYFLT *amp2;
-    int *flags;
     int *k1;
     int *k2;
-    int num;
+    int active; /* Playing grains are packed in [0, active) of the grain arrays. */
+    int maxgrains;
+    unsigned long dropped; /* Grains not started because maxgrains were already playing. */
     int chnls;
     double timer;
     double devFactor;
@@ -3413,264 +3038,127 @@ typedef struct
 } MainParticle;
 
 static void
-MainParticle_transform_mono_i(MainParticle *self)
+MainParticle_startGrain(MainParticle *self, int i, T_SIZE_T size)
 {
-    MYFLT dens, inc, index, amp, phase, val;
-    int i, j, flag = 0;
-    T_SIZE_T ipart;
-    MYFLT pit = 0, pos = 0, dur = 0, dev = 0;
+    int j, l, l1;
+    MYFLT pit, pos, dur, dev, pan, min = 0;
 
-    MYFLT *tablelist = TableStream_getData((TableStream *)self->table);
-    T_SIZE_T size = TableStream_getSize((TableStream *)self->table);
-
-    MYFLT *envlist = TableStream_getData((TableStream *)self->env);
-    T_SIZE_T envsize = TableStream_getSize((TableStream *)self->env);
-
-    dens = PyFloat_AS_DOUBLE(self->dens);
-
-    if (dens < 0.0)
-        dens = 0.0;
-
-    inc = dens * self->oneOnSr * self->devFactor;
-
-    for (i = 0; i < self->bufsize * self->chnls; i++)
+    if (self->active >= self->maxgrains)
     {
-        self->buffer_streams[i] = 0.0;
+        self->dropped++;
+        return;
     }
 
-    for (i = 0; i < self->bufsize; i++)
-    {
-        self->timer += inc;
-
-        if (self->timer >= 1.0)
-        {
-            self->timer -= 1.0;
-            flag = 1;
-        }
-
-        /* need to start a new grain */
-        if (flag)
-        {
-            for (j = 0; j < MAINPARTICLE_MAX_GRAINS; j++)
-            {
-                if (self->flags[j] == 0)
-                {
-                    self->flags[j] = 1;
-
-                    if (j >= self->num)
-                        self->num = j + 1;
-
-                    if (self->modebuffer[1] == 0)
-                        pit = PyFloat_AS_DOUBLE(self->pitch);
-                    else
-                        pit = Stream_getData((Stream *)self->pitch_stream)[i];
-
-                    if (self->modebuffer[2] == 0)
-                        pos = PyFloat_AS_DOUBLE(self->pos);
-                    else
-                        pos = Stream_getData((Stream *)self->pos_stream)[i];
+    j = self->active;
 
-                    if (self->modebuffer[3] == 0)
-                        dur = PyFloat_AS_DOUBLE(self->dur);
-                    else
-                        dur = Stream_getData((Stream *)self->dur_stream)[i];
-
-                    if (self->modebuffer[4] == 0)
-                        dev = PyFloat_AS_DOUBLE(self->dev);
-                    else
-                        dev = Stream_getData((Stream *)self->dev_stream)[i];
-
-                    if (pit < 0.0)
-                        pit = -pit;
-
-                    if (pos < 0.0)
-                        pos = 0.0;
-                    else if (pos >= size)
-                        pos = (MYFLT)size;
-
-                    if (dur < 0.0001)
-                        dur = 0.0001;
-
-                    if (dev < 0.0)
-                        dev = 0.0;
-                    else if (dev > 1.0)
-                        dev = 1.0;
-
-                    self->gpos[j] = pos;
-                    self->glen[j] = dur * self->sr * pit * self->srScale;
-
-                    if ((pos + self->glen[j]) >= size || (pos + self->glen[j]) < 0)
-                        self->flags[j] = 0;
+    if (self->modebuffer[1] == 0)
+        pit = PyFloat_AS_DOUBLE(self->pitch);
+    else
+        pit = Stream_getData((Stream *)self->pitch_stream)[i];
 
-                    self->phase[j] = 0.0;
-                    self->inc[j] = 1.0 / (dur * self->sr);
-                    self->devFactor = (RANDOM_UNIFORM * 2.0 - 1.0) * dev + 1.0;
-                    break;
-                }
-            }
-        }
+    if (self->modebuffer[2] == 0)
+        pos = PyFloat_AS_DOUBLE(self->pos);
+    else
+        pos = Stream_getData((Stream *)self->pos_stream)[i];
 
-        /* compute active grains */
-        for (j = 0; j < self->num; j++)
-        {
-            if (self->flags[j])
-            {
-                phase = self->phase[j];
-                /* compute envelope */
-                index = phase * envsize;
-                ipart = (T_SIZE_T)index;
-                amp = envlist[ipart] + (envlist[ipart + 1] - envlist[ipart]) * (index - ipart);
-                /* compute sampling */
-                index = phase * self->glen[j] + self->gpos[j];
-                ipart = (T_SIZE_T)index;
-                val = (tablelist[ipart] + (tablelist[ipart + 1] - tablelist[ipart]) * (index - ipart)) * amp;
-                self->buffer_streams[i] += val;
-                phase += self->inc[j];
+    if (self->modebuffer[3] == 0)
+        dur = PyFloat_AS_DOUBLE(self->dur);
+    else
+        dur = Stream_getData((Stream *)self->dur_stream)[i];
 
-                if (phase >= 1.0)
-                    self->flags[j] = 0;
-                else
-                    self->phase[j] = phase;
-            }
-        }
+    if (self->modebuffer[4] == 0)
+        dev = PyFloat_AS_DOUBLE(self->dev);
+    else
+        dev = Stream_getData((Stream *)self->dev_stream)[i];
 
-        flag = 0;
-    }
-}
+    if (pit < 0.0)
+        pit = -pit;
 
-static void
-MainParticle_transform_mono_a(MainParticle *self)
-{
-    MYFLT dens, index, amp, phase, val;
-    int i, j, flag = 0;
-    T_SIZE_T ipart;
-    MYFLT pit = 0, pos = 0, dur = 0, dev = 0;
+    if (pos < 0.0)
+        pos = 0.0;
+    else if (pos >= size)
+        pos = (MYFLT)size;
 
-    MYFLT *tablelist = TableStream_getData((TableStream *)self->table);
-    T_SIZE_T size = TableStream_getSize((TableStream *)self->table);
+    if (dur < 0.0001)
+        dur = 0.0001;
 
-    MYFLT *envlist = TableStream_getData((TableStream *)self->env);
-    T_SIZE_T envsize = TableStream_getSize((TableStream *)self->env);
+    if (dev < 0.0)
+        dev = 0.0;
+    else if (dev > 1.0)
+        dev = 1.0;
 
-    MYFLT *density = Stream_getData((Stream *)self->dens_stream);
+    self->gpos[j] = pos;
+    self->glen[j] = dur * self->sr * pit * self->srScale;
+    self->phase[j] = 0.0;
+    self->inc[j] = 1.0 / (dur * self->sr);
+    self->devFactor = (RANDOM_UNIFORM * 2.0 - 1.0) * dev + 1.0;
 
-    for (i = 0; i < self->bufsize * self->chnls; i++)
+    if (self->chnls > 1)
     {
-        self->buffer_streams[i] = 0.0;
-    }
-
-    for (i = 0; i < self->bufsize; i++)
-    {
-        if (density[i] < 0.0)
-            dens = 0.0;
+        if (self->modebuffer[5] == 0)
+            pan = PyFloat_AS_DOUBLE(self->pan);
         else
-            dens = density[i];
+            pan = Stream_getData((Stream *)self->pan_stream)[i];
 
-        self->timer += dens * self->oneOnSr * self->devFactor;
+        if (pan < 0.0)
+            pan = 0.0;
+        else if (pan > 1.0)
+            pan = 1.0;
 
-        if (self->timer >= 1.0)
-        {
-            self->timer -= 1.0;
-            flag = 1;
-        }
+        self->amp1[j] = MYSQRT(1.0 - pan);
+        self->amp2[j] = MYSQRT(pan);
+        self->k1[j] = 0;
+        self->k2[j] = self->bufsize;
 
-        /* need to start a new grain */
-        if (flag)
+        if (self->chnls > 2)
         {
-            for (j = 0; j < MAINPARTICLE_MAX_GRAINS; j++)
+            for (l = self->chnls; l > 0; l--)
             {
-                if (self->flags[j] == 0)
-                {
-                    self->flags[j] = 1;
-
-                    if (j >= self->num)
-                        self->num = j + 1;
+                l1 = l - 1;
+                min = l1 / (MYFLT)self->chnls;
 
-                    if (self->modebuffer[1] == 0)
-                        pit = PyFloat_AS_DOUBLE(self->pitch);
-                    else
-                        pit = Stream_getData((Stream *)self->pitch_stream)[i];
-
-                    if (self->modebuffer[2] == 0)
-                        pos = PyFloat_AS_DOUBLE(self->pos);
-                    else
-                        pos = Stream_getData((Stream *)self->pos_stream)[i];
-
-                    if (self->modebuffer[3] == 0)
-                        dur = PyFloat_AS_DOUBLE(self->dur);
-                    else
-                        dur = Stream_getData((Stream *)self->dur_stream)[i];
+                if (pan > min)
+                {
+                    self->k1[j] = l1 * self->bufsize;
 
-                    if (self->modebuffer[4] == 0)
-                        dev = PyFloat_AS_DOUBLE(self->dev);
+                    if (l == self->chnls)
+                        self->k2[j] = 0;
                     else
-                        dev = Stream_getData((Stream *)self->dev_stream)[i];
-
-                    if (pit < 0.0)
-                        pit = -pit;
-
-                    if (pos < 0.0)
-                        pos = 0.0;
-                    else if (pos >= size)
-                        pos = (MYFLT)size;
-
-                    if (dur < 0.0001)
-                        dur = 0.0001;
-
-                    if (dev < 0.0)
-                        dev = 0.0;
-                    else if (dev > 1.0)
-                        dev = 1.0;
+                        self->k2[j] = l * self->bufsize;
 
-                    self->gpos[j] = pos;
-                    self->glen[j] = dur * self->sr * pit * self->srScale;
-
-                    if ((pos + self->glen[j]) >= size || (pos + self->glen[j]) < 0)
-                        self->flags[j] = 0;
-
-                    self->phase[j] = 0.0;
-                    self->inc[j] = 1.0 / (dur * self->sr);
-                    self->devFactor = (RANDOM_UNIFORM * 2.0 - 1.0) * dev + 1.0;
                     break;
                 }
             }
         }
+    }
 
-        /* compute active grains */
-        for (j = 0; j < self->num; j++)
-        {
-            if (self->flags[j])
-            {
-                phase = self->phase[j];
-                /* compute envelope */
-                index = phase * envsize;
-                ipart = (T_SIZE_T)index;
-                amp = envlist[ipart] + (envlist[ipart + 1] - envlist[ipart]) * (index - ipart);
-                /* compute sampling */
-                index = phase * self->glen[j] + self->gpos[j];
-                ipart = (T_SIZE_T)index;
-                val = (tablelist[ipart] + (tablelist[ipart + 1] - tablelist[ipart]) * (index - ipart)) * amp;
-                self->buffer_streams[i] += val;
-                phase += self->inc[j];
-
-                if (phase >= 1.0)
-                    self->flags[j] = 0;
-                else
-                    self->phase[j] = phase;
-            }
-        }
+    /* A grain reading outside the table is never started. */
+    if (!((pos + self->glen[j]) >= size || (pos + self->glen[j]) < 0))
+        self->active++;
+}
 
-        flag = 0;
-    }
+/* Removes grain j by moving the last playing grain into its slot. */
+static void
+MainParticle_retire(MainParticle *self, int j)
+{
+    int last = --self->active;
+
+    self->gpos[j] = self->gpos[last];
+    self->glen[j] = self->glen[last];
+    self->inc[j] = self->inc[last];
+    self->phase[j] = self->phase[last];
+    self->amp1[j] = self->amp1[last];
+    self->amp2[j] = self->amp2[last];
+    self->k1[j] = self->k1[last];
+    self->k2[j] = self->k2[last];
 }
 
 static void
-MainParticle_transform_i(MainParticle *self)
+MainParticle_transform_mono_i(MainParticle *self)
 {
-    MYFLT dens, inc, index, amp, phase, val, min = 0;
-    int i, j, l, l1, flag = 0;
+    MYFLT dens, inc, index, amp, phase, val;
+    int i, j, flag = 0;
     T_SIZE_T ipart;
-    MYFLT pit = 0, pos = 0, dur = 0, dev = 0, pan = 0;
 
     MYFLT *tablelist = TableStream_getData((TableStream *)self->table);
     T_SIZE_T size = TableStream_getSize((TableStream *)self->table);
@@ -3692,144 +3180,38 @@ MainParticle_transform_i(MainParticle *self)
 
     for (i = 0; i < self->bufsize; i++)
     {
-        self->timer += inc;
-
-        if (self->timer >= 1.0)
-        {
-            self->timer -= 1.0;
-            flag = 1;
-        }
-
-        /* need to start a new grain */
-        if (flag)
-        {
-            for (j = 0; j < MAINPARTICLE_MAX_GRAINS; j++)
-            {
-                if (self->flags[j] == 0)
-                {
-                    self->flags[j] = 1;
-
-                    if (j >= self->num)
-                        self->num = j + 1;
-
-                    if (self->modebuffer[1] == 0)
-                        pit = PyFloat_AS_DOUBLE(self->pitch);
-                    else
-                        pit = Stream_getData((Stream *)self->pitch_stream)[i];
-
-                    if (self->modebuffer[2] == 0)
-                        pos = PyFloat_AS_DOUBLE(self->pos);
-                    else
-                        pos = Stream_getData((Stream *)self->pos_stream)[i];
-
-                    if (self->modebuffer[3] == 0)
-                        dur = PyFloat_AS_DOUBLE(self->dur);
-                    else
-                        dur = Stream_getData((Stream *)self->dur_stream)[i];
-
-                    if (self->modebuffer[4] == 0)
-                        dev = PyFloat_AS_DOUBLE(self->dev);
-                    else
-                        dev = Stream_getData((Stream *)self->dev_stream)[i];
-
-                    if (self->modebuffer[5] == 0)
-                        pan = PyFloat_AS_DOUBLE(self->pan);
-                    else
-                        pan = Stream_getData((Stream *)self->pan_stream)[i];
-
-                    if (pit < 0.0)
-                        pit = -pit;
-
-                    if (pos < 0.0)
-                        pos = 0.0;
-                    else if (pos >= size)
-                        pos = (MYFLT)size;
-
-                    if (dur < 0.0001)
-                        dur = 0.0001;
-
-                    if (dev < 0.0)
-                        dev = 0.0;
-                    else if (dev > 1.0)
-                        dev = 1.0;
-
-                    if (pan < 0.0)
-                        pan = 0.0;
-                    else if (pan > 1.0)
-                        pan = 1.0;
-
-                    self->gpos[j] = pos;
-                    self->glen[j] = dur * self->sr * pit * self->srScale;
-
-                    if ((pos + self->glen[j]) >= size || (pos + self->glen[j]) < 0)
-                        self->flags[j] = 0;
-
-                    self->phase[j] = 0.0;
-                    self->inc[j] = 1.0 / (dur * self->sr);
-                    self->devFactor = (RANDOM_UNIFORM * 2.0 - 1.0) * dev + 1.0;
-
-                    if (self->chnls == 2)
-                    {
-                        self->k1[j] = 0;
-                        self->k2[j] = self->bufsize;
-                        self->amp1[j] = MYSQRT(1.0 - pan);
-                        self->amp2[j] = MYSQRT(pan);
-                    }
-                    else
-                    {
-                        self->amp1[j] = MYSQRT(1.0 - pan);
-                        self->amp2[j] = MYSQRT(pan);
-                        min = 0;
-                        self->k1[j] = 0;
-                        self->k2[j] = self->bufsize;
-
-                        for (l = self->chnls; l > 0; l--)
-                        {
-                            l1 = l - 1;
-                            min = l1 / (MYFLT)self->chnls;
-
-                            if (pan > min)
-                            {
-                                self->k1[j] = l1 * self->bufsize;
-
-                                if (l == self->chnls)
-                                    self->k2[j] = 0;
-                                else
-                                    self->k2[j] = l * self->bufsize;
-
-                                break;
-                            }
-                        }
-                    }
+        self->timer += inc;
 
-                    break;
-                }
-            }
+        if (self->timer >= 1.0)
+        {
+            self->timer -= 1.0;
+            flag = 1;
         }
 
+        /* need to start a new grain */
+        if (flag)
+            MainParticle_startGrain(self, i, size);
+
         /* compute active grains */
-        for (j = 0; j < self->num; j++)
+        for (j = 0; j < self->active; j++)
         {
-            if (self->flags[j])
-            {
-                phase = self->phase[j];
-                /* compute envelope */
-                index = phase * envsize;
-                ipart = (T_SIZE_T)index;
-                amp = envlist[ipart] + (envlist[ipart + 1] - envlist[ipart]) * (index - ipart);
-                /* compute sampling */
-                index = phase * self->glen[j] + self->gpos[j];
-                ipart = (T_SIZE_T)index;
-                val = (tablelist[ipart] + (tablelist[ipart + 1] - tablelist[ipart]) * (index - ipart)) * amp;
-                self->buffer_streams[i + self->k1[j]] += val * self->amp1[j];
-                self->buffer_streams[i + self->k2[j]] += val * self->amp2[j];
-                phase += self->inc[j];
+            phase = self->phase[j];
+            /* compute envelope */
+            index = phase * envsize;
+            ipart = (T_SIZE_T)index;
+            amp = envlist[ipart] + (envlist[ipart + 1] - envlist[ipart]) * (index - ipart);
+            /* compute sampling */
+            index = phase * self->glen[j] + self->gpos[j];
+            ipart = (T_SIZE_T)index;
+            val = (tablelist[ipart] + (tablelist[ipart + 1] - tablelist[ipart]) * (index - ipart)) * amp;
+            self->buffer_streams[i] += val;
+            phase += self->inc[j];
 
-                if (phase >= 1.0)
-                    self->flags[j] = 0;
-                else
-                    self->phase[j] = phase;
-            }
+
+            if (phase >= 1.0)
+                MainParticle_retire(self, j--);
+            else
+                self->phase[j] = phase;
         }
 
         flag = 0;
@@ -3837,12 +3219,11 @@ MainParticle_transform_i(MainParticle *self)
 }
 
 static void
-MainParticle_transform_a(MainParticle *self)
+MainParticle_transform_mono_a(MainParticle *self)
 {
-    MYFLT dens, index, amp, phase, val, min = 0;
-    int i, j, l, l1, flag = 0;
+    MYFLT dens, index, amp, phase, val;
+    int i, j, flag = 0;
     T_SIZE_T ipart;
-    MYFLT pit = 0, pos = 0, dur = 0, dev = 0, pan = 0;
 
     MYFLT *tablelist = TableStream_getData((TableStream *)self->table);
     T_SIZE_T size = TableStream_getSize((TableStream *)self->table);
@@ -3874,134 +3255,160 @@ MainParticle_transform_a(MainParticle *self)
 
         /* need to start a new grain */
         if (flag)
+            MainParticle_startGrain(self, i, size);
+
+        /* compute active grains */
+        for (j = 0; j < self->active; j++)
         {
-            for (j = 0; j < MAINPARTICLE_MAX_GRAINS; j++)
-            {
-                if (self->flags[j] == 0)
-                {
-                    self->flags[j] = 1;
+            phase = self->phase[j];
+            /* compute envelope */
+            index = phase * envsize;
+            ipart = (T_SIZE_T)index;
+            amp = envlist[ipart] + (envlist[ipart + 1] - envlist[ipart]) * (index - ipart);
+            /* compute sampling */
+            index = phase * self->glen[j] + self->gpos[j];
+            ipart = (T_SIZE_T)index;
+            val = (tablelist[ipart] + (tablelist[ipart + 1] - tablelist[ipart]) * (index - ipart)) * amp;
+            self->buffer_streams[i] += val;
+            phase += self->inc[j];
 
-                    if (j >= self->num)
-                        self->num = j + 1;
 
-                    if (self->modebuffer[1] == 0)
-                        pit = PyFloat_AS_DOUBLE(self->pitch);
-                    else
-                        pit = Stream_getData((Stream *)self->pitch_stream)[i];
+            if (phase >= 1.0)
+                MainParticle_retire(self, j--);
+            else
+                self->phase[j] = phase;
+        }
 
-                    if (self->modebuffer[2] == 0)
-                        pos = PyFloat_AS_DOUBLE(self->pos);
-                    else
-                        pos = Stream_getData((Stream *)self->pos_stream)[i];
+        flag = 0;
+    }
+}
 
-                    if (self->modebuffer[3] == 0)
-                        dur = PyFloat_AS_DOUBLE(self->dur);
-                    else
-                        dur = Stream_getData((Stream *)self->dur_stream)[i];
+static void
+MainParticle_transform_i(MainParticle *self)
+{
+    MYFLT dens, inc, index, amp, phase, val;
+    int i, j, flag = 0;
+    T_SIZE_T ipart;
 
-                    if (self->modebuffer[4] == 0)
-                        dev = PyFloat_AS_DOUBLE(self->dev);
-                    else
-                        dev = Stream_getData((Stream *)self->dev_stream)[i];
+    MYFLT *tablelist = TableStream_getData((TableStream *)self->table);
+    T_SIZE_T size = TableStream_getSize((TableStream *)self->table);
 
-                    if (self->modebuffer[5] == 0)
-                        pan = PyFloat_AS_DOUBLE(self->pan);
-                    else
-                        pan = Stream_getData((Stream *)self->pan_stream)[i];
+    MYFLT *envlist = TableStream_getData((TableStream *)self->env);
+    T_SIZE_T envsize = TableStream_getSize((TableStream *)self->env);
 
-                    if (pit < 0.0)
-                        pit = -pit;
+    dens = PyFloat_AS_DOUBLE(self->dens);
 
-                    if (pos < 0.0)
-                        pos = 0.0;
-                    else if (pos >= size)
-                        pos = (MYFLT)size;
+    if (dens < 0.0)
+        dens = 0.0;
 
-                    if (dur < 0.0001)
-                        dur = 0.0001;
+    inc = dens * self->oneOnSr * self->devFactor;
 
-                    if (dev < 0.0)
-                        dev = 0.0;
-                    else if (dev > 1.0)
-                        dev = 1.0;
+    for (i = 0; i < self->bufsize * self->chnls; i++)
+    {
+        self->buffer_streams[i] = 0.0;
+    }
 
-                    if (pan < 0.0)
-                        pan = 0.0;
-                    else if (pan > 1.0)
-                        pan = 1.0;
+    for (i = 0; i < self->bufsize; i++)
+    {
+        self->timer += inc;
 
-                    self->gpos[j] = pos;
-                    self->glen[j] = dur * self->sr * pit * self->srScale;
+        if (self->timer >= 1.0)
+        {
+            self->timer -= 1.0;
+            flag = 1;
+        }
 
-                    if ((pos + self->glen[j]) >= size || (pos + self->glen[j]) < 0)
-                        self->flags[j] = 0;
+        /* need to start a new grain */
+        if (flag)
+            MainParticle_startGrain(self, i, size);
 
-                    self->phase[j] = 0.0;
-                    self->inc[j] = 1.0 / (dur * self->sr);
-                    self->devFactor = (RANDOM_UNIFORM * 2.0 - 1.0) * dev + 1.0;
+        /* compute active grains */
+        for (j = 0; j < self->active; j++)
+        {
+            phase = self->phase[j];
+            /* compute envelope */
+            index = phase * envsize;
+            ipart = (T_SIZE_T)index;
+            amp = envlist[ipart] + (envlist[ipart + 1] - envlist[ipart]) * (index - ipart);
+            /* compute sampling */
+            index = phase * self->glen[j] + self->gpos[j];
+            ipart = (T_SIZE_T)index;
+            val = (tablelist[ipart] + (tablelist[ipart + 1] - tablelist[ipart]) * (index - ipart)) * amp;
+            self->buffer_streams[i + self->k1[j]] += val * self->amp1[j];
+            self->buffer_streams[i + self->k2[j]] += val * self->amp2[j];
+            phase += self->inc[j];
 
-                    if (self->chnls == 2)
-                    {
-                        self->k1[j] = 0;
-                        self->k2[j] = self->bufsize;
-                        self->amp1[j] = MYSQRT(1.0 - pan);
-                        self->amp2[j] = MYSQRT(pan);
-                    }
-                    else
-                    {
-                        self->amp1[j] = MYSQRT(1.0 - pan);
-                        self->amp2[j] = MYSQRT(pan);
-                        min = 0;
-                        self->k1[j] = 0;
-                        self->k2[j] = self->bufsize;
 
-                        for (l = self->chnls; l > 0; l--)
-                        {
-                            l1 = l - 1;
-                            min = l1 / (MYFLT)self->chnls;
+            if (phase >= 1.0)
+                MainParticle_retire(self, j--);
+            else
+                self->phase[j] = phase;
+        }
 
-                            if (pan > min)
-                            {
-                                self->k1[j] = l1 * self->bufsize;
+        flag = 0;
+    }
+}
 
-                                if (l == self->chnls)
-                                    self->k2[j] = 0;
-                                else
-                                    self->k2[j] = l * self->bufsize;
+static void
+MainParticle_transform_a(MainParticle *self)
+{
+    MYFLT dens, index, amp, phase, val;
+    int i, j, flag = 0;
+    T_SIZE_T ipart;
 
-                                break;
-                            }
-                        }
-                    }
+    MYFLT *tablelist = TableStream_getData((TableStream *)self->table);
+    T_SIZE_T size = TableStream_getSize((TableStream *)self->table);
 
-                    break;
-                }
-            }
+    MYFLT *envlist = TableStream_getData((TableStream *)self->env);
+    T_SIZE_T envsize = TableStream_getSize((TableStream *)self->env);
+
+    MYFLT *density = Stream_getData((Stream *)self->dens_stream);
+
+    for (i = 0; i < self->bufsize * self->chnls; i++)
+    {
+        self->buffer_streams[i] = 0.0;
+    }
+
+    for (i = 0; i < self->bufsize; i++)
+    {
+        if (density[i] < 0.0)
+            dens = 0.0;
+        else
+            dens = density[i];
+
+        self->timer += dens * self->oneOnSr * self->devFactor;
+
+        if (self->timer >= 1.0)
+        {
+            self->timer -= 1.0;
+            flag = 1;
         }
 
+        /* need to start a new grain */
+        if (flag)
+            MainParticle_startGrain(self, i, size);
+
         /* compute active grains */
-        for (j = 0; j < self->num; j++)
+        for (j = 0; j < self->active; j++)
         {
-            if (self->flags[j])
-            {
-                phase = self->phase[j];
-                /* compute envelope */
-                index = phase * envsize;
-                ipart = (T_SIZE_T)index;
-                amp = envlist[ipart] + (envlist[ipart + 1] - envlist[ipart]) * (index - ipart);
-                /* compute sampling */
-                index = phase * self->glen[j] + self->gpos[j];
-                ipart = (T_SIZE_T)index;
-                val = (tablelist[ipart] + (tablelist[ipart + 1] - tablelist[ipart]) * (index - ipart)) * amp;
-                self->buffer_streams[i + self->k1[j]] += val * self->amp1[j];
-                self->buffer_streams[i + self->k2[j]] += val * self->amp2[j];
-                phase += self->inc[j];
+            phase = self->phase[j];
+            /* compute envelope */
+            index = phase * envsize;
+            ipart = (T_SIZE_T)index;
+            amp = envlist[ipart] + (envlist[ipart + 1] - envlist[ipart]) * (index - ipart);
+            /* compute sampling */
+            index = phase * self->glen[j] + self->gpos[j];
+            ipart = (T_SIZE_T)index;
+            val = (tablelist[ipart] + (tablelist[ipart + 1] - tablelist[ipart]) * (index - ipart)) * amp;
+            self->buffer_streams[i + self->k1[j]] += val * self->amp1[j];
+            self->buffer_streams[i + self->k2[j]] += val * self->amp2[j];
+            phase += self->inc[j];
 
-                if (phase >= 1.0)
-                    self->flags[j] = 0;
-                else
-                    self->phase[j] = phase;
-            }
+
+            if (phase >= 1.0)
+                MainParticle_retire(self, j--);
+            else
+                self->phase[j] = phase;
         }
 
         flag = 0;
@@ -4072,7 +3479,6 @@ MainParticle_dealloc(MainParticle* self)
     PyMem_RawFree(self->gpos);
     PyMem_RawFree(self->glen);
     PyMem_RawFree(self->inc);
-    PyMem_RawFree(self->flags);
     PyMem_RawFree(self->k1);
     PyMem_RawFree(self->k2);
     PyMem_RawFree(self->phase);
@@ -4084,6 +3490,19 @@ MainParticle_dealloc(MainParticle* self)
     Py_TYPE(self)->tp_free((PyObject*)self);
 }
 
+static void
+MainParticle_alloc_grains(MainParticle *self)
+{
+    self->gpos = (MYFLT *)PyMem_RawRealloc(self->gpos, self->maxgrains * sizeof(MYFLT));
+    self->glen = (MYFLT *)PyMem_RawRealloc(self->glen, self->maxgrains * sizeof(MYFLT));
+    self->inc = (MYFLT *)PyMem_RawRealloc(self->inc, self->maxgrains * sizeof(MYFLT));
+    self->phase = (MYFLT *)PyMem_RawRealloc(self->phase, self->maxgrains * sizeof(MYFLT));
+    self->amp1 = (MYFLT *)PyMem_RawRealloc(self->amp1, self->maxgrains * sizeof(MYFLT));
+    self->amp2 = (MYFLT *)PyMem_RawRealloc(self->amp2, self->maxgrains * sizeof(MYFLT));
+    self->k1 = (int *)PyMem_RawRealloc(self->k1, self->maxgrains * sizeof(int));
+    self->k2 = (int *)PyMem_RawRealloc(self->k2, self->maxgrains * sizeof(int));
+}
+
 MYFLT *
 MainParticle_getSamplesBuffer(MainParticle *self)
 {
@@ -4106,7 +3525,9 @@ MainParticle_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->pan = PyFloat_FromDouble(0.5);
     self->timer = self->devFactor = 1.0;
     self->srScale = 1.0;
-    self->num = 0;
+    self->active = 0;
+    self->maxgrains = MAINPARTICLE_MAX_GRAINS;
+    self->dropped = 0;
     self->chnls = 1;
     self->modebuffer[0] = 0;
     self->modebuffer[1] = 0;
@@ -4121,6 +3542,7 @@ MainParticle_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->srOnRandMax = self->sr / (MYFLT)PYO_RAND_MAX;
 
     Stream_setFunctionPtr(self->stream, MainParticle_compute_next_data_frame);
+    Stream_setSerial(self->stream, 1);
     self->mode_func_ptr = MainParticle_setProcMode;
 
     static char *kwlist[] = {"table", "env", "dens", "pitch", "pos", "dur", "dev", "pan", "chnls", NULL};
@@ -4180,21 +3602,7 @@ MainParticle_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     if (self->chnls < 1)
         self->chnls = 1;
 
-    self->gpos = (MYFLT *)PyMem_RawRealloc(self->gpos, MAINPARTICLE_MAX_GRAINS * sizeof(MYFLT));
-    self->glen = (MYFLT *)PyMem_RawRealloc(self->glen, MAINPARTICLE_MAX_GRAINS * sizeof(MYFLT));
-    self->inc = (MYFLT *)PyMem_RawRealloc(self->inc, MAINPARTICLE_MAX_GRAINS * sizeof(MYFLT));
-    self->phase = (MYFLT *)PyMem_RawRealloc(self->phase, MAINPARTICLE_MAX_GRAINS * sizeof(MYFLT));
-    self->amp1 = (MYFLT *)PyMem_RawRealloc(self->amp1, MAINPARTICLE_MAX_GRAINS * sizeof(MYFLT));
-    self->amp2 = (MYFLT *)PyMem_RawRealloc(self->amp2, MAINPARTICLE_MAX_GRAINS * sizeof(MYFLT));
-    self->flags = (int *)PyMem_RawRealloc(self->flags, MAINPARTICLE_MAX_GRAINS * sizeof(int));
-    self->k1 = (int *)PyMem_RawRealloc(self->k1, MAINPARTICLE_MAX_GRAINS * sizeof(int));
-    self->k2 = (int *)PyMem_RawRealloc(self->k2, MAINPARTICLE_MAX_GRAINS * sizeof(int));
-
-    for (i = 0; i < MAINPARTICLE_MAX_GRAINS; i++)
-    {
-        self->gpos[i] = self->glen[i] = self->inc[i] = self->phase[i] = self->amp1[i] = self->amp2[i] = 0.0;
-        self->flags[i] = self->k1[i] = self->k2[i] = 0;
-    }
+    MainParticle_alloc_grains(self);
 
     self->buffer_streams = (MYFLT *)PyMem_RawRealloc(self->buffer_streams, self->bufsize * self->chnls * sizeof(MYFLT));
 
@@ -4235,9 +3643,11 @@ MainParticle_setTable(MainParticle *self, PyObject *arg)
 {
     ASSERT_ARG_NOT_NULL
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->table);
     self->table = PyObject_CallMethod((PyObject *)arg, "getTableStream", "");
     self->srScale = TableStream_getSamplingRate((TableStream *)self->table) / self->sr;
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -4254,12 +3664,43 @@ MainParticle_setEnv(MainParticle *self, PyObject *arg)
 {
     ASSERT_ARG_NOT_NULL
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->env);
     self->env = PyObject_CallMethod((PyObject *)arg, "getTableStream", "");
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
 
+static PyObject *
+MainParticle_setMaxGrains(MainParticle *self, PyObject *arg)
+{
+    int max;
+
+    if (PyLong_Check(arg))
+    {
+        max = PyLong_AsLong(arg);
+
+        if (max < 1)
+            max = 1;
+
+        /* Grains beyond the new maximum are cut off. */
+        if (self->active > max)
+        {
+            self->dropped += self->active - max;
+            self->active = max;
+        }
+
+        self->maxgrains = max;
+        MainParticle_alloc_grains(self);
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject * MainParticle_getActiveGrains(MainParticle *self) { return PyLong_FromLong(self->active); }
+static PyObject * MainParticle_getDroppedGrains(MainParticle *self) { return PyLong_FromUnsignedLong(self->dropped); }
+
 static PyMemberDef MainParticle_members[] =
 {
     {"server", T_OBJECT_EX, offsetof(MainParticle, server), 0, "Pyo server."},
@@ -4291,6 +3732,9 @@ static PyMethodDef MainParticle_methods[] =
     {"setDur", (PyCFunction)MainParticle_setDur, METH_O, "Sets the grain duration."},
     {"setDev", (PyCFunction)MainParticle_setDev, METH_O, "Sets grain start point deviation factor."},
     {"setPan", (PyCFunction)MainParticle_setPan, METH_O, "Sets grain panning factor."},
+    {"setMaxGrains", (PyCFunction)MainParticle_setMaxGrains, METH_O, "Sets the maximum number of grains playing at once."},
+    {"getActiveGrains", (PyCFunction)MainParticle_getActiveGrains, METH_NOARGS, "Returns the number of grains currently playing."},
+    {"getDroppedGrains", (PyCFunction)MainParticle_getDroppedGrains, METH_NOARGS, "Returns the number of grains not started because the maximum was reached."},
     {NULL}  /* Sentinel */
 };
 
@@ -5725,6 +5169,7 @@ MainParticle2_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->filterfreq = PyFloat_FromDouble(self->nyquist);
 
     Stream_setFunctionPtr(self->stream, MainParticle2_compute_next_data_frame);
+    Stream_setSerial(self->stream, 1);
     self->mode_func_ptr = MainParticle2_setProcMode;
 
     static char *kwlist[] = {"table", "env", "dens", "pitch", "pos", "dur", "dev", "pan", "filterfreq", "filterq", "filtertype", "chnls", NULL};
@@ -5878,9 +5323,11 @@ MainParticle2_setTable(MainParticle2 *self, PyObject *arg)
 {
     ASSERT_ARG_NOT_NULL
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->table);
     self->table = PyObject_CallMethod((PyObject *)arg, "getTableStream", "");
     self->srScale = TableStream_getSamplingRate((TableStream *)self->table) / self->sr;
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -5897,8 +5344,10 @@ MainParticle2_setEnv(MainParticle2 *self, PyObject *arg)
 {
     ASSERT_ARG_NOT_NULL
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->env);
     self->env = PyObject_CallMethod((PyObject *)arg, "getTableStream", "");
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -202,7 +202,6 @@ HRTFData_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     /* Compute magnitudes and unwrapped phases for each impulse. */
     MYFLT re, im, ma, ph;
     int hsize = self->length / 2;
-    int n8 = self->length >> 3;
     MYFLT outframe[self->length];
 
     for (i = 0; i < self->length; i++)
@@ -217,12 +216,7 @@ HRTFData_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
         real[i] = imag[i] = magn[i] = freq[i] = 0.0;
     }
 
-    MYFLT **twiddle = (MYFLT **)PyMem_RawMalloc(4 * sizeof(MYFLT *));
-
-    for (i = 0; i < 4; i++)
-        twiddle[i] = (MYFLT *)PyMem_RawMalloc(n8 * sizeof(MYFLT));
-
-    fft_compute_split_twiddle(twiddle, self->length);
+    PyoFFTPlan *plan = fft_plan_acquire(self->length, PYO_FFT_REAL);
 
     self->mag_left = (MYFLT ***)PyMem_RawRealloc(self->mag_left, 14 * sizeof(MYFLT **));
     self->ang_left = (MYFLT ***)PyMem_RawRealloc(self->ang_left, 14 * sizeof(MYFLT **));
@@ -245,7 +239,7 @@ HRTFData_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
             self->ang_right[i][j] = (MYFLT *)PyMem_RawMalloc(hsize * sizeof(MYFLT));
 
             /* Left channel */
-            realfft_split(self->hrtf_left[i][j], outframe, self->length, twiddle);
+            fft_plan_forward(plan, self->hrtf_left[i][j], outframe);
             real[0] = outframe[0];
             imag[0] = 0.0;
 
@@ -271,7 +265,7 @@ HRTFData_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
             }
 
             /* Right channel */
-            realfft_split(self->hrtf_right[i][j], outframe, self->length, twiddle);
+            fft_plan_forward(plan, self->hrtf_right[i][j], outframe);
             real[0] = outframe[0];
             imag[0] = 0.0;
 
@@ -298,12 +292,7 @@ HRTFData_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
         }
     }
 
-    for (i = 0; i < 4; i++)
-    {
-        PyMem_RawFree(twiddle[i]);
-    }
-
-    PyMem_RawFree(twiddle);
+    fft_plan_release(plan);
 
     return (PyObject *)self;
 }
@@ -382,7 +371,7 @@ typedef struct
     MYFLT *hrtf_input_tmp;
     MYFLT **current_impulses;
     MYFLT **previous_impulses;
-    MYFLT **twiddle;
+    PyoFFTPlan *plan;
     int modebuffer[2];
     MYFLT *buffer_streams;
 } HRTFSpatter;
@@ -544,8 +533,8 @@ HRTFSpatter_splitter(HRTFSpatter *self)
                 inframeR[self->length - k] = imagR[k];
             }
 
-            irealfft_split(inframeL, self->current_impulses[0], self->length, self->twiddle);
-            irealfft_split(inframeR, self->current_impulses[1], self->length, self->twiddle);
+            fft_plan_inverse(self->plan, inframeL, self->current_impulses[0]);
+            fft_plan_inverse(self->plan, inframeR, self->current_impulses[1]);
         }
 
         tmp_count = self->hrtf_count;
@@ -644,12 +633,7 @@ HRTFSpatter_dealloc(HRTFSpatter* self)
     PyMem_RawFree(self->current_impulses);
     PyMem_RawFree(self->previous_impulses);
 
-    for (i = 0; i < 4; i++)
-    {
-        PyMem_RawFree(self->twiddle[i]);
-    }
-
-    PyMem_RawFree(self->twiddle);
+    fft_plan_release(self->plan);
     HRTFSpatter_clear(self);
     Py_TYPE(self->stream)->tp_free((PyObject*)self->stream);
     Py_TYPE(self)->tp_free((PyObject*)self);
@@ -727,13 +711,8 @@ HRTFSpatter_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
         self->hrtf_input_tmp[k] = 0.0;
     }
 
-    int n8 = self->length >> 3;
-    self->twiddle = (MYFLT **)PyMem_RawRealloc(self->twiddle, 4 * sizeof(MYFLT *));
-
-    for (i = 0; i < 4; i++)
-        self->twiddle[i] = (MYFLT *)PyMem_RawMalloc(n8 * sizeof(MYFLT));
-
-    fft_compute_split_twiddle(self->twiddle, self->length);
+    fft_plan_release(self->plan);
+    self->plan = fft_plan_acquire(self->length, PYO_FFT_REAL);
 
     (*self->mode_func_ptr)(self);
 
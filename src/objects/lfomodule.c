@@ -1365,6 +1365,7 @@ LFO_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->srOverFour = (MYFLT)self->sr * 0.25;
     self->srOverEight = (MYFLT)self->sr * 0.125;
     Stream_setFunctionPtr(self->stream, LFO_compute_next_data_frame);
+    Stream_setSerial(self->stream, 1);
     self->mode_func_ptr = LFO_setProcMode;
 
     static char *kwlist[] = {"freq", "sharp", "type", "mul", "add", NULL};
@@ -667,6 +667,7 @@ MatrixRec_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     INIT_OBJECT_COMMON
 
     Stream_setFunctionPtr(self->stream, MatrixRec_compute_next_data_frame);
+    Stream_setTableWriter(self->stream, 1);
 
     static char *kwlist[] = {"input", "matrix", "fadetime", "delay", NULL};
 
@@ -721,9 +722,11 @@ MatrixRec_setMatrix(MatrixRec *self, PyObject *arg)
 {
     ASSERT_ARG_NOT_NULL
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->matrix);
     self->matrix = (NewMatrix *)arg;
     Py_INCREF(self->matrix);
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -874,6 +877,7 @@ MatrixRecLoop_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     INIT_OBJECT_COMMON
 
     Stream_setFunctionPtr(self->stream, MatrixRecLoop_compute_next_data_frame);
+    Stream_setTableWriter(self->stream, 1);
 
     static char *kwlist[] = {"input", "matrix", NULL};
 
@@ -912,9 +916,11 @@ MatrixRecLoop_setMatrix(MatrixRecLoop *self, PyObject *arg)
 {
     ASSERT_ARG_NOT_NULL
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->matrix);
     self->matrix = (NewMatrix *)arg;
     Py_INCREF(self->matrix);
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -1085,6 +1091,8 @@ MatrixMorph_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     INIT_OBJECT_COMMON
 
     Stream_setFunctionPtr(self->stream, MatrixMorph_compute_next_data_frame);
+    Stream_setTableWriter(self->stream, 1);
+    Stream_setNeedGIL(self->stream, 1);
 
     static char *kwlist[] = {"input", "matrix", "sources", NULL};
 
@@ -1120,9 +1128,11 @@ MatrixMorph_setMatrix(MatrixMorph *self, PyObject *arg)
 {
     ASSERT_ARG_NOT_NULL
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->matrix);
     self->matrix = (PyObject *)arg;
     Py_INCREF(self->matrix);
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -1139,8 +1149,10 @@ MatrixMorph_setSources(MatrixMorph *self, PyObject *arg)
     }
 
     Py_INCREF(arg);
+    Server_lockProcessing(self->server);
     Py_DECREF(self->sources);
     self->sources = arg;
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
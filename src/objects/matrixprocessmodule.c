@@ -242,8 +242,10 @@ MatrixPointer_setMatrix(MatrixPointer *self, PyObject *arg)
         Py_RETURN_NONE;
     }
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->matrix);
     self->matrix = PyObject_CallMethod((PyObject *)arg, "getMatrixStream", "");
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -259,6 +261,7 @@ MatrixPointer_setX(MatrixPointer *self, PyObject *arg)
         Py_RETURN_NONE;
     }
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->x);
 
     self->x = arg;
@@ -266,6 +269,8 @@ MatrixPointer_setX(MatrixPointer *self, PyObject *arg)
     PyObject *streamtmp = PyObject_CallMethod((PyObject *)self->x, "_getStream", NULL);
     self->x_stream = (Stream *)streamtmp;
     Py_INCREF(self->x_stream);
+    Stream_invalidateGraph();
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -281,6 +286,7 @@ MatrixPointer_setY(MatrixPointer *self, PyObject *arg)
         Py_RETURN_NONE;
     }
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->y);
 
     self->y = arg;
@@ -288,6 +294,8 @@ MatrixPointer_setY(MatrixPointer *self, PyObject *arg)
     PyObject *streamtmp = PyObject_CallMethod((PyObject *)self->y, "_getStream", NULL);
     self->y_stream = (Stream *)streamtmp;
     Py_INCREF(self->y_stream);
+    Stream_invalidateGraph();
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
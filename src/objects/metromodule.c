@@ -718,6 +718,7 @@ Seqer_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, Seqer_compute_next_data_frame);
+    Stream_setNeedGIL(self->stream, 1);
     self->mode_func_ptr = Seqer_setProcMode;
 
     Stream_setStreamActive(self->stream, 0);
@@ -1281,6 +1282,7 @@ Clouder_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, Clouder_compute_next_data_frame);
+    Stream_setSerial(self->stream, 1);
     self->mode_func_ptr = Clouder_setProcMode;
 
     Stream_setStreamActive(self->stream, 0);
@@ -2526,6 +2528,7 @@ Beater_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, Beater_compute_next_data_frame);
+    Stream_setNeedGIL(self->stream, 1);
     self->mode_func_ptr = Beater_setProcMode;
 
     self->sampleToSec = 1. / self->sr;
@@ -111,6 +111,7 @@ CtlScan_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, CtlScan_compute_next_data_frame);
+    Stream_setNeedGIL(self->stream, 1);
     self->mode_func_ptr = CtlScan_setProcMode;
 
     static char *kwlist[] = {"callable", "toprint", NULL};
@@ -318,6 +319,7 @@ CtlScan2_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, CtlScan2_compute_next_data_frame);
+    Stream_setNeedGIL(self->stream, 1);
     self->mode_func_ptr = CtlScan2_setProcMode;
 
     static char *kwlist[] = {"callable", "toprint", NULL};
@@ -3198,7 +3200,7 @@ static void
 MidiAdsr_generates(MidiAdsr *self)
 {
     MYFLT val;
-    int i;
+    int i, silent = 1;
 
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
 
@@ -3244,6 +3246,9 @@ MidiAdsr_generates(MidiAdsr *self)
                 val = 0.;
         }
 
+        if (val != 0)
+            silent = 0;
+
         self->buf[i] = val;
         self->currentTime += self->sampleToSec;
     }
@@ -3262,6 +3267,10 @@ MidiAdsr_generates(MidiAdsr *self)
             self->data[i] = self->buf[i];
         }
     }
+
+    /* Idle envelope, lets the objects it controls skip their processing. */
+    if (silent)
+        Stream_setState(self->stream, self->data[0] == 0 ? PYO_STREAM_SILENT : PYO_STREAM_CONSTANT);
 }
 
 static void MidiAdsr_postprocessing_ii(MidiAdsr *self) { POST_PROCESSING_II };
@@ -4193,6 +4202,7 @@ RawMidi_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, RawMidi_compute_next_data_frame);
+    Stream_setNeedGIL(self->stream, 1);
     self->mode_func_ptr = RawMidi_setProcMode;
 
     static char *kwlist[] = {"callable", NULL};
@@ -4569,6 +4579,7 @@ MidiLinseg_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, MidiLinseg_compute_next_data_frame);
+    Stream_setNeedGIL(self->stream, 1);
     self->mode_func_ptr = MidiLinseg_setProcMode;
 
     self->sampleToSec = 1. / self->sr;
@@ -4649,10 +4660,12 @@ MidiLinseg_setList(MidiLinseg *self, PyObject *value)
     }
 
     Py_INCREF(value);
+    Server_lockProcessing(self->server);
     Py_DECREF(self->pointslist);
     self->pointslist = value;
 
     self->newlist = 1;
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
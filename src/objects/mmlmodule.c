@@ -788,6 +788,7 @@ MMLMain_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, MMLMain_compute_next_data_frame);
+    Stream_setNeedGIL(self->stream, 1);
     self->mode_func_ptr = MMLMain_setProcMode;
 
     Stream_setStreamActive(self->stream, 0);
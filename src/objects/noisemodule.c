@@ -167,6 +167,7 @@ Noise_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, Noise_compute_next_data_frame);
+    Stream_setSerial(self->stream, 1);
     self->mode_func_ptr = Noise_setProcMode;
 
     static char *kwlist[] = {"mul", "add", NULL};
@@ -468,6 +469,7 @@ PinkNoise_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, PinkNoise_compute_next_data_frame);
+    Stream_setSerial(self->stream, 1);
     self->mode_func_ptr = PinkNoise_setProcMode;
 
     static char *kwlist[] = {"mul", "add", NULL};
@@ -740,6 +742,7 @@ BrownNoise_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, BrownNoise_compute_next_data_frame);
+    Stream_setSerial(self->stream, 1);
     self->mode_func_ptr = BrownNoise_setProcMode;
 
     static char *kwlist[] = {"mul", "add", NULL};
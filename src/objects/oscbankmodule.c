@@ -26,26 +26,12 @@
 #include "servermodule.h"
 #include "dummymodule.h"
 #include "tablemodule.h"
+#include "oscillatorbank.h"
 
 /*******************/
 /***** OscBank ******/
 /*******************/
 
-static MYFLT
-OscBank_clip(MYFLT x, int size)
-{
-    if (x >= size)
-    {
-        x -= (int)(x / size) * size;
-    }
-    else if (x < 0)
-    {
-        x += ((int)(-x / size) + 1) * size;
-    }
-
-    return x;
-}
-
 typedef struct
 {
     pyo_audio_HEAD
@@ -67,7 +53,8 @@ typedef struct
     int stages;
     int fjit;
     int modebuffer[9];
-    MYFLT *pointerPos;
+    OscillatorBank bank;
+    int started; /* The bank holds the increments and the amplitudes of the previous block. */
     MYFLT *frequencies;
     MYFLT lastFreq;
     MYFLT lastSpread;
@@ -163,10 +150,10 @@ OscBank_pickNewArnds(OscBank *self, MYFLT arndf, MYFLT arnda)
 static void
 OscBank_readframes(OscBank *self)
 {
-    MYFLT freq, spread, slope, frndf, frnda, arndf, arnda, amp, modamp, pos, inc, x, y, fpart;
-    int i, j, ipart;
+    MYFLT freq, spread, slope, frndf, frnda, arndf, arnda, amp, inc, modamp;
+    int i, j;
     MYFLT *tablelist = TableStream_getData((TableStream *)self->table);
-    int size = TableStream_getSize((TableStream *)self->table);
+    T_SIZE_T size = TableStream_getSize((TableStream *)self->table);
     MYFLT tabscl = size / self->sr;
 
     for (i = 0; i < self->bufsize; i++)
@@ -225,137 +212,57 @@ OscBank_readframes(OscBank *self)
         {
             for (i = 0; i < self->stages; i++)
             {
-                self->pointerPos[i] = 0.0;
+                self->bank.phase[i] = 0.0;
             }
         }
     }
 
-    if (frnda == 0.0 && arnda == 0.0)
+    if (frnda != 0.0 && self->ftime >= 1.0)
     {
-        amp = self->amplitude;
+        OscBank_pickNewFrnds(self, frndf, frnda);
+    }
 
-        for (j = 0; j < self->stages; j++)
-        {
-            inc = self->frequencies[j] * tabscl;
-            pos = self->pointerPos[j];
+    if (arnda != 0.0 && self->atime >= 1.0)
+    {
+        OscBank_pickNewArnds(self, arndf, arnda);
+    }
 
-            for (i = 0; i < self->bufsize; i++)
-            {
-                pos = OscBank_clip(pos, size);
-                ipart = (int)pos;
-                fpart = pos - ipart;
-                x = tablelist[ipart];
-                y = tablelist[ipart + 1];
-                self->data[i] += (x + (y - x) * fpart) * amp;
-                pos += inc;
-            }
+    amp = self->amplitude;
 
-            self->pointerPos[j] = pos;
-            amp *= slope;
-        }
-    }
-    else if (frnda != 0.0 && arnda != 0.0)
+    for (j = 0; j < self->stages; j++)
     {
-        if (self->ftime >= 1.0)
-        {
-            OscBank_pickNewFrnds(self, frndf, frnda);
-        }
+        inc = self->frequencies[j];
 
-        if (self->atime >= 1.0)
-        {
-            OscBank_pickNewArnds(self, arndf, arnda);
-        }
+        if (frnda != 0.0)
+            inc += self->fOldValues[j] + self->fDiffs[j] * self->ftime;
 
-        amp = self->amplitude;
+        inc *= tabscl;
 
-        for (j = 0; j < self->stages; j++)
-        {
-            inc = (self->frequencies[j] + (self->fOldValues[j] + self->fDiffs[j] * self->ftime)) * tabscl;
-            pos = self->pointerPos[j];
+        if (arnda == 0.0)
+            modamp = 1.0;
+        else
             modamp = (1.0 - arnda) + (self->aOldValues[j] + self->aDiffs[j] * self->atime);
 
-            for (i = 0; i < self->bufsize; i++)
-            {
-                pos = OscBank_clip(pos, size);
-                ipart = (int)pos;
-                fpart = pos - ipart;
-                x = tablelist[ipart];
-                y = tablelist[ipart + 1];
-                self->data[i] += (x + (y - x) * fpart) * amp * modamp;
-                pos += inc;
-            }
-
-            self->pointerPos[j] = pos;
-            amp *= slope;
-        }
+        /* With random deviations, the increments and the amplitudes move
+           linearly over the block, from the values of the previous block.
+           Without them, the oscillators take their new values at once. */
+        if (self->started && (frnda != 0.0 || arnda != 0.0))
+            OscillatorBank_rampTo(&self->bank, j, inc, amp * modamp, self->bufsize);
+        else
+            OscillatorBank_set(&self->bank, j, inc, amp * modamp);
 
-        self->ftime += self->finc;
-        self->atime += self->ainc;
+        amp *= slope;
     }
-    else if (frnda != 0.0 && arnda == 0.0)
-    {
-        if (self->ftime >= 1.0)
-        {
-            OscBank_pickNewFrnds(self, frndf, frnda);
-        }
 
-        amp = self->amplitude;
+    self->started = 1;
 
-        for (j = 0; j < self->stages; j++)
-        {
-            inc = (self->frequencies[j] + (self->fOldValues[j] + self->fDiffs[j] * self->ftime)) * tabscl;
-            pos = self->pointerPos[j];
-
-            for (i = 0; i < self->bufsize; i++)
-            {
-                pos = OscBank_clip(pos, size);
-                ipart = (int)pos;
-                fpart = pos - ipart;
-                x = tablelist[ipart];
-                y = tablelist[ipart + 1];
-                self->data[i] += (x + (y - x) * fpart) * amp;
-                pos += inc;
-            }
-
-            self->pointerPos[j] = pos;
-            amp *= slope;
-        }
+    OscillatorBank_process(&self->bank, self->stages, tablelist, size, self->data, self->bufsize);
 
+    if (frnda != 0.0)
         self->ftime += self->finc;
-    }
-    else if (frnda == 0.0 && arnda != 0.0)
-    {
-        if (self->atime >= 1.0)
-        {
-            OscBank_pickNewArnds(self, arndf, arnda);
-        }
-
-        amp = self->amplitude;
-
-        for (j = 0; j < self->stages; j++)
-        {
-            inc = self->frequencies[j] * tabscl;
-            pos = self->pointerPos[j];
-            modamp = (1.0 - arnda) + (self->aOldValues[j] + self->aDiffs[j] * self->atime);
-
-            for (i = 0; i < self->bufsize; i++)
-            {
-                pos = OscBank_clip(pos, size);
-                ipart = (int)pos;
-                fpart = pos - ipart;
-                x = tablelist[ipart];
-                y = tablelist[ipart + 1];
-                self->data[i] += (x + (y - x) * fpart) * amp * modamp;
-                pos += inc;
-            }
-
-            self->pointerPos[j] = pos;
-            amp *= slope;
-        }
 
+    if (arnda != 0.0)
         self->atime += self->ainc;
-    }
-
 }
 
 static void OscBank_postprocessing_ii(OscBank *self) { POST_PROCESSING_II };
@@ -455,7 +362,7 @@ static void
 OscBank_dealloc(OscBank* self)
 {
     pyo_DEALLOC
-    PyMem_RawFree(self->pointerPos);
+    OscillatorBank_free(&self->bank);
     PyMem_RawFree(self->frequencies);
     PyMem_RawFree(self->fOldValues);
     PyMem_RawFree(self->fValues);
@@ -504,6 +411,7 @@ OscBank_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     INIT_OBJECT_COMMON
 
     Stream_setFunctionPtr(self->stream, OscBank_compute_next_data_frame);
+    Stream_setSerial(self->stream, 1);
     self->mode_func_ptr = OscBank_setProcMode;
 
     static char *kwlist[] = {"table", "freq", "spread", "slope", "frndf", "frnda", "arndf", "arnda", "num", "fjit", "mul", "add", NULL};
@@ -568,7 +476,7 @@ OscBank_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     (*self->mode_func_ptr)(self);
 
-    self->pointerPos = (MYFLT *)PyMem_RawRealloc(self->pointerPos, self->stages * sizeof(MYFLT));
+    OscillatorBank_alloc(&self->bank, self->stages);
     self->frequencies = (MYFLT *)PyMem_RawRealloc(self->frequencies, self->stages * sizeof(MYFLT));
     self->fOldValues = (MYFLT *)PyMem_RawRealloc(self->fOldValues, self->stages * sizeof(MYFLT));
     self->fValues = (MYFLT *)PyMem_RawRealloc(self->fValues, self->stages * sizeof(MYFLT));
@@ -579,7 +487,7 @@ OscBank_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     for (i = 0; i < self->stages; i++)
     {
-        self->pointerPos[i] = self->frequencies[i] = self->fOldValues[i] = self->fValues[i] = self->fDiffs[i] = self->aOldValues[i] = self->aValues[i] = self->aDiffs[i] = 0.0;
+        self->frequencies[i] = self->fOldValues[i] = self->fValues[i] = self->fDiffs[i] = self->aOldValues[i] = self->aValues[i] = self->aDiffs[i] = 0.0;
     }
 
     self->amplitude = 1. / self->stages;
@@ -621,8 +529,10 @@ OscBank_setTable(OscBank *self, PyObject *arg)
 {
     ASSERT_ARG_NOT_NULL
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->table);
     self->table = PyObject_CallMethod((PyObject *)arg, "getTableStream", "");
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
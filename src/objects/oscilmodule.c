@@ -27,6 +27,7 @@
 #include "dummymodule.h"
 #include "tablemodule.h"
 #include "interpolation.h"
+#include "multichannel.h"
 
 static MYFLT SINE_ARRAY[513] = {0.0, 0.012271538285719925, 0.024541228522912288, 0.036807222941358832, 0.049067674327418015, 0.061320736302208578, 0.073564563599667426, 0.085797312344439894, 0.098017140329560604, 0.11022220729388306, 0.1224106751992162, 0.13458070850712617, 0.14673047445536175, 0.15885814333386145, 0.17096188876030122, 0.18303988795514095, 0.19509032201612825, 0.20711137619221856, 0.2191012401568698, 0.23105810828067111, 0.24298017990326387, 0.25486565960451457, 0.26671275747489837, 0.27851968938505306, 0.29028467725446233, 0.30200594931922808, 0.31368174039889152, 0.32531029216226293, 0.33688985339222005, 0.34841868024943456, 0.35989503653498811, 0.37131719395183754, 0.38268343236508978, 0.3939920400610481, 0.40524131400498986, 0.41642956009763715, 0.42755509343028208, 0.43861623853852766, 0.44961132965460654, 0.46053871095824001, 0.47139673682599764, 0.48218377207912272, 0.49289819222978404, 0.50353838372571758, 0.51410274419322166, 0.52458968267846895, 0.53499761988709715, 0.54532498842204646, 0.55557023301960218, 0.56573181078361312, 0.57580819141784534, 0.58579785745643886, 0.59569930449243336, 0.60551104140432555, 0.61523159058062682, 0.62485948814238634, 0.63439328416364549, 0.64383154288979139, 0.65317284295377676, 0.66241577759017178, 0.67155895484701833, 0.68060099779545302, 0.68954054473706683, 0.69837624940897292, 0.70710678118654746, 0.71573082528381859, 0.72424708295146689, 0.7326542716724127, 0.74095112535495899, 0.74913639452345926, 0.75720884650648446, 0.76516726562245885, 0.77301045336273688, 0.78073722857209438, 0.78834642762660623, 0.79583690460888346, 0.80320753148064483, 0.81045719825259477, 0.81758481315158371, 0.82458930278502529, 0.83146961230254512, 0.83822470555483797, 0.84485356524970701, 0.8513551931052652, 0.85772861000027212, 0.8639728561215867, 0.87008699110871135, 0.87607009419540649, 0.88192126434835494, 0.88763962040285393, 0.89322430119551532, 0.89867446569395382, 0.90398929312344334, 0.90916798309052238, 0.91420975570353069, 0.91911385169005777, 0.92387953251128674, 0.92850608047321548, 0.93299279883473885, 0.93733901191257496, 0.94154406518302081, 0.94560732538052128, 0.94952818059303667, 0.95330604035419375, 0.95694033573220894, 0.96043051941556579, 0.96377606579543984, 0.96697647104485207, 0.97003125319454397, 0.97293995220556007, 0.97570213003852857, 0.97831737071962765, 0.98078528040323043, 0.98310548743121629, 0.98527764238894122, 0.98730141815785843, 0.98917650996478101, 0.99090263542778001, 0.99247953459870997, 0.99390697000235606, 0.99518472667219682, 0.996312612182778, 0.99729045667869021, 0.99811811290014918, 0.99879545620517241, 0.99932238458834954, 0.99969881869620425, 0.9999247018391445, 1.0, 0.9999247018391445, 0.99969881869620425, 0.99932238458834954, 0.99879545620517241, 0.99811811290014918, 0.99729045667869021, 0.996312612182778, 0.99518472667219693, 0.99390697000235606, 0.99247953459870997, 0.99090263542778001, 0.98917650996478101, 0.98730141815785843, 0.98527764238894122, 0.98310548743121629, 0.98078528040323043, 0.97831737071962765, 0.97570213003852857, 0.97293995220556018, 0.97003125319454397, 0.96697647104485207, 0.96377606579543984, 0.9604305194155659, 0.95694033573220894, 0.95330604035419386, 0.94952818059303667, 0.94560732538052139, 0.94154406518302081, 0.93733901191257496, 0.93299279883473885, 0.92850608047321559, 0.92387953251128674, 0.91911385169005777, 0.91420975570353069, 0.90916798309052249, 0.90398929312344345, 0.89867446569395393, 0.89322430119551521, 0.88763962040285393, 0.88192126434835505, 0.8760700941954066, 0.87008699110871146, 0.86397285612158681, 0.85772861000027212, 0.8513551931052652, 0.84485356524970723, 0.83822470555483819, 0.83146961230254546, 0.82458930278502529, 0.81758481315158371, 0.81045719825259477, 0.80320753148064494, 0.79583690460888357, 0.78834642762660634, 0.7807372285720946, 0.7730104533627371, 0.76516726562245907, 0.75720884650648479, 0.74913639452345926, 0.74095112535495899, 0.73265427167241282, 0.724247082951467, 0.71573082528381871, 0.70710678118654757, 0.69837624940897292, 0.68954054473706705, 0.68060099779545324, 0.67155895484701855, 0.66241577759017201, 0.65317284295377664, 0.64383154288979139, 0.63439328416364549, 0.62485948814238634, 0.61523159058062693, 0.60551104140432555, 0.59569930449243347, 0.58579785745643898, 0.57580819141784545, 0.56573181078361345, 0.55557023301960218, 0.54532498842204635, 0.53499761988709715, 0.52458968267846895, 0.51410274419322177, 0.50353838372571758, 0.49289819222978415, 0.48218377207912289, 0.47139673682599781, 0.46053871095824023, 0.44961132965460687, 0.43861623853852755, 0.42755509343028203, 0.41642956009763715, 0.40524131400498986, 0.39399204006104815, 0.38268343236508984, 0.37131719395183765, 0.35989503653498833, 0.34841868024943479, 0.33688985339222027, 0.3253102921622632, 0.31368174039889141, 0.30200594931922803, 0.29028467725446233, 0.27851968938505312, 0.26671275747489848, 0.25486565960451468, 0.24298017990326404, 0.2310581082806713, 0.21910124015687002, 0.20711137619221884, 0.19509032201612858, 0.1830398879551409, 0.17096188876030119, 0.15885814333386145, 0.1467304744553618, 0.13458070850712628, 0.12241067519921635, 0.11022220729388325, 0.09801714032956084, 0.085797312344440158, 0.073564563599667745, 0.061320736302208495, 0.049067674327417973, 0.036807222941358832, 0.024541228522912326, 0.012271538285720007, 1.2246467991473532e-16, -0.012271538285719761, -0.024541228522912083, -0.036807222941358582, -0.049067674327417724, -0.061320736302208245, -0.073564563599667496, -0.085797312344439922, -0.09801714032956059, -0.110222207293883, -0.1224106751992161, -0.13458070850712606, -0.14673047445536158, -0.15885814333386122, -0.17096188876030097, -0.18303988795514067, -0.19509032201612836, -0.20711137619221862, -0.21910124015686983, -0.23105810828067111, -0.24298017990326382, -0.25486565960451446, -0.26671275747489825, -0.27851968938505289, -0.29028467725446216, -0.30200594931922781, -0.31368174039889118, -0.32531029216226304, -0.33688985339222011, -0.34841868024943456, -0.35989503653498811, -0.37131719395183749, -0.38268343236508967, -0.39399204006104793, -0.40524131400498969, -0.41642956009763693, -0.42755509343028181, -0.43861623853852733, -0.44961132965460665, -0.46053871095824006, -0.47139673682599764, -0.48218377207912272, -0.49289819222978393, -0.50353838372571746, -0.51410274419322155, -0.52458968267846873, -0.53499761988709693, -0.54532498842204613, -0.55557023301960196, -0.56573181078361323, -0.57580819141784534, -0.58579785745643886, -0.59569930449243325, -0.60551104140432543, -0.61523159058062671, -0.62485948814238623, -0.63439328416364527, -0.64383154288979128, -0.65317284295377653, -0.66241577759017178, -0.67155895484701844, -0.68060099779545302, -0.68954054473706683, -0.6983762494089728, -0.70710678118654746, -0.71573082528381848, -0.72424708295146667, -0.73265427167241259, -0.74095112535495877, -0.74913639452345904, -0.75720884650648423, -0.76516726562245885, -0.77301045336273666, -0.78073722857209438, -0.78834642762660589, -0.79583690460888334, -0.80320753148064505, -0.81045719825259466, -0.81758481315158371, -0.82458930278502507, -0.83146961230254524, -0.83822470555483775, -0.84485356524970712, -0.85135519310526486, -0.85772861000027201, -0.86397285612158647, -0.87008699110871135, -0.87607009419540671, -0.88192126434835494, -0.88763962040285405, -0.89322430119551521, -0.89867446569395382, -0.90398929312344312, -0.90916798309052238, -0.91420975570353047, -0.91911385169005766, -0.92387953251128652, -0.92850608047321548, -0.93299279883473896, -0.93733901191257485, -0.94154406518302081, -0.94560732538052117, -0.94952818059303667, -0.95330604035419375, -0.95694033573220882, -0.96043051941556568, -0.96377606579543984, -0.96697647104485218, -0.97003125319454397, -0.97293995220556018, -0.97570213003852846, -0.97831737071962765, -0.98078528040323032, -0.98310548743121629, -0.98527764238894111, -0.98730141815785832, -0.9891765099647809, -0.99090263542778001, -0.99247953459871008, -0.99390697000235606, -0.99518472667219693, -0.996312612182778, -0.99729045667869021, -0.99811811290014918, -0.99879545620517241, -0.99932238458834943, -0.99969881869620425, -0.9999247018391445, -1.0, -0.9999247018391445, -0.99969881869620425, -0.99932238458834954, -0.99879545620517241, -0.99811811290014918, -0.99729045667869021, -0.996312612182778, -0.99518472667219693, -0.99390697000235606, -0.99247953459871008, -0.99090263542778001, -0.9891765099647809, -0.98730141815785843, -0.98527764238894122, -0.9831054874312164, -0.98078528040323043, -0.97831737071962777, -0.97570213003852857, -0.97293995220556029, -0.97003125319454397, -0.96697647104485229, -0.96377606579543995, -0.96043051941556579, -0.95694033573220894, -0.95330604035419375, -0.94952818059303679, -0.94560732538052128, -0.94154406518302092, -0.93733901191257496, -0.93299279883473907, -0.92850608047321559, -0.92387953251128663, -0.91911385169005788, -0.91420975570353058, -0.90916798309052249, -0.90398929312344334, -0.89867446569395404, -0.89322430119551532, -0.88763962040285416, -0.88192126434835505, -0.87607009419540693, -0.87008699110871146, -0.8639728561215867, -0.85772861000027223, -0.85135519310526508, -0.84485356524970734, -0.83822470555483797, -0.83146961230254557, -0.82458930278502529, -0.81758481315158404, -0.81045719825259488, -0.80320753148064528, -0.79583690460888368, -0.78834642762660612, -0.78073722857209471, -0.77301045336273688, -0.76516726562245918, -0.75720884650648457, -0.7491363945234597, -0.74095112535495922, -0.73265427167241315, -0.72424708295146711, -0.71573082528381904, -0.70710678118654768, -0.69837624940897269, -0.68954054473706716, -0.68060099779545302, -0.67155895484701866, -0.66241577759017178, -0.65317284295377709, -0.6438315428897915, -0.63439328416364593, -0.62485948814238645, -0.61523159058062737, -0.60551104140432566, -0.59569930449243325, -0.58579785745643909, -0.57580819141784523, -0.56573181078361356, -0.55557023301960218, -0.5453249884220468, -0.53499761988709726, -0.52458968267846939, -0.51410274419322188, -0.50353838372571813, -0.49289819222978426, -0.48218377207912261, -0.47139673682599792, -0.46053871095823995, -0.44961132965460698, -0.43861623853852766, -0.42755509343028253, -0.41642956009763726, -0.40524131400499042, -0.39399204006104827, -0.38268343236509039, -0.37131719395183777, -0.359895036534988, -0.3484186802494349, -0.33688985339222, -0.32531029216226331, -0.31368174039889152, -0.30200594931922853, -0.29028467725446244, -0.27851968938505367, -0.26671275747489859, -0.25486565960451435, -0.24298017990326418, -0.23105810828067103, -0.21910124015687016, -0.20711137619221853, -0.19509032201612872, -0.18303988795514103, -0.17096188876030177, -0.15885814333386158, -0.14673047445536239, -0.13458070850712642, -0.12241067519921603, -0.11022220729388338, -0.09801714032956052, -0.085797312344440282, -0.073564563599667426, -0.06132073630220905, -0.049067674327418091, -0.036807222941359394, -0.024541228522912451, -0.012271538285720572, 0.0};
 static MYFLT COSINE_ARRAY[513] = {1.0, 0.9999247018391445, 0.9996988186962042, 0.9993223845883495, 0.9987954562051724, 0.9981181129001492, 0.9972904566786902, 0.996312612182778, 0.9951847266721969, 0.9939069700023561, 0.99247953459871, 0.99090263542778, 0.989176509964781, 0.9873014181578584, 0.9852776423889412, 0.9831054874312163, 0.9807852804032304, 0.9783173707196277, 0.9757021300385286, 0.9729399522055602, 0.970031253194544, 0.9669764710448521, 0.9637760657954398, 0.9604305194155658, 0.9569403357322088, 0.9533060403541939, 0.9495281805930367, 0.9456073253805213, 0.9415440651830208, 0.937339011912575, 0.932992798834739, 0.9285060804732156, 0.9238795325112867, 0.9191138516900578, 0.9142097557035307, 0.9091679830905224, 0.9039892931234433, 0.8986744656939538, 0.8932243011955153, 0.8876396204028539, 0.881921264348355, 0.8760700941954066, 0.8700869911087115, 0.8639728561215868, 0.8577286100002721, 0.8513551931052652, 0.8448535652497071, 0.8382247055548381, 0.8314696123025452, 0.8245893027850253, 0.8175848131515837, 0.8104571982525948, 0.8032075314806449, 0.7958369046088836, 0.7883464276266063, 0.7807372285720945, 0.773010453362737, 0.765167265622459, 0.7572088465064846, 0.7491363945234594, 0.7409511253549591, 0.7326542716724128, 0.724247082951467, 0.7157308252838186, 0.7071067811865476, 0.6983762494089729, 0.6895405447370669, 0.6806009977954531, 0.6715589548470183, 0.6624157775901718, 0.6531728429537768, 0.6438315428897915, 0.6343932841636455, 0.6248594881423865, 0.6152315905806268, 0.6055110414043255, 0.5956993044924335, 0.5857978574564389, 0.5758081914178453, 0.5657318107836132, 0.5555702330196023, 0.5453249884220465, 0.5349976198870973, 0.5245896826784688, 0.5141027441932217, 0.5035383837257176, 0.4928981922297841, 0.48218377207912283, 0.4713967368259978, 0.46053871095824, 0.4496113296546066, 0.4386162385385277, 0.4275550934302822, 0.4164295600976373, 0.40524131400498986, 0.3939920400610481, 0.38268343236508984, 0.3713171939518376, 0.3598950365349883, 0.3484186802494345, 0.33688985339222005, 0.325310292162263, 0.3136817403988916, 0.3020059493192282, 0.29028467725446233, 0.27851968938505306, 0.2667127574748984, 0.2548656596045146, 0.24298017990326398, 0.23105810828067128, 0.21910124015686977, 0.20711137619221856, 0.19509032201612833, 0.18303988795514106, 0.17096188876030136, 0.1588581433338614, 0.14673047445536175, 0.13458070850712622, 0.12241067519921628, 0.11022220729388318, 0.09801714032956077, 0.08579731234443988, 0.07356456359966745, 0.06132073630220865, 0.049067674327418126, 0.03680722294135899, 0.024541228522912264, 0.012271538285719944, 6.123031769111886e-17, -0.012271538285719823, -0.024541228522912142, -0.036807222941358866, -0.04906767432741801, -0.06132073630220853, -0.07356456359966733, -0.08579731234443976, -0.09801714032956065, -0.11022220729388306, -0.12241067519921615, -0.1345807085071261, -0.14673047445536164, -0.15885814333386128, -0.17096188876030124, -0.18303988795514092, -0.1950903220161282, -0.20711137619221845, -0.21910124015686966, -0.23105810828067114, -0.24298017990326387, -0.2548656596045145, -0.2667127574748983, -0.27851968938505295, -0.29028467725446216, -0.3020059493192281, -0.3136817403988914, -0.32531029216226287, -0.33688985339221994, -0.3484186802494344, -0.35989503653498817, -0.3713171939518375, -0.3826834323650897, -0.393992040061048, -0.40524131400498975, -0.416429560097637, -0.42755509343028186, -0.4386162385385274, -0.4496113296546067, -0.46053871095824006, -0.4713967368259977, -0.4821837720791227, -0.492898192229784, -0.5035383837257175, -0.5141027441932217, -0.5245896826784687, -0.534997619887097, -0.5453249884220462, -0.555570233019602, -0.5657318107836132, -0.5758081914178453, -0.5857978574564389, -0.5956993044924334, -0.6055110414043254, -0.6152315905806267, -0.6248594881423862, -0.6343932841636454, -0.6438315428897913, -0.6531728429537765, -0.6624157775901719, -0.6715589548470184, -0.680600997795453, -0.6895405447370669, -0.6983762494089728, -0.7071067811865475, -0.7157308252838186, -0.7242470829514668, -0.7326542716724127, -0.7409511253549589, -0.7491363945234591, -0.7572088465064846, -0.765167265622459, -0.773010453362737, -0.7807372285720945, -0.7883464276266062, -0.7958369046088835, -0.8032075314806448, -0.8104571982525947, -0.8175848131515836, -0.8245893027850251, -0.8314696123025453, -0.8382247055548381, -0.8448535652497071, -0.8513551931052652, -0.857728610000272, -0.8639728561215867, -0.8700869911087113, -0.8760700941954065, -0.8819212643483549, -0.8876396204028538, -0.8932243011955152, -0.8986744656939539, -0.9039892931234433, -0.9091679830905224, -0.9142097557035307, -0.9191138516900578, -0.9238795325112867, -0.9285060804732155, -0.9329927988347388, -0.9373390119125748, -0.9415440651830207, -0.9456073253805212, -0.9495281805930367, -0.9533060403541939, -0.9569403357322088, -0.9604305194155658,
@@ -84,6 +85,7 @@ Sine_readframes_ii(Sine *self)
 {
     MYFLT inc, fr, ph, pos;
     int i, ipart;
+    FUSED_MULADD_INIT
 
     fr = PyFloat_AS_DOUBLE(self->freq);
     ph = PyFloat_AS_DOUBLE(self->phase) * 512;
@@ -98,7 +100,7 @@ Sine_readframes_ii(Sine *self)
             pos -= 512;
 
         ipart = (int)pos;
-        self->data[i] = SINE_ARRAY[ipart] + (SINE_ARRAY[ipart + 1] - SINE_ARRAY[ipart]) * (pos - ipart);
+        self->data[i] = FUSED_MULADD(SINE_ARRAY[ipart] + (SINE_ARRAY[ipart + 1] - SINE_ARRAY[ipart]) * (pos - ipart));
         self->pointerPos += inc;
     }
 }
@@ -108,6 +110,7 @@ Sine_readframes_ai(Sine *self)
 {
     MYFLT inc, ph, pos, fac;
     int i, ipart;
+    FUSED_MULADD_INIT
 
     MYFLT *fr = Stream_getData((Stream *)self->freq_stream);
     ph = PyFloat_AS_DOUBLE(self->phase) * 512;
@@ -124,7 +127,7 @@ Sine_readframes_ai(Sine *self)
             pos -= 512;
 
         ipart = (int)pos;
-        self->data[i] = SINE_ARRAY[ipart] + (SINE_ARRAY[ipart + 1] - SINE_ARRAY[ipart]) * (pos - ipart);
+        self->data[i] = FUSED_MULADD(SINE_ARRAY[ipart] + (SINE_ARRAY[ipart + 1] - SINE_ARRAY[ipart]) * (pos - ipart));
         self->pointerPos += inc;
     }
 }
@@ -134,6 +137,7 @@ Sine_readframes_ia(Sine *self)
 {
     MYFLT inc, fr, pos;
     int i, ipart;
+    FUSED_MULADD_INIT
 
     fr = PyFloat_AS_DOUBLE(self->freq);
     MYFLT *ph = Stream_getData((Stream *)self->phase_stream);
@@ -148,7 +152,7 @@ Sine_readframes_ia(Sine *self)
             pos -= 512;
 
         ipart = (int)pos;
-        self->data[i] = SINE_ARRAY[ipart] + (SINE_ARRAY[ipart + 1] - SINE_ARRAY[ipart]) * (pos - ipart);
+        self->data[i] = FUSED_MULADD(SINE_ARRAY[ipart] + (SINE_ARRAY[ipart + 1] - SINE_ARRAY[ipart]) * (pos - ipart));
         self->pointerPos += inc;
     }
 }
@@ -158,6 +162,7 @@ Sine_readframes_aa(Sine *self)
 {
     MYFLT inc, pos, fac;
     int i, ipart;
+    FUSED_MULADD_INIT
 
     MYFLT *fr = Stream_getData((Stream *)self->freq_stream);
     MYFLT *ph = Stream_getData((Stream *)self->phase_stream);
@@ -174,12 +179,12 @@ Sine_readframes_aa(Sine *self)
             pos -= 512;
 
         ipart = (int)pos;
-        self->data[i] = SINE_ARRAY[ipart] + (SINE_ARRAY[ipart + 1] - SINE_ARRAY[ipart]) * (pos - ipart);
+        self->data[i] = FUSED_MULADD(SINE_ARRAY[ipart] + (SINE_ARRAY[ipart + 1] - SINE_ARRAY[ipart]) * (pos - ipart));
         self->pointerPos += inc;
     }
 }
 
-static void Sine_postprocessing_ii(Sine *self) { POST_PROCESSING_II };
+static void Sine_postprocessing_fused(Sine *self) {}; /* mul & add applied by the processing function */
 static void Sine_postprocessing_ai(Sine *self) { POST_PROCESSING_AI };
 static void Sine_postprocessing_ia(Sine *self) { POST_PROCESSING_IA };
 static void Sine_postprocessing_aa(Sine *self) { POST_PROCESSING_AA };
@@ -218,7 +223,7 @@ Sine_setProcMode(Sine *self)
     switch (muladdmode)
     {
         case 0:
-            self->muladd_func_ptr = Sine_postprocessing_ii;
+            self->muladd_func_ptr = Sine_postprocessing_fused;
             break;
 
         case 1:
@@ -255,10 +260,47 @@ Sine_setProcMode(Sine *self)
     }
 }
 
+/* Moves the phase as the processing functions do, without reading the
+   table, while the output is muted by the mul. */
+static void
+Sine_advance(Sine *self)
+{
+    MYFLT inc, fr, fac;
+    int i;
+
+    if (self->modebuffer[2] == 0)
+    {
+        fr = PyFloat_AS_DOUBLE(self->freq);
+        inc = fr * 512 / self->sr;
+
+        for (i = 0; i < self->bufsize; i++)
+        {
+            self->pointerPos = Sine_clip(self->pointerPos);
+            self->pointerPos += inc;
+        }
+    }
+    else
+    {
+        MYFLT *frs = Stream_getData((Stream *)self->freq_stream);
+        fac = 512 / self->sr;
+
+        for (i = 0; i < self->bufsize; i++)
+        {
+            inc = frs[i] * fac;
+            self->pointerPos = Sine_clip(self->pointerPos);
+            self->pointerPos += inc;
+        }
+    }
+}
+
 static void
 Sine_compute_next_data_frame(Sine *self)
 {
-    (*self->proc_func_ptr)(self);
+    if (MULADD_MUTED)
+        Sine_advance(self);
+    else
+        (*self->proc_func_ptr)(self);
+
     (*self->muladd_func_ptr)(self);
 }
 
@@ -308,6 +350,7 @@ Sine_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, Sine_compute_next_data_frame);
+    Stream_setShareable(self->stream, 1);
     self->mode_func_ptr = Sine_setProcMode;
 
     static char *kwlist[] = {"freq", "phase", "mul", "add", NULL};
@@ -481,6 +524,329 @@ PyTypeObject SineType =
 };
 
 
+/* SineMulti object, computes all the channels of a Sine (see multichannel.h) */
+typedef struct
+{
+    pyo_multi_HEAD
+    MultiParam freq;
+    MultiParam phase;
+    MYFLT *pointerPos;
+} SineMulti;
+
+/* Channels first to first+lanes-1, freq and phase given as floats. */
+static void
+SineMulti_readframes_lanes(SineMulti *self, int first, int lanes)
+{
+    MYFLT inc[PYO_MULTI_LANES], ph[PYO_MULTI_LANES], pp[PYO_MULTI_LANES], pos;
+    int i, j, ipart;
+    MYFLT *out = self->buffer_streams + first * self->bufsize;
+
+    for (j = 0; j < lanes; j++)
+    {
+        inc[j] = self->freq.values[first + j] * 512 / self->sr;
+        ph[j] = self->phase.values[first + j] * 512;
+        pp[j] = self->pointerPos[first + j];
+    }
+
+    for (i = 0; i < self->bufsize; i++)
+    {
+        for (j = 0; j < lanes; j++)
+        {
+            pp[j] = Sine_clip(pp[j]);
+            pos = pp[j] + ph[j];
+
+            if (pos >= 512)
+                pos -= 512;
+
+            ipart = (int)pos;
+            out[j * self->bufsize + i] = SINE_ARRAY[ipart] + (SINE_ARRAY[ipart + 1] - SINE_ARRAY[ipart]) * (pos - ipart);
+            pp[j] += inc[j];
+        }
+    }
+
+    for (j = 0; j < lanes; j++)
+        self->pointerPos[first + j] = pp[j];
+}
+
+/* One channel with at least one audio parameter, same computation as Sine. */
+static void
+SineMulti_readframes_chnl(SineMulti *self, int chnl)
+{
+    MYFLT inc = 0, ph = 0, pos, fac;
+    int i, ipart;
+    MYFLT *out = self->buffer_streams + chnl * self->bufsize;
+    Stream *fr_stream = self->freq.streams[chnl];
+    Stream *ph_stream = self->phase.streams[chnl];
+    MYFLT *fr = fr_stream != NULL ? Stream_getData(fr_stream) : NULL;
+    MYFLT *pha = ph_stream != NULL ? Stream_getData(ph_stream) : NULL;
+    MYFLT pointerPos = self->pointerPos[chnl];
+
+    fac = 512 / self->sr;
+
+    if (fr == NULL)
+        inc = self->freq.values[chnl] * 512 / self->sr;
+
+    if (pha == NULL)
+        ph = self->phase.values[chnl] * 512;
+
+    for (i = 0; i < self->bufsize; i++)
+    {
+        if (fr != NULL)
+            inc = fr[i] * fac;
+
+        pointerPos = Sine_clip(pointerPos);
+        pos = pointerPos + (pha != NULL ? pha[i] * 512 : ph);
+
+        if (pos >= 512)
+            pos -= 512;
+
+        ipart = (int)pos;
+        out[i] = SINE_ARRAY[ipart] + (SINE_ARRAY[ipart + 1] - SINE_ARRAY[ipart]) * (pos - ipart);
+        pointerPos += inc;
+    }
+
+    self->pointerPos[chnl] = pointerPos;
+}
+
+/* Moves the phase of one channel as the processing functions do, without
+   reading the table, while the channel is muted by its mul. */
+static void
+SineMulti_advance(SineMulti *self, int chnl)
+{
+    MYFLT inc, fac;
+    int i;
+    Stream *fr_stream = self->freq.streams[chnl];
+    MYFLT pointerPos = self->pointerPos[chnl];
+
+    if (fr_stream == NULL)
+    {
+        inc = self->freq.values[chnl] * 512 / self->sr;
+
+        for (i = 0; i < self->bufsize; i++)
+        {
+            pointerPos = Sine_clip(pointerPos);
+            pointerPos += inc;
+        }
+    }
+    else
+    {
+        MYFLT *fr = Stream_getData(fr_stream);
+        fac = 512 / self->sr;
+
+        for (i = 0; i < self->bufsize; i++)
+        {
+            inc = fr[i] * fac;
+            pointerPos = Sine_clip(pointerPos);
+            pointerPos += inc;
+        }
+    }
+
+    self->pointerPos[chnl] = pointerPos;
+}
+
+static void
+SineMulti_compute_next_data_frame(SineMulti *self)
+{
+    int i, j, lanes;
+
+    for (i = 0; i < self->chnls; i += PYO_MULTI_LANES)
+    {
+        lanes = self->chnls - i < PYO_MULTI_LANES ? self->chnls - i : PYO_MULTI_LANES;
+
+        if (MultiParam_isFloat(&self->freq, i, lanes) && MultiParam_isFloat(&self->phase, i, lanes)
+            && ! MultiObject_isMuted((MultiObject *)self, i, lanes))
+            SineMulti_readframes_lanes(self, i, lanes);
+        else
+        {
+            for (j = i; j < i + lanes; j++)
+            {
+                if (MultiObject_isMuted((MultiObject *)self, j, 1))
+                    SineMulti_advance(self, j);
+                else
+                    SineMulti_readframes_chnl(self, j);
+            }
+        }
+    }
+}
+
+static int
+SineMulti_traverse(SineMulti *self, visitproc visit, void *arg)
+{
+    pyo_multi_VISIT
+    MULTIPARAM_VISIT(self->freq)
+    MULTIPARAM_VISIT(self->phase)
+    return 0;
+}
+
+static int
+SineMulti_clear(SineMulti *self)
+{
+    pyo_multi_CLEAR
+    MULTIPARAM_CLEAR(self->freq)
+    MULTIPARAM_CLEAR(self->phase)
+    return 0;
+}
+
+static void
+SineMulti_dealloc(SineMulti* self)
+{
+    pyo_DEALLOC
+    MultiObject_freeBuffer((MultiObject *)self);
+    MultiParam_free(&self->freq);
+    MultiParam_free(&self->phase);
+    PyMem_RawFree(self->pointerPos);
+    SineMulti_clear(self);
+    Py_TYPE(self->stream)->tp_free((PyObject*)self->stream);
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static PyObject *
+SineMulti_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    int i;
+    PyObject *freqtmp = NULL, *phasetmp = NULL;
+    SineMulti *self;
+    self = (SineMulti *)type->tp_alloc(type, 0);
+
+    INIT_OBJECT_COMMON
+    Stream_setFunctionPtr(self->stream, SineMulti_compute_next_data_frame);
+
+    static char *kwlist[] = {"chnls", "freq", "phase", NULL};
+
+    if (! PyArg_ParseTupleAndKeywords(args, kwds, "i|OO", kwlist, &self->chnls, &freqtmp, &phasetmp))
+        Py_RETURN_NONE;
+
+    if (self->chnls < 1)
+        self->chnls = 1;
+
+    if (MultiObject_allocBuffer((MultiObject *)self) < 0)
+        return PyErr_NoMemory();
+
+    self->pointerPos = (MYFLT *)PyMem_RawCalloc(self->chnls, sizeof(MYFLT));
+
+    PyObject *deffreq = PyFloat_FromDouble(1000);
+    PyObject *defphase = PyFloat_FromDouble(0.0);
+    i = MultiParam_set(&self->freq, freqtmp ? freqtmp : deffreq, self->chnls, self->server);
+
+    if (i == 0)
+        i = MultiParam_set(&self->phase, phasetmp ? phasetmp : defphase, self->chnls, self->server);
+
+    Py_DECREF(deffreq);
+    Py_DECREF(defphase);
+
+    if (i < 0)
+    {
+        Py_DECREF(self);
+        return NULL;
+    }
+
+    PyObject_CallMethod(self->server, "addStream", "O", self->stream);
+
+    return (PyObject *)self;
+}
+
+static PyObject * SineMulti_getServer(SineMulti* self) { GET_SERVER };
+static PyObject * SineMulti_getStream(SineMulti* self) { GET_STREAM };
+
+static PyObject * SineMulti_play(SineMulti *self, PyObject *args, PyObject *kwds) { PLAY };
+static PyObject * SineMulti_stop(SineMulti *self, PyObject *args, PyObject *kwds) { STOP };
+
+static PyObject *
+SineMulti_setFreq(SineMulti *self, PyObject *args)
+{
+    if (MultiParam_setArgs(&self->freq, args, self->chnls, self->server) < 0)
+        return NULL;
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+SineMulti_setPhase(SineMulti *self, PyObject *args)
+{
+    if (MultiParam_setArgs(&self->phase, args, self->chnls, self->server) < 0)
+        return NULL;
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+SineMulti_reset(SineMulti *self, PyObject *args)
+{
+    int i, chnl = -1;
+
+    if (! PyArg_ParseTuple(args, "|i", &chnl))
+        return NULL;
+
+    for (i = 0; i < self->chnls; i++)
+    {
+        if (chnl < 0 || i == chnl)
+            self->pointerPos[i] = 0.0;
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyMemberDef SineMulti_members[] =
+{
+    {"server", T_OBJECT_EX, offsetof(SineMulti, server), 0, "Pyo server."},
+    {"stream", T_OBJECT_EX, offsetof(SineMulti, stream), 0, "Stream object."},
+    {NULL}  /* Sentinel */
+};
+
+static PyMethodDef SineMulti_methods[] =
+{
+    {"getServer", (PyCFunction)SineMulti_getServer, METH_NOARGS, "Returns server object."},
+    {"_getStream", (PyCFunction)SineMulti_getStream, METH_NOARGS, "Returns stream object."},
+    {"play", (PyCFunction)SineMulti_play, METH_VARARGS | METH_KEYWORDS, "Starts computing without sending sound to soundcard."},
+    {"stop", (PyCFunction)SineMulti_stop, METH_VARARGS | METH_KEYWORDS, "Stops computing."},
+    {"setFreq", (PyCFunction)SineMulti_setFreq, METH_VARARGS, "Sets the frequency of each channel, or of the given channel, in cycle per second."},
+    {"setPhase", (PyCFunction)SineMulti_setPhase, METH_VARARGS, "Sets the phase of each channel, or of the given channel, between 0 and 1."},
+    {"reset", (PyCFunction)SineMulti_reset, METH_VARARGS, "Resets the pointer position of every channel, or of the given channel, to 0."},
+    {NULL}  /* Sentinel */
+};
+
+PyTypeObject SineMultiType =
+{
+    PyVarObject_HEAD_INIT(NULL, 0)
+    "_pyo.SineMulti_base",         /*tp_name*/
+    sizeof(SineMulti),         /*tp_basicsize*/
+    0,                         /*tp_itemsize*/
+    (destructor)SineMulti_dealloc, /*tp_dealloc*/
+    0,                         /*tp_print*/
+    0,                         /*tp_getattr*/
+    0,                         /*tp_setattr*/
+    0,                         /*tp_as_async (tp_compare in Python 2)*/
+    0,                         /*tp_repr*/
+    0,                         /*tp_as_number*/
+    0,                         /*tp_as_sequence*/
+    0,                         /*tp_as_mapping*/
+    0,                         /*tp_hash */
+    0,                         /*tp_call*/
+    0,                         /*tp_str*/
+    0,                         /*tp_getattro*/
+    0,                         /*tp_setattro*/
+    0,                         /*tp_as_buffer*/
+    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE | Py_TPFLAGS_HAVE_GC,  /*tp_flags*/
+    "SineMulti objects. Generates the sinewaves of all the channels of a Sine.",           /* tp_doc */
+    (traverseproc)SineMulti_traverse,   /* tp_traverse */
+    (inquiry)SineMulti_clear,           /* tp_clear */
+    0,                     /* tp_richcompare */
+    0,                     /* tp_weaklistoffset */
+    0,                     /* tp_iter */
+    0,                     /* tp_iternext */
+    SineMulti_methods,             /* tp_methods */
+    SineMulti_members,             /* tp_members */
+    0,                      /* tp_getset */
+    0,                         /* tp_base */
+    0,                         /* tp_dict */
+    0,                         /* tp_descr_get */
+    0,                         /* tp_descr_set */
+    0,                         /* tp_dictoffset */
+    0,      /* tp_init */
+    0,                         /* tp_alloc */
+    SineMulti_new,                 /* tp_new */
+};
+
 /* FastSine object */
 typedef struct
 {
@@ -1448,17 +1814,20 @@ typedef struct
     double pointerPos;
     int interp; /* 0 = default to 2, 1 = nointerp, 2 = linear, 3 = cos, 4 = cubic */
     MYFLT (*interp_func_ptr)(MYFLT *, T_SIZE_T, MYFLT, T_SIZE_T);
+    interp_block_func interp_block_ptr;
+    double *positions; /* Reading positions of the block, followed by the phase increments. */
+    MYFLT *scratch;
 } Osc;
 
 static void
 Osc_readframes_ii(Osc *self)
 {
     int i;
-    MYFLT fr, ph, fpart;
+    MYFLT fr, ph;
     double inc, pos;
-    T_SIZE_T ipart;
-    MYFLT *tablelist = TableStream_getData((TableStream *)self->table);
     T_SIZE_T size = TableStream_getSize((TableStream *)self->table);
+    double pointer = self->pointerPos, *positions = self->positions;
+    FUSED_MULADD_INIT
 
     fr = PyFloat_AS_DOUBLE(self->freq);
     ph = PyFloat_AS_DOUBLE(self->phase);
@@ -1468,28 +1837,34 @@ Osc_readframes_ii(Osc *self)
 
     for (i = 0; i < self->bufsize; i++)
     {
-        self->pointerPos += inc;
-        self->pointerPos = Osc_clip(self->pointerPos, size);
-        pos = self->pointerPos + ph;
+        pointer += inc;
+        pointer = Osc_clip(pointer, size);
+        pos = pointer + ph;
 
         if (pos >= size)
             pos -= size;
 
-        ipart = (T_SIZE_T)pos;
-        fpart = pos - ipart;
-        self->data[i] = (*self->interp_func_ptr)(tablelist, ipart, fpart, size);
+        positions[i] = pos;
     }
+
+    self->pointerPos = pointer;
+
+    TableStream_interpolate((TableStream *)self->table, self->interp_block_ptr, positions,
+                            inc, NULL, self->data, self->scratch, self->bufsize);
+
+    for (i = 0; i < self->bufsize; i++)
+        self->data[i] = FUSED_MULADD(self->data[i]);
 }
 
 static void
 Osc_readframes_ai(Osc *self)
 {
     int i;
-    MYFLT ph, fpart, sizeOnSr;
+    MYFLT ph, sizeOnSr;
     double inc, pos;
-    T_SIZE_T ipart;
-    MYFLT *tablelist = TableStream_getData((TableStream *)self->table);
     T_SIZE_T size = TableStream_getSize((TableStream *)self->table);
+    double pointer = self->pointerPos, *positions = self->positions;
+    FUSED_MULADD_INIT
 
     MYFLT *fr = Stream_getData((Stream *)self->freq_stream);
     ph = PyFloat_AS_DOUBLE(self->phase);
@@ -1500,28 +1875,35 @@ Osc_readframes_ai(Osc *self)
     for (i = 0; i < self->bufsize; i++)
     {
         inc = fr[i] * sizeOnSr;
-        self->pointerPos += inc;
-        self->pointerPos = Osc_clip(self->pointerPos, size);
-        pos = self->pointerPos + ph;
+        positions[self->bufsize + i] = inc;
+        pointer += inc;
+        pointer = Osc_clip(pointer, size);
+        pos = pointer + ph;
 
         if (pos >= size)
             pos -= size;
 
-        ipart = (T_SIZE_T)pos;
-        fpart = pos - ipart;
-        self->data[i] = (*self->interp_func_ptr)(tablelist, ipart, fpart, size);
+        positions[i] = pos;
     }
+
+    self->pointerPos = pointer;
+
+    TableStream_interpolate((TableStream *)self->table, self->interp_block_ptr, positions,
+                            0.0, positions + self->bufsize, self->data, self->scratch, self->bufsize);
+
+    for (i = 0; i < self->bufsize; i++)
+        self->data[i] = FUSED_MULADD(self->data[i]);
 }
 
 static void
 Osc_readframes_ia(Osc *self)
 {
     int i;
-    MYFLT fr, pha, fpart;
+    MYFLT fr, pha;
     double inc, pos;
-    T_SIZE_T ipart;
-    MYFLT *tablelist = TableStream_getData((TableStream *)self->table);
     T_SIZE_T size = TableStream_getSize((TableStream *)self->table);
+    double pointer = self->pointerPos, *positions = self->positions;
+    FUSED_MULADD_INIT
 
     fr = PyFloat_AS_DOUBLE(self->freq);
     MYFLT *ph = Stream_getData((Stream *)self->phase_stream);
@@ -1530,28 +1912,34 @@ Osc_readframes_ia(Osc *self)
     for (i = 0; i < self->bufsize; i++)
     {
         pha = ph[i] * size;
-        self->pointerPos += inc;
-        self->pointerPos = Osc_clip(self->pointerPos, size);
-        pos = self->pointerPos + pha;
+        pointer += inc;
+        pointer = Osc_clip(pointer, size);
+        pos = pointer + pha;
 
         if (pos >= size)
             pos -= size;
 
-        ipart = (T_SIZE_T)pos;
-        fpart = pos - ipart;
-        self->data[i] = (*self->interp_func_ptr)(tablelist, ipart, fpart, size);
+        positions[i] = pos;
     }
+
+    self->pointerPos = pointer;
+
+    TableStream_interpolate((TableStream *)self->table, self->interp_block_ptr, positions,
+                            inc, NULL, self->data, self->scratch, self->bufsize);
+
+    for (i = 0; i < self->bufsize; i++)
+        self->data[i] = FUSED_MULADD(self->data[i]);
 }
 
 static void
 Osc_readframes_aa(Osc *self)
 {
     int i;
-    MYFLT pha, fpart, sizeOnSr;
+    MYFLT pha, sizeOnSr;
     double inc, pos;
-    T_SIZE_T ipart;
-    MYFLT *tablelist = TableStream_getData((TableStream *)self->table);
     T_SIZE_T size = TableStream_getSize((TableStream *)self->table);
+    double pointer = self->pointerPos, *positions = self->positions;
+    FUSED_MULADD_INIT
 
     MYFLT *fr = Stream_getData((Stream *)self->freq_stream);
     MYFLT *ph = Stream_getData((Stream *)self->phase_stream);
@@ -1561,21 +1949,28 @@ Osc_readframes_aa(Osc *self)
     for (i = 0; i < self->bufsize; i++)
     {
         inc = fr[i] * sizeOnSr;
+        positions[self->bufsize + i] = inc;
         pha = ph[i] * size;
-        self->pointerPos += inc;
-        self->pointerPos = Osc_clip(self->pointerPos, size);
-        pos = self->pointerPos + pha;
+        pointer += inc;
+        pointer = Osc_clip(pointer, size);
+        pos = pointer + pha;
 
         if (pos >= size)
             pos -= size;
 
-        ipart = (T_SIZE_T)pos;
-        fpart = pos - ipart;
-        self->data[i] = (*self->interp_func_ptr)(tablelist, ipart, fpart, size);
+        positions[i] = pos;
     }
+
+    self->pointerPos = pointer;
+
+    TableStream_interpolate((TableStream *)self->table, self->interp_block_ptr, positions,
+                            0.0, positions + self->bufsize, self->data, self->scratch, self->bufsize);
+
+    for (i = 0; i < self->bufsize; i++)
+        self->data[i] = FUSED_MULADD(self->data[i]);
 }
 
-static void Osc_postprocessing_ii(Osc *self) { POST_PROCESSING_II };
+static void Osc_postprocessing_fused(Osc *self) {}; /* mul & add applied by the processing function */
 static void Osc_postprocessing_ai(Osc *self) { POST_PROCESSING_AI };
 static void Osc_postprocessing_ia(Osc *self) { POST_PROCESSING_IA };
 static void Osc_postprocessing_aa(Osc *self) { POST_PROCESSING_AA };
@@ -1614,7 +2009,7 @@ Osc_setProcMode(Osc *self)
     switch (muladdmode)
     {
         case 0:
-            self->muladd_func_ptr = Osc_postprocessing_ii;
+            self->muladd_func_ptr = Osc_postprocessing_fused;
             break;
 
         case 1:
@@ -1651,10 +2046,52 @@ Osc_setProcMode(Osc *self)
     }
 }
 
+/* Moves the phase as the processing functions do, without reading the
+   table, while the output is muted by the mul. */
+static void
+Osc_advance(Osc *self)
+{
+    int i;
+    MYFLT fr, sizeOnSr;
+    double inc;
+    T_SIZE_T size = TableStream_getSize((TableStream *)self->table);
+    double pointer = self->pointerPos;
+
+    if (self->modebuffer[2] == 0)
+    {
+        fr = PyFloat_AS_DOUBLE(self->freq);
+        inc = fr * size / self->sr;
+
+        for (i = 0; i < self->bufsize; i++)
+        {
+            pointer += inc;
+            pointer = Osc_clip(pointer, size);
+        }
+    }
+    else
+    {
+        MYFLT *frs = Stream_getData((Stream *)self->freq_stream);
+        sizeOnSr = size / self->sr;
+
+        for (i = 0; i < self->bufsize; i++)
+        {
+            inc = frs[i] * sizeOnSr;
+            pointer += inc;
+            pointer = Osc_clip(pointer, size);
+        }
+    }
+
+    self->pointerPos = pointer;
+}
+
 static void
 Osc_compute_next_data_frame(Osc *self)
 {
-    (*self->proc_func_ptr)(self);
+    if (MULADD_MUTED)
+        Osc_advance(self);
+    else
+        (*self->proc_func_ptr)(self);
+
     (*self->muladd_func_ptr)(self);
 }
 
@@ -1680,6 +2117,8 @@ static void
 Osc_dealloc(Osc* self)
 {
     pyo_DEALLOC
+    PyMem_RawFree(self->positions);
+    PyMem_RawFree(self->scratch);
     Osc_clear(self);
     Py_TYPE(self->stream)->tp_free((PyObject*)self->stream);
     Py_TYPE(self)->tp_free((PyObject*)self);
@@ -1704,8 +2143,12 @@ Osc_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, Osc_compute_next_data_frame);
+    Stream_setShareable(self->stream, 1);
     self->mode_func_ptr = Osc_setProcMode;
 
+    self->positions = (double *)PyMem_RawMalloc(2 * self->bufsize * sizeof(double));
+    self->scratch = (MYFLT *)PyMem_RawMalloc(self->bufsize * sizeof(MYFLT));
+
     static char *kwlist[] = {"table", "freq", "phase", "interp", "mul", "add", NULL};
 
     if (! PyArg_ParseTupleAndKeywords(args, kwds, "O|OOiOO", kwlist, &tabletmp, &freqtmp, &phasetmp, &self->interp, &multmp, &addtmp))
@@ -1743,7 +2186,7 @@ Osc_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     (*self->mode_func_ptr)(self);
 
-    SET_INTERP_POINTER
+    SET_INTERP_BLOCK_POINTER
 
     return (PyObject *)self;
 }
@@ -1780,8 +2223,10 @@ Osc_setTable(Osc *self, PyObject *arg)
 {
     ASSERT_ARG_NOT_NULL
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->table);
     self->table = PyObject_CallMethod((PyObject *)arg, "getTableStream", "");
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -1799,7 +2244,7 @@ Osc_setInterp(Osc *self, PyObject *arg)
         self->interp = PyLong_AsLong(PyNumber_Long(arg));
     }
 
-    SET_INTERP_POINTER
+    SET_INTERP_BLOCK_POINTER
 
     Py_RETURN_NONE;
 }
@@ -1947,11 +2392,17 @@ OscLoop_readframes_ii(OscLoop *self)
     T_SIZE_T ipart;
     MYFLT *tablelist = TableStream_getData((TableStream *)self->table);
     T_SIZE_T size = TableStream_getSize((TableStream *)self->table);
+    MYFLT *lo = tablelist, *hi = tablelist, mix = 0.0;
+    int nlevels;
+    MYFLT **levels = TableStream_getMipmaps((TableStream *)self->table, &nlevels);
 
     fr = PyFloat_AS_DOUBLE(self->freq);
     feed = _clip(PyFloat_AS_DOUBLE(self->feedback)) * size;
     inc = fr * size / self->sr;
 
+    if (levels != NULL)
+        mix = TableStream_pickMipmaps(levels, nlevels, inc, &lo, &hi);
+
     for (i = 0; i < self->bufsize; i++)
     {
         self->pointerPos += inc;
@@ -1964,7 +2415,7 @@ OscLoop_readframes_ii(OscLoop *self)
             pos += size;
 
         ipart = (T_SIZE_T)pos;
-        self->data[i] = self->lastValue = tablelist[ipart] + (tablelist[ipart + 1] - tablelist[ipart]) * (pos - ipart);
+        self->data[i] = self->lastValue = TableStream_readMipmaps(linear, lo, hi, mix, ipart, pos - ipart, size);
     }
 }
 
@@ -1976,15 +2427,32 @@ OscLoop_readframes_ai(OscLoop *self)
     T_SIZE_T ipart;
     MYFLT *tablelist = TableStream_getData((TableStream *)self->table);
     T_SIZE_T size = TableStream_getSize((TableStream *)self->table);
+    MYFLT *lo = tablelist, *hi = tablelist, mix = 0.0;
+    int nlevels;
+    MYFLT **levels = TableStream_getMipmaps((TableStream *)self->table, &nlevels);
 
     MYFLT *fr = Stream_getData((Stream *)self->freq_stream);
     feed = _clip(PyFloat_AS_DOUBLE(self->feedback)) * size;
 
     sizeOnSr = size / self->sr;
 
+    if (levels != NULL)
+    {
+        inc = 0.0;
+
+        for (i = 0; i < self->bufsize; i++)
+        {
+            if (MYFABS(fr[i]) > inc)
+                inc = MYFABS(fr[i]);
+        }
+
+        mix = TableStream_pickMipmaps(levels, nlevels, inc * sizeOnSr, &lo, &hi);
+    }
+
     for (i = 0; i < self->bufsize; i++)
     {
         inc = fr[i] * sizeOnSr;
+
         self->pointerPos += inc;
         self->pointerPos = Osc_clip(self->pointerPos, size);
         pos = self->pointerPos + (self->lastValue * feed);
@@ -1995,7 +2463,7 @@ OscLoop_readframes_ai(OscLoop *self)
             pos += size;
 
         ipart = (T_SIZE_T)pos;
-        self->data[i] = self->lastValue = tablelist[ipart] + (tablelist[ipart + 1] - tablelist[ipart]) * (pos - ipart);
+        self->data[i] = self->lastValue = TableStream_readMipmaps(linear, lo, hi, mix, ipart, pos - ipart, size);
     }
 }
 
@@ -2007,11 +2475,17 @@ OscLoop_readframes_ia(OscLoop *self)
     T_SIZE_T ipart;
     MYFLT *tablelist = TableStream_getData((TableStream *)self->table);
     T_SIZE_T size = TableStream_getSize((TableStream *)self->table);
+    MYFLT *lo = tablelist, *hi = tablelist, mix = 0.0;
+    int nlevels;
+    MYFLT **levels = TableStream_getMipmaps((TableStream *)self->table, &nlevels);
 
     fr = PyFloat_AS_DOUBLE(self->freq);
     MYFLT *fd = Stream_getData((Stream *)self->feedback_stream);
     inc = fr * size / self->sr;
 
+    if (levels != NULL)
+        mix = TableStream_pickMipmaps(levels, nlevels, inc, &lo, &hi);
+
     for (i = 0; i < self->bufsize; i++)
     {
         feed = _clip(fd[i]) * size;
@@ -2025,7 +2499,7 @@ OscLoop_readframes_ia(OscLoop *self)
             pos += size;
 
         ipart = (T_SIZE_T)pos;
-        self->data[i] = self->lastValue = tablelist[ipart] + (tablelist[ipart + 1] - tablelist[ipart]) * (pos - ipart);
+        self->data[i] = self->lastValue = TableStream_readMipmaps(linear, lo, hi, mix, ipart, pos - ipart, size);
     }
 }
 
@@ -2037,15 +2511,32 @@ OscLoop_readframes_aa(OscLoop *self)
     T_SIZE_T ipart;
     MYFLT *tablelist = TableStream_getData((TableStream *)self->table);
     T_SIZE_T size = TableStream_getSize((TableStream *)self->table);
+    MYFLT *lo = tablelist, *hi = tablelist, mix = 0.0;
+    int nlevels;
+    MYFLT **levels = TableStream_getMipmaps((TableStream *)self->table, &nlevels);
 
     MYFLT *fr = Stream_getData((Stream *)self->freq_stream);
     MYFLT *fd = Stream_getData((Stream *)self->feedback_stream);
 
     sizeOnSr = size / self->sr;
 
+    if (levels != NULL)
+    {
+        inc = 0.0;
+
+        for (i = 0; i < self->bufsize; i++)
+        {
+            if (MYFABS(fr[i]) > inc)
+                inc = MYFABS(fr[i]);
+        }
+
+        mix = TableStream_pickMipmaps(levels, nlevels, inc * sizeOnSr, &lo, &hi);
+    }
+
     for (i = 0; i < self->bufsize; i++)
     {
         inc = fr[i] * sizeOnSr;
+
         feed = _clip(fd[i]) * size;
         self->pointerPos += inc;
         self->pointerPos = Osc_clip(self->pointerPos, size);
@@ -2057,7 +2548,7 @@ OscLoop_readframes_aa(OscLoop *self)
             pos += size;
 
         ipart = (T_SIZE_T)pos;
-        self->data[i] = self->lastValue = tablelist[ipart] + (tablelist[ipart + 1] - tablelist[ipart]) * (pos - ipart);
+        self->data[i] = self->lastValue = TableStream_readMipmaps(linear, lo, hi, mix, ipart, pos - ipart, size);
     }
 }
 
@@ -2263,8 +2754,10 @@ OscLoop_setTable(OscLoop *self, PyObject *arg)
 {
     ASSERT_ARG_NOT_NULL
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->table);
     self->table = PyObject_CallMethod((PyObject *)arg, "getTableStream", "");
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -2396,17 +2889,19 @@ typedef struct
     double pointerPos;
     int interp; /* 0 = default to 2, 1 = nointerp, 2 = linear, 3 = cos, 4 = cubic */
     MYFLT (*interp_func_ptr)(MYFLT *, T_SIZE_T, MYFLT, T_SIZE_T);
+    interp_block_func interp_block_ptr;
+    double *positions; /* Reading positions of the block, followed by the phase increments. */
+    MYFLT *scratch;
 } OscTrig;
 
 static void
 OscTrig_readframes_ii(OscTrig *self)
 {
     int i;
-    MYFLT fr, ph, fpart;
+    MYFLT fr, ph;
     double inc, pos;
-    T_SIZE_T ipart;
-    MYFLT *tablelist = TableStream_getData((TableStream *)self->table);
     T_SIZE_T size = TableStream_getSize((TableStream *)self->table);
+    double pointer = self->pointerPos, *positions = self->positions;
 
     fr = PyFloat_AS_DOUBLE(self->freq);
     ph = PyFloat_AS_DOUBLE(self->phase);
@@ -2418,33 +2913,35 @@ OscTrig_readframes_ii(OscTrig *self)
     for (i = 0; i < self->bufsize; i++)
     {
         if (tr[i] == 1)
-            self->pointerPos = 0.0;
+            pointer = 0.0;
         else
         {
-            self->pointerPos += inc;
-            self->pointerPos = Osc_clip(self->pointerPos, size);
+            pointer += inc;
+            pointer = Osc_clip(pointer, size);
         }
 
-        pos = self->pointerPos + ph;
+        pos = pointer + ph;
 
         if (pos >= size)
             pos -= size;
 
-        ipart = (T_SIZE_T)pos;
-        fpart = pos - ipart;
-        self->data[i] = (*self->interp_func_ptr)(tablelist, ipart, fpart, size);
+        positions[i] = pos;
     }
+
+    self->pointerPos = pointer;
+
+    TableStream_interpolate((TableStream *)self->table, self->interp_block_ptr, positions,
+                            inc, NULL, self->data, self->scratch, self->bufsize);
 }
 
 static void
 OscTrig_readframes_ai(OscTrig *self)
 {
     int i;
-    MYFLT ph, fpart, sizeOnSr;
+    MYFLT ph, sizeOnSr;
     double inc, pos;
-    T_SIZE_T ipart;
-    MYFLT *tablelist = TableStream_getData((TableStream *)self->table);
     T_SIZE_T size = TableStream_getSize((TableStream *)self->table);
+    double pointer = self->pointerPos, *positions = self->positions;
 
     MYFLT *fr = Stream_getData((Stream *)self->freq_stream);
     ph = PyFloat_AS_DOUBLE(self->phase);
@@ -2456,35 +2953,38 @@ OscTrig_readframes_ai(OscTrig *self)
     for (i = 0; i < self->bufsize; i++)
     {
         inc = fr[i] * sizeOnSr;
+        positions[self->bufsize + i] = inc;
 
         if (tr[i] == 1)
-            self->pointerPos = 0.0;
+            pointer = 0.0;
         else
         {
-            self->pointerPos += inc;
-            self->pointerPos = Osc_clip(self->pointerPos, size);
+            pointer += inc;
+            pointer = Osc_clip(pointer, size);
         }
 
-        pos = self->pointerPos + ph;
+        pos = pointer + ph;
 
         if (pos >= size)
             pos -= size;
 
-        ipart = (T_SIZE_T)pos;
-        fpart = pos - ipart;
-        self->data[i] = (*self->interp_func_ptr)(tablelist, ipart, fpart, size);
+        positions[i] = pos;
     }
+
+    self->pointerPos = pointer;
+
+    TableStream_interpolate((TableStream *)self->table, self->interp_block_ptr, positions,
+                            0.0, positions + self->bufsize, self->data, self->scratch, self->bufsize);
 }
 
 static void
 OscTrig_readframes_ia(OscTrig *self)
 {
     int i;
-    MYFLT fr, pha, fpart;
+    MYFLT fr, pha;
     double inc, pos;
-    T_SIZE_T ipart;
-    MYFLT *tablelist = TableStream_getData((TableStream *)self->table);
     T_SIZE_T size = TableStream_getSize((TableStream *)self->table);
+    double pointer = self->pointerPos, *positions = self->positions;
 
     fr = PyFloat_AS_DOUBLE(self->freq);
     MYFLT *ph = Stream_getData((Stream *)self->phase_stream);
@@ -2496,33 +2996,35 @@ OscTrig_readframes_ia(OscTrig *self)
         pha = ph[i] * size;
 
         if (tr[i] == 1)
-            self->pointerPos = 0.0;
+            pointer = 0.0;
         else
         {
-            self->pointerPos += inc;
-            self->pointerPos = Osc_clip(self->pointerPos, size);
+            pointer += inc;
+            pointer = Osc_clip(pointer, size);
         }
 
-        pos = self->pointerPos + pha;
+        pos = pointer + pha;
 
         if (pos >= size)
             pos -= size;
 
-        ipart = (T_SIZE_T)pos;
-        fpart = pos - ipart;
-        self->data[i] = (*self->interp_func_ptr)(tablelist, ipart, fpart, size);
+        positions[i] = pos;
     }
+
+    self->pointerPos = pointer;
+
+    TableStream_interpolate((TableStream *)self->table, self->interp_block_ptr, positions,
+                            inc, NULL, self->data, self->scratch, self->bufsize);
 }
 
 static void
 OscTrig_readframes_aa(OscTrig *self)
 {
     int i;
-    MYFLT pha, fpart, sizeOnSr;
+    MYFLT pha, sizeOnSr;
     double inc, pos;
-    T_SIZE_T ipart;
-    MYFLT *tablelist = TableStream_getData((TableStream *)self->table);
     T_SIZE_T size = TableStream_getSize((TableStream *)self->table);
+    double pointer = self->pointerPos, *positions = self->positions;
 
     MYFLT *fr = Stream_getData((Stream *)self->freq_stream);
     MYFLT *ph = Stream_getData((Stream *)self->phase_stream);
@@ -2533,25 +3035,29 @@ OscTrig_readframes_aa(OscTrig *self)
     for (i = 0; i < self->bufsize; i++)
     {
         inc = fr[i] * sizeOnSr;
+        positions[self->bufsize + i] = inc;
         pha = ph[i] * size;
 
         if (tr[i] == 1)
-            self->pointerPos = 0.0;
+            pointer = 0.0;
         else
         {
-            self->pointerPos += inc;
-            self->pointerPos = Osc_clip(self->pointerPos, size);
+            pointer += inc;
+            pointer = Osc_clip(pointer, size);
         }
 
-        pos = self->pointerPos + pha;
+        pos = pointer + pha;
 
         if (pos >= size)
             pos -= size;
 
-        ipart = (T_SIZE_T)pos;
-        fpart = pos - ipart;
-        self->data[i] = (*self->interp_func_ptr)(tablelist, ipart, fpart, size);
+        positions[i] = pos;
     }
+
+    self->pointerPos = pointer;
+
+    TableStream_interpolate((TableStream *)self->table, self->interp_block_ptr, positions,
+                            0.0, positions + self->bufsize, self->data, self->scratch, self->bufsize);
 }
 
 static void OscTrig_postprocessing_ii(OscTrig *self) { POST_PROCESSING_II };
@@ -2661,6 +3167,8 @@ static void
 OscTrig_dealloc(OscTrig* self)
 {
     pyo_DEALLOC
+    PyMem_RawFree(self->positions);
+    PyMem_RawFree(self->scratch);
     OscTrig_clear(self);
     Py_TYPE(self->stream)->tp_free((PyObject*)self->stream);
     Py_TYPE(self)->tp_free((PyObject*)self);
@@ -2688,6 +3196,9 @@ OscTrig_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     Stream_setFunctionPtr(self->stream, OscTrig_compute_next_data_frame);
     self->mode_func_ptr = OscTrig_setProcMode;
 
+    self->positions = (double *)PyMem_RawMalloc(2 * self->bufsize * sizeof(double));
+    self->scratch = (MYFLT *)PyMem_RawMalloc(self->bufsize * sizeof(MYFLT));
+
     static char *kwlist[] = {"table", "trig", "freq", "phase", "interp", "mul", "add", NULL};
 
     if (! PyArg_ParseTupleAndKeywords(args, kwds, "OO|OOiOO", kwlist, &tabletmp, &trigtmp, &freqtmp, &phasetmp, &self->interp, &multmp, &addtmp))
@@ -2730,7 +3241,7 @@ OscTrig_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     (*self->mode_func_ptr)(self);
 
-    SET_INTERP_POINTER
+    SET_INTERP_BLOCK_POINTER
 
     return (PyObject *)self;
 }
@@ -2767,8 +3278,10 @@ OscTrig_setTable(OscTrig *self, PyObject *arg)
 {
     ASSERT_ARG_NOT_NULL
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->table);
     self->table = PyObject_CallMethod((PyObject *)arg, "getTableStream", "");
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -2784,6 +3297,7 @@ OscTrig_setTrig(OscTrig *self, PyObject *arg)
         Py_RETURN_NONE;
     }
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->trig);
 
     self->trig = arg;
@@ -2791,6 +3305,8 @@ OscTrig_setTrig(OscTrig *self, PyObject *arg)
     PyObject *streamtmp = PyObject_CallMethod((PyObject *)self->trig, "_getStream", NULL);
     self->trig_stream = (Stream *)streamtmp;
     Py_INCREF(self->trig_stream);
+    Stream_invalidateGraph();
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -2808,7 +3324,7 @@ OscTrig_setInterp(OscTrig *self, PyObject *arg)
         self->interp = PyLong_AsLong(PyNumber_Long(arg));
     }
 
-    SET_INTERP_POINTER
+    SET_INTERP_BLOCK_POINTER
 
     Py_RETURN_NONE;
 }
@@ -3580,8 +4096,10 @@ Pointer_setTable(Pointer *self, PyObject *arg)
 {
     ASSERT_ARG_NOT_NULL
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->table);
     self->table = PyObject_CallMethod((PyObject *)arg, "getTableStream", "");
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -3597,6 +4115,7 @@ Pointer_setIndex(Pointer *self, PyObject *arg)
         Py_RETURN_NONE;
     }
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->index);
 
     self->index = arg;
@@ -3604,6 +4123,8 @@ Pointer_setIndex(Pointer *self, PyObject *arg)
     PyObject *streamtmp = PyObject_CallMethod((PyObject *)self->index, "_getStream", NULL);
     self->index_stream = (Stream *)streamtmp;
     Py_INCREF(self->index_stream);
+    Stream_invalidateGraph();
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -3733,39 +4254,36 @@ typedef struct
     MYFLT lastPh;
     MYFLT mTwoPiOverSr;
     MYFLT (*interp_func_ptr)(MYFLT *, T_SIZE_T, MYFLT, T_SIZE_T);
+    interp_block_func interp_block_ptr;
+    double *positions; /* Reading positions of the block. */
 } Pointer2;
 
 static void
 Pointer2_readframes_a(Pointer2 *self)
 {
     int i;
-    MYFLT fpart, phdiff, c, fr;
+    MYFLT phdiff, c, fr;
     double ph;
-    T_SIZE_T ipart;
     MYFLT *tablelist = TableStream_getData((TableStream *)self->table);
     T_SIZE_T size = TableStream_getSize((TableStream *)self->table);
     double tableSr = TableStream_getSamplingRate((TableStream *)self->table);
 
     MYFLT *pha = Stream_getData((Stream *)self->index_stream);
 
+    for (i = 0; i < self->bufsize; i++)
+        self->positions[i] = Osc_clip(pha[i] * size, size);
+
+    (*self->interp_block_ptr)(tablelist, size, self->positions, self->data, self->bufsize);
+
     if (!self->autosmooth)
     {
-        for (i = 0; i < self->bufsize; i++)
-        {
-            ph = Osc_clip(pha[i] * size, size);
-            ipart = (T_SIZE_T)ph;
-            fpart = ph - ipart;
-            self->y1 = self->y2 = self->data[i] = (*self->interp_func_ptr)(tablelist, ipart, fpart, size);
-        }
+        self->y1 = self->y2 = self->data[self->bufsize - 1];
     }
     else
     {
         for (i = 0; i < self->bufsize; i++)
         {
-            ph = Osc_clip(pha[i] * size, size);
-            ipart = (T_SIZE_T)ph;
-            fpart = ph - ipart;
-            self->data[i] = (*self->interp_func_ptr)(tablelist, ipart, fpart, size);
+            ph = self->positions[i];
             phdiff = fabs(ph - self->lastPh);
             self->lastPh = ph;
 
@@ -3867,6 +4385,7 @@ static void
 Pointer2_dealloc(Pointer2* self)
 {
     pyo_DEALLOC
+    PyMem_RawFree(self->positions);
     Pointer2_clear(self);
     Py_TYPE(self->stream)->tp_free((PyObject*)self->stream);
     Py_TYPE(self)->tp_free((PyObject*)self);
@@ -3892,6 +4411,8 @@ Pointer2_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     Stream_setFunctionPtr(self->stream, Pointer2_compute_next_data_frame);
     self->mode_func_ptr = Pointer2_setProcMode;
 
+    self->positions = (double *)PyMem_RawMalloc(self->bufsize * sizeof(double));
+
     self->mTwoPiOverSr = -TWOPI / self->sr;
 
     static char *kwlist[] = {"table", "index", "interp", "autosmooth", "mul", "add", NULL};
@@ -3926,7 +4447,7 @@ Pointer2_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     (*self->mode_func_ptr)(self);
 
-    SET_INTERP_POINTER
+    SET_INTERP_BLOCK_POINTER
 
     return (PyObject *)self;
 }
@@ -3963,8 +4484,10 @@ Pointer2_setTable(Pointer2 *self, PyObject *arg)
 {
     ASSERT_ARG_NOT_NULL
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->table);
     self->table = PyObject_CallMethod((PyObject *)arg, "getTableStream", "");
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -3980,6 +4503,7 @@ Pointer2_setIndex(Pointer2 *self, PyObject *arg)
         Py_RETURN_NONE;
     }
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->index);
 
     self->index = arg;
@@ -3987,6 +4511,8 @@ Pointer2_setIndex(Pointer2 *self, PyObject *arg)
     PyObject *streamtmp = PyObject_CallMethod((PyObject *)self->index, "_getStream", NULL);
     self->index_stream = (Stream *)streamtmp;
     Py_INCREF(self->index_stream);
+    Stream_invalidateGraph();
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -4001,7 +4527,7 @@ Pointer2_setInterp(Pointer2 *self, PyObject *arg)
         self->interp = PyLong_AsLong(PyNumber_Long(arg));
     }
 
-    SET_INTERP_POINTER
+    SET_INTERP_BLOCK_POINTER
 
     Py_RETURN_NONE;
 }
@@ -4338,8 +4864,10 @@ TableIndex_setTable(TableIndex *self, PyObject *arg)
 {
     ASSERT_ARG_NOT_NULL
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->table);
     self->table = PyObject_CallMethod((PyObject *)arg, "getTableStream", "");
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -4355,6 +4883,7 @@ TableIndex_setIndex(TableIndex *self, PyObject *arg)
         Py_RETURN_NONE;
     }
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->index);
 
     self->index = arg;
@@ -4362,6 +4891,8 @@ TableIndex_setIndex(TableIndex *self, PyObject *arg)
     PyObject *streamtmp = PyObject_CallMethod((PyObject *)self->index, "_getStream", NULL);
     self->index_stream = (Stream *)streamtmp;
     Py_INCREF(self->index_stream);
+    Stream_invalidateGraph();
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -4691,8 +5222,10 @@ Lookup_setTable(Lookup *self, PyObject *arg)
 {
     ASSERT_ARG_NOT_NULL
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->table);
     self->table = PyObject_CallMethod((PyObject *)arg, "getTableStream", "");
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -4708,6 +5241,7 @@ Lookup_setIndex(Lookup *self, PyObject *arg)
         Py_RETURN_NONE;
     }
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->index);
 
     self->index = arg;
@@ -4715,6 +5249,8 @@ Lookup_setIndex(Lookup *self, PyObject *arg)
     PyObject *streamtmp = PyObject_CallMethod((PyObject *)self->index, "_getStream", NULL);
     self->index_stream = (Stream *)streamtmp;
     Py_INCREF(self->index_stream);
+    Stream_invalidateGraph();
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -5516,8 +6052,10 @@ Pulsar_setTable(Pulsar *self, PyObject *arg)
 {
     ASSERT_ARG_NOT_NULL
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->table);
     self->table = PyObject_CallMethod((PyObject *)arg, "getTableStream", "");
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -5527,8 +6065,10 @@ Pulsar_setEnv(Pulsar *self, PyObject *arg)
 {
     ASSERT_ARG_NOT_NULL
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->env);
     self->env = PyObject_CallMethod((PyObject *)arg, "getTableStream", "");
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -5687,16 +6227,18 @@ typedef struct
     int init;
     int interp; /* 0 = default to 2, 1 = nointerp, 2 = linear, 3 = cos, 4 = cubic */
     MYFLT (*interp_func_ptr)(MYFLT *, T_SIZE_T, MYFLT, T_SIZE_T);
+    interp_block_func interp_block_ptr;
+    double *positions; /* Reading positions of the block, followed by the phase increments. */
+    MYFLT *scratch;
 } TableRead;
 
 static void
 TableRead_readframes_i(TableRead *self)
 {
-    int i;
-    MYFLT fr, inc, fpart;
-    T_SIZE_T ipart;
-    MYFLT *tablelist = TableStream_getData((TableStream *)self->table);
+    int i, count = 0;
+    MYFLT fr, inc;
     T_SIZE_T size = TableStream_getSize((TableStream *)self->table);
+    double pointer = self->pointerPos, *positions = self->positions;
 
     fr = PyFloat_AS_DOUBLE(self->freq);
     inc = fr * size / self->sr;
@@ -5708,7 +6250,7 @@ TableRead_readframes_i(TableRead *self)
     {
         self->trigsBuffer[i] = 0.0;
 
-        if (self->pointerPos < 0)
+        if (pointer < 0)
         {
             if (self->init == 0)
             {
@@ -5720,44 +6262,52 @@ TableRead_readframes_i(TableRead *self)
             else
                 self->init = 0;
 
-            self->pointerPos = size + self->pointerPos;
+            pointer = size + pointer;
         }
-        else if (self->pointerPos >= size && self->go)
+        else if (pointer >= size && self->go)
         {
             self->trigsBuffer[i] = 1.0;
 
             if (self->loop == 1)
-                self->pointerPos -= size;
+                pointer -= size;
             else
                 self->go = 0;
         }
 
+        /* go only falls to 0 within a block, the samples read are a prefix of it. */
         if (self->go == 1)
         {
-            ipart = (T_SIZE_T)self->pointerPos;
-            fpart = self->pointerPos - ipart;
-            self->lastValue = self->data[i] = (*self->interp_func_ptr)(tablelist, ipart, fpart, size);
-        }
-        else
-        {
-            if (self->keepLast == 0)
-                self->data[i] = 0.0;
-            else
-                self->data[i] = self->lastValue;
+            positions[i] = pointer;
+            count = i + 1;
         }
 
-        self->pointerPos += inc;
+        pointer += inc;
+    }
+
+    self->pointerPos = pointer;
+
+    TableStream_interpolate((TableStream *)self->table, self->interp_block_ptr, positions,
+                            inc, NULL, self->data, self->scratch, count);
+
+    if (count > 0)
+        self->lastValue = self->data[count - 1];
+
+    for (i = count; i < self->bufsize; i++)
+    {
+        if (self->keepLast == 0)
+            self->data[i] = 0.0;
+        else
+            self->data[i] = self->lastValue;
     }
 }
 
 static void
 TableRead_readframes_a(TableRead *self)
 {
-    int i;
-    MYFLT inc, fpart, sizeOnSr;
-    T_SIZE_T ipart;
-    MYFLT *tablelist = TableStream_getData((TableStream *)self->table);
+    int i, count = 0;
+    MYFLT inc, sizeOnSr;
     T_SIZE_T size = TableStream_getSize((TableStream *)self->table);
+    double pointer = self->pointerPos, *positions = self->positions;
 
     MYFLT *fr = Stream_getData((Stream *)self->freq_stream);
 
@@ -5770,7 +6320,7 @@ TableRead_readframes_a(TableRead *self)
     {
         self->trigsBuffer[i] = 0.0;
 
-        if (self->pointerPos < 0)
+        if (pointer < 0)
         {
             if (self->init == 0)
             {
@@ -5782,34 +6332,44 @@ TableRead_readframes_a(TableRead *self)
             else
                 self->init = 0;
 
-            self->pointerPos = size + self->pointerPos;
+            pointer = size + pointer;
         }
-        else if (self->pointerPos >= size && self->go)
+        else if (pointer >= size && self->go)
         {
             self->trigsBuffer[i] = 1.0;
 
             if (self->loop == 1)
-                self->pointerPos -= size;
+                pointer -= size;
             else
                 self->go = 0;
         }
 
+        /* go only falls to 0 within a block, the samples read are a prefix of it. */
         if (self->go == 1)
         {
-            ipart = (T_SIZE_T)self->pointerPos;
-            fpart = self->pointerPos - ipart;
-            self->lastValue = self->data[i] = (*self->interp_func_ptr)(tablelist, ipart, fpart, size);
-        }
-        else
-        {
-            if (self->keepLast == 0)
-                self->data[i] = 0.0;
-            else
-                self->data[i] = self->lastValue;
+            positions[i] = pointer;
+            count = i + 1;
         }
 
         inc = fr[i] * sizeOnSr;
-        self->pointerPos += inc;
+        positions[self->bufsize + i] = inc;
+        pointer += inc;
+    }
+
+    self->pointerPos = pointer;
+
+    TableStream_interpolate((TableStream *)self->table, self->interp_block_ptr, positions,
+                            0.0, positions + self->bufsize, self->data, self->scratch, count);
+
+    if (count > 0)
+        self->lastValue = self->data[count - 1];
+
+    for (i = count; i < self->bufsize; i++)
+    {
+        if (self->keepLast == 0)
+            self->data[i] = 0.0;
+        else
+            self->data[i] = self->lastValue;
     }
 }
 
@@ -5908,6 +6468,8 @@ static void
 TableRead_dealloc(TableRead* self)
 {
     pyo_DEALLOC
+    PyMem_RawFree(self->positions);
+    PyMem_RawFree(self->scratch);
     PyMem_RawFree(self->trigsBuffer);
     TableRead_clear(self);
     Py_TYPE(self->trig_stream)->tp_free((PyObject*)self->trig_stream);
@@ -5937,8 +6499,12 @@ TableRead_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, TableRead_compute_next_data_frame);
+    Stream_setNeedGIL(self->stream, 1);
     self->mode_func_ptr = TableRead_setProcMode;
 
+    self->positions = (double *)PyMem_RawMalloc(2 * self->bufsize * sizeof(double));
+    self->scratch = (MYFLT *)PyMem_RawMalloc(self->bufsize * sizeof(MYFLT));
+
     static char *kwlist[] = {"table", "freq", "loop", "interp", "mul", "add", NULL};
 
     if (! PyArg_ParseTupleAndKeywords(args, kwds, "O|OiiOO", kwlist, &tabletmp, &freqtmp, &self->loop, &self->interp, &multmp, &addtmp))
@@ -5984,7 +6550,7 @@ TableRead_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     (*self->mode_func_ptr)(self);
 
-    SET_INTERP_POINTER
+    SET_INTERP_BLOCK_POINTER
 
     self->init = 1;
 
@@ -6077,8 +6643,10 @@ TableRead_setTable(TableRead *self, PyObject *arg)
 {
     ASSERT_ARG_NOT_NULL
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->table);
     self->table = PyObject_CallMethod((PyObject *)arg, "getTableStream", "");
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -6105,7 +6673,7 @@ TableRead_setInterp(TableRead *self, PyObject *arg)
         self->interp = PyLong_AsLong(PyNumber_Long(arg));
     }
 
-    SET_INTERP_POINTER
+    SET_INTERP_BLOCK_POINTER
 
     Py_RETURN_NONE;
 }
@@ -12176,6 +12744,7 @@ TableScale_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, TableScale_compute_next_data_frame);
+    Stream_setTableWriter(self->stream, 1);
     self->mode_func_ptr = TableScale_setProcMode;
 
     static char *kwlist[] = {"table", "outtable", "mul", "add", NULL};
@@ -12248,8 +12817,10 @@ TableScale_setTable(TableScale *self, PyObject *arg)
 {
     ASSERT_ARG_NOT_NULL
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->table);
     self->table = PyObject_CallMethod((PyObject *)arg, "getTableStream", "");
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -12266,8 +12837,10 @@ TableScale_setOuttable(TableScale *self, PyObject *arg)
 {
     ASSERT_ARG_NOT_NULL
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->outtable);
     self->outtable = PyObject_CallMethod((PyObject *)arg, "getTableStream", "");
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -12448,6 +13021,7 @@ TableFill_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     INIT_OBJECT_COMMON
 
     Stream_setFunctionPtr(self->stream, TableFill_compute_next_data_frame);
+    Stream_setTableWriter(self->stream, 1);
 
     static char *kwlist[] = {"input", "table", NULL};
 
@@ -12485,9 +13059,11 @@ TableFill_setTable(TableFill *self, PyObject *arg)
 {
     ASSERT_ARG_NOT_NULL
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->table);
     self->table = PyObject_CallMethod((PyObject *)arg, "getTableStream", "");
     Py_INCREF(self->table);
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -12761,8 +13337,10 @@ TableScan_setTable(TableScan *self, PyObject *arg)
 {
     ASSERT_ARG_NOT_NULL
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->table);
     self->table = PyObject_CallMethod((PyObject *)arg, "getTableStream", "");
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -103,6 +103,7 @@ OscReceiver_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, OscReceiver_compute_next_data_frame);
+    Stream_setNeedGIL(self->stream, 1);
 
     static char *kwlist[] = {"port", "address", NULL};
 
@@ -408,6 +409,7 @@ OscReceive_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->factor = 1. / (0.01 * self->sr);
 
     Stream_setFunctionPtr(self->stream, OscReceive_compute_next_data_frame);
+    Stream_setNeedGIL(self->stream, 1);
     self->mode_func_ptr = OscReceive_setProcMode;
 
     static char *kwlist[] = {"input", "address", "mul", "add", NULL};
@@ -658,6 +660,7 @@ OscSend_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, OscSend_compute_next_data_frame);
+    Stream_setNeedGIL(self->stream, 1);
 
     static char *kwlist[] = {"input", "port", "address", "host", NULL};
 
@@ -933,6 +936,7 @@ OscDataSend_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, OscDataSend_compute_next_data_frame);
+    Stream_setNeedGIL(self->stream, 1);
 
     static char *kwlist[] = {"types", "port", "address", "host", NULL};
 
@@ -1220,6 +1224,7 @@ OscDataReceive_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, OscDataReceive_compute_next_data_frame);
+    Stream_setNeedGIL(self->stream, 1);
 
     static char *kwlist[] = {"port", "address", "callable", NULL};
 
@@ -1443,6 +1448,7 @@ OscListReceiver_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, OscListReceiver_compute_next_data_frame);
+    Stream_setNeedGIL(self->stream, 1);
 
     static char *kwlist[] = {"port", "address", "num", NULL};
 
@@ -1779,6 +1785,7 @@ OscListReceive_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->factor = 1. / (0.01 * self->sr);
 
     Stream_setFunctionPtr(self->stream, OscListReceive_compute_next_data_frame);
+    Stream_setNeedGIL(self->stream, 1);
     self->mode_func_ptr = OscListReceive_setProcMode;
 
     static char *kwlist[] = {"input", "address", "order", "mul", "add", NULL};
@@ -1870,6 +1870,7 @@ typedef struct
     PyObject *input;
     Stream *input_stream;
     PyObject *trigger_streams;
+    Stream **trig_streams; /* borrowed, see Stream_getListStreams. */
     int maxVoices;
     int *voices;
     int modebuffer[2]; // need at least 2 slots for mul & add
@@ -1879,7 +1880,6 @@ static void
 VoiceManager_generate(VoiceManager *self)
 {
     int j, i;
-    Stream *trig_stream;
 
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
 
@@ -1892,8 +1892,7 @@ VoiceManager_generate(VoiceManager *self)
         {
             for (j = 0; j < self->maxVoices; j++)
             {
-                trig_stream = (Stream *)PyObject_CallMethod((PyObject *)PyList_GET_ITEM(self->trigger_streams, j), "_getStream", NULL);
-                if (Stream_getData(trig_stream)[i] == 1.0)
+                if (Stream_getData(self->trig_streams[j])[i] == 1.0)
                     self->voices[j] = 0;
             }
 
@@ -1983,6 +1982,7 @@ VoiceManager_traverse(VoiceManager *self, visitproc visit, void *arg)
 {
     pyo_VISIT
     Py_VISIT(self->input);
+    Py_VISIT(self->trigger_streams);
     return 0;
 }
 
@@ -1991,6 +1991,7 @@ VoiceManager_clear(VoiceManager *self)
 {
     pyo_CLEAR
     Py_CLEAR(self->input);
+    Py_CLEAR(self->trigger_streams);
     return 0;
 }
 
@@ -2005,6 +2006,8 @@ VoiceManager_dealloc(VoiceManager* self)
         PyMem_RawFree(self->voices);
     }
 
+    PyMem_RawFree(self->trig_streams);
+
     Py_TYPE(self->stream)->tp_free((PyObject*)self->stream);
     Py_TYPE(self)->tp_free((PyObject*)self);
 }
@@ -2077,7 +2080,10 @@ static PyObject * VoiceManager_inplace_div(VoiceManager *self, PyObject *arg) {
 static PyObject *
 VoiceManager_setTriggers(VoiceManager *self, PyObject *arg)
 {
-    int i;
+    int i, maxVoices;
+    int *voices, *oldvoices;
+    PyObject *old;
+    Stream **streams, **oldstreams;
 
     if (! PyList_Check(arg))
     {
@@ -2085,18 +2091,33 @@ VoiceManager_setTriggers(VoiceManager *self, PyObject *arg)
         Py_RETURN_NONE;
     }
 
-    Py_INCREF(arg);
-    Py_XDECREF(self->trigger_streams);
-    self->trigger_streams = arg;
+    if ((streams = Stream_getListStreams(arg)) == NULL)
+        return NULL;
 
-    self->maxVoices = PyList_Size(arg);
-    self->voices = (int *)PyMem_RawRealloc(self->voices, self->maxVoices * sizeof(int));
+    maxVoices = PyList_Size(arg);
+    voices = (int *)PyMem_RawMalloc((maxVoices + 1) * sizeof(int));
 
-    for (i = 0; i < self->maxVoices; i++)
+    for (i = 0; i < maxVoices; i++)
     {
-        self->voices[i] = 0;
+        voices[i] = 0;
     }
 
+    Py_INCREF(arg);
+    Server_lockProcessing(self->server);
+    old = self->trigger_streams;
+    oldstreams = self->trig_streams;
+    oldvoices = self->voices;
+    self->trigger_streams = arg;
+    self->trig_streams = streams;
+    self->voices = voices;
+    self->maxVoices = maxVoices;
+    Stream_invalidateGraph();
+    Server_unlockProcessing(self->server);
+
+    Py_XDECREF(old);
+    PyMem_RawFree(oldstreams);
+    PyMem_RawFree(oldvoices);
+
     Py_RETURN_NONE;
 }
 
@@ -2212,6 +2233,8 @@ typedef struct
 {
     pyo_audio_HEAD
     PyObject *inputs;
+    PyObject *keys; /* keys of `inputs`, in the order of input_streams. */
+    Stream **input_streams; /* borrowed, see Stream_getListStreams. */
     PyObject *gains;
     PyObject *lastGains;
     PyObject *currentGains;
@@ -2237,13 +2260,13 @@ Mixer_generate(Mixer *self)
         self->buffer_streams[i] = 0.0;
     }
 
-    keys = PyDict_Keys(self->inputs);
-    num = PyList_Size(keys);
+    keys = self->keys;
+    num = keys != NULL ? PyList_GET_SIZE(keys) : 0;
 
     for (j = 0; j < num; j++)
     {
-        key = PyList_GetItem(keys, j);
-        MYFLT *st = Stream_getData((Stream *)PyObject_CallMethod((PyObject *)PyDict_GetItem(self->inputs, key), "_getStream", NULL));
+        key = PyList_GET_ITEM(keys, j);
+        MYFLT *st = Stream_getData(self->input_streams[j]);
         list_of_gains = PyDict_GetItem(self->gains, key);
         list_of_last_gains = PyDict_GetItem(self->lastGains, key);
         list_of_current_gains = PyDict_GetItem(self->currentGains, key);
@@ -2286,8 +2309,6 @@ Mixer_generate(Mixer *self)
             PyList_SetItem(list_of_time_counts, k, PyLong_FromLong(tmpCount));
         }
     }
-
-    Py_XDECREF(keys);
 }
 
 MYFLT *
@@ -2313,6 +2334,7 @@ Mixer_traverse(Mixer *self, visitproc visit, void *arg)
 {
     pyo_VISIT
     Py_VISIT(self->inputs);
+    Py_VISIT(self->keys);
     Py_VISIT(self->gains);
     Py_VISIT(self->lastGains);
     Py_VISIT(self->currentGains);
@@ -2326,6 +2348,7 @@ Mixer_clear(Mixer *self)
 {
     pyo_CLEAR
     Py_CLEAR(self->inputs);
+    Py_CLEAR(self->keys);
     Py_CLEAR(self->gains);
     Py_CLEAR(self->lastGains);
     Py_CLEAR(self->currentGains);
@@ -2339,6 +2362,7 @@ Mixer_dealloc(Mixer* self)
 {
     pyo_DEALLOC
     PyMem_RawFree(self->buffer_streams);
+    PyMem_RawFree(self->input_streams);
     Mixer_clear(self);
     Py_TYPE(self->stream)->tp_free((PyObject*)self->stream);
     Py_TYPE(self)->tp_free((PyObject*)self);
@@ -2364,6 +2388,7 @@ Mixer_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, Mixer_compute_next_data_frame);
+    Stream_setNeedGIL(self->stream, 1);
     self->mode_func_ptr = Mixer_setProcMode;
 
     static char *kwlist[] = {"outs", "time", NULL};
@@ -2425,6 +2450,43 @@ Mixer_setTime(Mixer *self, PyObject *arg)
     Py_RETURN_NONE;
 }
 
+/* Fetches the streams of the inputs again. The Mixer is computed with the
+   GIL held (it updates its gain lists), never while they are replaced. */
+static int
+Mixer_setInputStreams(Mixer *self)
+{
+    PyObject *keys, *values, *old;
+    Stream **streams;
+
+    keys = PyDict_Keys(self->inputs);
+    values = PyDict_Values(self->inputs);
+
+    if (keys == NULL || values == NULL)
+    {
+        Py_XDECREF(keys);
+        Py_XDECREF(values);
+        return -1;
+    }
+
+    streams = Stream_getListStreams(values);
+    Py_DECREF(values);
+
+    if (streams == NULL)
+    {
+        Py_DECREF(keys);
+        return -1;
+    }
+
+    old = self->keys;
+    PyMem_RawFree(self->input_streams);
+    self->keys = keys;
+    self->input_streams = streams;
+    Py_XDECREF(old);
+    Stream_invalidateGraph();
+
+    return 0;
+}
+
 static PyObject *
 Mixer_addInput(Mixer *self, PyObject *args, PyObject *kwds)
 {
@@ -2472,6 +2534,9 @@ Mixer_addInput(Mixer *self, PyObject *args, PyObject *kwds)
     PyDict_SetItem(self->stepVals, voice, initStepVals);
     PyDict_SetItem(self->timeCounts, voice, initTimeCounts);
 
+    if (Mixer_setInputStreams(self) < 0)
+        return NULL;
+
     Py_RETURN_NONE;
 }
 
@@ -2490,6 +2555,9 @@ Mixer_delInput(Mixer *self, PyObject *arg)
         PyDict_DelItem(self->currentGains, key);
         PyDict_DelItem(self->stepVals, key);
         PyDict_DelItem(self->timeCounts, key);
+
+        if (Mixer_setInputStreams(self) < 0)
+            return NULL;
     }
     else
     {
@@ -2863,6 +2931,7 @@ typedef struct
 {
     pyo_audio_HEAD
     PyObject *inputs;
+    Stream **input_streams; /* borrowed, see Stream_getListStreams. */
     PyObject *voice;
     Stream *voice_stream;
     int chSize;
@@ -2899,8 +2968,8 @@ Selector_generate_i(Selector *self)
         j--;
     }
 
-    MYFLT *st1 = Stream_getData((Stream *)PyObject_CallMethod((PyObject *)PyList_GET_ITEM(self->inputs, j1), "_getStream", NULL));
-    MYFLT *st2 = Stream_getData((Stream *)PyObject_CallMethod((PyObject *)PyList_GET_ITEM(self->inputs, j), "_getStream", NULL));
+    MYFLT *st1 = Stream_getData(self->input_streams[j1]);
+    MYFLT *st2 = Stream_getData(self->input_streams[j]);
 
     voice = P_clip(voice - j1);
     voice1 = MYSQRT(1.0 - voice);
@@ -2927,8 +2996,8 @@ Selector_generate_lin_i(Selector *self)
         j--;
     }
 
-    MYFLT *st1 = Stream_getData((Stream *)PyObject_CallMethod((PyObject *)PyList_GET_ITEM(self->inputs, j1), "_getStream", NULL));
-    MYFLT *st2 = Stream_getData((Stream *)PyObject_CallMethod((PyObject *)PyList_GET_ITEM(self->inputs, j), "_getStream", NULL));
+    MYFLT *st1 = Stream_getData(self->input_streams[j1]);
+    MYFLT *st2 = Stream_getData(self->input_streams[j]);
 
     voice = P_clip(voice - j1);
 
@@ -2948,8 +3017,8 @@ Selector_generate_a(Selector *self)
 
     old_j1 = 0;
     old_j = 1;
-    st1 = Stream_getData((Stream *)PyObject_CallMethod((PyObject *)PyList_GET_ITEM(self->inputs, old_j1), "_getStream", NULL));
-    st2 = Stream_getData((Stream *)PyObject_CallMethod((PyObject *)PyList_GET_ITEM(self->inputs, old_j), "_getStream", NULL));
+    st1 = Stream_getData(self->input_streams[old_j1]);
+    st2 = Stream_getData(self->input_streams[old_j]);
 
     for (i = 0; i < self->bufsize; i++)
     {
@@ -2966,13 +3035,13 @@ Selector_generate_a(Selector *self)
 
         if (j1 != old_j1)
         {
-            st1 = Stream_getData((Stream *)PyObject_CallMethod((PyObject *)PyList_GET_ITEM(self->inputs, j1), "_getStream", NULL));
+            st1 = Stream_getData(self->input_streams[j1]);
             old_j1 = j1;
         }
 
         if (j != old_j)
         {
-            st2 = Stream_getData((Stream *)PyObject_CallMethod((PyObject *)PyList_GET_ITEM(self->inputs, j), "_getStream", NULL));
+            st2 = Stream_getData(self->input_streams[j]);
             old_j = j;
         }
 
@@ -2992,8 +3061,8 @@ Selector_generate_lin_a(Selector *self)
 
     old_j1 = 0;
     old_j = 1;
-    st1 = Stream_getData((Stream *)PyObject_CallMethod((PyObject *)PyList_GET_ITEM(self->inputs, old_j1), "_getStream", NULL));
-    st2 = Stream_getData((Stream *)PyObject_CallMethod((PyObject *)PyList_GET_ITEM(self->inputs, old_j), "_getStream", NULL));
+    st1 = Stream_getData(self->input_streams[old_j1]);
+    st2 = Stream_getData(self->input_streams[old_j]);
 
     for (i = 0; i < self->bufsize; i++)
     {
@@ -3010,13 +3079,13 @@ Selector_generate_lin_a(Selector *self)
 
         if (j1 != old_j1)
         {
-            st1 = Stream_getData((Stream *)PyObject_CallMethod((PyObject *)PyList_GET_ITEM(self->inputs, j1), "_getStream", NULL));
+            st1 = Stream_getData(self->input_streams[j1]);
             old_j1 = j1;
         }
 
         if (j != old_j)
         {
-            st2 = Stream_getData((Stream *)PyObject_CallMethod((PyObject *)PyList_GET_ITEM(self->inputs, j), "_getStream", NULL));
+            st2 = Stream_getData(self->input_streams[j]);
             old_j = j;
         }
 
@@ -3131,6 +3200,7 @@ static void
 Selector_dealloc(Selector* self)
 {
     pyo_DEALLOC
+    PyMem_RawFree(self->input_streams);
     Selector_clear(self);
     Py_TYPE(self->stream)->tp_free((PyObject*)self->stream);
     Py_TYPE(self)->tp_free((PyObject*)self);
@@ -3209,16 +3279,30 @@ static PyObject * Selector_inplace_div(Selector *self, PyObject *arg) { INPLACE_
 static PyObject *
 Selector_setInputs(Selector *self, PyObject *arg)
 {
+    PyObject *old;
+    Stream **streams, **oldstreams;
+
     if (! PyList_Check(arg))
     {
         PyErr_SetString(PyExc_TypeError, "The inputs attribute must be a list.");
         Py_RETURN_NONE;
     }
 
+    if ((streams = Stream_getListStreams(arg)) == NULL)
+        return NULL;
+
+    Py_INCREF(arg);
+    Server_lockProcessing(self->server);
+    old = self->inputs;
+    oldstreams = self->input_streams;
     self->chSize = PyList_Size(arg);
-    Py_XDECREF(self->inputs);
     self->inputs = arg;
-    Py_INCREF(self->inputs);
+    self->input_streams = streams;
+    Stream_invalidateGraph();
+    Server_unlockProcessing(self->server);
+
+    Py_XDECREF(old);
+    PyMem_RawFree(oldstreams);
 
     Py_RETURN_NONE;
 }
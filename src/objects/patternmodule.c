@@ -38,12 +38,38 @@ typedef struct
     int init;
 } Pattern;
 
+static void
+Pattern_callFunction(Pattern *self)
+{
+    PyObject *tuple, *result;
+
+    if (! PyCallable_Check(self->callable))
+        return;
+
+    if (self->arg == Py_None)
+    {
+        result = PyObject_Call((PyObject *)self->callable, PyTuple_New(0), NULL);
+    }
+    else
+    {
+        tuple = PyTuple_New(1);
+        Py_INCREF(self->arg);
+        PyTuple_SET_ITEM(tuple, 0, self->arg);
+        result = PyObject_Call((PyObject *)self->callable, tuple, NULL);
+        Py_DECREF(tuple);
+    }
+
+    if (result == NULL)
+        PyErr_Print();
+
+    Py_XDECREF(result);
+}
+
 static void
 Pattern_generate_i(Pattern *self)
 {
     int i;
     MYFLT tm;
-    PyObject *tuple, *result;
 
     tm = PyFloat_AS_DOUBLE(self->time);
 
@@ -58,31 +84,7 @@ Pattern_generate_i(Pattern *self)
         if (self->currentTime >= tm && PyCallable_Check(self->callable))
         {
             self->currentTime = 0.0;
-
-            if (self->arg == Py_None)
-            {
-                result = PyObject_Call((PyObject *)self->callable, PyTuple_New(0), NULL);
-
-                if (result == NULL)
-                {
-                    PyErr_Print();
-                    return;
-                }
-            }
-            else
-            {
-                tuple = PyTuple_New(1);
-                Py_INCREF(self->arg);
-                PyTuple_SET_ITEM(tuple, 0, self->arg);
-                result = PyObject_Call((PyObject *)self->callable, tuple, NULL);
-                Py_DECREF(tuple);
-
-                if (result == NULL)
-                {
-                    PyErr_Print();
-                    return;
-                }
-            }
+            Server_callOrDefer((Server *)self->server, self->stream);
         }
 
         self->currentTime += self->sampleToSec;
@@ -93,7 +95,6 @@ static void
 Pattern_generate_a(Pattern *self)
 {
     int i;
-    PyObject *tuple, *result;
 
     MYFLT *tm = Stream_getData((Stream *)self->time_stream);
 
@@ -108,31 +109,7 @@ Pattern_generate_a(Pattern *self)
         if (self->currentTime >= tm[i] && PyCallable_Check(self->callable))
         {
             self->currentTime = 0.0;
-
-            if (self->arg == Py_None)
-            {
-                result = PyObject_Call((PyObject *)self->callable, PyTuple_New(0), NULL);
-
-                if (result == NULL)
-                {
-                    PyErr_Print();
-                    return;
-                }
-            }
-            else
-            {
-                tuple = PyTuple_New(1);
-                Py_INCREF(self->arg);
-                PyTuple_SET_ITEM(tuple, 0, self->arg);
-                result = PyObject_Call((PyObject *)self->callable, tuple, NULL);
-                Py_DECREF(tuple);
-
-                if (result == NULL)
-                {
-                    PyErr_Print();
-                    return;
-                }
-            }
+            Server_callOrDefer((Server *)self->server, self->stream);
         }
 
         self->currentTime += self->sampleToSec;
@@ -206,6 +183,8 @@ Pattern_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, Pattern_compute_next_data_frame);
+    Stream_setNeedGIL(self->stream, 1);
+    Stream_setCallbackPtr(self->stream, Pattern_callFunction);
     self->mode_func_ptr = Pattern_setProcMode;
 
     self->sampleToSec = 1. / self->sr;
@@ -431,6 +410,7 @@ Score_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, Score_compute_next_data_frame);
+    Stream_setNeedGIL(self->stream, 1);
     self->mode_func_ptr = Score_setProcMode;
 
     static char *kwlist[] = {"input", "fname", NULL};
@@ -524,36 +504,48 @@ typedef struct
     double currentTime;
 } CallAfter;
 
+static void
+CallAfter_callFunction(CallAfter *self)
+{
+    PyObject *tuple, *result;
+
+    if (self->stream != NULL)
+    {
+        result = PyObject_CallMethod((PyObject *)self, "stop", NULL);
+        Py_XDECREF(result);
+    }
+
+    if (self->arg == Py_None)
+    {
+        result = PyObject_Call(self->callable, PyTuple_New(0), NULL);
+    }
+    else
+    {
+        tuple = PyTuple_New(1);
+        Py_INCREF(self->arg);
+        PyTuple_SET_ITEM(tuple, 0, self->arg);
+        result = PyObject_Call(self->callable, tuple, NULL);
+        Py_DECREF(tuple);
+    }
+
+    if (result == NULL)
+        PyErr_Print();
+
+    Py_XDECREF(result);
+}
+
 static void
 CallAfter_generate(CallAfter *self)
 {
     int i;
-    PyObject *tuple, *result;
 
     for (i = 0; i < self->bufsize; i++)
     {
         if (self->currentTime >= self->time)
         {
-            if (self->stream != NULL)
-                PyObject_CallMethod((PyObject *)self, "stop", NULL);
-
-            if (self->arg == Py_None)
-            {
-                result = PyObject_Call(self->callable, PyTuple_New(0), NULL);
-            }
-            else
-            {
-                tuple = PyTuple_New(1);
-                Py_INCREF(self->arg);
-                PyTuple_SET_ITEM(tuple, 0, self->arg);
-                result = PyObject_Call(self->callable, tuple, NULL);
-                Py_DECREF(tuple);
-
-            }
-
-            if (result == NULL)
-                PyErr_Print();
-
+            /* In GIL-free mode, the call is deferred, make sure it happens only once. */
+            self->currentTime = -1.0e30;
+            Server_callOrDefer((Server *)self->server, self->stream);
             break;
         }
 
@@ -613,6 +605,7 @@ CallAfter_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, CallAfter_compute_next_data_frame);
+    Stream_setCallbackPtr(self->stream, CallAfter_callFunction);
     self->mode_func_ptr = CallAfter_setProcMode;
 
     self->sampleToSec = 1. / self->sr;
@@ -29,6 +29,7 @@
 #include "tablemodule.h"
 #include "fft.h"
 #include "wind.h"
+#include "oscillatorbank.h"
 
 static int
 isPowerOfTwo(int x)
@@ -59,7 +60,7 @@ typedef struct
     MYFLT *real;
     MYFLT *imag;
     MYFLT *lastPhase;
-    MYFLT **twiddle;
+    PyoFFTPlan *plan;
     MYFLT *window;
     MYFLT **magn;
     MYFLT **freq;
@@ -72,7 +73,7 @@ typedef struct
 static void
 PVAnal_realloc_memories(PVAnal *self)
 {
-    int i, j, n8;
+    int i, j;
     self->hsize = self->size / 2;
     self->hopsize = self->size / self->olaps;
     self->factor = self->sr / (self->hopsize * TWOPI);
@@ -80,7 +81,6 @@ PVAnal_realloc_memories(PVAnal *self)
     self->inputLatency = self->size - self->hopsize;
     self->incount = self->inputLatency;
     self->overcount = 0;
-    n8 = self->size >> 3;
     self->input_buffer = (MYFLT *)PyMem_RawRealloc(self->input_buffer, self->size * sizeof(MYFLT));
     self->inframe = (MYFLT *)PyMem_RawRealloc(self->inframe, self->size * sizeof(MYFLT));
     self->outframe = (MYFLT *)PyMem_RawRealloc(self->outframe, self->size * sizeof(MYFLT));
@@ -92,8 +92,8 @@ PVAnal_realloc_memories(PVAnal *self)
     {
         for (i = 0; i < self->last_olaps; i++)
         {
-            PyMem_RawFree(self->magn[i]);
-            PyMem_RawFree(self->freq[i]);
+            arena_free(self->magn[i]);
+            arena_free(self->freq[i]);
         }
     }
 
@@ -105,8 +105,8 @@ PVAnal_realloc_memories(PVAnal *self)
 
     for (i = 0; i < self->olaps; i++)
     {
-        self->magn[i] = (MYFLT *)PyMem_RawMalloc(self->hsize * sizeof(MYFLT));
-        self->freq[i] = (MYFLT *)PyMem_RawMalloc(self->hsize * sizeof(MYFLT));
+        self->magn[i] = (MYFLT *)arena_alloc(self->hsize * sizeof(MYFLT));
+        self->freq[i] = (MYFLT *)arena_alloc(self->hsize * sizeof(MYFLT));
 
         for (j = 0; j < self->hsize; j++)
             self->magn[i][j] = self->freq[i][j] = 0.0;
@@ -115,18 +115,8 @@ PVAnal_realloc_memories(PVAnal *self)
     for (i = 0; i < self->hsize; i++)
         self->lastPhase[i] = self->real[i] = self->imag[i] = 0.0;
 
-    self->twiddle = (MYFLT **)PyMem_RawRealloc(self->twiddle, 4 * sizeof(MYFLT *));
-
-    for (i = 0; i < 4; i++)
-    {
-        if (self->allocated)
-        {
-            PyMem_RawFree(self->twiddle[i]);
-        }
-        self->twiddle[i] = (MYFLT *)PyMem_RawMalloc(n8 * sizeof(MYFLT));
-    }
-
-    fft_compute_split_twiddle(self->twiddle, self->size);
+    fft_plan_release(self->plan);
+    self->plan = fft_plan_acquire(self->size, PYO_FFT_REAL);
     self->window = (MYFLT *)PyMem_RawRealloc(self->window, self->size * sizeof(MYFLT));
     gen_window(self->window, self->size, self->wintype);
 
@@ -192,7 +182,7 @@ PVAnal_process(PVAnal *self)
                 self->inframe[(k + mod) % self->size] = self->input_buffer[k] * self->window[k];
             }
 
-            realfft_split(self->inframe, self->outframe, self->size, self->twiddle);
+            fft_plan_forward(self->plan, self->inframe, self->outframe);
             self->real[0] = self->outframe[0];
             self->imag[0] = 0.0;
 
@@ -289,18 +279,13 @@ PVAnal_dealloc(PVAnal* self)
     PyMem_RawFree(self->imag);
     PyMem_RawFree(self->lastPhase);
 
-    for (i = 0; i < 4; i++)
-    {
-        PyMem_RawFree(self->twiddle[i]);
-    }
-
-    PyMem_RawFree(self->twiddle);
+    fft_plan_release(self->plan);
     PyMem_RawFree(self->window);
 
     for (i = 0; i < self->olaps; i++)
     {
-        PyMem_RawFree(self->magn[i]);
-        PyMem_RawFree(self->freq[i]);
+        arena_free(self->magn[i]);
+        arena_free(self->freq[i]);
     }
 
     PyMem_RawFree(self->magn);
@@ -328,6 +313,7 @@ PVAnal_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->allocated = 0;
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, PVAnal_compute_next_data_frame);
+    Stream_setNeedGIL(self->stream, 1);
     self->mode_func_ptr = PVAnal_setProcMode;
 
     static char *kwlist[] = {"input", "size", "olaps", "wintype", "callback", NULL};
@@ -543,7 +529,7 @@ typedef struct
     MYFLT *real;
     MYFLT *imag;
     MYFLT *sumPhase;
-    MYFLT **twiddle;
+    PyoFFTPlan *plan;
     MYFLT *window;
     int modebuffer[2]; // need at least 2 slots for mul & add
     int allocated;
@@ -553,7 +539,7 @@ typedef struct
 static void
 PVSynth_realloc_memories(PVSynth *self)
 {
-    int i, n8;
+    int i;
     self->hsize = self->size / 2;
     self->hopsize = self->size / self->olaps;
     self->factor = self->hopsize * TWOPI / self->sr;
@@ -561,7 +547,6 @@ PVSynth_realloc_memories(PVSynth *self)
     self->inputLatency = self->size - self->hopsize;
     self->overcount = 0;
     self->ampscl = 1.0 / MYSQRT(self->olaps);
-    n8 = self->size >> 3;
     self->output_buffer = (MYFLT *)PyMem_RawRealloc(self->output_buffer, self->size * sizeof(MYFLT));
     self->inframe = (MYFLT *)PyMem_RawRealloc(self->inframe, self->size * sizeof(MYFLT));
     self->outframe = (MYFLT *)PyMem_RawRealloc(self->outframe, self->size * sizeof(MYFLT));
@@ -581,18 +566,8 @@ PVSynth_realloc_memories(PVSynth *self)
     for (i = 0; i < (self->size + self->hopsize); i++)
         self->outputAccum[i] = 0.0;
 
-    self->twiddle = (MYFLT **)PyMem_RawRealloc(self->twiddle, 4 * sizeof(MYFLT *));
-
-    for (i = 0; i < 4; i++)
-    {
-        if (self->allocated)
-        {
-            PyMem_RawFree(self->twiddle[i]);
-        }
-        self->twiddle[i] = (MYFLT *)PyMem_RawMalloc(n8 * sizeof(MYFLT));
-    }
-
-    fft_compute_split_twiddle(self->twiddle, self->size);
+    fft_plan_release(self->plan);
+    self->plan = fft_plan_acquire(self->size, PYO_FFT_REAL);
     self->window = (MYFLT *)PyMem_RawRealloc(self->window, self->size * sizeof(MYFLT));
     gen_window(self->window, self->size, self->wintype);
 
@@ -643,7 +618,7 @@ PVSynth_process(PVSynth *self)
                 self->inframe[self->size - k] = self->imag[k];
             }
 
-            irealfft_split(self->inframe, self->outframe, self->size, self->twiddle);
+            fft_plan_inverse(self->plan, self->inframe, self->outframe);
             mod = self->hopsize * self->overcount;
 
             for (k = 0; k < self->size; k++)
@@ -753,7 +728,6 @@ PVSynth_clear(PVSynth *self)
 static void
 PVSynth_dealloc(PVSynth* self)
 {
-    int i;
     pyo_DEALLOC
     PyMem_RawFree(self->output_buffer);
     PyMem_RawFree(self->outputAccum);
@@ -763,12 +737,7 @@ PVSynth_dealloc(PVSynth* self)
     PyMem_RawFree(self->imag);
     PyMem_RawFree(self->sumPhase);
 
-    for (i = 0; i < 4; i++)
-    {
-        PyMem_RawFree(self->twiddle[i]);
-    }
-
-    PyMem_RawFree(self->twiddle);
+    fft_plan_release(self->plan);
     PyMem_RawFree(self->window);
     PVSynth_clear(self);
     Py_TYPE(self->stream)->tp_free((PyObject*)self->stream);
@@ -836,6 +805,7 @@ PVSynth_setInput(PVSynth *self, PyObject *arg)
         Py_RETURN_NONE;
     }
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->input);
 
     self->input = arg;
@@ -843,6 +813,7 @@ PVSynth_setInput(PVSynth *self, PyObject *arg)
     PyObject *input_streamtmp = PyObject_CallMethod((PyObject *)self->input, "_getPVStream", NULL);
     self->input_stream = (PVStream *)input_streamtmp;
     Py_INCREF(self->input_stream);
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -1006,8 +977,8 @@ typedef struct
     int first;
     int inc;
     int update;
-    MYFLT *ppos;
-    MYFLT *amp;
+    int active; /* Number of oscillators whose bin is below the Nyquist frequency. */
+    OscillatorBank bank;
     MYFLT *freq;
     MYFLT *outbuf;
     MYFLT *table;
@@ -1018,18 +989,24 @@ static void
 PVAddSynth_realloc_memories(PVAddSynth *self)
 {
     int i;
+    MYFLT ratio = 8192.0 / self->sr;
     self->hsize = self->size / 2;
     self->hopsize = self->size / self->olaps;
     self->inputLatency = self->size - self->hopsize;
     self->overcount = 0;
-    self->ppos = (MYFLT *)PyMem_RawRealloc(self->ppos, self->num * sizeof(MYFLT));
-    self->amp = (MYFLT *)PyMem_RawRealloc(self->amp, self->num * sizeof(MYFLT));
+    self->active = 0;
+    OscillatorBank_alloc(&self->bank, self->num);
     self->freq = (MYFLT *)PyMem_RawRealloc(self->freq, self->num * sizeof(MYFLT));
 
     for (i = 0; i < self->num; i++)
     {
-        self->ppos[i] = self->amp[i] = 0.0;
         self->freq[i] = (i * self->inc + self->first) * self->size / self->sr;
+        /* The bank reads the table before moving the phase, it holds the
+           phases already advanced by one sample. */
+        self->bank.phase[i] = self->freq[i] * ratio;
+
+        if ((i * self->inc + self->first) < self->hsize)
+            self->active = i + 1;
     }
 
     self->outbuf = (MYFLT *)PyMem_RawRealloc(self->outbuf, self->hopsize * sizeof(MYFLT));
@@ -1038,11 +1015,44 @@ PVAddSynth_realloc_memories(PVAddSynth *self)
         self->outbuf[i] = 0.0;
 }
 
+/* Synthesizes the next hop in `outbuf`. The frequency and the amplitude
+   of each oscillator move linearly to the values of its bin over the hop. */
+static void
+PVAddSynth_synthesize(PVAddSynth *self, MYFLT pitch, MYFLT **magn, MYFLT **freq)
+{
+    int k, n, bin;
+    MYFLT tamp, tfreq, incf;
+    MYFLT ratio = 8192.0 / self->sr;
+
+    for (n = 0; n < self->hopsize; n++)
+    {
+        self->outbuf[n] = 0.0;
+    }
+
+    for (k = 0; k < self->active; k++)
+    {
+        bin = k * self->inc + self->first;
+        tamp = magn[self->overcount][bin];
+        tfreq = freq[self->overcount][bin] * pitch;
+        incf = (tfreq - self->freq[k]) / self->hopsize;
+        OscillatorBank_set(&self->bank, k, (self->freq[k] + incf) * ratio, self->bank.amp[k]);
+        OscillatorBank_rampTo(&self->bank, k, (tfreq + incf) * ratio, tamp, self->hopsize);
+        self->freq[k] = tfreq;
+    }
+
+    OscillatorBank_process(&self->bank, self->active, self->table, 8192, self->outbuf, self->hopsize);
+
+    self->overcount++;
+
+    if (self->overcount >= self->olaps)
+        self->overcount = 0;
+}
+
 static void
 PVAddSynth_process_i(PVAddSynth *self)
 {
-    int i, k, n, bin, ipart;
-    MYFLT pitch, tamp, tfreq, inca, incf, ratio, fpart;
+    int i;
+    MYFLT pitch;
     MYFLT **magn = PVStream_getMagn((PVStream *)self->input_stream);
     MYFLT **freq = PVStream_getFreq((PVStream *)self->input_stream);
     int *count = PVStream_getCount((PVStream *)self->input_stream);
@@ -1058,51 +1068,13 @@ PVAddSynth_process_i(PVAddSynth *self)
         PVAddSynth_realloc_memories(self);
     }
 
-    ratio = 8192.0 / self->sr;
-
     for (i = 0; i < self->bufsize; i++)
     {
         self->data[i] = self->outbuf[count[i] - self->inputLatency];
 
         if (count[i] >= (self->size - 1))
         {
-            for (n = 0; n < self->hopsize; n++)
-            {
-                self->outbuf[n] = 0.0;
-            }
-
-            for (k = 0; k < self->num; k++)
-            {
-                bin = k * self->inc + self->first;
-
-                if (bin < self->hsize)
-                {
-                    tamp = magn[self->overcount][bin];
-                    tfreq = freq[self->overcount][bin] * pitch;
-                    inca = (tamp - self->amp[k]) / self->hopsize;
-                    incf = (tfreq - self->freq[k]) / self->hopsize;
-
-                    for (n = 0; n < self->hopsize; n++)
-                    {
-                        self->ppos[k] += self->freq[k] * ratio;
-
-                        while (self->ppos[k] < 0.0) self->ppos[k] += 8192.0;
-
-                        while (self->ppos[k] >= 8192.0) self->ppos[k] -= 8192.0;
-
-                        ipart = (int)self->ppos[k];
-                        fpart = self->ppos[k] - ipart;
-                        self->outbuf[n] += self->amp[k] * (self->table[ipart] + (self->table[ipart + 1] - self->table[ipart]) * fpart);
-                        self->amp[k] += inca;
-                        self->freq[k] += incf;
-                    }
-                }
-            }
-
-            self->overcount++;
-
-            if (self->overcount >= self->olaps)
-                self->overcount = 0;
+            PVAddSynth_synthesize(self, pitch, magn, freq);
         }
     }
 }
@@ -1110,8 +1082,7 @@ PVAddSynth_process_i(PVAddSynth *self)
 static void
 PVAddSynth_process_a(PVAddSynth *self)
 {
-    int i, k, n, bin, ipart;
-    MYFLT pitch, tamp, tfreq, inca, incf, ratio, fpart;
+    int i;
     MYFLT **magn = PVStream_getMagn((PVStream *)self->input_stream);
     MYFLT **freq = PVStream_getFreq((PVStream *)self->input_stream);
     int *count = PVStream_getCount((PVStream *)self->input_stream);
@@ -1127,53 +1098,13 @@ PVAddSynth_process_a(PVAddSynth *self)
         PVAddSynth_realloc_memories(self);
     }
 
-    ratio = 8192.0 / self->sr;
-
     for (i = 0; i < self->bufsize; i++)
     {
         self->data[i] = self->outbuf[count[i] - self->inputLatency];
 
         if (count[i] >= (self->size - 1))
         {
-            pitch = pit[i];
-
-            for (n = 0; n < self->hopsize; n++)
-            {
-                self->outbuf[n] = 0.0;
-            }
-
-            for (k = 0; k < self->num; k++)
-            {
-                bin = k * self->inc + self->first;
-
-                if (bin < self->hsize)
-                {
-                    tamp = magn[self->overcount][bin];
-                    tfreq = freq[self->overcount][bin] * pitch;
-                    inca = (tamp - self->amp[k]) / self->hopsize;
-                    incf = (tfreq - self->freq[k]) / self->hopsize;
-
-                    for (n = 0; n < self->hopsize; n++)
-                    {
-                        self->ppos[k] += self->freq[k] * ratio;
-
-                        while (self->ppos[k] < 0.0) self->ppos[k] += 8192.0;
-
-                        while (self->ppos[k] >= 8192.0) self->ppos[k] -= 8192.0;
-
-                        ipart = (int)self->ppos[k];
-                        fpart = self->ppos[k] - ipart;
-                        self->outbuf[n] += self->amp[k] * (self->table[ipart] + (self->table[ipart + 1] - self->table[ipart]) * fpart);
-                        self->amp[k] += inca;
-                        self->freq[k] += incf;
-                    }
-                }
-            }
-
-            self->overcount++;
-
-            if (self->overcount >= self->olaps)
-                self->overcount = 0;
+            PVAddSynth_synthesize(self, pit[i], magn, freq);
         }
     }
 }
@@ -1275,10 +1206,9 @@ static void
 PVAddSynth_dealloc(PVAddSynth* self)
 {
     pyo_DEALLOC
-    PyMem_RawFree(self->ppos);
+    OscillatorBank_free(&self->bank);
     PyMem_RawFree(self->outbuf);
     PyMem_RawFree(self->table);
-    PyMem_RawFree(self->amp);
     PyMem_RawFree(self->freq);
     PVAddSynth_clear(self);
     Py_TYPE(self->stream)->tp_free((PyObject*)self->stream);
@@ -1362,6 +1292,7 @@ PVAddSynth_setInput(PVAddSynth *self, PyObject *arg)
         Py_RETURN_NONE;
     }
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->input);
 
     self->input = arg;
@@ -1369,6 +1300,7 @@ PVAddSynth_setInput(PVAddSynth *self, PyObject *arg)
     PyObject *input_streamtmp = PyObject_CallMethod((PyObject *)self->input, "_getPVStream", NULL);
     self->input_stream = (PVStream *)input_streamtmp;
     Py_INCREF(self->input_stream);
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -1596,8 +1528,8 @@ PVTranspose_realloc_memories(PVTranspose *self)
     {
         for (i = 0; i < self->last_olaps; i++)
         {
-            PyMem_RawFree(self->magn[i]);
-            PyMem_RawFree(self->freq[i]);
+            arena_free(self->magn[i]);
+            arena_free(self->freq[i]);
         }
     }
 
@@ -1606,8 +1538,8 @@ PVTranspose_realloc_memories(PVTranspose *self)
 
     for (i = 0; i < self->olaps; i++)
     {
-        self->magn[i] = (MYFLT *)PyMem_RawMalloc(self->hsize * sizeof(MYFLT));
-        self->freq[i] = (MYFLT *)PyMem_RawMalloc(self->hsize * sizeof(MYFLT));
+        self->magn[i] = (MYFLT *)arena_alloc(self->hsize * sizeof(MYFLT));
+        self->freq[i] = (MYFLT *)arena_alloc(self->hsize * sizeof(MYFLT));
 
         for (j = 0; j < self->hsize; j++)
             self->magn[i][j] = self->freq[i][j] = 0.0;
@@ -1778,8 +1710,8 @@ PVTranspose_dealloc(PVTranspose* self)
 
     for (i = 0; i < self->olaps; i++)
     {
-        PyMem_RawFree(self->magn[i]);
-        PyMem_RawFree(self->freq[i]);
+        arena_free(self->magn[i]);
+        arena_free(self->freq[i]);
     }
 
     PyMem_RawFree(self->magn);
@@ -1857,6 +1789,7 @@ PVTranspose_setInput(PVTranspose *self, PyObject *arg)
         Py_RETURN_NONE;
     }
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->input);
 
     self->input = arg;
@@ -1864,6 +1797,7 @@ PVTranspose_setInput(PVTranspose *self, PyObject *arg)
     PyObject *input_streamtmp = PyObject_CallMethod((PyObject *)self->input, "_getPVStream", NULL);
     self->input_stream = (PVStream *)input_streamtmp;
     Py_INCREF(self->input_stream);
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -1980,8 +1914,8 @@ PVVerb_realloc_memories(PVVerb *self)
     {
         for (i = 0; i < self->last_olaps; i++)
         {
-            PyMem_RawFree(self->magn[i]);
-            PyMem_RawFree(self->freq[i]);
+            arena_free(self->magn[i]);
+            arena_free(self->freq[i]);
         }
     }
 
@@ -1990,8 +1924,8 @@ PVVerb_realloc_memories(PVVerb *self)
 
     for (i = 0; i < self->olaps; i++)
     {
-        self->magn[i] = (MYFLT *)PyMem_RawMalloc(self->hsize * sizeof(MYFLT));
-        self->freq[i] = (MYFLT *)PyMem_RawMalloc(self->hsize * sizeof(MYFLT));
+        self->magn[i] = (MYFLT *)arena_alloc(self->hsize * sizeof(MYFLT));
+        self->freq[i] = (MYFLT *)arena_alloc(self->hsize * sizeof(MYFLT));
 
         for (j = 0; j < self->hsize; j++)
             self->magn[i][j] = self->freq[i][j] = 0.0;
@@ -2350,8 +2284,8 @@ PVVerb_dealloc(PVVerb* self)
 
     for (i = 0; i < self->olaps; i++)
     {
-        PyMem_RawFree(self->magn[i]);
-        PyMem_RawFree(self->freq[i]);
+        arena_free(self->magn[i]);
+        arena_free(self->freq[i]);
     }
 
     PyMem_RawFree(self->magn);
@@ -2437,6 +2371,7 @@ PVVerb_setInput(PVVerb *self, PyObject *arg)
         Py_RETURN_NONE;
     }
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->input);
 
     self->input = arg;
@@ -2444,6 +2379,7 @@ PVVerb_setInput(PVVerb *self, PyObject *arg)
     PyObject *input_streamtmp = PyObject_CallMethod((PyObject *)self->input, "_getPVStream", NULL);
     self->input_stream = (PVStream *)input_streamtmp;
     Py_INCREF(self->input_stream);
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -2557,8 +2493,8 @@ PVGate_realloc_memories(PVGate *self)
     {
         for (i = 0; i < self->last_olaps; i++)
         {
-            PyMem_RawFree(self->magn[i]);
-            PyMem_RawFree(self->freq[i]);
+            arena_free(self->magn[i]);
+            arena_free(self->freq[i]);
         }
     }
 
@@ -2567,8 +2503,8 @@ PVGate_realloc_memories(PVGate *self)
 
     for (i = 0; i < self->olaps; i++)
     {
-        self->magn[i] = (MYFLT *)PyMem_RawMalloc(self->hsize * sizeof(MYFLT));
-        self->freq[i] = (MYFLT *)PyMem_RawMalloc(self->hsize * sizeof(MYFLT));
+        self->magn[i] = (MYFLT *)arena_alloc(self->hsize * sizeof(MYFLT));
+        self->freq[i] = (MYFLT *)arena_alloc(self->hsize * sizeof(MYFLT));
 
         for (j = 0; j < self->hsize; j++)
             self->magn[i][j] = self->freq[i][j] = 0.0;
@@ -2910,8 +2846,8 @@ PVGate_dealloc(PVGate* self)
 
     for (i = 0; i < self->olaps; i++)
     {
-        PyMem_RawFree(self->magn[i]);
-        PyMem_RawFree(self->freq[i]);
+        arena_free(self->magn[i]);
+        arena_free(self->freq[i]);
     }
 
     PyMem_RawFree(self->magn);
@@ -2996,6 +2932,7 @@ PVGate_setInput(PVGate *self, PyObject *arg)
         Py_RETURN_NONE;
     }
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->input);
 
     self->input = arg;
@@ -3003,6 +2940,7 @@ PVGate_setInput(PVGate *self, PyObject *arg)
     PyObject *input_streamtmp = PyObject_CallMethod((PyObject *)self->input, "_getPVStream", NULL);
     self->input_stream = (PVStream *)input_streamtmp;
     Py_INCREF(self->input_stream);
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -3129,8 +3067,8 @@ PVCross_realloc_memories(PVCross *self)
     {
         for (i = 0; i < self->last_olaps; i++)
         {
-            PyMem_RawFree(self->magn[i]);
-            PyMem_RawFree(self->freq[i]);
+            arena_free(self->magn[i]);
+            arena_free(self->freq[i]);
         }
     }
 
@@ -3139,8 +3077,8 @@ PVCross_realloc_memories(PVCross *self)
 
     for (i = 0; i < self->olaps; i++)
     {
-        self->magn[i] = (MYFLT *)PyMem_RawMalloc(self->hsize * sizeof(MYFLT));
-        self->freq[i] = (MYFLT *)PyMem_RawMalloc(self->hsize * sizeof(MYFLT));
+        self->magn[i] = (MYFLT *)arena_alloc(self->hsize * sizeof(MYFLT));
+        self->freq[i] = (MYFLT *)arena_alloc(self->hsize * sizeof(MYFLT));
 
         for (j = 0; j < self->hsize; j++)
             self->magn[i][j] = self->freq[i][j] = 0.0;
@@ -3293,8 +3231,8 @@ PVCross_dealloc(PVCross* self)
 
     for (i = 0; i < self->olaps; i++)
     {
-        PyMem_RawFree(self->magn[i]);
-        PyMem_RawFree(self->freq[i]);
+        arena_free(self->magn[i]);
+        arena_free(self->freq[i]);
     }
 
     PyMem_RawFree(self->magn);
@@ -3380,6 +3318,7 @@ PVCross_setInput(PVCross *self, PyObject *arg)
         Py_RETURN_NONE;
     }
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->input);
 
     self->input = arg;
@@ -3387,6 +3326,7 @@ PVCross_setInput(PVCross *self, PyObject *arg)
     PyObject *input_streamtmp = PyObject_CallMethod((PyObject *)self->input, "_getPVStream", NULL);
     self->input_stream = (PVStream *)input_streamtmp;
     Py_INCREF(self->input_stream);
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -3400,6 +3340,7 @@ PVCross_setInput2(PVCross *self, PyObject *arg)
         Py_RETURN_NONE;
     }
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->input2);
 
     self->input2 = arg;
@@ -3407,6 +3348,7 @@ PVCross_setInput2(PVCross *self, PyObject *arg)
     PyObject *input_streamtmp = PyObject_CallMethod((PyObject *)self->input2, "_getPVStream", NULL);
     self->input2_stream = (PVStream *)input_streamtmp;
     Py_INCREF(self->input2_stream);
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -3515,8 +3457,8 @@ PVMult_realloc_memories(PVMult *self)
     {
         for (i = 0; i < self->last_olaps; i++)
         {
-            PyMem_RawFree(self->magn[i]);
-            PyMem_RawFree(self->freq[i]);
+            arena_free(self->magn[i]);
+            arena_free(self->freq[i]);
         }
     }
 
@@ -3525,8 +3467,8 @@ PVMult_realloc_memories(PVMult *self)
 
     for (i = 0; i < self->olaps; i++)
     {
-        self->magn[i] = (MYFLT *)PyMem_RawMalloc(self->hsize * sizeof(MYFLT));
-        self->freq[i] = (MYFLT *)PyMem_RawMalloc(self->hsize * sizeof(MYFLT));
+        self->magn[i] = (MYFLT *)arena_alloc(self->hsize * sizeof(MYFLT));
+        self->freq[i] = (MYFLT *)arena_alloc(self->hsize * sizeof(MYFLT));
 
         for (j = 0; j < self->hsize; j++)
             self->magn[i][j] = self->freq[i][j] = 0.0;
@@ -3621,8 +3563,8 @@ PVMult_dealloc(PVMult* self)
 
     for (i = 0; i < self->olaps; i++)
     {
-        PyMem_RawFree(self->magn[i]);
-        PyMem_RawFree(self->freq[i]);
+        arena_free(self->magn[i]);
+        arena_free(self->freq[i]);
     }
 
     PyMem_RawFree(self->magn);
@@ -3702,6 +3644,7 @@ PVMult_setInput(PVMult *self, PyObject *arg)
         Py_RETURN_NONE;
     }
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->input);
 
     self->input = arg;
@@ -3709,6 +3652,7 @@ PVMult_setInput(PVMult *self, PyObject *arg)
     PyObject *input_streamtmp = PyObject_CallMethod((PyObject *)self->input, "_getPVStream", NULL);
     self->input_stream = (PVStream *)input_streamtmp;
     Py_INCREF(self->input_stream);
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -3722,6 +3666,7 @@ PVMult_setInput2(PVMult *self, PyObject *arg)
         Py_RETURN_NONE;
     }
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->input2);
 
     self->input2 = arg;
@@ -3729,6 +3674,7 @@ PVMult_setInput2(PVMult *self, PyObject *arg)
     PyObject *input_streamtmp = PyObject_CallMethod((PyObject *)self->input2, "_getPVStream", NULL);
     self->input2_stream = (PVStream *)input_streamtmp;
     Py_INCREF(self->input2_stream);
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -3836,8 +3782,8 @@ PVMorph_realloc_memories(PVMorph *self)
     {
         for (i = 0; i < self->last_olaps; i++)
         {
-            PyMem_RawFree(self->magn[i]);
-            PyMem_RawFree(self->freq[i]);
+            arena_free(self->magn[i]);
+            arena_free(self->freq[i]);
         }
     }
 
@@ -3846,8 +3792,8 @@ PVMorph_realloc_memories(PVMorph *self)
 
     for (i = 0; i < self->olaps; i++)
     {
-        self->magn[i] = (MYFLT *)PyMem_RawMalloc(self->hsize * sizeof(MYFLT));
-        self->freq[i] = (MYFLT *)PyMem_RawMalloc(self->hsize * sizeof(MYFLT));
+        self->magn[i] = (MYFLT *)arena_alloc(self->hsize * sizeof(MYFLT));
+        self->freq[i] = (MYFLT *)arena_alloc(self->hsize * sizeof(MYFLT));
 
         for (j = 0; j < self->hsize; j++)
             self->magn[i][j] = self->freq[i][j] = 0.0;
@@ -4010,8 +3956,8 @@ PVMorph_dealloc(PVMorph* self)
 
     for (i = 0; i < self->olaps; i++)
     {
-        PyMem_RawFree(self->magn[i]);
-        PyMem_RawFree(self->freq[i]);
+        arena_free(self->magn[i]);
+        arena_free(self->freq[i]);
     }
 
     PyMem_RawFree(self->magn);
@@ -4097,6 +4043,7 @@ PVMorph_setInput(PVMorph *self, PyObject *arg)
         Py_RETURN_NONE;
     }
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->input);
 
     self->input = arg;
@@ -4104,6 +4051,7 @@ PVMorph_setInput(PVMorph *self, PyObject *arg)
     PyObject *input_streamtmp = PyObject_CallMethod((PyObject *)self->input, "_getPVStream", NULL);
     self->input_stream = (PVStream *)input_streamtmp;
     Py_INCREF(self->input_stream);
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -4117,6 +4065,7 @@ PVMorph_setInput2(PVMorph *self, PyObject *arg)
         Py_RETURN_NONE;
     }
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->input2);
 
     self->input2 = arg;
@@ -4124,6 +4073,7 @@ PVMorph_setInput2(PVMorph *self, PyObject *arg)
     PyObject *input_streamtmp = PyObject_CallMethod((PyObject *)self->input2, "_getPVStream", NULL);
     self->input2_stream = (PVStream *)input_streamtmp;
     Py_INCREF(self->input2_stream);
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -4235,8 +4185,8 @@ PVFilter_realloc_memories(PVFilter *self)
     {
         for (i = 0; i < self->last_olaps; i++)
         {
-            PyMem_RawFree(self->magn[i]);
-            PyMem_RawFree(self->freq[i]);
+            arena_free(self->magn[i]);
+            arena_free(self->freq[i]);
         }
     }
 
@@ -4245,8 +4195,8 @@ PVFilter_realloc_memories(PVFilter *self)
 
     for (i = 0; i < self->olaps; i++)
     {
-        self->magn[i] = (MYFLT *)PyMem_RawMalloc(self->hsize * sizeof(MYFLT));
-        self->freq[i] = (MYFLT *)PyMem_RawMalloc(self->hsize * sizeof(MYFLT));
+        self->magn[i] = (MYFLT *)arena_alloc(self->hsize * sizeof(MYFLT));
+        self->freq[i] = (MYFLT *)arena_alloc(self->hsize * sizeof(MYFLT));
 
         for (j = 0; j < self->hsize; j++)
             self->magn[i][j] = self->freq[i][j] = 0.0;
@@ -4455,8 +4405,8 @@ PVFilter_dealloc(PVFilter* self)
 
     for (i = 0; i < self->olaps; i++)
     {
-        PyMem_RawFree(self->magn[i]);
-        PyMem_RawFree(self->freq[i]);
+        arena_free(self->magn[i]);
+        arena_free(self->freq[i]);
     }
 
     PyMem_RawFree(self->magn);
@@ -4538,6 +4488,7 @@ PVFilter_setInput(PVFilter *self, PyObject *arg)
         Py_RETURN_NONE;
     }
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->input);
 
     self->input = arg;
@@ -4545,6 +4496,7 @@ PVFilter_setInput(PVFilter *self, PyObject *arg)
     PyObject *input_streamtmp = PyObject_CallMethod((PyObject *)self->input, "_getPVStream", NULL);
     self->input_stream = (PVStream *)input_streamtmp;
     Py_INCREF(self->input_stream);
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -4563,8 +4515,10 @@ PVFilter_setTable(PVFilter *self, PyObject *arg)
 {
     ASSERT_ARG_NOT_NULL
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->table);
     self->table = PyObject_CallMethod((PyObject *)arg, "getTableStream", "");
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -4700,13 +4654,13 @@ PVDelay_realloc_memories(PVDelay *self)
     {
         for (i = 0; i < self->last_olaps; i++)
         {
-            PyMem_RawFree(self->magn[i]);
-            PyMem_RawFree(self->freq[i]);
+            arena_free(self->magn[i]);
+            arena_free(self->freq[i]);
         }
         for (i = 0; i < self->last_numFrames; i++)
         {
-            PyMem_RawFree(self->magn_buf[i]);
-            PyMem_RawFree(self->freq_buf[i]);
+            arena_free(self->magn_buf[i]);
+            arena_free(self->freq_buf[i]);
         }
     }
 
@@ -4715,8 +4669,8 @@ PVDelay_realloc_memories(PVDelay *self)
 
     for (i = 0; i < self->olaps; i++)
     {
-        self->magn[i] = (MYFLT *)PyMem_RawMalloc(self->hsize * sizeof(MYFLT));
-        self->freq[i] = (MYFLT *)PyMem_RawMalloc(self->hsize * sizeof(MYFLT));
+        self->magn[i] = (MYFLT *)arena_alloc(self->hsize * sizeof(MYFLT));
+        self->freq[i] = (MYFLT *)arena_alloc(self->hsize * sizeof(MYFLT));
 
         for (j = 0; j < self->hsize; j++)
             self->magn[i][j] = self->freq[i][j] = 0.0;
@@ -4727,8 +4681,8 @@ PVDelay_realloc_memories(PVDelay *self)
 
     for (i = 0; i < self->numFrames; i++)
     {
-        self->magn_buf[i] = (MYFLT *)PyMem_RawMalloc(self->hsize * sizeof(MYFLT));
-        self->freq_buf[i] = (MYFLT *)PyMem_RawMalloc(self->hsize * sizeof(MYFLT));
+        self->magn_buf[i] = (MYFLT *)arena_alloc(self->hsize * sizeof(MYFLT));
+        self->freq_buf[i] = (MYFLT *)arena_alloc(self->hsize * sizeof(MYFLT));
 
         for (j = 0; j < self->hsize; j++)
             self->magn_buf[i][j] = self->freq_buf[i][j] = 0.0;
@@ -4956,8 +4910,8 @@ PVDelay_dealloc(PVDelay* self)
 
     for (i = 0; i < self->olaps; i++)
     {
-        PyMem_RawFree(self->magn[i]);
-        PyMem_RawFree(self->freq[i]);
+        arena_free(self->magn[i]);
+        arena_free(self->freq[i]);
     }
 
     PyMem_RawFree(self->magn);
@@ -4965,8 +4919,8 @@ PVDelay_dealloc(PVDelay* self)
 
     for (i = 0; i < self->numFrames; i++)
     {
-        PyMem_RawFree(self->magn_buf[i]);
-        PyMem_RawFree(self->freq_buf[i]);
+        arena_free(self->magn_buf[i]);
+        arena_free(self->freq_buf[i]);
     }
 
     PyMem_RawFree(self->magn_buf);
@@ -5048,6 +5002,7 @@ PVDelay_setInput(PVDelay *self, PyObject *arg)
         Py_RETURN_NONE;
     }
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->input);
 
     self->input = arg;
@@ -5055,6 +5010,7 @@ PVDelay_setInput(PVDelay *self, PyObject *arg)
     PyObject *input_streamtmp = PyObject_CallMethod((PyObject *)self->input, "_getPVStream", NULL);
     self->input_stream = (PVStream *)input_streamtmp;
     Py_INCREF(self->input_stream);
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -5071,8 +5027,10 @@ PVDelay_setDeltable(PVDelay *self, PyObject *arg)
 {
     ASSERT_ARG_NOT_NULL
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->deltable);
     self->deltable = PyObject_CallMethod((PyObject *)arg, "getTableStream", "");
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -5089,8 +5047,10 @@ PVDelay_setFeedtable(PVDelay *self, PyObject *arg)
 {
     ASSERT_ARG_NOT_NULL
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->feedtable);
     self->feedtable = PyObject_CallMethod((PyObject *)arg, "getTableStream", "");
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -5231,13 +5191,13 @@ PVBuffer_realloc_memories(PVBuffer *self)
     {
         for (i = 0; i < self->last_olaps; i++)
         {
-            PyMem_RawFree(self->magn[i]);
-            PyMem_RawFree(self->freq[i]);
+            arena_free(self->magn[i]);
+            arena_free(self->freq[i]);
         }
         for (i = 0; i < self->last_numFrames; i++)
         {
-            PyMem_RawFree(self->magn_buf[i]);
-            PyMem_RawFree(self->freq_buf[i]);
+            arena_free(self->magn_buf[i]);
+            arena_free(self->freq_buf[i]);
         }
     }
 
@@ -5246,8 +5206,8 @@ PVBuffer_realloc_memories(PVBuffer *self)
 
     for (i = 0; i < self->olaps; i++)
     {
-        self->magn[i] = (MYFLT *)PyMem_RawMalloc(self->hsize * sizeof(MYFLT));
-        self->freq[i] = (MYFLT *)PyMem_RawMalloc(self->hsize * sizeof(MYFLT));
+        self->magn[i] = (MYFLT *)arena_alloc(self->hsize * sizeof(MYFLT));
+        self->freq[i] = (MYFLT *)arena_alloc(self->hsize * sizeof(MYFLT));
 
         for (j = 0; j < self->hsize; j++)
             self->magn[i][j] = self->freq[i][j] = 0.0;
@@ -5258,8 +5218,8 @@ PVBuffer_realloc_memories(PVBuffer *self)
 
     for (i = 0; i < self->numFrames; i++)
     {
-        self->magn_buf[i] = (MYFLT *)PyMem_RawMalloc(self->hsize * sizeof(MYFLT));
-        self->freq_buf[i] = (MYFLT *)PyMem_RawMalloc(self->hsize * sizeof(MYFLT));
+        self->magn_buf[i] = (MYFLT *)arena_alloc(self->hsize * sizeof(MYFLT));
+        self->freq_buf[i] = (MYFLT *)arena_alloc(self->hsize * sizeof(MYFLT));
 
         for (j = 0; j < self->hsize; j++)
             self->magn_buf[i][j] = self->freq_buf[i][j] = 0.0;
@@ -5474,8 +5434,8 @@ PVBuffer_dealloc(PVBuffer* self)
 
     for (i = 0; i < self->olaps; i++)
     {
-        PyMem_RawFree(self->magn[i]);
-        PyMem_RawFree(self->freq[i]);
+        arena_free(self->magn[i]);
+        arena_free(self->freq[i]);
     }
 
     PyMem_RawFree(self->magn);
@@ -5483,8 +5443,8 @@ PVBuffer_dealloc(PVBuffer* self)
 
     for (i = 0; i < self->numFrames; i++)
     {
-        PyMem_RawFree(self->magn_buf[i]);
-        PyMem_RawFree(self->freq_buf[i]);
+        arena_free(self->magn_buf[i]);
+        arena_free(self->freq_buf[i]);
     }
 
     PyMem_RawFree(self->magn_buf);
@@ -5576,6 +5536,7 @@ PVBuffer_setInput(PVBuffer *self, PyObject *arg)
         Py_RETURN_NONE;
     }
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->input);
 
     self->input = arg;
@@ -5583,6 +5544,7 @@ PVBuffer_setInput(PVBuffer *self, PyObject *arg)
     PyObject *input_streamtmp = PyObject_CallMethod((PyObject *)self->input, "_getPVStream", NULL);
     self->input_stream = (PVStream *)input_streamtmp;
     Py_INCREF(self->input_stream);
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -5598,6 +5560,7 @@ PVBuffer_setIndex(PVBuffer *self, PyObject *arg)
         Py_RETURN_NONE;
     }
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->index);
 
     self->index = arg;
@@ -5605,6 +5568,8 @@ PVBuffer_setIndex(PVBuffer *self, PyObject *arg)
     PyObject *streamtmp = PyObject_CallMethod((PyObject *)self->index, "_getStream", NULL);
     self->index_stream = (Stream *)streamtmp;
     Py_INCREF(self->index_stream);
+    Stream_invalidateGraph();
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -5731,8 +5696,8 @@ PVShift_realloc_memories(PVShift *self)
     {
         for (i = 0; i < self->last_olaps; i++)
         {
-            PyMem_RawFree(self->magn[i]);
-            PyMem_RawFree(self->freq[i]);
+            arena_free(self->magn[i]);
+            arena_free(self->freq[i]);
         }
     }
 
@@ -5741,8 +5706,8 @@ PVShift_realloc_memories(PVShift *self)
 
     for (i = 0; i < self->olaps; i++)
     {
-        self->magn[i] = (MYFLT *)PyMem_RawMalloc(self->hsize * sizeof(MYFLT));
-        self->freq[i] = (MYFLT *)PyMem_RawMalloc(self->hsize * sizeof(MYFLT));
+        self->magn[i] = (MYFLT *)arena_alloc(self->hsize * sizeof(MYFLT));
+        self->freq[i] = (MYFLT *)arena_alloc(self->hsize * sizeof(MYFLT));
 
         for (j = 0; j < self->hsize; j++)
             self->magn[i][j] = self->freq[i][j] = 0.0;
@@ -5919,8 +5884,8 @@ PVShift_dealloc(PVShift* self)
 
     for (i = 0; i < self->olaps; i++)
     {
-        PyMem_RawFree(self->magn[i]);
-        PyMem_RawFree(self->freq[i]);
+        arena_free(self->magn[i]);
+        arena_free(self->freq[i]);
     }
 
     PyMem_RawFree(self->magn);
@@ -5998,6 +5963,7 @@ PVShift_setInput(PVShift *self, PyObject *arg)
         Py_RETURN_NONE;
     }
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->input);
 
     self->input = arg;
@@ -6005,6 +5971,7 @@ PVShift_setInput(PVShift *self, PyObject *arg)
     PyObject *input_streamtmp = PyObject_CallMethod((PyObject *)self->input, "_getPVStream", NULL);
     self->input_stream = (PVStream *)input_streamtmp;
     Py_INCREF(self->input_stream);
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -6205,8 +6172,8 @@ PVAmpMod_realloc_memories(PVAmpMod *self)
     {
         for (i = 0; i < self->last_olaps; i++)
         {
-            PyMem_RawFree(self->magn[i]);
-            PyMem_RawFree(self->freq[i]);
+            arena_free(self->magn[i]);
+            arena_free(self->freq[i]);
         }
     }
 
@@ -6220,8 +6187,8 @@ PVAmpMod_realloc_memories(PVAmpMod *self)
 
     for (i = 0; i < self->olaps; i++)
     {
-        self->magn[i] = (MYFLT *)PyMem_RawMalloc(self->hsize * sizeof(MYFLT));
-        self->freq[i] = (MYFLT *)PyMem_RawMalloc(self->hsize * sizeof(MYFLT));
+        self->magn[i] = (MYFLT *)arena_alloc(self->hsize * sizeof(MYFLT));
+        self->freq[i] = (MYFLT *)arena_alloc(self->hsize * sizeof(MYFLT));
 
         for (j = 0; j < self->hsize; j++)
             self->magn[i][j] = self->freq[i][j] = 0.0;
@@ -6515,8 +6482,8 @@ PVAmpMod_dealloc(PVAmpMod* self)
 
     for (i = 0; i < self->olaps; i++)
     {
-        PyMem_RawFree(self->magn[i]);
-        PyMem_RawFree(self->freq[i]);
+        arena_free(self->magn[i]);
+        arena_free(self->freq[i]);
     }
 
     PyMem_RawFree(self->magn);
@@ -6605,6 +6572,7 @@ PVAmpMod_setInput(PVAmpMod *self, PyObject *arg)
         Py_RETURN_NONE;
     }
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->input);
 
     self->input = arg;
@@ -6612,6 +6580,7 @@ PVAmpMod_setInput(PVAmpMod *self, PyObject *arg)
     PyObject *input_streamtmp = PyObject_CallMethod((PyObject *)self->input, "_getPVStream", NULL);
     self->input_stream = (PVStream *)input_streamtmp;
     Py_INCREF(self->input_stream);
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -6756,8 +6725,8 @@ PVFreqMod_realloc_memories(PVFreqMod *self)
     {
         for (i = 0; i < self->last_olaps; i++)
         {
-            PyMem_RawFree(self->magn[i]);
-            PyMem_RawFree(self->freq[i]);
+            arena_free(self->magn[i]);
+            arena_free(self->freq[i]);
         }
     }
 
@@ -6771,8 +6740,8 @@ PVFreqMod_realloc_memories(PVFreqMod *self)
 
     for (i = 0; i < self->olaps; i++)
     {
-        self->magn[i] = (MYFLT *)PyMem_RawMalloc(self->hsize * sizeof(MYFLT));
-        self->freq[i] = (MYFLT *)PyMem_RawMalloc(self->hsize * sizeof(MYFLT));
+        self->magn[i] = (MYFLT *)arena_alloc(self->hsize * sizeof(MYFLT));
+        self->freq[i] = (MYFLT *)arena_alloc(self->hsize * sizeof(MYFLT));
 
         for (j = 0; j < self->hsize; j++)
             self->magn[i][j] = self->freq[i][j] = 0.0;
@@ -7161,8 +7130,8 @@ PVFreqMod_dealloc(PVFreqMod* self)
 
     for (i = 0; i < self->olaps; i++)
     {
-        PyMem_RawFree(self->magn[i]);
-        PyMem_RawFree(self->freq[i]);
+        arena_free(self->magn[i]);
+        arena_free(self->freq[i]);
     }
 
     PyMem_RawFree(self->magn);
@@ -7257,6 +7226,7 @@ PVFreqMod_setInput(PVFreqMod *self, PyObject *arg)
         Py_RETURN_NONE;
     }
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->input);
 
     self->input = arg;
@@ -7264,6 +7234,7 @@ PVFreqMod_setInput(PVFreqMod *self, PyObject *arg)
     PyObject *input_streamtmp = PyObject_CallMethod((PyObject *)self->input, "_getPVStream", NULL);
     self->input_stream = (PVStream *)input_streamtmp;
     Py_INCREF(self->input_stream);
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -7421,13 +7392,13 @@ PVBufLoops_realloc_memories(PVBufLoops *self)
     {
         for (i = 0; i < self->last_olaps; i++)
         {
-            PyMem_RawFree(self->magn[i]);
-            PyMem_RawFree(self->freq[i]);
+            arena_free(self->magn[i]);
+            arena_free(self->freq[i]);
         }
         for (i = 0; i < self->last_numFrames; i++)
         {
-            PyMem_RawFree(self->magn_buf[i]);
-            PyMem_RawFree(self->freq_buf[i]);
+            arena_free(self->magn_buf[i]);
+            arena_free(self->freq_buf[i]);
         }
     }
 
@@ -7445,8 +7416,8 @@ PVBufLoops_realloc_memories(PVBufLoops *self)
 
     for (i = 0; i < self->olaps; i++)
     {
-        self->magn[i] = (MYFLT *)PyMem_RawMalloc(self->hsize * sizeof(MYFLT));
-        self->freq[i] = (MYFLT *)PyMem_RawMalloc(self->hsize * sizeof(MYFLT));
+        self->magn[i] = (MYFLT *)arena_alloc(self->hsize * sizeof(MYFLT));
+        self->freq[i] = (MYFLT *)arena_alloc(self->hsize * sizeof(MYFLT));
 
         for (j = 0; j < self->hsize; j++)
             self->magn[i][j] = self->freq[i][j] = 0.0;
@@ -7457,8 +7428,8 @@ PVBufLoops_realloc_memories(PVBufLoops *self)
 
     for (i = 0; i < self->numFrames; i++)
     {
-        self->magn_buf[i] = (MYFLT *)PyMem_RawMalloc(self->hsize * sizeof(MYFLT));
-        self->freq_buf[i] = (MYFLT *)PyMem_RawMalloc(self->hsize * sizeof(MYFLT));
+        self->magn_buf[i] = (MYFLT *)arena_alloc(self->hsize * sizeof(MYFLT));
+        self->freq_buf[i] = (MYFLT *)arena_alloc(self->hsize * sizeof(MYFLT));
 
         for (j = 0; j < self->hsize; j++)
             self->magn_buf[i][j] = self->freq_buf[i][j] = 0.0;
@@ -7689,8 +7660,8 @@ PVBufLoops_dealloc(PVBufLoops* self)
 
     for (i = 0; i < self->olaps; i++)
     {
-        PyMem_RawFree(self->magn[i]);
-        PyMem_RawFree(self->freq[i]);
+        arena_free(self->magn[i]);
+        arena_free(self->freq[i]);
     }
 
     PyMem_RawFree(self->magn);
@@ -7698,8 +7669,8 @@ PVBufLoops_dealloc(PVBufLoops* self)
 
     for (i = 0; i < self->numFrames; i++)
     {
-        PyMem_RawFree(self->magn_buf[i]);
-        PyMem_RawFree(self->freq_buf[i]);
+        arena_free(self->magn_buf[i]);
+        arena_free(self->freq_buf[i]);
     }
 
     PyMem_RawFree(self->magn_buf);
@@ -7733,6 +7704,7 @@ PVBufLoops_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->length = 1.0;
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, PVBufLoops_compute_next_data_frame);
+    Stream_setSerial(self->stream, 1);
     self->mode_func_ptr = PVBufLoops_setProcMode;
 
     static char *kwlist[] = {"input", "low", "high", "mode", "length", NULL};
@@ -7800,6 +7772,7 @@ PVBufLoops_setInput(PVBufLoops *self, PyObject *arg)
         Py_RETURN_NONE;
     }
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->input);
 
     self->input = arg;
@@ -7807,6 +7780,7 @@ PVBufLoops_setInput(PVBufLoops *self, PyObject *arg)
     PyObject *input_streamtmp = PyObject_CallMethod((PyObject *)self->input, "_getPVStream", NULL);
     self->input_stream = (PVStream *)input_streamtmp;
     Py_INCREF(self->input_stream);
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -7957,13 +7931,13 @@ PVBufTabLoops_realloc_memories(PVBufTabLoops *self)
     {
         for (i = 0; i < self->last_olaps; i++)
         {
-            PyMem_RawFree(self->magn[i]);
-            PyMem_RawFree(self->freq[i]);
+            arena_free(self->magn[i]);
+            arena_free(self->freq[i]);
         }
         for (i = 0; i < self->last_numFrames; i++)
         {
-            PyMem_RawFree(self->magn_buf[i]);
-            PyMem_RawFree(self->freq_buf[i]);
+            arena_free(self->magn_buf[i]);
+            arena_free(self->freq_buf[i]);
         }
     }
 
@@ -7979,8 +7953,8 @@ PVBufTabLoops_realloc_memories(PVBufTabLoops *self)
 
     for (i = 0; i < self->olaps; i++)
     {
-        self->magn[i] = (MYFLT *)PyMem_RawMalloc(self->hsize * sizeof(MYFLT));
-        self->freq[i] = (MYFLT *)PyMem_RawMalloc(self->hsize * sizeof(MYFLT));
+        self->magn[i] = (MYFLT *)arena_alloc(self->hsize * sizeof(MYFLT));
+        self->freq[i] = (MYFLT *)arena_alloc(self->hsize * sizeof(MYFLT));
 
         for (j = 0; j < self->hsize; j++)
             self->magn[i][j] = self->freq[i][j] = 0.0;
@@ -7991,8 +7965,8 @@ PVBufTabLoops_realloc_memories(PVBufTabLoops *self)
 
     for (i = 0; i < self->numFrames; i++)
     {
-        self->magn_buf[i] = (MYFLT *)PyMem_RawMalloc(self->hsize * sizeof(MYFLT));
-        self->freq_buf[i] = (MYFLT *)PyMem_RawMalloc(self->hsize * sizeof(MYFLT));
+        self->magn_buf[i] = (MYFLT *)arena_alloc(self->hsize * sizeof(MYFLT));
+        self->freq_buf[i] = (MYFLT *)arena_alloc(self->hsize * sizeof(MYFLT));
 
         for (j = 0; j < self->hsize; j++)
             self->magn_buf[i][j] = self->freq_buf[i][j] = 0.0;
@@ -8118,8 +8092,8 @@ PVBufTabLoops_dealloc(PVBufTabLoops* self)
 
     for (i = 0; i < self->olaps; i++)
     {
-        PyMem_RawFree(self->magn[i]);
-        PyMem_RawFree(self->freq[i]);
+        arena_free(self->magn[i]);
+        arena_free(self->freq[i]);
     }
 
     PyMem_RawFree(self->magn);
@@ -8127,8 +8101,8 @@ PVBufTabLoops_dealloc(PVBufTabLoops* self)
 
     for (i = 0; i < self->numFrames; i++)
     {
-        PyMem_RawFree(self->magn_buf[i]);
-        PyMem_RawFree(self->freq_buf[i]);
+        arena_free(self->magn_buf[i]);
+        arena_free(self->freq_buf[i]);
     }
 
     PyMem_RawFree(self->magn_buf);
@@ -8216,6 +8190,7 @@ PVBufTabLoops_setInput(PVBufTabLoops *self, PyObject *arg)
         Py_RETURN_NONE;
     }
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->input);
 
     self->input = arg;
@@ -8223,6 +8198,7 @@ PVBufTabLoops_setInput(PVBufTabLoops *self, PyObject *arg)
     PyObject *input_streamtmp = PyObject_CallMethod((PyObject *)self->input, "_getPVStream", NULL);
     self->input_stream = (PVStream *)input_streamtmp;
     Py_INCREF(self->input_stream);
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -8232,8 +8208,10 @@ PVBufTabLoops_setSpeed(PVBufTabLoops *self, PyObject *arg)
 {
     ASSERT_ARG_NOT_NULL
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->speed);
     self->speed = PyObject_CallMethod((PyObject *)arg, "getTableStream", "");
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -8350,8 +8328,8 @@ PVMix_realloc_memories(PVMix *self)
     {
         for (i = 0; i < self->last_olaps; i++)
         {
-            PyMem_RawFree(self->magn[i]);
-            PyMem_RawFree(self->freq[i]);
+            arena_free(self->magn[i]);
+            arena_free(self->freq[i]);
         }
     }
 
@@ -8360,8 +8338,8 @@ PVMix_realloc_memories(PVMix *self)
 
     for (i = 0; i < self->olaps; i++)
     {
-        self->magn[i] = (MYFLT *)PyMem_RawMalloc(self->hsize * sizeof(MYFLT));
-        self->freq[i] = (MYFLT *)PyMem_RawMalloc(self->hsize * sizeof(MYFLT));
+        self->magn[i] = (MYFLT *)arena_alloc(self->hsize * sizeof(MYFLT));
+        self->freq[i] = (MYFLT *)arena_alloc(self->hsize * sizeof(MYFLT));
 
         for (j = 0; j < self->hsize; j++)
             self->magn[i][j] = self->freq[i][j] = 0.0;
@@ -8465,8 +8443,8 @@ PVMix_dealloc(PVMix* self)
 
     for (i = 0; i < self->olaps; i++)
     {
-        PyMem_RawFree(self->magn[i]);
-        PyMem_RawFree(self->freq[i]);
+        arena_free(self->magn[i]);
+        arena_free(self->freq[i]);
     }
 
     PyMem_RawFree(self->magn);
@@ -8546,6 +8524,7 @@ PVMix_setInput(PVMix *self, PyObject *arg)
         Py_RETURN_NONE;
     }
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->input);
 
     self->input = arg;
@@ -8553,6 +8532,7 @@ PVMix_setInput(PVMix *self, PyObject *arg)
     PyObject *input_streamtmp = PyObject_CallMethod((PyObject *)self->input, "_getPVStream", NULL);
     self->input_stream = (PVStream *)input_streamtmp;
     Py_INCREF(self->input_stream);
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -8566,6 +8546,7 @@ PVMix_setInput2(PVMix *self, PyObject *arg)
         Py_RETURN_NONE;
     }
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->input2);
 
     self->input2 = arg;
@@ -8573,6 +8554,7 @@ PVMix_setInput2(PVMix *self, PyObject *arg)
     PyObject *input_streamtmp = PyObject_CallMethod((PyObject *)self->input2, "_getPVStream", NULL);
     self->input2_stream = (PVStream *)input_streamtmp;
     Py_INCREF(self->input2_stream);
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
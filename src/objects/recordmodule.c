@@ -36,6 +36,7 @@ typedef struct
 {
     pyo_audio_HEAD
     PyObject *input_list;
+    PyObject *input_stream_list;
     int chnls;
     int buffering;
     int count;
@@ -43,6 +44,8 @@ typedef struct
     char *recpath;
     SNDFILE *recfile;
     SF_INFO recinfo;
+    PyoDiskStream *diskstream;
+    unsigned long overruns;
     MYFLT *buffer;
 } Record;
 
@@ -69,7 +72,7 @@ Record_process(Record *self)
     for (j = 0; j < self->listlen; j++)
     {
         chnl = j % self->chnls;
-        in = Stream_getData((Stream *)PyObject_CallMethod(PyList_GET_ITEM(self->input_list, j), "_getStream", NULL));
+        in = Stream_getData((Stream *)PyList_GET_ITEM(self->input_stream_list, j));
 
         for (i = 0; i < self->bufsize; i++)
         {
@@ -79,8 +82,45 @@ Record_process(Record *self)
 
     self->count++;
 
-    if (self->count == self->buffering)
-        SF_WRITE(self->recfile, self->buffer, totlen);
+    if (self->count == self->buffering && self->diskstream != NULL)
+        DiskStream_write(self->diskstream, self->buffer, totlen);
+}
+
+/* Detaches the ring buffer from the audio thread and closes the file. On
+   the control side, waits for the disk writer thread without the GIL. On the
+   audio thread (stop() called when the `wait` time of stop is elapsed, or by
+   a Python function called from the processing loop), the stream is only
+   detached and the disk writer thread closes the file later. */
+static void
+Record_close(Record *self)
+{
+    int audiothread;
+    unsigned long overruns;
+    PyoDiskStream *stream;
+
+    Server_lock_streams((Server *)self->server);
+    stream = self->diskstream;
+    self->diskstream = NULL;
+    audiothread = ((Server *)self->server)->stream_iterating;
+    Server_unlock_streams((Server *)self->server);
+
+    if (stream == NULL)
+        return;
+
+    if (audiothread)
+    {
+        self->overruns += DiskStream_getOverruns(stream);
+        DiskStream_release(stream);
+    }
+    else if (PyGILState_Check())
+    {
+        Py_BEGIN_ALLOW_THREADS
+        overruns = DiskStream_close(stream);
+        Py_END_ALLOW_THREADS
+        self->overruns += overruns;
+    }
+    else
+        self->overruns += DiskStream_close(stream);
 }
 
 static void
@@ -100,6 +140,7 @@ Record_traverse(Record *self, visitproc visit, void *arg)
 {
     pyo_VISIT
     Py_VISIT(self->input_list);
+    Py_VISIT(self->input_stream_list);
     return 0;
 }
 
@@ -108,6 +149,7 @@ Record_clear(Record *self)
 {
     pyo_CLEAR
     Py_CLEAR(self->input_list);
+    Py_CLEAR(self->input_stream_list);
     return 0;
 }
 
@@ -117,6 +159,8 @@ Record_dealloc(Record* self)
     if (Stream_getStreamActive(self->stream))
         PyObject_CallMethod((PyObject *)self, "stop", NULL);
 
+    Record_close(self);
+
     pyo_DEALLOC
     PyMem_RawFree(self->buffer);
     Record_clear(self);
@@ -127,12 +171,13 @@ Record_dealloc(Record* self)
 static PyObject *
 Record_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 {
-    int i, buflen;
+    int i, buflen, blocking;
+    long frames;
     int fileformat = 0;
     int sampletype = 0;
     double quality = 0.4;
     Py_ssize_t psize;
-    PyObject *input_listtmp;
+    PyObject *input_listtmp, *streamtmp;
     Record *self;
     self = (Record *)type->tp_alloc(type, 0);
 
@@ -153,6 +198,19 @@ Record_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     Py_INCREF(self->input_list);
     self->listlen = PyList_Size(self->input_list);
 
+    /* The streams are fetched once, the audio thread must not call Python. */
+    self->input_stream_list = PyList_New(self->listlen);
+
+    for (i = 0; i < self->listlen; i++)
+    {
+        streamtmp = PyObject_CallMethod(PyList_GET_ITEM(self->input_list, i), "_getStream", NULL);
+
+        if (streamtmp == NULL)
+            return NULL;
+
+        PyList_SET_ITEM(self->input_stream_list, i, streamtmp);
+    }
+
     /* Prepare sfinfo */
     self->recinfo.samplerate = (int)self->sr;
     self->recinfo.channels = self->chnls;
@@ -242,6 +300,21 @@ Record_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     buflen = self->bufsize * self->chnls * self->buffering;
     self->buffer = (MYFLT *)PyMem_RawRealloc(self->buffer, buflen * sizeof(MYFLT));
 
+    /* The ring buffer holds at least two writes. Non real time servers wait for the disk. */
+    frames = ((Server *)self->server)->recbufsize;
+
+    if (frames < self->bufsize * self->buffering * 2)
+        frames = self->bufsize * self->buffering * 2;
+
+    blocking = Server_isNonRealTime((Server *)self->server);
+
+    if ((self->diskstream = DiskStream_new(self->recfile, self->chnls, sizeof(MYFLT), frames, blocking)) == NULL)
+    {
+        PySys_WriteStdout("Record: not able to start the disk writer thread.\n");
+        sf_close(self->recfile);
+        Py_RETURN_NONE;
+    }
+
     for (i = 0; i < buflen; i++)
     {
         self->buffer[i] = 0.;
@@ -270,7 +343,7 @@ static PyObject * Record_stop(Record *self, PyObject *args, PyObject *kwds)
 
     if (wait == 0)
     {
-        sf_close(self->recfile);
+        Record_close(self);
         Stream_setStreamActive(self->stream, 0);
         Stream_setStreamChnl(self->stream, 0);
         Stream_setStreamToDac(self->stream, 0);
@@ -290,6 +363,12 @@ static PyObject * Record_stop(Record *self, PyObject *args, PyObject *kwds)
     Py_RETURN_NONE;
 };
 
+static PyObject *
+Record_getOverruns(Record *self)
+{
+    return PyLong_FromUnsignedLong(self->overruns + DiskStream_getOverruns(self->diskstream));
+}
+
 static PyMemberDef Record_members[] =
 {
     {"server", T_OBJECT_EX, offsetof(Record, server), 0, "Pyo server."},
@@ -304,6 +383,7 @@ static PyMethodDef Record_methods[] =
     {"_getStream", (PyCFunction)Record_getStream, METH_NOARGS, "Returns stream object."},
     {"play", (PyCFunction)Record_play, METH_VARARGS | METH_KEYWORDS, "Starts computing without sending sound to soundcard."},
     {"stop", (PyCFunction)Record_stop, METH_VARARGS | METH_KEYWORDS, "Stops computing."},
+    {"getOverruns", (PyCFunction)Record_getOverruns, METH_NOARGS, "Returns the number of blocks dropped because the disk was too slow."},
     {NULL}  /* Sentinel */
 };
 
@@ -462,6 +542,7 @@ ControlRec_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, ControlRec_compute_next_data_frame);
+    Stream_setNeedGIL(self->stream, 1);
     self->mode_func_ptr = ControlRec_setProcMode;
 
     static char *kwlist[] = {"input", "rate", "dur", NULL};
@@ -778,6 +859,7 @@ ControlRead_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, ControlRead_compute_next_data_frame);
+    Stream_setNeedGIL(self->stream, 1);
     self->mode_func_ptr = ControlRead_setProcMode;
 
     static char *kwlist[] = {"values", "rate", "loop", "interp", "mul", "add", NULL};
@@ -1122,6 +1204,7 @@ NoteinRec_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, NoteinRec_compute_next_data_frame);
+    Stream_setNeedGIL(self->stream, 1);
     self->mode_func_ptr = NoteinRec_setProcMode;
 
     static char *kwlist[] = {"inputp", "inputv", NULL};
@@ -1407,6 +1490,7 @@ NoteinRead_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, NoteinRead_compute_next_data_frame);
+    Stream_setNeedGIL(self->stream, 1);
     self->mode_func_ptr = NoteinRead_setProcMode;
 
     static char *kwlist[] = {"values", "timestamps", "loop", "mul", "add", NULL};
@@ -29,6 +29,7 @@
 #include "dummymodule.h"
 #include "sndfile.h"
 #include "interpolation.h"
+#include "diskreader.h"
 
 /* SfPlayer object */
 typedef struct
@@ -37,7 +38,7 @@ typedef struct
     PyObject *speed;
     Stream *speed_stream;
     int modebuffer[1];
-    SNDFILE *sf;
+    PyoDiskReader *reader;
     SF_INFO info;
     char *path;
     int loop;
@@ -61,7 +62,7 @@ SfPlayer_readframes_i(SfPlayer *self)
     MYFLT sp, frac, bufpos, delta, startPos;
     int i, j, shortbuflen, pad;
     T_SIZE_T totlen, buflen, bufindex;
-    sf_count_t index;
+    sf_count_t index, readPos;
 
     if (self->modebuffer[0] == 0)
         sp = PyFloat_AS_DOUBLE(self->speed);
@@ -100,7 +101,6 @@ SfPlayer_readframes_i(SfPlayer *self)
         }
 
         index = (sf_count_t)self->pointerPos;
-        sf_seek(self->sf, index, SEEK_SET); /* sets position pointer in the file */
 
         /* fill a buffer with enough samples to satisfy speed reading */
         /* if not enough samples left in the file */
@@ -108,7 +108,7 @@ SfPlayer_readframes_i(SfPlayer *self)
         {
             shortbuflen = self->sndSize - index;
             pad = (buflen - shortbuflen) * self->sndChnls;
-            SF_READ(self->sf, buffer, shortbuflen * self->sndChnls);
+            DiskReader_read(self->reader, index, buffer, shortbuflen);
 
             if (self->loop == 0)   /* with zero padding if noloop */
             {
@@ -120,8 +120,7 @@ SfPlayer_readframes_i(SfPlayer *self)
             else   /* wrap around and read new samples if loop */
             {
                 MYFLT buftemp[pad];
-                sf_seek(self->sf, (sf_count_t)self->startPos, SEEK_SET);
-                SF_READ(self->sf, buftemp, pad);
+                DiskReader_read(self->reader, (sf_count_t)self->startPos, buftemp, buflen - shortbuflen);
 
                 for (i = 0; i < pad; i++)
                 {
@@ -130,7 +129,11 @@ SfPlayer_readframes_i(SfPlayer *self)
             }
         }
         else /* without zero padding */
-            SF_READ(self->sf, buffer, totlen);
+            DiskReader_read(self->reader, index, buffer, buflen);
+
+        /* the next block and the loop point */
+        DiskReader_prefetch(self->reader, index + buflen + PYO_DISK_BLOCK_FRAMES);
+        DiskReader_prefetch(self->reader, (sf_count_t)self->startPos);
 
         /* de-interleave samples */
         for (i = 0; i < totlen; i++)
@@ -209,8 +212,7 @@ SfPlayer_readframes_i(SfPlayer *self)
             else   /* wrap around and read new samples if loop */
             {
                 MYFLT buftemp[padlen];
-                sf_seek(self->sf, (sf_count_t)startPos - pad, SEEK_SET);
-                SF_READ(self->sf, buftemp, padlen);
+                DiskReader_read(self->reader, (sf_count_t)startPos - pad, buftemp, pad);
 
                 for (i = 0; i < padlen; i++)
                 {
@@ -219,18 +221,24 @@ SfPlayer_readframes_i(SfPlayer *self)
             }
 
             MYFLT buftemp2[shortbuflen * self->sndChnls];
-            sf_seek(self->sf, 0, SEEK_SET); /* sets position pointer in the file */
-            SF_READ(self->sf, buftemp2, shortbuflen * self->sndChnls);
+            DiskReader_read(self->reader, 0, buftemp2, shortbuflen);
 
             for (i = 0; i < (shortbuflen * self->sndChnls); i++)
             {
                 buffer[i + padlen] = buftemp2[i];
             }
+
+            /* continues reading where the previous read stopped */
+            readPos = shortbuflen;
         }
         else /* without zero padding */
-            sf_seek(self->sf, index - buflen, SEEK_SET); /* sets position pointer in the file */
+            readPos = index - buflen;
+
+        DiskReader_read(self->reader, readPos, buffer, buflen);
 
-        SF_READ(self->sf, buffer, totlen);
+        /* the next block and the loop point */
+        DiskReader_prefetch(self->reader, index - buflen - PYO_DISK_BLOCK_FRAMES);
+        DiskReader_prefetch(self->reader, (sf_count_t)startPos);
 
         /* de-interleave samples */
         for (i = 0; i < totlen; i++)
@@ -320,8 +328,7 @@ SfPlayer_dealloc(SfPlayer* self)
 {
     pyo_DEALLOC
 
-    if (self->sf != NULL)
-        sf_close(self->sf);
+    DiskReader_free(self->reader);
 
     PyMem_RawFree(self->trigsBuffer);
     PyMem_RawFree(self->samplesBuffer);
@@ -349,6 +356,7 @@ SfPlayer_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, SfPlayer_compute_next_data_frame);
+    Stream_setNeedGIL(self->stream, 1);
     self->mode_func_ptr = SfPlayer_setProcMode;
 
     static char *kwlist[] = {"path", "speed", "loop", "offset", "interp", NULL};
@@ -368,10 +376,9 @@ SfPlayer_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     SET_INTERP_POINTER
 
     /* Open the sound file. */
-    self->info.format = 0;
-    self->sf = sf_open(self->path, SFM_READ, &self->info);
+    self->reader = DiskReader_new(self->path, &self->info, Server_isNonRealTime((Server *)self->server));
 
-    if (self->sf == NULL)
+    if (self->reader == NULL)
     {
         PySys_WriteStdout("SfPlayer: failed to open the file.\n");
     }
@@ -399,6 +406,14 @@ SfPlayer_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     self->pointerPos = self->startPos;
 
+    /* The first frames, in both directions, are loaded before the object starts playing. */
+    DiskReader_prefetch(self->reader, (sf_count_t)self->startPos);
+    DiskReader_prefetch(self->reader, self->sndSize - 1);
+    Py_BEGIN_ALLOW_THREADS
+    DiskReader_wait(self->reader, (sf_count_t)self->startPos);
+    DiskReader_wait(self->reader, self->sndSize - 1);
+    Py_END_ALLOW_THREADS
+
     return (PyObject *)self;
 }
 
@@ -430,6 +445,8 @@ SfPlayer_setSound(SfPlayer *self, PyObject *args)
     /* Need to perform a check to be sure that the new
        sound is of the same number of channels. */
     Py_ssize_t psize;
+    SF_INFO info;
+    PyoDiskReader *reader, *old;
 
     //ASSERT_ARG_NOT_NULL
 
@@ -438,17 +455,27 @@ SfPlayer_setSound(SfPlayer *self, PyObject *args)
 
     //self->path = PyUnicode_AsUTF8(arg);
 
-    sf_close(self->sf);
-
-    /* Open the sound file. */
-    self->info.format = 0;
-    self->sf = sf_open(self->path, SFM_READ, &self->info);
+    /* Open the sound file and load its first frames before the swap. */
+    memset(&info, 0, sizeof(SF_INFO));
+    reader = DiskReader_new(self->path, &info, Server_isNonRealTime((Server *)self->server));
 
-    if (self->sf == NULL)
+    if (reader == NULL)
     {
         PySys_WriteStdout("SfPlayer: failed to open the file.\n");
     }
+    else
+    {
+        DiskReader_prefetch(reader, 0);
+        Py_BEGIN_ALLOW_THREADS
+        DiskReader_wait(reader, 0);
+        Py_END_ALLOW_THREADS
+    }
+
+    Server_lock_streams((Server *)self->server);
 
+    old = self->reader;
+    self->reader = reader;
+    self->info = info;
     self->sndSize = self->info.frames;
     self->sndSr = self->info.samplerate;
     //self->sndChnls = self->info.channels;
@@ -459,6 +486,10 @@ SfPlayer_setSound(SfPlayer *self, PyObject *args)
     self->startPos = 0.0;
     self->pointerPos = self->startPos;
 
+    Server_unlock_streams((Server *)self->server);
+
+    DiskReader_free(old);
+
     Py_RETURN_NONE;
 }
 
@@ -483,6 +514,10 @@ SfPlayer_setOffset(SfPlayer *self, PyObject *arg)
 
         if (self->startPos < 0.0 || self->startPos >= self->sndSize)
             self->startPos = 0.0;
+
+        Server_lock_streams((Server *)self->server);
+        DiskReader_prefetch(self->reader, (sf_count_t)self->startPos);
+        Server_unlock_streams((Server *)self->server);
     }
 
     Py_RETURN_NONE;
@@ -503,6 +538,12 @@ SfPlayer_setInterp(SfPlayer *self, PyObject *arg)
     Py_RETURN_NONE;
 }
 
+static PyObject *
+SfPlayer_getUnderruns(SfPlayer *self)
+{
+    return PyLong_FromUnsignedLong(DiskReader_getUnderruns(self->reader));
+}
+
 MYFLT *
 SfPlayer_getSamplesBuffer(SfPlayer *self)
 {
@@ -531,6 +572,7 @@ static PyMethodDef SfPlayer_methods[] =
     {"setLoop", (PyCFunction)SfPlayer_setLoop, METH_O, "Sets sfplayer loop mode (0 = no loop, 1 = loop)."},
     {"setOffset", (PyCFunction)SfPlayer_setOffset, METH_O, "Sets sfplayer start position."},
     {"setInterp", (PyCFunction)SfPlayer_setInterp, METH_O, "Sets sfplayer interpolation mode."},
+    {"getUnderruns", (PyCFunction)SfPlayer_getUnderruns, METH_NOARGS, "Returns the number of blocks read before the disk could provide them."},
     {NULL}  /* Sentinel */
 };
 
@@ -857,7 +899,7 @@ typedef struct
     PyObject *speed;
     Stream *speed_stream;
     int modebuffer[1];
-    SNDFILE *sf;
+    PyoDiskReader *reader;
     SF_INFO info;
     char *path;
     int interp; /* 0 = default to 2, 1 = nointerp, 2 = linear, 3 = cos, 4 = cubic */
@@ -1059,21 +1101,19 @@ SfMarkerShuffler_readframes_i(SfMarkerShuffler *self)
         }
 
         index = (sf_count_t)self->pointerPos;
-        sf_seek(self->sf, index, SEEK_SET); /* sets position pointer in the file */
 
         /* fill a buffer with enough samples to satisfy speed reading */
         /* if not enough samples to read in the file */
         if ((index + buflen) > self->endPos)
         {
             shortbuflen = self->endPos - index;
-            SF_READ(self->sf, buffer, shortbuflen * self->sndChnls);
+            DiskReader_read(self->reader, index, buffer, shortbuflen);
 
             /* wrap around and read new samples from new marker */
             int pad = buflen - shortbuflen;
             int padlen = pad * self->sndChnls;
             MYFLT buftemp[padlen];
-            sf_seek(self->sf, (sf_count_t)self->nextStartPos, SEEK_SET);
-            SF_READ(self->sf, buftemp, padlen);
+            DiskReader_read(self->reader, (sf_count_t)self->nextStartPos, buftemp, pad);
 
             for (i = 0; i < padlen; i++)
             {
@@ -1081,7 +1121,11 @@ SfMarkerShuffler_readframes_i(SfMarkerShuffler *self)
             }
         }
         else /* without wraparound */
-            SF_READ(self->sf, buffer, totlen);
+            DiskReader_read(self->reader, index, buffer, buflen);
+
+        /* the next block and the next marker */
+        DiskReader_prefetch(self->reader, index + buflen + PYO_DISK_BLOCK_FRAMES);
+        DiskReader_prefetch(self->reader, (sf_count_t)self->nextStartPos);
 
         /* de-interleave samples */
         for (i = 0; i < totlen; i++)
@@ -1132,8 +1176,7 @@ SfMarkerShuffler_readframes_i(SfMarkerShuffler *self)
 
             /* wrap around and read new samples from new marker */
             MYFLT buftemp[padlen];
-            sf_seek(self->sf, (sf_count_t)self->nextStartPos - pad, SEEK_SET);
-            SF_READ(self->sf, buftemp, padlen);
+            DiskReader_read(self->reader, (sf_count_t)self->nextStartPos - pad, buftemp, pad);
 
             for (i = 0; i < padlen; i++)
             {
@@ -1141,8 +1184,7 @@ SfMarkerShuffler_readframes_i(SfMarkerShuffler *self)
             }
 
             MYFLT buftemp2[shortbuflen * self->sndChnls];
-            sf_seek(self->sf, (sf_count_t)self->endPos, SEEK_SET); /* sets position pointer in the file */
-            SF_READ(self->sf, buftemp2, shortbuflen * self->sndChnls);
+            DiskReader_read(self->reader, (sf_count_t)self->endPos, buftemp2, shortbuflen);
 
             for (i = 0; i < (shortbuflen * self->sndChnls); i++)
             {
@@ -1151,10 +1193,13 @@ SfMarkerShuffler_readframes_i(SfMarkerShuffler *self)
         }
         else   /* without wraparound */
         {
-            sf_seek(self->sf, index - buflen, SEEK_SET); /* sets position pointer in the file */
-            SF_READ(self->sf, buffer, totlen);
+            DiskReader_read(self->reader, index - buflen, buffer, buflen);
         }
 
+        /* the next block and the next marker */
+        DiskReader_prefetch(self->reader, index - buflen - PYO_DISK_BLOCK_FRAMES);
+        DiskReader_prefetch(self->reader, (sf_count_t)self->nextStartPos - 1);
+
         /* de-interleave samples */
         for (i = 0; i < totlen; i++)
         {
@@ -1303,8 +1348,7 @@ SfMarkerShuffler_dealloc(SfMarkerShuffler* self)
 {
     pyo_DEALLOC
 
-    if (self->sf != NULL)
-        sf_close(self->sf);
+    DiskReader_free(self->reader);
 
     PyMem_RawFree(self->samplesBuffer);
     PyMem_RawFree(self->markers);
@@ -1331,6 +1375,7 @@ SfMarkerShuffler_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->x = 0.5;
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, SfMarkerShuffler_compute_next_data_frame);
+    Stream_setSerial(self->stream, 1);
     self->mode_func_ptr = SfMarkerShuffler_setProcMode;
 
     static char *kwlist[] = {"path", "markers", "speed", "interp", NULL};
@@ -1362,10 +1407,9 @@ SfMarkerShuffler_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
         self->interp_func_ptr = cubic;
 
     /* Open the sound file. */
-    self->info.format = 0;
-    self->sf = sf_open(self->path, SFM_READ, &self->info);
+    self->reader = DiskReader_new(self->path, &self->info, Server_isNonRealTime((Server *)self->server));
 
-    if (self->sf == NULL)
+    if (self->reader == NULL)
     {
         PySys_WriteStdout("SfMarkerShuffler: failed to open the file.\n");
         Py_RETURN_NONE;
@@ -1497,6 +1541,12 @@ SfMarkerShuffler_setRandomType(SfMarkerShuffler *self, PyObject *args, PyObject
     Py_RETURN_NONE;
 }
 
+static PyObject *
+SfMarkerShuffler_getUnderruns(SfMarkerShuffler *self)
+{
+    return PyLong_FromUnsignedLong(DiskReader_getUnderruns(self->reader));
+}
+
 MYFLT *
 SfMarkerShuffler_getSamplesBuffer(SfMarkerShuffler *self)
 {
@@ -1520,6 +1570,7 @@ static PyMethodDef SfMarkerShuffler_methods[] =
     {"stop", (PyCFunction)SfMarkerShuffler_stop, METH_VARARGS | METH_KEYWORDS, "Stops computing."},
     {"setSpeed", (PyCFunction)SfMarkerShuffler_setSpeed, METH_O, "Sets sfplayer reading speed."},
     {"setInterp", (PyCFunction)SfMarkerShuffler_setInterp, METH_O, "Sets sfplayer interpolation mode."},
+    {"getUnderruns", (PyCFunction)SfMarkerShuffler_getUnderruns, METH_NOARGS, "Returns the number of blocks read before the disk could provide them."},
     {"setRandomType", (PyCFunction)SfMarkerShuffler_setRandomType, METH_VARARGS | METH_KEYWORDS, "Sets sfplayer random type."},
     {NULL}  /* Sentinel */
 };
@@ -1849,7 +1900,7 @@ typedef struct
     PyObject *mark;
     Stream *mark_stream;
     int modebuffer[2];
-    SNDFILE *sf;
+    PyoDiskReader *reader;
     SF_INFO info;
     char *path;
     int interp; /* 0 = default to 2, 1 = nointerp, 2 = linear, 3 = cos, 4 = cubic */
@@ -1912,21 +1963,19 @@ SfMarkerLooper_readframes_i(SfMarkerLooper *self)
         }
 
         index = (sf_count_t)self->pointerPos;
-        sf_seek(self->sf, index, SEEK_SET); /* sets position pointer in the file */
 
         /* fill a buffer with enough samples to satisfy speed reading */
         /* if not enough samples to read in the file */
         if ((index + buflen) > self->endPos)
         {
             shortbuflen = self->endPos - index;
-            SF_READ(self->sf, buffer, shortbuflen * self->sndChnls);
+            DiskReader_read(self->reader, index, buffer, shortbuflen);
 
             /* wrap around and read new samples if loop */
             int pad = buflen - shortbuflen;
             int padlen = pad * self->sndChnls;
             MYFLT buftemp[padlen];
-            sf_seek(self->sf, (sf_count_t)self->nextStartPos, SEEK_SET);
-            SF_READ(self->sf, buftemp, padlen);
+            DiskReader_read(self->reader, (sf_count_t)self->nextStartPos, buftemp, pad);
 
             for (i = 0; i < (padlen); i++)
             {
@@ -1934,7 +1983,11 @@ SfMarkerLooper_readframes_i(SfMarkerLooper *self)
             }
         }
         else /* without zero padding */
-            SF_READ(self->sf, buffer, totlen);
+            DiskReader_read(self->reader, index, buffer, buflen);
+
+        /* the next block and the next marker */
+        DiskReader_prefetch(self->reader, index + buflen + PYO_DISK_BLOCK_FRAMES);
+        DiskReader_prefetch(self->reader, (sf_count_t)self->nextStartPos);
 
         /* de-interleave samples */
         for (i = 0; i < totlen; i++)
@@ -1985,8 +2038,7 @@ SfMarkerLooper_readframes_i(SfMarkerLooper *self)
 
             /* wrap around and read new samples if loop */
             MYFLT buftemp[padlen];
-            sf_seek(self->sf, (sf_count_t)self->nextStartPos - pad, SEEK_SET);
-            SF_READ(self->sf, buftemp, padlen);
+            DiskReader_read(self->reader, (sf_count_t)self->nextStartPos - pad, buftemp, pad);
 
             for (i = 0; i < padlen; i++)
             {
@@ -1994,8 +2046,7 @@ SfMarkerLooper_readframes_i(SfMarkerLooper *self)
             }
 
             MYFLT buftemp2[shortbuflen * self->sndChnls];
-            sf_seek(self->sf, (sf_count_t)self->endPos, SEEK_SET); /* sets position pointer in the file */
-            SF_READ(self->sf, buftemp2, shortbuflen * self->sndChnls);
+            DiskReader_read(self->reader, (sf_count_t)self->endPos, buftemp2, shortbuflen);
 
             for (i = 0; i < (shortbuflen * self->sndChnls); i++)
             {
@@ -2004,10 +2055,13 @@ SfMarkerLooper_readframes_i(SfMarkerLooper *self)
         }
         else   /* without zero padding */
         {
-            sf_seek(self->sf, index - buflen, SEEK_SET); /* sets position pointer in the file */
-            SF_READ(self->sf, buffer, totlen);
+            DiskReader_read(self->reader, index - buflen, buffer, buflen);
         }
 
+        /* the next block and the next marker */
+        DiskReader_prefetch(self->reader, index - buflen - PYO_DISK_BLOCK_FRAMES);
+        DiskReader_prefetch(self->reader, (sf_count_t)self->nextStartPos - 1);
+
         /* de-interleave samples */
         for (i = 0; i < totlen; i++)
         {
@@ -2168,8 +2222,7 @@ SfMarkerLooper_dealloc(SfMarkerLooper* self)
 {
     pyo_DEALLOC
 
-    if (self->sf != NULL)
-        sf_close(self->sf);
+    DiskReader_free(self->reader);
 
     PyMem_RawFree(self->samplesBuffer);
     PyMem_RawFree(self->markers);
@@ -2233,10 +2286,9 @@ SfMarkerLooper_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
         self->interp_func_ptr = cubic;
 
     /* Open the sound file. */
-    self->info.format = 0;
-    self->sf = sf_open(self->path, SFM_READ, &self->info);
+    self->reader = DiskReader_new(self->path, &self->info, Server_isNonRealTime((Server *)self->server));
 
-    if (self->sf == NULL)
+    if (self->reader == NULL)
     {
         PySys_WriteStdout("SfMarkerLooper: failed to open the file.\n");
         Py_RETURN_NONE;
@@ -2292,6 +2344,12 @@ SfMarkerLooper_setInterp(SfMarkerLooper *self, PyObject *arg)
     Py_RETURN_NONE;
 }
 
+static PyObject *
+SfMarkerLooper_getUnderruns(SfMarkerLooper *self)
+{
+    return PyLong_FromUnsignedLong(DiskReader_getUnderruns(self->reader));
+}
+
 MYFLT *
 SfMarkerLooper_getSamplesBuffer(SfMarkerLooper *self)
 {
@@ -2317,6 +2375,7 @@ static PyMethodDef SfMarkerLooper_methods[] =
     {"setSpeed", (PyCFunction)SfMarkerLooper_setSpeed, METH_O, "Sets sfplayer reading speed."},
     {"setMark", (PyCFunction)SfMarkerLooper_setMark, METH_O, "Sets marker to loop."},
     {"setInterp", (PyCFunction)SfMarkerLooper_setInterp, METH_O, "Sets sfplayer interpolation mode."},
+    {"getUnderruns", (PyCFunction)SfMarkerLooper_getUnderruns, METH_NOARGS, "Returns the number of blocks read before the disk could provide them."},
     {NULL}  /* Sentinel */
 };
 
@@ -102,6 +102,8 @@ Sig_compute_next_data_frame(Sig *self)
         {
             self->data[i] = val;
         }
+
+        Stream_setState(self->stream, val == 0 ? PYO_STREAM_SILENT : PYO_STREAM_CONSTANT);
     }
     else
     {
@@ -111,6 +113,8 @@ Sig_compute_next_data_frame(Sig *self)
         {
             self->data[i] = vals[i];
         }
+
+        Stream_setState(self->stream, Stream_getState(self->value_stream));
     }
 
     (*self->muladd_func_ptr)(self);
@@ -156,6 +160,7 @@ Sig_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, Sig_compute_next_data_frame);
+    Stream_setShareable(self->stream, 1);
     self->mode_func_ptr = Sig_setProcMode;
 
     static char *kwlist[] = {"value", "mul", "add", NULL};
@@ -337,6 +342,7 @@ SigTo_generates_i(SigTo *self)
 {
     int i;
     MYFLT value, time;
+    FUSED_MULADD_INIT
 
     if (self->modebuffer[2] == 0)
     {
@@ -360,7 +366,20 @@ SigTo_generates_i(SigTo *self)
         if (self->timeStep <= 0)
         {
             for (i = 0; i < self->bufsize; i++)
-                self->data[i] = self->currentValue = self->lastValue = value;
+            {
+                self->currentValue = self->lastValue = value;
+                self->data[i] = FUSED_MULADD(value);
+            }
+
+            Stream_setState(self->stream, self->data[0] == 0 ? PYO_STREAM_SILENT : PYO_STREAM_CONSTANT);
+        }
+        else if (self->timeCount >= self->timeStep)
+        {
+            /* Ramp ended, the value holds for the whole block. */
+            for (i = 0; i < self->bufsize; i++)
+                self->data[i] = FUSED_MULADD(self->currentValue);
+
+            Stream_setState(self->stream, self->data[0] == 0 ? PYO_STREAM_SILENT : PYO_STREAM_CONSTANT);
         }
         else
         {
@@ -377,7 +396,7 @@ SigTo_generates_i(SigTo *self)
                     self->timeCount++;
                 }
 
-                self->data[i] = self->currentValue;
+                self->data[i] = FUSED_MULADD(self->currentValue);
             }
         }
     }
@@ -406,7 +425,8 @@ SigTo_generates_i(SigTo *self)
 
             if (self->timeStep <= 0)
             {
-                self->data[i] = self->currentValue = self->lastValue = value;
+                self->currentValue = self->lastValue = value;
+                self->data[i] = FUSED_MULADD(value);
             }
             else
             {
@@ -421,13 +441,13 @@ SigTo_generates_i(SigTo *self)
                     self->timeCount++;
                 }
 
-                self->data[i] = self->currentValue;
+                self->data[i] = FUSED_MULADD(self->currentValue);
             }
         }
     }
 }
 
-static void SigTo_postprocessing_ii(SigTo *self) { POST_PROCESSING_II };
+static void SigTo_postprocessing_fused(SigTo *self) {}; /* mul & add applied by the processing function */
 static void SigTo_postprocessing_ai(SigTo *self) { POST_PROCESSING_AI };
 static void SigTo_postprocessing_ia(SigTo *self) { POST_PROCESSING_IA };
 static void SigTo_postprocessing_aa(SigTo *self) { POST_PROCESSING_AA };
@@ -448,7 +468,7 @@ SigTo_setProcMode(SigTo *self)
     switch (muladdmode)
     {
         case 0:
-            self->muladd_func_ptr = SigTo_postprocessing_ii;
+            self->muladd_func_ptr = SigTo_postprocessing_fused;
             break;
 
         case 1:
@@ -540,6 +560,7 @@ SigTo_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, SigTo_compute_next_data_frame);
+    Stream_setShareable(self->stream, 1);
     self->mode_func_ptr = SigTo_setProcMode;
 
     static char *kwlist[] = {"value", "time", "init", "mul", "add", NULL};
@@ -910,6 +931,7 @@ VarPort_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, VarPort_compute_next_data_frame);
+    Stream_setNeedGIL(self->stream, 1);
     self->mode_func_ptr = VarPort_setProcMode;
 
     static char *kwlist[] = {"value", "time", "init", "callable", "arg", "mul", "add", NULL};
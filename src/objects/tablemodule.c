@@ -34,7 +34,10 @@
 
 #if !defined(_WIN32) && !defined(_WIN64)
 #include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
 #include <sys/mman.h>
+#include <limits.h>
 #endif
 
 #include "tablemodule.h"
@@ -42,9 +45,48 @@
 /*************************/
 /* TableStream structure */
 /*************************/
+static void
+TableStream_freeLevels(MYFLT **levels, int nlevels)
+{
+    int k;
+
+    if (levels != NULL)
+    {
+        for (k = 1; k < nlevels; k++)
+            PyMem_RawFree(levels[k]);
+
+        PyMem_RawFree(levels);
+    }
+}
+
+/* Replaces the levels read by the objects. The swap is done under the
+   processing lock of the server and the old levels are returned to the
+   caller, to be freed once it is released. */
+static MYFLT **
+TableStream_swapLevels(TableStream *self, MYFLT **levels, int nlevels, T_SIZE_T size, int *oldnlevels)
+{
+    MYFLT **old;
+
+    if (self->server != NULL)
+        Server_lockProcessing(self->server);
+
+    old = self->levels;
+    *oldnlevels = self->miplevels;
+    self->levels = levels;
+    self->miplevels = nlevels;
+    self->mipsize = size;
+
+    if (self->server != NULL)
+        Server_unlockProcessing(self->server);
+
+    return old;
+}
+
 static void
 TableStream_dealloc(TableStream* self)
 {
+    TableStream_freeLevels(self->levels, self->miplevels);
+    Py_XDECREF(self->server);
     Py_TYPE(self)->tp_free((PyObject*)self);
 }
 
@@ -134,6 +176,135 @@ void TableStream_record(TableStream *self, int pos, MYFLT value)
     self->data[pos] = value;
 }
 
+/* Builds octave-spaced band-limited copies of the table by removing the
+   upper harmonics of its spectrum. Only sizes accepted by the real FFT
+   plans can be mipmapped, other tables are read as is. The new levels
+   are built aside and swapped with the ones read by the audio thread. */
+void
+TableStream_updateMipmaps(TableStream *self)
+{
+    int k, nlevels = 1, oldnlevels;
+    T_SIZE_T i, size = self->size, hsize = size / 2, cut;
+    MYFLT *spectrum, *scratch, **levels = NULL, **old;
+    PyoFFTPlan *plan;
+
+    if (self->mipmaps && size <= INT_MAX && fft_valid_size((int)size, PYO_FFT_REAL))
+    {
+        while ((size >> (nlevels + 1)) >= 1)
+            nlevels++;
+
+        levels = (MYFLT **)PyMem_RawMalloc(nlevels * sizeof(MYFLT *));
+        levels[0] = self->data;
+
+        plan = fft_plan_acquire((int)size, PYO_FFT_REAL);
+        spectrum = (MYFLT *)PyMem_RawMalloc(size * sizeof(MYFLT));
+        scratch = (MYFLT *)PyMem_RawMalloc(size * sizeof(MYFLT));
+
+        memcpy(scratch, self->data, size * sizeof(MYFLT));
+        fft_plan_forward(plan, scratch, spectrum);
+
+        for (k = 1; k < nlevels; k++)
+        {
+            levels[k] = (MYFLT *)PyMem_RawMalloc((size + 1) * sizeof(MYFLT));
+            cut = size >> (k + 1);
+            memcpy(scratch, spectrum, size * sizeof(MYFLT));
+
+            for (i = cut + 1; i < hsize; i++)
+                scratch[i] = scratch[size - i] = 0.0;
+
+            scratch[hsize] = 0.0;
+            fft_plan_inverse(plan, scratch, levels[k]);
+            levels[k][size] = levels[k][0];
+        }
+
+        PyMem_RawFree(spectrum);
+        PyMem_RawFree(scratch);
+        fft_plan_release(plan);
+    }
+    else
+    {
+        nlevels = 0;
+        size = 0;
+    }
+
+    old = TableStream_swapLevels(self, levels, nlevels, size, &oldnlevels);
+    TableStream_freeLevels(old, oldnlevels);
+}
+
+MYFLT **
+TableStream_getMipmaps(TableStream *self, int *nlevels)
+{
+    if (self->miplevels < 2 || self->mipsize != self->size || self->levels[0] != self->data)
+        return NULL;
+
+    *nlevels = self->miplevels;
+    return self->levels;
+}
+
+void
+TableStream_interpolate(TableStream *self, interp_block_func block, double *pos, double inc,
+                        double *incs, MYFLT *out, MYFLT *tmp, int n)
+{
+    int i, nlevels;
+    MYFLT mix, *lo, *hi;
+    MYFLT **levels = TableStream_getMipmaps(self, &nlevels);
+
+    if (levels == NULL)
+    {
+        (*block)(self->data, self->size, pos, out, n);
+        return;
+    }
+
+    if (incs != NULL)
+    {
+        inc = 0.0;
+
+        for (i = 0; i < n; i++)
+        {
+            if (fabs(incs[i]) > inc)
+                inc = fabs(incs[i]);
+        }
+    }
+
+    mix = TableStream_pickMipmaps(levels, nlevels, inc, &lo, &hi);
+    (*block)(lo, self->size, pos, out, n);
+
+    if (hi != lo)
+    {
+        (*block)(hi, self->size, pos, tmp, n);
+
+        for (i = 0; i < n; i++)
+            out[i] += (tmp[i] - out[i]) * mix;
+    }
+}
+
+static PyObject *
+TableStream_setMipmaps(TableStream *self, PyObject *arg)
+{
+    ASSERT_ARG_NOT_NULL
+
+    self->mipmaps = PyObject_IsTrue(arg);
+    TableStream_updateMipmaps(self);
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+TableStream_refreshMipmaps(TableStream *self)
+{
+    if (self->mipmaps)
+        TableStream_updateMipmaps(self);
+
+    Py_RETURN_NONE;
+}
+
+static PyMethodDef TableStream_methods[] =
+{
+    {"setMipmaps", (PyCFunction)TableStream_setMipmaps, METH_O, "Activates the band-limited copies of the table."},
+    {"refreshMipmaps", (PyCFunction)TableStream_refreshMipmaps, METH_NOARGS, "Rebuilds the band-limited copies of the table, if active."},
+    {NULL}  /* Sentinel */
+};
+
 static PyBufferProcs TableStream_as_buffer =
 {
     (getbufferproc)TableStream_getBuffer,
@@ -169,7 +340,7 @@ PyTypeObject TableStreamType =
     0, /* tp_weaklistoffset */
     0, /* tp_iter */
     0, /* tp_iternext */
-    0, /* tp_methods */
+    TableStream_methods, /* tp_methods */
     0, /* tp_members */
     0, /* tp_getset */
     0, /* tp_base */
@@ -248,7 +419,7 @@ HarmTable_clear(HarmTable *self)
 static void
 HarmTable_dealloc(HarmTable* self)
 {
-    PyMem_RawFree(self->data);
+    arena_free(self->data);
     HarmTable_clear(self);
     Py_TYPE(self->tablestream)->tp_free((PyObject*)self->tablestream);
     Py_TYPE(self)->tp_free((PyObject*)self);
@@ -284,7 +455,7 @@ HarmTable_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
         self->amplist = amplist;
     }
 
-    self->data = (MYFLT *)PyMem_RawRealloc(self->data, (self->size + 1) * sizeof(MYFLT));
+    self->data = (MYFLT *)arena_realloc(self->data, (self->size + 1) * sizeof(MYFLT));
     TableStream_setSize(self->tablestream, self->size);
     TableStream_setData(self->tablestream, self->data);
     HarmTable_generate(self);
@@ -573,7 +744,7 @@ ChebyTable_clear(ChebyTable *self)
 static void
 ChebyTable_dealloc(ChebyTable* self)
 {
-    PyMem_RawFree(self->data);
+    arena_free(self->data);
     ChebyTable_clear(self);
     Py_TYPE(self->tablestream)->tp_free((PyObject*)self->tablestream);
     Py_TYPE(self)->tp_free((PyObject*)self);
@@ -609,7 +780,7 @@ ChebyTable_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
         self->amplist = amplist;
     }
 
-    self->data = (MYFLT *)PyMem_RawRealloc(self->data, (self->size + 1) * sizeof(MYFLT));
+    self->data = (MYFLT *)arena_realloc(self->data, (self->size + 1) * sizeof(MYFLT));
     TableStream_setSize(self->tablestream, self->size);
     TableStream_setData(self->tablestream, self->data);
     ChebyTable_generate(self);
@@ -917,7 +1088,7 @@ HannTable_clear(HannTable *self)
 static void
 HannTable_dealloc(HannTable* self)
 {
-    PyMem_RawFree(self->data);
+    arena_free(self->data);
     HannTable_clear(self);
     Py_TYPE(self->tablestream)->tp_free((PyObject*)self->tablestream);
     Py_TYPE(self)->tp_free((PyObject*)self);
@@ -941,7 +1112,7 @@ HannTable_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     if (! PyArg_ParseTupleAndKeywords(args, kwds, "|n", kwlist, &self->size))
         Py_RETURN_NONE;
 
-    self->data = (MYFLT *)PyMem_RawRealloc(self->data, (self->size + 1) * sizeof(MYFLT));
+    self->data = (MYFLT *)arena_realloc(self->data, (self->size + 1) * sizeof(MYFLT));
     TableStream_setSize(self->tablestream, self->size);
     TableStream_setData(self->tablestream, self->data);
     HannTable_generate(self);
@@ -1152,7 +1323,7 @@ SincTable_clear(SincTable *self)
 static void
 SincTable_dealloc(SincTable* self)
 {
-    PyMem_RawFree(self->data);
+    arena_free(self->data);
     SincTable_clear(self);
     Py_TYPE(self->tablestream)->tp_free((PyObject*)self->tablestream);
     Py_TYPE(self)->tp_free((PyObject*)self);
@@ -1178,7 +1349,7 @@ SincTable_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     if (! PyArg_ParseTupleAndKeywords(args, kwds, TYPE__FIN, kwlist, &self->freq, &self->windowed, &self->size))
         Py_RETURN_NONE;
 
-    self->data = (MYFLT *)PyMem_RawRealloc(self->data, (self->size + 1) * sizeof(MYFLT));
+    self->data = (MYFLT *)arena_realloc(self->data, (self->size + 1) * sizeof(MYFLT));
     TableStream_setSize(self->tablestream, self->size);
     TableStream_setData(self->tablestream, self->data);
     SincTable_generate(self);
@@ -1388,7 +1559,7 @@ WinTable_clear(WinTable *self)
 static void
 WinTable_dealloc(WinTable* self)
 {
-    PyMem_RawFree(self->data);
+    arena_free(self->data);
     WinTable_clear(self);
     Py_TYPE(self->tablestream)->tp_free((PyObject*)self->tablestream);
     Py_TYPE(self)->tp_free((PyObject*)self);
@@ -1413,7 +1584,7 @@ WinTable_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     if (! PyArg_ParseTupleAndKeywords(args, kwds, "|in", kwlist, &self->type, &self->size))
         Py_RETURN_NONE;
 
-    self->data = (MYFLT *)PyMem_RawRealloc(self->data, (self->size + 1) * sizeof(MYFLT));
+    self->data = (MYFLT *)arena_realloc(self->data, (self->size + 1) * sizeof(MYFLT));
     TableStream_setSize(self->tablestream, self->size);
     TableStream_setData(self->tablestream, self->data);
     WinTable_generate(self);
@@ -1626,7 +1797,7 @@ ParaTable_clear(ParaTable *self)
 static void
 ParaTable_dealloc(ParaTable* self)
 {
-    PyMem_RawFree(self->data);
+    arena_free(self->data);
     ParaTable_clear(self);
     Py_TYPE(self->tablestream)->tp_free((PyObject*)self->tablestream);
     Py_TYPE(self)->tp_free((PyObject*)self);
@@ -1650,7 +1821,7 @@ ParaTable_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     if (! PyArg_ParseTupleAndKeywords(args, kwds, "|n", kwlist, &self->size))
         Py_RETURN_NONE;
 
-    self->data = (MYFLT *)PyMem_RawRealloc(self->data, (self->size + 1) * sizeof(MYFLT));
+    self->data = (MYFLT *)arena_realloc(self->data, (self->size + 1) * sizeof(MYFLT));
     TableStream_setSize(self->tablestream, self->size);
     TableStream_setData(self->tablestream, self->data);
     ParaTable_generate(self);
@@ -1887,7 +2058,7 @@ LinTable_clear(LinTable *self)
 static void
 LinTable_dealloc(LinTable* self)
 {
-    PyMem_RawFree(self->data);
+    arena_free(self->data);
     LinTable_clear(self);
     Py_TYPE(self->tablestream)->tp_free((PyObject*)self->tablestream);
     Py_TYPE(self)->tp_free((PyObject*)self);
@@ -1925,7 +2096,7 @@ LinTable_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
         PyList_Append(self->pointslist, PyTuple_Pack(2, PyLong_FromLong(self->size), PyFloat_FromDouble(1.)));
     }
 
-    self->data = (MYFLT *)PyMem_RawRealloc(self->data, (self->size + 1) * sizeof(MYFLT));
+    self->data = (MYFLT *)arena_realloc(self->data, (self->size + 1) * sizeof(MYFLT));
     TableStream_setSize(self->tablestream, self->size);
     TableStream_setData(self->tablestream, self->data);
     LinTable_generate(self);
@@ -2228,7 +2399,7 @@ LogTable_clear(LogTable *self)
 static void
 LogTable_dealloc(LogTable* self)
 {
-    PyMem_RawFree(self->data);
+    arena_free(self->data);
     LogTable_clear(self);
     Py_TYPE(self->tablestream)->tp_free((PyObject*)self->tablestream);
     Py_TYPE(self)->tp_free((PyObject*)self);
@@ -2266,7 +2437,7 @@ LogTable_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
         PyList_Append(self->pointslist, PyTuple_Pack(2, PyLong_FromLong(self->size), PyFloat_FromDouble(1.)));
     }
 
-    self->data = (MYFLT *)PyMem_RawRealloc(self->data, (self->size + 1) * sizeof(MYFLT));
+    self->data = (MYFLT *)arena_realloc(self->data, (self->size + 1) * sizeof(MYFLT));
     TableStream_setSize(self->tablestream, self->size);
     TableStream_setData(self->tablestream, self->data);
     LogTable_generate(self);
@@ -2537,7 +2708,7 @@ CosTable_clear(CosTable *self)
 static void
 CosTable_dealloc(CosTable* self)
 {
-    PyMem_RawFree(self->data);
+    arena_free(self->data);
     CosTable_clear(self);
     Py_TYPE(self->tablestream)->tp_free((PyObject*)self->tablestream);
     Py_TYPE(self)->tp_free((PyObject*)self);
@@ -2575,7 +2746,7 @@ CosTable_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
         PyList_Append(self->pointslist, PyTuple_Pack(2, PyLong_FromLong(self->size), PyFloat_FromDouble(1.)));
     }
 
-    self->data = (MYFLT *)PyMem_RawRealloc(self->data, (self->size + 1) * sizeof(MYFLT));
+    self->data = (MYFLT *)arena_realloc(self->data, (self->size + 1) * sizeof(MYFLT));
     TableStream_setSize(self->tablestream, self->size);
     TableStream_setData(self->tablestream, self->data);
     CosTable_generate(self);
@@ -2879,7 +3050,7 @@ CosLogTable_clear(CosLogTable *self)
 static void
 CosLogTable_dealloc(CosLogTable* self)
 {
-    PyMem_RawFree(self->data);
+    arena_free(self->data);
     CosLogTable_clear(self);
     Py_TYPE(self->tablestream)->tp_free((PyObject*)self->tablestream);
     Py_TYPE(self)->tp_free((PyObject*)self);
@@ -2917,7 +3088,7 @@ CosLogTable_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
         PyList_Append(self->pointslist, PyTuple_Pack(2, PyLong_FromLong(self->size), PyFloat_FromDouble(1.)));
     }
 
-    self->data = (MYFLT *)PyMem_RawRealloc(self->data, (self->size + 1) * sizeof(MYFLT));
+    self->data = (MYFLT *)arena_realloc(self->data, (self->size + 1) * sizeof(MYFLT));
     TableStream_setSize(self->tablestream, self->size);
     TableStream_setData(self->tablestream, self->data);
     CosLogTable_generate(self);
@@ -3212,7 +3383,7 @@ CurveTable_clear(CurveTable *self)
 static void
 CurveTable_dealloc(CurveTable* self)
 {
-    PyMem_RawFree(self->data);
+    arena_free(self->data);
     CurveTable_clear(self);
     Py_TYPE(self->tablestream)->tp_free((PyObject*)self->tablestream);
     Py_TYPE(self)->tp_free((PyObject*)self);
@@ -3252,7 +3423,7 @@ CurveTable_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
         PyList_Append(self->pointslist, PyTuple_Pack(2, PyLong_FromLong(self->size), PyFloat_FromDouble(1.)));
     }
 
-    self->data = (MYFLT *)PyMem_RawRealloc(self->data, (self->size + 1) * sizeof(MYFLT));
+    self->data = (MYFLT *)arena_realloc(self->data, (self->size + 1) * sizeof(MYFLT));
     TableStream_setSize(self->tablestream, self->size);
     TableStream_setData(self->tablestream, self->data);
     CurveTable_generate(self);
@@ -3593,7 +3764,7 @@ ExpTable_clear(ExpTable *self)
 static void
 ExpTable_dealloc(ExpTable* self)
 {
-    PyMem_RawFree(self->data);
+    arena_free(self->data);
     ExpTable_clear(self);
     Py_TYPE(self->tablestream)->tp_free((PyObject*)self->tablestream);
     Py_TYPE(self)->tp_free((PyObject*)self);
@@ -3633,7 +3804,7 @@ ExpTable_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
         PyList_Append(self->pointslist, PyTuple_Pack(2, PyLong_FromLong(self->size), PyFloat_FromDouble(1.)));
     }
 
-    self->data = (MYFLT *)PyMem_RawRealloc(self->data, (self->size + 1) * sizeof(MYFLT));
+    self->data = (MYFLT *)arena_realloc(self->data, (self->size + 1) * sizeof(MYFLT));
     TableStream_setSize(self->tablestream, self->size);
     TableStream_setData(self->tablestream, self->data);
     ExpTable_generate(self);
@@ -3867,6 +4038,8 @@ typedef struct
     MYFLT stop;
     MYFLT crossfade;
     MYFLT insertPos;
+    void *mapbase; /* Mapping of the sound file or of its planar cache, NULL when data lives on the heap. */
+    size_t maplen;
 } SndTable;
 
 static void
@@ -3884,6 +4057,437 @@ SndTable_full_reset(SndTable *self)
     self->stop = -1.0;
 }
 
+/* Planar cache files used by the memory-mapped mode. A cache holds every
+ * channel of a sound, already converted to MYFLT, one after the other,
+ * each followed by a guard point. Mapping it privately lets pages fault in
+ * on demand while in-place table edits stay local to the process. */
+#define SND_CACHE_MAGIC "PYOSNDC1"
+#define SND_CACHE_CHUNK 65536
+
+typedef struct
+{
+    char magic[8];
+    int samplesize;
+    int channels;
+    int samplerate;
+    int reserved;
+    long long frames;
+    long long srcsize;
+    long long srcmtime;
+    char padding[16];
+} SndCacheHeader;
+
+static void
+SndTable_releaseMap(SndTable *self)
+{
+#if !defined(_WIN32) && !defined(_WIN64)
+
+    if (self->mapbase != NULL)
+    {
+        munmap(self->mapbase, self->maplen);
+        self->mapbase = NULL;
+        self->maplen = 0;
+        self->data = NULL;
+    }
+
+#endif
+}
+
+/* Moves a mapped table to the heap, for operations that resize the data. */
+static void
+SndTable_unmapSound(SndTable *self)
+{
+    MYFLT *data;
+
+    if (self->mapbase == NULL)
+        return;
+
+    data = (MYFLT *)arena_alloc((self->size + 1) * sizeof(MYFLT));
+    memcpy(data, self->data, (self->size + 1) * sizeof(MYFLT));
+    SndTable_releaseMap(self);
+    self->data = data;
+    TableStream_setData(self->tablestream, self->data);
+}
+
+#if !defined(_WIN32) && !defined(_WIN64)
+/* Builds the path of the cache of `path` in `dir`. Returns -1 if it doesn't fit in `len`. */
+static int
+SndTable_cachePath(const char *path, const char *dir, char *cpath, size_t len)
+{
+    int n;
+    unsigned long long hash = 14695981039346656037ULL;
+    char *full = realpath(path, NULL);
+    const char *c = full != NULL ? full : path;
+
+    /* FNV-1a hash of the absolute path. */
+    for (; *c != '\0'; c++)
+    {
+        hash ^= (unsigned char)*c;
+        hash *= 1099511628211ULL;
+    }
+
+    free(full);
+    n = snprintf(cpath, len, "%s/%016llx-%d.pyosnd", dir, hash, (int)sizeof(MYFLT));
+
+    return (n < 0 || (size_t)n >= len) ? -1 : 0;
+}
+
+static int
+SndTable_cacheIsValid(int fd, const SndCacheHeader *header, const struct stat *src)
+{
+    struct stat st;
+
+    if (fstat(fd, &st) != 0)
+        return 0;
+
+    if (memcmp(header->magic, SND_CACHE_MAGIC, 8) != 0 ||
+        header->samplesize != (int)sizeof(MYFLT) ||
+        header->srcsize != (long long)src->st_size ||
+        header->srcmtime != (long long)src->st_mtime)
+        return 0;
+
+    return (long long)st.st_size == (long long)sizeof(SndCacheHeader) +
+           (long long)header->channels * (header->frames + 1) * (long long)sizeof(MYFLT);
+}
+
+/* Decodes the whole sound into a new cache file. Written under a temporary
+ * name and renamed at the end so that concurrent readers never see a
+ * partial cache. */
+static int
+SndTable_buildCache(const char *path, const char *cpath, const struct stat *src)
+{
+    SNDFILE *sf;
+    SF_INFO info;
+    SndCacheHeader header;
+    T_SIZE_T i, j, num, pos = 0;
+    size_t len;
+    int n, fd, chnls;
+    char tmppath[PATH_MAX + 32];
+    MYFLT *tmp, *planar, *channel;
+    void *base;
+
+    n = snprintf(tmppath, sizeof(tmppath), "%s.%d.tmp", cpath, (int)getpid());
+
+    if (n < 0 || (size_t)n >= sizeof(tmppath))
+        return -1;
+
+    info.format = 0;
+    sf = sf_open(path, SFM_READ, &info);
+
+    if (sf == NULL)
+        return -1;
+
+    chnls = info.channels;
+    len = sizeof(SndCacheHeader) + (size_t)chnls * (info.frames + 1) * sizeof(MYFLT);
+
+    fd = open(tmppath, O_CREAT | O_TRUNC | O_RDWR, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+
+    if (fd == -1)
+    {
+        sf_close(sf);
+        return -1;
+    }
+
+    if (ftruncate(fd, len) == -1 ||
+        (base = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)) == MAP_FAILED)
+    {
+        close(fd);
+        unlink(tmppath);
+        sf_close(sf);
+        return -1;
+    }
+
+    planar = (MYFLT *)((char *)base + sizeof(SndCacheHeader));
+    tmp = (MYFLT *)PyMem_RawMalloc(SND_CACHE_CHUNK * chnls * sizeof(MYFLT));
+
+    do
+    {
+        num = SF_READ(sf, tmp, SND_CACHE_CHUNK * chnls) / chnls;
+
+        for (j = 0; j < chnls; j++)
+        {
+            channel = planar + j * (info.frames + 1) + pos;
+
+            for (i = 0; i < num; i++)
+            {
+                channel[i] = tmp[i * chnls + j];
+            }
+        }
+
+        pos += num;
+    }
+    while (num == SND_CACHE_CHUNK && pos < info.frames);
+
+    sf_close(sf);
+    PyMem_RawFree(tmp);
+
+    for (j = 0; j < chnls; j++)
+    {
+        channel = planar + j * (info.frames + 1);
+        channel[info.frames] = channel[0];
+    }
+
+    memset(&header, 0, sizeof(SndCacheHeader));
+    memcpy(header.magic, SND_CACHE_MAGIC, 8);
+    header.samplesize = (int)sizeof(MYFLT);
+    header.channels = chnls;
+    header.samplerate = info.samplerate;
+    header.frames = info.frames;
+    header.srcsize = (long long)src->st_size;
+    header.srcmtime = (long long)src->st_mtime;
+    memcpy(base, &header, sizeof(SndCacheHeader));
+
+    munmap(base, len);
+    close(fd);
+
+    if (rename(tmppath, cpath) != 0)
+    {
+        unlink(tmppath);
+        return -1;
+    }
+
+    return 0;
+}
+
+static unsigned int
+SndTable_le16(const unsigned char *p)
+{
+    return p[0] | (p[1] << 8);
+}
+
+static unsigned long
+SndTable_le32(const unsigned char *p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((unsigned long)p[3] << 24);
+}
+
+/* Finds the samples of a mono WAV file whose samples are MYFLT (32-bit float,
+ * or 64-bit float in double precision) in the byte order of the machine,
+ * the only files that can be mapped as they are. Returns -1 otherwise. */
+static int
+SndTable_findRawSamples(int fd, off_t *offset, T_SIZE_T *frames, int *samplerate)
+{
+    unsigned char head[12], chunk[8], fmt[26];
+    unsigned long size;
+    unsigned int format = 0, channels = 0, bits = 0;
+    off_t pos = 12;
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    return -1;
+#endif
+
+    if (pread(fd, head, 12, 0) != 12 || memcmp(head, "RIFF", 4) != 0 || memcmp(head + 8, "WAVE", 4) != 0)
+        return -1;
+
+    while (pread(fd, chunk, 8, pos) == 8)
+    {
+        size = SndTable_le32(chunk + 4);
+
+        if (memcmp(chunk, "fmt ", 4) == 0 && size >= 16)
+        {
+            memset(fmt, 0, sizeof(fmt));
+
+            if (pread(fd, fmt, size < sizeof(fmt) ? size : sizeof(fmt), pos + 8) < 16)
+                return -1;
+
+            format = SndTable_le16(fmt);
+            channels = SndTable_le16(fmt + 2);
+            *samplerate = (int)SndTable_le32(fmt + 4);
+            bits = SndTable_le16(fmt + 14);
+
+            /* WAVE_FORMAT_EXTENSIBLE, the format is the start of the sub-format GUID. */
+            if (format == 0xFFFE && size >= 26)
+                format = SndTable_le16(fmt + 24);
+        }
+        else if (memcmp(chunk, "data", 4) == 0)
+        {
+            if (format != 3 || channels != 1 || bits != 8 * sizeof(MYFLT) || size == 0xFFFFFFFF)
+                return -1;
+
+            *offset = pos + 8;
+            *frames = size / sizeof(MYFLT);
+
+            return 0;
+        }
+
+        pos += 8 + size + (size & 1);
+    }
+
+    return -1;
+}
+
+/* Maps the samples of the sound file itself. The guard point, past the end
+ * of the samples, may lie beyond the end of the file, so the file is mapped
+ * over an anonymous mapping of the whole length. */
+static int
+SndTable_mapFile(const char *path, void **base, size_t *len, MYFLT **samples, T_SIZE_T *frames, int *samplerate)
+{
+    struct stat st;
+    off_t offset, aligned;
+    size_t page = (size_t)sysconf(_SC_PAGESIZE), filelen;
+    int fd;
+    void *anon;
+
+    fd = open(path, O_RDONLY);
+
+    if (fd == -1)
+        return -1;
+
+    if (fstat(fd, &st) != 0 || SndTable_findRawSamples(fd, &offset, frames, samplerate) != 0)
+    {
+        close(fd);
+        return -1;
+    }
+
+    if (offset + (off_t)(*frames * sizeof(MYFLT)) > st.st_size)
+        *frames = (st.st_size - offset) / sizeof(MYFLT);
+
+    if (*frames < 1)
+    {
+        close(fd);
+        return -1;
+    }
+
+    aligned = offset & ~((off_t)page - 1);
+    *len = (offset - aligned + (*frames + 1) * sizeof(MYFLT) + page - 1) & ~(page - 1);
+    filelen = (st.st_size - aligned + page - 1) & ~(page - 1);
+
+    if (filelen > *len)
+        filelen = *len;
+
+    anon = mmap(NULL, *len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if (anon == MAP_FAILED)
+    {
+        close(fd);
+        return -1;
+    }
+
+    if (mmap(anon, filelen, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, aligned) == MAP_FAILED)
+    {
+        munmap(anon, *len);
+        close(fd);
+        return -1;
+    }
+
+    close(fd);
+
+    *base = anon;
+    *samples = (MYFLT *)((char *)anon + (offset - aligned));
+
+    return 0;
+}
+
+/* Maps the planar cache of the sound in `dir`, building it first if it is
+ * missing or stale. */
+static int
+SndTable_mapCache(const char *path, int chnl, const char *dir, void **base, size_t *len, MYFLT **samples, T_SIZE_T *frames, int *samplerate)
+{
+    struct stat src;
+    SndCacheHeader header;
+    char cpath[PATH_MAX];
+    int fd, tries;
+
+    if (stat(path, &src) != 0 || SndTable_cachePath(path, dir, cpath, sizeof(cpath)) != 0)
+        return -1;
+
+    for (tries = 0; tries < 2; tries++)
+    {
+        fd = open(cpath, O_RDONLY);
+
+        if (fd != -1)
+        {
+            if (read(fd, &header, sizeof(SndCacheHeader)) == sizeof(SndCacheHeader) &&
+                SndTable_cacheIsValid(fd, &header, &src))
+                break;
+
+            close(fd);
+            fd = -1;
+        }
+
+        if (tries == 0 && SndTable_buildCache(path, cpath, &src) != 0)
+            return -1;
+    }
+
+    if (fd == -1)
+        return -1;
+
+    if (chnl < 0 || chnl >= header.channels)
+    {
+        close(fd);
+        return -1;
+    }
+
+    *len = sizeof(SndCacheHeader) + (size_t)header.channels * (header.frames + 1) * sizeof(MYFLT);
+    *base = mmap(NULL, *len, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (*base == MAP_FAILED)
+        return -1;
+
+    *frames = header.frames;
+    *samplerate = header.samplerate;
+    *samples = (MYFLT *)((char *)*base + sizeof(SndCacheHeader)) + chnl * (header.frames + 1);
+
+    return 0;
+}
+#endif
+
+/* Maps channel `chnl` of the sound. Mono files whose samples are already
+ * MYFLT are mapped directly. Other files are mapped from their planar cache
+ * in `dir`, if a cache directory is given. Returns -1 if the sound can't be
+ * mapped, the caller then loads it in memory. */
+static int
+SndTable_mapSound(SndTable *self, const char *dir)
+{
+#if !defined(_WIN32) && !defined(_WIN64)
+    T_SIZE_T start, stop, snd_size;
+    int samplerate;
+    void *base;
+    size_t len;
+    MYFLT *samples;
+
+    if (self->chnl != 0 || SndTable_mapFile(self->path, &base, &len, &samples, &snd_size, &samplerate) != 0)
+    {
+        if (dir == NULL || SndTable_mapCache(self->path, self->chnl, dir, &base, &len, &samples, &snd_size, &samplerate) != 0)
+            return -1;
+    }
+
+    self->sndSr = samplerate;
+
+    if (self->stop <= 0 || self->stop <= self->start || (self->stop * self->sndSr) > snd_size)
+        stop = snd_size;
+    else
+        stop = (T_SIZE_T)(self->stop * self->sndSr);
+
+    if (self->start < 0 || (self->start * self->sndSr) > snd_size)
+        start = 0;
+    else
+        start = (T_SIZE_T)(self->start * self->sndSr);
+
+    if (self->mapbase != NULL)
+        SndTable_releaseMap(self);
+    else
+        arena_free(self->data);
+
+    self->mapbase = base;
+    self->maplen = len;
+    self->size = stop - start;
+    self->data = samples + start;
+    self->data[self->size] = self->data[0];
+
+    self->start = 0.0;
+    self->stop = -1.0;
+    TableStream_setSize(self->tablestream, self->size);
+    TableStream_setSamplingRate(self->tablestream, self->sndSr);
+    TableStream_setData(self->tablestream, self->data);
+
+    return 0;
+#else
+    return -1;
+#endif
+}
+
 static void
 SndTable_loadSound(SndTable *self)
 {
@@ -3919,7 +4523,8 @@ SndTable_loadSound(SndTable *self)
     num_items = self->size * num_chnls;
 
     /* Allocate space for the data to be read, then read it. */
-    self->data = (MYFLT *)PyMem_RawRealloc(self->data, (self->size + 1) * sizeof(MYFLT));
+    SndTable_releaseMap(self);
+    self->data = (MYFLT *)arena_realloc(self->data, (self->size + 1) * sizeof(MYFLT));
 
     /* For sound longer than 1 minute, load 30 sec chunks. */
     if (self->size > (T_SIZE_T)(self->sndSr * 60 * num_chnls))
@@ -4031,7 +4636,7 @@ SndTable_appendSound(SndTable *self)
 
     cross_point = self->size - cross_in_samps;
     self->size = self->size + to_load_size - cross_in_samps;
-    self->data = (MYFLT *)PyMem_RawRealloc(self->data, (self->size + 1) * sizeof(MYFLT));
+    self->data = (MYFLT *)arena_realloc(self->data, (self->size + 1) * sizeof(MYFLT));
 
     if (cross_in_samps != 0)
     {
@@ -4141,7 +4746,7 @@ SndTable_prependSound(SndTable *self)
 
     cross_point = to_load_size - cross_in_samps;
     self->size = self->size + to_load_size - cross_in_samps;
-    self->data = (MYFLT *)PyMem_RawRealloc(self->data, (self->size + 1) * sizeof(MYFLT));
+    self->data = (MYFLT *)arena_realloc(self->data, (self->size + 1) * sizeof(MYFLT));
 
     if (self->crossfade == 0.0)
     {
@@ -4257,7 +4862,7 @@ SndTable_insertSound(SndTable *self)
     }
 
     self->size = self->size + to_load_size - (cross_in_samps * 2);
-    self->data = (MYFLT *)PyMem_RawRealloc(self->data, (self->size + 1) * sizeof(MYFLT));
+    self->data = (MYFLT *)arena_realloc(self->data, (self->size + 1) * sizeof(MYFLT));
 
     cross_point = insert_point - cross_in_samps;
 
@@ -4340,7 +4945,11 @@ SndTable_clear(SndTable *self)
 static void
 SndTable_dealloc(SndTable* self)
 {
-    PyMem_RawFree(self->data);
+    if (self->mapbase != NULL)
+        SndTable_releaseMap(self);
+    else
+        arena_free(self->data);
+
     SndTable_clear(self);
     Py_TYPE(self)->tp_free((PyObject*)self);
 }
@@ -4365,15 +4974,18 @@ SndTable_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     MAKE_NEW_TABLESTREAM(self->tablestream, &TableStreamType, NULL);
 
-    static char *kwlist[] = {"path", "chnl", "start", "stop", NULL};
+    int map = 0;
+    char *cachedir = NULL;
+
+    static char *kwlist[] = {"path", "chnl", "start", "stop", "mmap", "cachedir", NULL};
 
-    if (! PyArg_ParseTupleAndKeywords(args, kwds, TYPE_P_IFF, kwlist, &self->path, &psize, &self->chnl, &self->start, &self->stop))
+    if (! PyArg_ParseTupleAndKeywords(args, kwds, TYPE_P_IFFIZ, kwlist, &self->path, &psize, &self->chnl, &self->start, &self->stop, &map, &cachedir))
         return PyLong_FromLong(-1);
 
     if (strcmp(self->path, "") == 0)
     {
         self->size = (T_SIZE_T)self->sr;
-        self->data = (MYFLT *)PyMem_RawRealloc(self->data, (self->size + 1) * sizeof(MYFLT));
+        self->data = (MYFLT *)arena_realloc(self->data, (self->size + 1) * sizeof(MYFLT));
 
         SndTable_full_reset(self);
 
@@ -4382,7 +4994,7 @@ SndTable_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
         TableStream_setSamplingRate(self->tablestream, (int)self->sr);
         TableStream_setData(self->tablestream, self->data);
     }
-    else
+    else if (! map || SndTable_mapSound(self, cachedir) != 0)
     {
         SndTable_loadSound(self);
     }
@@ -4392,7 +5004,7 @@ SndTable_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
 static PyObject * SndTable_getServer(SndTable* self) { GET_SERVER };
 static PyObject * SndTable_getTableStream(SndTable* self) { GET_TABLE_STREAM };
-static PyObject * SndTable_setData(SndTable *self, PyObject *arg) { SET_TABLE_DATA };
+static PyObject * SndTable_setData(SndTable *self, PyObject *arg) { SndTable_unmapSound(self); SET_TABLE_DATA };
 static PyObject * SndTable_normalize(SndTable *self, PyObject *args, PyObject *kwds) { NORMALIZE };
 static PyObject * SndTable_reset(SndTable *self) { TABLE_RESET };
 static PyObject * SndTable_removeDC(SndTable *self) { REMOVE_DC };
@@ -4591,17 +5203,21 @@ static PyObject *
 SndTable_setSound(SndTable *self, PyObject *args, PyObject *kwds)
 {
     Py_ssize_t psize;
-    static char *kwlist[] = {"path", "chnl", "start", "stop", NULL};
+    int map = 0;
+    char *cachedir = NULL;
+    static char *kwlist[] = {"path", "chnl", "start", "stop", "mmap", "cachedir", NULL};
 
     MYFLT stoptmp = -1.0;
 
-    if (! PyArg_ParseTupleAndKeywords(args, kwds, TYPE_P_IFF, kwlist, &self->path, &psize, &self->chnl, &self->start, &stoptmp))
+    if (! PyArg_ParseTupleAndKeywords(args, kwds, TYPE_P_IFFIZ, kwlist, &self->path, &psize, &self->chnl, &self->start, &stoptmp, &map, &cachedir))
     {
         Py_RETURN_NONE;
     }
 
     self->stop = stoptmp;
-    SndTable_loadSound(self);
+
+    if (! map || SndTable_mapSound(self, cachedir) != 0)
+        SndTable_loadSound(self);
 
     Py_RETURN_NONE;
 }
@@ -4627,6 +5243,8 @@ SndTable_append(SndTable *self, PyObject *args, PyObject *kwds)
     else
         self->crossfade = crosstmp;
 
+    SndTable_unmapSound(self);
+
     SndTable_appendSound(self);
 
     Py_RETURN_NONE;
@@ -4654,6 +5272,8 @@ SndTable_insert(SndTable *self, PyObject *args, PyObject *kwds)
     else
         self->crossfade = crosstmp;
 
+    SndTable_unmapSound(self);
+
     if (postmp <= 0.0)
         SndTable_prependSound(self);
     else if (postmp >= ((self->size - 1) / self->sndSr))
@@ -4670,12 +5290,47 @@ SndTable_insert(SndTable *self, PyObject *args, PyObject *kwds)
 static PyObject *
 SndTable_setSize(SndTable *self, PyObject *value)
 {
+    SndTable_unmapSound(self);
 
     TABLE_SET_SIZE
 
     Py_RETURN_NONE;
 }
 
+static PyObject *
+SndTable_prefetch(SndTable *self, PyObject *args, PyObject *kwds)
+{
+    MYFLT start = 0.0, stop = -1.0;
+    static char *kwlist[] = {"start", "stop", NULL};
+
+    if (! PyArg_ParseTupleAndKeywords(args, kwds, TYPE__FF, kwlist, &start, &stop))
+        return PyLong_FromLong(-1);
+
+#if !defined(_WIN32) && !defined(_WIN64)
+
+    if (self->mapbase != NULL)
+    {
+        T_SIZE_T first, last;
+        uintptr_t page = (uintptr_t)sysconf(_SC_PAGESIZE);
+        uintptr_t begin, end;
+
+        first = start <= 0 ? 0 : (T_SIZE_T)(start * self->sndSr);
+        last = (stop <= 0 || (T_SIZE_T)(stop * self->sndSr) > self->size) ? self->size : (T_SIZE_T)(stop * self->sndSr);
+
+        if (first < last)
+        {
+            /* Ask the kernel to read the pages in the background. */
+            begin = (uintptr_t)(self->data + first) & ~(page - 1);
+            end = (uintptr_t)(self->data + last + 1);
+            posix_madvise((void *)begin, end - begin, POSIX_MADV_WILLNEED);
+        }
+    }
+
+#endif
+
+    Py_RETURN_NONE;
+}
+
 static PyObject *
 SndTable_getSize(SndTable *self)
 {
@@ -4726,6 +5381,7 @@ static PyMethodDef SndTable_methods[] =
     {"append", (PyCFunction)SndTable_append, METH_VARARGS | METH_KEYWORDS, "Append a sound in the table."},
     {"insert", (PyCFunction)SndTable_insert, METH_VARARGS | METH_KEYWORDS, "Insert a sound in the table."},
     {"setSize", (PyCFunction)SndTable_setSize, METH_O, "Sets the size of the table in samples"},
+    {"prefetch", (PyCFunction)SndTable_prefetch, METH_VARARGS | METH_KEYWORDS, "Pages in a region of a memory-mapped sound."},
     {"getSize", (PyCFunction)SndTable_getSize, METH_NOARGS, "Return the size of the table in samples."},
     {"getRate", (PyCFunction)SndTable_getRate, METH_NOARGS, "Return the frequency (in cps) that reads the sound without pitch transposition."},
     {"add", (PyCFunction)SndTable_add, METH_O, "Performs table addition."},
@@ -4813,7 +5469,7 @@ NewTable_clear(NewTable *self)
 static void
 NewTable_dealloc(NewTable* self)
 {
-    PyMem_RawFree(self->data);
+    arena_free(self->data);
     NewTable_clear(self);
     Py_TYPE(self->tablestream)->tp_free((PyObject*)self->tablestream);
     Py_TYPE(self)->tp_free((PyObject*)self);
@@ -4844,7 +5500,7 @@ NewTable_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     Py_DECREF(srobj);
 
     self->size = (T_SIZE_T)(self->length * self->sr + 0.5);
-    self->data = (MYFLT *)PyMem_RawRealloc(self->data, (self->size + 1) * sizeof(MYFLT));
+    self->data = (MYFLT *)arena_realloc(self->data, (self->size + 1) * sizeof(MYFLT));
 
     for (i = 0; i < (self->size + 1); i++)
     {
@@ -5057,7 +5713,7 @@ NewTable_setLength(NewTable *self, PyObject *value)
 
     T_SIZE_T size = (T_SIZE_T)(tmp * self->sr + 0.5);
 
-    MYFLT *data = (MYFLT *)PyMem_RawRealloc(self->data, (size + 1) * sizeof(MYFLT));
+    MYFLT *data = (MYFLT *)arena_realloc(self->data, (size + 1) * sizeof(MYFLT));
     if (data == NULL)
     {
         Py_RETURN_NONE;
@@ -5251,7 +5907,7 @@ DataTable_clear(DataTable *self)
 static void
 DataTable_dealloc(DataTable* self)
 {
-    PyMem_RawFree(self->data);
+    arena_free(self->data);
     DataTable_clear(self);
     Py_TYPE(self->tablestream)->tp_free((PyObject*)self->tablestream);
     Py_TYPE(self)->tp_free((PyObject*)self);
@@ -5275,7 +5931,7 @@ DataTable_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     if (! PyArg_ParseTupleAndKeywords(args, kwds, "n|O", kwlist, &self->size, &inittmp))
         Py_RETURN_NONE;
 
-    self->data = (MYFLT *)PyMem_RawRealloc(self->data, (self->size + 1) * sizeof(MYFLT));
+    self->data = (MYFLT *)arena_realloc(self->data, (self->size + 1) * sizeof(MYFLT));
 
     for (i = 0; i < (self->size + 1); i++)
     {
@@ -5468,7 +6124,7 @@ AtanTable_clear(AtanTable *self)
 static void
 AtanTable_dealloc(AtanTable* self)
 {
-    PyMem_RawFree(self->data);
+    arena_free(self->data);
     AtanTable_clear(self);
     Py_TYPE(self->tablestream)->tp_free((PyObject*)self->tablestream);
     Py_TYPE(self)->tp_free((PyObject*)self);
@@ -5493,7 +6149,7 @@ AtanTable_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     if (! PyArg_ParseTupleAndKeywords(args, kwds, TYPE_F_N, kwlist, &self->slope, &self->size))
         Py_RETURN_NONE;
 
-    self->data = (MYFLT *)PyMem_RawRealloc(self->data, (self->size + 1) * sizeof(MYFLT));
+    self->data = (MYFLT *)arena_realloc(self->data, (self->size + 1) * sizeof(MYFLT));
     TableStream_setSize(self->tablestream, self->size);
     TableStream_setData(self->tablestream, self->data);
     AtanTable_generate(self);
@@ -5669,7 +6325,7 @@ isPowerOfTwo(int x)
 typedef struct
 {
     pyo_table_HEAD
-    MYFLT **twiddle;
+    PyoFFTPlan *plan;
     MYFLT basefreq;
     MYFLT spread;
     MYFLT bw;
@@ -5679,29 +6335,13 @@ typedef struct
     double sr;
     MYFLT *amp;
     MYFLT *inframe;
-    int allocated;
 } PadSynthTable;
 
 static void
-PadSynthTable_gen_twiddle(PadSynthTable *self)
+PadSynthTable_gen_plan(PadSynthTable *self)
 {
-    int i, n8;
-    n8 = self->size >> 3;
-
-    if (self->allocated)
-    {
-        for (i = 0; i < 4; i++)
-            PyMem_RawFree(self->twiddle[i]);
-    }
-
-    self->twiddle = (MYFLT **)PyMem_RawRealloc(self->twiddle, 4 * sizeof(MYFLT *));
-
-    for (i = 0; i < 4; i++)
-        self->twiddle[i] = (MYFLT *)PyMem_RawMalloc(n8 * sizeof(MYFLT));
-
-    fft_compute_split_twiddle(self->twiddle, self->size);
-
-    self->allocated = 1;
+    fft_plan_release(self->plan);
+    self->plan = fft_plan_acquire(self->size, PYO_FFT_REAL);
 }
 
 static void
@@ -5754,7 +6394,7 @@ PadSynthTable_generate(PadSynthTable *self)
         self->inframe[self->size - i] = self->amp[i] * MYSIN(phase);
     }
 
-    irealfft_split(self->inframe, self->data, self->size, self->twiddle);
+    fft_plan_inverse(self->plan, self->inframe, self->data);
 
     max = 0.0;
 
@@ -5796,15 +6436,8 @@ PadSynthTable_clear(PadSynthTable *self)
 static void
 PadSynthTable_dealloc(PadSynthTable* self)
 {
-    int i;
-
-    for (i = 0; i < 4; i++)
-    {
-        PyMem_RawFree(self->twiddle[i]);
-    }
-
-    PyMem_RawFree(self->twiddle);
-    PyMem_RawFree(self->data);
+    fft_plan_release(self->plan);
+    arena_free(self->data);
     PyMem_RawFree(self->amp);
     PyMem_RawFree(self->inframe);
     PadSynthTable_clear(self);
@@ -5828,7 +6461,6 @@ PadSynthTable_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->bwscl = 1.0;
     self->nharms = 64;
     self->damp = 0.7;
-    self->allocated = 0;
 
     MAKE_NEW_TABLESTREAM(self->tablestream, &TableStreamType, NULL);
 
@@ -5849,7 +6481,7 @@ PadSynthTable_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
         PySys_WriteStdout("PadSynthTable size must be a power-of-2, using the next power-of-2 greater than size : %ld\n", (long)self->size);
     }
 
-    self->data = (MYFLT *)PyMem_RawRealloc(self->data, (self->size + 1) * sizeof(MYFLT));
+    self->data = (MYFLT *)arena_realloc(self->data, (self->size + 1) * sizeof(MYFLT));
     self->amp = (MYFLT *)PyMem_RawRealloc(self->amp, (self->size / 2) * sizeof(MYFLT));
     self->inframe = (MYFLT *)PyMem_RawRealloc(self->inframe, self->size * sizeof(MYFLT));
     TableStream_setSize(self->tablestream, self->size);
@@ -5861,7 +6493,7 @@ PadSynthTable_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     TableStream_setSamplingRate(self->tablestream, self->sr);
 
-    PadSynthTable_gen_twiddle(self);
+    PadSynthTable_gen_plan(self);
 
     srand(time(NULL));
     PadSynthTable_generate(self);
@@ -6014,12 +6646,12 @@ PadSynthTable_setSize(PadSynthTable *self, PyObject *args, PyObject *kwds)
         PySys_WriteStdout("PadSynthTable size must be a power-of-2, using the next power-of-2 greater than size : %ld\n", (long)self->size);
     }
 
-    self->data = (MYFLT *)PyMem_RawRealloc(self->data, (self->size + 1) * sizeof(MYFLT));
+    self->data = (MYFLT *)arena_realloc(self->data, (self->size + 1) * sizeof(MYFLT));
     self->amp = (MYFLT *)PyMem_RawRealloc(self->amp, (self->size / 2) * sizeof(MYFLT));
     self->inframe = (MYFLT *)PyMem_RawRealloc(self->inframe, self->size * sizeof(MYFLT));
     TableStream_setSize(self->tablestream, self->size);
 
-    PadSynthTable_gen_twiddle(self);
+    PadSynthTable_gen_plan(self);
 
     if (generate)
         PadSynthTable_generate(self);
@@ -6265,6 +6897,7 @@ TableRec_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     INIT_OBJECT_COMMON
 
     Stream_setFunctionPtr(self->stream, TableRec_compute_next_data_frame);
+    Stream_setTableWriter(self->stream, 1);
 
     static char *kwlist[] = {"input", "table", "fadetime", NULL};
 
@@ -6364,8 +6997,10 @@ TableRec_setTable(TableRec *self, PyObject *arg)
 {
     ASSERT_ARG_NOT_NULL
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->table);
     self->table = PyObject_CallMethod((PyObject *)arg, "getTableStream", "");
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -6699,6 +7334,8 @@ typedef struct
     Stream *input_stream;
     PyObject *table;
     PyObject *sources;
+    TableStream **source_streams; /* table streams of the objects in `sources`, fetched once (borrowed). */
+    int sourcesize;
     MYFLT *buffer;
     T_SIZE_T last_size;
 } TableMorph;
@@ -6737,7 +7374,7 @@ TableMorph_compute_next_data_frame(TableMorph *self)
 
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
     T_SIZE_T size = TableStream_getSize((TableStream *)self->table);
-    int len = PyList_Size(self->sources);
+    int len = self->sourcesize;
 
     if (size != self->last_size)
         TableMorph_alloc_memories(self);
@@ -6748,10 +7385,10 @@ TableMorph_compute_next_data_frame(TableMorph *self)
     x = (int)(interp);
     y = x + 1;
 
-    MYFLT *tab1 = TableStream_getData((TableStream *)PyObject_CallMethod((PyObject *)PyList_GET_ITEM(self->sources, x), "getTableStream", ""));
-    MYFLT *tab2 = TableStream_getData((TableStream *)PyObject_CallMethod((PyObject *)PyList_GET_ITEM(self->sources, y), "getTableStream", ""));
-    T_SIZE_T size1 = TableStream_getSize((TableStream *)PyObject_CallMethod((PyObject *)PyList_GET_ITEM(self->sources, x), "getTableStream", ""));
-    T_SIZE_T size2 = TableStream_getSize((TableStream *)PyObject_CallMethod((PyObject *)PyList_GET_ITEM(self->sources, y), "getTableStream", ""));
+    MYFLT *tab1 = TableStream_getData(self->source_streams[x]);
+    MYFLT *tab2 = TableStream_getData(self->source_streams[y]);
+    T_SIZE_T size1 = TableStream_getSize(self->source_streams[x]);
+    T_SIZE_T size2 = TableStream_getSize(self->source_streams[y]);
 
     size = size < size1 ? size : size1;
     size = size < size2 ? size : size2;
@@ -6768,6 +7405,49 @@ TableMorph_compute_next_data_frame(TableMorph *self)
     TableStream_recordChunk((TableStream *)self->table, self->buffer, size);
 }
 
+/* Sets the sources list and fetches the table stream of every object in
+   it. The pointers are borrowed, the streams live as long as the tables
+   held by `sources`. */
+static int
+TableMorph_setSourceStreams(TableMorph *self, PyObject *sources)
+{
+    int i;
+    Py_ssize_t lsize = PyList_Size(sources);
+    PyObject *streamtmp;
+    PyObject *old;
+    TableStream **streams, **oldstreams;
+
+    streams = (TableStream **)PyMem_RawMalloc((lsize + 1) * sizeof(TableStream *));
+
+    for (i = 0; i < lsize; i++)
+    {
+        streamtmp = PyObject_CallMethod(PyList_GET_ITEM(sources, i), "getTableStream", "");
+
+        if (streamtmp == NULL)
+        {
+            PyMem_RawFree(streams);
+            return -1;
+        }
+
+        streams[i] = (TableStream *)streamtmp;
+        Py_DECREF(streamtmp);
+    }
+
+    Py_INCREF(sources);
+    Server_lockProcessing(self->server);
+    old = self->sources;
+    oldstreams = self->source_streams;
+    self->sources = sources;
+    self->source_streams = streams;
+    self->sourcesize = (int)lsize;
+    Server_unlockProcessing(self->server);
+
+    Py_XDECREF(old);
+    PyMem_RawFree(oldstreams);
+
+    return 0;
+}
+
 static int
 TableMorph_traverse(TableMorph *self, visitproc visit, void *arg)
 {
@@ -6791,6 +7471,7 @@ TableMorph_dealloc(TableMorph* self)
 {
     pyo_DEALLOC
     PyMem_RawFree(self->buffer);
+    PyMem_RawFree(self->source_streams);
     TableMorph_clear(self);
     Py_TYPE(self->stream)->tp_free((PyObject*)self->stream);
     Py_TYPE(self)->tp_free((PyObject*)self);
@@ -6807,6 +7488,7 @@ TableMorph_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     INIT_OBJECT_COMMON
 
     Stream_setFunctionPtr(self->stream, TableMorph_compute_next_data_frame);
+    Stream_setTableWriter(self->stream, 1);
 
     static char *kwlist[] = {"input", "table", "sources", NULL};
 
@@ -6823,8 +7505,8 @@ TableMorph_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     self->table = PyObject_CallMethod((PyObject *)tabletmp, "getTableStream", "");
 
-    self->sources = (PyObject *)sourcestmp;
-    Py_INCREF(self->sources);
+    if (TableMorph_setSourceStreams(self, sourcestmp) < 0)
+        return NULL;
 
     TableMorph_alloc_memories(self);
 
@@ -6844,8 +7526,10 @@ TableMorph_setTable(TableMorph *self, PyObject *arg)
 {
     ASSERT_ARG_NOT_NULL
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->table);
     self->table = PyObject_CallMethod((PyObject *)arg, "getTableStream", "");
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -6861,9 +7545,8 @@ TableMorph_setSources(TableMorph *self, PyObject *arg)
         return PyLong_FromLong(-1);
     }
 
-    Py_INCREF(arg);
-    Py_DECREF(self->sources);
-    self->sources = arg;
+    if (TableMorph_setSourceStreams(self, arg) < 0)
+        return NULL;
 
     Py_RETURN_NONE;
 }
@@ -7133,6 +7816,7 @@ TrigTableRec_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     INIT_OBJECT_COMMON
 
     Stream_setFunctionPtr(self->stream, TrigTableRec_compute_next_data_frame);
+    Stream_setTableWriter(self->stream, 1);
 
     static char *kwlist[] = {"input", "trig", "table", "fadetime", NULL};
 
@@ -7192,8 +7876,10 @@ TrigTableRec_setTable(TrigTableRec *self, PyObject *arg)
 {
     ASSERT_ARG_NOT_NULL
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->table);
     self->table = PyObject_CallMethod((PyObject *)arg, "getTableStream", "");
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -7608,6 +8294,7 @@ TablePut_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     INIT_OBJECT_COMMON
 
     Stream_setFunctionPtr(self->stream, TablePut_compute_next_data_frame);
+    Stream_setTableWriter(self->stream, 1);
 
     static char *kwlist[] = {"input", "table", NULL};
 
@@ -7657,8 +8344,10 @@ TablePut_setTable(TablePut *self, PyObject *arg)
 {
     ASSERT_ARG_NOT_NULL
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->table);
     self->table = PyObject_CallMethod((PyObject *)arg, "getTableStream", "");
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -7877,6 +8566,7 @@ TableWrite_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     INIT_OBJECT_COMMON
 
     Stream_setFunctionPtr(self->stream, TableWrite_compute_next_data_frame);
+    Stream_setTableWriter(self->stream, 1);
 
     static char *kwlist[] = {"input", "pos", "table", "mode", "maxwindow", NULL};
 
@@ -7920,6 +8610,7 @@ TableWrite_setPos(TableWrite *self, PyObject *arg)
         Py_RETURN_NONE;
     }
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->pos);
 
     self->pos = arg;
@@ -7927,6 +8618,8 @@ TableWrite_setPos(TableWrite *self, PyObject *arg)
     PyObject *streamtmp = PyObject_CallMethod((PyObject *)self->pos, "_getStream", NULL);
     self->pos_stream = (Stream *)streamtmp;
     Py_INCREF(self->pos_stream);
+    Stream_invalidateGraph();
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -7936,8 +8629,10 @@ TableWrite_setTable(TableWrite *self, PyObject *arg)
 {
     ASSERT_ARG_NOT_NULL
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->table);
     self->table = PyObject_CallMethod((PyObject *)arg, "getTableStream", "");
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
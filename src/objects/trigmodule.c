@@ -189,6 +189,7 @@ TrigRandInt_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, TrigRandInt_compute_next_data_frame);
+    Stream_setSerial(self->stream, 1);
     self->mode_func_ptr = TrigRandInt_setProcMode;
 
     static char *kwlist[] = {"input", "max", "mul", "add", NULL};
@@ -660,6 +661,7 @@ TrigRand_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, TrigRand_compute_next_data_frame);
+    Stream_setSerial(self->stream, 1);
     self->mode_func_ptr = TrigRand_setProcMode;
 
     static char *kwlist[] = {"input", "min", "max", "port", "init", "mul", "add", NULL};
@@ -1009,6 +1011,7 @@ TrigChoice_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, TrigChoice_compute_next_data_frame);
+    Stream_setSerial(self->stream, 1);
     self->mode_func_ptr = TrigChoice_setProcMode;
 
     static char *kwlist[] = {"input", "choice", "port", "init", "mul", "add", NULL};
@@ -1221,41 +1224,41 @@ typedef struct
     PyObject *func;
 } TrigFunc;
 
+static void
+TrigFunc_callFunction(TrigFunc *self)
+{
+    PyObject *tuple, *result;
+
+    if (self->arg == Py_None)
+    {
+        result = PyObject_Call(self->func, PyTuple_New(0), NULL);
+    }
+    else
+    {
+        tuple = PyTuple_New(1);
+        Py_INCREF(self->arg);
+        PyTuple_SET_ITEM(tuple, 0, self->arg);
+        result = PyObject_Call(self->func, tuple, NULL);
+        Py_DECREF(tuple);
+    }
+
+    if (result == NULL)
+        PyErr_Print();
+
+    Py_XDECREF(result);
+}
+
 static void
 TrigFunc_generate(TrigFunc *self)
 {
     int i;
-    PyObject *tuple, *result;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
 
     for (i = 0; i < self->bufsize; i++)
     {
         if (in[i] == 1)
         {
-            if (self->arg == Py_None)
-            {
-                result = PyObject_Call(self->func, PyTuple_New(0), NULL);
-
-                if (result == NULL)
-                {
-                    PyErr_Print();
-                    return;
-                }
-            }
-            else
-            {
-                tuple = PyTuple_New(1);
-                Py_INCREF(self->arg);
-                PyTuple_SET_ITEM(tuple, 0, self->arg);
-                result = PyObject_Call(self->func, tuple, NULL);
-                Py_DECREF(tuple);
-
-                if (result == NULL)
-                {
-                    PyErr_Print();
-                    return;
-                }
-            }
+            Server_callOrDefer((Server *)self->server, self->stream);
         }
     }
 }
@@ -1307,6 +1310,7 @@ TrigFunc_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, TrigFunc_compute_next_data_frame);
+    Stream_setCallbackPtr(self->stream, TrigFunc_callFunction);
 
     static char *kwlist[] = {"input", "function", "arg", NULL};
 
@@ -1768,8 +1772,10 @@ TrigEnv_setTable(TrigEnv *self, PyObject *arg)
 {
     ASSERT_ARG_NOT_NULL
 
+    Server_lockProcessing(self->server);
     Py_DECREF(self->table);
     self->table = PyObject_CallMethod((PyObject *)arg, "getTableStream", "");
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -2111,6 +2117,7 @@ TrigLinseg_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, TrigLinseg_compute_next_data_frame);
+    Stream_setNeedGIL(self->stream, 1);
     self->mode_func_ptr = TrigLinseg_setProcMode;
 
     self->sampleToSec = 1. / self->sr;
@@ -2189,10 +2196,12 @@ TrigLinseg_setList(TrigLinseg *self, PyObject *value)
     }
 
     Py_INCREF(value);
+    Server_lockProcessing(self->server);
     Py_DECREF(self->pointslist);
     self->pointslist = value;
 
     self->newlist = 1;
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -2543,6 +2552,7 @@ TrigExpseg_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, TrigExpseg_compute_next_data_frame);
+    Stream_setNeedGIL(self->stream, 1);
     self->mode_func_ptr = TrigExpseg_setProcMode;
 
     self->sampleToSec = 1. / self->sr;
@@ -2621,10 +2631,12 @@ TrigExpseg_setList(TrigExpseg *self, PyObject *value)
     }
 
     Py_INCREF(value);
+    Server_lockProcessing(self->server);
     Py_DECREF(self->pointslist);
     self->pointslist = value;
 
     self->newlist = 1;
+    Server_unlockProcessing(self->server);
 
     Py_RETURN_NONE;
 }
@@ -3337,6 +3349,7 @@ TrigXnoise_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->loopLen = (pyorand() % 10) + 3;
 
     Stream_setFunctionPtr(self->stream, TrigXnoise_compute_next_data_frame);
+    Stream_setSerial(self->stream, 1);
     self->mode_func_ptr = TrigXnoise_setProcMode;
 
     static char *kwlist[] = {"input", "type", "x1", "x2", "mul", "add", NULL};
@@ -4140,6 +4153,7 @@ TrigXnoiseMidi_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->loopLen = (pyorand() % 10) + 3;
 
     Stream_setFunctionPtr(self->stream, TrigXnoiseMidi_compute_next_data_frame);
+    Stream_setSerial(self->stream, 1);
     self->mode_func_ptr = TrigXnoiseMidi_setProcMode;
 
     static char *kwlist[] = {"input", "type", "x1", "x2", "scale", "range", "mul", "add", NULL};
@@ -5365,6 +5379,7 @@ Percent_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, Percent_compute_next_data_frame);
+    Stream_setSerial(self->stream, 1);
     self->mode_func_ptr = Percent_setProcMode;
 
     static char *kwlist[] = {"input", "percent", "mul", "add", NULL};
@@ -5841,6 +5856,8 @@ typedef struct
     PyObject *input;
     Stream *input_stream;
     PyObject *choice;
+    MYFLT *values; /* the numbers of `choice`. */
+    Stream **choice_streams; /* the streams of the audio objects of `choice` (borrowed), NULL for the numbers. */
     Stream *audioval;
     int chSize;
     int chCount;
@@ -5851,21 +5868,10 @@ typedef struct
     int modebuffer[2]; // need at least 2 slots for mul & add
 } Iter;
 
-static void
-Iter_get_stream(Iter *self, PyObject *obj)
-{
-    PyObject *streamtmp;
-    streamtmp = PyObject_CallMethod((PyObject *)obj, "_getStream", NULL);
-    Py_XDECREF(self->audioval);
-    self->audioval = (Stream *)streamtmp;
-    Py_INCREF(self->audioval);
-}
-
 static void
 Iter_generate(Iter *self)
 {
     int i;
-    PyObject *obj;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
 
     for (i = 0; i < self->bufsize; i++)
@@ -5877,17 +5883,15 @@ Iter_generate(Iter *self)
             if (self->chCount >= self->chSize)
                 self->chCount = 0;
 
-            obj = PyList_GetItem(self->choice, self->chCount);
-
-            if (PyNumber_Check(obj))
+            if (self->choice_streams[self->chCount] == NULL)
             {
-                self->value = PyFloat_AsDouble(obj);
+                self->value = self->values[self->chCount];
                 self->curIsAudio = 0;
             }
             else
             {
                 self->curIsAudio = 1;
-                Iter_get_stream(self, obj);
+                self->audioval = self->choice_streams[self->chCount];
             }
 
             self->chCount++;
@@ -5979,7 +5983,6 @@ Iter_traverse(Iter *self, visitproc visit, void *arg)
     pyo_VISIT
     Py_VISIT(self->input);
     Py_VISIT(self->choice);
-    Py_VISIT(self->audioval);
     return 0;
 }
 
@@ -5989,7 +5992,6 @@ Iter_clear(Iter *self)
     pyo_CLEAR
     Py_CLEAR(self->input);
     Py_CLEAR(self->choice);
-    Py_CLEAR(self->audioval);
     return 0;
 }
 
@@ -5998,6 +6000,8 @@ Iter_dealloc(Iter* self)
 {
     pyo_DEALLOC
     PyMem_RawFree(self->trigsBuffer);
+    PyMem_RawFree(self->values);
+    PyMem_RawFree(self->choice_streams);
     Iter_clear(self);
     Py_TYPE(self->trig_stream)->tp_free((PyObject*)self->trig_stream);
     Py_TYPE(self->stream)->tp_free((PyObject*)self->stream);
@@ -6088,16 +6092,74 @@ static PyObject * Iter_inplace_div(Iter *self, PyObject *arg) { INPLACE_DIV };
 static PyObject *
 Iter_setChoice(Iter *self, PyObject *arg)
 {
+    int i, chSize;
+    PyObject *obj, *old, *streamtmp;
+    MYFLT *values, *oldvalues;
+    Stream **streams, **oldstreams;
+
     if (! PyList_Check(arg))
     {
         PyErr_SetString(PyExc_TypeError, "The choice attribute must be a list.");
         Py_RETURN_NONE;
     }
 
-    self->chSize = PyList_Size(arg);
-    Py_XDECREF(self->choice);
+    chSize = PyList_Size(arg);
+    values = (MYFLT *)PyMem_RawMalloc((chSize + 1) * sizeof(MYFLT));
+    streams = (Stream **)PyMem_RawMalloc((chSize + 1) * sizeof(Stream *));
+
+    for (i = 0; i < chSize; i++)
+    {
+        obj = PyList_GET_ITEM(arg, i);
+        values[i] = 0.0;
+        streams[i] = NULL;
+
+        if (PyNumber_Check(obj))
+            values[i] = PyFloat_AsDouble(obj);
+        else
+        {
+            /* Borrowed, the stream lives as long as its object. */
+            if ((streamtmp = PyObject_CallMethod(obj, "_getStream", NULL)) == NULL)
+            {
+                PyMem_RawFree(values);
+                PyMem_RawFree(streams);
+                return NULL;
+            }
+
+            streams[i] = (Stream *)streamtmp;
+            Py_DECREF(streamtmp);
+        }
+    }
+
+    Py_INCREF(arg);
+    Server_lockProcessing(self->server);
+    old = self->choice;
+    oldvalues = self->values;
+    oldstreams = self->choice_streams;
+    self->chSize = chSize;
     self->choice = arg;
-    Py_INCREF(self->choice);
+    self->values = values;
+    self->choice_streams = streams;
+
+    /* The current stream may belong to an object released with the old
+       list, its last sample is held until the next trigger. */
+    if (self->curIsAudio)
+    {
+        self->curIsAudio = 0;
+        self->value = self->audioval->shared ? self->audioval->last : Stream_getData(self->audioval)[self->bufsize - 1];
+
+        for (i = 0; i < chSize; i++)
+        {
+            if (streams[i] == self->audioval)
+                self->curIsAudio = 1;
+        }
+    }
+
+    Stream_invalidateGraph();
+    Server_unlockProcessing(self->server);
+
+    Py_XDECREF(old);
+    PyMem_RawFree(oldvalues);
+    PyMem_RawFree(oldstreams);
 
     Py_RETURN_NONE;
 }
@@ -151,6 +151,7 @@ Print_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, Print_compute_next_data_frame);
+    Stream_setNeedGIL(self->stream, 1);
     self->mode_func_ptr = Print_setProcMode;
 
     self->sampleToSec = 1. / self->sr;
@@ -2658,6 +2659,7 @@ Denorm_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, Denorm_compute_next_data_frame);
+    Stream_setSerial(self->stream, 1);
     self->mode_func_ptr = Denorm_setProcMode;
 
     static char *kwlist[] = {"input", "mul", "add", NULL};
@@ -580,6 +580,7 @@ WGVerb_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, WGVerb_compute_next_data_frame);
+    Stream_setSerial(self->stream, 1);
     self->mode_func_ptr = WGVerb_setProcMode;
 
     for (i = 0; i < 8; i++)
@@ -1638,6 +1639,7 @@ STReverb_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->srfac = self->sr / 44100.0;
 
     Stream_setFunctionPtr(self->stream, STReverb_compute_next_data_frame);
+    Stream_setSerial(self->stream, 1);
     self->mode_func_ptr = STReverb_setProcMode;
 
     static char *kwlist[] = {"input", "inpos", "revtime", "cutoff", "mix", "roomSize", "firstRefGain", NULL};
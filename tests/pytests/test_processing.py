@@ -0,0 +1,456 @@
+import pytest
+from utilities import *
+from pyo import *
+
+# The processing modes of the server (GIL-free, worker threads, shared
+# buffers, ...) must give the same samples as the normal processing.
+
+
+@pytest.mark.usefixtures("audio_server")
+class TestGILFree:
+
+    GRAPHS = [
+        lambda: Sine(440, mul=0.5, add=0.1),
+        lambda: Sine(Sine(3, mul=100, add=400), mul=Sine(1, mul=.5, add=.5)),
+        lambda: Biquad(SuperSaw(100), freq=Sine(2, mul=600, add=1000), q=5),
+        lambda: Linseg([(0, 0), (0.1, 1), (0.3, 0)]).play() * Sine(300),
+        lambda: Expr(Sine(200), "(* (sin (* twopi 0.25)) $x[0])"),
+        lambda: Mix([Sine(100 + i * 10) for i in range(4)], voices=2),
+        # These read the streams of a list of objects.
+        lambda: Selector([Sine(200), Sine(300), Sine(400)], voice=Sine(1, mul=1, add=1)),
+        lambda: Iter(Metro(0.005).play(), [Sine(200), 0.5, Sine(3)]),
+        lambda: (lambda f: IFFT(f["real"], FrameDelta(f["imag"], 512, 4), size=512, overlaps=4))(FFT(Sine(440), size=512, overlaps=4)),
+        lambda: (lambda f: IFFT(Vectral(f["real"], 512, 4, up=0.5, down=0.5), FrameAccum(f["imag"], 512, 4), size=512, overlaps=4))(FFT(Sine(440), size=512, overlaps=4)),
+    ]
+
+    @pytest.mark.parametrize("graph", range(len(GRAPHS)))
+    def test_same_output(self, audio_server, graph):
+        ref = render(audio_server, self.GRAPHS[graph])
+        assert max(abs(x) for x in ref[0]) > 0
+        audio_server.setGILFree(True)
+        out = render(audio_server, self.GRAPHS[graph])
+        assert out == ref
+
+    def test_setters_while_playing(self, audio_server):
+        def change(obj, i):
+            if i % 3 == 0:
+                obj.setFreq(200 + i * 10)
+                obj.mul = Sine(2) if i % 2 else 0.5
+                obj.setPhase(Sig(0.25))
+
+        ref = render(audio_server, lambda: Sine(100), during=change)
+        audio_server.setGILFree(True)
+        out = render(audio_server, lambda: Sine(100), during=change)
+        assert out == ref
+
+    def test_expr_change_while_playing(self, audio_server):
+        def change(obj, i):
+            obj.expr = "(* $x[0] %d)" % (i % 4)
+
+        ref = render(audio_server, lambda: Expr(Sine(200)), during=change)
+        audio_server.setGILFree(True)
+        out = render(audio_server, lambda: Expr(Sine(200)), during=change)
+        assert out == ref
+
+    def test_python_objects(self, audio_server, capsys):
+        # These objects call the interpreter while they compute their samples.
+        audio_server.setGILFree(True)
+        def build():
+            it = Iter(Metro(0.01).play(), [1, 2, 3])
+            pr = Print(it, method=1, message="it")
+            seg = Linseg([(0, 0), (0.05, 1)]).play()
+            seg.setList([(0, 1), (0.05, 0)])
+            build.keep = [pr, seg]
+            return it
+        out = render(audio_server, build, numbuf=20)
+        assert set(out[0]) <= {0.0, 1.0, 2.0, 3.0}
+        assert "it" in capsys.readouterr().out
+
+    def test_no_stream_references_per_block(self, audio_server):
+        import sys
+        with Start(audio_server) as st:
+            src = Sine(200)
+            objs = [Selector([src, Sine(300)], voice=0.5), Iter(Metro(0.005).play(), [src, 0.5])]
+            mx = Mixer(outs=1)
+            mx.addInput(0, src)
+            mx.setAmp(0, 0, 0.5)
+            stream = src._base_objs[0]._getStream()
+            st.advanceOneBuf()
+            count = sys.getrefcount(stream)
+            for i in range(20):
+                st.advanceOneBuf()
+            assert sys.getrefcount(stream) == count
+            # A stream is freed with its object, whatever its count.
+            del stream
+
+    def test_server_callback(self, audio_server):
+        calls = []
+        audio_server.setCallback(lambda: calls.append(1))
+        audio_server.setGILFree(True)
+        render(audio_server, lambda: Sine(), numbuf=10)
+        assert len(calls) >= 10
+
+
+@pytest.mark.usefixtures("audio_server")
+class TestWorkers:
+
+    GRAPHS = [
+        lambda: Mix([Biquad(SuperSaw(100 + i * 50), freq=800 + i * 100, q=3) for i in range(8)], voices=2),
+        lambda: Delay(Sine(300) * Sine(2), delay=Sine(.5, mul=.01, add=.02), feedback=.5),
+        lambda: Expr(Sine(200) + Sine(301), "(+ $x[0] (delay $x[0] 20))"),
+        lambda: Pan(Sine([300, 400, 500]), outs=2, pan=Sine(1, mul=.5, add=.5)).mix(2),
+        lambda: Freeverb(Sine(300) * Linseg([(0, 0), (0.05, 1), (0.2, 0)]).play(), size=.8),
+    ]
+
+    @pytest.mark.parametrize("workers", [1, 2, 4])
+    @pytest.mark.parametrize("graph", range(len(GRAPHS)))
+    def test_same_output(self, audio_server, graph, workers):
+        ref = render(audio_server, self.GRAPHS[graph])
+        audio_server.setNumWorkers(workers)
+        out = render(audio_server, self.GRAPHS[graph])
+        audio_server.setNumWorkers(0)
+        assert out == ref
+
+    def test_random_objects(self, audio_server):
+        # Objects drawing from the global random generator run in list order.
+        def graph():
+            objs = [Denorm(Sine(100 + i * 50)) for i in range(8)]
+            objs += [Noise(0.1), Randi(freq=200), PVSynth(PVBufLoops(PVAnal(Sine(300)), mode=3))]
+            return Mix(objs, voices=1)
+
+        audio_server.setGlobalSeed(7)
+        ref = render(audio_server, graph)
+        # Rebooting resets the seeds of the random objects.
+        audio_server.shutdown()
+        audio_server.boot()
+        audio_server.setNumWorkers(4)
+        out = render(audio_server, graph)
+        audio_server.setNumWorkers(0)
+        assert out == ref
+
+    def test_with_gilfree(self, audio_server):
+        graph = self.GRAPHS[0]
+        ref = render(audio_server, graph)
+        audio_server.setNumWorkers(2)
+        audio_server.setGILFree(True)
+        out = render(audio_server, graph)
+        audio_server.setNumWorkers(0)
+        assert out == ref
+
+
+@pytest.mark.usefixtures("audio_server")
+class TestRecord:
+
+    def _record(self, audio_server, path, wait):
+        with Start(audio_server) as st:
+            rec = Record(Sine(440), path, chnls=1, fileformat=0, sampletype=3, buffering=1)
+            for i in range(8):
+                st.advanceOneBuf()
+            rec.stop(wait=wait)
+            for i in range(8):
+                st.advanceOneBuf()
+        return rec
+
+    def test_stop(self, audio_server, tmp_path):
+        path = str(tmp_path / "rec.wav")
+        rec = self._record(audio_server, path, 0)
+        # The file is closed when stop() returns.
+        assert sndinfo(path)[0] == 8 * audio_server.getBufferSize()
+        tab = SndTable(path)
+        assert tab.getTable() == render(audio_server, lambda: Sine(440), numbuf=8)[0]
+
+    def test_stop_wait(self, audio_server, tmp_path):
+        # The stream expires in the processing loop, the file is closed by
+        # the disk writer thread without blocking the audio thread.
+        import time
+        path = str(tmp_path / "rec.wav")
+        rec = self._record(audio_server, path, 0.02)
+        frames = (8 + 2) * audio_server.getBufferSize()
+        for i in range(200):
+            info = sndinfo(path)
+            if info is not None and info[0] == frames:
+                break
+            time.sleep(0.01)
+        assert sndinfo(path)[0] == frames
+
+
+@pytest.mark.usefixtures("audio_server")
+class TestStreamOrder:
+
+    # Reading a stream computed after it, an object gets the previous block.
+    def _build(self, during_block):
+        def build():
+            out = Sig(0)
+            late = Sine(1000)
+            out.setValue(late)
+            server = out.getBaseObjects()[0].getServer()
+            move = lambda: server.changeStreamPosition(out.getBaseObjects()[0]._getStream(), late.getBaseObjects()[0]._getStream())
+            if during_block:
+                out._keep = [late, TrigFunc(Trig().play(), move)]
+            else:
+                move()
+                out._keep = [late]
+            return out
+        return build
+
+    def test_move_while_processing(self, audio_server):
+        # The move asked by a callback takes effect from the next block.
+        bs = audio_server.getBufferSize()
+        ref = render(audio_server, self._build(False), numbuf=10)
+        out = render(audio_server, self._build(True), numbuf=10)
+        assert out[0][:bs] != ref[0][:bs]
+        assert out[0][2 * bs:] == ref[0][2 * bs:]
+
+
+@pytest.mark.usefixtures("audio_server")
+class TestMutedByMul:
+
+    # An object whose audio mul is silent skips its processing, but its
+    # phase must move on as if it had computed its samples.
+
+    def _retrigger(self, env):
+        def during(obj, i):
+            if i % 20 == 0:
+                env.play()
+        return during
+
+    @pytest.mark.parametrize("freq", ["float", "audio"])
+    @pytest.mark.parametrize("kind", ["Sine", "Osc"])
+    def test_phase_moves_while_muted(self, audio_server, kind, freq):
+        table = HarmTable([1, 0.5, 0.3])
+
+        def source(mul):
+            fr = 500 if freq == "float" else Sine(3, mul=50, add=500)
+            if kind == "Sine":
+                return Sine(fr, mul=mul)
+            return Osc(table, fr, mul=mul)
+
+        env = Adsr(0.01, 0.05, 0.5, 0.05, dur=0.1)
+        ref = render(audio_server, lambda: source(1) * env, numbuf=100, during=self._retrigger(env))
+        env = Adsr(0.01, 0.05, 0.5, 0.05, dur=0.1)
+        out = render(audio_server, lambda: source(env), numbuf=100, during=self._retrigger(env))
+        assert max(abs(x) for x in ref[0]) > 0.1
+        assert out == ref
+
+
+@pytest.mark.usefixtures("audio_server")
+class TestMultichannelStreams:
+
+    # The streams of an object computed together must give the samples of
+    # the streams computed one by one.
+
+    GRAPHS = [
+        lambda: Sine([100 * (i + 1) for i in range(10)], phase=[0, 0.25], mul=[0.5, 1, 0.25], add=[0, 0.125]),
+        lambda: Sine([200, Sine(2, mul=50, add=300), 500], mul=Sine(1)),
+        lambda: Tone(Sine([300, 1000, 5000]), freq=[500, Sine(3, mul=200, add=600), 2000], mul=0.5),
+    ]
+
+    @pytest.mark.parametrize("graph", range(len(GRAPHS)))
+    def test_same_output(self, audio_server, graph):
+        ref = render(audio_server, self.GRAPHS[graph])
+        audio_server.setMultichannelStreams(True)
+        out = render(audio_server, self.GRAPHS[graph])
+        assert out == ref
+
+    def _sine_setters(self, obj, i):
+        if i == 10:
+            obj._base_objs[1].setFreq(700)
+            obj._base_objs[2].setPhase(0.5)
+        elif i == 20:
+            obj._base_objs[0].setFreq(Sine(2, mul=100, add=300)[0])
+            obj._base_objs[2].reset()
+
+    def _biquad_setters(self, obj, i):
+        if i == 10:
+            obj._base_objs[0].setQ(10)
+            obj._base_objs[1].setType(2)
+        elif i == 20:
+            obj._base_objs[2].setFreq(Sine(2, mul=300, add=1000)[0])
+
+    @pytest.mark.parametrize("kind", ["Sine", "Biquad"])
+    def test_channel_setters(self, audio_server, kind):
+        # The streams forward the setters of their channel.
+        if kind == "Sine":
+            build = lambda: Sine([200, 300, 400], mul=0.5)
+            during = self._sine_setters
+        else:
+            build = lambda: Biquad(Sine([300, 1000, 5000]), freq=[500, 1000, 2000])
+            during = self._biquad_setters
+        ref = render(audio_server, build, during=during)
+        audio_server.setMultichannelStreams(True)
+        out = render(audio_server, build, during=during)
+        assert out == ref
+
+    @pytest.mark.parametrize("kind", ["Sine", "Biquad"])
+    def test_muted_channels(self, audio_server, kind):
+        # The channels muted by their mul are not computed, the phase of a
+        # Sine moves on and the memories of a Biquad restart.
+        def retrigger(obj, i):
+            if i % 20 == 0:
+                env.play()
+
+        def build():
+            if kind == "Sine":
+                return Sine([500, 700, Sine(3, mul=50, add=500)], mul=[env, 0.5, env])
+            return Biquad(Sine([300, 1000, 700]), freq=[500, 1000, Sine(2, mul=300, add=1000)], mul=[env, 0.5, env])
+
+        env = Adsr(0.01, 0.05, 0.5, 0.05, dur=0.1)
+        ref = render(audio_server, build, numbuf=100, during=retrigger)
+        audio_server.setMultichannelStreams(True)
+        env = Adsr(0.01, 0.05, 0.5, 0.05, dur=0.1)
+        out = render(audio_server, build, numbuf=100, during=retrigger)
+        assert max(abs(x) for x in ref[2]) > 0.1
+        assert out == ref
+
+
+@pytest.mark.usefixtures("audio_server")
+class TestBufferReuse:
+
+    GRAPHS = [
+        lambda: Sine(300) * Sine(2) + Sine(500) * 0.5 - 0.1,
+        lambda: Biquad(Sine(300) * Sine(3) + Sine(700), freq=Sine(2, mul=600, add=1000), q=5),
+        lambda: Selector([Sine(200) * 0.5, Sine(300) + 0.1, Sine(400)], voice=Sine(1, mul=1, add=1)),
+        lambda: Biquada(Sine(300) * Sine(5), Sig(0.1), Sig(0.2), Sig(0.1), Sig(1), Sig(-0.5) * 1, Sig(0.2)),
+    ]
+
+    @pytest.mark.parametrize("graph", range(len(GRAPHS)))
+    def test_same_output(self, audio_server, graph):
+        ref = render(audio_server, self.GRAPHS[graph])
+        assert max(abs(x) for x in ref[0]) > 0
+        audio_server.setBufferReuse(True)
+        out = render(audio_server, self.GRAPHS[graph])
+        assert out == ref
+
+    def test_mixer(self, audio_server):
+        def build():
+            mx = Mixer(outs=1, chnls=1)
+            for i in range(3):
+                mx.addInput(i, Sine(200 + i * 100) * Sine(1 + i))
+                mx.setAmp(i, 0, 0.3)
+            return mx[0]
+
+        ref = render(audio_server, build)
+        audio_server.setBufferReuse(True)
+        out = render(audio_server, build)
+        assert out == ref
+
+    def test_new_input_while_playing(self, audio_server):
+        # The sharing must follow the streams given to an object after
+        # its creation.
+        def change(obj, i):
+            if i == 10:
+                obj.setInput(Sine(500) * Sine(3), fadetime=0.01)
+            elif i == 20:
+                obj.freq = Sine(1, mul=300, add=800) * 1
+
+        build = lambda: Biquad(Sine(300) * Sine(2), freq=1000, q=3)
+        ref = render(audio_server, build, during=change)
+        audio_server.setBufferReuse(True)
+        out = render(audio_server, build, during=change)
+        assert out == ref
+
+
+@pytest.mark.usefixtures("audio_server")
+class TestArithmeticFusion:
+
+    # Chained operators are evaluated as one expression, they must give the
+    # samples of the same operations computed one object at a time (Sig
+    # reads each intermediate object, which is then computed on its own).
+
+    def test_chain(self, audio_server):
+        def build(step):
+            a, b, c, d = Sine(300), Sine(2), Sine(500, mul=0.5), Sine(3, add=1)
+            return step(step(step(a * b) + c) * d - 0.1) / 2
+
+        ref = render(audio_server, lambda: build(Sig))
+        out = render(audio_server, lambda: build(lambda x: x))
+        assert max(abs(x) for x in ref[0]) > 0
+        assert out == ref
+
+    def test_reflected(self, audio_server):
+        def build(step):
+            a, b = Sine(300), Sine(2, add=1.5)
+            return 0.5 - step(step(a * b) + 1) * b
+
+        ref = render(audio_server, lambda: build(Sig))
+        out = render(audio_server, lambda: build(lambda x: x))
+        assert out == ref
+
+    def test_long_chain(self, audio_server):
+        # More operators than can be fused in one expression.
+        def build(step):
+            srcs = [Sine(100 + i * 50, mul=0.02) for i in range(40)]
+            out = srcs[0]
+            for s in srcs[1:]:
+                out = step(out * 0.99 + s)
+            return out
+
+        ref = render(audio_server, lambda: build(Sig))
+        out = render(audio_server, lambda: build(lambda x: x))
+        assert out == ref
+
+    def test_set_input(self, audio_server):
+        def change(obj, i):
+            if i == 10:
+                obj._base_objs[0].setInput(Sine(500)._base_objs[0])
+
+        ref = render(audio_server, lambda: Sig(Sine(300)) * Sine(2), during=change)
+        out = render(audio_server, lambda: Sine(300) * Sine(2), during=change)
+        assert out == ref
+
+
+@pytest.mark.usefixtures("audio_server")
+class TestExprBlocks:
+
+    # Expr evaluates its program a block at a time, the samples must be
+    # those of the same operations computed by the arithmetic operators.
+
+    CASES = [
+        ("(* $x[0] 0.5)", lambda a, b: a * 0.5),
+        ("(+ (* $x[0] $x1[0]) 0.25)", lambda a, b: a * b + 0.25),
+        ("(- (* (+ $x[0] 1) $x1[0]) (* $x[0] 0.5))", lambda a, b: (a + 1) * b - a * 0.5),
+        ("(let #a (* $x[0] 2)) (* #a $x1[0])", lambda a, b: a * 2 * b),
+        ("(* (sin (* twopi 0.25)) $x[0])", lambda a, b: a * 1),
+        ("(/ $x[0] 4)", lambda a, b: a / 4),
+    ]
+
+    @pytest.mark.parametrize("case", range(len(CASES)))
+    def test_same_as_operators(self, audio_server, case):
+        expr, ops = self.CASES[case]
+        ref = render(audio_server, lambda: ops(Sine(200), Sine(3, add=0.5)))
+        out = render(audio_server, lambda: Expr([Sine(200), Sine(3, add=0.5)], expr))
+        assert max(abs(x) for x in ref[0]) > 0
+        assert out == ref
+
+    def test_comparisons(self, audio_server):
+        ph = render(audio_server, lambda: Phasor(100))[0]
+        out = render(audio_server, lambda: Expr(Phasor(100), "(if (> $x[0] 0.5) (max $x[0] 0.75) (min $x[0] 0.25))"))[0]
+        assert out == [max(x, 0.75) if x > 0.5 else min(x, 0.25) for x in ph]
+
+
+@pytest.mark.usefixtures("audio_server")
+class TestOscBankRamps:
+
+    # With random deviations, the frequency and the amplitude of each
+    # partial move linearly over the buffer instead of stepping at its start.
+
+    def _steps(self, data, limit):
+        "Largest change between two successive sample differences, away from the wraps of the waveform."
+        diffs = [b - a for a, b in zip(data, data[1:])]
+        near = lambda i: any(abs(d) >= limit for d in diffs[max(i - 1, 0):i + 3])
+        return max(abs(diffs[i + 1] - diffs[i]) for i in range(len(diffs) - 1) if not near(i))
+
+    def test_frequency_ramps(self, audio_server):
+        # Reading a ramp, the sample difference follows the phase increment.
+        table = LinTable([(0, 0), (8191, 1)], size=8192)
+        data = render(audio_server, lambda: OscBank(table, freq=100, frndf=20, frnda=0.5, num=1), numbuf=20)[0]
+        diffs = [b - a for a, b in zip(data, data[1:]) if abs(b - a) < 0.01]
+        assert max(diffs) - min(diffs) > 1e-4
+        assert self._steps(data, 0.01) < 1e-5
+
+    def test_amplitude_ramps(self, audio_server):
+        table = HarmTable()
+        ref = render(audio_server, lambda: OscBank(table, freq=20, num=1), numbuf=20)[0]
+        data = render(audio_server, lambda: OscBank(table, freq=20, arndf=20, arnda=1, num=1), numbuf=20)[0]
+        assert max_difference([data], [ref]) > 0.1
+        assert max(abs(b - a) for a, b in zip(data, data[1:])) < 0.01
@@ -0,0 +1,98 @@
+import os
+import math
+import pytest
+from utilities import *
+from pyo import *
+
+
+def _mapped(path):
+    "True if the file is mapped in the process."
+    with open("/proc/self/maps") as f:
+        return os.path.realpath(path) in f.read()
+
+
+@pytest.mark.usefixtures("audio_server")
+class TestSndTableMmap:
+
+    def _save(self, path, chnls, sampletype):
+        samples = [[math.sin(i * 0.01 * (c + 1)) for i in range(4800)] for c in range(chnls)]
+        tab = DataTable(size=4800, chnls=chnls, init=samples if chnls > 1 else samples[0])
+        tab.save(path, format=0, sampletype=sampletype)
+
+    def test_mono_float_is_mapped(self, tmp_path):
+        path = str(tmp_path / "mono.wav")
+        self._save(path, 1, 3)
+        ref = SndTable(path)
+        tab = SndTable(path, mmap=True)
+        assert tab.getTable() == ref.getTable()
+        assert tab.getSize() == ref.getSize()
+        if os.path.exists("/proc/self/maps"):
+            assert _mapped(path)
+        # Edits stay in the process.
+        tab.put(1.0, 0)
+        assert SndTable(path).getTable() == ref.getTable()
+
+    def test_no_cache_by_default(self, tmp_path):
+        path = str(tmp_path / "stereo.wav")
+        self._save(path, 2, 0)
+        ref = SndTable(path)
+        tab = SndTable(path, mmap=True)
+        assert tab.getTable(all=True) == ref.getTable(all=True)
+        assert os.listdir(str(tmp_path)) == ["stereo.wav"]
+
+    def test_cachedir(self, tmp_path):
+        path = str(tmp_path / "stereo.wav")
+        cachedir = str(tmp_path / "cache")
+        self._save(path, 2, 0)
+        ref = SndTable(path)
+        tab = SndTable(path, mmap=True, cachedir=cachedir)
+        assert tab.getTable(all=True) == ref.getTable(all=True)
+        assert len(os.listdir(cachedir)) == 1
+        # The cache is reused.
+        again = SndTable(path, mmap=True, cachedir=cachedir)
+        assert again.getTable(all=True) == ref.getTable(all=True)
+        assert len(os.listdir(cachedir)) == 1
+
+    def test_start_stop(self, tmp_path):
+        path = str(tmp_path / "mono.wav")
+        self._save(path, 1, 3)
+        ref = SndTable(path, start=0.02, stop=0.05)
+        tab = SndTable(path, start=0.02, stop=0.05, mmap=True)
+        assert tab.getTable() == ref.getTable()
+
+
+@pytest.mark.usefixtures("audio_server")
+class TestMipmaps:
+
+    # Harmonics 1 and 3000 of a 8192 samples table, the second one is
+    # removed by every band-limited copy.
+    def _table(self, mipmaps):
+        tab = HarmTable([1] + [0] * 2998 + [0.5], size=8192)
+        tab.setMipmaps(mipmaps)
+        return tab
+
+    def _render(self, audio_server, inc, mipmaps, during=None):
+        freq = inc * audio_server.getSamplingRate() / 8192
+        tab = self._table(mipmaps)
+        return render(audio_server, lambda: Osc(tab, freq=freq), numbuf=10, during=during)
+
+    def test_original_speed(self, audio_server):
+        plain = self._render(audio_server, 0.9, False)
+        assert max_difference(self._render(audio_server, 0.9, True), plain) == 0
+
+    def test_continuous_above_original_speed(self, audio_server):
+        # Just above the original speed, the table is still mostly read as is.
+        plain = self._render(audio_server, 1.001, False)
+        assert max_difference(self._render(audio_server, 1.001, True), plain) < 0.01
+
+    def test_band_limited(self, audio_server):
+        # At twice the original speed, harmonic 3000 would alias.
+        plain = self._render(audio_server, 2, False)
+        assert max_difference(self._render(audio_server, 2, True), plain) > 0.25
+
+    def test_refresh_while_playing(self, audio_server):
+        def during(obj, i):
+            obj.table.refreshView()
+
+        ref = self._render(audio_server, 3, True)
+        assert max_difference(self._render(audio_server, 3, True, during), ref) == 0
@@ -64,3 +64,34 @@ class StartAndAdvanceOneBuf(BaseStart):
         self._audio_server.start()
         self._audio_server.process()
         return self
+
+
+def render(audio_server, build, numbuf=50, during=None):
+    """
+    Records `numbuf` buffers of the object returned by `build()` and returns
+    the samples as a list of channels. The random objects are seeded from a
+    count of the objects created, use deterministic sources to compare two
+    renders.
+
+    `during`, if given, is called with the object and the buffer index before
+    each buffer is computed, to change the object while it is playing.
+
+    """
+    from pyo import NewTable, TableRec
+
+    with Start(audio_server) as st:
+        obj = build()
+        bs = audio_server.getBufferSize()
+        tab = NewTable(length=numbuf * bs / audio_server.getSamplingRate(), chnls=len(obj))
+        rec = TableRec(obj, tab).play()
+        for i in range(numbuf):
+            if during is not None:
+                during(obj, i)
+            st.advanceOneBuf()
+        data = tab.getTable(all=True) if len(obj) > 1 else [tab.getTable()]
+    return data
+
+
+def max_difference(a, b):
+    "Largest absolute difference between two lists of channels."
+    return max(abs(x - y) for ca, cb in zip(a, b) for x, y in zip(ca, cb))